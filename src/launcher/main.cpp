@@ -60,6 +60,7 @@ int main(int argc, char *argv[])
 #include "updater/updater_progress_handler.h"
 #include "updater/prepare_progress_handler.h"
 #include "updater/update_application.h"
+#include "updater/perform_update.h"
 
 #include "base/win_utility.h"
 
@@ -424,75 +425,33 @@ namespace mmo
 				}
 			}
 
-			{
-				asio::io_service dispatcher;
-				for (const auto & step : preparedUpdate.steps)
+			mmo::updating::performUpdate(
+				preparedUpdate,
+				updateParameters,
+				updatePerformanceConcurrency,
+				[&selfExecutablePath](const mmo::updating::PreparedUpdateStep &step)
 				{
-					dispatcher.post(
-					    [&]()
+					if (isSelfUpdateEnabled)
 					{
-						std::string errorMessage;
-						try
-						{
-							if (!isSelfUpdateEnabled)
-							{
-								try
-								{
-									if (std::filesystem::equivalent(
-									            step.destinationPath,
-									            selfExecutablePath
-									        ))
-									{
-										return;
-									}
-								}
-								catch (const std::filesystem::filesystem_error &)
-								{
-									//ignore
-								}
-							}
-
-							while (!g_shouldQuit && step.step(updateParameters)) {
-								;
-							}
-
-							return;
-						}
-						catch (const std::exception &ex)
-						{
-							errorMessage = ex.what();
-						}
-						catch (...)
-						{
-							errorMessage = "Caught an exception not derived from std::exception";
-						}
-
-						dispatcher.stop();
-						dispatcher.post([errorMessage]()
-						{
-							throw std::runtime_error(errorMessage);
-						});
-					});
-				}
-
-				std::vector<std::thread> threads;
-				std::generate_n(
-				    std::back_inserter(threads),
-				    updatePerformanceConcurrency,
-					[&dispatcher]() {
-						return std::thread([&dispatcher] {
-							dispatcher.run();
-						});
+						return false;
 					}
-				);
 
-				std::for_each(
-				    threads.begin(),
-				    threads.end(),
-				    std::bind(&std::thread::join, std::placeholders::_1));
+					try
+					{
+						return std::filesystem::equivalent(
+							step.destinationPath,
+							selfExecutablePath
+						);
+					}
+					catch (const std::filesystem::filesystem_error &)
+					{
+						//ignore
+					}
 
-				dispatcher.run();
-			}
+					return false;
+				},
+				[]() { return g_shouldQuit; }
+			);
 
 			if (g_shouldQuit)
 			{
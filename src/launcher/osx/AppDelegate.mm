@@ -32,6 +32,7 @@
 #include "updater/updater_progress_handler.h"
 #include "updater/prepare_progress_handler.h"
 #include "updater/update_application.h"
+#include "updater/perform_update.h"
 
 #define MMO_LAUNCHER_VERSION 3
 
@@ -177,49 +178,8 @@ namespace mmo
 																progressHandler
 																);
 			
-			{
-				asio::io_service dispatcher;
-				for (const auto & step : preparedUpdate.steps)
-				{
-					dispatcher.post(
-									[&]()
-									{
-										std::string errorMessage;
-										try
-										{
-											while (step.step(updateParameters)) {
-												;
-											}
-											
-											return;
-										}
-										catch (const std::exception &ex)
-										{
-											errorMessage = ex.what();
-										}
-										catch (...)
-										{
-											errorMessage = "Caught an exception not derived from std::exception";
-										}
-										
-										dispatcher.stop();
-										dispatcher.post([errorMessage]()
-														{
-															throw std::runtime_error(errorMessage);
-														});
-									});
-				}
-				
-                std::vector<std::thread> threads;
-                threads.emplace_back(std::thread([&dispatcher] { dispatcher.run(); } ));
-
-                std::for_each(
-                    threads.begin(),
-                    threads.end(),
-                    std::bind(&std::thread::join, std::placeholders::_1));
-
-                dispatcher.run();
-			}
+			// The progress handler is not thread safe, so steps are performed one after another
+			mmo::updating::performUpdate(preparedUpdate, updateParameters, 1);
 			
 			// Enable play button
 			[self updateStatusMessage:@"Client is up-to-date!"];
@@ -22,12 +22,19 @@ namespace mmo
         , realmPort(mmo::constants::DefaultLoginRealmPort)
 		, maxPlayers((std::numeric_limits<decltype(maxPlayers)>::max)())
 		, maxRealms(constants::MaxRealmCount)
+		, cryptoWorkerCount(0)
+		, maxPendingCryptoJobs(1024)
 		, mysqlPort(mmo::constants::DefaultMySQLPort)
 		, mysqlHost("127.0.0.1")
 		, mysqlUser("mmo")
 		, mysqlPassword("")
 		, mysqlDatabase("mmo_login")
 		, mysqlUpdatePath("updates/login")
+		, databaseType("mysql")
+		, databaseSnapshotFile("")
+		, databaseLatency(0)
+		, databaseLatencyJitter(0)
+		, databaseAutoCreatePassword("")
 		, isLogActive(true)
 		, logFileName("logs/login")
 		, isLogFileBuffering(false)
@@ -95,6 +102,15 @@ namespace mmo
 				mysqlUpdatePath = mysqlDatabaseTable->getString("updatePath", mysqlUpdatePath);
 			}
 
+			if (const Table *const databaseTable = global.getTable("database"))
+			{
+				databaseType = databaseTable->getString("type", databaseType);
+				databaseSnapshotFile = databaseTable->getString("snapshotFile", databaseSnapshotFile);
+				databaseLatency = databaseTable->getInteger("latency", databaseLatency);
+				databaseLatencyJitter = databaseTable->getInteger("latencyJitter", databaseLatencyJitter);
+				databaseAutoCreatePassword = databaseTable->getString("autoCreatePassword", databaseAutoCreatePassword);
+			}
+
 			if (const Table *const mysqlDatabaseTable = global.getTable("webServer"))
 			{
 				webPort = mysqlDatabaseTable->getInteger("port", webPort);
@@ -123,6 +139,12 @@ namespace mmo
 				}
 			}
 
+			if (const Table *const crypto = global.getTable("crypto"))
+			{
+				cryptoWorkerCount = crypto->getInteger("workerCount", cryptoWorkerCount);
+				maxPendingCryptoJobs = crypto->getInteger("maxPendingJobs", maxPendingCryptoJobs);
+			}
+
 			if (const Table *const log = global.getTable("log"))
 			{
 				isLogActive = log->getInteger("active", static_cast<unsigned>(isLogActive)) != 0;
@@ -180,6 +202,18 @@ namespace mmo
 
 		global.writer.newLine();
 
+		{
+			sff::write::Table<Char> databaseTable(global, "database", sff::write::MultiLine);
+			databaseTable.addKey("type", databaseType);
+			databaseTable.addKey("snapshotFile", databaseSnapshotFile);
+			databaseTable.addKey("latency", databaseLatency);
+			databaseTable.addKey("latencyJitter", databaseLatencyJitter);
+			databaseTable.addKey("autoCreatePassword", databaseAutoCreatePassword);
+			databaseTable.Finish();
+		}
+
+		global.writer.newLine();
+
 		{
 			sff::write::Table<Char> mysqlDatabaseTable(global, "webServer", sff::write::MultiLine);
 			mysqlDatabaseTable.addKey("port", webPort);
@@ -209,6 +243,15 @@ namespace mmo
 		
 		global.writer.newLine();
 
+		{
+			sff::write::Table<Char> crypto(global, "crypto", sff::write::MultiLine);
+			crypto.addKey("workerCount", cryptoWorkerCount);
+			crypto.addKey("maxPendingJobs", maxPendingCryptoJobs);
+			crypto.Finish();
+		}
+
+		global.writer.newLine();
+
 		{
 			sff::write::Table<Char> log(global, "log", sff::write::MultiLine);
 			log.addKey("active", static_cast<unsigned>(isLogActive));
@@ -21,6 +21,10 @@ namespace mmo
 		size_t maxPlayers;
 		/// Maximum number of realm connections.
 		size_t maxRealms;
+		/// Number of threads used for srp6 calculations of logins. 0 means one per hardware thread.
+		size_t cryptoWorkerCount;
+		/// Maximum number of queued srp6 calculations before new logins are rejected.
+		size_t maxPendingCryptoJobs;
 
 		/// The port to be used for a mysql connection.
 		uint16 mysqlPort;
@@ -35,6 +39,18 @@ namespace mmo
 
 		String mysqlUpdatePath;
 
+		/// The database system to be used, either "mysql" or "memory". The in-memory database doesn't need a
+		/// database server and is meant for load tests and profiling.
+		String databaseType;
+		/// File the in-memory database is loaded from on startup and saved to on shutdown. Empty to not persist anything.
+		String databaseSnapshotFile;
+		/// Delay in milliseconds applied to every in-memory database request to simulate a database server.
+		uint32 databaseLatency;
+		/// Maximum random delay in milliseconds added on top of the in-memory database latency.
+		uint32 databaseLatencyJitter;
+		/// If not empty, the in-memory database creates unknown accounts and realms with this password when they log in.
+		String databaseAutoCreatePassword;
+
 		/// Indicates whether or not file logging is enabled.
 		bool isLogActive;
 		/// File name of the log file.
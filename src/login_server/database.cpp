@@ -2,6 +2,8 @@
 
 #include "database.h"
 
+#include "base/database_metrics.h"
+
 namespace mmo
 {
 	IDatabase::~IDatabase()
@@ -10,7 +12,7 @@ namespace mmo
 
 	AsyncDatabase::AsyncDatabase(IDatabase &database, ActionDispatcher asyncWorker, ActionDispatcher resultDispatcher)
 		: m_database(database)
-		, m_asyncWorker(std::move(asyncWorker))
+		, m_asyncWorker(MeasureDatabaseRequests(std::move(asyncWorker)))
 		, m_resultDispatcher(std::move(resultDispatcher))
 	{
 	}
@@ -0,0 +1,459 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "memory_database.h"
+
+#include "base/constants.h"
+#include "base/srp6.h"
+#include "binary_io/reader.h"
+#include "binary_io/stream_sink.h"
+#include "binary_io/stream_source.h"
+#include "binary_io/writer.h"
+#include "log/default_log_levels.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace mmo
+{
+	namespace
+	{
+		/// "MLDB" in little endian.
+		constexpr uint32 SnapshotMagic = 0x42444C4D;
+		/// Version 2 added the session keys of accounts and realms.
+		constexpr uint32 SnapshotVersion = 2;
+		/// Oldest snapshot version which can still be loaded.
+		constexpr uint32 MinSnapshotVersion = 1;
+
+		/// Names are compared case insensitive, just like the MySQL collation does.
+		String NormalizeName(String name)
+		{
+			std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+			return name;
+		}
+
+		/// Formats the current local time like MySQL's NOW() so it can be compared against ban expirations.
+		String GetCurrentDateTime()
+		{
+			const std::time_t now = std::time(nullptr);
+
+			std::ostringstream strm;
+			strm << std::put_time(std::localtime(&now), "%Y-%m-%d %H:%M:%S");
+			return strm.str();
+		}
+	}
+
+	MemoryDatabase::MemoryDatabase(MemoryDatabaseInfo info)
+		: m_info(std::move(info))
+	{
+	}
+
+	bool MemoryDatabase::Load()
+	{
+		if (m_info.autoCreatePassword.empty() == false)
+		{
+			WLOG("Unknown accounts and realms will be created on their first login attempt");
+		}
+
+		if (m_info.snapshotFile.empty())
+		{
+			ILOG("Using in-memory database without snapshot file");
+			return true;
+		}
+
+		std::ifstream file(m_info.snapshotFile, std::ios::in | std::ios::binary);
+		if (!file)
+		{
+			ILOG("Snapshot file " << m_info.snapshotFile << " does not exist yet, starting with an empty in-memory database");
+			return true;
+		}
+
+		io::StreamSource source{ file };
+		io::Reader reader{ source };
+
+		uint32 magic = 0, version = 0;
+		if (!(reader >> io::read<uint32>(magic) >> io::read<uint32>(version)) || magic != SnapshotMagic || version < MinSnapshotVersion || version > SnapshotVersion)
+		{
+			ELOG("Snapshot file " << m_info.snapshotFile << " is not a supported login database snapshot");
+			return false;
+		}
+
+		std::scoped_lock lock{ m_mutex };
+
+		uint32 accountCount = 0;
+		if (!(reader >> io::read<uint32>(accountCount)))
+		{
+			ELOG("Failed to read accounts from snapshot file " << m_info.snapshotFile);
+			return false;
+		}
+
+		for (uint32 i = 0; i < accountCount; ++i)
+		{
+			Account account;
+			if (!(reader
+				>> io::read<uint64>(account.id)
+				>> io::read_container<uint8>(account.name)
+				>> io::read_container<uint16>(account.s)
+				>> io::read_container<uint16>(account.v)
+				>> io::read<uint8>(account.banned)
+				>> io::read_container<uint8>(account.banExpiration))
+				|| (version >= 2 && !(reader >> io::read_container<uint16>(account.sessionKey))))
+			{
+				ELOG("Failed to read accounts from snapshot file " << m_info.snapshotFile);
+				return false;
+			}
+
+			m_nextAccountId = std::max(m_nextAccountId, account.id + 1);
+			m_accountIdsByName[NormalizeName(account.name)] = account.id;
+			m_accounts[account.id] = std::move(account);
+		}
+
+		uint32 realmCount = 0;
+		if (!(reader >> io::read<uint32>(realmCount)))
+		{
+			ELOG("Failed to read realms from snapshot file " << m_info.snapshotFile);
+			return false;
+		}
+
+		for (uint32 i = 0; i < realmCount; ++i)
+		{
+			Realm realm;
+			if (!(reader
+				>> io::read<uint32>(realm.id)
+				>> io::read_container<uint8>(realm.name)
+				>> io::read_container<uint16>(realm.s)
+				>> io::read_container<uint16>(realm.v)
+				>> io::read_container<uint8>(realm.address)
+				>> io::read<uint16>(realm.port))
+				|| (version >= 2 && !(reader >> io::read_container<uint16>(realm.sessionKey))))
+			{
+				ELOG("Failed to read realms from snapshot file " << m_info.snapshotFile);
+				return false;
+			}
+
+			m_nextRealmId = std::max(m_nextRealmId, realm.id + 1);
+			m_realmIdsByName[NormalizeName(realm.name)] = realm.id;
+			m_realms[realm.id] = std::move(realm);
+		}
+
+		ILOG("Loaded " << m_accounts.size() << " accounts and " << m_realms.size() << " realms from snapshot file " << m_info.snapshotFile);
+		return true;
+	}
+
+	bool MemoryDatabase::Save() const
+	{
+		if (m_info.snapshotFile.empty())
+		{
+			return true;
+		}
+
+		// Write into a temporary file first so a crash while saving doesn't destroy the last snapshot
+		const String tempFile = m_info.snapshotFile + ".tmp";
+
+		{
+			std::ofstream file(tempFile, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				ELOG("Could not open snapshot file " << tempFile << " for writing");
+				return false;
+			}
+
+			io::StreamSink sink{ file };
+			io::Writer writer{ sink };
+
+			std::scoped_lock lock{ m_mutex };
+
+			writer
+				<< io::write<uint32>(SnapshotMagic)
+				<< io::write<uint32>(SnapshotVersion);
+
+			writer << io::write<uint32>(m_accounts.size());
+			for (const auto& [accountId, account] : m_accounts)
+			{
+				writer
+					<< io::write<uint64>(account.id)
+					<< io::write_dynamic_range<uint8>(account.name)
+					<< io::write_dynamic_range<uint16>(account.s)
+					<< io::write_dynamic_range<uint16>(account.v)
+					<< io::write<uint8>(account.banned)
+					<< io::write_dynamic_range<uint8>(account.banExpiration)
+					<< io::write_dynamic_range<uint16>(account.sessionKey);
+			}
+
+			writer << io::write<uint32>(m_realms.size());
+			for (const auto& [realmId, realm] : m_realms)
+			{
+				writer
+					<< io::write<uint32>(realm.id)
+					<< io::write_dynamic_range<uint8>(realm.name)
+					<< io::write_dynamic_range<uint16>(realm.s)
+					<< io::write_dynamic_range<uint16>(realm.v)
+					<< io::write_dynamic_range<uint8>(realm.address)
+					<< io::write<uint16>(realm.port)
+					<< io::write_dynamic_range<uint16>(realm.sessionKey);
+			}
+
+			if (!file.flush())
+			{
+				ELOG("Failed to write snapshot file " << tempFile);
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempFile, m_info.snapshotFile, error);
+		if (error)
+		{
+			ELOG("Failed to replace snapshot file " << m_info.snapshotFile << ": " << error.message());
+			return false;
+		}
+
+		ILOG("Saved in-memory database to snapshot file " << m_info.snapshotFile);
+		return true;
+	}
+
+	std::optional<AccountData> MemoryDatabase::GetAccountDataByName(std::string name)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const Account* account = FindAccount(name);
+		if (!account && !m_info.autoCreatePassword.empty())
+		{
+			const auto [s, v] = srp6::CalculateSaltAndVerifier(name, m_info.autoCreatePassword);
+			account = &AddAccount(NormalizeName(name), s.asHexStr(), v.asHexStr());
+			ILOG("Created account " << account->name << " on first login");
+		}
+
+		if (!account)
+		{
+			return {};
+		}
+
+		AccountData data;
+		data.id = account->id;
+		data.name = account->name;
+		data.s = account->s;
+		data.v = account->v;
+		data.banned = BanState::None;
+		if (account->banned)
+		{
+			if (account->banExpiration.empty())
+			{
+				data.banned = BanState::Permanent;
+			}
+			else if (account->banExpiration >= GetCurrentDateTime())
+			{
+				data.banned = BanState::Temporarily;
+			}
+		}
+
+		return data;
+	}
+
+	std::optional<RealmAuthData> MemoryDatabase::GetRealmAuthData(std::string name)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const Realm* realm = FindRealm(name);
+		if (!realm && !m_info.autoCreatePassword.empty())
+		{
+			const auto [s, v] = srp6::CalculateSaltAndVerifier(name, m_info.autoCreatePassword);
+			realm = &AddRealm(NormalizeName(name), "127.0.0.1", constants::DefaultRealmPlayerPort, s.asHexStr(), v.asHexStr());
+			ILOG("Created realm " << realm->name << " on first login, players will connect to " << realm->address << ":" << realm->port);
+		}
+
+		if (!realm)
+		{
+			return {};
+		}
+
+		RealmAuthData data;
+		data.id = realm->id;
+		data.name = realm->name;
+		data.s = realm->s;
+		data.v = realm->v;
+		data.ipAddress = realm->address;
+		data.port = realm->port;
+		return data;
+	}
+
+	std::optional<std::pair<uint64, std::string>> MemoryDatabase::GetAccountSessionKey(std::string accountName)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const Account* account = FindAccount(accountName);
+		if (!account)
+		{
+			return {};
+		}
+
+		return std::make_pair(account->id, account->sessionKey);
+	}
+
+	void MemoryDatabase::PlayerLogin(const uint64 accountId, const std::string& sessionKey, const std::string& ip)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (const auto it = m_accounts.find(accountId); it != m_accounts.end())
+		{
+			it->second.sessionKey = sessionKey;
+			it->second.lastIp = ip;
+		}
+	}
+
+	void MemoryDatabase::PlayerLoginFailed(uint64 accountId, const std::string& ip)
+	{
+		// Login attempts are not archived by the in-memory database
+		SimulateLatency();
+	}
+
+	void MemoryDatabase::RealmLogin(const uint32 realmId, const std::string& sessionKey, const std::string& ip, const std::string& build)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (const auto it = m_realms.find(realmId); it != m_realms.end())
+		{
+			it->second.sessionKey = sessionKey;
+			it->second.lastIp = ip;
+			it->second.lastBuild = build;
+		}
+	}
+
+	std::optional<AccountCreationResult> MemoryDatabase::AccountCreate(const std::string& id, const std::string& s, const std::string& v)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (FindAccount(id))
+		{
+			return AccountCreationResult::AccountNameAlreadyInUse;
+		}
+
+		AddAccount(id, s, v);
+		return AccountCreationResult::Success;
+	}
+
+	std::optional<RealmCreationResult> MemoryDatabase::RealmCreate(const std::string& name, const std::string& address, const uint16 port, const std::string& s, const std::string& v)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (FindRealm(name))
+		{
+			return RealmCreationResult::RealmNameAlreadyInUse;
+		}
+
+		AddRealm(name, address, port, s, v);
+		return RealmCreationResult::Success;
+	}
+
+	void MemoryDatabase::BanAccountByName(const std::string& accountName, const std::string& expiration, const std::string& reason)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (Account* account = FindAccount(accountName))
+		{
+			account->banned = true;
+			account->banExpiration = expiration;
+		}
+	}
+
+	void MemoryDatabase::UnbanAccountByName(const std::string& accountName, const std::string& reason)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (Account* account = FindAccount(accountName))
+		{
+			account->banned = false;
+			account->banExpiration.clear();
+		}
+	}
+
+	void MemoryDatabase::SimulateLatency() const
+	{
+		if (m_info.latency == 0 && m_info.latencyJitter == 0)
+		{
+			return;
+		}
+
+		uint32 delay = m_info.latency;
+		if (m_info.latencyJitter > 0)
+		{
+			thread_local std::minstd_rand generator{ std::random_device{}() };
+			delay += std::uniform_int_distribution<uint32>(0, m_info.latencyJitter)(generator);
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+	}
+
+	MemoryDatabase::Account& MemoryDatabase::AddAccount(const String& name, const String& s, const String& v)
+	{
+		Account& account = m_accounts[m_nextAccountId];
+		account.id = m_nextAccountId++;
+		account.name = name;
+		account.s = s;
+		account.v = v;
+
+		m_accountIdsByName[NormalizeName(name)] = account.id;
+		return account;
+	}
+
+	MemoryDatabase::Realm& MemoryDatabase::AddRealm(const String& name, const String& address, const uint16 port, const String& s, const String& v)
+	{
+		Realm& realm = m_realms[m_nextRealmId];
+		realm.id = m_nextRealmId++;
+		realm.name = name;
+		realm.address = address;
+		realm.port = port;
+		realm.s = s;
+		realm.v = v;
+
+		m_realmIdsByName[NormalizeName(name)] = realm.id;
+		return realm;
+	}
+
+	MemoryDatabase::Account* MemoryDatabase::FindAccount(const String& name)
+	{
+		const auto it = m_accountIdsByName.find(NormalizeName(name));
+		if (it == m_accountIdsByName.end())
+		{
+			return nullptr;
+		}
+
+		return &m_accounts.at(it->second);
+	}
+
+	MemoryDatabase::Realm* MemoryDatabase::FindRealm(const String& name)
+	{
+		const auto it = m_realmIdsByName.find(NormalizeName(name));
+		if (it == m_realmIdsByName.end())
+		{
+			return nullptr;
+		}
+
+		return &m_realms.at(it->second);
+	}
+}
@@ -0,0 +1,118 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "database.h"
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace mmo
+{
+	/// Settings of the in-memory database.
+	struct MemoryDatabaseInfo final
+	{
+		/// File the database is loaded from on startup and saved to on shutdown. Empty to keep everything in memory only.
+		String snapshotFile;
+		/// Delay in milliseconds applied to every request to simulate the round trip to a database server.
+		uint32 latency = 0;
+		/// Maximum random delay in milliseconds added on top of the latency.
+		uint32 latencyJitter = 0;
+		/// If not empty, unknown accounts and realms are created with this password when they try to log in.
+		String autoCreatePassword;
+	};
+
+	/// In-memory implementation of the login server database system. Doesn't need a database server and is
+	/// meant for load tests, profiling and local development. Requests are thread safe since the web service
+	/// accesses the database from the network thread.
+	class MemoryDatabase final
+		: public IDatabase
+	{
+	public:
+		explicit MemoryDatabase(MemoryDatabaseInfo info);
+		~MemoryDatabase() override = default;
+
+		/// Loads the snapshot file if there is one.
+		/// @returns false if the snapshot file exists but could not be read.
+		bool Load();
+
+		/// Writes all data into the snapshot file. Does nothing if no snapshot file is configured.
+		/// @returns false if the snapshot file could not be written.
+		bool Save() const;
+
+	public:
+		std::optional<AccountData> GetAccountDataByName(std::string name) override;
+
+		std::optional<RealmAuthData> GetRealmAuthData(std::string name) override;
+
+		std::optional<std::pair<uint64, std::string>> GetAccountSessionKey(std::string accountName) override;
+
+		void PlayerLogin(uint64 accountId, const std::string& sessionKey, const std::string& ip) override;
+
+		void PlayerLoginFailed(uint64 accountId, const std::string& ip) override;
+
+		void RealmLogin(uint32 realmId, const std::string& sessionKey, const std::string& ip, const std::string& build) override;
+
+		std::optional<AccountCreationResult> AccountCreate(const std::string& id, const std::string& s, const std::string& v) override;
+
+		std::optional<RealmCreationResult> RealmCreate(const std::string& name, const std::string& address, uint16 port, const std::string& s, const std::string& v) override;
+
+		void BanAccountByName(const std::string& accountName, const std::string& expiration, const std::string& reason) override;
+
+		void UnbanAccountByName(const std::string& accountName, const std::string& reason) override;
+
+	private:
+		struct Account
+		{
+			uint64 id = 0;
+			String name;
+			String s;
+			String v;
+			String sessionKey;
+			String lastIp;
+			bool banned = false;
+			/// Ban expiration in the format "YYYY-MM-DD HH:MM:SS", empty for permanent bans.
+			String banExpiration;
+		};
+
+		struct Realm
+		{
+			uint32 id = 0;
+			String name;
+			String s;
+			String v;
+			String address;
+			uint16 port = 0;
+			String sessionKey;
+			String lastIp;
+			String lastBuild;
+		};
+
+	private:
+		/// Blocks the calling database thread for the configured latency.
+		void SimulateLatency() const;
+
+		/// Creates a new account. m_mutex has to be locked.
+		Account& AddAccount(const String& name, const String& s, const String& v);
+
+		/// Creates a new realm. m_mutex has to be locked.
+		Realm& AddRealm(const String& name, const String& address, uint16 port, const String& s, const String& v);
+
+		/// Finds an account by its name. m_mutex has to be locked.
+		Account* FindAccount(const String& name);
+
+		/// Finds a realm by its name. m_mutex has to be locked.
+		Realm* FindRealm(const String& name);
+
+	private:
+		const MemoryDatabaseInfo m_info;
+		mutable std::mutex m_mutex;
+		std::map<uint64, Account> m_accounts;
+		std::unordered_map<String, uint64> m_accountIdsByName;
+		std::map<uint32, Realm> m_realms;
+		std::unordered_map<String, uint32> m_realmIdsByName;
+		uint64 m_nextAccountId = 1;
+		uint32 m_nextRealmId = 1;
+	};
+}
@@ -7,7 +7,9 @@
 #include "realm.h"
 
 #include "base/constants.h"
+#include "base/crypto_worker_pool.h"
 #include "base/sha1.h"
+#include "base/srp6.h"
 #include "base/weak_ptr_function.h"
 #include "log/default_log_levels.h"
 
@@ -19,11 +21,13 @@ namespace mmo
 		PlayerManager& playerManager,
 		RealmManager& realmManager,
 		AsyncDatabase& database, 
+		CryptoWorkerPool& cryptoWorkers,
 		std::shared_ptr<Client> connection, 
 		const String & address)
 		: m_manager(playerManager)
 		, m_realmManager(realmManager)
 		, m_database(database)
+		, m_cryptoWorkers(cryptoWorkers)
 		, m_connection(std::move(connection))
 		, m_address(address)
 	{
@@ -225,11 +229,8 @@ namespace mmo
 						// We are NOT banned so continue
 						authResult = auth::auth_result::Success;
 
-						strongThis->m_b.setRand(19 * 8);
-						const BigNumber gmod = constants::srp::g.modExp(strongThis->m_b, constants::srp::N);
-						strongThis->m_B = ((strongThis->m_v * 3) + gmod) % constants::srp::N;
-
-						assert(gmod.getNumBytes() <= 32);
+						strongThis->m_b.setRand(srp6::ServerPrivateKeyBits);
+						strongThis->m_B = srp6::CalculateServerPublicKey(strongThis->m_v, strongThis->m_b);
 						strongThis->m_unk3.setRand(16 * 8);
 
 						// Allow handling the logon proof packet now
@@ -300,74 +301,44 @@ namespace mmo
 			ELOG("[Logon Proof] SRP safeguard failed");
 			return PacketParseResult::Disconnect;
 		}
-		
-		// Build hash
-		SHA1Hash hash = Sha1_BigNumbers({ A, m_B });
-
-		// Calculate u and S
-		BigNumber u{ hash.data(), hash.size() };
-		BigNumber S = (A * (m_v.modExp(u, constants::srp::N))).modExp(m_b, constants::srp::N);
-
-		// Build t
-		const std::vector<uint8> t = S.asByteArray(32);
-		std::array<uint8, 16> t1;
-		for (size_t i = 0; i < t1.size(); ++i)
-		{
-			t1[i] = t[i * 2];
-		}
-		hash = sha1(reinterpret_cast<const char*>(t1.data()), t1.size());
 
-		std::array<uint8, 40> vK;
-		for (size_t i = 0; i < 20; ++i)
-		{
-			vK[i * 2] = hash[i];
-		}
-		for (size_t i = 0; i < 16; ++i)
+		// Verifying the proof is the expensive part of the handshake, so do it on a crypto worker thread to
+		// keep the network threads responsive. Packet parsing is resumed as soon as the result is available.
+		std::weak_ptr<Player> weakThis{ shared_from_this() };
+		auto verifyProof = [identity = m_accountName, s = m_s, v = m_v, b = m_b, B = m_B, A, rec_M1]()
 		{
-			t1[i] = t[i * 2 + 1];
-		}
-
-		hash = sha1(reinterpret_cast<const char*>(t1.data()), t1.size());
-		for (size_t i = 0; i < 20; ++i)
+			return srp6::VerifyClientProof(identity, s, v, b, B, A, rec_M1);
+		};
+		auto proofVerified = [weakThis](const srp6::ServerProof& proof)
 		{
-			vK[i * 2 + 1] = hash[i];
-		}
-
-		BigNumber K{ vK.data(), vK.size() };
+			// The connection might have been closed in the meantime
+			const auto strongThis = weakThis.lock();
+			if (strongThis && strongThis->m_connection)
+			{
+				strongThis->OnLogonProofVerified(proof);
+				strongThis->m_connection->resumeParsing();
+			}
+		};
 
-		SHA1Hash h;
-		h = Sha1_BigNumbers({ constants::srp::N });
-		hash = Sha1_BigNumbers({ constants::srp::g });
-		for (size_t i = 0; i < h.size(); ++i)
+		if (!m_cryptoWorkers.Post(std::move(verifyProof), std::move(proofVerified)))
 		{
-			h[i] ^= hash[i];
+			WLOG("Too many pending logins, rejecting logon proof of account " << m_accountName);
+			SendAuthProof(auth::auth_result::FailDbBusy);
+			return PacketParseResult::Pass;
 		}
 
-		BigNumber t3{ h.data(), h.size() };
-
-		HashGeneratorSha1 sha;
-		Sha1_Add_BigNumbers(sha, { t3 });
-		const auto t4 = sha1(reinterpret_cast<const char*>(m_accountName.data()), m_accountName.size());
-		sha.update(reinterpret_cast<const char*>(t4.data()), t4.size());
-		Sha1_Add_BigNumbers(sha, { m_s, A, m_B, K });
-		hash = sha.finalize();
-
-		// Proof result which will be sent to the client
-		auth::AuthResult proofResult = auth::auth_result::FailWrongCredentials;
+		return PacketParseResult::Block;
+	}
 
-		// Calculate M1 hash on server using values sent by the client and compare it against
-		// the M1 hash sent by the client to see if the passwords do match.
-		const BigNumber M1{ hash.data(), hash.size() };
-		auto sArr = M1.asByteArray(20);
-		if (std::equal(sArr.begin(), sArr.end(), rec_M1.begin()))
+	void Player::OnLogonProofVerified(const srp6::ServerProof& proof)
+	{
+		if (proof.verified)
 		{
-			// Finish SRP6 by calculating the M2 hash value that is sent back to the client for
-			// verification as well.
-			m_m2 = Sha1_BigNumbers({ A, M1, K});
+			m_m2 = proof.m2;
 
 			// Store the calculated session key value internally for later use, also store it in the 
 			// database maybe.
-			m_sessionKey = K;
+			m_sessionKey = proof.sessionKey;
 
 			// Handler method
 			std::weak_ptr<Player> weakThis{ shared_from_this() };
@@ -398,15 +369,16 @@ namespace mmo
 
 			// Store session key in account database
 			m_database.asyncRequest<void>(
-				std::bind(&IDatabase::PlayerLogin, std::placeholders::_1, m_accountId, K.asHexStr(), m_address),
+				std::bind(&IDatabase::PlayerLogin, std::placeholders::_1, m_accountId, m_sessionKey.asHexStr(), m_address),
 				std::move(handler));
-
-			// Stop here since we wait for the database callback
-			return PacketParseResult::Pass;
+			return;
 		}
 
 		// Log error
 		WLOG("Invalid password for account " << m_accountName);
+
+		// Proof result which will be sent to the client
+		auth::AuthResult proofResult = auth::auth_result::FailWrongCredentials;
 		
 		std::weak_ptr<Player> weakThis{ shared_from_this() };
 		auto loginFailedDbHandler = [weakThis, proofResult](const bool)
@@ -421,8 +393,6 @@ namespace mmo
 		m_database.asyncRequest<void>(
 			[this, address = std::cref(m_address)](auto&& database) { database->PlayerLoginFailed(m_accountId, address); },
 			std::move(loginFailedDbHandler));
-
-		return PacketParseResult::Pass;
 	}
 
 	PacketParseResult Player::HandleReconnectChallenge(auth::IncomingPacket & packet)
@@ -20,6 +20,12 @@ namespace mmo
 {
 	class AsyncDatabase;
 	class RealmManager;
+	class CryptoWorkerPool;
+
+	namespace srp6
+	{
+		struct ServerProof;
+	}
 
 
 	/// This class represents a player connction on the login server.
@@ -37,6 +43,7 @@ namespace mmo
 			PlayerManager &manager,
 			RealmManager &realmManager,
 			AsyncDatabase &database,
+			CryptoWorkerPool &cryptoWorkers,
 			std::shared_ptr<Client> connection,
 			const std::string &address);
 
@@ -74,6 +81,7 @@ namespace mmo
 		PlayerManager &m_manager;
 		RealmManager &m_realmManager;
 		AsyncDatabase &m_database;
+		CryptoWorkerPool &m_cryptoWorkers;
 		std::shared_ptr<Client> m_connection;
 		std::string m_address;					// IP address in string format
 		std::string m_accountName;				// Account name in uppercase letters
@@ -122,6 +130,9 @@ namespace mmo
 		/// Handles an incoming packet with packet id LogonProof.
 		/// @param packet The packet data.
 		PacketParseResult HandleLogonProof(auth::IncomingPacket &packet);
+		/// Finishes the logon proof after the client proof has been verified by a crypto worker.
+		/// @param proof The verification result.
+		void OnLogonProofVerified(const srp6::ServerProof &proof);
 		/// Handles an incoming packet with packet id LogonChallenge.
 		/// @param packet The packet data.
 		PacketParseResult HandleReconnectChallenge(auth::IncomingPacket &packet);
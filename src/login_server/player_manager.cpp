@@ -1,6 +1,7 @@
 // Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
 
 #include "player_manager.h"
+#include "base/metrics.h"
 #include "player.h"
 #include "binary_io/string_sink.h"
 #include <cassert>
@@ -10,6 +11,7 @@ namespace mmo
 	PlayerManager::PlayerManager(
 	    size_t playerCapacity)
 		: m_playerCapacity(playerCapacity)
+		, m_connectionCount(MetricsRegistry::Get().AddGauge("mmo_connections", "Number of open connections by type.", "type=\"player\""))
 	{
 	}
 
@@ -31,6 +33,7 @@ namespace mmo
 		});
 		assert(p != m_players.end());
 		m_players.erase(p);
+		m_connectionCount.Set(static_cast<int64>(m_players.size()));
 	}
 	
 	bool PlayerManager::HasPlayerCapacityBeenReached()
@@ -46,6 +49,7 @@ namespace mmo
 
 		assert(added);
 		m_players.push_back(std::move(added));
+		m_connectionCount.Set(static_cast<int64>(m_players.size()));
 	}
 
 	Player * PlayerManager::GetPlayerByAccountName(const String &accountName)
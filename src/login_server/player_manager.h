@@ -11,6 +11,7 @@
 namespace mmo
 {
 	class Player;
+	class MetricGauge;
 
 	/// Manages all connected players.
 	class PlayerManager final : public NonCopyable
@@ -51,6 +52,7 @@ namespace mmo
 
 		Players m_players;
 		size_t m_playerCapacity;
+		MetricGauge& m_connectionCount;
 		std::mutex m_playerMutex;
 	};
 }
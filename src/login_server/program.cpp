@@ -4,6 +4,7 @@
 #include "configuration.h"
 #include "version.h"
 #include "mysql_database.h"
+#include "memory_database.h"
 #include "player_manager.h"
 #include "player.h"
 #include "realm_manager.h"
@@ -18,6 +19,7 @@
 #include "auth_protocol/auth_protocol.h"
 #include "auth_protocol/auth_server.h"
 #include "base/constants.h"
+#include "base/crypto_worker_pool.h"
 
 #include <fstream>
 #include <sstream>
@@ -113,17 +115,46 @@ namespace mmo
 		// Database setup
 		/////////////////////////////////////////////////////////////////////////////////////////////////
 
-		auto database = std::make_unique<MySQLDatabase>(mysql::DatabaseInfo{
-			config.mysqlHost, 
-			config.mysqlPort,
-			config.mysqlUser, 
-			config.mysqlPassword, 
-			config.mysqlDatabase,
-			config.mysqlUpdatePath
-		}, timerQueue);
-		if (!database->Load())
+		std::unique_ptr<IDatabase> database;
+		MemoryDatabase* memoryDatabase = nullptr;
+		if (config.databaseType == "memory")
 		{
-			ELOG("Could not load the database");
+			auto inMemoryDatabase = std::make_unique<MemoryDatabase>(MemoryDatabaseInfo{
+				config.databaseSnapshotFile,
+				config.databaseLatency,
+				config.databaseLatencyJitter,
+				config.databaseAutoCreatePassword
+			});
+			if (!inMemoryDatabase->Load())
+			{
+				ELOG("Could not load the database");
+				return 1;
+			}
+
+			memoryDatabase = inMemoryDatabase.get();
+			database = std::move(inMemoryDatabase);
+		}
+		else if (config.databaseType == "mysql")
+		{
+			auto mysqlDatabase = std::make_unique<MySQLDatabase>(mysql::DatabaseInfo{
+				config.mysqlHost, 
+				config.mysqlPort,
+				config.mysqlUser, 
+				config.mysqlPassword, 
+				config.mysqlDatabase,
+				config.mysqlUpdatePath
+			}, timerQueue);
+			if (!mysqlDatabase->Load())
+			{
+				ELOG("Could not load the database");
+				return 1;
+			}
+
+			database = std::move(mysqlDatabase);
+		}
+		else
+		{
+			ELOG("Unknown database type '" << config.databaseType << "', expected 'mysql' or 'memory'");
 			return 1;
 		}
 
@@ -133,6 +164,16 @@ namespace mmo
 
 		ILOG("Database loaded successfully");
 
+		/////////////////////////////////////////////////////////////////////////////////////////////////
+		// Crypto worker setup
+		/////////////////////////////////////////////////////////////////////////////////////////////////
+
+		// SRP6 calculations are executed on these threads so that a lot of simultaneous logins don't
+		// stall the network threads
+		const size_t cryptoWorkerCount = config.cryptoWorkerCount > 0 ? config.cryptoWorkerCount : std::max(std::thread::hardware_concurrency(), 1u);
+		CryptoWorkerPool cryptoWorkers{ cryptoWorkerCount, config.maxPendingCryptoJobs, sync };
+		ILOG("Running with " << cryptoWorkers.GetWorkerCount() << " crypto worker threads");
+
 		/////////////////////////////////////////////////////////////////////////////////////////////////
 		// Create the realm service
 		/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -152,7 +193,7 @@ namespace mmo
 		}
 
 		// Careful: Called by multiple threads!
-		const auto createRealm = [&realmManager, &asyncDatabase](std::shared_ptr<Realm::Client> connection)
+		const auto createRealm = [&realmManager, &asyncDatabase, &cryptoWorkers](std::shared_ptr<Realm::Client> connection)
 		{
 			asio::ip::address address;
 
@@ -166,7 +207,7 @@ namespace mmo
 				return;
 			}
 
-			auto realm = std::make_shared<Realm>(realmManager, asyncDatabase, connection, address.to_string());
+			auto realm = std::make_shared<Realm>(realmManager, asyncDatabase, cryptoWorkers, connection, address.to_string());
 			ILOG("Incoming realm connection from " << address);
 			realmManager.AddRealm(std::move(realm));
 
@@ -198,7 +239,7 @@ namespace mmo
 		}
 		
 		// Careful: Called by multiple threads!
-		const auto createPlayer = [&playerManager, &realmManager, &asyncDatabase](std::shared_ptr<Player::Client> connection)
+		const auto createPlayer = [&playerManager, &realmManager, &asyncDatabase, &cryptoWorkers](std::shared_ptr<Player::Client> connection)
 		{
 			asio::ip::address address;
 
@@ -212,7 +253,7 @@ namespace mmo
 				return;
 			}
 
-			auto player = std::make_shared<Player>(playerManager, realmManager, asyncDatabase, connection, address.to_string());
+			auto player = std::make_shared<Player>(playerManager, realmManager, asyncDatabase, cryptoWorkers, connection, address.to_string());
 			ILOG("Incoming player connection from " << address);
 			playerManager.AddPlayer(std::move(player));
 
@@ -273,6 +314,11 @@ namespace mmo
 		dbWork.reset();
 		dbThread.join();
 
+		if (memoryDatabase)
+		{
+			memoryDatabase->Save();
+		}
+
 		return 0;
 	}
 }
@@ -4,7 +4,9 @@
 #include "database.h"
 
 #include "base/constants.h"
+#include "base/crypto_worker_pool.h"
 #include "base/sha1.h"
+#include "base/srp6.h"
 #include "base/clock.h"
 #include "base/weak_ptr_function.h"
 #include "log/default_log_levels.h"
@@ -17,10 +19,12 @@ namespace mmo
 	Realm::Realm(
 		RealmManager& realmManager, 
 		AsyncDatabase& database, 
+		CryptoWorkerPool& cryptoWorkers,
 		std::shared_ptr<Client> connection, 
 		const String & address)
 		: m_manager(realmManager)
 		, m_database(database)
+		, m_cryptoWorkers(cryptoWorkers)
 		, m_connection(std::move(connection))
 		, m_address(address)
 		, m_authenticated(false)
@@ -214,11 +218,8 @@ namespace mmo
 					// We are NOT banned so continue
 					authResult = auth::auth_result::Success;
 
-					strongThis->m_b.setRand(19 * 8);
-					BigNumber gmod = constants::srp::g.modExp(strongThis->m_b, constants::srp::N);
-					strongThis->m_B = ((strongThis->m_v * 3) + gmod) % constants::srp::N;
-
-					assert(gmod.getNumBytes() <= 32);
+					strongThis->m_b.setRand(srp6::ServerPrivateKeyBits);
+					strongThis->m_B = srp6::CalculateServerPublicKey(strongThis->m_v, strongThis->m_b);
 					strongThis->m_unk3.setRand(16 * 8);
 
 					// Allow handling the logon proof packet now
@@ -288,133 +289,97 @@ namespace mmo
 			ELOG("[Logon Proof] SRP safeguard failed");
 			return PacketParseResult::Disconnect;
 		}
-		
-		// Build hash
-		SHA1Hash hash = Sha1_BigNumbers({ A, m_B });
-
-		// Calculate u and S
-		BigNumber u{ hash.data(), hash.size() };
-		BigNumber S = (A * (m_v.modExp(u, constants::srp::N))).modExp(m_b, constants::srp::N);
-
-		// Build t
-		const std::vector<uint8> t = S.asByteArray(32);
-		std::array<uint8, 16> t1;
-		for (size_t i = 0; i < t1.size(); ++i)
-		{
-			t1[i] = t[i * 2];
-		}
-		hash = sha1(reinterpret_cast<const char*>(t1.data()), t1.size());
 
-		std::array<uint8, 40> vK;
-		for (size_t i = 0; i < 20; ++i)
+		// Verifying the proof is the expensive part of the handshake, so do it on a crypto worker thread to
+		// keep the network threads responsive. Packet parsing is resumed as soon as the result is available.
+		std::weak_ptr<Realm> weakThis{ shared_from_this() };
+		auto verifyProof = [identity = m_realmName, s = m_s, v = m_v, b = m_b, B = m_B, A, rec_M1]()
 		{
-			vK[i * 2] = hash[i];
-		}
-		for (size_t i = 0; i < 16; ++i)
+			return srp6::VerifyClientProof(identity, s, v, b, B, A, rec_M1);
+		};
+		auto proofVerified = [weakThis](const srp6::ServerProof& proof)
 		{
-			t1[i] = t[i * 2 + 1];
-		}
+			// The connection might have been closed in the meantime
+			const auto strongThis = weakThis.lock();
+			if (strongThis && strongThis->m_connection)
+			{
+				strongThis->OnLogonProofVerified(proof);
+				strongThis->m_connection->resumeParsing();
+			}
+		};
 
-		hash = sha1(reinterpret_cast<const char*>(t1.data()), t1.size());
-		for (size_t i = 0; i < 20; ++i)
+		if (!m_cryptoWorkers.Post(std::move(verifyProof), std::move(proofVerified)))
 		{
-			vK[i * 2 + 1] = hash[i];
+			WLOG("Too many pending logins, rejecting logon proof of realm " << m_realmName);
+			SendAuthProof(auth::auth_result::FailDbBusy);
+			return PacketParseResult::Pass;
 		}
 
-		BigNumber K{ vK.data(), vK.size() };
+		return PacketParseResult::Block;
+	}
 
-		SHA1Hash h;
-		h = Sha1_BigNumbers({ constants::srp::N });
-		hash = Sha1_BigNumbers({ constants::srp::g });
-		for (size_t i = 0; i < h.size(); ++i)
+	void Realm::OnLogonProofVerified(const srp6::ServerProof& proof)
+	{
+		if (!proof.verified)
 		{
-			h[i] ^= hash[i];
-		}
+			// Log error
+			WLOG("Invalid password for realm " << m_realmName);
 
-		BigNumber t3{ h.data(), h.size() };
+			// Send proof result
+			SendAuthProof(auth::auth_result::FailWrongCredentials);
+			return;
+		}
 
-		HashGeneratorSha1 sha;
-		Sha1_Add_BigNumbers(sha, { t3 });
-		const auto t4 = sha1(reinterpret_cast<const char*>(m_realmName.data()), m_realmName.size());
-		sha.update(reinterpret_cast<const char*>(t4.data()), t4.size());
-		Sha1_Add_BigNumbers(sha, { m_s, A, m_B, K });
-		hash = sha.finalize();
+		m_m2 = proof.m2;
 
-		// Proof result which will be sent to the client
-		auth::AuthResult proofResult = auth::auth_result::FailWrongCredentials;
+		// Store the caluclated session key value internally for later use, also store it in the 
+		// database maybe.
+		m_sessionKey = proof.sessionKey;
 
-		// Calculate M1 hash on server using values sent by the client and compare it against
-		// the M1 hash sent by the client to see if the passwords do match.
-		const BigNumber M1{ hash.data(), hash.size() };
-		auto sArr = M1.asByteArray(20);
-		if (std::equal(sArr.begin(), sArr.end(), rec_M1.begin()))
+		// Handler method
+		std::weak_ptr<Realm> weakThis{ shared_from_this() };
+		auto handler = [weakThis](bool success)
 		{
-			// Finish SRP6 by calculating the M2 hash value that is sent back to the client for
-			// verification as well.
-			m_m2 = Sha1_BigNumbers({ A, M1, K});
-
-			// Store the caluclated session key value internally for later use, also store it in the 
-			// database maybe.
-			m_sessionKey = K;
-
-			// Handler method
-			std::weak_ptr<Realm> weakThis{ shared_from_this() };
-			auto handler = [weakThis](bool success)
+			if (auto strongThis = weakThis.lock())
 			{
-				if (auto strongThis = weakThis.lock())
+				if (success)
 				{
-					if (success)
-					{
-						// Add log entry about successful login as the hashes do indeed mach (and thus, so
-						// do the passwords)
-						ILOG("Realm server " << strongThis->m_realmName << " successfully authenticated");
-						strongThis->m_authenticated = true;
-
-						// From here on, accept ClientAuthSession packets
-						strongThis->RegisterPacketHandler(auth::realm_login_packet::ClientAuthSession, *strongThis.get(), &Realm::OnClientAuthSession);
-
-						// If the login attempt succeeded, then we will accept RealmList request packets from now
-						// on to send the realm list to the client on manual request
-						//strongThis->RegisterPacketHandler(auth::client_packet::RealmList, std::bind(&Realm::HandleRealmList, strongThis.get(), std::placeholders::_1));
-						strongThis->SendAuthProof(auth::AuthResult::Success);
-					}
-					else
-					{
-						strongThis->SendAuthProof(auth::AuthResult::FailDbBusy);
-					}
+					// Add log entry about successful login as the hashes do indeed mach (and thus, so
+					// do the passwords)
+					ILOG("Realm server " << strongThis->m_realmName << " successfully authenticated");
+					strongThis->m_authenticated = true;
+
+					// From here on, accept ClientAuthSession packets
+					strongThis->RegisterPacketHandler(auth::realm_login_packet::ClientAuthSession, *strongThis.get(), &Realm::OnClientAuthSession);
+
+					// If the login attempt succeeded, then we will accept RealmList request packets from now
+					// on to send the realm list to the client on manual request
+					//strongThis->RegisterPacketHandler(auth::client_packet::RealmList, std::bind(&Realm::HandleRealmList, strongThis.get(), std::placeholders::_1));
+					strongThis->SendAuthProof(auth::AuthResult::Success);
 				}
-			};
-
-			// Build version string for database (cast to uint16 as ostringstream would otherwise treat uint8
-			// numbers as ascii character letters!)
-			std::ostringstream versionBuilder;
-			versionBuilder 
-				<< static_cast<uint16>(m_version1) 
-				<< "." 
-				<< static_cast<uint16>(m_version2)
-				<< "." 
-				<< static_cast<uint16>(m_version3)
-				<< "." 
-				<< m_build;
-
-			// Store session key in account database
-			m_database.asyncRequest<void>(
-				std::bind(&IDatabase::RealmLogin, std::placeholders::_1, m_realmId, K.asHexStr(), m_address, versionBuilder.str()),
-				std::move(handler));
-
-			// Stop here since we wait for the database callback
-			return PacketParseResult::Pass;
-		}
-		else
-		{
-			// Log error
-			WLOG("Invalid password for realm " << m_realmName);
-		}
-
-		// Send proof result
-		SendAuthProof(proofResult);
+				else
+				{
+					strongThis->SendAuthProof(auth::AuthResult::FailDbBusy);
+				}
+			}
+		};
 
-		return PacketParseResult::Pass;
+		// Build version string for database (cast to uint16 as ostringstream would otherwise treat uint8
+		// numbers as ascii character letters!)
+		std::ostringstream versionBuilder;
+		versionBuilder 
+			<< static_cast<uint16>(m_version1) 
+			<< "." 
+			<< static_cast<uint16>(m_version2)
+			<< "." 
+			<< static_cast<uint16>(m_version3)
+			<< "." 
+			<< m_build;
+
+		// Store session key in account database
+		m_database.asyncRequest<void>(
+			std::bind(&IDatabase::RealmLogin, std::placeholders::_1, m_realmId, m_sessionKey.asHexStr(), m_address, versionBuilder.str()),
+			std::move(handler));
 	}
 
 	PacketParseResult Realm::OnClientAuthSession(auth::IncomingPacket & packet)
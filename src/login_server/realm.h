@@ -16,6 +16,12 @@
 namespace mmo
 {
 	class AsyncDatabase;
+	class CryptoWorkerPool;
+
+	namespace srp6
+	{
+		struct ServerProof;
+	}
 
 	/// This class represents a realm connction on the login server.
 	class Realm final
@@ -31,6 +37,7 @@ namespace mmo
 		explicit Realm(
 			RealmManager &manager,
 			AsyncDatabase &database,
+			CryptoWorkerPool &cryptoWorkers,
 			std::shared_ptr<Client> connection,
 			const std::string &address);
 
@@ -72,6 +79,7 @@ namespace mmo
 	private:
 		RealmManager &m_manager;
 		AsyncDatabase &m_database;
+		CryptoWorkerPool &m_cryptoWorkers;
 		std::shared_ptr<Client> m_connection;
 		std::string m_address;					// IP address of the realm server in string format
 		std::string m_realmName;				// Realm name
@@ -124,6 +132,9 @@ namespace mmo
 		/// Handles an incoming packet with packet id LogonProof.
 		/// @param packet The packet data.
 		PacketParseResult HandleLogonProof(auth::IncomingPacket &packet);
+		/// Finishes the logon proof after the client proof has been verified by a crypto worker.
+		/// @param proof The verification result.
+		void OnLogonProofVerified(const srp6::ServerProof &proof);
 		/// Handles incoming ClientAuthSession packets from a realm server.
 		PacketParseResult OnClientAuthSession(auth::IncomingPacket &packet);
 	};
@@ -1,6 +1,7 @@
 // Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
 
 #include "realm_manager.h"
+#include "base/metrics.h"
 #include "realm.h"
 #include "binary_io/string_sink.h"
 #include <cassert>
@@ -10,6 +11,7 @@ namespace mmo
 	RealmManager::RealmManager(
 	    size_t capacity)
 		: m_capacity(capacity)
+		, m_connectionCount(MetricsRegistry::Get().AddGauge("mmo_connections", "Number of open connections by type.", "type=\"realm\""))
 	{
 	}
 
@@ -30,6 +32,7 @@ namespace mmo
 		});
 		assert(p != m_realms.end());
 		m_realms.erase(p);
+		m_connectionCount.Set(static_cast<int64>(m_realms.size()));
 	}
 	
 	bool RealmManager::HasCapacityBeenReached()
@@ -44,6 +47,7 @@ namespace mmo
 
 		assert(added);
 		m_realms.push_back(std::move(added));
+		m_connectionCount.Set(static_cast<int64>(m_realms.size()));
 	}
 
 	Realm * RealmManager::GetRealmByName(const String &name)
@@ -13,6 +13,7 @@
 namespace mmo
 {
 	class Realm;
+	class MetricGauge;
 
 	/// Manages all connected players.
 	class RealmManager final : public NonCopyable
@@ -64,6 +65,7 @@ namespace mmo
 
 		Realms m_realms;
 		size_t m_capacity;
+		MetricGauge& m_connectionCount;
 		std::mutex m_realmsMutex;
 	};
 }
@@ -42,6 +42,7 @@
 
 #include "base/executable_path.h"
 #include "client_data/project.h"
+#include "frame_ui/font_mgr.h"
 
 #include "action_bar.h"
 #include "spell_cast.h"
@@ -268,6 +269,7 @@ namespace mmo
 	static const char* const s_itemCacheFilename = "Cache/Items.db";
 	static const char* const s_creatureCacheFilename = "Cache/Creatures.db";
 	static const char* const s_questCacheFilename = "Cache/Quests.db";
+	static scoped_connection s_realmAuthConnection;
 
 	static std::unique_ptr<ActionBar> s_actionBar;
 	static std::unique_ptr<SpellCast> s_spellCast;
@@ -306,6 +308,9 @@ namespace mmo
 		// Initialize the event loop
 		EventLoop::Initialize();
 
+		// Fonts keep their rasterized glyphs between sessions
+		FontManager::Get().SetGlyphCacheDirectory("Cache/Fonts");
+
 		// Initialize the console client which also loads the config file
 		Console::Initialize("Config/Config.cfg");
 
@@ -334,7 +339,7 @@ namespace mmo
 
 		s_nameCache = std::make_unique<DBNameCache>(*s_realmConnector);
 
-		// Initialize item cache (TODO: Try loading cache from file so we maybe won't have to ask the server next time we run the client)
+		// Initialize query caches from the files persisted by the last session
 		s_itemCache = std::make_unique<DBItemCache>(*s_realmConnector);
 		if (const auto itemCacheFile = AssetRegistry::OpenFile(s_itemCacheFilename))
 		{
@@ -359,6 +364,21 @@ namespace mmo
 			s_questCache->Deserialize(reader);
 		}
 
+		// Persisted cache entries are only valid for the realm data they were queried from
+		s_realmAuthConnection = s_realmConnector->AuthenticationResult.connect([](uint8 result)
+			{
+				if (result != game::auth_result::Success)
+				{
+					return;
+				}
+
+				const uint64 dataHash = s_realmConnector->GetQueryDataHash();
+				s_itemCache->SetDataHash(dataHash);
+				s_creatureCache->SetDataHash(dataHash);
+				s_questCache->SetDataHash(dataHash);
+				s_nameCache->SetDataHash(0);
+			});
+
 		// Initialize loot client
 		s_lootClient = std::make_unique<LootClient>(*s_realmConnector, *s_itemCache);
 		s_vendorClient = std::make_unique<VendorClient>(*s_realmConnector, *s_itemCache);
@@ -408,6 +428,7 @@ namespace mmo
 	void DestroyGlobal()
 	{
 		s_timerConnection.disconnect();
+		s_realmAuthConnection.disconnect();
 
 		// Remove all registered game states and also leave the current game state.
 		GameStateMgr::Get().RemoveAllGameStates();
@@ -443,6 +464,8 @@ namespace mmo
 			s_questCache->Serialize(writer);
 		}
 
+		FontManager::Get().SaveGlyphCaches();
+
 		s_audio.reset();
 
 		// Destroy the graphics device object
@@ -1,13 +1,18 @@
 #pragma once
 
 #include "base/typedefs.h"
+#include "base/signal.h"
 
 #include "binary_io/writer.h"
 #include "binary_io/reader.h"
 #include "version.h"
+#include "event_loop.h"
 
+#include <algorithm>
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "net/realm_connector.h"
 
@@ -15,16 +20,32 @@ namespace mmo
 {
 	class RealmConnector;
 
+	/// Caches query results of a specific type received from the realm server. Unknown entries are collected and
+	///	requested once per frame, batched into DbQueryBatch packets where the realm supports it. The cache can be
+	///	persisted between sessions and is only reused as long as the realm's query data hash doesn't change.
 	template<typename T, game::client_realm_packet::Type RequestOpCode>
 	class DBCache
 	{
 	public:
 		typedef std::function<void(uint64 guid, const T&)> QueryCallback;
 
+		/// Magic number of the persisted cache file format.
+		static constexpr uint32 FileHeader = 'CDB2';
+
+		/// Whether the realm answers DbQueryBatch packets for the request op code.
+		static constexpr bool SupportsBatching =
+			RequestOpCode == game::client_realm_packet::CreatureQuery ||
+			RequestOpCode == game::client_realm_packet::ItemQuery ||
+			RequestOpCode == game::client_realm_packet::QuestQuery;
+
 	public:
 		DBCache(RealmConnector& realmConnector)
 			: m_realmConnector(realmConnector)
 		{
+			m_idleConnection = EventLoop::Idle.connect([this](float, GameTime)
+				{
+					FlushRequests();
+				});
 		}
 
 	public:
@@ -36,18 +57,10 @@ namespace mmo
 				return &it->second;
 			}
 
-			// Enqueue pending request callback
-			const auto requestIt = m_pendingRequests.find(guid);
-			if (requestIt == m_pendingRequests.end())
+			// Enqueue the request unless it has already been sent. It will be sent on the next idle tick.
+			if (m_requested.insert(guid).second)
 			{
-				// Send request to server asking for entry
-				m_realmConnector.sendSinglePacket([guid](game::OutgoingPacket& packet)
-					{
-						packet.Start(RequestOpCode);
-						packet
-							<< io::write_packed_guid(guid);
-						packet.Finish();
-					});
+				m_queuedRequests.push_back(guid);
 			}
 
 			return nullptr;
@@ -68,8 +81,79 @@ namespace mmo
 			return nullptr;
 		}
 
+		/// Sends all queued requests to the realm. Called automatically once per frame.
+		void FlushRequests()
+		{
+			if (m_queuedRequests.empty())
+			{
+				return;
+			}
+
+			if constexpr (SupportsBatching)
+			{
+				for (size_t offset = 0; offset < m_queuedRequests.size(); offset += game::MaxDbQueryBatchSize)
+				{
+					const size_t count = std::min<size_t>(m_queuedRequests.size() - offset, game::MaxDbQueryBatchSize);
+					if (count == 1)
+					{
+						SendSingleRequest(m_queuedRequests[offset]);
+						continue;
+					}
+
+					const uint64* entries = m_queuedRequests.data() + offset;
+					m_realmConnector.sendSinglePacket([entries, count](game::OutgoingPacket& packet)
+						{
+							packet.Start(game::client_realm_packet::DbQueryBatch);
+							packet
+								<< io::write<uint16>(RequestOpCode)
+								<< io::write<uint16>(count);
+							for (size_t i = 0; i < count; ++i)
+							{
+								packet << io::write_packed_guid(entries[i]);
+							}
+							packet.Finish();
+						});
+				}
+			}
+			else
+			{
+				for (const uint64 guid : m_queuedRequests)
+				{
+					SendSingleRequest(guid);
+				}
+			}
+
+			m_queuedRequests.clear();
+		}
+
+		/// Sets the query data hash of the realm we just authenticated at. If it differs from the hash the cached entries
+		///	were received with, the cache is cleared as the entries might be outdated. Entries which are still awaited are
+		///	requested again since the previous connection might have been lost before they were answered.
+		void SetDataHash(uint64 dataHash)
+		{
+			if (dataHash != m_dataHash)
+			{
+				m_dataHash = dataHash;
+				m_cache.clear();
+			}
+
+			m_requested.clear();
+			m_queuedRequests.clear();
+			for (const auto& [guid, callback] : m_pendingRequests)
+			{
+				if (m_requested.insert(guid).second)
+				{
+					m_queuedRequests.push_back(guid);
+				}
+			}
+		}
+
+		/// Gets the query data hash the cached entries belong to.
+		[[nodiscard]] uint64 GetDataHash() const { return m_dataHash; }
+
 		void NotifyObjectResponse(uint64 guid, const T& object)
 		{
+			m_requested.erase(guid);
 			m_cache[guid] = object;
 			const T& objectRef = m_cache[guid];
 
@@ -82,11 +166,23 @@ namespace mmo
 			m_pendingRequests.erase(range.first, range.second);
 		}
 
+	private:
+		void SendSingleRequest(uint64 guid)
+		{
+			m_realmConnector.sendSinglePacket([guid](game::OutgoingPacket& packet)
+				{
+					packet.Start(RequestOpCode);
+					packet
+						<< io::write_packed_guid(guid);
+					packet.Finish();
+				});
+		}
+
+	public:
 		void Serialize(io::Writer& writer)
 		{
-			// Read file format header
-			constexpr uint32 header = 'CDBC';
-			writer << io::write<uint32>(header) << io::write<uint32>(Revision);
+			// Write file format header
+			writer << io::write<uint32>(FileHeader) << io::write<uint32>(Revision) << io::write<uint64>(m_dataHash);
 
 			writer << io::write<uint32>(m_cache.size());
 			for (auto& [id, object] : m_cache)
@@ -100,7 +196,7 @@ namespace mmo
 		{
 			// Read file format header
 			uint32 header = 0;
-			if (!(reader >> io::read<uint32>(header)) || header != static_cast<uint32>('CDBC'))
+			if (!(reader >> io::read<uint32>(header)) || header != FileHeader)
 			{
 				return false;
 			}
@@ -118,6 +214,14 @@ namespace mmo
 				return false;
 			}
 
+			// Remember which realm data the entries belong to, they are dropped when the realm reports a different hash
+			uint64 dataHash = 0;
+			if (!(reader >> io::read<uint64>(dataHash)))
+			{
+				return false;
+			}
+			m_dataHash = dataHash;
+
 			// Read item count
 			uint32 itemCount = 0;
 			if (!(reader >> io::read<uint32>(itemCount)))
@@ -131,21 +235,26 @@ namespace mmo
 			for (uint32 i = 0; i < itemCount; ++i)
 			{
 				uint64 id = 0;
-				if (!(reader >> io::read<uint64>(id)))
+				if (!(reader >> io::read<uint64>(id)) || !(reader >> m_cache[id]))
 				{
+					// Don't keep partially read entries around
+					m_cache.clear();
 					return false;
 				}
-
-				// Read object entry
-				reader >> m_cache[id];
 			}
 
-			return reader;
+			return true;
 		}
 
 	private:
 		RealmConnector& m_realmConnector;
 		std::unordered_map<uint64, T> m_cache;
 		std::unordered_multimap<uint64, QueryCallback> m_pendingRequests;
+		/// Ids which have been requested from the realm and are not known yet.
+		std::unordered_set<uint64> m_requested;
+		/// Ids which still have to be sent to the realm.
+		std::vector<uint64> m_queuedRequests;
+		uint64 m_dataHash = 0;
+		scoped_connection m_idleConnection;
 	};
 }
@@ -71,6 +71,9 @@ namespace mmo
 
 	namespace
 	{
+		/// Maximum number of streamed assets finalized per frame to avoid hitches.
+		constexpr size_t MaxStreamingCompletionsPerFrame = 4;
+
 		String MapMouseButton(const MouseButton button)
 		{
 			if ((button & MouseButton::Left) == MouseButton::Left) return "LMB";
@@ -281,6 +284,9 @@ namespace mmo
 
 		m_worldInstance.reset();
 
+		// Terrain pages cancel their streaming requests on destruction, so the streamer has to go after the world
+		m_assetStreamer.reset();
+
 		RemovePacketHandler();
 
 		RemoveGameplayCommands();
@@ -494,6 +500,12 @@ namespace mmo
 
 		m_dispatcher.poll();
 
+		if (m_assetStreamer)
+		{
+			UpdatePageStreamingPriorities();
+			m_assetStreamer->ProcessCompletions(MaxStreamingCompletionsPerFrame);
+		}
+
 		// Update audio component to simulate 3d audio correctly from the player position
 		if (m_playerController->GetControlledUnit())
 		{
@@ -661,6 +673,9 @@ namespace mmo
 				dispatcher.post(work);
 			};
 
+		// Terrain pages are read and parsed in the background, closest visible pages first
+		m_assetStreamer = std::make_unique<AssetStreamer>();
+
 		const PagePosition pos = GetPagePositionFromCamera();
 		m_visibleSection = std::make_unique<LoadedPageSection>(pos, 1, *this);
 		m_pageLoader = std::make_unique<WorldPageLoader>(*m_visibleSection, addWork, synchronize);
@@ -694,6 +709,7 @@ namespace mmo
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::MoveJump, *this, &WorldState::OnMovement);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::MoveFallLand, *this, &WorldState::OnMovement);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::MoveEnded, *this, &WorldState::OnMovement);
+		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::CompactMovement, *this, &WorldState::OnCompactMovement);
 
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::ChatMessage, *this, &WorldState::OnChatMessage);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::NameQueryResult, *this, &WorldState::OnNameQueryResult);
@@ -744,6 +760,7 @@ namespace mmo
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::PeriodicAuraLog, *this, &WorldState::OnPeriodicAuraLog);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::ActionButtons, *this, &WorldState::OnActionButtons);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::QuestGiverStatus, *this, &WorldState::OnQuestGiverStatus);
+		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::QuestGiverStatusMultiple, *this, &WorldState::OnQuestGiverStatusMultiple);
 
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::SpellEnergizeLog, *this, &WorldState::OnSpellEnergizeLog);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::TransferPending, *this, &WorldState::OnTransferPending);
@@ -801,6 +818,7 @@ namespace mmo
 
 		m_worldPacketHandlers.Clear();
 		m_worldChangeHandlers.Clear();
+		m_movementReferences.clear();
 	}
 
 	void WorldState::OnRealmDisconnected()
@@ -923,6 +941,9 @@ namespace mmo
 			return PacketParseResult::Disconnect;
 		}
 
+		// Quest givers which were created by this packet, so that their status is queried at once
+		std::vector<uint64> questGiverGuids;
+
 		auto result = PacketParseResult::Disconnect;
 		for (auto i = 0; i < numObjectUpdates; ++i)
 		{
@@ -979,7 +1000,7 @@ namespace mmo
 				{
 					if (object->Get<uint32>(object_fields::NpcFlags) & npc_flags::QuestGiver)
 					{
-						m_realmConnector.UpdateQuestStatus(object->GetGuid());
+						questGiverGuids.push_back(object->GetGuid());
 					}
 				}
 
@@ -1076,6 +1097,8 @@ namespace mmo
 			
 			result = PacketParseResult::Pass;
 		}
+
+		m_realmConnector.UpdateQuestStatus(questGiverGuids);
 		
 		return result;
 	}
@@ -1103,6 +1126,7 @@ namespace mmo
 			}
 
 			m_partyInfo.OnPlayerDespawned(id);
+			m_movementReferences.erase(id);
 
 			if (m_playerController->GetControlledUnit() &&
 				m_playerController->GetControlledUnit()->GetGuid() == id)
@@ -1138,6 +1162,39 @@ namespace mmo
 		return PacketParseResult::Pass;
 	}
 
+	PacketParseResult WorldState::OnCompactMovement(game::IncomingPacket& packet)
+	{
+		uint64 characterGuid;
+		uint8 opCode;
+		if (!(packet >> io::read_packed_guid(characterGuid) >> io::read<uint8>(opCode)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		const auto referenceIt = m_movementReferences.find(characterGuid);
+		CompactMovementState state;
+		if (!ReadCompactMovement(packet, referenceIt != m_movementReferences.end() ? &referenceIt->second : nullptr, state))
+		{
+			// The server and the client forget references at the same time, so this only happens if a delta for a unit
+			// arrives after the unit was destroyed, in which case there is nothing to move anyway
+			WLOG("Could not decode compact movement of unit " << log_hex_digit(characterGuid) << " (op code " << static_cast<uint32>(opCode) << ")");
+			return PacketParseResult::Pass;
+		}
+
+		m_movementReferences[characterGuid] = state;
+
+		const auto unitPtr = ObjectMgr::Get<GameUnitC>(characterGuid);
+		if (!unitPtr)
+		{
+			WLOG("Received movement packet for unknown unit " << log_hex_digit(characterGuid));
+			return PacketParseResult::Pass;
+		}
+
+		unitPtr->ApplyMovementInfo(state.ToMovementInfo());
+
+		return PacketParseResult::Pass;
+	}
+
 	PacketParseResult WorldState::OnChatMessage(game::IncomingPacket& packet)
 	{
 		uint64 characterGuid;
@@ -2214,6 +2271,41 @@ namespace mmo
 		return PacketParseResult::Pass;
 	}
 
+	PacketParseResult WorldState::OnQuestGiverStatusMultiple(game::IncomingPacket& packet)
+	{
+		uint16 count;
+		if (!(packet >> io::read<uint16>(count)))
+		{
+			ELOG("Failed to read QuestGiverStatusMultiple packet!");
+			return PacketParseResult::Disconnect;
+		}
+
+		for (uint16 i = 0; i < count; ++i)
+		{
+			uint64 questgiverGuid;
+			QuestgiverStatus status;
+			if (!(packet >> io::read_packed_guid(questgiverGuid) >> io::read<uint8>(status)))
+			{
+				ELOG("Failed to read QuestGiverStatusMultiple packet!");
+				return PacketParseResult::Disconnect;
+			}
+
+			if (status >= questgiver_status::Count_)
+			{
+				ELOG("Received invalid quest giver status " << static_cast<int32>(status));
+				return PacketParseResult::Disconnect;
+			}
+
+			// The unit might have been despawned while the query was pending
+			if (std::shared_ptr<GameUnitC> questgiverUnit = ObjectMgr::Get<GameUnitC>(questgiverGuid))
+			{
+				questgiverUnit->SetQuestgiverStatus(status);
+			}
+		}
+
+		return PacketParseResult::Pass;
+	}
+
 	PacketParseResult WorldState::OnSpellEnergizeLog(game::IncomingPacket& packet)
 	{
 		uint64 targetGuid, casterGuid;
@@ -2256,6 +2348,7 @@ namespace mmo
 		// Remove all objects at once
 		m_playerController->SetControlledUnit(nullptr);
 		ObjectMgr::RemoveAllObjects();
+		m_movementReferences.clear();
 
 		return PacketParseResult::Pass;
 	}
@@ -2901,11 +2994,24 @@ namespace mmo
 
 			if (isAvailable)
 			{
-				page->Prepare();
-				EnsurePageIsLoaded(pos);
+				if (!m_assetStreamer)
+				{
+					page->Prepare();
+					EnsurePageIsLoaded(pos);
+					return;
+				}
+
+				page->PrepareAsync(*m_assetStreamer, GetPageStreamingPriority(*page), [this, pos](const bool succeeded)
+					{
+						if (succeeded)
+						{
+							EnsurePageIsLoaded(pos);
+						}
+					});
 			}
 			else
 			{
+				page->CancelPrepare();
 				page->Unload();
 			}
 		}
@@ -2940,6 +3046,36 @@ namespace mmo
 		}
 	}
 
+	void WorldState::UpdatePageStreamingPriorities()
+	{
+		if (!m_worldInstance || !m_worldInstance->HasTerrain())
+		{
+			return;
+		}
+
+		const PagePosition worldSize(64, 64);
+		ForEachPageInSquare(worldSize, GetPagePositionFromCamera(), 2, [this](const PagePosition& pos)
+			{
+				terrain::Page* page = m_worldInstance->GetTerrain()->GetPage(pos.x(), pos.y());
+				if (page && page->IsPreparing())
+				{
+					page->SetPreparePriority(GetPageStreamingPriority(*page));
+				}
+			});
+	}
+
+	float WorldState::GetPageStreamingPriority(const terrain::Page& page) const
+	{
+		const Camera& camera = m_playerController->GetCamera();
+		const AABB& bounds = page.GetBoundingBox();
+
+		// Pages have no height until they are prepared, so only use the horizontal distance
+		Vector3 center = bounds.GetCenter();
+		center.y = camera.GetDerivedPosition().y;
+
+		return AssetStreamer::CalculatePriority(camera.GetDerivedPosition().GetDistanceTo(center), camera.IsVisible(bounds));
+	}
+
 	void WorldState::OnTargetHealthChanged(uint64 monitoredGuid)
 	{
 		FrameManager::Get().TriggerLuaEvent("UNIT_HEALTH_UPDATED", "target");
@@ -20,12 +20,14 @@
 #include "scene_graph/world_grid.h"
 #include "spell_projectile.h"
 
+#include "assets/asset_streamer.h"
 #include "base/id_generator.h"
 #include "world_deserializer.h"
 #include "client_data/project.h"
 #include "frame_ui/frame.h"
 #include "game/action_button.h"
 #include "game/auto_attack.h"
+#include "game/compact_movement.h"
 #include "paging/loaded_page_section.h"
 #include "paging/page_loader_listener.h"
 #include "paging/page_pov_partitioner.h"
@@ -205,6 +207,8 @@ namespace mmo
 
 		PacketParseResult OnMovement(game::IncomingPacket& packet);
 
+		PacketParseResult OnCompactMovement(game::IncomingPacket& packet);
+
 		PacketParseResult OnChatMessage(game::IncomingPacket& packet);
 
 		PacketParseResult OnNameQueryResult(game::IncomingPacket& packet);
@@ -255,6 +259,8 @@ namespace mmo
 
 		PacketParseResult OnQuestGiverStatus(game::IncomingPacket& packet);
 
+		PacketParseResult OnQuestGiverStatusMultiple(game::IncomingPacket& packet);
+
 		PacketParseResult OnSpellEnergizeLog(game::IncomingPacket& packet);
 
 		PacketParseResult OnTransferPending(game::IncomingPacket& packet);
@@ -324,6 +330,12 @@ namespace mmo
 
 		void EnsurePageIsLoaded(PagePosition position);
 
+		/// Updates the streaming priorities of all terrain pages that are currently being prepared in the background.
+		void UpdatePageStreamingPriorities();
+
+		/// Calculates the streaming priority of a terrain page based on its distance and visibility to the camera.
+		float GetPageStreamingPriority(const terrain::Page& page) const;
+
 	private:
 		RealmConnector& m_realmConnector;
 		ScreenLayerIt m_paintLayer;
@@ -371,6 +383,7 @@ namespace mmo
 		std::unique_ptr<LoadedPageSection> m_visibleSection;
 		std::unique_ptr<WorldPageLoader> m_pageLoader;
 		std::unique_ptr<PagePOVPartitioner> m_memoryPointOfView;
+		std::unique_ptr<AssetStreamer> m_assetStreamer;
 		LootClient& m_lootClient;
 		VendorClient& m_vendorClient;
 
@@ -379,6 +392,9 @@ namespace mmo
 		RealmConnector::PacketHandlerHandleContainer m_worldPacketHandlers;
 		RealmConnector::PacketHandlerHandleContainer m_worldChangeHandlers;
 
+		/// Last compact movement state received per unit, which the next compact movement of that unit is encoded against.
+		std::unordered_map<uint64, CompactMovementState> m_movementReferences;
+
 		ActionBar& m_actionBar;
 		SpellCast& m_spellCast;
 		TrainerClient& m_trainerClient;
@@ -53,7 +53,8 @@ namespace mmo
 				<< io::write<uint32>(mmo::Revision)
 				<< io::write_dynamic_range<uint8>(this->m_account)
 				<< io::write<uint32>(m_clientSeed)
-				<< io::write_range(hash);
+				<< io::write_range(hash)
+				<< io::write<uint32>(game::client_feature::Supported);
 			packet.Finish();
 		});
 
@@ -82,6 +83,14 @@ namespace mmo
 			return PacketParseResult::Disconnect;
 		}
 
+		// Older realms don't send a data hash, in which case persisted query caches can't be validated
+		uint64 queryDataHash = 0;
+		if (result == game::auth_result::Success && !(packet >> io::read<uint64>(queryDataHash)))
+		{
+			queryDataHash = 0;
+		}
+		m_queryDataHash = queryDataHash;
+
 		// Authentication has been successful!
 		AuthenticationResult(result);
 
@@ -92,6 +101,7 @@ namespace mmo
 			RegisterPacketHandler(game::realm_client_packet::CharEnum, *this, &RealmConnector::OnCharEnum);
 			RegisterPacketHandler(game::realm_client_packet::LoginVerifyWorld, *this, &RealmConnector::OnLoginVerifyWorld);
 			RegisterPacketHandler(game::realm_client_packet::EnterWorldFailed, *this, &RealmConnector::OnEnterWorldFailed);
+			RegisterPacketHandler(game::realm_client_packet::DbQueryBatchResult, *this, &RealmConnector::OnDbQueryBatchResult);
 			
 			// And now, we ask for the character list
 			sendSinglePacket([](game::OutgoingPacket& outPacket)
@@ -158,6 +168,41 @@ namespace mmo
 
 		return PacketParseResult::Pass;
 	}
+
+	PacketParseResult RealmConnector::OnDbQueryBatchResult(game::IncomingPacket& packet)
+	{
+		uint16 resultOpCode = 0, count = 0;
+		if (!(packet >> io::read<uint16>(resultOpCode) >> io::read<uint16>(count)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		PacketHandler handler = nullptr;
+		{
+			std::scoped_lock lock{ m_packetHandlerMutex };
+
+			const auto it = m_packetHandlers.find(resultOpCode);
+			if (it == m_packetHandlers.end())
+			{
+				WLOG("Received batched query result for unhandled op code 0x" << std::hex << resultOpCode);
+				return PacketParseResult::Pass;
+			}
+
+			handler = it->second;
+		}
+
+		// Every entry is laid out exactly like a single query result packet body
+		for (uint16 i = 0; i < count; ++i)
+		{
+			const PacketParseResult result = handler(packet);
+			if (result != PacketParseResult::Pass)
+			{
+				return result;
+			}
+		}
+
+		return PacketParseResult::Pass;
+	}
 	
 	bool RealmConnector::connectionEstablished(bool success)
 	{
@@ -698,6 +743,30 @@ namespace mmo
 			});
 	}
 
+	void RealmConnector::UpdateQuestStatus(const std::vector<uint64>& questGiverGuids)
+	{
+		for (size_t offset = 0; offset < questGiverGuids.size(); offset += game::MaxQuestGiverStatusBatchSize)
+		{
+			const size_t count = std::min<size_t>(questGiverGuids.size() - offset, game::MaxQuestGiverStatusBatchSize);
+			if (count == 1)
+			{
+				UpdateQuestStatus(questGiverGuids[offset]);
+				continue;
+			}
+
+			const uint64* guids = questGiverGuids.data() + offset;
+			sendSinglePacket([guids, count](game::OutgoingPacket& packet) {
+				packet.Start(game::client_realm_packet::QuestGiverStatusMultipleQuery);
+				packet << io::write<uint16>(count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					packet << io::write_packed_guid(guids[i]);
+				}
+				packet.Finish();
+				});
+		}
+	}
+
 	void RealmConnector::AcceptQuest(uint64 questGiverGuid, uint32 questId)
 	{
 		sendSinglePacket([questGiverGuid, questId](game::OutgoingPacket& packet) {
@@ -48,6 +48,7 @@ namespace mmo
 		uint32 m_serverSeed;
 		uint32 m_clientSeed;
 		uint32 m_realmId;
+		uint64 m_queryDataHash = 0;
 
 	public:
 		/// Initializes a new instance of the RealmConnector class.
@@ -75,6 +76,10 @@ namespace mmo
 		///	@param packet The packet to parse.
 		PacketParseResult OnEnterWorldFailed(game::IncomingPacket& packet);
 
+		/// Handles the DbQueryBatchResult packet by passing each contained entry to the packet handler of the single query result.
+		///	@param packet The packet to parse.
+		PacketParseResult OnDbQueryBatchResult(game::IncomingPacket& packet);
+
 	public:
 		// ~ Begin IConnectorListener
 		bool connectionEstablished(bool success) override;
@@ -370,6 +375,11 @@ namespace mmo
 		///	@param questGiverGuid The guid of the npc to update the quest status for.
 		void UpdateQuestStatus(uint64 questGiverGuid);
 
+		/// Sends packets to the server to ask for the quest giver status of multiple npcs at once. Prefer this over single updates when many
+		///	quest givers need an update at the same time, like when they spawn or when the quest log changed.
+		///	@param questGiverGuids The guids of the npcs to update the quest status for.
+		void UpdateQuestStatus(const std::vector<uint64>& questGiverGuids);
+
 		/// Sends a packet to the server to accept a quest from a specified quest giver object.
 		///	@param questGiverGuid The guid quest giver object. Must be a valid object guid.
 		/// @param questId The id of the quest to accept. Must be a valid quest id offered by the quest giver object.
@@ -410,6 +420,10 @@ namespace mmo
 		/// Gets the id of the realm.
 		uint32 GetRealmId() const { return m_realmId; }
 
+		/// Gets the hash of the realm's queryable game data as sent on successful authentication. Persisted query caches
+		///	are only valid as long as this hash doesn't change.
+		uint64 GetQueryDataHash() const { return m_queryDataHash; }
+
 	public:
 		/// Gets a constant list of character views.
 		const std::vector<CharacterView>& GetCharacterViews() const { return m_characterViews; }
@@ -346,7 +346,8 @@ namespace mmo
 
 	void QuestClient::RefreshQuestGiverStatus()
 	{
-		ObjectMgr::ForEachObject<GameUnitC>([this](const std::shared_ptr<GameUnitC>& unit)
+		std::vector<uint64> questGiverGuids;
+		ObjectMgr::ForEachObject<GameUnitC>([&questGiverGuids](const std::shared_ptr<GameUnitC>& unit)
 			{
 				if (!unit)
 				{
@@ -355,9 +356,11 @@ namespace mmo
 
 				if (unit->Get<uint32>(object_fields::NpcFlags) & npc_flags::QuestGiver)
 				{
-					m_connector.UpdateQuestStatus(unit->GetGuid());
+					questGiverGuids.push_back(unit->GetGuid());
 				}
 			});
+
+		m_connector.UpdateQuestStatus(questGiverGuids);
 	}
 
 	void QuestClient::AbandonQuest(uint32 questId)
@@ -0,0 +1,38 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "bot_config.h"
+
+#include <array>
+
+namespace mmo
+{
+	namespace
+	{
+		const std::array<const char*, 6> s_scenarioNames = {
+			"login",
+			"move",
+			"cast",
+			"chat",
+			"zone",
+			"mixed"
+		};
+	}
+
+	std::optional<BotScenario> ParseBotScenario(const String& name)
+	{
+		for (size_t i = 0; i < s_scenarioNames.size(); ++i)
+		{
+			if (name == s_scenarioNames[i])
+			{
+				return static_cast<BotScenario>(i);
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	const char* BotScenarioName(const BotScenario scenario)
+	{
+		return s_scenarioNames[scenario];
+	}
+}
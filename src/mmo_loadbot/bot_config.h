@@ -0,0 +1,79 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+#include "base/constants.h"
+
+#include <optional>
+#include <vector>
+
+namespace mmo
+{
+	/// Enumerates the scripted behaviors a load bot can execute once it entered the world.
+	namespace bot_scenario
+	{
+		enum Type
+		{
+			/// Only log in and enter the world, then stay idle.
+			Login,
+			/// Walk along a square path around the spawn position.
+			Move,
+			/// Repeatedly cast a spell on the bot itself.
+			Cast,
+			/// Repeatedly say something in local chat.
+			Chat,
+			/// Repeatedly port between maps. Requires game master accounts.
+			Zone,
+			/// Combination of movement, casting and chatting.
+			Mixed
+		};
+	}
+
+	typedef bot_scenario::Type BotScenario;
+
+	/// Parses a scenario name as given on the command line.
+	/// @param name The scenario name, case sensitive.
+	/// @return The parsed scenario or an empty optional if the name is unknown.
+	std::optional<BotScenario> ParseBotScenario(const String& name);
+
+	/// Gets the display name of a scenario.
+	const char* BotScenarioName(BotScenario scenario);
+
+	/// Settings shared by all load bots of a single run.
+	struct BotConfig final
+	{
+		/// Address of the login server.
+		String loginAddress = "127.0.0.1";
+		/// Player port of the login server.
+		uint16 loginPort = constants::DefaultLoginPlayerPort;
+		/// Account names are generated by appending the bot index to this prefix.
+		String accountPrefix = "LOADBOT";
+		/// Password shared by all bot accounts.
+		String password = "LOADBOT";
+		/// Id of the realm to connect to. If not set, the first realm of the realm list is used.
+		std::optional<uint32> realmId;
+		/// Race and class used when a bot account has no character yet.
+		uint8 race = 1;
+		uint8 characterClass = 1;
+
+		/// Scripted behavior after entering the world.
+		BotScenario scenario = bot_scenario::Move;
+		/// Edge length of the square walked in the Move scenario.
+		float pathLength = 20.0f;
+		/// Movement speed in units per second. Should match the character's run speed.
+		float runSpeed = 7.0f;
+		/// Interval between movement heartbeats while moving in milliseconds.
+		uint32 heartbeatInterval = 500;
+		/// Spell cast in the Cast scenario.
+		uint32 spellId = 0;
+		/// Interval between spell casts in milliseconds.
+		uint32 castInterval = 3000;
+		/// Interval between chat messages in milliseconds.
+		uint32 chatInterval = 5000;
+		/// Maps to port between in the Zone scenario.
+		std::vector<uint32> zoneMaps;
+		/// Interval between map changes in milliseconds.
+		uint32 zoneInterval = 15000;
+	};
+}
@@ -0,0 +1,250 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "bot_login_connector.h"
+#include "version.h"
+
+#include "base/constants.h"
+#include "log/default_log_levels.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	BotLoginConnector::BotLoginConnector(asio::io_service& ioService)
+		: auth::Connector(std::make_unique<asio::ip::tcp::socket>(ioService), nullptr)
+		, m_ioService(ioService)
+	{
+	}
+
+	void BotLoginConnector::Connect(const String& address, const uint16 port, const String& accountName, const String& password)
+	{
+		m_accountName = accountName;
+		m_finished = false;
+
+		String upperPassword;
+		std::transform(password.begin(), password.end(), std::back_inserter(upperPassword), ::toupper);
+
+		const String authHash = m_accountName + ":" + upperPassword;
+		m_authHash = sha1(authHash.c_str(), authHash.size());
+
+		connect(address, port, *this, m_ioService);
+	}
+
+	bool BotLoginConnector::connectionEstablished(const bool success)
+	{
+		if (!success)
+		{
+			Fail(auth::auth_result::FailInvalidServer);
+			return true;
+		}
+
+		RegisterPacketHandler(auth::login_client_packet::LogonChallenge, *this, &BotLoginConnector::OnLogonChallenge);
+
+		sendSinglePacket([this](auth::OutgoingPacket& packet)
+		{
+			packet.Start(auth::client_login_packet::LogonChallenge);
+			packet
+				<< io::write<uint8>(mmo::Major)
+				<< io::write<uint8>(mmo::Minor)
+				<< io::write<uint8>(mmo::Build)
+				<< io::write<uint16>(mmo::Revision)
+				<< io::write<uint32>(0x656E5553)	// Locale: enUS
+				<< io::write_dynamic_range<uint8>(m_accountName);
+			packet.Finish();
+		});
+
+		return true;
+	}
+
+	void BotLoginConnector::connectionLost()
+	{
+		ClearPacketHandlers();
+		Fail(auth::auth_result::FailInternalError);
+	}
+
+	void BotLoginConnector::connectionMalformedPacket()
+	{
+		ELOG("[" << m_accountName << "] Received a malformed packet from the login server");
+	}
+
+	PacketParseResult BotLoginConnector::connectionPacketReceived(auth::IncomingPacket& packet)
+	{
+		return HandleIncomingPacket(packet);
+	}
+
+	PacketParseResult BotLoginConnector::OnLogonChallenge(auth::IncomingPacket& packet)
+	{
+		ClearPacketHandler(auth::login_client_packet::LogonChallenge);
+
+		uint8 result = 0;
+		if (!(packet >> io::read<uint8>(result)))
+		{
+			Fail(auth::auth_result::FailInternalError);
+			return PacketParseResult::Disconnect;
+		}
+
+		if (result != auth::auth_result::Success)
+		{
+			Fail(static_cast<auth::AuthResult>(result));
+			return PacketParseResult::Disconnect;
+		}
+
+		std::array<uint8, 32> B, N, s;
+		uint8 g = 0;
+		if (!(packet >> io::read_range(B) >> io::read<uint8>(g) >> io::read_range(N) >> io::read_range(s)))
+		{
+			Fail(auth::auth_result::FailInternalError);
+			return PacketParseResult::Disconnect;
+		}
+
+		CalculateProof(BigNumber(B.data(), B.size()), BigNumber(s.data(), s.size()));
+
+		RegisterPacketHandler(auth::login_client_packet::LogonProof, *this, &BotLoginConnector::OnLogonProof);
+
+		sendSinglePacket([this](auth::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(auth::client_login_packet::LogonProof);
+			outPacket << io::write_range(m_A.asByteArray(32));
+			outPacket << io::write_range(m_m1);
+			outPacket.Finish();
+		});
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotLoginConnector::OnLogonProof(auth::IncomingPacket& packet)
+	{
+		ClearPacketHandler(auth::login_client_packet::LogonProof);
+
+		uint8 result = 0;
+		if (!(packet >> io::read<uint8>(result)))
+		{
+			Fail(auth::auth_result::FailInternalError);
+			return PacketParseResult::Disconnect;
+		}
+
+		if (result != auth::auth_result::Success)
+		{
+			Fail(result < auth::auth_result::Count_ ? static_cast<auth::AuthResult>(result) : auth::auth_result::FailInternalError);
+			return PacketParseResult::Disconnect;
+		}
+
+		SHA1Hash serverM2;
+		if (!(packet >> io::read_range(serverM2)) || serverM2 != m_m2)
+		{
+			ELOG("[" << m_accountName << "] Login server sent an invalid proof");
+			Fail(auth::auth_result::FailInternalError);
+			return PacketParseResult::Disconnect;
+		}
+
+		// The login server sends the realm list right after a successful login
+		RegisterPacketHandler(auth::login_client_packet::RealmList, *this, &BotLoginConnector::OnRealmList);
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotLoginConnector::OnRealmList(auth::IncomingPacket& packet)
+	{
+		ClearPacketHandler(auth::login_client_packet::RealmList);
+
+		uint16 realmCount = 0;
+		if (!(packet >> io::read<uint16>(realmCount)))
+		{
+			Fail(auth::auth_result::FailInternalError);
+			return PacketParseResult::Disconnect;
+		}
+
+		std::vector<BotRealmEntry> realms(realmCount);
+		for (auto& realm : realms)
+		{
+			if (!(packet
+				>> io::read<uint32>(realm.id)
+				>> io::read_container<uint8>(realm.name)
+				>> io::read_container<uint8>(realm.address)
+				>> io::read<uint16>(realm.port)))
+			{
+				Fail(auth::auth_result::FailInternalError);
+				return PacketParseResult::Disconnect;
+			}
+		}
+
+		// We are done with the login server, listeners may close this connection now
+		m_finished = true;
+		RealmListReceived(realms);
+
+		return PacketParseResult::Pass;
+	}
+
+	void BotLoginConnector::CalculateProof(const BigNumber& B, const BigNumber& s)
+	{
+		BigNumber a;
+		a.setRand(19 * 8);
+
+		HashGeneratorSha1 gen;
+		gen.update(reinterpret_cast<const char*>(s.asByteArray().data()), s.getNumBytes());
+		gen.update(reinterpret_cast<const char*>(m_authHash.data()), m_authHash.size());
+		const SHA1Hash xHash = gen.finalize();
+		BigNumber x{ xHash.data(), xHash.size() };
+
+		m_A = constants::srp::g.modExp(a, constants::srp::N);
+
+		const SHA1Hash uHash = Sha1_BigNumbers({ m_A, B });
+		BigNumber u{ uHash.data(), uHash.size() };
+
+		// Add k * N so that the base of the exponentiation never becomes negative
+		BigNumber k{ 3 };
+		BigNumber N = constants::srp::N;
+		BigNumber base = B;
+		base = (base + k * N) - k * constants::srp::g.modExp(x, constants::srp::N);
+		const BigNumber S = base.modExp(a + u * x, constants::srp::N);
+
+		// Interleaved hash of S forms the session key
+		char S1[16], S2[16];
+		const auto arrS = S.asByteArray(32);
+		for (uint32 i = 0; i < 16; i++)
+		{
+			S1[i] = arrS[i * 2];
+			S2[i] = arrS[i * 2 + 1];
+		}
+
+		const SHA1Hash S1hash = sha1(S1, 16);
+		const SHA1Hash S2hash = sha1(S2, 16);
+
+		uint8 S_hash[40];
+		for (uint32 i = 0; i < 20; i++)
+		{
+			S_hash[i * 2] = S1hash[i];
+			S_hash[i * 2 + 1] = S2hash[i];
+		}
+		m_sessionKey.setBinary(S_hash, 40);
+
+		const SHA1Hash userHash = sha1(m_accountName.c_str(), m_accountName.size());
+		const SHA1Hash Nhash = Sha1_BigNumbers({ constants::srp::N });
+		const SHA1Hash ghash = Sha1_BigNumbers({ constants::srp::g });
+
+		uint8 Ng_hash[20];
+		for (uint32 i = 0; i < 20; i++) Ng_hash[i] = Nhash[i] ^ ghash[i];
+
+		const BigNumber t_acc{ userHash.data(), userHash.size() };
+		const BigNumber t_Ng_hash{ Ng_hash, 20 };
+
+		Sha1_Add_BigNumbers(gen, { t_Ng_hash, t_acc, s, m_A, B });
+		gen.update(reinterpret_cast<const char*>(S_hash), 40);
+		m_m1 = gen.finalize();
+
+		Sha1_Add_BigNumbers(gen, { m_A });
+		gen.update(reinterpret_cast<const char*>(m_m1.data()), m_m1.size());
+		gen.update(reinterpret_cast<const char*>(S_hash), 40);
+		m_m2 = gen.finalize();
+	}
+
+	void BotLoginConnector::Fail(const auth::AuthResult result)
+	{
+		if (m_finished)
+		{
+			return;
+		}
+
+		m_finished = true;
+		LoginFailed(result);
+	}
+}
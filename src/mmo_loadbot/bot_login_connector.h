@@ -0,0 +1,83 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "auth_protocol/auth_connector.h"
+#include "base/big_number.h"
+#include "base/sha1.h"
+#include "base/signal.h"
+
+#include "asio/io_service.hpp"
+
+namespace mmo
+{
+	/// Realm list entry as received by a load bot.
+	struct BotRealmEntry final
+	{
+		uint32 id = 0;
+		String name;
+		String address;
+		uint16 port = 0;
+	};
+
+	/// Performs the srp6 login of a single load bot at the login server and requests the realm list.
+	class BotLoginConnector final
+		: public auth::Connector
+		, public auth::IConnectorListener
+	{
+	public:
+		/// Fired when the login failed for any reason, including a lost connection.
+		signal<void(auth::AuthResult)> LoginFailed;
+
+		/// Fired when the realm list has been received after a successful login.
+		signal<void(const std::vector<BotRealmEntry>&)> RealmListReceived;
+
+	public:
+		explicit BotLoginConnector(asio::io_service& ioService);
+
+	public:
+		/// Connects to the login server and starts the login process.
+		/// @param address The login server address.
+		/// @param port The login server player port.
+		/// @param accountName The account name, in upper case letters.
+		/// @param password The account password.
+		void Connect(const String& address, uint16 port, const String& accountName, const String& password);
+
+		/// Gets the session key. Only valid after a successful login.
+		const BigNumber& GetSessionKey() const { return m_sessionKey; }
+
+		/// Gets the account name used to log in.
+		const String& GetAccountName() const { return m_accountName; }
+
+	public:
+		// ~ Begin IConnectorListener
+		bool connectionEstablished(bool success) override;
+		void connectionLost() override;
+		void connectionMalformedPacket() override;
+		PacketParseResult connectionPacketReceived(auth::IncomingPacket& packet) override;
+		// ~ End IConnectorListener
+
+	private:
+		PacketParseResult OnLogonChallenge(auth::IncomingPacket& packet);
+
+		PacketParseResult OnLogonProof(auth::IncomingPacket& packet);
+
+		PacketParseResult OnRealmList(auth::IncomingPacket& packet);
+
+		/// Calculates A, M1, the expected M2 and the session key from the server values.
+		void CalculateProof(const BigNumber& B, const BigNumber& s);
+
+		/// Fires LoginFailed at most once.
+		void Fail(auth::AuthResult result);
+
+	private:
+		asio::io_service& m_ioService;
+		String m_accountName;
+		SHA1Hash m_authHash;
+		BigNumber m_A;
+		SHA1Hash m_m1;
+		SHA1Hash m_m2;
+		BigNumber m_sessionKey;
+		bool m_finished = false;
+	};
+}
@@ -0,0 +1,129 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "bot_realm_connector.h"
+#include "version.h"
+
+#include "base/sha1.h"
+#include "log/default_log_levels.h"
+
+#include <random>
+
+namespace mmo
+{
+	BotRealmConnector::BotRealmConnector(asio::io_service& ioService)
+		: game::Connector(std::make_unique<asio::ip::tcp::socket>(ioService), nullptr)
+		, m_ioService(ioService)
+	{
+	}
+
+	void BotRealmConnector::Connect(const String& address, const uint16 port, const String& accountName, const BigNumber& sessionKey)
+	{
+		m_accountName = accountName;
+		m_sessionKey = sessionKey;
+
+		connect(address, port, *this, m_ioService);
+	}
+
+	bool BotRealmConnector::connectionEstablished(const bool success)
+	{
+		if (!success)
+		{
+			Disconnected();
+			return true;
+		}
+
+		m_clientSeed = std::random_device{}();
+		RegisterPacketHandler(game::realm_client_packet::AuthChallenge, *this, &BotRealmConnector::OnAuthChallenge);
+
+		return true;
+	}
+
+	void BotRealmConnector::connectionLost()
+	{
+		ClearPacketHandlers();
+		Disconnected();
+	}
+
+	void BotRealmConnector::connectionMalformedPacket()
+	{
+		ELOG("[" << m_accountName << "] Received a malformed packet from the realm server");
+	}
+
+	PacketParseResult BotRealmConnector::connectionPacketReceived(game::IncomingPacket& packet)
+	{
+		PacketReceived(packet);
+		return HandleIncomingPacket(packet);
+	}
+
+	PacketParseResult BotRealmConnector::HandleIncomingPacket(game::IncomingPacket& packet)
+	{
+		PacketHandler handler = nullptr;
+		{
+			std::scoped_lock lock{ m_packetHandlerMutex };
+
+			const auto it = m_packetHandlers.find(packet.GetId());
+			if (it == m_packetHandlers.end())
+			{
+				return PacketParseResult::Pass;
+			}
+
+			handler = it->second;
+		}
+
+		return handler(packet);
+	}
+
+	PacketParseResult BotRealmConnector::OnAuthChallenge(game::IncomingPacket& packet)
+	{
+		ClearPacketHandler(game::realm_client_packet::AuthChallenge);
+
+		uint32 serverSeed = 0;
+		if (!(packet >> io::read<uint32>(serverSeed)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		HashGeneratorSha1 hashGen;
+		hashGen.update(m_accountName.data(), m_accountName.length());
+		hashGen.update(reinterpret_cast<const char*>(&m_clientSeed), sizeof(m_clientSeed));
+		hashGen.update(reinterpret_cast<const char*>(&serverSeed), sizeof(serverSeed));
+		Sha1_Add_BigNumbers(hashGen, { m_sessionKey });
+		const SHA1Hash hash = hashGen.finalize();
+
+		RegisterPacketHandler(game::realm_client_packet::AuthSessionResponse, *this, &BotRealmConnector::OnAuthSessionResponse);
+
+		sendSinglePacket([this, &hash](game::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(game::client_realm_packet::AuthSession);
+			outPacket
+				<< io::write<uint32>(mmo::Revision)
+				<< io::write_dynamic_range<uint8>(m_accountName)
+				<< io::write<uint32>(m_clientSeed)
+				<< io::write_range(hash);
+			outPacket.Finish();
+		});
+
+		// Everything after the session packet is encrypted
+		HMACHash cryptKey;
+		GetCrypt().GenerateKey(cryptKey, m_sessionKey);
+		GetCrypt().SetKey(cryptKey.data(), cryptKey.size());
+		GetCrypt().Init();
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotRealmConnector::OnAuthSessionResponse(game::IncomingPacket& packet)
+	{
+		ClearPacketHandler(game::realm_client_packet::AuthSessionResponse);
+
+		uint8 result = 0;
+		if (!(packet >> io::read<uint8>(result)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		AuthenticationResult(result);
+
+		return result == game::auth_result::Success ? PacketParseResult::Pass : PacketParseResult::Disconnect;
+	}
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "game_protocol/game_connector.h"
+#include "base/big_number.h"
+#include "base/signal.h"
+
+#include "asio/io_service.hpp"
+
+namespace mmo
+{
+	/// Connection of a single load bot to a realm server. Performs the session handshake and leaves everything
+	/// else to packet handlers registered by the bot.
+	class BotRealmConnector final
+		: public game::Connector
+		, public game::IConnectorListener
+	{
+	public:
+		/// Fired when the realm answered the session handshake. The argument is a game::auth_result value.
+		signal<void(uint8)> AuthenticationResult;
+
+		/// Fired when the connection could not be established or was lost.
+		signal<void()> Disconnected;
+
+		/// Fired for every received packet, including packets without a registered handler.
+		signal<void(const game::IncomingPacket&)> PacketReceived;
+
+	public:
+		explicit BotRealmConnector(asio::io_service& ioService);
+
+	public:
+		/// Connects to a realm server and authenticates using the session key of the login server.
+		void Connect(const String& address, uint16 port, const String& accountName, const BigNumber& sessionKey);
+
+	public:
+		// ~ Begin IConnectorListener
+		bool connectionEstablished(bool success) override;
+		void connectionLost() override;
+		void connectionMalformedPacket() override;
+		PacketParseResult connectionPacketReceived(game::IncomingPacket& packet) override;
+		// ~ End IConnectorListener
+
+	protected:
+		/// Unlike the game client, bots silently ignore packets they have no handler for.
+		PacketParseResult HandleIncomingPacket(game::IncomingPacket& packet) override;
+
+	private:
+		PacketParseResult OnAuthChallenge(game::IncomingPacket& packet);
+
+		PacketParseResult OnAuthSessionResponse(game::IncomingPacket& packet);
+
+	private:
+		asio::io_service& m_ioService;
+		String m_accountName;
+		BigNumber m_sessionKey;
+		uint32 m_clientSeed = 0;
+	};
+}
@@ -0,0 +1,55 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace mmo
+{
+	void LatencyHistogram::Record(const double milliseconds)
+	{
+		std::scoped_lock lock{ m_mutex };
+		m_samples.push_back(milliseconds);
+	}
+
+	LatencyHistogram::Summary LatencyHistogram::Summarize() const
+	{
+		std::vector<double> samples;
+		{
+			std::scoped_lock lock{ m_mutex };
+			samples = m_samples;
+		}
+
+		Summary summary;
+		if (samples.empty())
+		{
+			return summary;
+		}
+
+		std::sort(samples.begin(), samples.end());
+
+		// Nearest rank percentile
+		const auto percentile = [&samples](const double p)
+		{
+			const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(samples.size())));
+			return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+		};
+
+		summary.count = samples.size();
+		summary.min = samples.front();
+		summary.max = samples.back();
+		summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+		summary.p50 = percentile(0.50);
+		summary.p90 = percentile(0.90);
+		summary.p99 = percentile(0.99);
+		return summary;
+	}
+
+	void LatencyHistogram::Reset()
+	{
+		std::scoped_lock lock{ m_mutex };
+		m_samples.clear();
+	}
+}
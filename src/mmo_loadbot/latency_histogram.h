@@ -0,0 +1,47 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+#include "base/non_copyable.h"
+
+#include <mutex>
+#include <vector>
+
+namespace mmo
+{
+	/// Collects latency samples from multiple threads and calculates percentiles over them.
+	class LatencyHistogram final : public NonCopyable
+	{
+	public:
+		/// Summary of all samples recorded so far.
+		struct Summary final
+		{
+			size_t count = 0;
+			double min = 0.0;
+			double mean = 0.0;
+			double p50 = 0.0;
+			double p90 = 0.0;
+			double p99 = 0.0;
+			double max = 0.0;
+		};
+
+	public:
+		LatencyHistogram() = default;
+
+	public:
+		/// Records a new sample. Thread safe.
+		/// @param milliseconds The measured latency in milliseconds.
+		void Record(double milliseconds);
+
+		/// Calculates the summary of all samples recorded so far. Thread safe.
+		[[nodiscard]] Summary Summarize() const;
+
+		/// Removes all recorded samples. Thread safe.
+		void Reset();
+
+	private:
+		mutable std::mutex m_mutex;
+		std::vector<double> m_samples;
+	};
+}
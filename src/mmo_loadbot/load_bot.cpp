@@ -0,0 +1,663 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "load_bot.h"
+
+#include "base/clock.h"
+#include "game/character_view.h"
+#include "game/chat_type.h"
+#include "game/spell_target_map.h"
+#include "log/default_log_levels.h"
+#include "math/constants.h"
+
+#include <cmath>
+
+namespace mmo
+{
+	namespace
+	{
+		/// Generates a unique character name containing only letters, since character names may not contain digits.
+		String MakeCharacterName(uint32 index)
+		{
+			String suffix;
+			for (int i = 0; i < 6; ++i)
+			{
+				suffix.insert(suffix.begin(), static_cast<char>('a' + index % 26));
+				index /= 26;
+			}
+
+			return "Lb" + suffix;
+		}
+
+		/// Prefix of chat messages sent by bots, followed by a sequence number used to match the echo.
+		const String ChatMessagePrefix = "loadbot #";
+	}
+
+	LoadBot::LoadBot(const uint32 index, const BotConfig& config, LoadMetrics& metrics, asio::io_service& ioService, TimerQueue& timers)
+		: m_index(index)
+		, m_config(config)
+		, m_metrics(metrics)
+		, m_ioService(ioService)
+		, m_timers(timers)
+		, m_accountName(config.accountPrefix + std::to_string(index))
+	{
+		std::transform(m_accountName.begin(), m_accountName.end(), m_accountName.begin(), ::toupper);
+	}
+
+	LoadBot::~LoadBot()
+	{
+		Stop();
+	}
+
+	void LoadBot::Start()
+	{
+		m_stopped = false;
+		m_loginStart = BotClock::now();
+
+		m_loginConnector = std::make_shared<BotLoginConnector>(m_ioService);
+		m_connections += {
+			m_loginConnector->LoginFailed.connect(*this, &LoadBot::OnLoginFailed),
+			m_loginConnector->RealmListReceived.connect(*this, &LoadBot::OnRealmListReceived)
+		};
+
+		m_loginConnector->Connect(m_config.loginAddress, m_config.loginPort, m_accountName, m_config.password);
+	}
+
+	void LoadBot::Stop()
+	{
+		if (m_stopped)
+		{
+			return;
+		}
+
+		m_stopped = true;
+		m_connections.disconnect();
+
+		if (m_inWorld)
+		{
+			m_inWorld = false;
+			--m_metrics.botsInWorld;
+		}
+
+		if (m_loginConnector)
+		{
+			m_loginConnector->ClearPacketHandlers();
+			m_loginConnector->resetListener();
+			m_loginConnector->close();
+			m_loginConnector.reset();
+		}
+
+		if (m_realmConnector)
+		{
+			m_realmConnector->ClearPacketHandlers();
+			m_realmConnector->resetListener();
+			m_realmConnector->close();
+			m_realmConnector.reset();
+		}
+	}
+
+	void LoadBot::OnLoginFailed(const auth::AuthResult result)
+	{
+		WLOG("[" << m_accountName << "] Login failed with result " << static_cast<uint16>(result));
+		++m_metrics.loginFailures;
+
+		// Connections can't be closed from within their own callbacks
+		m_ioService.post([weakThis = weak_from_this()]()
+		{
+			if (const auto strongThis = weakThis.lock())
+			{
+				strongThis->Stop();
+			}
+		});
+	}
+
+	void LoadBot::OnRealmListReceived(const std::vector<BotRealmEntry>& realms)
+	{
+		m_metrics.loginTime.Record(MillisecondsSince(m_loginStart));
+
+		const auto realm = std::find_if(realms.begin(), realms.end(), [this](const BotRealmEntry& entry)
+		{
+			return !m_config.realmId || entry.id == *m_config.realmId;
+		});
+
+		if (realm == realms.end())
+		{
+			OnLoginFailed(auth::auth_result::FailNoAccess);
+			return;
+		}
+
+		const BigNumber sessionKey = m_loginConnector->GetSessionKey();
+
+		// We no longer need the login server connection
+		m_ioService.post([connector = m_loginConnector]()
+		{
+			connector->ClearPacketHandlers();
+			connector->resetListener();
+			connector->close();
+		});
+		m_loginConnector.reset();
+
+		m_realmConnector = std::make_shared<BotRealmConnector>(m_ioService);
+		m_connections += {
+			m_realmConnector->AuthenticationResult.connect(*this, &LoadBot::OnRealmAuthenticated),
+			m_realmConnector->Disconnected.connect(*this, &LoadBot::OnRealmDisconnected),
+			m_realmConnector->PacketReceived.connect(*this, &LoadBot::OnRealmPacketReceived)
+		};
+
+		m_realmConnector->Connect(realm->address, realm->port, m_accountName, sessionKey);
+	}
+
+	void LoadBot::OnRealmAuthenticated(const uint8 result)
+	{
+		if (result != game::auth_result::Success)
+		{
+			WLOG("[" << m_accountName << "] Realm authentication failed with result " << static_cast<uint16>(result));
+			++m_metrics.loginFailures;
+			return;
+		}
+
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::CharEnum, *this, &LoadBot::OnCharEnum);
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::CharCreateResponse, *this, &LoadBot::OnCharCreateResponse);
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::LoginVerifyWorld, *this, &LoadBot::OnLoginVerifyWorld);
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::EnterWorldFailed, *this, &LoadBot::OnEnterWorldFailed);
+
+		m_realmConnector->sendSinglePacket([](game::OutgoingPacket& packet)
+		{
+			packet.Start(game::client_realm_packet::CharEnum);
+			packet.Finish();
+		});
+	}
+
+	void LoadBot::OnRealmDisconnected()
+	{
+		WLOG("[" << m_accountName << "] Lost connection to the realm server");
+		++m_metrics.disconnects;
+
+		m_ioService.post([weakThis = weak_from_this()]()
+		{
+			if (const auto strongThis = weakThis.lock())
+			{
+				strongThis->Stop();
+			}
+		});
+	}
+
+	void LoadBot::OnRealmPacketReceived(const game::IncomingPacket& packet)
+	{
+		++m_metrics.packetsReceived;
+
+		if (packet.GetId() == game::realm_client_packet::UpdateObject || packet.GetId() == game::realm_client_packet::CompressedUpdateObject)
+		{
+			++m_metrics.updatePacketsReceived;
+			m_metrics.updateBytesReceived += packet.GetSize();
+		}
+	}
+
+	PacketParseResult LoadBot::OnCharEnum(game::IncomingPacket& packet)
+	{
+		std::vector<CharacterView> characters;
+		if (!(packet >> io::read_container<uint8>(characters)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		if (characters.empty())
+		{
+			if (m_createdCharacter)
+			{
+				ELOG("[" << m_accountName << "] Character list is still empty after creating a character");
+				++m_metrics.loginFailures;
+				return PacketParseResult::Disconnect;
+			}
+
+			m_createdCharacter = true;
+
+			const String name = MakeCharacterName(m_index);
+			m_realmConnector->sendSinglePacket([this, &name](game::OutgoingPacket& outPacket)
+			{
+				outPacket.Start(game::client_realm_packet::CreateChar);
+				outPacket
+					<< io::write_dynamic_range<uint8>(name)
+					<< io::write<uint8>(m_config.race)
+					<< io::write<uint8>(m_config.characterClass)
+					<< io::write<uint8>(0);
+				outPacket.Finish();
+			});
+
+			return PacketParseResult::Pass;
+		}
+
+		m_realmConnector->ClearPacketHandler(game::realm_client_packet::CharEnum);
+		m_realmConnector->ClearPacketHandler(game::realm_client_packet::CharCreateResponse);
+
+		m_guid = characters.front().GetGuid();
+		m_realmConnector->sendSinglePacket([this](game::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(game::client_realm_packet::EnterWorld);
+			outPacket << io::write<uint64>(m_guid);
+			outPacket.Finish();
+		});
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult LoadBot::OnCharCreateResponse(game::IncomingPacket& packet)
+	{
+		// The realm only sends this packet if the character could not be created
+		uint8 result = 0;
+		packet >> io::read<uint8>(result);
+
+		ELOG("[" << m_accountName << "] Failed to create a character: " << static_cast<uint16>(result));
+		++m_metrics.loginFailures;
+
+		return PacketParseResult::Disconnect;
+	}
+
+	PacketParseResult LoadBot::OnLoginVerifyWorld(game::IncomingPacket& packet)
+	{
+		m_realmConnector->ClearPacketHandler(game::realm_client_packet::LoginVerifyWorld);
+
+		uint32 mapId = 0;
+		Vector3 position;
+		float facing = 0.0f;
+		if (!(packet
+			>> io::read<uint32>(mapId)
+			>> io::read<float>(position.x)
+			>> io::read<float>(position.y)
+			>> io::read<float>(position.z)
+			>> io::read<float>(facing)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		m_metrics.enterWorldTime.Record(MillisecondsSince(m_loginStart));
+		EnterWorld(mapId, position, facing);
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult LoadBot::OnEnterWorldFailed(game::IncomingPacket& packet)
+	{
+		uint8 response = 0;
+		packet >> io::read<uint8>(response);
+
+		ELOG("[" << m_accountName << "] Failed to enter the world: " << static_cast<uint16>(response));
+		++m_metrics.loginFailures;
+
+		return PacketParseResult::Disconnect;
+	}
+
+	PacketParseResult LoadBot::OnMovement(game::IncomingPacket& packet)
+	{
+		uint64 guid = 0;
+		MovementInfo info;
+		if (!(packet >> io::read<uint64>(guid) >> info))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		if (guid != m_guid)
+		{
+			const double elapsed = m_metrics.movementTracker.OnReceived(guid, info.timestamp);
+			if (elapsed >= 0.0)
+			{
+				m_metrics.movementEcho.Record(elapsed);
+			}
+		}
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult LoadBot::OnChatMessage(game::IncomingPacket& packet)
+	{
+		uint64 sender = 0;
+		uint8 type = 0;
+		String message;
+		if (!(packet >> io::read_packed_guid(sender) >> io::read<uint8>(type) >> io::read_string(message)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		if (sender != m_guid || message.compare(0, ChatMessagePrefix.size(), ChatMessagePrefix) != 0)
+		{
+			return PacketParseResult::Pass;
+		}
+
+		const uint32 sequence = static_cast<uint32>(std::strtoul(message.c_str() + ChatMessagePrefix.size(), nullptr, 10));
+		if (const auto it = m_pendingChatMessages.find(sequence); it != m_pendingChatMessages.end())
+		{
+			m_metrics.chatEcho.Record(MillisecondsSince(it->second));
+			m_pendingChatMessages.erase(m_pendingChatMessages.begin(), std::next(it));
+		}
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult LoadBot::OnSpellResult(game::IncomingPacket& packet)
+	{
+		uint64 caster = 0;
+		uint32 spellId = 0;
+		if (!(packet >> io::read_packed_guid(caster) >> io::read<uint32>(spellId)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		if (caster != m_guid || spellId != m_config.spellId)
+		{
+			return PacketParseResult::Pass;
+		}
+
+		// Casts with a cast time are answered by SpellStart first, so the following SpellGo is ignored
+		if (packet.GetId() == game::realm_client_packet::SpellGo && m_castStarted)
+		{
+			m_castStarted = false;
+			return PacketParseResult::Pass;
+		}
+
+		if (!m_pendingCasts.empty())
+		{
+			m_metrics.spellResponse.Record(MillisecondsSince(m_pendingCasts.front()));
+			m_pendingCasts.pop_front();
+			m_castStarted = packet.GetId() == game::realm_client_packet::SpellStart;
+		}
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult LoadBot::OnNewWorld(game::IncomingPacket& packet)
+	{
+		uint32 mapId = 0;
+		Vector3 position;
+		float facing = 0.0f;
+		if (!(packet
+			>> io::read<uint32>(mapId)
+			>> io::read<float>(position.x)
+			>> io::read<float>(position.y)
+			>> io::read<float>(position.z)
+			>> io::read<float>(facing)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		if (m_transferring)
+		{
+			m_metrics.zoneTransfer.Record(MillisecondsSince(m_transferStart));
+			m_transferring = false;
+		}
+
+		m_mapId = mapId;
+		m_movementInfo.movementFlags = movement_flags::None;
+		m_movementInfo.position = position;
+		m_movementInfo.facing = Radian(facing);
+
+		m_realmConnector->sendSinglePacket([](game::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(game::client_realm_packet::MoveWorldPortAck);
+			outPacket.Finish();
+		});
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult LoadBot::OnMoveTeleport(game::IncomingPacket& packet)
+	{
+		uint64 guid = 0;
+		uint32 ackId = 0;
+		MovementInfo info;
+		if (!(packet >> io::read_packed_guid(guid) >> io::read<uint32>(ackId) >> info))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		if (guid != m_guid)
+		{
+			return PacketParseResult::Pass;
+		}
+
+		// Ports on the same map are executed as teleport instead of a world change
+		if (m_transferring)
+		{
+			m_metrics.zoneTransfer.Record(MillisecondsSince(m_transferStart));
+			m_transferring = false;
+		}
+
+		m_movementInfo = info;
+		m_realmConnector->sendSinglePacket([this, ackId](game::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(game::client_realm_packet::MoveTeleportAck);
+			outPacket << io::write<uint32>(ackId) << m_movementInfo;
+			outPacket.Finish();
+		});
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult LoadBot::OnForceMovementSpeedChange(game::IncomingPacket& packet)
+	{
+		static const std::map<uint16, uint16> s_ackOpCodes = {
+			{ game::realm_client_packet::ForceMoveSetWalkSpeed, game::client_realm_packet::ForceMoveSetWalkSpeedAck },
+			{ game::realm_client_packet::ForceMoveSetRunSpeed, game::client_realm_packet::ForceMoveSetRunSpeedAck },
+			{ game::realm_client_packet::ForceMoveSetRunBackSpeed, game::client_realm_packet::ForceMoveSetRunBackSpeedAck },
+			{ game::realm_client_packet::ForceMoveSetSwimSpeed, game::client_realm_packet::ForceMoveSetSwimSpeedAck },
+			{ game::realm_client_packet::ForceMoveSetSwimBackSpeed, game::client_realm_packet::ForceMoveSetSwimBackSpeedAck },
+			{ game::realm_client_packet::ForceMoveSetTurnRate, game::client_realm_packet::ForceMoveSetTurnRateAck },
+			{ game::realm_client_packet::ForceSetFlightSpeed, game::client_realm_packet::ForceSetFlightSpeedAck },
+			{ game::realm_client_packet::ForceSetFlightBackSpeed, game::client_realm_packet::ForceSetFlightBackSpeedAck }
+		};
+
+		uint32 ackId = 0;
+		float speed = 0.0f;
+		if (!(packet >> io::read<uint32>(ackId) >> io::read<float>(speed)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		// Bots keep walking with the configured speed, but the server expects every speed change to be acknowledged
+		const uint16 ackOpCode = s_ackOpCodes.at(packet.GetId());
+		m_realmConnector->sendSinglePacket([this, ackOpCode, ackId, speed](game::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(ackOpCode);
+			outPacket << io::write<uint32>(ackId) << m_movementInfo << io::write<float>(speed);
+			outPacket.Finish();
+		});
+
+		return PacketParseResult::Pass;
+	}
+
+	void LoadBot::EnterWorld(const uint32 mapId, const Vector3& position, const float facing)
+	{
+		m_inWorld = true;
+		++m_metrics.botsInWorld;
+
+		m_mapId = mapId;
+		m_spawnPosition = position;
+		m_movementInfo.movementFlags = movement_flags::None;
+		m_movementInfo.position = position;
+		m_movementInfo.facing = Radian(facing);
+
+		for (const uint16 opCode : {
+			game::realm_client_packet::MoveStartForward, game::realm_client_packet::MoveStartBackward, game::realm_client_packet::MoveStop,
+			game::realm_client_packet::MoveStartStrafeLeft, game::realm_client_packet::MoveStartStrafeRight, game::realm_client_packet::MoveStopStrafe,
+			game::realm_client_packet::MoveStartTurnLeft, game::realm_client_packet::MoveStartTurnRight, game::realm_client_packet::MoveStopTurn,
+			game::realm_client_packet::MoveHeartBeat, game::realm_client_packet::MoveSetFacing, game::realm_client_packet::MoveJump,
+			game::realm_client_packet::MoveFallLand, game::realm_client_packet::MoveEnded })
+		{
+			m_realmConnector->RegisterPacketHandler(opCode, *this, &LoadBot::OnMovement);
+		}
+
+		for (const uint16 opCode : {
+			game::realm_client_packet::ForceMoveSetWalkSpeed, game::realm_client_packet::ForceMoveSetRunSpeed, game::realm_client_packet::ForceMoveSetRunBackSpeed,
+			game::realm_client_packet::ForceMoveSetSwimSpeed, game::realm_client_packet::ForceMoveSetSwimBackSpeed, game::realm_client_packet::ForceMoveSetTurnRate,
+			game::realm_client_packet::ForceSetFlightSpeed, game::realm_client_packet::ForceSetFlightBackSpeed })
+		{
+			m_realmConnector->RegisterPacketHandler(opCode, *this, &LoadBot::OnForceMovementSpeedChange);
+		}
+
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::ChatMessage, *this, &LoadBot::OnChatMessage);
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::SpellStart, *this, &LoadBot::OnSpellResult);
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::SpellGo, *this, &LoadBot::OnSpellResult);
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::SpellFailure, *this, &LoadBot::OnSpellResult);
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::NewWorld, *this, &LoadBot::OnNewWorld);
+		m_realmConnector->RegisterPacketHandler(game::realm_client_packet::MoveTeleportAck, *this, &LoadBot::OnMoveTeleport);
+
+		// Spread the scenario actions of all bots so they don't fire in lock step
+		const GameTime offset = (m_index * 97) % 1000;
+
+		const BotScenario scenario = m_config.scenario;
+		if (scenario == bot_scenario::Move || scenario == bot_scenario::Mixed)
+		{
+			Schedule(offset, [this]() { StartPathLeg(); });
+		}
+		if ((scenario == bot_scenario::Cast || scenario == bot_scenario::Mixed) && m_config.spellId != 0)
+		{
+			Schedule(offset + m_config.castInterval, [this]() { CastSpell(); });
+		}
+		if (scenario == bot_scenario::Chat || scenario == bot_scenario::Mixed)
+		{
+			Schedule(offset + m_config.chatInterval, [this]() { SendChatMessage(); });
+		}
+		if (scenario == bot_scenario::Zone && !m_config.zoneMaps.empty())
+		{
+			Schedule(offset + m_config.zoneInterval, [this]() { ChangeZone(); });
+		}
+	}
+
+	void LoadBot::Schedule(const GameTime delay, std::function<void()> callback)
+	{
+		m_timers.AddEvent([weakThis = weak_from_this(), callback = std::move(callback)]()
+		{
+			if (const auto strongThis = weakThis.lock(); strongThis && strongThis->m_inWorld)
+			{
+				callback();
+			}
+		}, m_timers.GetNow() + delay);
+	}
+
+	void LoadBot::StartPathLeg()
+	{
+		if (m_transferring)
+		{
+			Schedule(m_config.heartbeatInterval, [this]() { StartPathLeg(); });
+			return;
+		}
+
+		// Walk a square: turn by 90 degrees after every edge
+		m_movementInfo.facing = Radian(static_cast<float>(m_pathLeg % 4) * HalfPi);
+		SendMovement(game::client_realm_packet::MoveSetFacing);
+
+		m_movementInfo.movementFlags |= movement_flags::Forward;
+		SendMovement(game::client_realm_packet::MoveStartForward);
+
+		m_legDistance = 0.0f;
+		m_lastHeartbeat = m_timers.GetNow();
+		Schedule(m_config.heartbeatInterval, [this]() { MovementHeartbeat(); });
+	}
+
+	void LoadBot::MovementHeartbeat()
+	{
+		if (m_transferring)
+		{
+			m_movementInfo.movementFlags &= ~movement_flags::Forward;
+			Schedule(m_config.heartbeatInterval, [this]() { StartPathLeg(); });
+			return;
+		}
+
+		const GameTime now = m_timers.GetNow();
+		const float step = std::min(m_config.runSpeed * static_cast<float>(now - m_lastHeartbeat) / 1000.0f, m_config.pathLength - m_legDistance);
+		m_lastHeartbeat = now;
+		m_legDistance += step;
+
+		// Same forward vector as used by the server
+		const float facing = m_movementInfo.facing.GetValueRadians();
+		m_movementInfo.position += Vector3(std::cos(facing), 0.0f, -std::sin(facing)) * step;
+
+		if (m_legDistance >= m_config.pathLength)
+		{
+			m_movementInfo.movementFlags &= ~movement_flags::Forward;
+			SendMovement(game::client_realm_packet::MoveStop);
+
+			++m_pathLeg;
+			Schedule(m_config.heartbeatInterval, [this]() { StartPathLeg(); });
+			return;
+		}
+
+		SendMovement(game::client_realm_packet::MoveHeartBeat);
+		Schedule(m_config.heartbeatInterval, [this]() { MovementHeartbeat(); });
+	}
+
+	void LoadBot::SendMovement(const uint16 opCode)
+	{
+		m_movementInfo.timestamp = GetAsyncTimeMs();
+		m_metrics.movementTracker.OnSent(m_guid, m_movementInfo.timestamp);
+		++m_metrics.movementPacketsSent;
+
+		m_realmConnector->sendSinglePacket([this, opCode](game::OutgoingPacket& packet)
+		{
+			packet.Start(opCode);
+			packet << io::write<uint64>(m_guid) << m_movementInfo;
+			packet.Finish();
+		});
+	}
+
+	void LoadBot::CastSpell()
+	{
+		if (!m_transferring)
+		{
+			SpellTargetMap targetMap;
+			targetMap.SetTargetMap(spell_cast_target_flags::Unit);
+			targetMap.SetUnitTarget(m_guid);
+
+			m_pendingCasts.push_back(BotClock::now());
+			m_realmConnector->sendSinglePacket([this, &targetMap](game::OutgoingPacket& packet)
+			{
+				packet.Start(game::client_realm_packet::CastSpell);
+				packet << io::write<uint32>(m_config.spellId) << targetMap;
+				packet.Finish();
+			});
+		}
+
+		Schedule(m_config.castInterval, [this]() { CastSpell(); });
+	}
+
+	void LoadBot::SendChatMessage()
+	{
+		if (!m_transferring)
+		{
+			const uint32 sequence = ++m_chatSequence;
+			m_pendingChatMessages[sequence] = BotClock::now();
+
+			const String message = ChatMessagePrefix + std::to_string(sequence);
+			m_realmConnector->sendSinglePacket([&message](game::OutgoingPacket& packet)
+			{
+				packet.Start(game::client_realm_packet::ChatMessage);
+				packet << io::write<uint8>(ChatType::Say) << io::write_range(message) << io::write<uint8>(0);
+				packet.Finish();
+			});
+		}
+
+		Schedule(m_config.chatInterval, [this]() { SendChatMessage(); });
+	}
+
+	void LoadBot::ChangeZone()
+	{
+		if (!m_transferring)
+		{
+			const uint32 mapId = m_config.zoneMaps[m_zoneIndex++ % m_config.zoneMaps.size()];
+
+			m_transferring = true;
+			m_transferStart = BotClock::now();
+			m_realmConnector->sendSinglePacket([this, mapId](game::OutgoingPacket& packet)
+			{
+				packet.Start(game::client_realm_packet::CheatWorldPort);
+				packet
+					<< io::write<uint32>(mapId)
+					<< io::write<float>(m_spawnPosition.x)
+					<< io::write<float>(m_spawnPosition.y)
+					<< io::write<float>(m_spawnPosition.z)
+					<< io::write<float>(0.0f);
+				packet.Finish();
+			});
+		}
+
+		Schedule(m_config.zoneInterval, [this]() { ChangeZone(); });
+	}
+}
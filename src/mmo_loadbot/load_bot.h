@@ -0,0 +1,137 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "bot_config.h"
+#include "bot_login_connector.h"
+#include "bot_realm_connector.h"
+#include "load_metrics.h"
+
+#include "base/non_copyable.h"
+#include "base/signal.h"
+#include "base/timer_queue.h"
+#include "game/movement_info.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+
+namespace mmo
+{
+	/// A single scripted character. Logs in at the login server, enters the world on a realm and executes the
+	/// configured scenario while recording latencies into the shared metrics. All methods have to be called on
+	/// the thread running the io service the bot was created with.
+	class LoadBot final
+		: public NonCopyable
+		, public std::enable_shared_from_this<LoadBot>
+	{
+	public:
+		/// Initializes a new load bot.
+		/// @param index Index of the bot which is used to generate account and character names.
+		/// @param config Settings shared by all bots, has to outlive the bot.
+		/// @param metrics Metrics shared by all bots, has to outlive the bot.
+		/// @param ioService The io service used for all connections of this bot.
+		/// @param timers The timer queue used for scenario events, has to run on the same thread as ioService.
+		explicit LoadBot(uint32 index, const BotConfig& config, LoadMetrics& metrics, asio::io_service& ioService, TimerQueue& timers);
+		~LoadBot() override;
+
+	public:
+		/// Starts the login process.
+		void Start();
+
+		/// Closes all connections and stops the scenario.
+		void Stop();
+
+		/// Gets the account name of this bot.
+		[[nodiscard]] const String& GetAccountName() const { return m_accountName; }
+
+		/// Determines whether the bot is currently in the world.
+		[[nodiscard]] bool IsInWorld() const { return m_inWorld; }
+
+	private:
+		void OnLoginFailed(auth::AuthResult result);
+
+		void OnRealmListReceived(const std::vector<BotRealmEntry>& realms);
+
+		void OnRealmAuthenticated(uint8 result);
+
+		void OnRealmDisconnected();
+
+		void OnRealmPacketReceived(const game::IncomingPacket& packet);
+
+		PacketParseResult OnCharEnum(game::IncomingPacket& packet);
+
+		PacketParseResult OnCharCreateResponse(game::IncomingPacket& packet);
+
+		PacketParseResult OnLoginVerifyWorld(game::IncomingPacket& packet);
+
+		PacketParseResult OnEnterWorldFailed(game::IncomingPacket& packet);
+
+		PacketParseResult OnMovement(game::IncomingPacket& packet);
+
+		PacketParseResult OnChatMessage(game::IncomingPacket& packet);
+
+		PacketParseResult OnSpellResult(game::IncomingPacket& packet);
+
+		PacketParseResult OnNewWorld(game::IncomingPacket& packet);
+
+		PacketParseResult OnMoveTeleport(game::IncomingPacket& packet);
+
+		PacketParseResult OnForceMovementSpeedChange(game::IncomingPacket& packet);
+
+	private:
+		/// Called once the character entered the world. Starts the scenario.
+		void EnterWorld(uint32 mapId, const Vector3& position, float facing);
+
+		/// Executes a callback after the given delay as long as the bot is still alive and in the world.
+		void Schedule(GameTime delay, std::function<void()> callback);
+
+		/// Starts walking along the next edge of the square path.
+		void StartPathLeg();
+
+		/// Sends a heartbeat while walking and stops at the end of the current edge.
+		void MovementHeartbeat();
+
+		void SendMovement(uint16 opCode);
+
+		void CastSpell();
+
+		void SendChatMessage();
+
+		void ChangeZone();
+
+	private:
+		uint32 m_index;
+		const BotConfig& m_config;
+		LoadMetrics& m_metrics;
+		asio::io_service& m_ioService;
+		TimerQueue& m_timers;
+		String m_accountName;
+
+		std::shared_ptr<BotLoginConnector> m_loginConnector;
+		std::shared_ptr<BotRealmConnector> m_realmConnector;
+		scoped_connection_container m_connections;
+
+		BotClock::time_point m_loginStart;
+		bool m_createdCharacter = false;
+		bool m_inWorld = false;
+		bool m_stopped = false;
+
+		uint64 m_guid = 0;
+		uint32 m_mapId = 0;
+		Vector3 m_spawnPosition;
+		MovementInfo m_movementInfo;
+
+		uint32 m_pathLeg = 0;
+		float m_legDistance = 0.0f;
+		GameTime m_lastHeartbeat = 0;
+		bool m_transferring = false;
+		size_t m_zoneIndex = 0;
+		BotClock::time_point m_transferStart;
+
+		uint32 m_chatSequence = 0;
+		std::map<uint32, BotClock::time_point> m_pendingChatMessages;
+		std::deque<BotClock::time_point> m_pendingCasts;
+		bool m_castStarted = false;
+	};
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "load_metrics.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace mmo
+{
+	namespace
+	{
+		/// Packets which have not been relayed to any bot within this time are forgotten.
+		constexpr auto MovementEchoTimeout = std::chrono::seconds(10);
+
+		void PrintLatency(std::ostream& out, const char* name, const LatencyHistogram& histogram)
+		{
+			const LatencyHistogram::Summary summary = histogram.Summarize();
+
+			out << "\t" << std::left << std::setw(20) << name << std::right;
+			if (summary.count == 0)
+			{
+				out << "no samples\n";
+				return;
+			}
+
+			out << std::fixed << std::setprecision(2)
+				<< "n=" << std::setw(8) << summary.count
+				<< " min=" << std::setw(9) << summary.min
+				<< " avg=" << std::setw(9) << summary.mean
+				<< " p50=" << std::setw(9) << summary.p50
+				<< " p90=" << std::setw(9) << summary.p90
+				<< " p99=" << std::setw(9) << summary.p99
+				<< " max=" << std::setw(9) << summary.max
+				<< " ms\n";
+		}
+	}
+
+	void MovementEchoTracker::OnSent(const uint64 guid, const GameTime timestamp)
+	{
+		const auto now = BotClock::now();
+
+		std::scoped_lock lock{ m_mutex };
+		m_pending[{ guid, timestamp }] = now;
+
+		// Drop packets that will never be relayed, e.g. because no other bot was in sight
+		if (now - m_lastPrune < std::chrono::seconds(1))
+		{
+			return;
+		}
+
+		m_lastPrune = now;
+		for (auto it = m_pending.begin(); it != m_pending.end(); )
+		{
+			if (now - it->second > MovementEchoTimeout)
+			{
+				it = m_pending.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	double MovementEchoTracker::OnReceived(const uint64 guid, const GameTime timestamp)
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		const auto it = m_pending.find({ guid, timestamp });
+		if (it == m_pending.end())
+		{
+			return -1.0;
+		}
+
+		const double elapsed = MillisecondsSince(it->second);
+		m_pending.erase(it);
+		return elapsed;
+	}
+
+	void LoadMetrics::PrintReport(std::ostream& out, const double seconds) const
+	{
+		out << "Bots in world: " << botsInWorld << ", login failures: " << loginFailures << ", disconnects: " << disconnects << "\n";
+
+		out << "Latencies:\n";
+		PrintLatency(out, "Login", loginTime);
+		PrintLatency(out, "Enter world", enterWorldTime);
+		PrintLatency(out, "Movement echo", movementEcho);
+		PrintLatency(out, "Spell response", spellResponse);
+		PrintLatency(out, "Chat echo", chatEcho);
+		PrintLatency(out, "Zone transfer", zoneTransfer);
+
+		if (seconds <= 0.0)
+		{
+			return;
+		}
+
+		const double bots = static_cast<double>(std::max<size_t>(botsInWorld, 1));
+		out << "Rates:\n" << std::fixed << std::setprecision(2)
+			<< "\tMovement packets sent:     " << static_cast<double>(movementPacketsSent) / seconds << " / s\n"
+			<< "\tPackets received:          " << static_cast<double>(packetsReceived) / seconds << " / s\n"
+			<< "\tUpdate packets received:   " << static_cast<double>(updatePacketsReceived) / seconds << " / s ("
+				<< static_cast<double>(updatePacketsReceived) / seconds / bots << " / s per bot)\n"
+			<< "\tUpdate bytes received:     " << static_cast<double>(updateBytesReceived) / seconds / 1024.0 << " KiB / s\n";
+	}
+}
@@ -0,0 +1,74 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "latency_histogram.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <ostream>
+
+namespace mmo
+{
+	/// Clock used for all load bot measurements.
+	typedef std::chrono::steady_clock BotClock;
+
+	/// Gets the time in milliseconds elapsed since the given time point.
+	inline double MillisecondsSince(const BotClock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(BotClock::now() - start).count();
+	}
+
+	/// Measures the time it takes until a movement packet sent by one bot is relayed to another bot. All bots of a run share
+	/// one instance, since the server never echoes movement back to the moving client itself.
+	class MovementEchoTracker final : public NonCopyable
+	{
+	public:
+		/// Remembers when a movement packet was sent.
+		/// @param guid The guid of the moving character.
+		/// @param timestamp The timestamp of the sent movement info which is used to identify the packet.
+		void OnSent(uint64 guid, GameTime timestamp);
+
+		/// Looks up the send time of a relayed movement packet. Only the first receiver of a packet produces a sample.
+		/// @return The elapsed time in milliseconds or a negative value if the packet is unknown.
+		double OnReceived(uint64 guid, GameTime timestamp);
+
+	private:
+		std::mutex m_mutex;
+		std::map<std::pair<uint64, GameTime>, BotClock::time_point> m_pending;
+		BotClock::time_point m_lastPrune;
+	};
+
+	/// Metrics collected by all load bots of a run.
+	struct LoadMetrics final : public NonCopyable
+	{
+		/// Time from connecting to the login server until the realm list has been received.
+		LatencyHistogram loginTime;
+		/// Time from connecting to the login server until the character entered the world.
+		LatencyHistogram enterWorldTime;
+		/// Time until a movement packet of one bot was relayed to another bot.
+		LatencyHistogram movementEcho;
+		/// Time until the server confirmed or rejected a spell cast.
+		LatencyHistogram spellResponse;
+		/// Time until a bot received its own chat message.
+		LatencyHistogram chatEcho;
+		/// Time from requesting a map change until the new world packet has been received.
+		LatencyHistogram zoneTransfer;
+
+		MovementEchoTracker movementTracker;
+
+		std::atomic<size_t> botsInWorld { 0 };
+		std::atomic<size_t> loginFailures { 0 };
+		std::atomic<size_t> disconnects { 0 };
+		std::atomic<uint64> movementPacketsSent { 0 };
+		std::atomic<uint64> updatePacketsReceived { 0 };
+		std::atomic<uint64> updateBytesReceived { 0 };
+		std::atomic<uint64> packetsReceived { 0 };
+
+		/// Prints a report of all collected metrics.
+		/// @param out The stream to print to.
+		/// @param seconds The run time in seconds used to calculate rates.
+		void PrintReport(std::ostream& out, double seconds) const;
+	};
+}
@@ -0,0 +1,218 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "bot_config.h"
+#include "load_bot.h"
+#include "load_metrics.h"
+
+#include "base/timer_queue.h"
+#include "log/default_log_levels.h"
+#include "log/log_std_stream.h"
+
+#include "cxxopts/cxxopts.hpp"
+
+#include "asio/io_service.hpp"
+
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace mmo
+{
+	/// A network thread which runs a share of all bots.
+	struct BotWorker final : NonCopyable
+	{
+		asio::io_service ioService;
+		std::unique_ptr<asio::io_service::work> work { std::make_unique<asio::io_service::work>(ioService) };
+		TimerQueue timers { ioService };
+		std::vector<std::shared_ptr<LoadBot>> bots;
+		std::thread thread;
+	};
+
+	/// Spawns the bots, runs the scenario for the given duration and prints the collected metrics.
+	///	@return 0 on success, 1 if not a single bot managed to enter the world.
+	int32 run(const BotConfig& config, const uint32 botCount, const uint32 firstBotIndex, const double rampRate, const uint32 duration, size_t threadCount, const uint32 reportInterval)
+	{
+		LoadMetrics metrics;
+
+		std::vector<std::unique_ptr<BotWorker>> workers(threadCount);
+		for (auto& worker : workers)
+		{
+			worker = std::make_unique<BotWorker>();
+			worker->thread = std::thread([&ioService = worker->ioService]() { ioService.run(); });
+		}
+
+		ILOG("Running scenario '" << BotScenarioName(config.scenario) << "' with " << botCount << " bots on " << threadCount << " threads against " << config.loginAddress << ":" << config.loginPort);
+
+		const auto start = BotClock::now();
+		auto lastReport = start;
+
+		const auto report = [&metrics, &lastReport, reportInterval]()
+		{
+			if (reportInterval == 0 || BotClock::now() - lastReport < std::chrono::seconds(reportInterval))
+			{
+				return;
+			}
+
+			lastReport = BotClock::now();
+			ILOG(metrics.botsInWorld << " bots in world, " << metrics.loginFailures << " login failures, " << metrics.disconnects << " disconnects");
+		};
+
+		// Ramp up bots with the given rate so we don't measure a login storm unless it's requested
+		for (uint32 i = 0; i < botCount; ++i)
+		{
+			BotWorker& worker = *workers[i % workers.size()];
+			worker.ioService.post([&worker, &config, &metrics, index = firstBotIndex + i]()
+			{
+				auto bot = std::make_shared<LoadBot>(index, config, metrics, worker.ioService, worker.timers);
+				worker.bots.push_back(bot);
+				bot->Start();
+			});
+
+			if (rampRate > 0.0)
+			{
+				std::this_thread::sleep_until(start + std::chrono::duration_cast<BotClock::duration>(std::chrono::duration<double>((i + 1) / rampRate)));
+			}
+
+			report();
+		}
+
+		const auto rampEnd = BotClock::now();
+		while (BotClock::now() - rampEnd < std::chrono::seconds(duration))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			report();
+		}
+
+		const double seconds = std::chrono::duration<double>(BotClock::now() - start).count();
+		const size_t botsInWorld = metrics.botsInWorld;
+
+		std::ostringstream strm;
+		strm << "Results of scenario '" << BotScenarioName(config.scenario) << "' after " << seconds << " s:\n";
+		metrics.PrintReport(strm, seconds);
+		ILOG(strm.str());
+
+		// Bots have to be destroyed on their own network thread
+		for (auto& worker : workers)
+		{
+			worker->ioService.post([&worker = *worker]()
+			{
+				for (const auto& bot : worker.bots)
+				{
+					bot->Stop();
+				}
+				worker.bots.clear();
+
+				// Don't wait for pending scenario timers
+				worker.ioService.stop();
+			});
+		}
+
+		for (auto& worker : workers)
+		{
+			worker->thread.join();
+		}
+
+		return botsInWorld > 0 ? 0 : 1;
+	}
+}
+
+/// Entry point of the load test bot.
+///	@param argc The number of command line arguments.
+///	@param argv The command line arguments.
+///	@return 0 on success, anything else on error.
+int main(int argc, char* argv[])
+{
+	auto logOptions = mmo::g_DefaultConsoleLogOptions;
+
+	std::mutex coutLogMutex;
+	mmo::g_DefaultLog.signal().connect([&coutLogMutex, &logOptions](const mmo::LogEntry& entry) {
+		std::scoped_lock lock{ coutLogMutex };
+		printLogEntry(std::cout, entry, logOptions);
+		});
+
+	mmo::BotConfig config;
+	mmo::String scenarioName = mmo::BotScenarioName(config.scenario);
+	uint32 realmId = 0;
+	uint32 botCount = 10;
+	uint32 firstBotIndex = 0;
+	double rampRate = 10.0;
+	uint32 duration = 60;
+	uint32 reportInterval = 5;
+	uint32 race = config.race;
+	uint32 characterClass = config.characterClass;
+	size_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	cxxopts::Options options("mmo_loadbot", "Headless load test client for login, realm and world servers");
+	options.add_options()
+		("help", "produce help message")
+		("l,login", "login server address", cxxopts::value<std::string>(config.loginAddress))
+		("port", "login server player port", cxxopts::value<uint16>(config.loginPort))
+		("account-prefix", "bot accounts are named <prefix><index>", cxxopts::value<std::string>(config.accountPrefix))
+		("password", "password of all bot accounts", cxxopts::value<std::string>(config.password))
+		("realm", "id of the realm to connect to, first realm if not set", cxxopts::value<uint32>(realmId))
+		("n,bots", "number of bots", cxxopts::value<uint32>(botCount))
+		("first-index", "index of the first bot account", cxxopts::value<uint32>(firstBotIndex))
+		("r,ramp", "bots started per second, 0 starts all bots at once", cxxopts::value<double>(rampRate))
+		("d,duration", "seconds to run the scenario after all bots have been started", cxxopts::value<uint32>(duration))
+		("j,threads", "number of network threads", cxxopts::value<size_t>(threadCount))
+		("s,scenario", "login, move, cast, chat, zone or mixed", cxxopts::value<std::string>(scenarioName))
+		("report-interval", "seconds between progress reports, 0 to disable", cxxopts::value<uint32>(reportInterval))
+		("race", "race id of created characters", cxxopts::value<uint32>(race))
+		("class", "class id of created characters", cxxopts::value<uint32>(characterClass))
+		("path-length", "edge length of the square walked in the move scenario", cxxopts::value<float>(config.pathLength))
+		("speed", "movement speed in units per second", cxxopts::value<float>(config.runSpeed))
+		("heartbeat-interval", "milliseconds between movement heartbeats", cxxopts::value<uint32>(config.heartbeatInterval))
+		("spell", "spell id cast in the cast scenario", cxxopts::value<uint32>(config.spellId))
+		("cast-interval", "milliseconds between spell casts", cxxopts::value<uint32>(config.castInterval))
+		("chat-interval", "milliseconds between chat messages", cxxopts::value<uint32>(config.chatInterval))
+		("zone-maps", "comma separated map ids to port between in the zone scenario (requires game master accounts)", cxxopts::value<std::vector<uint32>>(config.zoneMaps))
+		("zone-interval", "milliseconds between map changes", cxxopts::value<uint32>(config.zoneInterval))
+		;
+
+	try
+	{
+		cxxopts::ParseResult result = options.parse(argc, argv);
+
+		if (result.count("help"))
+		{
+			ILOG(options.help());
+			return 0;
+		}
+
+		const auto scenario = mmo::ParseBotScenario(scenarioName);
+		if (!scenario)
+		{
+			ELOG("Unknown scenario '" << scenarioName << "'");
+			ILOG(options.help());
+			return 1;
+		}
+
+		config.scenario = *scenario;
+		config.race = static_cast<uint8>(race);
+		config.characterClass = static_cast<uint8>(characterClass);
+		if (result.count("realm"))
+		{
+			config.realmId = realmId;
+		}
+
+		if (config.scenario == mmo::bot_scenario::Cast && config.spellId == 0)
+		{
+			WLOG("No spell id given, bots won't cast anything");
+		}
+		if (config.scenario == mmo::bot_scenario::Zone && config.zoneMaps.empty())
+		{
+			WLOG("No zone maps given, bots won't change maps");
+		}
+
+		if (threadCount == 0) threadCount = 1;
+
+		return mmo::run(config, botCount, firstBotIndex, rampRate, duration, threadCount, reportInterval);
+	}
+	catch (const cxxopts::OptionException& e)
+	{
+		ELOG(e.what() << "\n");
+		ILOG(options.help());
+		return 1;
+	}
+}
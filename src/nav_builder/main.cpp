@@ -17,13 +17,14 @@ namespace mmo
 	///	@param worldName The name of the world to build. World will be located in the AssetRegistry using the schema: Worlds/<worldName>/<worldName>.hwld
 	///	@param directoryPath The target directory where the built tiles will be stored.
 	///	@param concurrentThreads The number of worker threads to use for building the tiles. Must be at least 1.
+	///	@param incremental If true, tiles whose inputs did not change since the previous build are reused.
 	///	@return 0 on success, 1 on failure. This should be thought of as the process exit code.
-	int32 run(const std::string& worldName, const std::string& directoryPath, size_t concurrentThreads)
+	int32 run(const std::string& worldName, const std::string& directoryPath, size_t concurrentThreads, bool incremental)
 	{
 		ASSERT(concurrentThreads > 0);
 
 		// Create a new mesh builder instance. This class is thread safe!
-		auto builder = std::make_unique<MeshBuilder>(directoryPath, worldName);
+		auto builder = std::make_unique<MeshBuilder>(directoryPath, worldName, incremental);
 		ILOG("Building " << builder->GetTileCount() << " tiles for world " << worldName << " using " << concurrentThreads << " thrads...");
 
 		volatile bool success = true;
@@ -70,7 +71,7 @@ namespace mmo
 		ILOG("Saving map...");
 		builder->SaveMap();
 
-		ILOG("Finished");
+		ILOG("Finished, reused " << builder->GetReusedTiles() << " of " << builder->GetTileCount() << " tiles from the previous build");
 		
 		// Wait for network threads to finish execution
 		for (auto& thread : networkThreads)
@@ -104,6 +105,9 @@ int main(int argc, char* argv[])
 	// Per default, use all available threads
 	size_t concurrentThreads = std::thread::hardware_concurrency();
 
+	// Per default, only rebuild tiles whose inputs changed since the last build
+	bool fullBuild = false;
+
 	// TODO: This is ugly! Let's remove this dependency. Right now this is needed because we deserialize Mesh Files which will also try to load
 	// materials, which in turn will try to load referenced textures and shaders and stuff. So by initializing the NullGraphicsDevice, we prevent
 	// this from crashing and not actually load textures and shaders and stuff.
@@ -117,6 +121,7 @@ int main(int argc, char* argv[])
 		("w,world", "sets world name to build", cxxopts::value<std::string>(worldName))
 		("o,out", "set target directory", cxxopts::value<std::string>(directoryPath))
 		("j,concurrency", "The number of threads used for building", cxxopts::value<size_t>(concurrentThreads))
+		("f,full", "rebuild all tiles, ignoring the results of previous builds", cxxopts::value<bool>(fullBuild))
 		;
 
 	// Add positional parameters to allow for something like this:
@@ -145,7 +150,7 @@ int main(int argc, char* argv[])
 		mmo::AssetRegistry::Initialize(dataDirectory, archives);
 
 		// Run the actual tool
-		return mmo::run(worldName, directoryPath, concurrentThreads);
+		return mmo::run(worldName, directoryPath, concurrentThreads, !fullBuild);
 	}
 	catch (const cxxopts::OptionException& e)
 	{
@@ -0,0 +1,95 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "character_name_cache.h"
+
+#include "base/clock.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	CharacterNameCache::CharacterNameCache(const size_t capacity, const GameTime notFoundLifetime)
+		: m_capacity(std::max<size_t>(capacity, 1))
+		, m_notFoundLifetime(notFoundLifetime)
+	{
+		m_entriesByGuid.reserve(m_capacity);
+	}
+
+	CharacterNameCache::LookupResult CharacterNameCache::Find(const uint64 guid, String& out_name)
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		const auto it = m_entriesByGuid.find(guid);
+		if (it == m_entriesByGuid.end())
+		{
+			return LookupResult::Unknown;
+		}
+
+		const EntryList::iterator entryIt = it->second;
+		if (entryIt->expiresAt != 0)
+		{
+			if (entryIt->expiresAt <= GetAsyncTimeMs())
+			{
+				m_entries.erase(entryIt);
+				m_entriesByGuid.erase(it);
+				return LookupResult::Unknown;
+			}
+
+			m_entries.splice(m_entries.begin(), m_entries, entryIt);
+			return LookupResult::NotFound;
+		}
+
+		m_entries.splice(m_entries.begin(), m_entries, entryIt);
+		out_name = entryIt->name;
+		return LookupResult::Found;
+	}
+
+	void CharacterNameCache::Add(const uint64 guid, const String& name)
+	{
+		std::scoped_lock lock{ m_mutex };
+		Store(guid, name, 0);
+	}
+
+	void CharacterNameCache::AddNotFound(const uint64 guid)
+	{
+		std::scoped_lock lock{ m_mutex };
+		Store(guid, String(), GetAsyncTimeMs() + m_notFoundLifetime);
+	}
+
+	void CharacterNameCache::Remove(const uint64 guid)
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		const auto it = m_entriesByGuid.find(guid);
+		if (it != m_entriesByGuid.end())
+		{
+			m_entries.erase(it->second);
+			m_entriesByGuid.erase(it);
+		}
+	}
+
+	void CharacterNameCache::Store(const uint64 guid, const String& name, const GameTime expiresAt)
+	{
+		const auto it = m_entriesByGuid.find(guid);
+		if (it != m_entriesByGuid.end())
+		{
+			it->second->name = name;
+			it->second->expiresAt = expiresAt;
+			m_entries.splice(m_entries.begin(), m_entries, it->second);
+			return;
+		}
+
+		m_entries.push_front(Entry{ guid, name, expiresAt });
+		m_entriesByGuid.emplace(guid, m_entries.begin());
+		Trim();
+	}
+
+	void CharacterNameCache::Trim()
+	{
+		while (m_entries.size() > m_capacity)
+		{
+			m_entriesByGuid.erase(m_entries.back().guid);
+			m_entries.pop_back();
+		}
+	}
+}
@@ -0,0 +1,76 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace mmo
+{
+	/// Bounded cache of character names by character guid which evicts the least recently used entries. It also
+	/// remembers guids which don't belong to any character for a while, so that repeated name queries for them
+	/// don't hit the database again. Thread safe.
+	class CharacterNameCache final : public NonCopyable
+	{
+	public:
+		/// Enumerates possible results of a cache lookup.
+		enum class LookupResult : uint8
+		{
+			/// Nothing is known about the guid, the database has to be asked.
+			Unknown,
+			/// The guid belongs to a character, the name has been returned.
+			Found,
+			/// The guid is known to not belong to any character.
+			NotFound
+		};
+
+	public:
+		/// @param capacity Maximum number of entries kept in the cache.
+		/// @param notFoundLifetime Time in milliseconds for how long a guid is remembered to not belong to any character.
+		explicit CharacterNameCache(size_t capacity, GameTime notFoundLifetime = 60 * 1000);
+
+	public:
+		/// Looks up the name of a character and marks the entry as recently used.
+		/// @param guid Guid of the character.
+		/// @param out_name Receives the character name if it was found.
+		LookupResult Find(uint64 guid, String& out_name);
+
+		/// Adds or updates the name of a character.
+		void Add(uint64 guid, const String& name);
+
+		/// Remembers that a guid doesn't belong to any character.
+		void AddNotFound(uint64 guid);
+
+		/// Removes a guid from the cache, for example when the character has been deleted.
+		void Remove(uint64 guid);
+
+	private:
+		struct Entry
+		{
+			uint64 guid = 0;
+			String name;
+			/// Time after which a not found entry is dropped. Zero for entries with a name.
+			GameTime expiresAt = 0;
+		};
+
+		typedef std::list<Entry> EntryList;
+
+		/// Inserts or updates an entry and moves it to the front. m_mutex has to be locked.
+		void Store(uint64 guid, const String& name, GameTime expiresAt);
+
+		/// Removes the least recently used entries until the capacity is respected. m_mutex has to be locked.
+		void Trim();
+
+	private:
+		const size_t m_capacity;
+		const GameTime m_notFoundLifetime;
+		std::mutex m_mutex;
+		/// Entries ordered from most to least recently used.
+		EntryList m_entries;
+		std::unordered_map<uint64, EntryList::iterator> m_entriesByGuid;
+	};
+}
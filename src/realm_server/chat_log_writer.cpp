@@ -0,0 +1,72 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "chat_log_writer.h"
+
+#include "base/timer_queue.h"
+
+#include <algorithm>
+#include <ctime>
+
+namespace mmo
+{
+	ChatLogWriter::ChatLogWriter(AsyncDatabase& database, TimerQueue& timerQueue, const size_t batchSize, const GameTime flushInterval)
+		: m_database(database)
+		, m_timerQueue(timerQueue)
+		, m_batchSize(std::max<size_t>(batchSize, 1))
+		, m_flushInterval(flushInterval)
+	{
+		m_messages.reserve(m_batchSize);
+	}
+
+	void ChatLogWriter::Add(const uint64 characterId, const uint16 type, const String& message)
+	{
+		std::vector<ChatMessageData> batch;
+
+		{
+			std::scoped_lock lock{ m_mutex };
+			m_messages.push_back(ChatMessageData{ characterId, type, message, static_cast<int64>(std::time(nullptr)) });
+
+			if (m_messages.size() < m_batchSize)
+			{
+				if (!m_flushScheduled)
+				{
+					m_flushScheduled = true;
+					m_timerQueue.AddEvent([this]()
+						{
+							{
+								std::scoped_lock lock{ m_mutex };
+								m_flushScheduled = false;
+							}
+
+							Flush();
+						}, m_timerQueue.GetNow() + m_flushInterval);
+				}
+
+				return;
+			}
+
+			batch.swap(m_messages);
+			m_messages.reserve(m_batchSize);
+		}
+
+		m_database.asyncRequest(&IDatabase::ChatMessages, std::move(batch));
+	}
+
+	void ChatLogWriter::Flush()
+	{
+		std::vector<ChatMessageData> batch;
+
+		{
+			std::scoped_lock lock{ m_mutex };
+			if (m_messages.empty())
+			{
+				return;
+			}
+
+			batch.swap(m_messages);
+			m_messages.reserve(m_batchSize);
+		}
+
+		m_database.asyncRequest(&IDatabase::ChatMessages, std::move(batch));
+	}
+}
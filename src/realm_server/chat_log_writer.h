@@ -0,0 +1,45 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "database.h"
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+
+#include <mutex>
+#include <vector>
+
+namespace mmo
+{
+	class TimerQueue;
+
+	/// Buffers chat messages and archives them in the database in batches, either when enough messages have been
+	/// collected or when the oldest buffered message has waited for the flush interval. This keeps busy channels from
+	/// flooding the database thread with single inserts. Thread safe.
+	class ChatLogWriter final : public NonCopyable
+	{
+	public:
+		/// @param database The database to write to.
+		/// @param timerQueue Timer queue used to flush the buffer after the flush interval.
+		/// @param batchSize Number of buffered messages which triggers an immediate flush.
+		/// @param flushInterval Maximum time in milliseconds a message is buffered.
+		explicit ChatLogWriter(AsyncDatabase& database, TimerQueue& timerQueue, size_t batchSize, GameTime flushInterval);
+
+	public:
+		/// Adds a chat message to the buffer.
+		void Add(uint64 characterId, uint16 type, const String& message);
+
+		/// Sends all buffered messages to the database.
+		void Flush();
+
+	private:
+		AsyncDatabase& m_database;
+		TimerQueue& m_timerQueue;
+		const size_t m_batchSize;
+		const GameTime m_flushInterval;
+		std::mutex m_mutex;
+		std::vector<ChatMessageData> m_messages;
+		bool m_flushScheduled = false;
+	};
+}
@@ -30,13 +30,23 @@ namespace mmo
 		: playerPort(mmo::constants::DefaultRealmPlayerPort)
         , worldPort(mmo::constants::DefaultRealmWorldPort)
 		, maxPlayers((std::numeric_limits<decltype(maxPlayers)>::max)())
+		, nameCacheCapacity(10000)
 		, maxWorlds(constants::MaxRealmCount)
+		, cryptoWorkerCount(1)
+		, maxPendingCryptoJobs(64)
 		, mysqlPort(mmo::constants::DefaultMySQLPort)
 		, mysqlHost("127.0.0.1")
 		, mysqlUser("mmo")
 		, mysqlPassword("")
 		, mysqlDatabase("mmo_realm_01")
 		, mysqlUpdatePath("updates/realm")
+		, databaseType("mysql")
+		, databaseSnapshotFile("")
+		, databaseLatency(0)
+		, databaseLatencyJitter(0)
+		, databaseAutoCreatePassword("")
+		, chatLogBatchSize(64)
+		, chatLogFlushInterval(5000)
 		, isLogActive(true)
 		, logFileName("logs/realm_01")
 		, isLogFileBuffering(false)
@@ -123,6 +133,17 @@ namespace mmo
 					"Realm authentication will most likely fail now.");
 			}
 
+			if (const Table *const databaseTable = global.getTable("database"))
+			{
+				databaseType = databaseTable->getString("type", databaseType);
+				databaseSnapshotFile = databaseTable->getString("snapshotFile", databaseSnapshotFile);
+				databaseLatency = databaseTable->getInteger("latency", databaseLatency);
+				databaseLatencyJitter = databaseTable->getInteger("latencyJitter", databaseLatencyJitter);
+				databaseAutoCreatePassword = databaseTable->getString("autoCreatePassword", databaseAutoCreatePassword);
+				chatLogBatchSize = databaseTable->getInteger("chatLogBatchSize", chatLogBatchSize);
+				chatLogFlushInterval = databaseTable->getInteger("chatLogFlushInterval", chatLogFlushInterval);
+			}
+
 			if (const Table *const mysqlDatabaseTable = global.getTable("webServer"))
 			{
 				webPort = mysqlDatabaseTable->getInteger("port", webPort);
@@ -135,6 +156,7 @@ namespace mmo
 			{
 				playerPort = playerManager->getInteger("port", playerPort);
 				maxPlayers = playerManager->getInteger("maxCount", maxPlayers);
+				nameCacheCapacity = playerManager->getInteger("nameCacheCapacity", nameCacheCapacity);
 			}
 
 			if (const Table *const worldManager = global.getTable("worldManager"))
@@ -143,6 +165,12 @@ namespace mmo
 				maxWorlds = worldManager->getInteger("maxCount", maxWorlds);
 			}
 
+			if (const Table *const crypto = global.getTable("crypto"))
+			{
+				cryptoWorkerCount = crypto->getInteger("workerCount", cryptoWorkerCount);
+				maxPendingCryptoJobs = crypto->getInteger("maxPendingJobs", maxPendingCryptoJobs);
+			}
+
 			if (const Table* const folders = global.getTable("folders"))
 			{
 				dataFolder = folders->getString("data", dataFolder);
@@ -206,6 +234,20 @@ namespace mmo
 
 		global.writer.newLine();
 
+		{
+			sff::write::Table<Char> databaseTable(global, "database", sff::write::MultiLine);
+			databaseTable.addKey("type", databaseType);
+			databaseTable.addKey("snapshotFile", databaseSnapshotFile);
+			databaseTable.addKey("latency", databaseLatency);
+			databaseTable.addKey("latencyJitter", databaseLatencyJitter);
+			databaseTable.addKey("autoCreatePassword", databaseAutoCreatePassword);
+			databaseTable.addKey("chatLogBatchSize", chatLogBatchSize);
+			databaseTable.addKey("chatLogFlushInterval", chatLogFlushInterval);
+			databaseTable.Finish();
+		}
+
+		global.writer.newLine();
+
 		global.writer.lineComment(" **************************************************************************");
 		global.writer.lineComment(" This section contains important realm configuration settings.");
 		global.writer.lineComment(" The realmName and realmPasswordHash must be known to the login server in order for this realm to authenticate.");
@@ -238,6 +280,7 @@ namespace mmo
 			sff::write::Table<Char> playerManager(global, "playerManager", sff::write::MultiLine);
 			playerManager.addKey("port", playerPort);
 			playerManager.addKey("maxCount", maxPlayers);
+			playerManager.addKey("nameCacheCapacity", nameCacheCapacity);
 			playerManager.Finish();
 		}
 
@@ -252,6 +295,15 @@ namespace mmo
 		
 		global.writer.newLine();
 
+		{
+			sff::write::Table<Char> crypto(global, "crypto", sff::write::MultiLine);
+			crypto.addKey("workerCount", cryptoWorkerCount);
+			crypto.addKey("maxPendingJobs", maxPendingCryptoJobs);
+			crypto.Finish();
+		}
+
+		global.writer.newLine();
+
 		{
 			sff::write::Table<Char> log(global, "log", sff::write::MultiLine);
 			log.addKey("active", static_cast<unsigned>(isLogActive));
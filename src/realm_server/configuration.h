@@ -19,8 +19,14 @@ namespace mmo
 		uint16 worldPort;
 		/// Maximum number of player connections.
 		size_t maxPlayers;
+		/// Maximum number of character names kept in memory to answer name queries without the database.
+		size_t nameCacheCapacity;
 		/// Maximum number of world node connections.
 		size_t maxWorlds;
+		/// Number of threads used for srp6 calculations of world node logins. 0 means one per hardware thread.
+		size_t cryptoWorkerCount;
+		/// Maximum number of queued srp6 calculations before new world node logins are rejected.
+		size_t maxPendingCryptoJobs;
 
 		/// The port to be used for a mysql connection.
 		uint16 mysqlPort;
@@ -35,6 +41,22 @@ namespace mmo
 		/// Path to where update files in the form of "YYYYMMDD_INDEX.sql" are stored.
 		String mysqlUpdatePath;
 
+		/// The database system to be used, either "mysql" or "memory". The in-memory database doesn't need a
+		/// database server and is meant for load tests and profiling.
+		String databaseType;
+		/// File the in-memory database is loaded from on startup and saved to on shutdown. Empty to not persist anything.
+		String databaseSnapshotFile;
+		/// Delay in milliseconds applied to every in-memory database request to simulate a database server.
+		uint32 databaseLatency;
+		/// Maximum random delay in milliseconds added on top of the in-memory database latency.
+		uint32 databaseLatencyJitter;
+		/// If not empty, the in-memory database creates unknown worlds with this password when they log in.
+		String databaseAutoCreatePassword;
+		/// Number of buffered chat messages which are archived in the database with a single insert.
+		uint32 chatLogBatchSize;
+		/// Maximum time in milliseconds a chat message is buffered before it is archived in the database.
+		uint32 chatLogFlushInterval;
+
 		/// Indicates whether or not file logging is enabled.
 		bool isLogActive;
 		/// File name of the log file.
@@ -83,6 +83,19 @@ namespace mmo
 		std::vector<GroupMemberData> members;
 	};
 
+	/// A chat message which should be archived.
+	struct ChatMessageData
+	{
+		uint64 characterId = 0;
+
+		uint16 type = 0;
+
+		String message;
+
+		/// Unix timestamp of when the message was sent.
+		int64 timestamp = 0;
+	};
+
 	/// Basic interface for a database system used by the login server.
 	struct IDatabase : public NonCopyable
 	{
@@ -127,7 +140,9 @@ namespace mmo
 		
 		virtual std::optional<WorldCreationResult> CreateWorkd(const String& name, const String& s, const String& v) = 0;
 
-		virtual void ChatMessage(uint64 characterId, uint16 type, String message) = 0;
+		/// Archives a batch of chat messages.
+		///	@param messages The messages to store, in the order they were sent.
+		virtual void ChatMessages(std::vector<ChatMessageData> messages) = 0;
 
 		virtual void UpdateCharacter(uint64 characterId, uint32 map, const Vector3& position, const Radian& orientation, uint32 level, uint32 xp, uint32 hp, uint32 mana, uint32 rage, uint32 energy, uint32 money, const std::vector<ItemData>& items, uint32 bindMap, const Vector3& bindPosition, const Radian& bindFacing, std::array<uint32, 5> attributePointsSpent, const std::vector<uint32>& spellIds) = 0;
 
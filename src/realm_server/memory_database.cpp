@@ -0,0 +1,805 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "memory_database.h"
+
+#include "base/srp6.h"
+#include "binary_io/reader.h"
+#include "binary_io/stream_sink.h"
+#include "binary_io/stream_source.h"
+#include "binary_io/writer.h"
+#include "game/item.h"
+#include "game/quest.h"
+#include "game_server/inventory.h"
+#include "log/default_log_levels.h"
+#include "math/degree.h"
+#include "proto_data/project.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace mmo
+{
+	namespace
+	{
+		/// "MRDB" in little endian.
+		constexpr uint32 SnapshotMagic = 0x4244524D;
+		/// Version 2 added the session keys of worlds.
+		constexpr uint32 SnapshotVersion = 2;
+		/// Oldest snapshot version which can still be loaded.
+		constexpr uint32 MinSnapshotVersion = 1;
+
+		/// Names are compared case insensitive, just like the MySQL collation does.
+		String NormalizeName(String name)
+		{
+			std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+			return name;
+		}
+	}
+
+	MemoryDatabase::MemoryDatabase(MemoryDatabaseInfo info, const proto::Project& project)
+		: m_info(std::move(info))
+		, m_project(project)
+	{
+	}
+
+	bool MemoryDatabase::Load()
+	{
+		if (m_info.autoCreatePassword.empty() == false)
+		{
+			WLOG("Unknown worlds will be created on their first login attempt");
+		}
+
+		if (m_info.snapshotFile.empty())
+		{
+			ILOG("Using in-memory database without snapshot file");
+			return true;
+		}
+
+		std::ifstream file(m_info.snapshotFile, std::ios::in | std::ios::binary);
+		if (!file)
+		{
+			ILOG("Snapshot file " << m_info.snapshotFile << " does not exist yet, starting with an empty in-memory database");
+			return true;
+		}
+
+		io::StreamSource source{ file };
+		io::Reader reader{ source };
+
+		uint32 magic = 0, version = 0;
+		if (!(reader >> io::read<uint32>(magic) >> io::read<uint32>(version)) || magic != SnapshotMagic || version < MinSnapshotVersion || version > SnapshotVersion)
+		{
+			ELOG("Snapshot file " << m_info.snapshotFile << " is not a supported realm database snapshot");
+			return false;
+		}
+
+		std::scoped_lock lock{ m_mutex };
+
+		uint32 characterCount = 0;
+		if (!(reader >> io::read<uint32>(characterCount)))
+		{
+			ELOG("Failed to read characters from snapshot file " << m_info.snapshotFile);
+			return false;
+		}
+
+		for (uint32 i = 0; i < characterCount; ++i)
+		{
+			Character character;
+			if (!(reader >> io::read<uint64>(character.accountId) >> character.data))
+			{
+				ELOG("Failed to read characters from snapshot file " << m_info.snapshotFile);
+				return false;
+			}
+
+			for (auto& button : character.actionButtons)
+			{
+				if (!(reader >> button))
+				{
+					ELOG("Failed to read characters from snapshot file " << m_info.snapshotFile);
+					return false;
+				}
+			}
+
+			const uint64 characterId = character.data.characterId;
+			m_nextCharacterId = std::max(m_nextCharacterId, characterId + 1);
+			m_characterIdsByName[NormalizeName(character.data.name)] = characterId;
+			m_characterIdsByAccount[character.accountId].push_back(characterId);
+			m_characters[characterId] = std::move(character);
+		}
+
+		uint32 worldCount = 0;
+		if (!(reader >> io::read<uint32>(worldCount)))
+		{
+			ELOG("Failed to read worlds from snapshot file " << m_info.snapshotFile);
+			return false;
+		}
+
+		for (uint32 i = 0; i < worldCount; ++i)
+		{
+			World world;
+			if (!(reader
+				>> io::read<uint64>(world.id)
+				>> io::read_container<uint8>(world.name)
+				>> io::read_container<uint16>(world.s)
+				>> io::read_container<uint16>(world.v))
+				|| (version >= 2 && !(reader >> io::read_container<uint16>(world.sessionKey))))
+			{
+				ELOG("Failed to read worlds from snapshot file " << m_info.snapshotFile);
+				return false;
+			}
+
+			m_nextWorldId = std::max(m_nextWorldId, world.id + 1);
+			m_worldIdsByName[NormalizeName(world.name)] = world.id;
+			m_worlds[world.id] = std::move(world);
+		}
+
+		uint32 groupCount = 0;
+		if (!(reader >> io::read<uint32>(groupCount)))
+		{
+			ELOG("Failed to read groups from snapshot file " << m_info.snapshotFile);
+			return false;
+		}
+
+		for (uint32 i = 0; i < groupCount; ++i)
+		{
+			uint64 groupId = 0;
+			Group group;
+			if (!(reader
+				>> io::read<uint64>(groupId)
+				>> io::read<uint64>(group.leaderGuid)
+				>> io::read_container<uint8>(group.members)))
+			{
+				ELOG("Failed to read groups from snapshot file " << m_info.snapshotFile);
+				return false;
+			}
+
+			m_groups[groupId] = std::move(group);
+		}
+
+		ILOG("Loaded " << m_characters.size() << " characters, " << m_worlds.size() << " worlds and " << m_groups.size() << " groups from snapshot file " << m_info.snapshotFile);
+		return true;
+	}
+
+	bool MemoryDatabase::Save() const
+	{
+		if (m_info.snapshotFile.empty())
+		{
+			return true;
+		}
+
+		// Write into a temporary file first so a crash while saving doesn't destroy the last snapshot
+		const String tempFile = m_info.snapshotFile + ".tmp";
+
+		{
+			std::ofstream file(tempFile, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				ELOG("Could not open snapshot file " << tempFile << " for writing");
+				return false;
+			}
+
+			io::StreamSink sink{ file };
+			io::Writer writer{ sink };
+
+			std::scoped_lock lock{ m_mutex };
+
+			writer
+				<< io::write<uint32>(SnapshotMagic)
+				<< io::write<uint32>(SnapshotVersion);
+
+			writer << io::write<uint32>(m_characters.size());
+			for (const auto& [characterId, character] : m_characters)
+			{
+				writer
+					<< io::write<uint64>(character.accountId)
+					<< character.data;
+
+				for (const auto& button : character.actionButtons)
+				{
+					writer << button;
+				}
+			}
+
+			writer << io::write<uint32>(m_worlds.size());
+			for (const auto& [worldId, world] : m_worlds)
+			{
+				writer
+					<< io::write<uint64>(world.id)
+					<< io::write_dynamic_range<uint8>(world.name)
+					<< io::write_dynamic_range<uint16>(world.s)
+					<< io::write_dynamic_range<uint16>(world.v)
+					<< io::write_dynamic_range<uint16>(world.sessionKey);
+			}
+
+			writer << io::write<uint32>(m_groups.size());
+			for (const auto& [groupId, group] : m_groups)
+			{
+				writer
+					<< io::write<uint64>(groupId)
+					<< io::write<uint64>(group.leaderGuid)
+					<< io::write_dynamic_range<uint8>(group.members);
+			}
+
+			if (!file.flush())
+			{
+				ELOG("Failed to write snapshot file " << tempFile);
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempFile, m_info.snapshotFile, error);
+		if (error)
+		{
+			ELOG("Failed to replace snapshot file " << m_info.snapshotFile << ": " << error.message());
+			return false;
+		}
+
+		ILOG("Saved in-memory database to snapshot file " << m_info.snapshotFile);
+		return true;
+	}
+
+	std::optional<std::vector<CharacterView>> MemoryDatabase::GetCharacterViewsByAccountId(const uint64 accountId)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		std::vector<CharacterView> result;
+
+		const auto it = m_characterIdsByAccount.find(accountId);
+		if (it == m_characterIdsByAccount.end())
+		{
+			return result;
+		}
+
+		result.reserve(it->second.size());
+		for (const uint64 characterId : it->second)
+		{
+			const CharacterData& data = m_characters.at(characterId).data;
+			result.emplace_back(
+				data.characterId,
+				data.name,
+				data.level,
+				data.mapId,
+				0,
+				data.raceId,
+				data.classId,
+				data.gender,
+				false,
+				0);
+		}
+
+		return result;
+	}
+
+	std::optional<WorldAuthData> MemoryDatabase::GetWorldAuthData(std::string name)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const World* world = FindWorld(name);
+		if (!world && !m_info.autoCreatePassword.empty())
+		{
+			const auto [s, v] = srp6::CalculateSaltAndVerifier(name, m_info.autoCreatePassword);
+			world = &AddWorld(NormalizeName(name), s.asHexStr(), v.asHexStr());
+			ILOG("Created world " << world->name << " on first login");
+		}
+
+		if (!world)
+		{
+			return {};
+		}
+
+		WorldAuthData data;
+		data.id = world->id;
+		data.name = world->name;
+		data.s = world->s;
+		data.v = world->v;
+		return data;
+	}
+
+	void MemoryDatabase::WorldLogin(const uint64 worldId, const std::string& sessionKey, const std::string& ip, const std::string& build)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (const auto it = m_worlds.find(worldId); it != m_worlds.end())
+		{
+			it->second.sessionKey = sessionKey;
+			it->second.lastIp = ip;
+			it->second.lastBuild = build;
+		}
+	}
+
+	void MemoryDatabase::DeleteCharacter(const uint64 characterGuid)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const auto it = m_characters.find(characterGuid);
+		if (it == m_characters.end())
+		{
+			return;
+		}
+
+		auto& accountCharacters = m_characterIdsByAccount[it->second.accountId];
+		std::erase(accountCharacters, characterGuid);
+
+		m_characterIdsByName.erase(NormalizeName(it->second.data.name));
+		m_characters.erase(it);
+	}
+
+	std::optional<CharCreateResult> MemoryDatabase::CreateCharacter(std::string characterName, const uint64 accountId, const uint32 map, const uint32 level, const uint32 hp, const uint32 gender, const uint32 race, const uint32 characterClass, const Vector3& position, const Degree& orientation, std::vector<uint32> spellIds, const uint32 mana, const uint32 rage, const uint32 energy, std::map<uint8, ActionButton> actionButtons)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (FindCharacter(characterName))
+		{
+			return CharCreateResult::NameAlreadyInUse;
+		}
+
+		const uint64 characterId = m_nextCharacterId++;
+
+		Character& character = m_characters[characterId];
+		character.accountId = accountId;
+
+		CharacterData& data = character.data;
+		data.characterId = characterId;
+		data.name = std::move(characterName);
+		data.mapId = map;
+		data.position = position;
+		data.facing = Radian(orientation.GetValueRadians());
+		data.classId = characterClass;
+		data.raceId = race;
+		data.gender = static_cast<uint8>(gender);
+		data.level = static_cast<uint8>(level);
+		data.xp = 0;
+		data.hp = hp;
+		data.mana = mana;
+		data.rage = rage;
+		data.energy = energy;
+		data.money = 0;
+		data.spellIds = std::move(spellIds);
+		data.bindMap = map;
+		data.bindPosition = position;
+		data.bindFacing = data.facing;
+
+		for (const auto& [slot, button] : actionButtons)
+		{
+			if (slot < character.actionButtons.size())
+			{
+				character.actionButtons[slot] = button;
+			}
+		}
+
+		m_characterIdsByName[NormalizeName(data.name)] = characterId;
+		m_characterIdsByAccount[accountId].push_back(characterId);
+
+		return CharCreateResult::Success;
+	}
+
+	std::optional<CharacterData> MemoryDatabase::CharacterEnterWorld(const uint64 characterId, const uint64 accountId)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const Character* character = FindCharacter(characterId);
+		if (!character || character->accountId != accountId)
+		{
+			return {};
+		}
+
+		CharacterData result = character->data;
+
+		// Conjured items don't survive a logout
+		std::erase_if(result.items, [this](const ItemData& item)
+		{
+			const auto* itemEntry = m_project.items.getById(item.entry);
+			if (!itemEntry)
+			{
+				WLOG("Unknown item in character database: " << item.entry);
+				return true;
+			}
+
+			return (itemEntry->flags() & item_flags::Conjured) != 0;
+		});
+
+		// Rewarded quests are only tracked by id once the character is loaded
+		for (auto it = result.questStatus.begin(); it != result.questStatus.end();)
+		{
+			if (it->second.status == quest_status::Rewarded)
+			{
+				result.rewardedQuestIds.push_back(it->first);
+				it = result.questStatus.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		return result;
+	}
+
+	std::optional<WorldCreationResult> MemoryDatabase::CreateWorkd(const String& name, const String& s, const String& v)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (FindWorld(name))
+		{
+			return WorldCreationResult::WorldNameAlreadyInUse;
+		}
+
+		AddWorld(name, s, v);
+		return WorldCreationResult::Success;
+	}
+
+	void MemoryDatabase::ChatMessages(std::vector<ChatMessageData> messages)
+	{
+		// Chat messages are not archived by the in-memory database
+		SimulateLatency();
+	}
+
+	void MemoryDatabase::UpdateCharacter(const uint64 characterId, const uint32 map, const Vector3& position, const Radian& orientation, const uint32 level, const uint32 xp, const uint32 hp, const uint32 mana, const uint32 rage, const uint32 energy, const uint32 money, const std::vector<ItemData>& items, const uint32 bindMap, const Vector3& bindPosition, const Radian& bindFacing, const std::array<uint32, 5> attributePointsSpent, const std::vector<uint32>& spellIds)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		Character* character = FindCharacter(characterId);
+		if (!character)
+		{
+			return;
+		}
+
+		CharacterData& data = character->data;
+		data.mapId = map;
+		data.position = position;
+		data.facing = orientation;
+		data.level = static_cast<uint8>(level);
+		data.xp = xp;
+		data.hp = hp;
+		data.mana = mana;
+		data.rage = rage;
+		data.energy = energy;
+		data.money = money;
+		data.bindMap = bindMap;
+		data.bindPosition = bindPosition;
+		data.bindFacing = bindFacing;
+		data.attributePointsSpent = attributePointsSpent;
+		data.spellIds = spellIds;
+
+		// Don't save buyback slots
+		data.items.clear();
+		std::copy_if(items.begin(), items.end(), std::back_inserter(data.items), [](const ItemData& item)
+		{
+			return !Inventory::IsBuyBackSlot(item.slot);
+		});
+	}
+
+	std::optional<ActionButtons> MemoryDatabase::GetActionButtons(const uint64 characterId)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const Character* character = FindCharacter(characterId);
+		if (!character)
+		{
+			return ActionButtons{};
+		}
+
+		return character->actionButtons;
+	}
+
+	void MemoryDatabase::SetCharacterActionButtons(const DatabaseId characterId, const ActionButtons buttons)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (Character* character = FindCharacter(characterId))
+		{
+			character->actionButtons = buttons;
+		}
+	}
+
+	void MemoryDatabase::LearnSpell(const DatabaseId characterId, const uint32 spellId)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		Character* character = FindCharacter(characterId);
+		if (!character)
+		{
+			return;
+		}
+
+		auto& spellIds = character->data.spellIds;
+		if (std::find(spellIds.begin(), spellIds.end(), spellId) == spellIds.end())
+		{
+			spellIds.push_back(spellId);
+		}
+	}
+
+	void MemoryDatabase::SetQuestData(const DatabaseId characterId, const uint32 questId, const QuestStatusData& data)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		Character* character = FindCharacter(characterId);
+		if (!character)
+		{
+			return;
+		}
+
+		// Was the quest abandoned?
+		if (data.status == quest_status::Available)
+		{
+			character->data.questStatus.erase(questId);
+		}
+		else
+		{
+			character->data.questStatus[questId] = data;
+		}
+	}
+
+	std::optional<CharacterLocationData> MemoryDatabase::GetCharacterLocationDataByName(String characterName)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const Character* character = FindCharacter(characterName);
+		if (!character)
+		{
+			return {};
+		}
+
+		CharacterLocationData data;
+		data.characterId = character->data.characterId;
+		data.map = character->data.mapId;
+		data.position = character->data.position;
+		data.facing = character->data.facing;
+		return data;
+	}
+
+	void MemoryDatabase::TeleportCharacterByName(String characterName, const uint32 map, const Vector3 position, const Radian orientation)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (Character* character = FindCharacter(characterName))
+		{
+			character->data.mapId = map;
+			character->data.position = position;
+			character->data.facing = orientation;
+		}
+	}
+
+	void MemoryDatabase::CreateGroup(const uint64 id, const uint64 leaderGuid)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (!m_groups.emplace(id, Group{ leaderGuid, {} }).second)
+		{
+			ELOG("Could not create group: Group " << id << " already exists");
+			throw std::runtime_error("Group " + std::to_string(id) + " already exists");
+		}
+
+		SetCharacterGroup(leaderGuid, id);
+	}
+
+	void MemoryDatabase::SetGroupLeader(const uint64 groupId, const uint64 leaderGuid)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (const auto it = m_groups.find(groupId); it != m_groups.end())
+		{
+			it->second.leaderGuid = leaderGuid;
+		}
+	}
+
+	void MemoryDatabase::AddGroupMember(const uint64 groupId, const uint64 memberGuid)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const auto it = m_groups.find(groupId);
+		if (it == m_groups.end())
+		{
+			ELOG("Could not add group member: Group " << groupId << " does not exist");
+			throw std::runtime_error("Group " + std::to_string(groupId) + " does not exist");
+		}
+
+		auto& members = it->second.members;
+		if (std::find(members.begin(), members.end(), memberGuid) != members.end())
+		{
+			ELOG("Could not add group member: " << memberGuid << " already is a member of group " << groupId);
+			throw std::runtime_error("Character " + std::to_string(memberGuid) + " already is a group member");
+		}
+
+		members.push_back(memberGuid);
+		SetCharacterGroup(memberGuid, groupId);
+	}
+
+	void MemoryDatabase::RemoveGroupMember(const uint64 groupId, const uint64 memberGuid)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		if (const auto it = m_groups.find(groupId); it != m_groups.end())
+		{
+			std::erase(it->second.members, memberGuid);
+		}
+
+		SetCharacterGroup(memberGuid, 0);
+	}
+
+	void MemoryDatabase::DisbandGroup(const uint64 groupId)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		m_groups.erase(groupId);
+
+		for (auto& [characterId, character] : m_characters)
+		{
+			if (character.data.groupId == groupId)
+			{
+				character.data.groupId = 0;
+			}
+		}
+	}
+
+	std::optional<std::vector<uint64>> MemoryDatabase::ListGroups()
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		std::vector<uint64> result;
+		result.reserve(m_groups.size());
+
+		for (const auto& [groupId, group] : m_groups)
+		{
+			result.push_back(groupId);
+		}
+
+		return result;
+	}
+
+	std::optional<GroupData> MemoryDatabase::LoadGroup(const uint64 groupId)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const auto it = m_groups.find(groupId);
+		if (it == m_groups.end())
+		{
+			return {};
+		}
+
+		const auto getName = [this](const uint64 guid) -> String
+		{
+			const Character* character = FindCharacter(guid);
+			return character ? character->data.name : String();
+		};
+
+		GroupData groupData;
+		groupData.leaderGuid = it->second.leaderGuid;
+		groupData.leaderName = getName(it->second.leaderGuid);
+
+		for (const uint64 memberGuid : it->second.members)
+		{
+			groupData.members.emplace_back(memberGuid, getName(memberGuid));
+		}
+
+		return groupData;
+	}
+
+	std::optional<String> MemoryDatabase::GetCharacterNameById(const uint64 characterId)
+	{
+		SimulateLatency();
+
+		std::scoped_lock lock{ m_mutex };
+
+		const Character* character = FindCharacter(characterId);
+		if (!character)
+		{
+			return {};
+		}
+
+		return character->data.name;
+	}
+
+	void MemoryDatabase::SimulateLatency() const
+	{
+		if (m_info.latency == 0 && m_info.latencyJitter == 0)
+		{
+			return;
+		}
+
+		uint32 delay = m_info.latency;
+		if (m_info.latencyJitter > 0)
+		{
+			thread_local std::minstd_rand generator{ std::random_device{}() };
+			delay += std::uniform_int_distribution<uint32>(0, m_info.latencyJitter)(generator);
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+	}
+
+	MemoryDatabase::World& MemoryDatabase::AddWorld(const String& name, const String& s, const String& v)
+	{
+		World& world = m_worlds[m_nextWorldId];
+		world.id = m_nextWorldId++;
+		world.name = name;
+		world.s = s;
+		world.v = v;
+
+		m_worldIdsByName[NormalizeName(name)] = world.id;
+		return world;
+	}
+
+	MemoryDatabase::Character* MemoryDatabase::FindCharacter(const uint64 characterId)
+	{
+		const auto it = m_characters.find(characterId);
+		return it != m_characters.end() ? &it->second : nullptr;
+	}
+
+	MemoryDatabase::Character* MemoryDatabase::FindCharacter(const String& name)
+	{
+		const auto it = m_characterIdsByName.find(NormalizeName(name));
+		if (it == m_characterIdsByName.end())
+		{
+			return nullptr;
+		}
+
+		return &m_characters.at(it->second);
+	}
+
+	MemoryDatabase::World* MemoryDatabase::FindWorld(const String& name)
+	{
+		const auto it = m_worldIdsByName.find(NormalizeName(name));
+		if (it == m_worldIdsByName.end())
+		{
+			return nullptr;
+		}
+
+		return &m_worlds.at(it->second);
+	}
+
+	void MemoryDatabase::SetCharacterGroup(const uint64 characterId, const uint64 groupId)
+	{
+		if (Character* character = FindCharacter(characterId))
+		{
+			character->data.groupId = groupId;
+		}
+	}
+}
@@ -0,0 +1,155 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "database.h"
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mmo
+{
+	namespace proto
+	{
+		class Project;
+	}
+
+	/// Settings of the in-memory database.
+	struct MemoryDatabaseInfo final
+	{
+		/// File the database is loaded from on startup and saved to on shutdown. Empty to keep everything in memory only.
+		String snapshotFile;
+		/// Delay in milliseconds applied to every request to simulate the round trip to a database server.
+		uint32 latency = 0;
+		/// Maximum random delay in milliseconds added on top of the latency.
+		uint32 latencyJitter = 0;
+		/// If not empty, unknown worlds are created with this password when they try to log in.
+		String autoCreatePassword;
+	};
+
+	/// In-memory implementation of the realm server database system. Doesn't need a database server and is
+	/// meant for load tests, profiling and local development. Requests are thread safe since the web service
+	/// accesses the database from the network thread.
+	class MemoryDatabase final
+		: public IDatabase
+	{
+	public:
+		explicit MemoryDatabase(MemoryDatabaseInfo info, const proto::Project& project);
+		~MemoryDatabase() override = default;
+
+		/// Loads the snapshot file if there is one.
+		/// @returns false if the snapshot file exists but could not be read.
+		bool Load();
+
+		/// Writes all data into the snapshot file. Does nothing if no snapshot file is configured.
+		/// @returns false if the snapshot file could not be written.
+		bool Save() const;
+
+	public:
+		std::optional<std::vector<CharacterView>> GetCharacterViewsByAccountId(uint64 accountId) override;
+
+		std::optional<WorldAuthData> GetWorldAuthData(std::string name) override;
+
+		void WorldLogin(uint64 worldId, const std::string& sessionKey, const std::string& ip, const std::string& build) override;
+
+		void DeleteCharacter(uint64 characterGuid) override;
+
+		std::optional<CharCreateResult> CreateCharacter(std::string characterName, uint64 accountId, uint32 map, uint32 level, uint32 hp, uint32 gender, uint32 race, uint32 characterClass, const Vector3& position, const Degree& orientation, std::vector<uint32> spellIds, uint32 mana, uint32 rage, uint32 energy, std::map<uint8, ActionButton> actionButtons) override;
+
+		std::optional<CharacterData> CharacterEnterWorld(uint64 characterId, uint64 accountId) override;
+
+		std::optional<WorldCreationResult> CreateWorkd(const String& name, const String& s, const String& v) override;
+
+		void ChatMessages(std::vector<ChatMessageData> messages) override;
+
+		void UpdateCharacter(uint64 characterId, uint32 map, const Vector3& position, const Radian& orientation, uint32 level, uint32 xp, uint32 hp, uint32 mana, uint32 rage, uint32 energy, uint32 money, const std::vector<ItemData>& items, uint32 bindMap, const Vector3& bindPosition, const Radian& bindFacing, std::array<uint32, 5> attributePointsSpent, const std::vector<uint32>& spellIds) override;
+
+		std::optional<ActionButtons> GetActionButtons(uint64 characterId) override;
+
+		void SetCharacterActionButtons(DatabaseId characterId, ActionButtons buttons) override;
+
+		void LearnSpell(DatabaseId characterId, uint32 spellId) override;
+
+		void SetQuestData(DatabaseId characterId, uint32 questId, const QuestStatusData& data) override;
+
+		std::optional<CharacterLocationData> GetCharacterLocationDataByName(String characterName) override;
+
+		void TeleportCharacterByName(String characterName, uint32 map, Vector3 position, Radian orientation) override;
+
+		void CreateGroup(uint64 id, uint64 leaderGuid) override;
+
+		void SetGroupLeader(uint64 groupId, uint64 leaderGuid) override;
+
+		void AddGroupMember(uint64 groupId, uint64 memberGuid) override;
+
+		void RemoveGroupMember(uint64 groupId, uint64 memberGuid) override;
+
+		void DisbandGroup(uint64 groupId) override;
+
+		std::optional<std::vector<uint64>> ListGroups() override;
+
+		std::optional<GroupData> LoadGroup(uint64 groupId) override;
+
+		std::optional<String> GetCharacterNameById(uint64 characterId) override;
+
+	private:
+		struct Character
+		{
+			uint64 accountId = 0;
+			/// Rewarded quests are kept in questStatus as well, like the character_quests table does.
+			CharacterData data;
+			ActionButtons actionButtons{};
+		};
+
+		struct World
+		{
+			uint64 id = 0;
+			String name;
+			String s;
+			String v;
+			String sessionKey;
+			String lastIp;
+			String lastBuild;
+		};
+
+		struct Group
+		{
+			uint64 leaderGuid = 0;
+			std::vector<uint64> members;
+		};
+
+	private:
+		/// Blocks the calling database thread for the configured latency.
+		void SimulateLatency() const;
+
+		/// Creates a new world. m_mutex has to be locked.
+		World& AddWorld(const String& name, const String& s, const String& v);
+
+		/// Finds a character by its id. m_mutex has to be locked.
+		Character* FindCharacter(uint64 characterId);
+
+		/// Finds a character by its name. m_mutex has to be locked.
+		Character* FindCharacter(const String& name);
+
+		/// Finds a world by its name. m_mutex has to be locked.
+		World* FindWorld(const String& name);
+
+		/// Sets the last group of a character if it exists. m_mutex has to be locked.
+		void SetCharacterGroup(uint64 characterId, uint64 groupId);
+
+	private:
+		const MemoryDatabaseInfo m_info;
+		const proto::Project& m_project;
+		mutable std::mutex m_mutex;
+		std::map<uint64, Character> m_characters;
+		std::unordered_map<String, uint64> m_characterIdsByName;
+		std::unordered_map<uint64, std::vector<uint64>> m_characterIdsByAccount;
+		std::map<uint64, World> m_worlds;
+		std::unordered_map<String, uint64> m_worldIdsByName;
+		std::map<uint64, Group> m_groups;
+		uint64 m_nextCharacterId = 1;
+		uint64 m_nextWorldId = 1;
+	};
+}
@@ -2,6 +2,7 @@
 
 #include "mysql_database.h"
 
+#include <sstream>
 #include <utility>
 
 #include "mysql_wrapper/mysql_row.h"
@@ -503,15 +504,35 @@ namespace mmo
 		return WorldCreationResult::Success;
 	}
 
-	void MySQLDatabase::ChatMessage(const uint64 characterId, const uint16 type, const String message)
+	void MySQLDatabase::ChatMessages(const std::vector<ChatMessageData> messages)
 	{
-		if (!m_connection.Execute("INSERT INTO character_chat (`character`, `type`, `message`, `timestamp`) VALUES ("
-			+ std::to_string(characterId) + ", "
-			+ std::to_string(type) + ", '"
-			+ m_connection.EscapeString(message) + "', NOW())"))
+		if (messages.empty())
+		{
+			return;
+		}
+
+		// Insert all messages with a single statement to keep the database thread from falling behind on busy channels
+		std::ostringstream query;
+		query << "INSERT INTO character_chat (`character`, `type`, `message`, `timestamp`) VALUES ";
+		for (size_t i = 0; i < messages.size(); ++i)
+		{
+			const ChatMessageData& message = messages[i];
+			if (i > 0)
+			{
+				query << ", ";
+			}
+
+			query
+				<< "(" << message.characterId
+				<< ", " << message.type
+				<< ", '" << m_connection.EscapeString(message.message) << "'"
+				<< ", FROM_UNIXTIME(" << message.timestamp << "))";
+		}
+
+		if (!m_connection.Execute(query.str()))
 		{
 			PrintDatabaseError();
-			throw mysql::Exception("Could not save chat message to database");
+			throw mysql::Exception("Could not save chat messages to database");
 		}
 	}
 
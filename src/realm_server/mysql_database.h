@@ -49,7 +49,7 @@ namespace mmo
 		/// @copydoc IDatabase::CreateWorkd
 		std::optional<WorldCreationResult> CreateWorkd(const String& name, const String& s, const String& v) override;
 
-		void ChatMessage(uint64 characterId, uint16 type, String message) override;
+		void ChatMessages(std::vector<ChatMessageData> messages) override;
 
 		void UpdateCharacter(uint64 characterId, uint32 map, const Vector3& position, const Radian& orientation, uint32 level, uint32 xp, uint32 hp, uint32 mana, uint32 rage, uint32 energy, uint32 money, const std::vector<ItemData>& items, uint32 bindMap, const Vector3& bindPosition, const Radian& bindFacing, std::array<uint32, 5> attributePointsSpent, const std::vector<uint32>& spellIds) override;
 
@@ -10,22 +10,53 @@
 
 #include "base/random.h"
 #include "base/sha1.h"
+#include "character_name_cache.h"
+#include "chat_log_writer.h"
+#include "query_response_cache.h"
 #include "log/default_log_levels.h"
 #include "math/vector3.h"
 #include "math/degree.h"
 #include "proto_data/project.h"
 
+#include <array>
 #include <functional>
 
 #include "player_group.h"
 #include "base/utilities.h"
 #include "game/chat_type.h"
-#include "game/quest_info.h"
 #include "game_server/game_player_s.h"
 
 
 namespace mmo
 {
+	namespace
+	{
+		/// Maps the op code of a static data query to the data type and the op code of its result.
+		bool GetQueryType(const uint16 queryOpCode, QueryType& out_type, uint16& out_resultOpCode)
+		{
+			switch (queryOpCode)
+			{
+			case game::client_realm_packet::CreatureQuery:
+				out_type = QueryType::Creature;
+				out_resultOpCode = game::realm_client_packet::CreatureQueryResult;
+				return true;
+
+			case game::client_realm_packet::ItemQuery:
+				out_type = QueryType::Item;
+				out_resultOpCode = game::realm_client_packet::ItemQueryResult;
+				return true;
+
+			case game::client_realm_packet::QuestQuery:
+				out_type = QueryType::Quest;
+				out_resultOpCode = game::realm_client_packet::QuestQueryResult;
+				return true;
+
+			default:
+				return false;
+			}
+		}
+	}
+
 	Player::Player(
 		TimerQueue& timerQueue,
 		PlayerManager& playerManager,
@@ -35,6 +66,9 @@ namespace mmo
 		std::shared_ptr<Client> connection,
 		String address,
 		const proto::Project& project,
+		QueryResponseCache& queryResponses,
+		CharacterNameCache& nameCache,
+		ChatLogWriter& chatLog,
 		IdGenerator<uint64>& groupIdGenerator)
 		: m_timerQueue(timerQueue)
 		, m_manager(playerManager)
@@ -42,6 +76,9 @@ namespace mmo
 		, m_loginConnector(loginConnector)
 		, m_database(database)
 		, m_project(project)
+		, m_queryResponses(queryResponses)
+		, m_nameCache(nameCache)
+		, m_chatLog(chatLog)
 		, m_groupIdGenerator(groupIdGenerator)
 		, m_connection(std::move(connection))
 		, m_address(std::move(address))
@@ -112,6 +149,7 @@ namespace mmo
 						}
 
 						strongThis->m_characterViews[charView.GetGuid()] = charView;
+						strongThis->m_nameCache.Add(charView.GetGuid(), charView.GetName());
 					}
 				}
 
@@ -205,6 +243,14 @@ namespace mmo
 			return PacketParseResult::Disconnect;
 		}
 
+		// Older clients do not announce any features
+		if (!packet.getSource()->end() && !(packet >> io::read<uint32>(m_clientFeatures)))
+		{
+			ELOG("Could not read client features field of AuthSession packet from a game client");
+			return PacketParseResult::Disconnect;
+		}
+		m_clientFeatures &= game::client_feature::Supported;
+
 		// Verify the client build immediately for validity
 		if (m_build != mmo::Revision)
 		{
@@ -446,7 +492,13 @@ namespace mmo
 
 		// Database callback handler
 		std::weak_ptr weakThis{ shared_from_this() };
-		auto handler = [weakThis](bool success) {
+		CharacterNameCache& nameCache = m_nameCache;
+		auto handler = [weakThis, &nameCache, charGuid](bool success) {
+			if (success)
+			{
+				nameCache.Remove(charGuid);
+			}
+
 			if (auto strongThis = weakThis.lock())
 			{
 				if (success)
@@ -545,8 +597,8 @@ namespace mmo
 			return PacketParseResult::Disconnect;
 		}
 
-		// Store in database
-		m_database.asyncRequest([](bool) {}, &IDatabase::ChatMessage, m_characterData->characterId, static_cast<uint16>(chatType), message);
+		// Archive in database
+		m_chatLog.Add(m_characterData->characterId, static_cast<uint16>(chatType), message);
 
 		return PacketParseResult::Pass;
 	}
@@ -561,48 +613,65 @@ namespace mmo
 
 		DLOG("Received CMSG_NAME_QUERY for unit " << log_hex_digit(guid) << "...");
 
-		const Player* player = m_manager.GetPlayerByCharacterGuid(guid);
-		if (player != nullptr)
+		String name;
+		CharacterNameCache::LookupResult lookup = CharacterNameCache::LookupResult::Unknown;
+
+		if (const Player* player = m_manager.GetPlayerByCharacterGuid(guid))
 		{
-			String name = player->GetCharacterName();
-			m_connection->sendSinglePacket([guid, &name](game::OutgoingPacket& packet)
-				{
-					packet.Start(game::realm_client_packet::NameQueryResult);
-					packet
-						<< io::write_packed_guid(guid)
-						<< io::write<uint8>(true)
-						<< io::write_range(name) << io::write<uint8>(0);
-					packet.Finish();
-				});
+			name = player->GetCharacterName();
+			lookup = CharacterNameCache::LookupResult::Found;
 		}
 		else
 		{
-			// We have to look up the player name in the database
-			std::weak_ptr weakThis = shared_from_this();
-			auto handler = [weakThis, guid](std::optional<String>& playerName) {
-				if (const auto strongThis = weakThis.lock())
-				{
-					strongThis->m_connection->sendSinglePacket([guid, &playerName](game::OutgoingPacket& packet)
-						{
-							packet.Start(game::realm_client_packet::NameQueryResult);
-							packet
-								<< io::write_packed_guid(guid)
-								<< io::write<uint8>(playerName ? true : false);
-								if (playerName)
-								{
-									packet
-										<< io::write_range(*playerName) << io::write<uint8>(0);
-								}
-							packet.Finish();
-						});
-				}
-			};
-			m_database.asyncRequest(std::move(handler), &IDatabase::GetCharacterNameById, guid);
+			lookup = m_nameCache.Find(guid, name);
 		}
 
+		if (lookup != CharacterNameCache::LookupResult::Unknown)
+		{
+			SendNameQueryResult(guid, lookup == CharacterNameCache::LookupResult::Found ? &name : nullptr);
+			return PacketParseResult::Pass;
+		}
+
+		// We have to look up the player name in the database
+		std::weak_ptr weakThis = shared_from_this();
+		CharacterNameCache& nameCache = m_nameCache;
+		auto handler = [weakThis, &nameCache, guid](std::optional<String>& playerName) {
+			if (playerName)
+			{
+				nameCache.Add(guid, *playerName);
+			}
+			else
+			{
+				nameCache.AddNotFound(guid);
+			}
+
+			if (const auto strongThis = weakThis.lock())
+			{
+				strongThis->SendNameQueryResult(guid, playerName ? &*playerName : nullptr);
+			}
+		};
+		m_database.asyncRequest(std::move(handler), &IDatabase::GetCharacterNameById, guid);
+
 		return PacketParseResult::Pass;
 	}
 
+	void Player::SendNameQueryResult(uint64 guid, const String* name)
+	{
+		m_connection->sendSinglePacket([guid, name](game::OutgoingPacket& packet)
+			{
+				packet.Start(game::realm_client_packet::NameQueryResult);
+				packet
+					<< io::write_packed_guid(guid)
+					<< io::write<uint8>(name != nullptr);
+				if (name)
+				{
+					packet
+						<< io::write_range(*name) << io::write<uint8>(0);
+				}
+				packet.Finish();
+			});
+	}
+
 	PacketParseResult Player::OnDbQuery(game::IncomingPacket& packet)
 	{
 		uint64 guid;
@@ -611,25 +680,73 @@ namespace mmo
 			return PacketParseResult::Disconnect;
 		}
 
-		switch(packet.GetId())
+		QueryType type;
+		uint16 resultOpCode;
+		if (!GetQueryType(packet.GetId(), type, resultOpCode))
 		{
-		case game::client_realm_packet::CreatureQuery:
-			OnQueryCreature(guid);
-			break;
+			ELOG("Player tried to query unsupported item, packet handler might be subscribed for wrong op code (" << packet.GetId() << ")");
+			return PacketParseResult::Pass;
+		}
 
-		case game::client_realm_packet::ItemQuery:
-			OnQueryItem(guid);
-			break;
+		DLOG("Querying for entry " << log_hex_digit(guid) << " (op code " << log_hex_digit(packet.GetId()) << ")...");
 
-		case game::client_realm_packet::QuestQuery:
-			OnQueryQuest(guid);
-			break;
+		m_connection->sendSinglePacket([this, type, resultOpCode, guid](game::OutgoingPacket& outPacket)
+			{
+				outPacket.Start(resultOpCode);
+				m_queryResponses.WriteResponse(outPacket, type, guid);
+				outPacket.Finish();
+			});
 
-		default:
-			ELOG("Player tried to query unsupported item, packet handler might be subscribed for wrong op code (" << packet.GetId() << ")");
-			break;
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult Player::OnDbQueryBatch(game::IncomingPacket& packet)
+	{
+		uint16 queryOpCode, count;
+		if (!(packet >> io::read<uint16>(queryOpCode) >> io::read<uint16>(count)))
+		{
+			return PacketParseResult::Disconnect;
 		}
 
+		if (count == 0 || count > game::MaxDbQueryBatchSize)
+		{
+			ELOG("Player sent db query batch with invalid entry count " << count);
+			return PacketParseResult::Disconnect;
+		}
+
+		QueryType type;
+		uint16 resultOpCode;
+		if (!GetQueryType(queryOpCode, type, resultOpCode))
+		{
+			ELOG("Player tried to batch query unsupported op code " << queryOpCode);
+			return PacketParseResult::Disconnect;
+		}
+
+		std::array<uint64, game::MaxDbQueryBatchSize> entries;
+		for (uint16 i = 0; i < count; ++i)
+		{
+			if (!(packet >> io::read_packed_guid(entries[i])))
+			{
+				return PacketParseResult::Disconnect;
+			}
+		}
+
+		DLOG("Querying " << count << " entries for op code " << log_hex_digit(queryOpCode) << "...");
+
+		// All entries are answered in a single packet which saves a lot of round trips when entering a crowded zone
+		m_connection->sendSinglePacket([this, type, resultOpCode, count, &entries](game::OutgoingPacket& outPacket)
+			{
+				outPacket.Start(game::realm_client_packet::DbQueryBatchResult);
+				outPacket
+					<< io::write<uint16>(resultOpCode)
+					<< io::write<uint16>(count);
+				for (uint16 i = 0; i < count; ++i)
+				{
+					m_queryResponses.WriteResponse(outPacket, type, entries[i]);
+				}
+				outPacket.Finish();
+			});
+
 		return PacketParseResult::Pass;
 	}
 
@@ -682,7 +799,7 @@ namespace mmo
 
 		std::weak_ptr weakThis = shared_from_this();
 		std::weak_ptr weakWorld = world;
-		world->Join(*m_characterData, [weakThis, weakWorld](const InstanceId instanceId, const bool success)
+		world->Join(*m_characterData, m_clientFeatures, [weakThis, weakWorld](const InstanceId instanceId, const bool success)
 			{
 				const auto strongThis = weakThis.lock();
 				if (!strongThis)
@@ -1160,9 +1277,11 @@ namespace mmo
 		m_connection->GetCrypt().Init();
 
 		// Send the response to the client
-		m_connection->sendSinglePacket([](game::OutgoingPacket& packet) {
+		m_connection->sendSinglePacket([this](game::OutgoingPacket& packet) {
 			packet.Start(game::realm_client_packet::AuthSessionResponse);
-			packet << io::write<uint8>(game::auth_result::Success);	// TODO: Write real packet content
+			packet
+				<< io::write<uint8>(game::auth_result::Success)
+				<< io::write<uint64>(m_queryResponses.GetDataHash());
 			packet.Finish();
 		});
 
@@ -1275,6 +1394,7 @@ namespace mmo
 			m_proxyHandlers += RegisterAutoPacketHandler(game::client_realm_packet::AttributePoint, *this, &Player::OnProxyPacket);
 			m_proxyHandlers += RegisterAutoPacketHandler(game::client_realm_packet::TrainerBuySpell, *this, &Player::OnProxyPacket);
 			m_proxyHandlers += RegisterAutoPacketHandler(game::client_realm_packet::QuestGiverStatusQuery, *this, &Player::OnProxyPacket);
+			m_proxyHandlers += RegisterAutoPacketHandler(game::client_realm_packet::QuestGiverStatusMultipleQuery, *this, &Player::OnProxyPacket);
 			m_proxyHandlers += RegisterAutoPacketHandler(game::client_realm_packet::TrainerMenu, *this, &Player::OnProxyPacket);
 			m_proxyHandlers += RegisterAutoPacketHandler(game::client_realm_packet::ListInventory, *this, &Player::OnProxyPacket);
 			m_proxyHandlers += RegisterAutoPacketHandler(game::client_realm_packet::QuestGiverHello, *this, &Player::OnProxyPacket);
@@ -1304,6 +1424,7 @@ namespace mmo
 			RegisterPacketHandler(game::client_realm_packet::CreatureQuery, *this, &Player::OnDbQuery);
 			RegisterPacketHandler(game::client_realm_packet::ItemQuery, *this, &Player::OnDbQuery);
 			RegisterPacketHandler(game::client_realm_packet::QuestQuery, *this, &Player::OnDbQuery);
+			RegisterPacketHandler(game::client_realm_packet::DbQueryBatch, *this, &Player::OnDbQueryBatch);
 			RegisterPacketHandler(game::client_realm_packet::SetActionBarButton, *this, &Player::OnSetActionBarButton);
 			RegisterPacketHandler(game::client_realm_packet::GroupInvite, *this, &Player::OnGroupInvite);
 			RegisterPacketHandler(game::client_realm_packet::GroupUninvite, *this, &Player::OnGroupUninvite);
@@ -1322,6 +1443,7 @@ namespace mmo
 			ClearPacketHandler(game::client_realm_packet::CreatureQuery);
 			ClearPacketHandler(game::client_realm_packet::ItemQuery);
 			ClearPacketHandler(game::client_realm_packet::QuestQuery);
+			ClearPacketHandler(game::client_realm_packet::DbQueryBatch);
 			ClearPacketHandler(game::client_realm_packet::SetActionBarButton);
 			ClearPacketHandler(game::client_realm_packet::GroupInvite);
 			ClearPacketHandler(game::client_realm_packet::GroupUninvite);
@@ -1484,6 +1606,7 @@ namespace mmo
 		}
 
 		m_characterData = characterData;
+		m_nameCache.Add(m_characterData->characterId, m_characterData->name);
 
 		if (m_characterData->groupId != 0)
 		{
@@ -1541,7 +1664,7 @@ namespace mmo
 		// Send join request
 		std::weak_ptr weakThis = shared_from_this();
 		std::weak_ptr weakWorld = world;
-		world->Join(*m_characterData, [weakThis, weakWorld] (const InstanceId instanceId, const bool success)
+		world->Join(*m_characterData, m_clientFeatures, [weakThis, weakWorld] (const InstanceId instanceId, const bool success)
 		{
 			const auto strongThis = weakThis.lock();
 			if (!strongThis)
@@ -1588,219 +1711,6 @@ namespace mmo
 		}
 	}
 
-	void Player::OnQueryCreature(uint64 entry)
-	{
-		DLOG("Querying for creature " << log_hex_digit(entry) << "...");
-
-		const proto::UnitEntry* unit = m_project.units.getById(entry);
-		if (unit == nullptr)
-		{
-			WLOG("Could not find creature entry " << log_hex_digit(entry));
-			m_connection->sendSinglePacket([entry](game::OutgoingPacket& packet)
-				{
-					packet.Start(game::realm_client_packet::CreatureQueryResult);
-					packet
-						<< io::write_packed_guid(entry)
-						<< io::write<uint8>(false);
-					packet.Finish();
-				});
-			return;
-		}
-
-		m_connection->sendSinglePacket([unit](game::OutgoingPacket& packet)
-			{
-				packet.Start(game::realm_client_packet::CreatureQueryResult);
-				packet
-					<< io::write_packed_guid(unit->id())
-					<< io::write<uint8>(true)
-					<< io::write_range(unit->name()) << io::write<uint8>(0)
-					<< io::write_range(unit->subname()) << io::write<uint8>(0);
-				packet.Finish();
-			});
-	}
-
-	void Player::OnQueryQuest(uint64 entry)
-	{
-		DLOG("Querying for quest " << log_hex_digit(entry) << "...");
-
-		// Check for existing quest entry
-		const proto::QuestEntry* questEntry = m_project.quests.getById(entry);
-		if (!questEntry)
-		{
-			m_connection->sendSinglePacket([entry](game::OutgoingPacket& packet)
-				{
-					packet.Start(game::realm_client_packet::QuestQueryResult);
-					packet
-						<< io::write_packed_guid(entry)
-						<< io::write<uint8>(false);
-					packet.Finish();
-				});
-			return;
-		}
-
-		// Map quest info
-		QuestInfo quest;
-		quest.id = questEntry->id();
-		quest.title = questEntry->name();
-		quest.description = questEntry->detailstext();
-		quest.summary = questEntry->objectivestext();
-
-		quest.questLevel = questEntry->questlevel();
-		quest.rewardMoney = questEntry->rewardmoney();
-		quest.rewardXp = questEntry->rewardxp();
-
-		for (const auto& requirement : questEntry->requirements())
-		{
-			if (requirement.itemid() != 0)
-			{
-				quest.requiredItems.emplace_back(requirement.itemid(), requirement.itemcount());
-			}
-			else if(requirement.creatureid() != 0)
-			{
-				quest.requiredCreatures.emplace_back(requirement.creatureid(), requirement.creaturecount());
-			}
-		}
-
-		for (const auto& reward : questEntry->rewarditems())
-		{
-			quest.rewardItems.emplace_back(reward.itemid(), reward.count());
-		}
-
-		for (const auto& reward : questEntry->rewarditemschoice())
-		{
-			quest.optionalItems.emplace_back(reward.itemid(), reward.count());
-		}
-
-		m_connection->sendSinglePacket([entry, &quest](game::OutgoingPacket& packet)
-			{
-				packet.Start(game::realm_client_packet::QuestQueryResult);
-				packet
-					<< io::write_packed_guid(entry)
-					<< io::write<uint8>(true)
-					<< quest;
-				packet.Finish();
-			});
-	}
-
-	void Player::OnQueryItem(uint64 entry)
-	{
-		DLOG("Querying for item " << log_hex_digit(entry) << "...");
-
-		const proto::ItemEntry* itemEntry = m_project.items.getById(entry);
-		if (!itemEntry)
-		{
-			WLOG("Item with entry " << entry << " could not be found!");
-			m_connection->sendSinglePacket([entry](game::OutgoingPacket& packet)
-				{
-					packet.Start(game::realm_client_packet::ItemQueryResult);
-					packet
-						<< io::write_packed_guid(entry)
-						<< io::write<uint8>(false);
-					packet.Finish();
-				});
-			return;
-		}
-
-		// Map item entry
-		ItemInfo info;
-		info.name = itemEntry->name();
-		info.description = itemEntry->description();
-		info.id = entry;
-		info.itemClass = itemEntry->itemclass();
-		info.itemSubclass = itemEntry->subclass();
-		info.displayId = itemEntry->displayid();
-		info.quality = itemEntry->quality();
-		info.flags = itemEntry->flags();
-		info.buyCount = itemEntry->buycount();
-		info.buyPrice = itemEntry->buyprice();
-		info.sellPrice = itemEntry->sellprice();
-		info.inventoryType = itemEntry->inventorytype();
-		info.allowedClasses = itemEntry->allowedclasses();
-		info.allowedRaces = itemEntry->allowedraces();
-		info.itemlevel = itemEntry->itemlevel();
-		info.requiredlevel = itemEntry->requiredlevel();
-		info.requiredskill = itemEntry->requiredskill();
-		info.requiredskillrank = itemEntry->requiredskillrank();
-		info.requiredspell = itemEntry->requiredspell();
-		info.requiredrep = itemEntry->requiredrep();
-		info.requiredreprank = itemEntry->requiredreprank();
-		info.requiredcityrank = itemEntry->requiredcityrank();
-		info.requiredrep = itemEntry->requiredrep();
-		info.requiredreprank = itemEntry->requiredreprank();
-		info.maxcount = itemEntry->maxcount();
-		info.maxstack = itemEntry->maxstack();
-		info.containerslots = itemEntry->containerslots();
-
-		for (int i = 0; i < 10; ++i)
-		{
-			if (i >= itemEntry->stats_size())
-			{
-				info.stats[i].type = -1;
-				info.stats[i].value = 0;
-			}
-			else
-			{
-				const auto& stat = itemEntry->stats(i);
-				info.stats[i].type = stat.type();
-				info.stats[i].value = stat.value();
-			}
-		}
-
-		info.damage.type = itemEntry->damage().type();
-		info.damage.min = itemEntry->damage().mindmg();
-		info.damage.max = itemEntry->damage().maxdmg();
-		info.attackTime = itemEntry->delay();
-
-		for (int i = 0; i < 5; ++i)
-		{
-			if (i >= itemEntry->spells_size())
-			{
-				info.spells[i].spellId = -1;
-				info.spells[i].triggertype = 0;
-			}
-			else
-			{
-				const auto& spell = itemEntry->spells(i);
-				info.spells[i].spellId = spell.spell();
-				info.spells[i].triggertype = spell.trigger();
-			}
-		}
-
-		info.armor = itemEntry->armor();
-		info.resistance[0] = itemEntry->holyres();
-		info.resistance[1] = itemEntry->fireres();
-		info.resistance[2] = itemEntry->natureres();
-		info.resistance[3] = itemEntry->frostres();
-		info.resistance[4] = itemEntry->shadowres();
-		info.resistance[5] = itemEntry->arcaneres();
-		info.ammotype = itemEntry->ammotype();
-
-		info.bonding = itemEntry->bonding();
-		info.lockid = itemEntry->lockid();
-		info.sheath = itemEntry->sheath();
-		info.randomproperty = itemEntry->randomproperty();
-		info.randomsuffix = itemEntry->randomsuffix();
-		info.block = itemEntry->block();
-		info.itemset = itemEntry->itemset();
-		info.material = itemEntry->material();
-		info.maxdurability = itemEntry->durability();
-		info.area = itemEntry->area();
-		info.extraflags = itemEntry->extraflags();
-		info.startquestid = itemEntry->questentry();
-		info.skill = itemEntry->skill();
-		info.icon = itemEntry->icon();
-
-		m_connection->sendSinglePacket([entry, &info](game::OutgoingPacket& packet)
-			{
-				packet.Start(game::realm_client_packet::ItemQueryResult);
-				packet
-					<< io::write_packed_guid(entry)
-					<< io::write<uint8>(true)
-					<< info;
-				packet.Finish();
-			});
-	}
-
 	void Player::OnActionButtons(const ActionButtons& actionButtons)
 	{
 		m_actionButtons = actionButtons;
@@ -36,6 +36,9 @@ namespace mmo
 	class WorldManager;
 	class World;
 	class PlayerGroup;
+	class QueryResponseCache;
+	class CharacterNameCache;
+	class ChatLogWriter;
 
 	/// This class represents a player connction on the login server.
 	class Player final
@@ -57,6 +60,9 @@ namespace mmo
 			std::shared_ptr<Client> connection,
 			std::string address,
 			const proto::Project& project,
+			QueryResponseCache& queryResponses,
+			CharacterNameCache& nameCache,
+			ChatLogWriter& chatLog,
 			IdGenerator<uint64>& groupIdGenerator);
 
 		void Kick();
@@ -147,11 +153,10 @@ namespace mmo
 
 		void NotifyWorldNodeChanged(World* worldNode);
 
-		void OnQueryCreature(uint64 entry);
-
-		void OnQueryQuest(uint64 entry);
-
-		void OnQueryItem(uint64 entry);
+		/// Sends a name query result to the client.
+		/// @param guid Guid of the queried character.
+		/// @param name Name of the character or nullptr if there is no such character.
+		void SendNameQueryResult(uint64 guid, const String* name);
 
 		void OnActionButtons(const ActionButtons& actionButtons);
 
@@ -280,6 +285,9 @@ namespace mmo
 		LoginConnector &m_loginConnector;
 		AsyncDatabase &m_database;
 		const proto::Project& m_project;
+		QueryResponseCache& m_queryResponses;
+		CharacterNameCache& m_nameCache;
+		ChatLogWriter& m_chatLog;
 		IdGenerator<uint64>& m_groupIdGenerator;
 		std::shared_ptr<Client> m_connection;
 		std::string m_address;						// IP address in string format
@@ -291,6 +299,7 @@ namespace mmo
 		uint32 m_clientSeed;
 		uint64 m_accountId;
 		SHA1Hash m_clientHash;
+		uint32 m_clientFeatures = game::client_feature::None;	// Optional protocol features announced by the client
 		/// Session key of the game client, retrieved by login server on successful login request.
 		BigNumber m_sessionKey;
 		uint8 m_gmLevel = 0;
@@ -347,6 +356,7 @@ namespace mmo
 		PacketParseResult OnChatMessage(game::IncomingPacket& packet);
 		PacketParseResult OnNameQuery(game::IncomingPacket& packet);
 		PacketParseResult OnDbQuery(game::IncomingPacket& packet);
+		PacketParseResult OnDbQueryBatch(game::IncomingPacket& packet);
 		PacketParseResult OnSetActionBarButton(game::IncomingPacket& packet);
 		PacketParseResult OnMoveWorldPortAck(game::IncomingPacket& packet);
 		PacketParseResult OnGroupInvite(game::IncomingPacket& packet);
@@ -1,6 +1,7 @@
 // Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
 
 #include "player_manager.h"
+#include "base/metrics.h"
 #include "player.h"
 
 #include "binary_io/string_sink.h"
@@ -13,6 +14,7 @@ namespace mmo
 	PlayerManager::PlayerManager(
 	    size_t playerCapacity)
 		: m_playerCapacity(playerCapacity)
+		, m_connectionCount(MetricsRegistry::Get().AddGauge("mmo_connections", "Number of open connections by type.", "type=\"player\""))
 	{
 	}
 
@@ -33,6 +35,7 @@ namespace mmo
 		});
 		assert(p != m_players.end());
 		m_players.erase(p);
+		m_connectionCount.Set(static_cast<int64>(m_players.size()));
 	}
 	
 	bool PlayerManager::HasPlayerCapacityBeenReached()
@@ -47,6 +50,7 @@ namespace mmo
 
 		assert(added);
 		m_players.push_back(added);
+		m_connectionCount.Set(static_cast<int64>(m_players.size()));
 
 		// Challenge the newly connected client for authentication
 		added->SendAuthChallenge();
@@ -4,9 +4,13 @@
 #include "login_connector.h"
 #include "player_manager.h"
 #include "player.h"
+#include "character_name_cache.h"
+#include "chat_log_writer.h"
+#include "query_response_cache.h"
 #include "world_manager.h"
 #include "world.h"
 #include "mysql_database.h"
+#include "memory_database.h"
 #include "configuration.h"
 #include "version.h"
 #include "web_service.h"
@@ -21,6 +25,7 @@
 #include "game_protocol/game_protocol.h"
 #include "game_protocol/game_server.h"
 #include "base/constants.h"
+#include "base/crypto_worker_pool.h"
 #include "base/filesystem.h"
 #include "base/timer_queue.h"
 
@@ -127,21 +132,54 @@ namespace mmo
 			return 1;
 		}
 
+		// Caches shared by all players to answer static data and name queries
+		QueryResponseCache queryResponseCache(project);
+		CharacterNameCache characterNameCache(config.nameCacheCapacity);
+
 		/////////////////////////////////////////////////////////////////////////////////////////////////
 		// Database setup
 		/////////////////////////////////////////////////////////////////////////////////////////////////
 
-		auto database = std::make_unique<MySQLDatabase>(mmo::mysql::DatabaseInfo{
-			config.mysqlHost,
-			config.mysqlPort,
-			config.mysqlUser,
-			config.mysqlPassword,
-			config.mysqlDatabase,
-			config.mysqlUpdatePath
-			}, project, dbTimerQueue);
-		if (!database->Load())
+		std::unique_ptr<IDatabase> database;
+		MemoryDatabase* memoryDatabase = nullptr;
+		if (config.databaseType == "memory")
+		{
+			auto inMemoryDatabase = std::make_unique<MemoryDatabase>(MemoryDatabaseInfo{
+				config.databaseSnapshotFile,
+				config.databaseLatency,
+				config.databaseLatencyJitter,
+				config.databaseAutoCreatePassword
+				}, project);
+			if (!inMemoryDatabase->Load())
+			{
+				ELOG("Could not load the database");
+				return 1;
+			}
+
+			memoryDatabase = inMemoryDatabase.get();
+			database = std::move(inMemoryDatabase);
+		}
+		else if (config.databaseType == "mysql")
+		{
+			auto mysqlDatabase = std::make_unique<MySQLDatabase>(mmo::mysql::DatabaseInfo{
+				config.mysqlHost,
+				config.mysqlPort,
+				config.mysqlUser,
+				config.mysqlPassword,
+				config.mysqlDatabase,
+				config.mysqlUpdatePath
+				}, project, dbTimerQueue);
+			if (!mysqlDatabase->Load())
+			{
+				ELOG("Could not load the database");
+				return 1;
+			}
+
+			database = std::move(mysqlDatabase);
+		}
+		else
 		{
-			ELOG("Could not load the database");
+			ELOG("Unknown database type '" << config.databaseType << "', expected 'mysql' or 'memory'");
 			return 1;
 		}
 
@@ -149,6 +187,14 @@ namespace mmo
 		const auto sync = [&ioService](Action action) { ioService.post(std::move(action)); };
 		AsyncDatabase asyncDatabase{ *database, async, sync };
 
+		// Chat messages are archived in batches to not flood the database thread
+		ChatLogWriter chatLog{ asyncDatabase, timerQueue, config.chatLogBatchSize, config.chatLogFlushInterval };
+
+		// SRP6 calculations of world node logins are executed on this thread so they don't stall the network threads
+		const size_t cryptoWorkerCount = config.cryptoWorkerCount > 0 ? config.cryptoWorkerCount : std::max(std::thread::hardware_concurrency(), 1u);
+		CryptoWorkerPool cryptoWorkers{ cryptoWorkerCount, config.maxPendingCryptoJobs, sync };
+		ILOG("Running with " << cryptoWorkers.GetWorkerCount() << " crypto worker threads");
+
 		IdGenerator<uint64> groupIdGenerator{ 1 };
 
 
@@ -197,7 +243,7 @@ namespace mmo
 		}
 
 		// Careful: Called by multiple threads!
-		const auto createWorld = [&worldManager, &playerManager, &asyncDatabase, &project, &timerQueue](std::shared_ptr<World::Client> connection)
+		const auto createWorld = [&worldManager, &playerManager, &asyncDatabase, &cryptoWorkers, &project, &timerQueue](std::shared_ptr<World::Client> connection)
 		{
 			asio::ip::address address;
 
@@ -211,7 +257,7 @@ namespace mmo
 				return;
 			}
 
-			auto world = std::make_shared<World>(timerQueue, worldManager, playerManager, asyncDatabase, connection, address.to_string(), project);
+			auto world = std::make_shared<World>(timerQueue, worldManager, playerManager, asyncDatabase, cryptoWorkers, connection, address.to_string(), project);
 			ILOG("Incoming world node connection from " << address);
 			worldManager.AddWorld(std::move(world));
 
@@ -254,7 +300,7 @@ namespace mmo
 		}
 
 		// Careful: Called by multiple threads!
-		const auto createPlayer = [&playerManager, &worldManager, &asyncDatabase, &loginConnector, &project, &timerQueue, &groupIdGenerator](std::shared_ptr<Player::Client> connection)
+		const auto createPlayer = [&playerManager, &worldManager, &asyncDatabase, &loginConnector, &project, &queryResponseCache, &characterNameCache, &chatLog, &timerQueue, &groupIdGenerator](std::shared_ptr<Player::Client> connection)
 		{
 			asio::ip::address address;
 
@@ -268,7 +314,7 @@ namespace mmo
 				return;
 			}
 
-			auto player = std::make_shared<Player>(timerQueue, playerManager, worldManager, *loginConnector, asyncDatabase, connection, address.to_string(), project, groupIdGenerator);
+			auto player = std::make_shared<Player>(timerQueue, playerManager, worldManager, *loginConnector, asyncDatabase, connection, address.to_string(), project, queryResponseCache, characterNameCache, chatLog, groupIdGenerator);
 			ILOG("Incoming player connection from " << address);
 			playerManager.AddPlayer(std::move(player));
 
@@ -327,10 +373,18 @@ namespace mmo
 			thread.join();
 		}
 
+		// Archive the remaining chat messages before the database worker shuts down
+		chatLog.Flush();
+
 		// Terminate the database worker and wait for pending database operations to finish
 		dbWork.reset();
 		dbThread.join();
 
+		if (memoryDatabase)
+		{
+			memoryDatabase->Save();
+		}
+
 		return 0;
 	}
 }
@@ -0,0 +1,270 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "query_response_cache.h"
+
+#include "base/sha1.h"
+#include "base/utilities.h"
+#include "binary_io/vector_sink.h"
+#include "game/item.h"
+#include "game/quest_info.h"
+#include "log/default_log_levels.h"
+#include "proto_data/project.h"
+
+#include <cstring>
+#include <mutex>
+
+namespace mmo
+{
+	QueryResponseCache::QueryResponseCache(const proto::Project& project)
+		: m_project(project)
+		, m_dataHash(ComputeDataHash(project))
+	{
+	}
+
+	void QueryResponseCache::WriteResponse(io::Writer& writer, const QueryType type, const uint64 entry)
+	{
+		auto& responses = m_responses[static_cast<size_t>(type)];
+
+		{
+			std::shared_lock lock{ m_mutex };
+
+			// Buffers are never modified or erased once inserted, so they can be used after releasing the lock
+			if (const auto it = responses.find(entry); it != responses.end())
+			{
+				const Buffer& buffer = it->second;
+				lock.unlock();
+
+				writer << io::write_range(buffer);
+				return;
+			}
+		}
+
+		Buffer buffer;
+		{
+			io::VectorSink sink(buffer);
+			io::Writer bufferWriter(sink);
+			if (!SerializeResponse(bufferWriter, type, entry))
+			{
+				writer
+					<< io::write_packed_guid(entry)
+					<< io::write<uint8>(false);
+				return;
+			}
+		}
+
+		writer << io::write_range(buffer);
+
+		// Another thread might have serialized the same entry in the meantime, in which case we keep the existing buffer
+		std::unique_lock lock{ m_mutex };
+		responses.emplace(entry, std::move(buffer));
+	}
+
+	bool QueryResponseCache::SerializeResponse(io::Writer& writer, const QueryType type, const uint64 entry) const
+	{
+		switch (type)
+		{
+		case QueryType::Creature:
+			return SerializeCreature(writer, entry);
+		case QueryType::Item:
+			return SerializeItem(writer, entry);
+		case QueryType::Quest:
+			return SerializeQuest(writer, entry);
+		default:
+			return false;
+		}
+	}
+
+	bool QueryResponseCache::SerializeCreature(io::Writer& writer, const uint64 entry) const
+	{
+		const proto::UnitEntry* unit = m_project.units.getById(entry);
+		if (unit == nullptr)
+		{
+			WLOG("Could not find creature entry " << log_hex_digit(entry));
+			return false;
+		}
+
+		writer
+			<< io::write_packed_guid(entry)
+			<< io::write<uint8>(true)
+			<< io::write_range(unit->name()) << io::write<uint8>(0)
+			<< io::write_range(unit->subname()) << io::write<uint8>(0);
+
+		return true;
+	}
+
+	bool QueryResponseCache::SerializeItem(io::Writer& writer, const uint64 entry) const
+	{
+		const proto::ItemEntry* itemEntry = m_project.items.getById(entry);
+		if (!itemEntry)
+		{
+			WLOG("Item with entry " << entry << " could not be found!");
+			return false;
+		}
+
+		// Map item entry
+		ItemInfo info;
+		info.name = itemEntry->name();
+		info.description = itemEntry->description();
+		info.id = entry;
+		info.itemClass = itemEntry->itemclass();
+		info.itemSubclass = itemEntry->subclass();
+		info.displayId = itemEntry->displayid();
+		info.quality = itemEntry->quality();
+		info.flags = itemEntry->flags();
+		info.buyCount = itemEntry->buycount();
+		info.buyPrice = itemEntry->buyprice();
+		info.sellPrice = itemEntry->sellprice();
+		info.inventoryType = itemEntry->inventorytype();
+		info.allowedClasses = itemEntry->allowedclasses();
+		info.allowedRaces = itemEntry->allowedraces();
+		info.itemlevel = itemEntry->itemlevel();
+		info.requiredlevel = itemEntry->requiredlevel();
+		info.requiredskill = itemEntry->requiredskill();
+		info.requiredskillrank = itemEntry->requiredskillrank();
+		info.requiredspell = itemEntry->requiredspell();
+		info.requiredrep = itemEntry->requiredrep();
+		info.requiredreprank = itemEntry->requiredreprank();
+		info.requiredcityrank = itemEntry->requiredcityrank();
+		info.requiredrep = itemEntry->requiredrep();
+		info.requiredreprank = itemEntry->requiredreprank();
+		info.maxcount = itemEntry->maxcount();
+		info.maxstack = itemEntry->maxstack();
+		info.containerslots = itemEntry->containerslots();
+
+		for (int i = 0; i < 10; ++i)
+		{
+			if (i >= itemEntry->stats_size())
+			{
+				info.stats[i].type = -1;
+				info.stats[i].value = 0;
+			}
+			else
+			{
+				const auto& stat = itemEntry->stats(i);
+				info.stats[i].type = stat.type();
+				info.stats[i].value = stat.value();
+			}
+		}
+
+		info.damage.type = itemEntry->damage().type();
+		info.damage.min = itemEntry->damage().mindmg();
+		info.damage.max = itemEntry->damage().maxdmg();
+		info.attackTime = itemEntry->delay();
+
+		for (int i = 0; i < 5; ++i)
+		{
+			if (i >= itemEntry->spells_size())
+			{
+				info.spells[i].spellId = -1;
+				info.spells[i].triggertype = 0;
+			}
+			else
+			{
+				const auto& spell = itemEntry->spells(i);
+				info.spells[i].spellId = spell.spell();
+				info.spells[i].triggertype = spell.trigger();
+			}
+		}
+
+		info.armor = itemEntry->armor();
+		info.resistance[0] = itemEntry->holyres();
+		info.resistance[1] = itemEntry->fireres();
+		info.resistance[2] = itemEntry->natureres();
+		info.resistance[3] = itemEntry->frostres();
+		info.resistance[4] = itemEntry->shadowres();
+		info.resistance[5] = itemEntry->arcaneres();
+		info.ammotype = itemEntry->ammotype();
+
+		info.bonding = itemEntry->bonding();
+		info.lockid = itemEntry->lockid();
+		info.sheath = itemEntry->sheath();
+		info.randomproperty = itemEntry->randomproperty();
+		info.randomsuffix = itemEntry->randomsuffix();
+		info.block = itemEntry->block();
+		info.itemset = itemEntry->itemset();
+		info.material = itemEntry->material();
+		info.maxdurability = itemEntry->durability();
+		info.area = itemEntry->area();
+		info.extraflags = itemEntry->extraflags();
+		info.startquestid = itemEntry->questentry();
+		info.skill = itemEntry->skill();
+		info.icon = itemEntry->icon();
+
+		writer
+			<< io::write_packed_guid(entry)
+			<< io::write<uint8>(true)
+			<< info;
+
+		return true;
+	}
+
+	bool QueryResponseCache::SerializeQuest(io::Writer& writer, const uint64 entry) const
+	{
+		// Check for existing quest entry
+		const proto::QuestEntry* questEntry = m_project.quests.getById(entry);
+		if (!questEntry)
+		{
+			return false;
+		}
+
+		// Map quest info
+		QuestInfo quest;
+		quest.id = questEntry->id();
+		quest.title = questEntry->name();
+		quest.description = questEntry->detailstext();
+		quest.summary = questEntry->objectivestext();
+
+		quest.questLevel = questEntry->questlevel();
+		quest.rewardMoney = questEntry->rewardmoney();
+		quest.rewardXp = questEntry->rewardxp();
+
+		for (const auto& requirement : questEntry->requirements())
+		{
+			if (requirement.itemid() != 0)
+			{
+				quest.requiredItems.emplace_back(requirement.itemid(), requirement.itemcount());
+			}
+			else if(requirement.creatureid() != 0)
+			{
+				quest.requiredCreatures.emplace_back(requirement.creatureid(), requirement.creaturecount());
+			}
+		}
+
+		for (const auto& reward : questEntry->rewarditems())
+		{
+			quest.rewardItems.emplace_back(reward.itemid(), reward.count());
+		}
+
+		for (const auto& reward : questEntry->rewarditemschoice())
+		{
+			quest.optionalItems.emplace_back(reward.itemid(), reward.count());
+		}
+
+		writer
+			<< io::write_packed_guid(entry)
+			<< io::write<uint8>(true)
+			<< quest;
+
+		return true;
+	}
+
+	uint64 QueryResponseCache::ComputeDataHash(const proto::Project& project)
+	{
+		HashGeneratorSha1 generator;
+
+		const auto hashTemplates = [&generator](const auto& templates)
+		{
+			const std::string serialized = templates.SerializeAsString();
+			generator.update(serialized.data(), serialized.size());
+		};
+		hashTemplates(project.units.getTemplates());
+		hashTemplates(project.items.getTemplates());
+		hashTemplates(project.quests.getTemplates());
+
+		const SHA1Hash hash = generator.finalize();
+
+		uint64 result = 0;
+		std::memcpy(&result, hash.data(), sizeof(result));
+		return result;
+	}
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+#include "binary_io/writer.h"
+
+#include <array>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mmo
+{
+	namespace proto
+	{
+		class Project;
+	}
+
+	/// Enumerates the kinds of static data clients can query from the realm.
+	enum class QueryType : uint8
+	{
+		Creature,
+		Item,
+		Quest,
+
+		Count_
+	};
+
+	/// Realm-wide cache of serialized creature, item and quest query result bodies. The static data these results
+	/// are built from doesn't change while the realm is running, so each entry is serialized once when it is first
+	/// requested and the bytes are copied into the packets of every client asking for it afterwards. Thread safe.
+	class QueryResponseCache final : public NonCopyable
+	{
+	public:
+		explicit QueryResponseCache(const proto::Project& project);
+
+	public:
+		/// Writes the result body of an entry (packed guid, success flag and data) into a packet. Results for unknown
+		/// entries are not cached to keep clients from filling the cache with random ids.
+		void WriteResponse(io::Writer& writer, QueryType type, uint64 entry);
+
+		/// Gets a hash of all data clients can query. Clients drop their persisted query caches if it changes.
+		[[nodiscard]] uint64 GetDataHash() const { return m_dataHash; }
+
+	private:
+		typedef std::vector<char> Buffer;
+
+		/// Serializes the result body of an existing entry.
+		/// @returns false if there is no such entry.
+		bool SerializeResponse(io::Writer& writer, QueryType type, uint64 entry) const;
+
+		bool SerializeCreature(io::Writer& writer, uint64 entry) const;
+
+		bool SerializeItem(io::Writer& writer, uint64 entry) const;
+
+		bool SerializeQuest(io::Writer& writer, uint64 entry) const;
+
+		static uint64 ComputeDataHash(const proto::Project& project);
+
+	private:
+		const proto::Project& m_project;
+		const uint64 m_dataHash;
+		std::shared_mutex m_mutex;
+		std::array<std::unordered_map<uint64, Buffer>, static_cast<size_t>(QueryType::Count_)> m_responses;
+	};
+}
@@ -5,6 +5,7 @@
 #include "database.h"
 #include "web_service.h"
 #include "base/clock.h"
+#include "base/metrics.h"
 #include "http/http_incoming_request.h"
 #include "player_manager.h"
 #include "player.h"
@@ -54,6 +55,14 @@ namespace mmo
 					message << "{\"uptime\":" << gameTimeToSeconds<unsigned>(GetAsyncTimeMs() - startTime) << "}";
 					SendJsonResponse(response, message.str());
 				}
+				else if (url == "/metrics")
+				{
+					std::ostringstream message;
+					MetricsRegistry::Get().WriteText(message);
+
+					const String content = message.str();
+					response.finishWithContent("text/plain; version=0.0.4", content.data(), content.size());
+				}
 				else
 				{
 					response.setStatus(net::http::OutgoingAnswer::NotFound);
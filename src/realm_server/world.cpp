@@ -15,6 +15,8 @@
 #include "vector_sink.h"
 #include "base/big_number.h"
 #include "base/constants.h"
+#include "base/crypto_worker_pool.h"
+#include "base/srp6.h"
 #include "base/utilities.h"
 #include "game/game.h"
 #include "game_protocol/game_outgoing_packet.h"
@@ -29,6 +31,7 @@ namespace mmo
 		WorldManager& worldManager,
 		PlayerManager& playerManager,
 		AsyncDatabase& database, 
+		CryptoWorkerPool& cryptoWorkers,
 		std::shared_ptr<Client> connection, 
 		const String & address,
 		const proto::Project& project)
@@ -36,6 +39,7 @@ namespace mmo
 		, m_manager(worldManager)
 		, m_playerManager(playerManager)
 		, m_database(database)
+		, m_cryptoWorkers(cryptoWorkers)
 		, m_connection(std::move(connection))
 		, m_address(address)
 		, m_project(project)
@@ -130,11 +134,8 @@ namespace mmo
 					// We are NOT banned so continue
 					authResult = auth::auth_result::Success;
 
-					strongThis->m_b.setRand(19 * 8);
-					const auto gmod = constants::srp::g.modExp(strongThis->m_b, constants::srp::N);
-					strongThis->m_B = ((strongThis->m_v * 3) + gmod) % constants::srp::N;
-
-					assert(gmod.getNumBytes() <= 32);
+					strongThis->m_b.setRand(srp6::ServerPrivateKeyBits);
+					strongThis->m_B = srp6::CalculateServerPublicKey(strongThis->m_v, strongThis->m_b);
 					strongThis->m_unk3.setRand(16 * 8);
 
 					// Allow handling the logon proof packet now
@@ -204,141 +205,108 @@ namespace mmo
 			return PacketParseResult::Disconnect;
 		}
 
-		// Build hash
-		SHA1Hash hash = Sha1_BigNumbers({ A, m_B });
-
-		// Calculate u and S
-		BigNumber u{ hash.data(), hash.size() };
-		BigNumber S = (A * (m_v.modExp(u, constants::srp::N))).modExp(m_b, constants::srp::N);
-
-		// Build t
-		const auto t = S.asByteArray(32);
-		std::array<uint8, 16> t1{};
-		for (size_t i = 0; i < t1.size(); ++i)
-		{
-			t1[i] = t[i * 2];
-		}
-		hash = sha1(reinterpret_cast<const char*>(t1.data()), t1.size());
-
-		std::array<uint8, 40> vK{};
-		for (size_t i = 0; i < 20; ++i)
+		// Verifying the proof is the expensive part of the handshake, so do it on a crypto worker thread to
+		// keep the network threads responsive. Packet parsing is resumed as soon as the result is available.
+		std::weak_ptr weakThis{ shared_from_this() };
+		auto verifyProof = [identity = m_worldName, s = m_s, v = m_v, b = m_b, B = m_B, A, rec_M1]()
 		{
-			vK[i * 2] = hash[i];
-		}
-		for (size_t i = 0; i < 16; ++i)
+			return srp6::VerifyClientProof(identity, s, v, b, B, A, rec_M1);
+		};
+		auto proofVerified = [weakThis](const srp6::ServerProof& proof)
 		{
-			t1[i] = t[i * 2 + 1];
-		}
+			// The connection might have been closed in the meantime
+			const auto strongThis = weakThis.lock();
+			if (strongThis && strongThis->m_connection)
+			{
+				strongThis->OnLogonProofVerified(proof);
+				strongThis->m_connection->resumeParsing();
+			}
+		};
 
-		hash = sha1(reinterpret_cast<const char*>(t1.data()), t1.size());
-		for (size_t i = 0; i < 20; ++i)
+		if (!m_cryptoWorkers.Post(std::move(verifyProof), std::move(proofVerified)))
 		{
-			vK[i * 2 + 1] = hash[i];
+			WLOG("Too many pending logins, rejecting logon proof of world " << m_worldName);
+			SendAuthProof(auth::auth_result::FailDbBusy);
+			return PacketParseResult::Pass;
 		}
 
-		BigNumber K{ vK.data(), vK.size() };
+		return PacketParseResult::Block;
+	}
 
-		SHA1Hash h;
-		h = Sha1_BigNumbers({ constants::srp::N });
-		hash = Sha1_BigNumbers({ constants::srp::g });
-		for (size_t i = 0; i < h.size(); ++i)
+	void World::OnLogonProofVerified(const srp6::ServerProof& proof)
+	{
+		if (!proof.verified)
 		{
-			h[i] ^= hash[i];
-		}
-
-		BigNumber t3{ h.data(), h.size() };
+			// Log error
+			WLOG("Invalid password for world " << m_worldName);
 
-		HashGeneratorSha1 sha;
-		Sha1_Add_BigNumbers(sha, { t3 });
-		const auto t4 = sha1(reinterpret_cast<const char*>(m_worldName.data()), m_worldName.size());
-		sha.update(reinterpret_cast<const char*>(t4.data()), t4.size());
-		Sha1_Add_BigNumbers(sha, { m_s, A, m_B, K });
-		hash = sha.finalize();
+			// Send proof result
+			SendAuthProof(auth::auth_result::FailWrongCredentials);
+			return;
+		}
 
-		// Proof result which will be sent to the client
-		auth::AuthResult proofResult = auth::auth_result::FailWrongCredentials;
+		m_m2 = proof.m2;
+		m_sessionKey = 0;
 
-		// Calculate M1 hash on server using values sent by the client and compare it against
-		// the M1 hash sent by the client to see if the passwords do match.
-		const BigNumber m1{ hash.data(), hash.size() };
-		if (auto sArr = m1.asByteArray(20); std::equal(sArr.begin(), sArr.end(), rec_M1.begin()))
+		// Handler method
+		std::weak_ptr weakThis{ shared_from_this() };
+		auto handler = [weakThis, K = proof.sessionKey](const bool success)
 		{
-			// Finish SRP6 by calculating the M2 hash value that is sent back to the client for
-			// verification as well.
-			m_m2 = Sha1_BigNumbers({ A, m1, K });
-			m_sessionKey = 0;
-			
-			// Handler method
-			std::weak_ptr weakThis{ shared_from_this() };
-			auto handler = [weakThis, K](const bool success)
+			if (const auto strongThis = weakThis.lock())
 			{
-				if (const auto strongThis = weakThis.lock())
+				if (success)
 				{
-					if (success)
-					{
-						// Add log entry about successful login as the hashes do indeed mach (and thus, so
-						// do the passwords)
-						ILOG("World node " << strongThis->m_worldName << " successfully authenticated");
-
-						// Store the calculated session key value internally for later use, also store it in the 
-						// database maybe.
-						strongThis->m_sessionKey = K;
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::PropagateMapList, *strongThis, &World::OnPropagateMapList);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::PlayerCharacterJoined, *strongThis, &World::OnPlayerCharacterJoined);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::PlayerCharacterJoinFailed, *strongThis, &World::OnPlayerCharacterJoinFailed);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::PlayerCharacterLeft, *strongThis, &World::OnPlayerCharacterLeft);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::InstanceCreated, *strongThis, &World::OnInstanceCreated);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::InstanceDestroyed, *strongThis, &World::OnInstanceDestroyed);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::ProxyPacket, *strongThis, &World::OnProxyPacket);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::CharacterData, *strongThis, &World::OnCharacterData);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::QuestData, *strongThis, &World::OnQuestData);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::TeleportRequest, *strongThis, &World::OnTeleportRequest);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::CharacterLocationResponse, *strongThis, &World::OnCharacterLocationResponse);
-						strongThis->RegisterPacketHandler(auth::world_realm_packet::PlayerGroupUpdate, *strongThis, &World::OnPlayerGroupUpdate);
-
-						// If the login attempt succeeded, then we will accept RealmList request packets from now
-						// on to send the realm list to the client on manual request
-						strongThis->SendAuthProof(auth::AuthResult::Success);
-					}
-					else
-					{
-						strongThis->SendAuthProof(auth::AuthResult::FailDbBusy);
-					}
+					// Add log entry about successful login as the hashes do indeed mach (and thus, so
+					// do the passwords)
+					ILOG("World node " << strongThis->m_worldName << " successfully authenticated");
+
+					// Store the calculated session key value internally for later use, also store it in the 
+					// database maybe.
+					strongThis->m_sessionKey = K;
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::PropagateMapList, *strongThis, &World::OnPropagateMapList);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::PlayerCharacterJoined, *strongThis, &World::OnPlayerCharacterJoined);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::PlayerCharacterJoinFailed, *strongThis, &World::OnPlayerCharacterJoinFailed);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::PlayerCharacterLeft, *strongThis, &World::OnPlayerCharacterLeft);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::InstanceCreated, *strongThis, &World::OnInstanceCreated);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::InstanceDestroyed, *strongThis, &World::OnInstanceDestroyed);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::ProxyPacket, *strongThis, &World::OnProxyPacket);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::ProxyPacketMulti, *strongThis, &World::OnProxyPacketMulti);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::CharacterData, *strongThis, &World::OnCharacterData);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::QuestData, *strongThis, &World::OnQuestData);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::TeleportRequest, *strongThis, &World::OnTeleportRequest);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::CharacterLocationResponse, *strongThis, &World::OnCharacterLocationResponse);
+					strongThis->RegisterPacketHandler(auth::world_realm_packet::PlayerGroupUpdate, *strongThis, &World::OnPlayerGroupUpdate);
+
+					// If the login attempt succeeded, then we will accept RealmList request packets from now
+					// on to send the realm list to the client on manual request
+					strongThis->SendAuthProof(auth::AuthResult::Success);
 				}
-			};
-
-			// Build version string for database (cast to uint16 as ostringstream would otherwise treat uint8
-			// numbers as ascii character letters!)
-			std::ostringstream versionBuilder;
-			versionBuilder
-				<< static_cast<uint16>(m_version1)
-				<< "."
-				<< static_cast<uint16>(m_version2)
-				<< "."
-				<< static_cast<uint16>(m_version3)
-				<< "."
-				<< m_build;
-
-			// Store session key in account database
-			m_database.asyncRequest<void>(
-				[this, sessionKey = K.asHexStr(), capture1 = versionBuilder.str()](auto&& database)
+				else
 				{
-					database->WorldLogin(m_worldId, sessionKey, m_address, capture1);
-				},
-				std::move(handler));
-
-			// Stop here since we wait for the database callback
-			return PacketParseResult::Pass;
-		}
-		else
-		{
-			// Log error
-			WLOG("Invalid password for world " << m_worldName);
-		}
+					strongThis->SendAuthProof(auth::AuthResult::FailDbBusy);
+				}
+			}
+		};
 
-		// Send proof result
-		SendAuthProof(proofResult);
-		return PacketParseResult::Pass;
+		// Build version string for database (cast to uint16 as ostringstream would otherwise treat uint8
+		// numbers as ascii character letters!)
+		std::ostringstream versionBuilder;
+		versionBuilder
+			<< static_cast<uint16>(m_version1)
+			<< "."
+			<< static_cast<uint16>(m_version2)
+			<< "."
+			<< static_cast<uint16>(m_version3)
+			<< "."
+			<< m_build;
+
+		// Store session key in account database
+		m_database.asyncRequest<void>(
+			[this, sessionKey = proof.sessionKey.asHexStr(), capture1 = versionBuilder.str()](auto&& database)
+			{
+				database->WorldLogin(m_worldId, sessionKey, m_address, capture1);
+			},
+			std::move(handler));
 	}
 
 	void World::SendAuthProof(auth::AuthResult result)
@@ -404,7 +372,7 @@ namespace mmo
 		return PacketParseResult::Pass;
 	}
 
-	void World::Join(CharacterData characterData, JoinWorldCallback callback)
+	void World::Join(CharacterData characterData, const uint32 clientFeatures, JoinWorldCallback callback)
 	{
 		// TODO: What if we already have a waiting callback? Right now we just discard the old one
 		if (callback)
@@ -413,10 +381,10 @@ namespace mmo
 			m_joinCallbacks.emplace(characterData.characterId, std::move(callback));	
 		}
 		
-		GetConnection().sendSinglePacket([characterData](auth::OutgoingPacket& outPacket)
+		GetConnection().sendSinglePacket([characterData, clientFeatures](auth::OutgoingPacket& outPacket)
 		{
 			outPacket.Start(auth::realm_world_packet::PlayerCharacterJoin);
-			outPacket << characterData;
+			outPacket << characterData << io::write<uint32>(clientFeatures);
 			outPacket.Finish();
 		});
 	}
@@ -625,6 +593,41 @@ namespace mmo
 		return PacketParseResult::Pass;
 	}
 
+	PacketParseResult World::OnProxyPacketMulti(auth::IncomingPacket& packet)
+	{
+		uint16 packetId;
+		uint32 packetSize;
+		std::vector<uint8> packetContent;
+		std::vector<uint64> characterGuids;
+		if (!(packet
+			>> io::read<uint16>(packetId)
+			>> io::read<uint32>(packetSize)
+			>> io::read_container<uint32>(packetContent)
+			>> io::read_container<uint32>(characterGuids)
+			))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		// Serialize the packet once and reuse the buffer for every receiver
+		std::vector<char> outBuffer;
+		io::VectorSink sink { outBuffer };
+
+		game::OutgoingPacket proxyPacket(sink, true);
+		proxyPacket
+			<< io::write_range(packetContent);
+
+		for (const uint64 characterGuid : characterGuids)
+		{
+			if (auto* player = m_playerManager.GetPlayerByCharacterGuid(characterGuid))
+			{
+				player->SendProxyPacket(packetId, outBuffer);
+			}
+		}
+
+		return PacketParseResult::Pass;
+	}
+
 	PacketParseResult World::OnCharacterData(auth::IncomingPacket& packet)
 	{
 		uint64 characterGuid = 0;
@@ -35,6 +35,12 @@ namespace mmo
 
 	class PlayerManager;
 	class AsyncDatabase;
+	class CryptoWorkerPool;
+
+	namespace srp6
+	{
+		struct ServerProof;
+	}
 
 	/// Callback executed after a world join returned a result.
 	typedef std::function<void(InstanceId instanceId, bool success)> JoinWorldCallback;
@@ -58,6 +64,7 @@ namespace mmo
 			WorldManager &manager,
 			PlayerManager& playerManager,
 			AsyncDatabase &database,
+			CryptoWorkerPool &cryptoWorkers,
 			std::shared_ptr<Client> connection,
 			const std::string &address,
 			const proto::Project& project);
@@ -71,7 +78,11 @@ namespace mmo
 		/// Gets the name of this world.
 		const String& GetWorldName() const { return m_worldName; }
 
-		void Join(CharacterData characterData, JoinWorldCallback callback);
+		/// Lets a character join this world.
+		/// @param characterData The character to join.
+		/// @param clientFeatures Features announced by the client of the character, see game::client_feature.
+		/// @param callback Called once the world answered the join request.
+		void Join(CharacterData characterData, uint32 clientFeatures, JoinWorldCallback callback);
 
 		void Leave(ObjectGuid characterGuid, auth::WorldLeftReason reason);
 
@@ -118,6 +129,7 @@ namespace mmo
 		WorldManager &m_manager;
 		PlayerManager& m_playerManager;
 		AsyncDatabase &m_database;
+		CryptoWorkerPool &m_cryptoWorkers;
 		std::shared_ptr<Client> m_connection;
 		std::string m_address;						// IP address in string format
 		std::map<uint16, PacketHandler> m_packetHandlers;
@@ -170,6 +182,10 @@ namespace mmo
 		/// @param packet The packet data.
 		PacketParseResult OnLogonProof(auth::IncomingPacket& packet);
 
+		/// Finishes the logon proof after the client proof has been verified by a crypto worker.
+		/// @param proof The verification result.
+		void OnLogonProofVerified(const srp6::ServerProof& proof);
+
 		/// Handles an incoming packet with packet id OnPropagateMapList.
 		/// @param packet The packet data.
 		PacketParseResult OnPropagateMapList(auth::IncomingPacket& packet);
@@ -186,6 +202,8 @@ namespace mmo
 		
 		PacketParseResult OnProxyPacket(auth::IncomingPacket& packet);
 
+		PacketParseResult OnProxyPacketMulti(auth::IncomingPacket& packet);
+
 		PacketParseResult OnCharacterData(auth::IncomingPacket& packet);
 
 		PacketParseResult OnQuestData(auth::IncomingPacket& packet);
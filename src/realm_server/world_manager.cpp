@@ -4,6 +4,7 @@
 #include "world.h"
 
 #include "base/macros.h"
+#include "base/metrics.h"
 
 #include <cassert>
 
@@ -13,6 +14,7 @@ namespace mmo
 	WorldManager::WorldManager(
 	    size_t capacity)
 		: m_capacity(capacity)
+		, m_connectionCount(MetricsRegistry::Get().AddGauge("mmo_connections", "Number of open connections by type.", "type=\"world\""))
 	{
 	}
 
@@ -31,6 +33,7 @@ namespace mmo
 		});
 		ASSERT(p != m_worlds.end());
 		m_worlds.erase(p);
+		m_connectionCount.Set(static_cast<int64>(m_worlds.size()));
 	}
 	
 	bool WorldManager::HasCapacityBeenReached()
@@ -45,6 +48,7 @@ namespace mmo
 
 		ASSERT(added);
 		m_worlds.push_back(added);
+		m_connectionCount.Set(static_cast<int64>(m_worlds.size()));
 	}
 
 	std::shared_ptr<World> WorldManager::GetIdealWorldNode(MapId mapId, InstanceId instanceId)
@@ -12,6 +12,7 @@
 namespace mmo
 {
 	class World;
+	class MetricGauge;
 
 	/// Manages all connected players.
 	class WorldManager final : public NonCopyable
@@ -52,6 +53,7 @@ namespace mmo
 
 		Worlds m_worlds;
 		size_t m_capacity;
+		MetricGauge& m_connectionCount;
 		std::mutex m_worldsMutex;
 	};
 }
@@ -0,0 +1,291 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "asset_streamer.h"
+#include "asset_registry.h"
+
+#include "base/macros.h"
+#include "log/default_log_levels.h"
+
+#include <algorithm>
+#include <iterator>
+
+
+namespace mmo
+{
+	AssetStreamer::AssetStreamer(const uint32 workerCount)
+	{
+		ASSERT(workerCount > 0);
+
+		m_workers.reserve(workerCount);
+		for (uint32 i = 0; i < workerCount; ++i)
+		{
+			m_workers.emplace_back([this]() { WorkerThread(); });
+		}
+	}
+
+	AssetStreamer::~AssetStreamer()
+	{
+		{
+			std::unique_lock lock { m_mutex };
+			m_stop = true;
+		}
+
+		m_workAvailable.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	AssetStreamer::RequestId AssetStreamer::Request(const String& filename, const float priority, CompletionHandler completion, DecodeHandler decode)
+	{
+		std::unique_lock lock { m_mutex };
+
+		const RequestId id = m_nextRequestId++;
+
+		EntryPtr& entry = m_entries[filename];
+		if (!entry)
+		{
+			entry = std::make_shared<Entry>();
+			entry->filename = filename;
+			entry->priority = priority;
+			entry->decode = std::move(decode);
+			m_queue.push_back(entry);
+		}
+
+		entry->waiters.push_back({ id, priority, std::move(completion) });
+		UpdateEntryPriority(*entry);
+
+		m_requests[id] = entry;
+		lock.unlock();
+
+		m_workAvailable.notify_one();
+		return id;
+	}
+
+	void AssetStreamer::SetPriority(const RequestId id, const float priority)
+	{
+		std::unique_lock lock { m_mutex };
+
+		const auto it = m_requests.find(id);
+		if (it == m_requests.end())
+		{
+			return;
+		}
+
+		Entry& entry = *it->second;
+		for (auto& waiter : entry.waiters)
+		{
+			if (waiter.id == id)
+			{
+				waiter.priority = priority;
+				break;
+			}
+		}
+
+		UpdateEntryPriority(entry);
+	}
+
+	void AssetStreamer::Cancel(const RequestId id, const bool waitForDecode)
+	{
+		std::unique_lock lock { m_mutex };
+
+		const auto it = m_requests.find(id);
+		if (it == m_requests.end())
+		{
+			return;
+		}
+
+		const EntryPtr entry = it->second;
+		m_requests.erase(it);
+
+		std::erase_if(entry->waiters, [id](const Waiter& waiter) { return waiter.id == id; });
+		if (entry->waiters.empty())
+		{
+			if (entry->state == EntryState::Queued)
+			{
+				std::erase(m_queue, entry);
+				RemoveEntry(entry);
+			}
+			else if (entry->state == EntryState::Completed)
+			{
+				std::erase(m_completed, entry);
+				RemoveEntry(entry);
+			}
+
+			// Entries which are currently loading are discarded by the worker thread
+		}
+		else
+		{
+			UpdateEntryPriority(*entry);
+		}
+
+		if (waitForDecode)
+		{
+			m_decodeFinished.wait(lock, [&entry]() { return entry->state != EntryState::Loading; });
+		}
+	}
+
+	size_t AssetStreamer::ProcessCompletions(const size_t maxCompletions)
+	{
+		size_t processed = 0;
+
+		while (processed < maxCompletions)
+		{
+			std::unique_lock lock { m_mutex };
+			if (m_completed.empty())
+			{
+				break;
+			}
+
+			const EntryPtr entry = std::move(m_completed.front());
+			m_completed.pop_front();
+			RemoveEntry(entry);
+
+			std::vector<Waiter> waiters = std::move(entry->waiters);
+			for (const auto& waiter : waiters)
+			{
+				m_requests.erase(waiter.id);
+			}
+
+			lock.unlock();
+
+			// Handlers are executed without holding the lock, so they are free to issue new requests
+			for (const auto& waiter : waiters)
+			{
+				if (waiter.completion)
+				{
+					waiter.completion(entry->succeeded, entry->contents);
+				}
+			}
+
+			++processed;
+		}
+
+		return processed;
+	}
+
+	size_t AssetStreamer::GetPendingCount() const
+	{
+		std::unique_lock lock { m_mutex };
+		return m_entries.size();
+	}
+
+	float AssetStreamer::CalculatePriority(const float distance, const bool isVisible) noexcept
+	{
+		return isVisible ? distance : distance * InvisiblePriorityScale;
+	}
+
+	void AssetStreamer::WorkerThread()
+	{
+		for (;;)
+		{
+			EntryPtr entry;
+
+			{
+				std::unique_lock lock { m_mutex };
+				m_workAvailable.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+
+				if (m_stop)
+				{
+					return;
+				}
+
+				// Pick the most important request. The queue is short, so a linear scan is fine and
+				// allows priorities to change while requests are queued.
+				const auto it = std::min_element(m_queue.begin(), m_queue.end(), [](const EntryPtr& a, const EntryPtr& b)
+				{
+					return a->priority < b->priority;
+				});
+
+				entry = *it;
+				*it = std::move(m_queue.back());
+				m_queue.pop_back();
+
+				entry->state = EntryState::Loading;
+			}
+
+			std::vector<char> contents;
+			bool succeeded = false;
+
+			if (const auto file = AssetRegistry::OpenFile(entry->filename); file && *file)
+			{
+				contents.assign(std::istreambuf_iterator<char>(*file), std::istreambuf_iterator<char>());
+				succeeded = !file->bad();
+				++m_loadedFileCount;
+			}
+			else
+			{
+				ELOG("Unable to stream asset file " << entry->filename);
+			}
+
+			bool decodeSkipped = false;
+			if (succeeded && entry->decode)
+			{
+				{
+					std::unique_lock lock { m_mutex };
+					decodeSkipped = entry->waiters.empty();
+				}
+
+				if (!decodeSkipped)
+				{
+					succeeded = entry->decode(contents);
+				}
+			}
+
+			{
+				std::unique_lock lock { m_mutex };
+
+				entry->contents = std::move(contents);
+				entry->succeeded = succeeded;
+
+				if (entry->waiters.empty())
+				{
+					// All requests were cancelled in the meantime
+					entry->state = EntryState::Queued;
+					RemoveEntry(entry);
+				}
+				else if (decodeSkipped)
+				{
+					// The file has been requested again after the decode step was skipped, so serve it again
+					entry->contents.clear();
+					entry->state = EntryState::Queued;
+					m_queue.push_back(entry);
+					lock.unlock();
+
+					m_workAvailable.notify_one();
+				}
+				else
+				{
+					entry->state = EntryState::Completed;
+					m_completed.push_back(entry);
+				}
+			}
+
+			m_decodeFinished.notify_all();
+		}
+	}
+
+	void AssetStreamer::RemoveEntry(const EntryPtr& entry)
+	{
+		const auto it = m_entries.find(entry->filename);
+		if (it != m_entries.end() && it->second == entry)
+		{
+			m_entries.erase(it);
+		}
+	}
+
+	void AssetStreamer::UpdateEntryPriority(Entry& entry)
+	{
+		if (entry.waiters.empty())
+		{
+			return;
+		}
+
+		entry.priority = std::min_element(entry.waiters.begin(), entry.waiters.end(), [](const Waiter& a, const Waiter& b)
+		{
+			return a.priority < b.priority;
+		})->priority;
+	}
+}
@@ -0,0 +1,137 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+#include "base/utilities.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace mmo
+{
+	/// Streams asset files in the background. File I/O (including archive decompression) and an optional
+	/// decode step are executed on worker threads, while results are handed back on the thread which
+	/// calls ProcessCompletions (usually the main thread), so that only cheap finalization work like
+	/// gpu resource creation remains there.
+	///
+	/// Requests are served in order of their priority (lower values first). Requests for the same file
+	/// are merged while they are in flight, and cancelled requests never execute their completion handler.
+	class AssetStreamer final
+		: public NonCopyable
+	{
+	public:
+		/// Identifies a single request made to the streamer.
+		typedef uint64 RequestId;
+
+		/// Value used for requests that do not exist.
+		static constexpr RequestId InvalidRequest = 0;
+
+		/// Priority scale applied to requests which are currently not visible to the camera.
+		static constexpr float InvisiblePriorityScale = 4.0f;
+
+		/// Executed on a worker thread after the file has been read. Returns false if decoding failed.
+		typedef std::function<bool(std::vector<char>& contents)> DecodeHandler;
+
+		/// Executed on the thread calling ProcessCompletions once a request has been served.
+		typedef std::function<void(bool succeeded, const std::vector<char>& contents)> CompletionHandler;
+
+	public:
+		/// Starts the given number of worker threads.
+		explicit AssetStreamer(uint32 workerCount = 2);
+
+		/// Stops all worker threads. Pending requests are dropped without notification.
+		~AssetStreamer() override;
+
+	public:
+		/// Requests the given asset file to be streamed in.
+		/// @param filename Name of the file in the asset registry.
+		/// @param priority Priority of the request. Lower values are served first.
+		/// @param completion Executed by ProcessCompletions once the file has been read and decoded.
+		/// @param decode Optional decode step executed on the worker thread. If the file is already in
+		///	       flight, the decode handler of the first request is used.
+		/// @returns Id of the request which can be used to update its priority or to cancel it.
+		RequestId Request(const String& filename, float priority, CompletionHandler completion, DecodeHandler decode = nullptr);
+
+		/// Updates the priority of a request that has not yet been picked up by a worker thread.
+		void SetPriority(RequestId id, float priority);
+
+		/// Cancels a request. Its completion handler will not be executed. If no other request for the same
+		/// file remains, the file is not loaded at all or its result is discarded.
+		/// @param waitForDecode If true and the file is currently being decoded, blocks until the decode
+		///	       handler returned. Use this if the decode handler references objects which are about to be destroyed.
+		void Cancel(RequestId id, bool waitForDecode = false);
+
+		/// Executes the completion handlers of served requests on the calling thread.
+		/// @param maxCompletions Maximum number of files to finalize, used to spread work across frames.
+		/// @returns Number of files that have been finalized.
+		size_t ProcessCompletions(size_t maxCompletions = std::numeric_limits<size_t>::max());
+
+		/// Gets the number of files which are queued, in flight or waiting for completion.
+		[[nodiscard]] size_t GetPendingCount() const;
+
+		/// Gets the number of files which have been read by worker threads so far.
+		[[nodiscard]] uint64 GetLoadedFileCount() const { return m_loadedFileCount.load(); }
+
+		/// Calculates a request priority from the distance to the camera and whether the asset is visible.
+		[[nodiscard]] static float CalculatePriority(float distance, bool isVisible) noexcept;
+
+	private:
+		enum class EntryState : uint8
+		{
+			Queued,
+			Loading,
+			Completed
+		};
+
+		struct Waiter
+		{
+			RequestId id;
+			float priority;
+			CompletionHandler completion;
+		};
+
+		struct Entry
+		{
+			String filename;
+			float priority;
+			DecodeHandler decode;
+			std::vector<Waiter> waiters;
+			std::vector<char> contents;
+			EntryState state = EntryState::Queued;
+			bool succeeded = false;
+		};
+
+		typedef std::shared_ptr<Entry> EntryPtr;
+
+	private:
+		void WorkerThread();
+
+		void RemoveEntry(const EntryPtr& entry);
+
+		static void UpdateEntryPriority(Entry& entry);
+
+	private:
+		mutable std::mutex m_mutex;
+		std::condition_variable m_workAvailable;
+		std::condition_variable m_decodeFinished;
+		std::map<String, EntryPtr, StrCaseIComp> m_entries;
+		std::map<RequestId, EntryPtr> m_requests;
+		std::vector<EntryPtr> m_queue;
+		std::deque<EntryPtr> m_completed;
+		std::vector<std::thread> m_workers;
+		RequestId m_nextRequestId { 1 };
+		std::atomic<uint64> m_loadedFileCount { 0 };
+		bool m_stop { false };
+	};
+}
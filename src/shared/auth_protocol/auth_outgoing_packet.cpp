@@ -2,12 +2,25 @@
 
 #include "auth_outgoing_packet.h"
 
+#include "base/metrics.h"
+
 namespace mmo
 {
 	namespace auth
 	{
+		namespace
+		{
+			MetricCounterArray& GetPacketsSent()
+			{
+				static MetricCounterArray& s_packetsSent = MetricsRegistry::Get().AddCounterArray(
+					"mmo_packets_sent_total", "Number of packets written per op code.", "opcode", 256, "protocol=\"auth\"");
+				return s_packetsSent;
+			}
+		}
+
 		OutgoingPacket::OutgoingPacket(io::ISink &sink)
 			: io::Writer(sink)
+			, m_id(0)
 			, m_sizePos(0)
 			, m_bodyPos(0)
 		{
@@ -15,6 +28,7 @@ namespace mmo
 
 		void OutgoingPacket::Start(uint8 id)
 		{
+			m_id = id;
 			*this << io::write<uint8>(id);
 
 			m_sizePos = Sink().Position();
@@ -30,6 +44,8 @@ namespace mmo
 
 			const uint32 packetSize = endPos - m_bodyPos;
 			Sink().Overwrite(m_sizePos, reinterpret_cast<const char*>(&packetSize), sizeof(packetSize));
+
+			GetPacketsSent().Increment(m_id);
 		}
 	}
 }
@@ -20,6 +20,7 @@ namespace mmo
 			void Finish();
 
 		private:
+			uint8 m_id;
 			size_t m_sizePos;
 			size_t m_bodyPos;
 		};
@@ -163,7 +163,10 @@ namespace mmo
 
 				CharacterLocationResponse,
 
-				PlayerGroupUpdate
+				PlayerGroupUpdate,
+
+				/// A packet which will be forwarded to multiple game clients. Contains the packet once, followed by the guids of all receiving characters.
+				ProxyPacketMulti
 			};
 		}
 
@@ -208,6 +208,82 @@ namespace mmo
 		return BN_cmp(m_bn, Other.m_bn) == 0;
 	}
 
+	FixedBaseModExp::FixedBaseModExp(const BigNumber &base, const BigNumber &modulus, const uint32 maxExponentBits)
+		: m_base(base)
+		, m_modulus(modulus)
+		, m_maxExponentBits((maxExponentBits + WindowBits - 1) / WindowBits * WindowBits)
+		, m_mont(BN_MONT_CTX_new())
+	{
+		BN_CTX *bnctx = BN_CTX_new();
+		BN_MONT_CTX_set(m_mont, m_modulus.m_bn, bnctx);
+
+		// One in montgomery form is the start value of every exponentiation
+		BN_to_montgomery(m_one.m_bn, BigNumber(1).m_bn, m_mont, bnctx);
+
+		// Entry [i * WindowSize + j] holds base^(j * 16^i), entry j = 0 is unused
+		const uint32 windowCount = m_maxExponentBits / WindowBits;
+		m_table.resize(windowCount * WindowSize);
+
+		BigNumber windowBase;
+		BN_mod(windowBase.m_bn, m_base.m_bn, m_modulus.m_bn, bnctx);
+		BN_to_montgomery(windowBase.m_bn, windowBase.m_bn, m_mont, bnctx);
+
+		for (uint32 i = 0; i < windowCount; ++i)
+		{
+			BigNumber *const window = &m_table[i * WindowSize];
+			window[1] = windowBase;
+
+			for (uint32 j = 2; j < WindowSize; ++j)
+			{
+				BN_mod_mul_montgomery(window[j].m_bn, window[j - 1].m_bn, windowBase.m_bn, m_mont, bnctx);
+			}
+
+			BN_mod_mul_montgomery(windowBase.m_bn, window[WindowSize - 1].m_bn, windowBase.m_bn, m_mont, bnctx);
+		}
+
+		BN_CTX_free(bnctx);
+	}
+
+	FixedBaseModExp::~FixedBaseModExp()
+	{
+		BN_MONT_CTX_free(m_mont);
+	}
+
+	BigNumber FixedBaseModExp::modExp(const BigNumber &exponent) const
+	{
+		if (BN_is_negative(exponent.m_bn) || static_cast<uint32>(BN_num_bits(exponent.m_bn)) > m_maxExponentBits)
+		{
+			return m_base.modExp(exponent, m_modulus);
+		}
+
+		BN_CTX *bnctx = BN_CTX_new();
+
+		BigNumber ret = m_one;
+
+		const int numBits = BN_num_bits(exponent.m_bn);
+		for (int bit = 0, window = 0; bit < numBits; bit += WindowBits, ++window)
+		{
+			uint32 index = 0;
+			for (uint32 i = 0; i < WindowBits; ++i)
+			{
+				if (BN_is_bit_set(exponent.m_bn, bit + static_cast<int>(i)))
+				{
+					index |= 1 << i;
+				}
+			}
+
+			if (index != 0)
+			{
+				BN_mod_mul_montgomery(ret.m_bn, ret.m_bn, m_table[window * WindowSize + index].m_bn, m_mont, bnctx);
+			}
+		}
+
+		BN_from_montgomery(ret.m_bn, ret.m_bn, m_mont, bnctx);
+		BN_CTX_free(bnctx);
+
+		return ret;
+	}
+
 	SHA1Hash Sha1_BigNumbers(std::initializer_list<BigNumber> args)
 	{
 		HashGeneratorSha1 gen;
@@ -3,15 +3,19 @@
 #pragma once
 
 #include "typedefs.h"
+#include "non_copyable.h"
 #include <vector>
 #include "sha1.h"
 
 struct bignum_st;
+struct bn_mont_ctx_st;
 
 namespace mmo
 {
 	class BigNumber final
 	{
+		friend class FixedBaseModExp;
+
 	public:
 
 		/// Initializes an empty number (zero).
@@ -96,6 +100,40 @@ namespace mmo
 		bignum_st *m_bn;
 	};
 
+	/// Precomputed table for modular exponentiations with a fixed base and modulus, like g^b mod N in srp6.
+	/// The table holds base^(j * 16^i) in montgomery form, so an exponentiation only needs a single modular
+	/// multiplication per 4 exponent bits and no squarings at all. The table is immutable after construction
+	/// and thus can be used by multiple threads at the same time.
+	class FixedBaseModExp final : public NonCopyable
+	{
+	public:
+		/// Builds the table.
+		/// @param base The fixed base.
+		/// @param modulus The fixed modulus, has to be odd.
+		/// @param maxExponentBits Maximum number of exponent bits covered by the table. Larger exponents
+		///	       fall back to a regular modular exponentiation.
+		explicit FixedBaseModExp(const BigNumber &base, const BigNumber &modulus, uint32 maxExponentBits);
+		~FixedBaseModExp() override;
+
+	public:
+		/// Calculates base^exponent mod modulus.
+		BigNumber modExp(const BigNumber &exponent) const;
+
+		/// Gets the maximum number of exponent bits covered by the table.
+		uint32 getMaxExponentBits() const { return m_maxExponentBits; }
+
+	private:
+		static constexpr uint32 WindowBits = 4;
+		static constexpr uint32 WindowSize = 1 << WindowBits;
+
+		BigNumber m_base;
+		BigNumber m_modulus;
+		uint32 m_maxExponentBits;
+		bn_mont_ctx_st *m_mont;
+		BigNumber m_one;
+		std::vector<BigNumber> m_table;
+	};
+
 	/// Helper method to build a sha1 hash out of a list of BigNumber objects.
 	SHA1Hash Sha1_BigNumbers(std::initializer_list<BigNumber> args);
 
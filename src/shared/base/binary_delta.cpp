@@ -0,0 +1,293 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "binary_delta.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace mmo
+{
+	namespace
+	{
+		/// 'BDLT', spelled out so that the value doesn't depend on the compiler.
+		constexpr uint32 DeltaSignature = 0x42444C54;
+		constexpr uint32 DeltaVersion = 1;
+
+		enum class DeltaOp : uint8
+		{
+			/// Copies a range of the source.
+			Copy,
+			/// Inserts bytes stored in the delta itself.
+			Insert
+		};
+
+		/// Weak rolling checksum as used by rsync. Can be moved along a buffer one byte at a time.
+		class RollingChecksum final
+		{
+		public:
+			void Reset(const uint8* data, const size_t length) noexcept
+			{
+				m_a = 0;
+				m_b = 0;
+				for (size_t i = 0; i < length; ++i)
+				{
+					m_a += data[i];
+					m_b += static_cast<uint32>(length - i) * data[i];
+				}
+			}
+
+			void Roll(const uint8 removed, const uint8 added, const size_t length) noexcept
+			{
+				m_a = m_a - removed + added;
+				m_b = m_b - static_cast<uint32>(length) * removed + m_a;
+			}
+
+			[[nodiscard]] uint32 GetValue() const noexcept { return (m_a & 0xffff) | (m_b << 16); }
+
+		private:
+			uint32 m_a = 0;
+			uint32 m_b = 0;
+		};
+
+		template<class T>
+		void WriteValue(std::ostream& stream, const T& value)
+		{
+			stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template<class T>
+		bool ReadValue(std::istream& stream, T& out_value)
+		{
+			return static_cast<bool>(stream.read(reinterpret_cast<char*>(&out_value), sizeof(T)));
+		}
+
+		/// Copies a number of bytes from one stream to another.
+		bool CopyBytes(std::istream& source, std::ostream& target, uint64 length)
+		{
+			char buffer[1024 * 16];
+			while (length > 0)
+			{
+				const auto chunk = static_cast<std::streamsize>(std::min<uint64>(length, sizeof(buffer)));
+				if (!source.read(buffer, chunk))
+				{
+					return false;
+				}
+
+				target.write(buffer, chunk);
+				length -= static_cast<uint64>(chunk);
+			}
+
+			return static_cast<bool>(target);
+		}
+
+		/// Writes delta operations and merges copies of adjacent source ranges.
+		class DeltaWriter final
+		{
+		public:
+			DeltaWriter(std::ostream& stream, const char* target)
+				: m_stream(stream)
+				, m_target(target)
+			{
+			}
+
+			void Copy(const uint64 offset, const uint64 length)
+			{
+				if (m_copyLength > 0 && m_copyOffset + m_copyLength == offset)
+				{
+					m_copyLength += length;
+					return;
+				}
+
+				FlushCopy();
+				m_copyOffset = offset;
+				m_copyLength = length;
+			}
+
+			void Insert(const size_t targetOffset, const size_t length)
+			{
+				if (length == 0)
+				{
+					return;
+				}
+
+				FlushCopy();
+				WriteValue(m_stream, DeltaOp::Insert);
+				WriteValue(m_stream, static_cast<uint64>(length));
+				m_stream.write(m_target + targetOffset, static_cast<std::streamsize>(length));
+			}
+
+			void FlushCopy()
+			{
+				if (m_copyLength == 0)
+				{
+					return;
+				}
+
+				WriteValue(m_stream, DeltaOp::Copy);
+				WriteValue(m_stream, m_copyOffset);
+				WriteValue(m_stream, m_copyLength);
+				m_copyLength = 0;
+			}
+
+		private:
+			std::ostream& m_stream;
+			const char* m_target;
+			uint64 m_copyOffset = 0;
+			uint64 m_copyLength = 0;
+		};
+	}
+
+	void CreateBinaryDelta(const char* source, const size_t sourceSize, const char* target, const size_t targetSize, std::ostream& out_delta, size_t blockSize)
+	{
+		blockSize = std::max<size_t>(blockSize, 16);
+
+		WriteValue(out_delta, DeltaSignature);
+		WriteValue(out_delta, DeltaVersion);
+		WriteValue(out_delta, static_cast<uint64>(sourceSize));
+		WriteValue(out_delta, static_cast<uint64>(targetSize));
+
+		const auto* sourceBytes = reinterpret_cast<const uint8*>(source);
+		const auto* targetBytes = reinterpret_cast<const uint8*>(target);
+
+		// Index all full blocks of the source by their weak checksum. If multiple blocks share a checksum, the first
+		// one wins, which only costs a possible match.
+		std::unordered_map<uint32, size_t> blocks;
+		blocks.reserve(sourceSize / blockSize);
+
+		RollingChecksum checksum;
+		for (size_t offset = 0; offset + blockSize <= sourceSize; offset += blockSize)
+		{
+			checksum.Reset(sourceBytes + offset, blockSize);
+			blocks.emplace(checksum.GetValue(), offset);
+		}
+
+		DeltaWriter writer(out_delta, target);
+
+		size_t literalStart = 0;
+		size_t position = 0;
+		if (!blocks.empty() && targetSize >= blockSize)
+		{
+			checksum.Reset(targetBytes, blockSize);
+		}
+
+		while (!blocks.empty() && position + blockSize <= targetSize)
+		{
+			const auto it = blocks.find(checksum.GetValue());
+			if (it != blocks.end() && std::memcmp(source + it->second, target + position, blockSize) == 0)
+			{
+				// Extend the match as far as source and target are equal
+				size_t length = blockSize;
+				while (it->second + length < sourceSize && position + length < targetSize && source[it->second + length] == target[position + length])
+				{
+					++length;
+				}
+
+				writer.Insert(literalStart, position - literalStart);
+				writer.Copy(it->second, length);
+
+				position += length;
+				literalStart = position;
+
+				if (position + blockSize <= targetSize)
+				{
+					checksum.Reset(targetBytes + position, blockSize);
+				}
+
+				continue;
+			}
+
+			if (position + blockSize >= targetSize)
+			{
+				break;
+			}
+
+			checksum.Roll(targetBytes[position], targetBytes[position + blockSize], blockSize);
+			++position;
+		}
+
+		writer.Insert(literalStart, targetSize - literalStart);
+		writer.FlushCopy();
+	}
+
+	bool ApplyBinaryDelta(std::istream& source, std::istream& delta, std::ostream& out_target)
+	{
+		uint32 signature = 0, version = 0;
+		uint64 sourceSize = 0, targetSize = 0;
+		if (!ReadValue(delta, signature) || !ReadValue(delta, version) || !ReadValue(delta, sourceSize) || !ReadValue(delta, targetSize))
+		{
+			return false;
+		}
+
+		if (signature != DeltaSignature || version != DeltaVersion)
+		{
+			return false;
+		}
+
+		source.seekg(0, std::ios::end);
+		if (static_cast<uint64>(source.tellg()) != sourceSize)
+		{
+			return false;
+		}
+
+		uint64 written = 0;
+		while (written < targetSize)
+		{
+			DeltaOp op;
+			if (!ReadValue(delta, op))
+			{
+				return false;
+			}
+
+			switch (op)
+			{
+			case DeltaOp::Copy:
+				{
+					uint64 offset = 0, length = 0;
+					if (!ReadValue(delta, offset) || !ReadValue(delta, length))
+					{
+						return false;
+					}
+
+					if (offset > sourceSize || length > sourceSize - offset || length > targetSize - written)
+					{
+						return false;
+					}
+
+					source.clear();
+					source.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+					if (!CopyBytes(source, out_target, length))
+					{
+						return false;
+					}
+
+					written += length;
+				}
+				break;
+
+			case DeltaOp::Insert:
+				{
+					uint64 length = 0;
+					if (!ReadValue(delta, length) || length > targetSize - written)
+					{
+						return false;
+					}
+
+					if (!CopyBytes(delta, out_target, length))
+					{
+						return false;
+					}
+
+					written += length;
+				}
+				break;
+
+			default:
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,32 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "typedefs.h"
+
+#include <istream>
+#include <ostream>
+
+namespace mmo
+{
+	/// Default block size used to find matching content in the source of a binary delta.
+	static constexpr size_t BinaryDeltaBlockSize = 2048;
+
+	/// Creates a binary delta which turns the source buffer into the target buffer. Blocks of the source are located
+	/// anywhere in the target using a rolling checksum (like rsync does), so content which only moved around is not
+	/// included in the delta. Matches are extended byte by byte past block boundaries.
+	/// @param source The previous version of the content.
+	/// @param sourceSize Number of bytes in source.
+	/// @param target The new version of the content.
+	/// @param targetSize Number of bytes in target.
+	/// @param out_delta The stream the delta is written to.
+	/// @param blockSize Size of the blocks the source is split into. Smaller blocks find more matches but use more memory.
+	void CreateBinaryDelta(const char* source, size_t sourceSize, const char* target, size_t targetSize, std::ostream& out_delta, size_t blockSize = BinaryDeltaBlockSize);
+
+	/// Applies a binary delta created by CreateBinaryDelta.
+	/// @param source The content the delta has been created from. Has to be seekable.
+	/// @param delta The delta.
+	/// @param out_target The stream the new content is written to.
+	/// @returns false if the delta is malformed or does not belong to the source.
+	bool ApplyBinaryDelta(std::istream& source, std::istream& delta, std::ostream& out_target);
+}
@@ -0,0 +1,82 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "crypto_worker_pool.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	CryptoWorkerPool::CryptoWorkerPool(const size_t workerCount, const size_t maxPendingJobs, Dispatcher dispatcher)
+		: m_maxPendingJobs(maxPendingJobs)
+		, m_dispatcher(std::move(dispatcher))
+	{
+		const size_t threadCount = std::max<size_t>(workerCount, 1);
+		m_workers.reserve(threadCount);
+
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			m_workers.emplace_back(&CryptoWorkerPool::WorkerThread, this);
+		}
+	}
+
+	CryptoWorkerPool::~CryptoWorkerPool()
+	{
+		{
+			std::scoped_lock lock{ m_mutex };
+			m_stopping = true;
+			m_jobs.clear();
+		}
+
+		m_jobAvailable.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	size_t CryptoWorkerPool::GetPendingJobCount() const
+	{
+		std::scoped_lock lock{ m_mutex };
+		return m_jobs.size();
+	}
+
+	bool CryptoWorkerPool::Enqueue(std::function<void()> job)
+	{
+		{
+			std::scoped_lock lock{ m_mutex };
+			if (m_stopping || m_jobs.size() >= m_maxPendingJobs)
+			{
+				return false;
+			}
+
+			m_jobs.push_back(std::move(job));
+		}
+
+		m_jobAvailable.notify_one();
+		return true;
+	}
+
+	void CryptoWorkerPool::WorkerThread()
+	{
+		for (;;)
+		{
+			std::function<void()> job;
+
+			{
+				std::unique_lock lock{ m_mutex };
+				m_jobAvailable.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+
+				if (m_stopping)
+				{
+					return;
+				}
+
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+
+			job();
+		}
+	}
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "typedefs.h"
+#include "non_copyable.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mmo
+{
+	/// A small, bounded pool of worker threads which executes cpu heavy work like srp6 big number math
+	/// away from the network threads. Results are handed back through a dispatcher function, which
+	/// usually posts the result handler to the io service of the calling connection.
+	class CryptoWorkerPool final : public NonCopyable
+	{
+	public:
+		/// Posts a function for execution on the thread which is supposed to handle results.
+		typedef std::function<void(std::function<void()>)> Dispatcher;
+
+	public:
+		/// Creates the worker threads.
+		/// @param workerCount Number of worker threads. At least one thread is created.
+		/// @param maxPendingJobs Maximum number of jobs that may wait for execution. Additional jobs
+		///        are rejected so that a login storm can't queue up an unlimited amount of work.
+		/// @param dispatcher Used to execute result handlers.
+		explicit CryptoWorkerPool(size_t workerCount, size_t maxPendingJobs, Dispatcher dispatcher);
+		~CryptoWorkerPool() override;
+
+	public:
+		/// Queues work for execution on a worker thread. The handler is invoked with the result of the
+		/// work through the dispatcher.
+		/// @returns false if the queue is full or the pool is shutting down. In this case, neither the
+		///          work nor the handler will be executed.
+		template<class Work, class Handler>
+		bool Post(Work&& work, Handler&& handler)
+		{
+			return Enqueue([work = std::forward<Work>(work), handler = std::forward<Handler>(handler), this]() mutable
+			{
+				using Result = std::invoke_result_t<Work&>;
+				if constexpr (std::is_void_v<Result>)
+				{
+					work();
+					m_dispatcher(std::move(handler));
+				}
+				else
+				{
+					auto result = std::make_shared<Result>(work());
+					m_dispatcher([handler = std::move(handler), result]() mutable
+					{
+						handler(std::move(*result));
+					});
+				}
+			});
+		}
+
+		/// Gets the number of jobs which are waiting for execution.
+		[[nodiscard]] size_t GetPendingJobCount() const;
+
+		/// Gets the maximum number of jobs which may wait for execution.
+		[[nodiscard]] size_t GetMaxPendingJobs() const { return m_maxPendingJobs; }
+
+		/// Gets the number of worker threads.
+		[[nodiscard]] size_t GetWorkerCount() const { return m_workers.size(); }
+
+	private:
+		bool Enqueue(std::function<void()> job);
+
+		void WorkerThread();
+
+	private:
+		size_t m_maxPendingJobs;
+		Dispatcher m_dispatcher;
+		mutable std::mutex m_mutex;
+		std::condition_variable m_jobAvailable;
+		std::deque<std::function<void()>> m_jobs;
+		std::vector<std::thread> m_workers;
+		bool m_stopping = false;
+	};
+}
@@ -0,0 +1,29 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "database_metrics.h"
+#include "metrics.h"
+
+#include <chrono>
+
+namespace mmo
+{
+	DatabaseActionDispatcher MeasureDatabaseRequests(DatabaseActionDispatcher asyncWorker)
+	{
+		static MetricGauge& s_queueDepth = MetricsRegistry::Get().AddGauge("mmo_db_queue_depth", "Number of database requests waiting for or being executed by the database thread.");
+		static MetricHistogram& s_latency = MetricsRegistry::Get().AddHistogram("mmo_db_request_duration_seconds", "Time from queueing a database request until it has been executed.");
+
+		return [asyncWorker = std::move(asyncWorker)](const std::function<void()>& action)
+		{
+			s_queueDepth.Add();
+
+			const auto queuedAt = std::chrono::steady_clock::now();
+			asyncWorker([action, queuedAt]()
+			{
+				action();
+
+				s_latency.ObserveDuration(std::chrono::steady_clock::now() - queuedAt);
+				s_queueDepth.Sub();
+			});
+		};
+	}
+}
@@ -0,0 +1,15 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include <functional>
+
+namespace mmo
+{
+	/// Executes an action on another thread, like the async worker of a server's AsyncDatabase.
+	typedef std::function<void(const std::function<void()>&)> DatabaseActionDispatcher;
+
+	/// Wraps the async worker of a database so that the number of pending requests and the time from queueing a
+	/// request until it has been executed on the database thread are exported as metrics.
+	DatabaseActionDispatcher MeasureDatabaseRequests(DatabaseActionDispatcher asyncWorker);
+}
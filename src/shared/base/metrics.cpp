@@ -0,0 +1,299 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "metrics.h"
+
+#include "macros.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace mmo
+{
+	namespace
+	{
+		void WriteSample(std::ostream& stream, const String& name, const String& labels, const String& extraLabel)
+		{
+			stream << name;
+
+			if (!labels.empty() || !extraLabel.empty())
+			{
+				stream << '{' << labels;
+				if (!labels.empty() && !extraLabel.empty())
+				{
+					stream << ',';
+				}
+				stream << extraLabel << '}';
+			}
+
+			stream << ' ';
+		}
+
+		String FormatBound(const double bound)
+		{
+			std::ostringstream strm;
+			strm << "le=\"" << bound << "\"";
+			return strm.str();
+		}
+	}
+
+	size_t GetMetricShard() noexcept
+	{
+		static std::atomic<size_t> s_nextShard { 0 };
+		thread_local const size_t s_shard = s_nextShard.fetch_add(1, std::memory_order_relaxed) % MetricShardCount;
+		return s_shard;
+	}
+
+	uint64 MetricCounter::GetValue() const noexcept
+	{
+		uint64 value = 0;
+		for (const auto& shard : m_shards)
+		{
+			value += shard.value.load(std::memory_order_relaxed);
+		}
+
+		return value;
+	}
+
+	const std::vector<double> MetricHistogram::DefaultDurationBuckets = { 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0 };
+
+	MetricHistogram::MetricHistogram(std::vector<double> upperBounds)
+		: m_upperBounds(std::move(upperBounds))
+	{
+		ASSERT(std::is_sorted(m_upperBounds.begin(), m_upperBounds.end()));
+
+		for (auto& shard : m_shards)
+		{
+			shard.buckets = std::make_unique<std::atomic<uint64>[]>(m_upperBounds.size() + 1);
+			for (size_t i = 0; i <= m_upperBounds.size(); ++i)
+			{
+				shard.buckets[i].store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void MetricHistogram::Observe(const double value) noexcept
+	{
+		// Bounds are inclusive, so the first bound which is not less than the value is the right bucket
+		const size_t bucket = std::lower_bound(m_upperBounds.begin(), m_upperBounds.end(), value) - m_upperBounds.begin();
+
+		Shard& shard = m_shards[GetMetricShard()];
+		shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		shard.sum.fetch_add(value, std::memory_order_relaxed);
+	}
+
+	std::vector<uint64> MetricHistogram::GetBucketCounts() const
+	{
+		std::vector<uint64> counts(m_upperBounds.size() + 1, 0);
+		for (const auto& shard : m_shards)
+		{
+			for (size_t i = 0; i < counts.size(); ++i)
+			{
+				counts[i] += shard.buckets[i].load(std::memory_order_relaxed);
+			}
+		}
+
+		return counts;
+	}
+
+	double MetricHistogram::GetSum() const noexcept
+	{
+		double sum = 0.0;
+		for (const auto& shard : m_shards)
+		{
+			sum += shard.sum.load(std::memory_order_relaxed);
+		}
+
+		return sum;
+	}
+
+	MetricCounterArray::MetricCounterArray(const size_t size)
+		: m_size(size)
+		, m_values(std::make_unique<std::atomic<uint64>[]>(m_size + 1))
+	{
+		for (size_t i = 0; i <= m_size; ++i)
+		{
+			m_values[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	MetricsRegistry& MetricsRegistry::Get()
+	{
+		static MetricsRegistry s_registry;
+		return s_registry;
+	}
+
+	MetricCounter& MetricsRegistry::AddCounter(const String& name, const String& help, const String& labels)
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		if (Entry* entry = FindEntry(name, labels, MetricType::Counter))
+		{
+			return *entry->counter;
+		}
+
+		Entry& entry = AddEntry(name, help, labels, MetricType::Counter);
+		entry.counter = std::make_unique<MetricCounter>();
+		return *entry.counter;
+	}
+
+	MetricGauge& MetricsRegistry::AddGauge(const String& name, const String& help, const String& labels)
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		if (Entry* entry = FindEntry(name, labels, MetricType::Gauge))
+		{
+			return *entry->gauge;
+		}
+
+		Entry& entry = AddEntry(name, help, labels, MetricType::Gauge);
+		entry.gauge = std::make_unique<MetricGauge>();
+		return *entry.gauge;
+	}
+
+	MetricHistogram& MetricsRegistry::AddHistogram(const String& name, const String& help, const std::vector<double>& upperBounds, const String& labels)
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		if (Entry* entry = FindEntry(name, labels, MetricType::Histogram))
+		{
+			return *entry->histogram;
+		}
+
+		Entry& entry = AddEntry(name, help, labels, MetricType::Histogram);
+		entry.histogram = std::make_unique<MetricHistogram>(upperBounds);
+		return *entry.histogram;
+	}
+
+	MetricCounterArray& MetricsRegistry::AddCounterArray(const String& name, const String& help, const String& indexLabel, const size_t size, const String& labels)
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		if (Entry* entry = FindEntry(name, labels, MetricType::CounterArray))
+		{
+			return *entry->counterArray;
+		}
+
+		Entry& entry = AddEntry(name, help, labels, MetricType::CounterArray);
+		entry.indexLabel = indexLabel;
+		entry.counterArray = std::make_unique<MetricCounterArray>(size);
+		return *entry.counterArray;
+	}
+
+	void MetricsRegistry::WriteText(std::ostream& stream) const
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		// Samples of the same metric have to be written as one group below a single HELP and TYPE line
+		std::vector<const Entry*> entries;
+		entries.reserve(m_entries.size());
+		for (const auto& entry : m_entries)
+		{
+			entries.push_back(&entry);
+		}
+
+		std::stable_sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b) { return a->name < b->name; });
+
+		const auto previousPrecision = stream.precision(12);
+
+		const String* previousName = nullptr;
+		for (const Entry* entry : entries)
+		{
+			if (!previousName || *previousName != entry->name)
+			{
+				const char* typeName = "counter";
+				if (entry->type == MetricType::Gauge)
+				{
+					typeName = "gauge";
+				}
+				else if (entry->type == MetricType::Histogram)
+				{
+					typeName = "histogram";
+				}
+
+				stream << "# HELP " << entry->name << ' ' << entry->help << '\n';
+				stream << "# TYPE " << entry->name << ' ' << typeName << '\n';
+				previousName = &entry->name;
+			}
+
+			switch (entry->type)
+			{
+			case MetricType::Counter:
+				WriteSample(stream, entry->name, entry->labels, String());
+				stream << entry->counter->GetValue() << '\n';
+				break;
+
+			case MetricType::Gauge:
+				WriteSample(stream, entry->name, entry->labels, String());
+				stream << entry->gauge->GetValue() << '\n';
+				break;
+
+			case MetricType::CounterArray:
+				for (size_t i = 0; i < entry->counterArray->GetSize(); ++i)
+				{
+					const uint64 value = entry->counterArray->GetValue(i);
+					if (value == 0)
+					{
+						continue;
+					}
+
+					WriteSample(stream, entry->name, entry->labels, entry->indexLabel + "=\"" + std::to_string(i) + "\"");
+					stream << value << '\n';
+				}
+
+				if (const uint64 other = entry->counterArray->GetOtherValue(); other != 0)
+				{
+					WriteSample(stream, entry->name, entry->labels, entry->indexLabel + "=\"other\"");
+					stream << other << '\n';
+				}
+				break;
+
+			case MetricType::Histogram:
+				{
+					const auto& bounds = entry->histogram->GetUpperBounds();
+					const auto counts = entry->histogram->GetBucketCounts();
+
+					uint64 cumulative = 0;
+					for (size_t i = 0; i < counts.size(); ++i)
+					{
+						cumulative += counts[i];
+						WriteSample(stream, entry->name + "_bucket", entry->labels, i < bounds.size() ? FormatBound(bounds[i]) : String("le=\"+Inf\""));
+						stream << cumulative << '\n';
+					}
+
+					WriteSample(stream, entry->name + "_sum", entry->labels, String());
+					stream << entry->histogram->GetSum() << '\n';
+					WriteSample(stream, entry->name + "_count", entry->labels, String());
+					stream << cumulative << '\n';
+				}
+				break;
+			}
+		}
+
+		stream.precision(previousPrecision);
+	}
+
+	MetricsRegistry::Entry* MetricsRegistry::FindEntry(const String& name, const String& labels, const MetricType type)
+	{
+		for (auto& entry : m_entries)
+		{
+			if (entry.name == name && entry.labels == labels)
+			{
+				// Reusing a name for a different kind of metric is a programming error
+				ASSERT(entry.type == type);
+				return &entry;
+			}
+		}
+
+		return nullptr;
+	}
+
+	MetricsRegistry::Entry& MetricsRegistry::AddEntry(const String& name, const String& help, const String& labels, const MetricType type)
+	{
+		Entry& entry = m_entries.emplace_back();
+		entry.name = name;
+		entry.help = help;
+		entry.labels = labels;
+		entry.type = type;
+		return entry;
+	}
+}
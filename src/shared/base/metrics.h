@@ -0,0 +1,182 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "typedefs.h"
+#include "non_copyable.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace mmo
+{
+	/// Number of shards counters and histograms are split into. Each thread is assigned a shard on first use, so
+	/// threads updating the same metric concurrently rarely write to the same cache line.
+	static constexpr size_t MetricShardCount = 16;
+
+	/// Gets the metric shard index of the calling thread.
+	size_t GetMetricShard() noexcept;
+
+	/// A monotonically increasing value, like the number of bytes sent. Updates are lock-free.
+	class MetricCounter final : public NonCopyable
+	{
+	public:
+		void Increment(const uint64 value = 1) noexcept
+		{
+			m_shards[GetMetricShard()].value.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		/// Gets the sum of all shards.
+		[[nodiscard]] uint64 GetValue() const noexcept;
+
+	private:
+		struct alignas(64) Shard
+		{
+			std::atomic<uint64> value { 0 };
+		};
+
+		std::array<Shard, MetricShardCount> m_shards;
+	};
+
+	/// A value which can go up and down, like a queue size. Updates are lock-free.
+	class MetricGauge final : public NonCopyable
+	{
+	public:
+		void Set(const int64 value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+
+		void Add(const int64 value = 1) noexcept { m_value.fetch_add(value, std::memory_order_relaxed); }
+
+		void Sub(const int64 value = 1) noexcept { m_value.fetch_sub(value, std::memory_order_relaxed); }
+
+		[[nodiscard]] int64 GetValue() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<int64> m_value { 0 };
+	};
+
+	/// Counts observed values in buckets with fixed upper bounds, like request durations. Updates are lock-free.
+	class MetricHistogram final : public NonCopyable
+	{
+	public:
+		/// Upper bounds in seconds used for durations unless specified otherwise.
+		static const std::vector<double> DefaultDurationBuckets;
+
+	public:
+		/// @param upperBounds Sorted upper bounds of the buckets. An implicit +Inf bucket is always added.
+		explicit MetricHistogram(std::vector<double> upperBounds);
+
+	public:
+		void Observe(double value) noexcept;
+
+		/// Observes a duration in seconds.
+		template<class Rep, class Period>
+		void ObserveDuration(const std::chrono::duration<Rep, Period> duration) noexcept
+		{
+			Observe(std::chrono::duration<double>(duration).count());
+		}
+
+		[[nodiscard]] const std::vector<double>& GetUpperBounds() const noexcept { return m_upperBounds; }
+
+		/// Gets the non-cumulative number of observations per bucket, including the +Inf bucket as last element.
+		[[nodiscard]] std::vector<uint64> GetBucketCounts() const;
+
+		[[nodiscard]] double GetSum() const noexcept;
+
+	private:
+		struct alignas(64) Shard
+		{
+			std::unique_ptr<std::atomic<uint64>[]> buckets;
+			std::atomic<double> sum { 0.0 };
+		};
+
+		const std::vector<double> m_upperBounds;
+		std::array<Shard, MetricShardCount> m_shards;
+	};
+
+	/// A fixed number of counters addressed by index, like packets received per op code. The index is exported as a
+	/// label and counters which never have been incremented are omitted. Indices past the end are counted in an
+	/// extra counter which is exported with the index label "other". Updates are lock-free.
+	class MetricCounterArray final : public NonCopyable
+	{
+	public:
+		explicit MetricCounterArray(size_t size);
+
+	public:
+		void Increment(const size_t index, const uint64 value = 1) noexcept
+		{
+			m_values[index < m_size ? index : m_size].fetch_add(value, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] size_t GetSize() const noexcept { return m_size; }
+
+		[[nodiscard]] uint64 GetValue(const size_t index) const noexcept { return m_values[index].load(std::memory_order_relaxed); }
+
+		/// Gets the counter of all indices past the end.
+		[[nodiscard]] uint64 GetOtherValue() const noexcept { return m_values[m_size].load(std::memory_order_relaxed); }
+
+	private:
+		const size_t m_size;
+		std::unique_ptr<std::atomic<uint64>[]> m_values;
+	};
+
+	/// Process-wide registry of metrics which can be written in the Prometheus text exposition format. Registering
+	/// a metric takes a lock and is meant to happen once (for example in a function local static), while updating
+	/// registered metrics never locks. Registering a name and label combination again returns the existing metric.
+	class MetricsRegistry final : public NonCopyable
+	{
+	public:
+		static MetricsRegistry& Get();
+
+	public:
+		/// @param name Metric name, like "mmo_network_bytes_sent_total".
+		/// @param help Description written along with the metric.
+		/// @param labels Optional label set without braces, like "protocol=\"game\"".
+		MetricCounter& AddCounter(const String& name, const String& help, const String& labels = String());
+
+		MetricGauge& AddGauge(const String& name, const String& help, const String& labels = String());
+
+		MetricHistogram& AddHistogram(const String& name, const String& help, const std::vector<double>& upperBounds = MetricHistogram::DefaultDurationBuckets, const String& labels = String());
+
+		/// @param indexLabel Name of the label which receives the counter index, like "opcode".
+		MetricCounterArray& AddCounterArray(const String& name, const String& help, const String& indexLabel, size_t size, const String& labels = String());
+
+		/// Writes all metrics in the Prometheus text exposition format (version 0.0.4).
+		void WriteText(std::ostream& stream) const;
+
+	private:
+		enum class MetricType : uint8
+		{
+			Counter,
+			Gauge,
+			Histogram,
+			CounterArray
+		};
+
+		struct Entry
+		{
+			String name;
+			String help;
+			String labels;
+			String indexLabel;
+			MetricType type;
+			std::unique_ptr<MetricCounter> counter;
+			std::unique_ptr<MetricGauge> gauge;
+			std::unique_ptr<MetricHistogram> histogram;
+			std::unique_ptr<MetricCounterArray> counterArray;
+		};
+
+		Entry* FindEntry(const String& name, const String& labels, MetricType type);
+
+		Entry& AddEntry(const String& name, const String& help, const String& labels, MetricType type);
+
+	private:
+		mutable std::mutex m_mutex;
+		std::deque<Entry> m_entries;
+	};
+}
@@ -0,0 +1,140 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "srp6.h"
+#include "constants.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace mmo
+{
+	namespace srp6
+	{
+		namespace
+		{
+			const FixedBaseModExp& GetGeneratorTable()
+			{
+				// Covers the exponent size of b, larger exponents fall back to a regular modExp
+				static const FixedBaseModExp s_table(constants::srp::g, constants::srp::N, ServerPrivateKeyBits);
+				return s_table;
+			}
+		}
+
+		BigNumber CalculateGeneratorPower(const BigNumber& exponent)
+		{
+			return GetGeneratorTable().modExp(exponent);
+		}
+
+		BigNumber CalculateServerPublicKey(const BigNumber& v, const BigNumber& b)
+		{
+			const BigNumber gmod = CalculateGeneratorPower(b);
+			BigNumber verifier = v;
+			return ((verifier * 3) + gmod) % constants::srp::N;
+		}
+
+		ServerProof VerifyClientProof(const String& identity, const BigNumber& s, const BigNumber& v, const BigNumber& b, const BigNumber& B, const BigNumber& A, const std::array<uint8, 20>& m1)
+		{
+			ServerProof result;
+
+			// Build hash
+			SHA1Hash hash = Sha1_BigNumbers({ A, B });
+
+			// Calculate u and S
+			const BigNumber u{ hash.data(), hash.size() };
+			BigNumber clientPublicKey = A;
+			const BigNumber S = (clientPublicKey * (v.modExp(u, constants::srp::N))).modExp(b, constants::srp::N);
+
+			// Build t
+			const std::vector<uint8> t = S.asByteArray(32);
+			std::array<uint8, 16> t1{};
+			for (size_t i = 0; i < t1.size(); ++i)
+			{
+				t1[i] = t[i * 2];
+			}
+			hash = sha1(reinterpret_cast<const char*>(t1.data()), t1.size());
+
+			std::array<uint8, 40> vK{};
+			for (size_t i = 0; i < 20; ++i)
+			{
+				vK[i * 2] = hash[i];
+			}
+			for (size_t i = 0; i < 16; ++i)
+			{
+				t1[i] = t[i * 2 + 1];
+			}
+
+			hash = sha1(reinterpret_cast<const char*>(t1.data()), t1.size());
+			for (size_t i = 0; i < 20; ++i)
+			{
+				vK[i * 2 + 1] = hash[i];
+			}
+
+			const BigNumber K{ vK.data(), vK.size() };
+
+			// H(N) xor H(g) only depends on constants
+			static const BigNumber t3 = []()
+			{
+				SHA1Hash h = Sha1_BigNumbers({ constants::srp::N });
+				const SHA1Hash gHash = Sha1_BigNumbers({ constants::srp::g });
+				for (size_t i = 0; i < h.size(); ++i)
+				{
+					h[i] ^= gHash[i];
+				}
+
+				return BigNumber{ h.data(), h.size() };
+			}();
+
+			HashGeneratorSha1 sha;
+			Sha1_Add_BigNumbers(sha, { t3 });
+			const auto t4 = sha1(identity.data(), identity.size());
+			sha.update(reinterpret_cast<const char*>(t4.data()), t4.size());
+			Sha1_Add_BigNumbers(sha, { s, A, B });
+
+			// Hash the raw session key bytes like the client does, as K's byte array would lack a trailing zero byte
+			sha.update(reinterpret_cast<const char*>(vK.data()), vK.size());
+			hash = sha.finalize();
+
+			// Compare the M1 hash calculated on the server using values sent by the client against the
+			// M1 hash sent by the client to see if the passwords do match.
+			if (!std::equal(hash.begin(), hash.end(), m1.begin()))
+			{
+				return result;
+			}
+
+			// Finish SRP6 by calculating the M2 hash value that is sent back to the client for
+			// verification as well.
+			HashGeneratorSha1 m2;
+			Sha1_Add_BigNumbers(m2, { A });
+			m2.update(reinterpret_cast<const char*>(hash.data()), hash.size());
+			m2.update(reinterpret_cast<const char*>(vK.data()), vK.size());
+
+			result.verified = true;
+			result.m2 = m2.finalize();
+			result.sessionKey = K;
+			return result;
+		}
+
+		std::pair<BigNumber, BigNumber> CalculateSaltAndVerifier(String identity, String password)
+		{
+			std::transform(identity.begin(), identity.end(), identity.begin(), ::toupper);
+			std::transform(password.begin(), password.end(), password.begin(), ::toupper);
+
+			const String authString = identity + ":" + password;
+			const SHA1Hash authHash = sha1(authString.c_str(), authString.size());
+
+			BigNumber s;
+			s.setRand(32 * 8);
+
+			// x = H(s | H(I:P))
+			HashGeneratorSha1 gen;
+			gen.update(reinterpret_cast<const char*>(s.asByteArray().data()), s.getNumBytes());
+			gen.update(reinterpret_cast<const char*>(authHash.data()), authHash.size());
+			const SHA1Hash xHash = gen.finalize();
+
+			BigNumber x;
+			x.setBinary(xHash.data(), xHash.size());
+
+			return std::make_pair(s, constants::srp::g.modExp(x, constants::srp::N));
+		}
+	}
+}
@@ -0,0 +1,58 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "typedefs.h"
+#include "big_number.h"
+#include "sha1.h"
+
+#include <array>
+#include <utility>
+
+namespace mmo
+{
+	/// Contains the server side calculations of the srp-6 handshake which is used by the login server
+	/// to authenticate players and realms and by the realm server to authenticate world nodes.
+	namespace srp6
+	{
+		/// Number of random bits used for the server's private ephemeral value b.
+		static constexpr uint32 ServerPrivateKeyBits = 19 * 8;
+
+		/// Result of a client proof verification.
+		struct ServerProof final
+		{
+			/// Whether the M1 hash sent by the client matched, i.e. the password was correct.
+			bool verified = false;
+			/// The session key K. Only valid if verified is true.
+			BigNumber sessionKey;
+			/// The M2 hash which is sent back to the client. Only valid if verified is true.
+			SHA1Hash m2{};
+		};
+
+		/// Calculates g^exponent mod N using a precomputed table, which is a lot faster than a regular
+		/// modular exponentiation. Safe to call from multiple threads.
+		BigNumber CalculateGeneratorPower(const BigNumber& exponent);
+
+		/// Calculates the server's public ephemeral value B = (3v + g^b) mod N.
+		/// @param v The password verifier of the account.
+		/// @param b The server's private ephemeral value.
+		BigNumber CalculateServerPublicKey(const BigNumber& v, const BigNumber& b);
+
+		/// Calculates the session key and verifies the M1 hash sent by the client. This is the expensive
+		/// part of the handshake and safe to call from any thread.
+		/// @param identity The name the client authenticates with (account, realm or world name).
+		/// @param s The salt.
+		/// @param v The password verifier.
+		/// @param b The server's private ephemeral value.
+		/// @param B The server's public ephemeral value.
+		/// @param A The client's public ephemeral value. Has to pass the A % N != 0 safeguard.
+		/// @param m1 The M1 hash sent by the client.
+		ServerProof VerifyClientProof(const String& identity, const BigNumber& s, const BigNumber& v, const BigNumber& b, const BigNumber& B, const BigNumber& A, const std::array<uint8, 20>& m1);
+
+		/// Generates a random salt and calculates the matching password verifier which are stored in the database.
+		/// @param identity The name the client authenticates with. Converted to upper case like the client does.
+		/// @param password The password. Converted to upper case like the client does.
+		/// @returns The salt s and the verifier v.
+		std::pair<BigNumber, BigNumber> CalculateSaltAndVerifier(String identity, String password);
+	}
+}
@@ -3,15 +3,31 @@
 #include "timer_queue.h"
 #include "macros.h"
 #include "clock.h"
+#include "metrics.h"
+#include "trace_profiler.h"
 
 
 namespace mmo
 {
+	namespace
+	{
+		MetricGauge& GetQueuedEvents()
+		{
+			static MetricGauge& s_queuedEvents = MetricsRegistry::Get().AddGauge("mmo_timer_queue_size", "Number of events waiting in timer queues.");
+			return s_queuedEvents;
+		}
+	}
+
 	TimerQueue::TimerQueue(asio::io_service &service)
 		: m_timer(service)
 	{
 	}
 
+	TimerQueue::~TimerQueue()
+	{
+		GetQueuedEvents().Sub(static_cast<int64>(m_queue.size()));
+	}
+
 	GameTime TimerQueue::GetNow() const
 	{
 		return GetAsyncTimeMs();
@@ -20,6 +36,7 @@ namespace mmo
 	void TimerQueue::AddEvent(const EventCallback& callback, GameTime time)
 	{
 		m_queue.emplace(callback, time);
+		GetQueuedEvents().Add();
 		SetTimer();
 	}
 
@@ -32,6 +49,8 @@ namespace mmo
 			return;
 		}
 
+		TRACE_SCOPE("TimerQueue::Update");
+
 		m_timerTime.reset();
 
 		const auto now = GetNow();
@@ -43,6 +62,7 @@ namespace mmo
 			{
 				const auto callback = next.callback;
 				m_queue.pop();
+				GetQueuedEvents().Sub();
 				callback();
 			}
 			else
@@ -28,6 +28,8 @@ namespace mmo
 		/// @param service The io service object to queue timers in to.
 		explicit TimerQueue(asio::io_service &service);
 
+		~TimerQueue();
+
 	public:
 		/// Gets the current timestamp in milliseconds.
 		GameTime GetNow() const;
@@ -0,0 +1,307 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "trace_profiler.h"
+
+#include "clock.h"
+#include "log/default_log_levels.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+
+namespace mmo
+{
+	namespace
+	{
+		void WriteJsonString(std::ostream& stream, const char* value)
+		{
+			stream << '"';
+			for (const char* c = value; *c; ++c)
+			{
+				if (*c == '"' || *c == '\\')
+				{
+					stream << '\\';
+				}
+				stream << *c;
+			}
+			stream << '"';
+		}
+
+		void WriteTraceEvents(std::ostream& stream, const std::vector<TraceThreadEvents>& threads)
+		{
+			stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+			const auto previousFlags = stream.flags();
+			const auto previousPrecision = stream.precision(3);
+			stream << std::fixed;
+
+			bool first = true;
+			for (const auto& thread : threads)
+			{
+				for (const auto& event : thread.events)
+				{
+					if (!first)
+					{
+						stream << ',';
+					}
+					first = false;
+
+					stream << "{\"name\":";
+					WriteJsonString(stream, event.name);
+					stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.threadId
+						<< ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+						<< ",\"dur\":" << static_cast<double>(event.duration) / 1000.0 << '}';
+				}
+			}
+
+			stream.flags(previousFlags);
+			stream.precision(previousPrecision);
+
+			stream << "]}";
+		}
+	}
+
+	TraceEventBuffer::TraceEventBuffer(const uint32 threadId, const size_t capacity)
+		: m_threadId(threadId)
+		, m_capacity(std::max<size_t>(capacity, 1))
+		, m_slots(std::make_unique<Slot[]>(m_capacity))
+	{
+	}
+
+	void TraceEventBuffer::Push(const char* name, const uint64 start, const uint64 duration) noexcept
+	{
+		const uint64 index = m_written.load(std::memory_order_relaxed);
+
+		Slot& slot = m_slots[index % m_capacity];
+		slot.name.store(name, std::memory_order_relaxed);
+		slot.start.store(start, std::memory_order_relaxed);
+		slot.duration.store(duration, std::memory_order_relaxed);
+
+		m_written.store(index + 1, std::memory_order_release);
+	}
+
+	void TraceEventBuffer::CopyEvents(std::vector<TraceEvent>& out_events, const uint64 since) const
+	{
+		const uint64 written = m_written.load(std::memory_order_acquire);
+		const uint64 count = std::min<uint64>(written, m_capacity);
+
+		for (uint64 i = written - count; i < written; ++i)
+		{
+			const Slot& slot = m_slots[i % m_capacity];
+
+			TraceEvent event;
+			event.name = slot.name.load(std::memory_order_relaxed);
+			event.start = slot.start.load(std::memory_order_relaxed);
+			event.duration = slot.duration.load(std::memory_order_relaxed);
+
+			if (event.name && event.start >= since)
+			{
+				out_events.push_back(event);
+			}
+		}
+	}
+
+	TraceProfiler& TraceProfiler::Get()
+	{
+		static TraceProfiler s_profiler;
+		return s_profiler;
+	}
+
+	TraceProfiler::TraceProfiler()
+		: m_epoch(std::chrono::steady_clock::now())
+	{
+	}
+
+	TraceProfiler::~TraceProfiler()
+	{
+		if (!m_captureWriter.joinable())
+		{
+			return;
+		}
+
+		{
+			std::scoped_lock lock{ m_captureMutex };
+			m_stopCaptureWriter = true;
+		}
+
+		m_captureQueued.notify_one();
+		m_captureWriter.join();
+	}
+
+	void TraceProfiler::Record(const char* name, const uint64 start, const uint64 duration)
+	{
+		GetThreadBuffer().Push(name, start, duration);
+	}
+
+	void TraceProfiler::SetEnabled(const bool enabled)
+	{
+		std::scoped_lock lock{ m_mutex };
+		m_enabled = enabled;
+		UpdateRecording();
+	}
+
+	void TraceProfiler::SetSampleInterval(const uint32 interval)
+	{
+		std::scoped_lock lock{ m_mutex };
+		m_sampleInterval = interval;
+	}
+
+	void TraceProfiler::SetTrigger(const GameTime threshold, const uint32 ticksAfter, const String& outputFolder)
+	{
+		std::scoped_lock lock{ m_mutex };
+		m_triggerThreshold = threshold;
+		m_ticksAfterTrigger = ticksAfter;
+		m_outputFolder = outputFolder;
+	}
+
+	void TraceProfiler::BeginTick()
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		m_tickStart = GetTimestamp();
+		m_sampleTick = m_sampleInterval > 0 && (m_tickIndex++ % m_sampleInterval) == 0;
+		UpdateRecording();
+	}
+
+	void TraceProfiler::EndTick()
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		const GameTime tickDuration = (GetTimestamp() - m_tickStart) / 1000000;
+
+		if (m_pendingCaptureTicks > 0)
+		{
+			if (--m_pendingCaptureTicks == 0)
+			{
+				WriteCapture();
+			}
+		}
+		else if (m_triggerThreshold > 0 && tickDuration > m_triggerThreshold)
+		{
+			const GameTime now = GetAsyncTimeMs();
+			if (m_lastCapture == 0 || now - m_lastCapture >= TriggerCooldown)
+			{
+				WLOG("Tick took " << tickDuration << " ms, recording the next " << m_ticksAfterTrigger << " ticks");
+
+				m_lastCapture = now;
+				m_captureSince = m_tickStart;
+				m_pendingCaptureTicks = m_ticksAfterTrigger;
+
+				if (m_pendingCaptureTicks == 0)
+				{
+					WriteCapture();
+				}
+			}
+		}
+
+		m_sampleTick = false;
+		UpdateRecording();
+	}
+
+	void TraceProfiler::WriteChromeTrace(std::ostream& stream, const uint64 since) const
+	{
+		WriteTraceEvents(stream, CopyEvents(since));
+	}
+
+	void TraceProfiler::FlushCaptures()
+	{
+		std::unique_lock lock{ m_captureMutex };
+		m_capturesWritten.wait(lock, [this]() { return m_captures.empty() && !m_writingCapture; });
+	}
+
+	std::vector<TraceThreadEvents> TraceProfiler::CopyEvents(const uint64 since) const
+	{
+		std::vector<std::shared_ptr<TraceEventBuffer>> buffers;
+		{
+			std::scoped_lock lock{ m_buffersMutex };
+			buffers = m_buffers;
+		}
+
+		std::vector<TraceThreadEvents> threads(buffers.size());
+		for (size_t i = 0; i < buffers.size(); ++i)
+		{
+			threads[i].threadId = buffers[i]->GetThreadId();
+			buffers[i]->CopyEvents(threads[i].events, since);
+		}
+
+		return threads;
+	}
+
+	TraceEventBuffer& TraceProfiler::GetThreadBuffer()
+	{
+		thread_local std::shared_ptr<TraceEventBuffer> t_buffer;
+		if (!t_buffer)
+		{
+			std::scoped_lock lock{ m_buffersMutex };
+			t_buffer = std::make_shared<TraceEventBuffer>(static_cast<uint32>(m_buffers.size() + 1), EventsPerThread);
+			m_buffers.push_back(t_buffer);
+		}
+
+		return *t_buffer;
+	}
+
+	void TraceProfiler::UpdateRecording()
+	{
+		m_recording.store(m_enabled || m_sampleTick || m_pendingCaptureTicks > 0, std::memory_order_relaxed);
+	}
+
+	void TraceProfiler::WriteCapture()
+	{
+		Capture capture;
+		capture.fileName = (std::filesystem::path(m_outputFolder) / ("trace_" + std::to_string(GetAsyncTimeMs()) + ".json")).string();
+		capture.threads = CopyEvents(m_captureSince);
+
+		{
+			std::scoped_lock lock{ m_captureMutex };
+			m_captures.push_back(std::move(capture));
+
+			// The writer is only started once the first capture is written
+			if (!m_captureWriter.joinable())
+			{
+				m_captureWriter = std::thread(&TraceProfiler::RunCaptureWriter, this);
+			}
+		}
+
+		m_captureQueued.notify_one();
+	}
+
+	void TraceProfiler::RunCaptureWriter()
+	{
+		std::unique_lock lock{ m_captureMutex };
+
+		for (;;)
+		{
+			m_captureQueued.wait(lock, [this]() { return m_stopCaptureWriter || !m_captures.empty(); });
+			if (m_captures.empty())
+			{
+				return;
+			}
+
+			Capture capture = std::move(m_captures.front());
+			m_captures.pop_front();
+			m_writingCapture = true;
+			lock.unlock();
+
+			const std::filesystem::path fileName = capture.fileName;
+
+			std::error_code error;
+			std::filesystem::create_directories(fileName.parent_path(), error);
+
+			std::ofstream file(fileName);
+			if (file)
+			{
+				WriteTraceEvents(file, capture.threads);
+				ILOG("Wrote trace file " << fileName.string());
+			}
+			else
+			{
+				ELOG("Failed to open trace file " << fileName.string());
+			}
+
+			lock.lock();
+			m_writingCapture = false;
+			m_capturesWritten.notify_all();
+		}
+	}
+}
@@ -0,0 +1,209 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "typedefs.h"
+#include "non_copyable.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace mmo
+{
+	/// A completed scope recorded by the trace profiler.
+	struct TraceEvent
+	{
+		/// Name of the scope. Always a string literal, so the pointer identifies the scope.
+		const char* name = nullptr;
+		/// Start of the scope in nanoseconds since the profiler has been created.
+		uint64 start = 0;
+		/// Duration of the scope in nanoseconds.
+		uint64 duration = 0;
+	};
+
+	/// Events of a single thread copied out of its ring buffer.
+	struct TraceThreadEvents
+	{
+		uint32 threadId = 0;
+		std::vector<TraceEvent> events;
+	};
+
+	/// Ring buffer of trace events which is only written by the thread owning it. When full, the oldest events are
+	/// overwritten. Events may be copied from other threads at any time without blocking the owner; an event which
+	/// is overwritten while being copied may come out torn, which is acceptable for diagnostics.
+	class TraceEventBuffer final : public NonCopyable
+	{
+	public:
+		explicit TraceEventBuffer(uint32 threadId, size_t capacity);
+
+	public:
+		void Push(const char* name, uint64 start, uint64 duration) noexcept;
+
+		/// Appends all buffered events which started at or after the given timestamp, oldest first.
+		void CopyEvents(std::vector<TraceEvent>& out_events, uint64 since) const;
+
+		[[nodiscard]] uint32 GetThreadId() const noexcept { return m_threadId; }
+
+	private:
+		struct Slot
+		{
+			std::atomic<const char*> name { nullptr };
+			std::atomic<uint64> start { 0 };
+			std::atomic<uint64> duration { 0 };
+		};
+
+		const uint32 m_threadId;
+		const size_t m_capacity;
+		std::unique_ptr<Slot[]> m_slots;
+		/// Total number of events ever pushed.
+		std::atomic<uint64> m_written { 0 };
+	};
+
+	/// Process-wide tracing profiler for the servers. Scopes are recorded into per-thread ring buffers, which can be
+	/// exported in the Chrome trace event format (chrome://tracing, Perfetto). Recording can be enabled permanently,
+	/// for one out of every n ticks (sampling) or for the ticks following a tick which took too long (trigger). While
+	/// not recording, a trace scope costs a single relaxed atomic load. Trace files of trigger captures are written
+	/// by a background thread, so the tick which finishes a capture only copies the events.
+	class TraceProfiler final : public NonCopyable
+	{
+	public:
+		/// Number of events each thread keeps.
+		static constexpr size_t EventsPerThread = 16384;
+
+		/// Minimum time in milliseconds between two trace files written because of slow ticks.
+		static constexpr GameTime TriggerCooldown = 60 * 1000;
+
+	public:
+		static TraceProfiler& Get();
+
+	public:
+		[[nodiscard]] bool IsRecording() const noexcept { return m_recording.load(std::memory_order_relaxed); }
+
+		/// Gets the current timestamp in nanoseconds since the profiler has been created.
+		[[nodiscard]] uint64 GetTimestamp() const noexcept
+		{
+			return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_epoch).count());
+		}
+
+		/// Records a completed scope in the buffer of the calling thread.
+		void Record(const char* name, uint64 start, uint64 duration);
+
+		/// Enables or disables recording of every tick.
+		void SetEnabled(bool enabled);
+
+		/// Records only one out of every interval ticks. 0 disables sampling.
+		void SetSampleInterval(uint32 interval);
+
+		/// Writes a trace file once a tick took longer than the threshold and the given number of ticks after it have
+		/// been recorded as well. If recording is enabled, the slow tick itself is part of the file too.
+		/// @param threshold Tick duration in milliseconds which triggers a capture. 0 disables the trigger.
+		/// @param ticksAfter Number of ticks recorded after the slow tick.
+		/// @param outputFolder Folder in which trace files are written.
+		void SetTrigger(GameTime threshold, uint32 ticksAfter, const String& outputFolder);
+
+		/// Has to be called at the start of every server tick by the thread running the ticks.
+		void BeginTick();
+
+		/// Has to be called at the end of every server tick by the thread running the ticks.
+		void EndTick();
+
+		/// Writes all buffered events which started at or after the given timestamp as Chrome trace event JSON.
+		void WriteChromeTrace(std::ostream& stream, uint64 since = 0) const;
+
+		/// Blocks until all trace files of finished trigger captures have been written.
+		void FlushCaptures();
+
+	private:
+		explicit TraceProfiler();
+
+		~TraceProfiler();
+
+		/// Copies all buffered events which started at or after the given timestamp.
+		std::vector<TraceThreadEvents> CopyEvents(uint64 since) const;
+
+		TraceEventBuffer& GetThreadBuffer();
+
+		/// Updates whether scopes are recorded right now. m_mutex has to be locked.
+		void UpdateRecording();
+
+		/// Copies the events of the finished trigger capture and queues them to be written. m_mutex has to be locked.
+		void WriteCapture();
+
+		/// Writes queued captures until the profiler is destroyed. Runs on m_captureWriter.
+		void RunCaptureWriter();
+
+	private:
+		const std::chrono::steady_clock::time_point m_epoch;
+		std::atomic<bool> m_recording { false };
+
+		mutable std::mutex m_buffersMutex;
+		std::vector<std::shared_ptr<TraceEventBuffer>> m_buffers;
+
+		std::mutex m_mutex;
+		bool m_enabled = false;
+		uint32 m_sampleInterval = 0;
+		uint64 m_tickIndex = 0;
+		bool m_sampleTick = false;
+		GameTime m_triggerThreshold = 0;
+		uint32 m_ticksAfterTrigger = 0;
+		String m_outputFolder;
+		uint64 m_tickStart = 0;
+		uint32 m_pendingCaptureTicks = 0;
+		uint64 m_captureSince = 0;
+		GameTime m_lastCapture = 0;
+
+		struct Capture
+		{
+			String fileName;
+			std::vector<TraceThreadEvents> threads;
+		};
+
+		std::mutex m_captureMutex;
+		std::condition_variable m_captureQueued;
+		std::condition_variable m_capturesWritten;
+		std::deque<Capture> m_captures;
+		bool m_writingCapture = false;
+		bool m_stopCaptureWriter = false;
+		std::thread m_captureWriter;
+	};
+
+	/// Records the lifetime of a scope with the trace profiler. Use the TRACE_SCOPE macro instead of this class.
+	class TraceScope final : public NonCopyable
+	{
+	public:
+		explicit TraceScope(const char* name) noexcept
+			: m_name(TraceProfiler::Get().IsRecording() ? name : nullptr)
+		{
+			if (m_name)
+			{
+				m_start = TraceProfiler::Get().GetTimestamp();
+			}
+		}
+
+		~TraceScope()
+		{
+			if (m_name)
+			{
+				TraceProfiler& profiler = TraceProfiler::Get();
+				profiler.Record(m_name, m_start, profiler.GetTimestamp() - m_start);
+			}
+		}
+
+	private:
+		const char* m_name;
+		uint64 m_start = 0;
+	};
+}
+
+#define MMO_TRACE_CONCAT_IMPL(a, b) a##b
+#define MMO_TRACE_CONCAT(a, b) MMO_TRACE_CONCAT_IMPL(a, b)
+
+/// Records the enclosing scope with the trace profiler. The name has to be a string literal.
+#define TRACE_SCOPE(name) const ::mmo::TraceScope MMO_TRACE_CONCAT(traceScope_, __LINE__) { "" name }
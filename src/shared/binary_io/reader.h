@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <cmath>
 #include <cstdint>
+#include <type_traits>
 
 namespace io
 {
@@ -114,15 +115,115 @@ namespace io
 			m_success = false;
 		}
 
-	private:
+	protected:
 
 		ISource *m_source;
 		bool m_success;
 	};
 
 
+	/// Reader over a concrete source type. Reads are forwarded to the source without a virtual call, and
+	/// the io operators keep the concrete reader type, so a chain of operator>> calls can be fully inlined.
+	/// @tparam TSource The source type, like MemorySource. Its read method is called non-virtually, so
+	///         sources derived from TSource must not override it.
+	template <class TSource>
+	class BasicReader final
+		: public Reader
+	{
+	public:
+
+		explicit BasicReader(TSource &source)
+			: Reader(source)
+			, m_concreteSource(source)
+		{
+		}
+
+		TSource *getSource() const
+		{
+			return &m_concreteSource;
+		}
+
+		/// The source of a typed reader can't be exchanged.
+		void setSource(ISource *source) = delete;
+
+		void skip(std::size_t size)
+		{
+			m_concreteSource.TSource::skip(size);
+		}
+
+		template <class T>
+		void readPOD(T &pod)
+		{
+			if (!m_success)
+			{
+				return;
+			}
+
+			const size_t size = sizeof(pod);
+			const size_t read = m_concreteSource.TSource::read(
+			                        reinterpret_cast<char *>(&pod),
+			                        size);
+
+			m_success = (size == read);
+		}
+
+		void readPOD(float &pod)
+		{
+			readFloatingPoint(pod);
+		}
+
+		void readPOD(double &pod)
+		{
+			readFloatingPoint(pod);
+		}
+
+		/// Checks once that at least size bytes are left for the following packet section and fails the
+		/// reader otherwise, so that a truncated section is rejected before any of its fields are read.
+		BasicReader &Require(std::size_t size)
+		{
+			if (m_success && m_concreteSource.TSource::size() - m_concreteSource.TSource::position() < size)
+			{
+				m_success = false;
+			}
+
+			return *this;
+		}
+
+	private:
+
+		template <class T>
+		void readFloatingPoint(T &pod)
+		{
+			if (!m_success)
+			{
+				return;
+			}
+
+			const size_t size = sizeof(pod);
+			const size_t read = m_concreteSource.TSource::read(
+				reinterpret_cast<char *>(&pod),
+				size);
+
+			if (std::isnan(pod) || !std::isfinite(pod))
+				m_success = false;
+			else
+				m_success = (size == read);
+		}
+
+	private:
+
+		TSource &m_concreteSource;
+	};
+
+
+	/// Resolves to R& if R is a reader type. Used by the io operators to return the concrete reader type.
+	template <class R>
+	using ReaderRef = std::enable_if_t<std::is_base_of_v<Reader, R>, R &>;
+
+
 #define BINARY_IO_READER_OPERATOR(type) \
-	inline Reader &operator >> (Reader &r, type &value) \
+	template <class R> \
+	ReaderRef<R> operator >> (R &r, type &value) \
 	{ \
 		r.readPOD(value); \
 		return r; \
@@ -143,7 +244,8 @@ namespace io
 #undef BINARY_IO_READER_OPERATOR
 
 #define BINARY_IO_READER_FLOAT_OPERATOR(type) \
-	inline Reader &operator >> (Reader &r, type &value) \
+	template <class R> \
+	ReaderRef<R> operator >> (R &r, type &value) \
 	{ \
 		r.readPOD(value); \
 		return r; \
@@ -172,8 +274,8 @@ namespace io
 			}
 		};
 
-		template <class F, class T>
-		Reader &operator >> (Reader &r, const ReadConverted<F, T> &surr)
+		template <class R, class F, class T>
+		ReaderRef<R> operator >> (R &r, const ReadConverted<F, T> &surr)
 		{
 			F original;
 
@@ -185,8 +287,8 @@ namespace io
 			return r;
 		}
 
-		template <class F>
-		Reader &operator >> (Reader &r, const ReadConverted<F, bool> &surr)
+		template <class R, class F>
+		ReaderRef<R> operator >> (R &r, const ReadConverted<F, bool> &surr)
 		{
 			F original;
 
@@ -222,8 +324,8 @@ namespace io
 			}
 		};
 
-		template <class I>
-		Reader &operator >> (Reader &r, const ReadRange<I> &range)
+		template <class R, class I>
+		ReaderRef<R> operator >> (R &r, const ReadRange<I> &range)
 		{
 			for (I i = range.begin; i != range.end; ++i)
 			{
@@ -263,8 +365,8 @@ namespace io
 			}
 		};
 
-		template <class I, class E>
-		Reader &operator >> (Reader &r, const ReadRangeWithConversion<I, E> &range)
+		template <class R, class I, class E>
+		ReaderRef<R> operator >> (R &r, const ReadRangeWithConversion<I, E> &range)
 		{
 			for (I i = range.begin; i != range.end; ++i)
 			{
@@ -303,7 +405,8 @@ namespace io
 		};
 
 
-		inline Reader &operator >> (Reader &r, const Skip &skip)
+		template <class R>
+		ReaderRef<R> operator >> (R &r, const Skip &skip)
 		{
 			r.skip(skip.size);
 			return r;
@@ -325,8 +428,8 @@ namespace io
 
 	namespace detail
 	{
-		template <class L, class C, class ReadElement>
-		void readContainer(Reader &r, C &destination, L maxLength, const ReadElement &readElement)
+		template <class R, class L, class C, class ReadElement>
+		void readContainer(R &r, C &destination, L maxLength, const ReadElement &readElement)
 		{
 			typedef typename C::value_type Element;
 
@@ -367,8 +470,8 @@ namespace io
 			}
 		};
 
-		template <class L, class C>
-		Reader &operator >> (Reader &r, const ReadContainerWithLength<L, C> &surr)
+		template <class R, class L, class C>
+		ReaderRef<R> operator >> (R &r, const ReadContainerWithLength<L, C> &surr)
 		{
 			typedef typename C::value_type Element;
 
@@ -397,8 +500,8 @@ namespace io
 			}
 		};
 
-		template <class L, class E, class C>
-		Reader &operator >> (Reader &r, const ReadContainerWithLengthAndConversion<L, E, C> &surr)
+		template <class R, class L, class E, class C>
+		ReaderRef<R> operator >> (R &r, const ReadContainerWithLengthAndConversion<L, E, C> &surr)
 		{
 			typedef typename C::value_type Element;
 
@@ -441,7 +544,8 @@ namespace io
 			}
 		};
 
-		inline Reader &operator >> (Reader &r, const ReadString &surr)
+		template <class R>
+		ReaderRef<R> operator >> (R &r, const ReadString &surr)
 		{
 			char c = 0x00;
 			do
@@ -481,7 +585,8 @@ namespace io
 			}
 		};
 
-		inline Reader& operator >> (Reader& r, const ReadLimitedString& surr)
+		template <class R>
+		ReaderRef<R> operator >> (R& r, const ReadLimitedString& surr)
 		{
 			char c = 0x00;
 			do
@@ -523,7 +628,8 @@ namespace io
 			}
 		};
 		
-		inline Reader &operator >> (Reader &r, const ReadablePackedGuid &surr)
+		template <class R>
+		ReaderRef<R> operator >> (R &r, const ReadablePackedGuid &surr)
 		{
 			std::uint8_t bitMask = 0;
 			r >> io::read<std::uint8_t>(bitMask);
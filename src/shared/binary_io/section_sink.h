@@ -0,0 +1,83 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "sink.h"
+
+#include <cstring>
+
+namespace io
+{
+	/// Sink over a region of a buffer which has already been sized for a packet section. Writes are copied
+	/// into the region without any buffer growth, so the size of the section has to be known when the region
+	/// is reserved. Writes which don't fit into the region are refused and fail the sink for good, so that a
+	/// section which was sized too small never writes past its region. Use it together with BasicWriter,
+	/// which calls Write non-virtually and fails as soon as a write is refused.
+	class SectionSink final
+		: public ISink
+	{
+	public:
+
+		SectionSink(char *begin, std::size_t size)
+			: m_begin(begin)
+			, m_size(size)
+			, m_position(0)
+			, m_overflowed(false)
+		{
+		}
+
+		std::size_t Write(const char *src, std::size_t size) override
+		{
+			if (m_overflowed || size > m_size - m_position)
+			{
+				m_overflowed = true;
+				return 0;
+			}
+
+			std::memcpy(m_begin + m_position, src, size);
+			m_position += size;
+			return size;
+		}
+
+		std::size_t Overwrite(std::size_t position, const char *src, std::size_t size) override
+		{
+			if (position > m_position || size > m_position - position)
+			{
+				m_overflowed = true;
+				return 0;
+			}
+
+			std::memcpy(m_begin + position, src, size);
+			return size;
+		}
+
+		/// Gets the number of bytes written to the section so far.
+		std::size_t Position() override
+		{
+			return m_position;
+		}
+
+		/// Gets the number of bytes reserved for the section.
+		[[nodiscard]] std::size_t Size() const
+		{
+			return m_size;
+		}
+
+		/// Determines whether a write has been refused because it didn't fit into the section.
+		[[nodiscard]] bool HasOverflowed() const
+		{
+			return m_overflowed;
+		}
+
+		void Flush() override
+		{
+		}
+
+	private:
+
+		char *m_begin;
+		std::size_t m_size;
+		std::size_t m_position;
+		bool m_overflowed;
+	};
+}
@@ -5,7 +5,9 @@
 #include "sink.h"
 
 #include <string>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace io
 {
@@ -51,6 +53,27 @@ namespace io
 			return m_buffer.size();
 		}
 
+		/// Grows the buffer capacity so that the next size bytes can be written without reallocation.
+		void Reserve(std::size_t size)
+		{
+			const std::size_t required = m_buffer.size() + size;
+			if (required > m_buffer.capacity())
+			{
+				m_buffer.reserve((std::max)(required, m_buffer.capacity() * 2));
+			}
+		}
+
+		/// Appends size bytes to the buffer at once and returns the start of the appended region, so that a
+		/// packet section of known size can be written into it without checking the capacity per field.
+		char *Extend(std::size_t size)
+		{
+			Reserve(size);
+
+			const std::size_t position = m_buffer.size();
+			m_buffer.resize(position + size);
+			return reinterpret_cast<char *>(&m_buffer[0]) + position;
+		}
+
 		void Flush() override
 		{
 		}
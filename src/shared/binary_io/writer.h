@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include "section_sink.h"
 #include "sink.h"
 #include "base/non_copyable.h"
 
+#include <type_traits>
+
 
 namespace io
 {
@@ -40,14 +43,99 @@ namespace io
 			    sizeof(pod));
 		}
 
+		/// Writes raw bytes to the sink.
+		void WriteBytes(const char *src, std::size_t size)
+		{
+			m_sink.Write(src, size);
+		}
+
 	private:
 
 		ISink &m_sink;
 	};
 
 
+	/// Writer over a concrete sink type. Writes are forwarded to the sink without a virtual call, and the
+	/// io operators keep the concrete writer type, so a chain of operator<< calls can be fully inlined.
+	/// @tparam TSink The sink type, like VectorSink or StringSink. Its Write method is called non-virtually,
+	///         so sinks derived from TSink must not override it.
+	template <class TSink>
+	class BasicWriter final
+		: public Writer
+	{
+	public:
+		explicit BasicWriter(TSink &sink)
+			: Writer(sink)
+			, m_sink(sink)
+			, m_success(true)
+		{
+		}
+
+	public:
+		TSink &Sink() { return m_sink; }
+		[[nodiscard]] const TSink &Sink() const { return m_sink; }
+
+		template <class T>
+		void WritePOD(const T &pod)
+		{
+			WriteBytes(reinterpret_cast<const char *>(&pod), sizeof(pod));
+		}
+
+		template <class T>
+		void WritePOD(std::size_t position, const T &pod)
+		{
+			if (m_sink.TSink::Overwrite(position, reinterpret_cast<const char *>(&pod), sizeof(pod)) != sizeof(pod))
+			{
+				m_success = false;
+			}
+		}
+
+		/// Writes raw bytes to the sink and fails the writer if the sink refuses any of them.
+		void WriteBytes(const char *src, std::size_t size)
+		{
+			if (m_sink.TSink::Write(src, size) != size)
+			{
+				m_success = false;
+			}
+		}
+
+		/// Determines whether all writes have been accepted by the sink.
+		explicit operator bool() const
+		{
+			return m_success;
+		}
+
+		/// Makes sure that the next size bytes can be written without growing the sink's buffer, so the
+		/// capacity of a packet section only has to be ensured once instead of once per field.
+		BasicWriter &Reserve(std::size_t size)
+		{
+			m_sink.Reserve(size);
+			return *this;
+		}
+
+		/// Appends a packet section of exactly size bytes to the sink, checking the capacity only once. The
+		/// fields of the section are then written through a BasicWriter<SectionSink> over the returned sink,
+		/// which copies them into the reserved region without any further checks.
+		SectionSink ReserveSection(std::size_t size)
+		{
+			return SectionSink(m_sink.Extend(size), size);
+		}
+
+	private:
+
+		TSink &m_sink;
+		bool m_success;
+	};
+
+
+	/// Resolves to W& if W is a writer type. Used by the io operators to return the concrete writer type.
+	template <class W>
+	using WriterRef = std::enable_if_t<std::is_base_of_v<Writer, W>, W &>;
+
+
 #define BINARY_IO_WRITER_OPERATOR(type) \
-	inline Writer &operator << (Writer &w, type value) \
+	template <class W> \
+	WriterRef<W> operator << (W &w, type value) \
 	{ \
 		w.WritePOD(value); \
 		return w; \
@@ -69,7 +157,8 @@ namespace io
 #undef BINARY_IO_WRITER_OPERATOR
 
 #define BINARY_IO_WRITER_FLOAT_OPERATOR(type) \
-	inline Writer &operator << (Writer &w, type value) \
+	template <class W> \
+	WriterRef<W> operator << (W &w, type value) \
 	{ \
 		w.WritePOD(value); \
 		return w; \
@@ -99,10 +188,11 @@ namespace io
 			}
 		};
 
-		template <class F, class T>
-		Writer &operator << (Writer &w, const WriteConverted<F, T> &surr)
+		template <class W, class F, class T>
+		WriterRef<W> operator << (W &w, const WriteConverted<F, T> &surr)
 		{
-			return w << static_cast<T>(surr.source);
+			w << static_cast<T>(surr.source);
+			return w;
 		}
 	}
 
@@ -128,8 +218,8 @@ namespace io
 			}
 		};
 
-		template <class I, class E>
-		Writer &operator << (Writer &w, const WriteRangeWithConversion<I, E> &range)
+		template <class W, class I, class E>
+		WriterRef<W> operator << (W &w, const WriteRangeWithConversion<I, E> &range)
 		{
 			for (I i = range.begin; i != range.end; ++i)
 			{
@@ -153,8 +243,8 @@ namespace io
 			}
 		};
 
-		template <class I>
-		Writer &operator << (Writer &w, const WriteRange<I> &range)
+		template <class W, class I>
+		WriterRef<W> operator << (W &w, const WriteRange<I> &range)
 		{
 			for (I i = range.begin; i != range.end; ++i)
 			{
@@ -206,8 +296,8 @@ namespace io
 			}
 		};
 
-		template <class L, class I>
-		Writer &operator << (Writer &w, const WriteRangeWithLength<L, I> &range)
+		template <class W, class L, class I>
+		WriterRef<W> operator << (W &w, const WriteRangeWithLength<L, I> &range)
 		{
 			const L length = static_cast<L>(range.end - range.begin);
 
@@ -235,8 +325,8 @@ namespace io
 			}
 		};
 
-		template <class L, class I, class E>
-		Writer &operator << (Writer &w, const WriteRangeWithLengthAndConversion<L, I, E> &range)
+		template <class W, class L, class I, class E>
+		WriterRef<W> operator << (W &w, const WriteRangeWithLengthAndConversion<L, I, E> &range)
 		{
 			const L length = static_cast<L>(range.end - range.begin);
 
@@ -290,7 +380,8 @@ namespace io
 			}
 		};
 
-		inline Writer &operator << (Writer &w, const WritablePackedGuid &surr)
+		template <class W>
+		WriterRef<W> operator << (W &w, const WritablePackedGuid &surr)
 		{
 			std::uint64_t guid = surr.guid;
 
@@ -310,8 +401,8 @@ namespace io
 				guid >>= 8;
 			}
 
-			return w
-				<< io::write_range(&packGUID[0], &packGUID[size]);
+			w << io::write_range(&packGUID[0], &packGUID[size]);
+			return w;
 		}
 	}
 
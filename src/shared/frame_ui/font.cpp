@@ -3,11 +3,18 @@
 #include "font.h"
 
 #include "base/macros.h"
+#include "base/sha1.h"
 #include "assets/asset_registry.h"
+#include "binary_io/reader.h"
+#include "binary_io/stream_sink.h"
+#include "binary_io/stream_source.h"
+#include "binary_io/writer.h"
 #include "graphics/graphics_device.h"
+#include "log/default_log_levels.h"
 
 #include <atomic>
 #include <fstream>
+#include <sstream>
 
 #include FT_STROKER_H
 
@@ -18,10 +25,8 @@ namespace mmo
 	static constexpr uint32 INTER_GLYPH_PAD_SPACE = 4;
 	/// A multiplication coefficient to convert FT_Pos values into normal floats
 	static constexpr float FT_POS_COEF = (1.0f / 64.0f);
-	/// Number of glyphs per page. Must be a power of two.
-	static constexpr uint32 GLYPHS_PER_PAGE = 256;
-	/// Amount of bits in a uint32.
-	static constexpr uint32 BITS_PER_UINT = sizeof(uint32) * 8;
+	/// Revision of the glyph cache file format.
+	static constexpr uint32 GLYPH_CACHE_REVISION = 1;
 
 
 	/// FreeType library handle.
@@ -30,13 +35,13 @@ namespace mmo
 	static std::atomic<int32> s_freeTypeUsageCount = 0;
 
 
-	Font::Font()
+	Font::Font(uint32 atlasPageSize, uint32 maxAtlasPageCount)
 		: m_pointSize(0.0f)
 		, m_ascender(0)
 		, m_descender(0)
 		, m_height(0)
 		, m_outlineWidth(0.0f)
-		, m_maxCodepoint(0)
+		, m_atlas([this](uint32 codepoint) { OnGlyphEvicted(codepoint); }, atlasPageSize, maxAtlasPageCount)
 	{
 		// Initializes the free type library if not already done and also increase
 		// the reference counter.
@@ -46,6 +51,11 @@ namespace mmo
 
 	Font::~Font()
 	{
+		// Release textures before the glyphs which use them
+		m_layoutCache.Clear();
+		m_glyphMap.clear();
+		m_atlas.Clear();
+
 		// Unload font face now before we eventually dispose the freetype library
 		m_fontFace.reset();
 
@@ -140,357 +150,195 @@ namespace mmo
 			m_height = m_fontFace->size->metrics.height * FT_POS_COEF;
 		}
 
-		// Create an empty FontGlyph structure for every glyph of the font
-		FT_UInt glyphIndex;
-		FT_ULong codepoint = FT_Get_First_Char(m_fontFace.get(), &glyphIndex);
-		FT_ULong maxCodepoint = codepoint;
-		while (glyphIndex)
-		{
-			if (maxCodepoint < codepoint)
-				maxCodepoint = codepoint;
+		// Glyphs are loaded and rasterized when they are used for the first time. Cached text layouts
+		// reference the old glyphs and metrics.
+		m_layoutCache.Clear();
+		m_glyphMap.clear();
+		m_atlas.Clear();
+
+		return true;
+	}
+
+	FontGlyph* Font::LoadGlyph(uint32 codepoint)
+	{
+		// Only codepoints of the character map are available
+		if (!FT_Get_Char_Index(m_fontFace.get(), codepoint))
+			return nullptr;
 
-			// Load-up required glyph metrics
-			if (FT_Load_Char(m_fontFace.get(), codepoint, FT_LOAD_DEFAULT | FT_LOAD_FORCE_AUTOHINT))
-				continue; // Glyph error
+		// Load-up required glyph metrics
+		if (FT_Load_Char(m_fontFace.get(), codepoint, FT_LOAD_DEFAULT | FT_LOAD_FORCE_AUTOHINT))
+			return nullptr;
 
-			// Create a new empty FontGlyph with given character code
-			const float advance = m_fontFace->glyph->metrics.horiAdvance * FT_POS_COEF;
-			m_glyphMap[codepoint] = FontGlyph(advance);
+		// Create a new FontGlyph with given character code, rasterization happens later
+		const float advance = m_fontFace->glyph->metrics.horiAdvance * FT_POS_COEF;
+		return &m_glyphMap.emplace(codepoint, FontGlyph(advance)).first->second;
+	}
 
-			// Proceed to next glyph
-			codepoint = FT_Get_Next_Char(m_fontFace.get(), codepoint, &glyphIndex);
+	void Font::RasterizeGlyph(uint32 codepoint, FontGlyph& glyph)
+	{
+		FontGlyphBitmap bitmap;
+		const auto cacheIt = m_cachedGlyphs.find(codepoint);
+		if (cacheIt != m_cachedGlyphs.end())
+		{
+			bitmap = std::move(cacheIt->second);
+			m_cachedGlyphs.erase(cacheIt);
+		}
+		else
+		{
+			RenderGlyph(codepoint, bitmap);
+			m_glyphCacheModified = !m_glyphCacheFile.empty();
 		}
 
-		// Update the amount of code points
-		SetMaxCodepoint(maxCodepoint);
+		// Glyphs without pixels use an empty image
+		const FontImage* image = nullptr;
+		if (!bitmap.pixels.empty())
+		{
+			image = m_atlas.AddGlyph(codepoint, bitmap);
 
-		// TODO: This is a hack to initialize some commonly used glyph pages
-		GetGlyphData('a');
+			// The atlas holds the pixels from now on and SaveGlyphCache reads them back from there. Keep
+			// bitmaps which didn't fit onto a page for the glyph cache file.
+			if (!image && !m_glyphCacheFile.empty())
+			{
+				m_cachedGlyphs[codepoint] = std::move(bitmap);
+			}
+		}
 
-		return true;
+		glyph.SetImage(image ? image : &m_emptyImage);
 	}
 
-	uint32 Font::GetTextureSize(GlyphMap::const_iterator start, GlyphMap::const_iterator end) const
+	bool Font::RenderGlyph(uint32 codepoint, FontGlyphBitmap& bitmap)
 	{
-		/// A texture may only grow up to a 4k texture
-		const uint32 maxTexsize = 4096;
+		// Render the glyph
+		if (FT_Load_Char(m_fontFace.get(), codepoint, FT_LOAD_NO_BITMAP | FT_LOAD_FORCE_AUTOHINT | FT_LOAD_TARGET_NORMAL))
+			return false;
+
+		if (m_fontFace->glyph->format != FT_GLYPH_FORMAT_OUTLINE)
+			return false;
 
-		// Start with 32x32 pixel texture
-		uint32 texSize = 32;
-		uint32 glyphCount = 0;
+		// Render normal glyph spans
+		Spans spans;
+		RenderSpans(s_freeTypeLib, &m_fontFace->glyph->outline, &spans);
 
-		while (texSize < maxTexsize)
+		// Next we need the spans for the outline.
+		Spans outlineSpans;
+		if (m_outlineWidth > 0.0f)
 		{
-			uint32 x = INTER_GLYPH_PAD_SPACE, y = INTER_GLYPH_PAD_SPACE;
-			uint32 yb = INTER_GLYPH_PAD_SPACE;
+			FT_Stroker stroker;
+			FT_Stroker_New(s_freeTypeLib, &stroker);
+			FT_Stroker_Set(stroker, (int)(m_outlineWidth * 64.0f), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
 
-			bool isTooSmall = false;
-			for (GlyphMap::const_iterator c = start; c != end; ++c)
+			FT_Glyph ftGlyph;
+			if (FT_Get_Glyph(m_fontFace->glyph, &ftGlyph) == 0)
 			{
-				// Skip glpyhs that are already rendered
-				if (c->second.GetImage())
-					continue;	// Already rendered
-
-				// Load glyph metrics
-				if (FT_Load_Char(m_fontFace.get(), c->first, FT_LOAD_DEFAULT | FT_LOAD_FORCE_AUTOHINT))
-					continue;	// Could not load glyph metrics, skip it!
-
-				// Calculate the glyph size in pixels
-				const uint32 glyphW = static_cast<uint32>(::ceil(m_fontFace->glyph->metrics.width * FT_POS_COEF)) + INTER_GLYPH_PAD_SPACE;
-				const uint32 glyphH = static_cast<uint32>(::ceil(m_fontFace->glyph->metrics.height * FT_POS_COEF)) + INTER_GLYPH_PAD_SPACE;
-
-				// Adjust the offset
-				x += glyphW;
-				if (x > texSize)
+				FT_Glyph_StrokeBorder(&ftGlyph, stroker, 0, 1);
+				// Again, this needs to be an outline to work.
+				if (ftGlyph->format == FT_GLYPH_FORMAT_OUTLINE)
 				{
-					x = INTER_GLYPH_PAD_SPACE;
-					y = yb;
+					// Render the outline spans to the span list
+					FT_Outline *o =
+						&reinterpret_cast<FT_OutlineGlyph>(ftGlyph)->outline;
+					RenderSpans(s_freeTypeLib, o, &outlineSpans);
 				}
 
-				uint32 yy = y + glyphH;
-				if (yy > texSize)
-					isTooSmall = true;
-
-				if (yy > yb)
-					yb = yy;
-
-				++glyphCount;
+				// Clean up afterwards.
+				FT_Stroker_Done(stroker);
+				FT_Done_Glyph(ftGlyph);
 			}
+		}
 
-			// The texture size is enough for holding our glyphs
-			if (!isTooSmall)
-				break;
+		// Now we need to put it all together.
+		if (spans.empty())
+			return false;
 
-			// Double the texture size because it's too small
-			texSize *= 2;
+		// Calculate glyph bounds
+		int minX = spans.front().x;
+		int maxX = minX;
+		int minY = spans.front().y;
+		int maxY = minY;
+		for (const auto& span : spans)
+		{
+			if (span.x < minX) minX = span.x;
+			if (span.y < minY) minY = span.y;
+			if (span.y > maxY) maxY = span.y;
+			if (span.x + span.width > maxX) maxX = span.x + span.width;
+		}
+		for (const auto& span : outlineSpans)
+		{
+			if (span.x < minX) minX = span.x;
+			if (span.y < minY) minY = span.y;
+			if (span.y > maxY) maxY = span.y;
+			if (span.x + span.width > maxX) maxX = span.x + span.width;
 		}
 
-		return glyphCount ? texSize : 0;
-	}
-
-	void Font::SetMaxCodepoint(uint32 codepoint)
-	{
-		m_maxCodepoint = codepoint;
+		// Shortcut for glyph size. The padding keeps the glyph apart from its neighbors on the atlas.
+		const int32 glyphW = (int32)(maxX - minX) + INTER_GLYPH_PAD_SPACE;
+		const int32 glyphH = (int32)(maxY - minY) + INTER_GLYPH_PAD_SPACE;
 
-		// Resize the glyph page map
-		const uint32 pageCount = (codepoint + GLYPHS_PER_PAGE) / GLYPHS_PER_PAGE;
-		const uint32 size = (pageCount + BITS_PER_UINT - 1) / BITS_PER_UINT;
-		m_glyphPageLoaded.resize(size, 0);
-	}
+		bitmap.width = static_cast<uint32>(glyphW);
+		bitmap.height = static_cast<uint32>(glyphH);
+		bitmap.pixels.assign(bitmap.width * bitmap.height, 0);
 
-	void Font::Rasterize(uint32 startCodepoint, uint32 endCodepoint)
-	{
-		GlyphMap::const_iterator start = m_glyphMap.lower_bound(startCodepoint);
-		if (start == m_glyphMap.end())
-			return;
+		// Spans are rendered from right to left, bottom to top
+		const auto getPixel = [&](const Span& s) -> uint32*
+		{
+			const int bufferX = (s.x - minX) + s.width;
+			const int bufferY = (glyphH - static_cast<int32>(INTER_GLYPH_PAD_SPACE)) - (s.y - minY);
+			return bitmap.pixels.data() + bufferY * glyphW + bufferX;
+		};
 
-		GlyphMap::const_iterator origStart = start;
-		GlyphMap::const_iterator end = m_glyphMap.upper_bound(endCodepoint);
-		while (true)
+		if (m_outlineWidth > 0.0f)
 		{
-			// Create a new imageset for glyphs, so calculate how much texture size we will need
-			uint32 texSize = GetTextureSize(start, end);
-			if (!texSize)
-				break;	// If all glyphs were already rendered, do nothing
-
-			// Create the imageset
-			m_imageSets.emplace_back(FontImageset());
-			FontImageset* imageSet = &m_imageSets.back();
-
-			// Create a memory buffer where the glyphs will be rendered and initialize it to 0
-			std::vector<uint32> mem;
-			mem.resize(texSize * texSize, 0);
-
-			// Go ahead, line by line, top-left to bottom-right
-			uint32 x = INTER_GLYPH_PAD_SPACE, y = INTER_GLYPH_PAD_SPACE;
-			uint32 yb = INTER_GLYPH_PAD_SPACE;
-
-			// Set to true when we finish rendering all glyphs we were asked to
-			bool finished = false;
-			// Set to false when we reach m_glyphMap.end() and we start going backward
-			bool forward = true;
-
-			// To converve texture space we will render more glyphs than asked, but never
-			// less than asked. First we render all glyphs from start to end.
-			// After that, we render glyphs until we reach m_glyphMap.end(), and if there
-			// is still free texture space we will go backward from start, until we hit 
-			// m_glyphMap.begin()
-			while (start != m_glyphMap.end())
+			// Loop over the outline spans and just draw them into the image.
+			for (Spans::iterator s = outlineSpans.begin(); s != outlineSpans.end(); ++s)
 			{
-				// Check if we finished rendering all the required glyphs
-				finished |= (start == end);
-
-				// Check if glyph already rendered
-				if (!start->second.GetImage())
+				uint32* buffer = getPixel(*s);
+				for (int w = 0; w < s->width; ++w)
 				{
-					// Render the glyph
-					if (FT_Load_Char(m_fontFace.get(), start->first, FT_LOAD_NO_BITMAP | FT_LOAD_FORCE_AUTOHINT | FT_LOAD_TARGET_NORMAL))
-					{
-						// Error while rendering the glyph - use an empty image for this glyph!
-						Rect area;
-						Point offset;
-						FontImage& image = imageSet->DefineImage(area, offset);
-						((FontGlyph&)start->second).SetImage(&image);
-					}
-					else
-					{
-						if (m_fontFace->glyph->format != FT_GLYPH_FORMAT_OUTLINE)
-						{
-							// Error while rendering the glyph - use an empty image for this glyph!
-							Rect area;
-							Point offset;
-							FontImage& image = imageSet->DefineImage(area, offset);
-							((FontGlyph&)start->second).SetImage(&image);
-						}
-						else
-						{
-							// Render normal glyph spans
-							Spans spans;
-							RenderSpans(s_freeTypeLib, &m_fontFace->glyph->outline, &spans);
-
-							// Next we need the spans for the outline.
-							Spans outlineSpans;
-							if (m_outlineWidth > 0.0f)
-							{
-								FT_Stroker stroker;
-								FT_Stroker_New(s_freeTypeLib, &stroker);
-								FT_Stroker_Set(stroker, (int)(m_outlineWidth * 64.0f), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
-
-								FT_Glyph glyph;
-								if (FT_Get_Glyph(m_fontFace->glyph, &glyph) == 0)
-								{
-									FT_Glyph_StrokeBorder(&glyph, stroker, 0, 1);
-									// Again, this needs to be an outline to work.
-									if (glyph->format == FT_GLYPH_FORMAT_OUTLINE)
-									{
-										// Render the outline spans to the span list
-										FT_Outline *o =
-											&reinterpret_cast<FT_OutlineGlyph>(glyph)->outline;
-										RenderSpans(s_freeTypeLib, o, &outlineSpans);
-									}
-
-									// Clean up afterwards.
-									FT_Stroker_Done(stroker);
-									FT_Done_Glyph(glyph);
-								}
-							}
-
-							// Now we need to put it all together.
-							if (spans.empty())
-							{
-								// Error while rendering the glyph - use an empty image for this glyph!
-								Rect area;
-								Point offset;
-								FontImage& image = imageSet->DefineImage(area, offset);
-								((FontGlyph&)start->second).SetImage(&image);
-							}
-							else
-							{
-								// Calculate glyph bounds
-								int minX = spans.front().x;
-								int maxX = minX;
-								int minY = spans.front().y;
-								int maxY = minY;
-								for (const auto& span : spans)
-								{
-									if (span.x < minX) minX = span.x;
-									if (span.y < minY) minY = span.y;
-									if (span.y > maxY) maxY = span.y;
-									if (span.x + span.width > maxX) maxX = span.x + span.width;
-								}
-								for (const auto& span : outlineSpans)
-								{
-									if (span.x < minX) minX = span.x;
-									if (span.y < minY) minY = span.y;
-									if (span.y > maxY) maxY = span.y;
-									if (span.x + span.width > maxX) maxX = span.x + span.width;
-								}
-
-								// Shortcut for glyph size
-								const int32 glyphW = (int32)(maxX - minX) + INTER_GLYPH_PAD_SPACE;
-								const int32 glyphH = (int32)(maxY - minY) + INTER_GLYPH_PAD_SPACE;
-
-								// Check if glyph right margin does not exceed texture size
-								uint32 xNext = x + glyphW;
-								if (xNext > texSize)
-								{
-									x = INTER_GLYPH_PAD_SPACE;
-									xNext = x + glyphW;
-									y = yb;
-								}
-
-								// Check if glyph bottom margin does not exceed texture size
-								uint32 yBot = y + glyphH;
-								if (yBot > texSize)
-									break;
-
-								if (m_outlineWidth > 0.0f)
-								{
-									// Loop over the outline spans and just draw them into the image.
-									for (Spans::iterator s = outlineSpans.begin(); s != outlineSpans.end(); ++s)
-									{
-										const int bufferX = (int)x + (s->x - minX) + s->width;
-										const int bufferY = (int)((int)y + (int)glyphH - (s->y - minY));
-										if (bufferX < static_cast<std::int32_t>(texSize) && bufferY >= 0 && bufferX - s->width >= 0 && bufferY < static_cast<std::int32_t>(texSize))
-										{
-											uint32* buffer = mem.data() + bufferY * static_cast<std::int32_t>(texSize) + bufferX;
-											for (int w = 0; w < s->width; ++w)
-											{
-												*buffer-- = Pixel32(0, 0, 0, s->coverage).integer;
-											}
-										}
-									}
-
-									// Then loop over the regular glyph spans and blend them into the image.
-									for (Spans::iterator s = spans.begin(); s != spans.end(); ++s)
-									{
-										const int bufferX = (int)x + (s->x - minX) + s->width;
-										const int bufferY = (int)((int)y + (int)glyphH - (s->y - minY));
-										if (bufferX < static_cast<std::int32_t>(texSize) && bufferY >= 0 && bufferX - s->width >= 0 && bufferY < static_cast<std::int32_t>(texSize))
-										{
-											uint32* buffer = mem.data() + bufferY * static_cast<int32>(texSize) + bufferX;
-
-											for (int w = 0; w < s->width; ++w)
-											{
-												Pixel32 &dst = (Pixel32&)*buffer--;
-												Pixel32 src = Pixel32(255, 255, 255, s->coverage);
-												dst.r = (int)(dst.r + ((src.r - dst.r) * src.a) / 255.0f);
-												dst.g = (int)(dst.g + ((src.g - dst.g) * src.a) / 255.0f);
-												dst.b = (int)(dst.b + ((src.b - dst.b) * src.a) / 255.0f);
-												dst.a = std::min(255, dst.a + src.a);
-											}
-										}
-									}
-								}
-								else
-								{
-									// No outline, just render the spans
-									for (Spans::iterator s = spans.begin(); s != spans.end(); ++s)
-									{
-										const int bufferX = (int)x + (s->x - minX) + s->width;
-										const int bufferY = (int)((int)y + (int)glyphH - (s->y - minY));
-										if (bufferX < static_cast<std::int32_t>(texSize) && bufferY >= 0 && bufferX - s->width >= 0 && bufferY < static_cast<std::int32_t>(texSize))
-										{
-											uint32* buffer = mem.data() + bufferY * static_cast<std::int32_t>(texSize) + bufferX;
-											for (int w = 0; w < s->width; ++w)
-											{
-												*buffer-- = Pixel32(255, 255, 255, s->coverage).integer;
-											}
-										}
-									}
-								}
-
-								Rect area(
-									static_cast<float>(x),
-									static_cast<float>(y + INTER_GLYPH_PAD_SPACE),
-									static_cast<float>(x + glyphW),
-									static_cast<float>(y + glyphH + INTER_GLYPH_PAD_SPACE));
-								Point offset(
-									m_fontFace->glyph->metrics.horiBearingX * FT_POS_COEF,
-									-m_fontFace->glyph->metrics.horiBearingY * FT_POS_COEF + m_descender);
-
-								FontImage& image = imageSet->DefineImage(area, offset);
-								((FontGlyph&)start->second).SetImage(&image);
-
-								// Advance to next position
-								x = xNext;
-								if (yBot > yb)
-								{
-									yb = yBot;
-								}
-							}
-						}
-
-					}
+					*buffer-- = Pixel32(0, 0, 0, s->coverage).integer;
 				}
+			}
 
-				// Go to next glyph if we are going forward
-				if (forward)
+			// Then loop over the regular glyph spans and blend them into the image.
+			for (Spans::iterator s = spans.begin(); s != spans.end(); ++s)
+			{
+				uint32* buffer = getPixel(*s);
+				for (int w = 0; w < s->width; ++w)
 				{
-					if (++start == m_glyphMap.end())
-					{
-						finished = true;
-						forward = false;
-						start = origStart;
-					}
+					Pixel32 &dst = (Pixel32&)*buffer--;
+					Pixel32 src = Pixel32(255, 255, 255, s->coverage);
+					dst.r = (int)(dst.r + ((src.r - dst.r) * src.a) / 255.0f);
+					dst.g = (int)(dst.g + ((src.g - dst.g) * src.a) / 255.0f);
+					dst.b = (int)(dst.b + ((src.b - dst.b) * src.a) / 255.0f);
+					dst.a = std::min(255, dst.a + src.a);
 				}
-
-				// Go to previous glyph if we are going backward
-				if (!forward)
+			}
+		}
+		else
+		{
+			// No outline, just render the spans
+			for (Spans::iterator s = spans.begin(); s != spans.end(); ++s)
+			{
+				uint32* buffer = getPixel(*s);
+				for (int w = 0; w < s->width; ++w)
 				{
-					if ((start == m_glyphMap.begin()) || (--start == m_glyphMap.end()))
-						break;
+					*buffer-- = Pixel32(255, 255, 255, s->coverage).integer;
 				}
 			}
+		}
 
-			// Manually create texture
-			auto texture = GraphicsDevice::Get().CreateTexture(texSize, texSize);
-			texture->LoadRaw(&mem[0], mem.size() * sizeof(uint32));
-			imageSet->SetTexture(texture);
+		bitmap.offset = Point(
+			m_fontFace->glyph->metrics.horiBearingX * FT_POS_COEF,
+			-m_fontFace->glyph->metrics.horiBearingY * FT_POS_COEF + m_descender);
 
-			// Check if finished
-			if (finished)
-				break;
+		return true;
+	}
+
+	void Font::OnGlyphEvicted(uint32 codepoint)
+	{
+		const auto it = m_glyphMap.find(codepoint);
+		if (it != m_glyphMap.end())
+		{
+			it->second.ResetImage();
 		}
 	}
 
@@ -563,24 +411,150 @@ namespace mmo
 
 	const FontGlyph * Font::GetGlyphData(uint32 codepoint)
 	{
-		if (codepoint > m_maxCodepoint)
+		// Find the glyph data or load it if the glyph is used for the first time
+		FontGlyph* glyph = nullptr;
+		if (const auto it = m_glyphMap.find(codepoint); it != m_glyphMap.end())
+		{
+			glyph = &it->second;
+		}
+		else if (!(glyph = LoadGlyph(codepoint)))
+		{
 			return nullptr;
+		}
 
-		// First see if the glyph data is already rasterized
-		const uint32 page = codepoint / GLYPHS_PER_PAGE;
-		const uint32 mask = 1 << (page & (BITS_PER_UINT - 1));
-		if (!(m_glyphPageLoaded[page / BITS_PER_UINT] & mask))
+		// Rasterize the glyph if it hasn't been rasterized yet or if it has been evicted from the atlas
+		if (const FontImage* image = glyph->GetImage())
+		{
+			m_atlas.MarkUsed(*image);
+		}
+		else
 		{
-			// Not yet rasterized, so do it now and remember that we did it
-			m_glyphPageLoaded[page / BITS_PER_UINT] |= mask;
-			Rasterize(
-				codepoint & ~(GLYPHS_PER_PAGE - 1),
-				codepoint | (GLYPHS_PER_PAGE - 1));
+			RasterizeGlyph(codepoint, *glyph);
 		}
 
-		// Fint the glyph data
-		auto it = m_glyphMap.find(codepoint);
-		return (it != m_glyphMap.end()) ? &it->second : nullptr;
+		return glyph;
+	}
+
+	void Font::PreloadGlyphs(uint32 startCodepoint, uint32 endCodepoint)
+	{
+		for (uint32 codepoint = startCodepoint; codepoint <= endCodepoint && codepoint >= startCodepoint; ++codepoint)
+		{
+			GetGlyphData(codepoint);
+		}
+
+		m_atlas.Flush();
+	}
+
+	void Font::EnableGlyphCache(const std::string& directory)
+	{
+		// Identify the cache file by everything that changes the rasterized pixels
+		std::ostringstream strm;
+		strm << directory << "/";
+		sha1PrintHex(strm, sha1(reinterpret_cast<const char*>(m_fileData.data()), m_fileData.size()));
+		strm << "_" << m_pointSize << "_" << m_outlineWidth << ".glyphs";
+		m_glyphCacheFile = strm.str();
+
+		m_cachedGlyphs.clear();
+		m_glyphCacheModified = false;
+
+		const auto file = AssetRegistry::OpenFile(m_glyphCacheFile);
+		if (!file)
+		{
+			return;
+		}
+
+		io::StreamSource source(*file);
+		io::Reader reader(source);
+
+		uint32 revision = 0, glyphCount = 0;
+		if (!(reader >> io::read<uint32>(revision) >> io::read<uint32>(glyphCount)) || revision != GLYPH_CACHE_REVISION)
+		{
+			WLOG("Ignoring outdated glyph cache file " << m_glyphCacheFile);
+			return;
+		}
+
+		for (uint32 i = 0; i < glyphCount; ++i)
+		{
+			uint32 codepoint = 0;
+			uint16 width = 0, height = 0;
+			FontGlyphBitmap bitmap;
+			if (!(reader >> io::read<uint32>(codepoint) >> io::read<uint16>(width) >> io::read<uint16>(height) >> io::read<float>(bitmap.offset.x) >> io::read<float>(bitmap.offset.y)))
+			{
+				break;
+			}
+
+			bitmap.width = width;
+			bitmap.height = height;
+			bitmap.pixels.resize(bitmap.width * bitmap.height);
+			const size_t pixelSize = bitmap.pixels.size() * sizeof(uint32);
+			if (reader.getSource()->read(reinterpret_cast<char*>(bitmap.pixels.data()), pixelSize) != pixelSize)
+			{
+				reader.setFailure();
+				break;
+			}
+
+			m_cachedGlyphs[codepoint] = std::move(bitmap);
+		}
+
+		// Don't use a damaged cache file
+		if (!reader)
+		{
+			WLOG("Glyph cache file " << m_glyphCacheFile << " is damaged and will be rebuilt");
+			m_cachedGlyphs.clear();
+		}
+	}
+
+	void Font::SaveGlyphCache()
+	{
+		if (m_glyphCacheFile.empty() || !m_glyphCacheModified)
+		{
+			return;
+		}
+
+		const auto file = AssetRegistry::CreateNewFile(m_glyphCacheFile);
+		if (!file)
+		{
+			WLOG("Unable to write glyph cache file " << m_glyphCacheFile);
+			return;
+		}
+
+		// Glyphs which haven't been used since the cache file was loaded, and glyphs which are on the atlas. Glyphs
+		// which have been evicted from the atlas are rasterized again next time.
+		std::map<uint32, FontGlyphBitmap> glyphs = m_cachedGlyphs;
+		for (const auto& [codepoint, glyph] : m_glyphMap)
+		{
+			const FontImage* image = glyph.GetImage();
+			if (!image || glyphs.find(codepoint) != glyphs.end())
+			{
+				continue;
+			}
+
+			FontGlyphBitmap& bitmap = glyphs[codepoint];
+			if (image != &m_emptyImage && m_atlas.CopyPixels(*image, bitmap.pixels))
+			{
+				const Rect& area = image->GetSourceTextureArea();
+				bitmap.width = static_cast<uint32>(area.GetWidth());
+				bitmap.height = static_cast<uint32>(area.GetHeight());
+				bitmap.offset = image->GetRenderOffset();
+			}
+		}
+
+		io::StreamSink sink(*file);
+		io::Writer writer(sink);
+
+		writer << io::write<uint32>(GLYPH_CACHE_REVISION) << io::write<uint32>(glyphs.size());
+		for (const auto& [codepoint, bitmap] : glyphs)
+		{
+			writer
+				<< io::write<uint32>(codepoint)
+				<< io::write<uint16>(bitmap.width)
+				<< io::write<uint16>(bitmap.height)
+				<< io::write<float>(bitmap.offset.x)
+				<< io::write<float>(bitmap.offset.y);
+			writer.Sink().Write(reinterpret_cast<const char*>(bitmap.pixels.data()), bitmap.pixels.size() * sizeof(uint32));
+		}
+
+		m_glyphCacheModified = false;
 	}
 
 	void Font::DrawText(const std::string & text, const Point & position, GeometryBuffer& buffer, float scale, argb_t color)
@@ -609,7 +583,7 @@ namespace mmo
 			if ((glyph = GetGlyphData(g)))
 			{
 				const FontImage* const image = glyph->GetImage();
-				glyphPos.y = baseY - (image->GetOffsetY() - image->GetOffsetY() * scale) + 4;
+				glyphPos.y = baseY - (image->GetOffsetY() - image->GetOffsetY() * scale) + GlyphOffsetY;
 
 				// Draw drop shadow?
 				if (m_shadowX != 0.0f || m_shadowY != 0.0f)
@@ -625,66 +599,78 @@ namespace mmo
 				}
 			}
 		}
+
+		// Upload newly rasterized glyphs
+		m_atlas.Flush();
 	}
 
 	int Font::DrawText(const std::string& text, const Rect& area, GeometryBuffer* buffer, float scale, argb_t color)
 	{
-		int lineCount = 1;
-		
-		const float height = GetHeight(scale);
-		const float baseline = GetBaseline(scale);
-		const Point position = area.GetPosition();
+		const TextLayout& layout = GetTextLayout(text, area.GetWidth(), scale, TextWrapping::Character);
+		if (buffer)
+		{
+			DrawTextLayout(layout, area.GetPosition(), *buffer, color);
+		}
 
-		float baseY = position.y + baseline;
-		Point glyphPos(position);
+		return static_cast<int>(layout.GetLineCount());
+	}
 
-		for (size_t c = 0; c < text.length(); ++c)
+	const TextLayout& Font::GetTextLayout(const std::string& text, float width, float scale, TextWrapping wrapping)
+	{
+		return m_layoutCache.Get(*this, text, width, scale, wrapping);
+	}
+
+	void Font::DrawTextLayout(const TextLayout& layout, const Point& position, GeometryBuffer& buffer, argb_t color)
+	{
+		AppendLayoutGlyphs(layout, 0, static_cast<uint32>(layout.GetGlyphs().size()), position, buffer, color);
+
+		// Upload newly rasterized glyphs
+		m_atlas.Flush();
+	}
+
+	void Font::DrawTextLayoutLine(const TextLayout& layout, uint32 lineIndex, const Point& position, GeometryBuffer& buffer, argb_t color)
+	{
+		ASSERT(lineIndex < layout.GetLineCount());
+
+		const TextLayoutLine& line = layout.GetLines()[lineIndex];
+		AppendLayoutGlyphs(layout, line.firstGlyph, line.glyphCount, position, buffer, color);
+
+		// Upload newly rasterized glyphs
+		m_atlas.Flush();
+	}
+
+	void Font::AppendLayoutGlyphs(const TextLayout& layout, uint32 firstGlyph, uint32 glyphCount, const Point& position, GeometryBuffer& buffer, argb_t color)
+	{
+		const float scale = layout.GetScale();
+		const bool hasShadow = m_shadowX != 0.0f || m_shadowY != 0.0f;
+
+		const TextLayoutGlyph* glyphs = layout.GetGlyphs().data() + firstGlyph;
+		for (uint32 i = 0; i < glyphCount; ++i)
 		{
-			size_t iterations = 1;
+			const TextLayoutGlyph& layoutGlyph = glyphs[i];
 
-			char g = text[c];
-			if (g == '\t')
+			// The glyph needs to be rasterized again if it has been removed from the atlas in the meantime
+			const FontImage* image = layoutGlyph.glyph->GetImage();
+			if (image)
 			{
-				g = ' ';
-				iterations = 4;
+				m_atlas.MarkUsed(*image);
 			}
-			else if(g == '\n')
+			else
 			{
-				++lineCount;
-				glyphPos.x = position.x;
-				baseY += height;
-				continue;
+				image = GetGlyphData(layoutGlyph.codepoint)->GetImage();
 			}
 
-			const FontGlyph* glyph = nullptr;
-			if ((glyph = GetGlyphData(g)))
-			{
-				const FontImage* const image = glyph->GetImage();
-				glyphPos.y = baseY - (image->GetOffsetY() - image->GetOffsetY() * scale) + 4;
-
-				if (buffer) 
-				{
-					// Draw drop shadow?
-					if (m_shadowX != 0.0f || m_shadowY != 0.0f)
-					{
-						image->Draw(glyphPos + Point(m_shadowX, m_shadowY), glyph->GetImage()->GetSize() * scale, *buffer, 0xFF000000);
-					}
-
-					image->Draw(glyphPos, glyph->GetImage()->GetSize() * scale, *buffer, color);
-				}
-
-				glyphPos.x += glyph->GetAdvance(scale) * iterations;
+			const Point glyphPos = position + layoutGlyph.position;
+			const Size size = image->GetSize() * scale;
 
-				if (glyphPos.x >= area.right)
-				{
-					glyphPos.x = position.x;
-					baseY += height;
-					++lineCount;
-				}
+			// Draw drop shadow?
+			if (hasShadow)
+			{
+				image->Draw(glyphPos + Point(m_shadowX, m_shadowY), size, buffer, 0xFF000000);
 			}
-		}
 
-		return lineCount;
+			image->Draw(glyphPos, size, buffer, color);
+		}
 	}
 
 	int Font::GetLineCount(const std::string& text, const Rect& area, float scale, bool wordWrap)
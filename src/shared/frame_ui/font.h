@@ -2,10 +2,12 @@
 
 #pragma once
 
+#include "font_atlas.h"
 #include "font_glyph.h"
 #include "font_imageset.h"
 #include "point.h"
 #include "color.h"
+#include "text_layout.h"
 
 #include "base/typedefs.h"
 
@@ -24,16 +26,24 @@ namespace mmo
 
 	/// This class is used to load a font from a true type font file. It utilizes the freetype
 	/// library to do this. It can also be used to measure text width and queue geometry for 
-	/// drawing text to a GeometryBuffer object.
+	/// drawing text to a GeometryBuffer object. Glyphs are rasterized the first time they are
+	/// used and packed into a FontAtlas.
 	class Font
 	{
 		/// A map that contains infos about loaded glyphs.
 		typedef std::map<uint32, FontGlyph> GlyphMap;
 
+	public:
+		/// Vertical offset in pixels which is added to the position of every glyph. Text has always been
+		/// drawn this much below the baseline, and all text rendering keeps it so text doesn't move.
+		static constexpr float GlyphOffsetY = 4.0f;
+
 	public:
 
 		/// Default constructor. Eventually initializes the freetype library.
-		Font();
+		/// @param atlasPageSize Width and height of the glyph texture pages in pixels.
+		/// @param maxAtlasPageCount Maximum number of glyph texture pages before pages are reused.
+		explicit Font(uint32 atlasPageSize = FontAtlas::DefaultPageSize, uint32 maxAtlasPageCount = FontAtlas::DefaultMaxPageCount);
 		/// Destructor. Eventually terminates the freetype library.
 		~Font();
 
@@ -93,21 +103,27 @@ namespace mmo
 		/// Performs internal initialization.
 		bool InitializeInternal();
 
-		/// Calculates the required texture size to display the given glyphs.
-		/// @param start The start codepoint.
-		/// @param end The end codepoint.
-		/// @return The required texture size (textures are expected to be squared, so width == height).
-		uint32 GetTextureSize(GlyphMap::const_iterator start, GlyphMap::const_iterator end) const;
+		/// Loads the metrics of a glyph which hasn't been used before.
+		/// @param codepoint The codepoint of the glyph.
+		/// @return nullptr if the glyph isn't available in this font.
+		FontGlyph* LoadGlyph(uint32 codepoint);
 
-		/// Sets the maximum supported codepoint and calculates the maximum page count.
-		/// @param codepoint The maximum codepoint value.
-		void SetMaxCodepoint(uint32 codepoint);
+		/// Rasterizes a glyph and adds it to the glyph atlas.
+		/// @param codepoint The codepoint of the glyph.
+		/// @param glyph The glyph which will receive the image.
+		void RasterizeGlyph(uint32 codepoint, FontGlyph& glyph);
 
-		/// Rasterizes the given codepoints, which means that textures will be generated if that
-		/// didn't happen already.
-		/// @param startCodepoint The start codepoint.
-		/// @param endCodepoint The end codepoint.
-		void Rasterize(uint32 startCodepoint, uint32 endCodepoint);
+		/// Renders the pixels of a glyph using freetype.
+		/// @param codepoint The codepoint of the glyph.
+		/// @param bitmap Receives the pixels of the glyph.
+		/// @return false if the glyph has no visible pixels.
+		bool RenderGlyph(uint32 codepoint, FontGlyphBitmap& bitmap);
+
+		/// Called when a glyph has been removed from the glyph atlas.
+		void OnGlyphEvicted(uint32 codepoint);
+
+		/// Appends the geometry of a range of glyphs of a text layout to a geometry buffer.
+		void AppendLayoutGlyphs(const TextLayout& layout, uint32 firstGlyph, uint32 glyphCount, const Point& position, GeometryBuffer& buffer, argb_t color);
 
 	private:
 		// Static freetype callbacks
@@ -125,6 +141,23 @@ namespace mmo
 		/// @return nullptr if the data isn't available in this font.
 		const FontGlyph* GetGlyphData(uint32 codepoint);
 
+		/// Rasterizes all glyphs of a codepoint range right away instead of waiting for them to be used.
+		/// @param startCodepoint The start codepoint.
+		/// @param endCodepoint The end codepoint (inclusive).
+		void PreloadGlyphs(uint32 startCodepoint, uint32 endCodepoint);
+
+		/// Gets the atlas which contains the rasterized glyphs.
+		const FontAtlas& GetAtlas() const { return m_atlas; }
+
+		/// Loads previously rasterized glyphs of this font from a cache file in the given directory
+		/// and keeps all glyphs rasterized from now on, so that they can be saved to the cache file.
+		/// The cache file is identified by the font file contents, the point size and the outline width.
+		/// @param directory The cache directory in the asset registry.
+		void EnableGlyphCache(const std::string& directory);
+
+		/// Writes all glyphs rasterized so far to the cache file, if new glyphs were rasterized.
+		void SaveGlyphCache();
+
 		/// Draws a given text by appending geometry to a given GeometryBuffer object.
 		/// @param text The text to be drawn.
 		/// @param position The position (in pixels) where to draw the text on screen.
@@ -133,8 +166,38 @@ namespace mmo
 		/// @param color The argbv color value.
 		void DrawText(const std::string& text, const Point& position, GeometryBuffer& buffer, float scale = 1.0f, argb_t color = 0xFFFFFFFF);
 
+		/// Draws a given text inside of an area, starting a new line whenever the text reaches the right
+		/// edge of the area. The layout of the text is cached.
+		/// @returns The number of lines of the text.
 		int DrawText(const std::string& text, const Rect& area, GeometryBuffer* buffer, float scale = 1.0f, argb_t color = 0xFFFFFFFF);
 
+		/// Gets the layout of a text from the text layout cache of this font or lays out the text.
+		/// The layout remains valid until the next layout is requested from this font.
+		/// @param text The text to lay out.
+		/// @param width Width of the area the text is rendered in.
+		/// @param scale A scaling factor.
+		/// @param wrapping How lines are split if they don't fit into the width.
+		const TextLayout& GetTextLayout(const std::string& text, float width, float scale = 1.0f, TextWrapping wrapping = TextWrapping::Word);
+
+		/// Draws all lines of a text layout by appending geometry to a given GeometryBuffer object.
+		/// @param layout A layout of this font.
+		/// @param position The position (in pixels) of the top left corner of the layout.
+		/// @param buffer The geometry buffer which will receive the generated geometry.
+		/// @param color The argb color value.
+		void DrawTextLayout(const TextLayout& layout, const Point& position, GeometryBuffer& buffer, argb_t color = 0xFFFFFFFF);
+
+		/// Draws a single line of a text layout by appending geometry to a given GeometryBuffer object.
+		/// @param layout A layout of this font.
+		/// @param lineIndex Index of the line to draw.
+		/// @param position The position (in pixels) of the top left corner of the layout. Glyph positions
+		///        already contain the vertical offset of the line.
+		/// @param buffer The geometry buffer which will receive the generated geometry.
+		/// @param color The argb color value.
+		void DrawTextLayoutLine(const TextLayout& layout, uint32 lineIndex, const Point& position, GeometryBuffer& buffer, argb_t color = 0xFFFFFFFF);
+
+		/// Gets the cache which contains the layouts of recently drawn texts.
+		const TextLayoutCache& GetTextLayoutCache() const { return m_layoutCache; }
+
 		int GetLineCount(const std::string& text, const Rect& area, float scale = 1.0f, bool wordWrap = true);
 
 		void SetShadow(float x, float y) { m_shadowX = x; m_shadowY = y; }
@@ -192,14 +255,20 @@ namespace mmo
 
 		/// A map of loaded glyph data.
 		GlyphMap m_glyphMap;
-		/// The maximum supported codepoint of this font.
-		uint32 m_maxCodepoint;
-		/// The loaded glyph pages.
-		std::vector<uint32> m_glyphPageLoaded;
-		/// The loaded imagesets. An imageset is a texture with image data. An image then is just
-		/// a named area on the texture. In this case, each glyph should have one image that belongs
-		/// to an imageset.
-		std::list<FontImageset> m_imageSets;
+		/// The texture pages with the rasterized glyphs. Each rasterized glyph has an image that
+		/// belongs to one of the pages.
+		FontAtlas m_atlas;
+		/// Image of glyphs without any visible pixels.
+		FontImage m_emptyImage;
+		/// Name of the glyph cache file or empty if glyphs aren't cached.
+		std::string m_glyphCacheFile;
+		/// Glyphs of the glyph cache file which haven't been added to the atlas yet. Entries are released as soon as
+		/// their glyph is on the atlas.
+		std::map<uint32, FontGlyphBitmap> m_cachedGlyphs;
+		/// Whether glyphs have been rasterized since the glyph cache file was loaded.
+		bool m_glyphCacheModified = false;
+		/// Layouts of recently drawn texts. Layouts reference glyphs of the glyph map.
+		TextLayoutCache m_layoutCache;
 	};
 
 	/// A smart pointer typedef for fonts.
@@ -0,0 +1,219 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "font_atlas.h"
+
+#include "base/macros.h"
+#include "graphics/graphics_device.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace mmo
+{
+	FontAtlas::FontAtlas(EvictionHandler evictionHandler, const uint32 pageSize, const uint32 maxPageCount)
+		: m_evictionHandler(std::move(evictionHandler))
+		, m_pageSize(pageSize)
+		, m_maxPageCount(std::max(maxPageCount, 1u))
+	{
+	}
+
+	const FontImage* FontAtlas::AddGlyph(const uint32 codepoint, const FontGlyphBitmap& bitmap)
+	{
+		ASSERT(bitmap.pixels.size() == bitmap.width * bitmap.height);
+
+		if (bitmap.width > m_pageSize || bitmap.height > m_pageSize)
+		{
+			return nullptr;
+		}
+
+		// Look for room on the existing pages first
+		Page* target = nullptr;
+		uint32 x = 0, y = 0;
+		for (auto& page : m_pages)
+		{
+			if (Allocate(page, bitmap.width, bitmap.height, x, y))
+			{
+				target = &page;
+				break;
+			}
+		}
+
+		if (!target)
+		{
+			target = m_pages.size() < m_maxPageCount ? &AddPage() : &EvictLeastRecentlyUsedPage();
+			VERIFY(Allocate(*target, bitmap.width, bitmap.height, x, y));
+		}
+
+		// Copy the glyph pixels onto the page
+		for (uint32 row = 0; row < bitmap.height; ++row)
+		{
+			std::memcpy(
+				target->pixels.data() + (y + row) * m_pageSize + x,
+				bitmap.pixels.data() + row * bitmap.width,
+				bitmap.width * sizeof(uint32));
+		}
+
+		target->codepoints.push_back(codepoint);
+		target->lastUse = ++m_useCounter;
+		target->modified = true;
+
+		const Rect area(
+			static_cast<float>(x),
+			static_cast<float>(y),
+			static_cast<float>(x + bitmap.width),
+			static_cast<float>(y + bitmap.height));
+		return &target->imageset.DefineImage(area, bitmap.offset);
+	}
+
+	void FontAtlas::MarkUsed(const FontImage& image)
+	{
+		if (Page* page = FindPage(image))
+		{
+			page->lastUse = ++m_useCounter;
+		}
+	}
+
+	void FontAtlas::Flush()
+	{
+		for (auto& page : m_pages)
+		{
+			if (page.modified)
+			{
+				Upload(page);
+			}
+		}
+	}
+
+	void FontAtlas::Clear()
+	{
+		m_pages.clear();
+	}
+
+	bool FontAtlas::CopyPixels(const FontImage& image, std::vector<uint32>& pixels) const
+	{
+		const Page* page = FindPage(image);
+		if (!page)
+		{
+			return false;
+		}
+
+		const Rect& area = image.GetSourceTextureArea();
+		const uint32 left = static_cast<uint32>(area.left);
+		const uint32 top = static_cast<uint32>(area.top);
+		const uint32 width = static_cast<uint32>(area.GetWidth());
+		const uint32 height = static_cast<uint32>(area.GetHeight());
+
+		pixels.resize(width * height);
+		for (uint32 row = 0; row < height; ++row)
+		{
+			std::memcpy(
+				pixels.data() + row * width,
+				page->pixels.data() + (top + row) * m_pageSize + left,
+				width * sizeof(uint32));
+		}
+
+		return true;
+	}
+
+	bool FontAtlas::Allocate(Page& page, const uint32 width, const uint32 height, uint32& x, uint32& y) const
+	{
+		// Use the flattest shelf the glyph fits on to waste as little space as possible
+		Shelf* best = nullptr;
+		for (auto& shelf : page.shelves)
+		{
+			if (shelf.height >= height && shelf.usedWidth + width <= m_pageSize && (!best || shelf.height < best->height))
+			{
+				best = &shelf;
+			}
+		}
+
+		if (!best)
+		{
+			// Open a new shelf below the last one
+			const uint32 bottom = page.shelves.empty() ? 0 : page.shelves.back().y + page.shelves.back().height;
+			if (bottom + height > m_pageSize)
+			{
+				return false;
+			}
+
+			best = &page.shelves.emplace_back(Shelf{ bottom, height, 0 });
+		}
+
+		x = best->usedWidth;
+		y = best->y;
+		best->usedWidth += width;
+		return true;
+	}
+
+	FontAtlas::Page& FontAtlas::AddPage()
+	{
+		Page& page = m_pages.emplace_back();
+		page.pixels.resize(m_pageSize * m_pageSize, 0);
+		CreateTexture(page);
+
+		return page;
+	}
+
+	FontAtlas::Page& FontAtlas::EvictLeastRecentlyUsedPage()
+	{
+		ASSERT(!m_pages.empty());
+
+		Page& page = *std::min_element(m_pages.begin(), m_pages.end(), [](const Page& a, const Page& b)
+			{
+				return a.lastUse < b.lastUse;
+			});
+
+		// Geometry which was already generated keeps a reference to the current texture, so it needs to have
+		// all glyphs before the page is reused with a new texture
+		if (page.modified)
+		{
+			Upload(page);
+		}
+
+		for (const uint32 codepoint : page.codepoints)
+		{
+			m_evictionHandler(codepoint);
+		}
+
+		page.codepoints.clear();
+		page.shelves.clear();
+		page.imageset.RemoveAllImages();
+		std::fill(page.pixels.begin(), page.pixels.end(), 0);
+		CreateTexture(page);
+
+		++m_evictionCount;
+		return page;
+	}
+
+	void FontAtlas::CreateTexture(Page& page) const
+	{
+		auto texture = GraphicsDevice::Get().CreateTexture(m_pageSize, m_pageSize, BufferUsage::StaticWriteOnly);
+		texture->LoadRaw(page.pixels.data(), page.pixels.size() * sizeof(uint32));
+		page.imageset.SetTexture(texture);
+	}
+
+	void FontAtlas::Upload(Page& page)
+	{
+		page.imageset.GetTexture()->UpdateFromMemory(page.pixels.data(), page.pixels.size() * sizeof(uint32));
+		page.modified = false;
+	}
+
+	FontAtlas::Page* FontAtlas::FindPage(const FontImage& image)
+	{
+		for (auto& page : m_pages)
+		{
+			if (&page.imageset == image.GetOwner())
+			{
+				return &page;
+			}
+		}
+
+		return nullptr;
+	}
+
+	const FontAtlas::Page* FontAtlas::FindPage(const FontImage& image) const
+	{
+		return const_cast<FontAtlas*>(this)->FindPage(image);
+	}
+}
@@ -0,0 +1,131 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "font_imageset.h"
+#include "point.h"
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+
+#include <functional>
+#include <list>
+#include <vector>
+
+
+namespace mmo
+{
+	/// Contains the pixels of a single rasterized glyph. The bitmap already contains the padding which
+	/// separates the glyph from other glyphs on a texture.
+	struct FontGlyphBitmap
+	{
+		/// Width of the bitmap in pixels.
+		uint32 width = 0;
+		/// Height of the bitmap in pixels.
+		uint32 height = 0;
+		/// Offset which is applied when the glyph is rendered.
+		Point offset;
+		/// Pixel data, row by row.
+		std::vector<uint32> pixels;
+	};
+
+	/// Packs rasterized glyphs of a font onto texture pages. Glyphs are placed on horizontal shelves as they
+	/// are added. If all pages are full, the page that was used least recently is cleared and reused, which
+	/// removes all glyphs on that page from the atlas.
+	class FontAtlas final : public NonCopyable
+	{
+	public:
+		/// Default width and height of a texture page in pixels.
+		static constexpr uint32 DefaultPageSize = 512;
+		/// Default maximum number of texture pages.
+		static constexpr uint32 DefaultMaxPageCount = 8;
+
+		/// Handler which is called for every glyph that has been removed from the atlas.
+		typedef std::function<void(uint32 codepoint)> EvictionHandler;
+
+	public:
+		/// Initializes a new, empty font atlas.
+		/// @param evictionHandler Called for every glyph that is removed because its page is reused.
+		/// @param pageSize Width and height of a texture page in pixels.
+		/// @param maxPageCount Maximum number of texture pages before pages are reused.
+		explicit FontAtlas(EvictionHandler evictionHandler, uint32 pageSize = DefaultPageSize, uint32 maxPageCount = DefaultMaxPageCount);
+
+	public:
+		/// Adds a rasterized glyph to the atlas. This might remove other glyphs from the atlas.
+		/// @param codepoint The codepoint of the glyph.
+		/// @param bitmap The rasterized glyph.
+		/// @returns The image of the glyph or nullptr if the glyph is too big for a texture page.
+		const FontImage* AddGlyph(uint32 codepoint, const FontGlyphBitmap& bitmap);
+
+		/// Marks the page of an image as being used, so that it is not reused any time soon.
+		void MarkUsed(const FontImage& image);
+
+		/// Uploads the pixels of all modified pages to their textures.
+		void Flush();
+
+		/// Removes all glyphs and pages from the atlas without calling the eviction handler.
+		void Clear();
+
+		/// Copies the pixels of an image on the atlas row by row.
+		/// @returns false if the image does not belong to this atlas.
+		bool CopyPixels(const FontImage& image, std::vector<uint32>& pixels) const;
+
+		/// Gets the number of texture pages.
+		[[nodiscard]] size_t GetPageCount() const { return m_pages.size(); }
+
+		/// Gets the number of times a page has been reused.
+		[[nodiscard]] uint32 GetEvictionCount() const { return m_evictionCount; }
+
+	private:
+		/// A row of glyphs on a page.
+		struct Shelf
+		{
+			uint32 y;
+			uint32 height;
+			uint32 usedWidth;
+		};
+
+		/// A texture page with glyphs.
+		struct Page
+		{
+			FontImageset imageset;
+			std::vector<uint32> pixels;
+			std::vector<Shelf> shelves;
+			std::vector<uint32> codepoints;
+			uint64 lastUse = 0;
+			bool modified = false;
+		};
+
+	private:
+		/// Finds a free area for a glyph on a page.
+		/// @returns false if the page has no room left for the glyph.
+		bool Allocate(Page& page, uint32 width, uint32 height, uint32& x, uint32& y) const;
+
+		/// Adds a new page.
+		Page& AddPage();
+
+		/// Clears the page that has been used least recently so that it can be reused.
+		Page& EvictLeastRecentlyUsedPage();
+
+		/// Creates a new texture for a page.
+		void CreateTexture(Page& page) const;
+
+		/// Uploads the pixels of a page to its texture.
+		static void Upload(Page& page);
+
+		/// Finds the page an image belongs to.
+		Page* FindPage(const FontImage& image);
+
+		/// Finds the page an image belongs to.
+		const Page* FindPage(const FontImage& image) const;
+
+	private:
+		EvictionHandler m_evictionHandler;
+		uint32 m_pageSize;
+		uint32 m_maxPageCount;
+		/// Pages are kept in a list, as images reference their imageset.
+		std::list<Page> m_pages;
+		uint64 m_useCounter = 0;
+		uint32 m_evictionCount = 0;
+	};
+}
@@ -28,6 +28,8 @@ namespace mmo
 		/// Sets the image object which is rendered when this glyph is rendered.
 		/// @param image The new image or nullptr to not use an image at all.
 		inline void SetImage(const FontImage* image) { ASSERT(image); m_image = image; }
+		/// Removes the image of this glyph, so that it has to be rasterized again before it can be rendered.
+		inline void ResetImage() { m_image = nullptr; }
 
 	private:
 
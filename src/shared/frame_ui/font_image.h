@@ -38,10 +38,14 @@ namespace mmo
 		inline float GetOffsetX() const { return m_scaledOffset.x; }
 		/// Gets the y coordinate of the start offset of this image in pixels.
 		inline float GetOffsetY() const { return m_scaledOffset.y; }
+		/// Gets the unscaled render offset this image was defined with.
+		inline const Point& GetRenderOffset() const { return m_offset; }
 
 	public:
 		/// A rectangle which describes the source texture area used by this image.
 		const Rect& GetSourceTextureArea() const;
+		/// Gets the imageset this image belongs to or nullptr if this is an empty image.
+		const FontImageset* GetOwner() const { return m_owner; }
 		/// Queues the image to be drawn.
 		/// @param position The position of the image.
 		/// @param size The size with which the image will be drawn.
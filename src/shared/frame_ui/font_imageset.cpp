@@ -22,6 +22,11 @@ namespace mmo
 		return m_images.back();
 	}
 
+	void FontImageset::RemoveAllImages()
+	{
+		m_images.clear();
+	}
+
 	void FontImageset::Draw(const Rect & srcRect, const Rect & dstRect, GeometryBuffer & buffer, argb_t color) const
 	{
 		if (m_texture)
@@ -28,6 +28,10 @@ namespace mmo
 		FontImage& DefineImage(const Point& position, const Size& size, const Point& renderOffset);
 		/// Defines a new named area on this set.
 		FontImage& DefineImage(const Rect& imageRect, const Point& renderOffset);
+		/// Removes all images from this set. References to these images become invalid.
+		void RemoveAllImages();
+		/// Gets the texture of this imageset.
+		const TexturePtr& GetTexture() const { return m_texture; }
 		/// Draws an image from the imageset.
 		void Draw(const Rect& srcRect, const Rect& dstRect, GeometryBuffer& buffer, argb_t color = 0xffffffff) const;
 
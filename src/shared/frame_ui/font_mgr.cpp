@@ -25,6 +25,11 @@ namespace mmo
 		font = std::make_shared<Font>();
 		VERIFY(font->Initialize(filename, size, outline));
 
+		if (!m_glyphCacheDirectory.empty())
+		{
+			font->EnableGlyphCache(m_glyphCacheDirectory);
+		}
+
 		font->SetShadow(shadowX, shadowY);
 
 		m_fontCache[filename][size][outline] = font;
@@ -32,6 +37,20 @@ namespace mmo
 		return font;
 	}
 
+	void FontManager::SaveGlyphCaches()
+	{
+		for (const auto& [filename, fontsBySize] : m_fontCache)
+		{
+			for (const auto& [size, fontsByOutline] : fontsBySize)
+			{
+				for (const auto& [outline, font] : fontsByOutline)
+				{
+					font->SaveGlyphCache();
+				}
+			}
+		}
+	}
+
 	FontPtr FontManager::FindCachedFont(const std::string & filename, float size, float outline, float shadowX, float shadowY) const
 	{
 		const auto cacheIt = m_fontCache.find(filename);
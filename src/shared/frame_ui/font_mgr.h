@@ -36,6 +36,14 @@ namespace mmo
 		/// @param outline Outline width in pixels.
 		FontPtr CreateOrRetrieve(const std::string& filename, float size, float outline = 0.0f, float shadowX = 0.0f, float shadowY = 0.0f);
 
+		/// Enables the glyph cache for all fonts created from now on. Rasterized glyphs are loaded from and
+		/// saved to cache files in the given directory, so they don't need to be rasterized again.
+		/// @param directory The cache directory in the asset registry or an empty string to disable the cache.
+		void SetGlyphCacheDirectory(const std::string& directory) { m_glyphCacheDirectory = directory; }
+
+		/// Saves the glyph cache files of all loaded fonts.
+		void SaveGlyphCaches();
+
 	private:
 		/// Determines whether the given font is already loaded using the given font size.
 		FontPtr FindCachedFont(const std::string& filename, float size, float outline, float shadowX, float shadowY) const;
@@ -46,5 +54,6 @@ namespace mmo
 		typedef std::map<std::string, FontPtrBySize, StrCaseIComp> FontCache;
 
 		FontCache m_fontCache;
+		std::string m_glyphCacheDirectory;
 	};
 }
@@ -199,7 +199,7 @@ namespace mmo
 					if ((glyph = font->GetGlyphData(g)))
 					{
 						const FontImage* const image = glyph->GetImage();
-						glyphPos.y = baseY - (image->GetOffsetY() - image->GetOffsetY() * textScale) + 4;
+						glyphPos.y = baseY - (image->GetOffsetY() - image->GetOffsetY() * textScale) + Font::GlyphOffsetY;
 						glyphPos.x += glyph->GetAdvance(textScale) * iterations;
 
 						if (glyphPos.x >= contentRect.right)
@@ -177,87 +177,6 @@ namespace mmo
 		SetVertAlignmentPropertyName(m_vertAlignPropertyName);
 	}
 
-	void TextComponent::CacheText(const Rect& area)
-	{
-		// Remove line cache
-		m_lineCache.clear();
-
-		// Gets the text that should be displayed for this frame.
-		const std::string& text = m_frame->GetVisualText();
-
-		// Now, split the text in lines depending on formatting
-		std::string::size_type pos = 0;
-		std::string::size_type prev = 0;
-		while ((pos = text.find('\n', prev)) != std::string::npos)
-		{
-			// Capture the line
-			m_lineCache.push_back(text.substr(prev, pos - prev));
-			prev = pos + 1;
-		}
-
-		// Append last line remaining
-		m_lineCache.push_back(text.substr(prev));
-
-		// Apply wrapping to each line and eventually split the lines into even more lines by doing so
-		ApplyWrapping(area);
-	}
-
-	void TextComponent::ApplyWrapping(const Rect& area)
-	{
-		const float textScale = FrameManager::Get().GetUIScale().y;
-		
-		if (area.GetWidth() > 0.0f && !m_lineCache.empty())
-		{
-			const FontPtr font = m_frame->GetFont();
-
-			// Iterate through each line, character per character
-			auto lineIt = m_lineCache.begin();
-			for (auto lineIt = m_lineCache.begin(); lineIt != m_lineCache.end();)
-			{
-				auto line = *lineIt;
-
-				// Check if we needed to wrap and where the last word 
-				bool wrapped = false;
-				size_t lastWordIndex = 0;
-
-				// Check if we need to split the line based on wrapping
-				float offset = area.left;
-				for (size_t i = 0; i < line.length(); ++i)
-				{
-					// Grab line character at the given position
-					const char c = line[i];
-					if (c == ' ')
-					{
-						lastWordIndex = i;
-					}
-
-					const auto* glyph = font->GetGlyphData(c);
-					if (glyph)
-					{
-						offset += glyph->GetAdvance(textScale);
-						if (offset > area.right)
-						{
-							offset = area.left;
-
-							lineIt = m_lineCache.insert(lineIt, line.substr(0, lastWordIndex));
-							lineIt = m_lineCache.erase(lineIt + 1);
-							lineIt = m_lineCache.insert(lineIt, line.substr(lastWordIndex + 1));
-							wrapped = true;
-
-							break;
-						}
-					}
-				}
-
-				// Next line
-				if (!wrapped)
-				{
-					++lineIt;
-				}
-			}
-		}
-	}
-
 	void TextComponent::Render(const Rect& area, const Color& color)
 	{
 		const float textScale = FrameManager::Get().GetUIScale().y;
@@ -271,10 +190,9 @@ namespace mmo
 			// Get frame area rect of this component
 			const Rect frameRect = GetArea(area);
 
-			// TODO: Right now, we get the area passed in the render function. This requires us to
-			// invalidate (or check) the cache every time the component is rendered! It would be better
-			// to have the area as a member variable and change it if needed.
-			CacheText(frameRect);
+			// Line breaks and glyph positions are cached by the font, so unchanged texts are not laid out again
+			const TextLayout& layout = font->GetTextLayout(m_frame->GetVisualText(), frameRect.GetWidth(), textScale, TextWrapping::Word);
+			m_lineCount = layout.GetLineCount();
 
 			// Calculate final text position in component
 			Point position = frameRect.GetPosition();
@@ -289,11 +207,14 @@ namespace mmo
 				position.y += frameRect.GetHeight() - font->GetHeight(textScale);
 			}
 
+			// Apply color multiplication
+			Color c = color;
+			c *= m_color;
+
 			// Now, render each line of text, separately
-			for (const auto& line : m_lineCache)
+			for (uint32 i = 0; i < layout.GetLineCount(); ++i)
 			{
-				// Calculate the text width and cache it for later use
-				const float width = font->GetTextWidth(line, textScale);
+				const float width = layout.GetLines()[i].width;
 
 				// Apply horizontal alignment
 				position.x = frameRect.GetPosition().x;
@@ -306,13 +227,8 @@ namespace mmo
 					position.x += frameRect.GetWidth() - width;
 				}
 
-				// Apply color multiplication
-				Color c = color;
-				c *= m_color;
-
-				// Determine the position to render the font at
-				font->DrawText(line, position, m_frame->GetGeometryBuffer(), textScale, c);
-				position.y += font->GetHeight(textScale);
+				// The glyph positions of the layout already contain the vertical offset of each line
+				font->DrawTextLayoutLine(layout, i, position, m_frame->GetGeometryBuffer(), c);
 			}
 		}
 	}
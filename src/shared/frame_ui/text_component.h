@@ -74,7 +74,7 @@ namespace mmo
 		void SetColor(const Color& color);
 
 		/// Determines the number of lines.
-		inline uint32 GetLineCount() const noexcept { return m_lineCache.size(); }
+		inline uint32 GetLineCount() const noexcept { return m_lineCount; }
 
 		void SetHorzAlignmentPropertyName(std::string propertyName);
 
@@ -84,12 +84,6 @@ namespace mmo
 
 		void OnFrameChanged() override;
 
-	private:
-		/// This function caches some values required for rendering the text using this component's properites.
-		void CacheText(const Rect& area);
-		/// Applies text wrapping to the line cache.
-		void ApplyWrapping(const Rect& frameRect);
-
 	public:
 		// FrameComponent overrides
 		void Render(const Rect& area, const Color& color = Color::White) override;
@@ -101,8 +95,8 @@ namespace mmo
 		HorizontalAlignment m_horzAlignment = HorizontalAlignment::Left;
 		/// 
 		VerticalAlignment m_vertAlignment = VerticalAlignment::Top;
-		/// A cache for text lines with wrapping applied.
-		std::vector<std::string> m_lineCache;
+		/// Number of lines the text was split into when it was rendered the last time.
+		uint32 m_lineCount = 0;
 
 		std::string m_horzAlignPropertyName;
 
@@ -0,0 +1,245 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "text_layout.h"
+#include "font.h"
+
+#include <algorithm>
+#include <functional>
+
+
+namespace mmo
+{
+	TextLayout::TextLayout(Font& font, const std::string& text, const float width, const float scale, const TextWrapping wrapping)
+		: m_scale(scale)
+	{
+		if (wrapping == TextWrapping::Word)
+		{
+			LayoutWords(font, text, width);
+		}
+		else
+		{
+			LayoutCharacters(font, text, width);
+		}
+	}
+
+	void TextLayout::LayoutWords(Font& font, const std::string& text, const float width)
+	{
+		// Split the text in lines depending on formatting
+		std::vector<std::string> lines;
+
+		std::string::size_type pos = 0;
+		std::string::size_type prev = 0;
+		while ((pos = text.find('\n', prev)) != std::string::npos)
+		{
+			lines.push_back(text.substr(prev, pos - prev));
+			prev = pos + 1;
+		}
+
+		lines.push_back(text.substr(prev));
+
+		// Apply wrapping to each line and eventually split the lines into even more lines by doing so
+		if (width > 0.0f)
+		{
+			for (size_t index = 0; index < lines.size(); ++index)
+			{
+				const std::string line = lines[index];
+
+				size_t lastWordIndex = 0;
+				float offset = 0.0f;
+				for (size_t i = 0; i < line.length(); ++i)
+				{
+					const char c = line[i];
+					if (c == ' ')
+					{
+						lastWordIndex = i;
+					}
+
+					const FontGlyph* glyph = font.GetGlyphData(c);
+					if (glyph)
+					{
+						offset += glyph->GetAdvance(m_scale);
+						if (offset > width)
+						{
+							// The remainder is checked again as the next line
+							lines[index] = line.substr(0, lastWordIndex);
+							lines.insert(lines.begin() + index + 1, line.substr(lastWordIndex + 1));
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		// Position the glyphs of each line
+		const float height = font.GetHeight(m_scale);
+		const float baseline = font.GetBaseline(m_scale);
+
+		float lineY = 0.0f;
+		for (const auto& line : lines)
+		{
+			AddLine();
+
+			float x = 0.0f, advance = 0.0f;
+			for (const char c : line)
+			{
+				size_t iterations = 1;
+
+				char g = c;
+				if (g == '\t')
+				{
+					g = ' ';
+					iterations = 4;
+				}
+
+				if (const FontGlyph* glyph = font.GetGlyphData(g))
+				{
+					MeasureGlyph(*glyph, iterations, advance);
+					AddGlyph(g, *glyph, x, lineY + baseline);
+
+					for (size_t i = 0; i < iterations; ++i)
+					{
+						x += glyph->GetAdvance(m_scale);
+					}
+				}
+			}
+
+			lineY += height;
+		}
+	}
+
+	void TextLayout::LayoutCharacters(Font& font, const std::string& text, const float width)
+	{
+		const float height = font.GetHeight(m_scale);
+		float baseY = font.GetBaseline(m_scale);
+		float x = 0.0f, advance = 0.0f;
+
+		AddLine();
+
+		for (const char c : text)
+		{
+			size_t iterations = 1;
+
+			char g = c;
+			if (g == '\t')
+			{
+				g = ' ';
+				iterations = 4;
+			}
+			else if (g == '\n')
+			{
+				x = 0.0f;
+				advance = 0.0f;
+				baseY += height;
+				AddLine();
+				continue;
+			}
+
+			if (const FontGlyph* glyph = font.GetGlyphData(g))
+			{
+				MeasureGlyph(*glyph, iterations, advance);
+				AddGlyph(g, *glyph, x, baseY);
+
+				x += glyph->GetAdvance(m_scale) * iterations;
+				if (x >= width)
+				{
+					x = 0.0f;
+					advance = 0.0f;
+					baseY += height;
+					AddLine();
+				}
+			}
+		}
+	}
+
+	void TextLayout::AddLine()
+	{
+		m_lines.push_back({ static_cast<uint32>(m_glyphs.size()), 0, 0.0f });
+	}
+
+	void TextLayout::AddGlyph(const uint32 codepoint, const FontGlyph& glyph, const float x, const float baseY)
+	{
+		// Glyphs without pixels don't generate any geometry
+		const FontImage* image = glyph.GetImage();
+		if (!image->GetOwner())
+		{
+			return;
+		}
+
+		// Keep the glyph offset of Font::DrawText so laid out text is drawn at the same position
+		const float y = baseY - (image->GetOffsetY() - image->GetOffsetY() * m_scale) + Font::GlyphOffsetY;
+		m_glyphs.push_back({ codepoint, &glyph, Point(x, y) });
+		m_lines.back().glyphCount++;
+	}
+
+	void TextLayout::MeasureGlyph(const FontGlyph& glyph, const size_t iterations, float& advance)
+	{
+		TextLayoutLine& line = m_lines.back();
+
+		const float renderedWidth = glyph.GetRenderedAdvance(m_scale);
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			line.width = std::max(line.width, advance + renderedWidth);
+			advance += glyph.GetAdvance(m_scale);
+		}
+
+		line.width = std::max(line.width, advance);
+	}
+
+	TextLayoutCache::TextLayoutCache(const size_t capacity)
+		: m_capacity(std::max<size_t>(capacity, 1))
+	{
+	}
+
+	const TextLayout& TextLayoutCache::Get(Font& font, const std::string& text, const float width, const float scale, const TextWrapping wrapping)
+	{
+		size_t hash = std::hash<std::string>()(text);
+		const auto combine = [&hash](const size_t value)
+		{
+			hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		};
+		combine(std::hash<float>()(width));
+		combine(std::hash<float>()(scale));
+		combine(static_cast<size_t>(wrapping));
+
+		const auto [first, last] = m_entriesByHash.equal_range(hash);
+		for (auto it = first; it != last; ++it)
+		{
+			const Entry& entry = *it->second;
+			if (entry.width == width && entry.scale == scale && entry.wrapping == wrapping && entry.text == text)
+			{
+				// Move the entry to the front as it is the most recently used one now
+				m_entries.splice(m_entries.begin(), m_entries, it->second);
+				return entry.layout;
+			}
+		}
+
+		m_entries.push_front(Entry{ hash, text, width, scale, wrapping, TextLayout(font, text, width, scale, wrapping) });
+		m_entriesByHash.emplace(hash, m_entries.begin());
+
+		// Remove the least recently used entry
+		if (m_entries.size() > m_capacity)
+		{
+			const auto oldest = std::prev(m_entries.end());
+
+			const auto [oldestFirst, oldestLast] = m_entriesByHash.equal_range(oldest->hash);
+			for (auto it = oldestFirst; it != oldestLast; ++it)
+			{
+				if (it->second == oldest)
+				{
+					m_entriesByHash.erase(it);
+					break;
+				}
+			}
+
+			m_entries.erase(oldest);
+		}
+
+		return m_entries.front().layout;
+	}
+
+	void TextLayoutCache::Clear()
+	{
+		m_entriesByHash.clear();
+		m_entries.clear();
+	}
+}
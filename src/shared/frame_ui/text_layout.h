@@ -0,0 +1,145 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "point.h"
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace mmo
+{
+	class Font;
+	class FontGlyph;
+
+	/// Enumerates the ways a text is split into lines when it doesn't fit into the available width.
+	enum class TextWrapping : uint8
+	{
+		/// Lines are split at the last space before the line gets too wide. Text components use this.
+		Word,
+		/// Lines are split right after the glyph which reached the end of the line.
+		Character
+	};
+
+	/// A glyph of a text layout, positioned relative to the origin of the layout.
+	struct TextLayoutGlyph
+	{
+		/// The codepoint of the glyph, used to rasterize the glyph again if it was removed from the atlas.
+		uint32 codepoint;
+		/// The glyph data. Glyph data stays valid until the font is initialized again.
+		const FontGlyph* glyph;
+		/// Position at which the image of the glyph is drawn.
+		Point position;
+	};
+
+	/// A line of a text layout.
+	struct TextLayoutLine
+	{
+		/// Index of the first glyph of the line.
+		uint32 firstGlyph;
+		/// Number of glyphs in the line.
+		uint32 glyphCount;
+		/// Width of the line in pixels.
+		float width;
+	};
+
+	/// Contains the result of splitting a text into lines and positioning its glyphs, so that geometry
+	/// can be generated without looking at the text again. Glyphs without visible pixels, like spaces,
+	/// are not part of the layout.
+	class TextLayout final
+	{
+	public:
+		/// Lays out a text.
+		/// @param font The font used to render the text.
+		/// @param text The text.
+		/// @param width Width of the area the text is rendered in. Words aren't wrapped if the width is zero or less.
+		/// @param scale The scale at which the text is rendered.
+		/// @param wrapping How lines are split if they don't fit into the width.
+		explicit TextLayout(Font& font, const std::string& text, float width, float scale, TextWrapping wrapping);
+
+	public:
+		/// Gets all lines of the layout.
+		const std::vector<TextLayoutLine>& GetLines() const { return m_lines; }
+
+		/// Gets all glyphs of the layout.
+		const std::vector<TextLayoutGlyph>& GetGlyphs() const { return m_glyphs; }
+
+		/// Gets the number of lines.
+		uint32 GetLineCount() const { return static_cast<uint32>(m_lines.size()); }
+
+		/// Gets the scale the text was laid out for.
+		float GetScale() const { return m_scale; }
+
+	private:
+		/// Splits the text into lines at line breaks and the last space which fits into the width.
+		void LayoutWords(Font& font, const std::string& text, float width);
+
+		/// Splits the text into lines at line breaks and after the glyph which reaches the end of the width.
+		void LayoutCharacters(Font& font, const std::string& text, float width);
+
+		/// Starts a new, empty line.
+		void AddLine();
+
+		/// Adds a glyph to the current line.
+		void AddGlyph(uint32 codepoint, const FontGlyph& glyph, float x, float baseY);
+
+		/// Extends the width of the current line by a glyph.
+		void MeasureGlyph(const FontGlyph& glyph, size_t iterations, float& advance);
+
+	private:
+		std::vector<TextLayoutLine> m_lines;
+		std::vector<TextLayoutGlyph> m_glyphs;
+		float m_scale;
+	};
+
+	/// Keeps the layouts of recently rendered texts of a font, so that texts which are rendered over and
+	/// over again don't need to be split into lines and measured every time. If the cache is full, the
+	/// layout which has been used least recently is removed.
+	class TextLayoutCache final : public NonCopyable
+	{
+	public:
+		/// Default maximum number of layouts in the cache.
+		static constexpr size_t DefaultCapacity = 512;
+
+	public:
+		/// Initializes a new, empty text layout cache.
+		/// @param capacity Maximum number of layouts in the cache.
+		explicit TextLayoutCache(size_t capacity = DefaultCapacity);
+
+	public:
+		/// Gets the layout of a text from the cache or lays out the text if it isn't cached yet.
+		/// The layout remains valid until the next call of this method or until the cache is cleared.
+		const TextLayout& Get(Font& font, const std::string& text, float width, float scale, TextWrapping wrapping);
+
+		/// Removes all layouts. This needs to happen whenever the glyphs of the font change.
+		void Clear();
+
+		/// Gets the number of cached layouts.
+		size_t GetSize() const { return m_entries.size(); }
+
+	private:
+		struct Entry
+		{
+			size_t hash;
+			std::string text;
+			float width;
+			float scale;
+			TextWrapping wrapping;
+			TextLayout layout;
+		};
+
+		typedef std::list<Entry> EntryList;
+
+	private:
+		size_t m_capacity;
+		/// Entries ordered by their last use, most recently used entry first.
+		EntryList m_entries;
+		std::unordered_multimap<size_t, EntryList::iterator> m_entriesByHash;
+	};
+}
@@ -0,0 +1,276 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "compact_movement.h"
+
+#include "math/constants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mmo
+{
+	namespace
+	{
+		int32 QuantizePosition(const float value)
+		{
+			const double scaled = std::round(static_cast<double>(value) * CompactMovementPositionScale);
+			return static_cast<int32>(std::clamp<double>(scaled, std::numeric_limits<int32>::min(), std::numeric_limits<int32>::max()));
+		}
+
+		uint16 QuantizeFacing(const float value)
+		{
+			float wrapped = std::fmod(value, TwoPi);
+			if (wrapped < 0.0f)
+			{
+				wrapped += TwoPi;
+			}
+
+			// Rounding up to a full turn wraps around to 0
+			return static_cast<uint16>(static_cast<uint32>(std::lround(wrapped / TwoPi * 65536.0f)) & 0xffff);
+		}
+
+		int16 QuantizePitch(const float value)
+		{
+			return static_cast<int16>(std::lround(std::clamp(value, -Pi, Pi) / Pi * 32767.0f));
+		}
+
+		bool FitsInt16(const int64 value)
+		{
+			return value >= std::numeric_limits<int16>::min() && value <= std::numeric_limits<int16>::max();
+		}
+
+		bool HasSameJump(const CompactMovementState& a, const CompactMovementState& b)
+		{
+			return a.jumpVelocity == b.jumpVelocity && a.jumpSinAngle == b.jumpSinAngle &&
+				a.jumpCosAngle == b.jumpCosAngle && a.jumpXZSpeed == b.jumpXZSpeed;
+		}
+	}
+
+	CompactMovementState CompactMovementState::FromMovementInfo(const MovementInfo& info)
+	{
+		CompactMovementState state;
+		state.movementFlags = info.movementFlags;
+		state.timestamp = info.timestamp;
+		state.position = { QuantizePosition(info.position.x), QuantizePosition(info.position.y), QuantizePosition(info.position.z) };
+		state.facing = QuantizeFacing(info.facing.GetValueRadians());
+		state.fallTime = static_cast<uint32>(std::min<GameTime>(info.fallTime, std::numeric_limits<uint32>::max()));
+
+		// Like in the full format, pitch and jump values are only kept while they are relevant
+		if (info.movementFlags & (movement_flags::Swimming | movement_flags::Flying))
+		{
+			state.pitch = QuantizePitch(info.pitch.GetValueRadians());
+		}
+
+		if (info.movementFlags & movement_flags::Falling)
+		{
+			state.jumpVelocity = info.jumpVelocity;
+			state.jumpSinAngle = info.jumpSinAngle;
+			state.jumpCosAngle = info.jumpCosAngle;
+			state.jumpXZSpeed = info.jumpXZSpeed;
+		}
+
+		return state;
+	}
+
+	MovementInfo CompactMovementState::ToMovementInfo() const
+	{
+		MovementInfo info;
+		info.movementFlags = movementFlags;
+		info.timestamp = timestamp;
+		info.position = Vector3(
+			static_cast<float>(position[0]) / CompactMovementPositionScale,
+			static_cast<float>(position[1]) / CompactMovementPositionScale,
+			static_cast<float>(position[2]) / CompactMovementPositionScale);
+		info.facing = Radian(static_cast<float>(facing) / 65536.0f * TwoPi);
+		info.pitch = Radian(static_cast<float>(pitch) / 32767.0f * Pi);
+		info.fallTime = fallTime;
+		info.jumpVelocity = jumpVelocity;
+		info.jumpSinAngle = jumpSinAngle;
+		info.jumpCosAngle = jumpCosAngle;
+		info.jumpXZSpeed = jumpXZSpeed;
+		return info;
+	}
+
+	void WriteCompactMovement(io::Writer& writer, const CompactMovementState& state, const CompactMovementState* reference)
+	{
+		namespace fields = compact_movement_fields;
+
+		// Timestamps go backwards after reconnects and do not fit into the delta after long pauses, so these
+		// movements are encoded from scratch
+		const bool isKeyframe = !reference || state.timestamp < reference->timestamp || state.timestamp - reference->timestamp > std::numeric_limits<uint16>::max();
+		const CompactMovementState base = isKeyframe ? CompactMovementState() : *reference;
+
+		std::array<int64, 3> positionDelta {};
+		for (size_t i = 0; i < positionDelta.size(); ++i)
+		{
+			positionDelta[i] = static_cast<int64>(state.position[i]) - base.position[i];
+		}
+
+		// Only fields which differ from the base are written
+		uint8 mask = isKeyframe ? fields::Keyframe : 0;
+		if (state.movementFlags != base.movementFlags)
+		{
+			mask |= fields::Flags;
+		}
+		if (state.position != base.position)
+		{
+			mask |= std::all_of(positionDelta.begin(), positionDelta.end(), FitsInt16) ? fields::Position : fields::PositionWide;
+		}
+		if (state.facing != base.facing)
+		{
+			mask |= fields::Facing;
+		}
+		if (state.pitch != base.pitch)
+		{
+			mask |= fields::Pitch;
+		}
+		if (state.fallTime != base.fallTime)
+		{
+			mask |= fields::FallTime;
+		}
+		if (!HasSameJump(state, base))
+		{
+			mask |= fields::Jump;
+		}
+
+		writer << io::write<uint8>(mask);
+
+		if (isKeyframe)
+		{
+			writer << io::write<uint64>(state.timestamp);
+		}
+		else
+		{
+			writer << io::write<uint16>(static_cast<uint16>(state.timestamp - base.timestamp));
+		}
+
+		if (mask & fields::Flags)
+		{
+			writer << io::write<uint32>(state.movementFlags);
+		}
+
+		if (mask & fields::Position)
+		{
+			for (const int64 delta : positionDelta)
+			{
+				writer << io::write<int16>(static_cast<int16>(delta));
+			}
+		}
+		else if (mask & fields::PositionWide)
+		{
+			for (const int32 value : state.position)
+			{
+				writer << io::write<int32>(value);
+			}
+		}
+
+		if (mask & fields::Facing)
+		{
+			writer << io::write<uint16>(state.facing);
+		}
+
+		if (mask & fields::Pitch)
+		{
+			writer << io::write<int16>(state.pitch);
+		}
+
+		if (mask & fields::FallTime)
+		{
+			writer << io::write<uint32>(state.fallTime);
+		}
+
+		if (mask & fields::Jump)
+		{
+			writer
+				<< io::write<float>(state.jumpVelocity)
+				<< io::write<float>(state.jumpSinAngle)
+				<< io::write<float>(state.jumpCosAngle)
+				<< io::write<float>(state.jumpXZSpeed);
+		}
+	}
+
+	bool ReadCompactMovement(io::Reader& reader, const CompactMovementState* reference, CompactMovementState& out_state)
+	{
+		namespace fields = compact_movement_fields;
+
+		uint8 mask = 0;
+		if (!(reader >> io::read<uint8>(mask)))
+		{
+			return false;
+		}
+
+		const bool isKeyframe = (mask & fields::Keyframe) != 0;
+		if (!isKeyframe && !reference)
+		{
+			return false;
+		}
+
+		CompactMovementState state = isKeyframe ? CompactMovementState() : *reference;
+
+		if (isKeyframe)
+		{
+			reader >> io::read<uint64>(state.timestamp);
+		}
+		else
+		{
+			uint16 timestampDelta = 0;
+			reader >> io::read<uint16>(timestampDelta);
+			state.timestamp += timestampDelta;
+		}
+
+		if (mask & fields::Flags)
+		{
+			reader >> io::read<uint32>(state.movementFlags);
+		}
+
+		if (mask & fields::Position)
+		{
+			for (int32& value : state.position)
+			{
+				int16 delta = 0;
+				reader >> io::read<int16>(delta);
+				value += delta;
+			}
+		}
+		else if (mask & fields::PositionWide)
+		{
+			for (int32& value : state.position)
+			{
+				reader >> io::read<int32>(value);
+			}
+		}
+
+		if (mask & fields::Facing)
+		{
+			reader >> io::read<uint16>(state.facing);
+		}
+
+		if (mask & fields::Pitch)
+		{
+			reader >> io::read<int16>(state.pitch);
+		}
+
+		if (mask & fields::FallTime)
+		{
+			reader >> io::read<uint32>(state.fallTime);
+		}
+
+		if (mask & fields::Jump)
+		{
+			reader
+				>> io::read<float>(state.jumpVelocity)
+				>> io::read<float>(state.jumpSinAngle)
+				>> io::read<float>(state.jumpCosAngle)
+				>> io::read<float>(state.jumpXZSpeed);
+		}
+
+		if (!reader)
+		{
+			return false;
+		}
+
+		out_state = state;
+		return true;
+	}
+}
@@ -0,0 +1,81 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+#include "binary_io/reader.h"
+#include "binary_io/writer.h"
+#include "movement_info.h"
+
+#include <array>
+
+namespace mmo
+{
+	/// Number of position steps per world unit in the compact movement format.
+	static constexpr float CompactMovementPositionScale = 64.0f;
+
+	/// Flags which tell which fields of a compact movement follow.
+	namespace compact_movement_fields
+	{
+		enum Type
+		{
+			/// The movement is encoded against an empty state instead of the previous one and has an absolute timestamp.
+			Keyframe = 1 << 0,
+			/// Movement flags follow.
+			Flags = 1 << 1,
+			/// The position follows as difference to the previous position in 16 bit steps.
+			Position = 1 << 2,
+			/// The position follows in absolute 32 bit steps.
+			PositionWide = 1 << 3,
+			/// The facing follows.
+			Facing = 1 << 4,
+			/// The pitch follows.
+			Pitch = 1 << 5,
+			/// The fall time follows.
+			FallTime = 1 << 6,
+			/// The jump values follow.
+			Jump = 1 << 7
+		};
+	}
+
+	/// Quantized movement info as sent in compact movement packets. Sender and receiver both keep the last state of every
+	/// moving unit, so that the next movement only needs to contain the fields that changed.
+	struct CompactMovementState
+	{
+		uint32 movementFlags { 0 };
+		GameTime timestamp { 0 };
+		/// Position in steps of 1 / CompactMovementPositionScale.
+		std::array<int32, 3> position {};
+		/// Facing in steps of a full turn divided by 65536.
+		uint16 facing { 0 };
+		/// Pitch in steps of half a turn divided by 32767.
+		int16 pitch { 0 };
+		uint32 fallTime { 0 };
+		float jumpVelocity { 0.0f };
+		float jumpSinAngle { 0.0f };
+		float jumpCosAngle { 0.0f };
+		float jumpXZSpeed { 0.0f };
+
+		/// Quantizes a movement info.
+		static CompactMovementState FromMovementInfo(const MovementInfo& info);
+
+		/// Gets the movement info this state represents.
+		[[nodiscard]] MovementInfo ToMovementInfo() const;
+
+		bool operator==(const CompactMovementState& other) const = default;
+	};
+
+	/// Writes a movement state in the compact format.
+	/// @param writer The writer to write to.
+	/// @param state The state to write.
+	/// @param reference The state previously written for the same unit to the same receiver, or nullptr if the receiver
+	///	does not know any state of the unit.
+	void WriteCompactMovement(io::Writer& writer, const CompactMovementState& state, const CompactMovementState* reference);
+
+	/// Reads a movement state written by WriteCompactMovement.
+	/// @param reader The reader to read from.
+	/// @param reference The state previously read for the same unit, or nullptr if there is none.
+	/// @param out_state Receives the state.
+	/// @returns false if the data could not be read or if it needs a reference state but none was given.
+	bool ReadCompactMovement(io::Reader& reader, const CompactMovementState* reference, CompactMovementState& out_state);
+}
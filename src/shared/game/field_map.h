@@ -2,7 +2,8 @@
 
 #pragma once
 
-#include <bitset>
+#include <algorithm>
+#include <bit>
 #include <type_traits>
 #include <vector>
 
@@ -22,6 +23,15 @@ namespace mmo
 		typedef uint16 FieldIndexType;
 
 		static constexpr size_t MaxFieldCount = 1 << std::numeric_limits<FieldIndexType>::digits;
+
+	private:
+		/// Type of a word in the change set. Change flags are scanned one word at a time.
+		typedef uint64 ChangeWord;
+
+		static constexpr size_t BitsPerChangeWord = std::numeric_limits<ChangeWord>::digits;
+
+		/// Number of change mask bytes stored in a single change word.
+		static constexpr size_t MaskBytesPerChangeWord = sizeof(ChangeWord);
 		
 	public:
 		/// Initializes the field map with a maximum number of fields, where 0 < numFields <= MaxFieldCount.
@@ -35,7 +45,7 @@ namespace mmo
 			ASSERT(numFields > 0);
 			ASSERT(numFields <= MaxFieldCount);
 			
-			m_changes.reset();
+			m_changes.assign((numFields + BitsPerChangeWord - 1) / BitsPerChangeWord, 0);
 			m_data.resize(numFields, 0);
 		}
 	
@@ -80,17 +90,20 @@ namespace mmo
 		}
 
 		/// Determines whether the given field is marked as changed.
-		[[nodiscard]] bool IsFieldMarkedAsChanged(const FieldIndexType index) const { return m_changes[index]; }
+		[[nodiscard]] bool IsFieldMarkedAsChanged(const FieldIndexType index) const
+		{
+			return (m_changes[index / BitsPerChangeWord] >> (index % BitsPerChangeWord)) & 1;
+		}
 
 		[[nodiscard]] size_t GetFieldCount() const { return m_data.size(); }
 
 		int32 GetFirstChangedField() const
 		{
-			for (uint32 i = 0; i < m_data.size(); ++i)
+			for (size_t word = 0; word < m_changes.size(); ++word)
 			{
-				if (m_changes[i])
+				if (m_changes[word] != 0)
 				{
-					return i;
+					return static_cast<int32>(word * BitsPerChangeWord + std::countr_zero(m_changes[word]));
 				}
 			}
 
@@ -99,11 +112,11 @@ namespace mmo
 
 		int32 GetLastChangedField() const
 		{
-			for (int32 i = m_data.size() - 1; i >= 0; --i)
+			for (size_t word = m_changes.size(); word-- > 0; )
 			{
-				if (m_changes[i])
+				if (m_changes[word] != 0)
 				{
-					return i;
+					return static_cast<int32>(word * BitsPerChangeWord + BitsPerChangeWord - 1 - std::countl_zero(m_changes[word]));
 				}
 			}
 
@@ -111,22 +124,39 @@ namespace mmo
 		}
 
 		/// Marks all fields as changed.
-		void MarkAllAsChanged() { m_changes.set(); }
+		void MarkAllAsChanged()
+		{
+			std::fill(m_changes.begin(), m_changes.end(), ~ChangeWord(0));
+			ClearUnusedChangeBits();
+		}
 
 		/// Marks all fields as changed.
-		void MarkAllAsUnchanged() { m_changes.reset(); }
+		void MarkAllAsUnchanged() { MarkAsUnchanged(); }
 
 		/// Marks a specific field as changed.
-		void MarkAsChanged(const FieldIndexType index) { m_changes.set(index); }
+		void MarkAsChanged(const FieldIndexType index) { m_changes[index / BitsPerChangeWord] |= ChangeWord(1) << (index % BitsPerChangeWord); }
 		
 		/// Marks all fields as unchanged.
-		void MarkAsUnchanged() { m_changes.reset(); }
+		void MarkAsUnchanged() { std::fill(m_changes.begin(), m_changes.end(), 0); }
 
-		bool HasChanges() const { return m_changes.any(); }
+		bool HasChanges() const { return std::any_of(m_changes.begin(), m_changes.end(), [](const ChangeWord word) { return word != 0; }); }
+
+		/// Gets the number of bytes SerializeChanges writes.
+		[[nodiscard]] size_t GetChangesSize() const
+		{
+			size_t changedFields = 0;
+			for (const ChangeWord word : m_changes)
+			{
+				changedFields += std::popcount(word);
+			}
+
+			return GetChangeMaskSize() + changedFields * sizeof(TFieldBase);
+		}
 
 	public:
 		/// Serializes the whole field map, regardless of change flags.
-		io::Writer& SerializeComplete(io::Writer& w) const
+		template <class W>
+		io::WriterRef<W> SerializeComplete(W& w) const
 		{
 			return w
 				<< io::write_range(m_data);
@@ -134,82 +164,158 @@ namespace mmo
 
 		/// @brief Serializes only fields that have been changed.
 		/// @param w The writer to use.
-		io::Writer& SerializeChanges(io::Writer& w) const
+		///	The change mask comes first, one bit per field in one byte per eight fields, followed by the values of all
+		///	changed fields in ascending order.
+		template <class W>
+		io::WriterRef<W> SerializeChanges(W& w) const
 		{
-			for (size_t i = 0; i < m_data.size(); i += 8)
-			{
-				uint8 flag = 0;
+			const size_t maskSize = GetChangeMaskSize();
 
-				for (size_t j = 0; j < 8; ++j)
+			for (size_t word = 0; word < m_changes.size(); ++word)
+			{
+				char mask[MaskBytesPerChangeWord];
+				const size_t maskBytes = std::min(MaskBytesPerChangeWord, maskSize - word * MaskBytesPerChangeWord);
+				for (size_t i = 0; i < maskBytes; ++i)
 				{
-					if (i + j < m_data.size())
-					{
-						if (m_changes[i + j]) flag |= 1 << j;
-					}
+					mask[i] = static_cast<char>(m_changes[word] >> (i * 8));
 				}
 
-				w << io::write<uint8>(flag);
+				w.WriteBytes(mask, maskBytes);
 			}
 
-			for (size_t i = 0; i < m_data.size(); ++i)
+			ForEachChangedRange([this, &w](const size_t first, const size_t count)
 			{
-				if (m_changes[i])
-				{
-					w << io::write<TFieldBase>(m_data[i]);
-				}
-			}
+				w.WriteBytes(reinterpret_cast<const char*>(&m_data[first]), count * sizeof(TFieldBase));
+				return true;
+			});
 			
 			return w;
 		}
 
 		/// @brief Deserializes the whole field map, expecting every single field value.
 		///	@param r The reader to use.
-		io::Reader& DeserializeComplete(io::Reader& r)
+		template <class R>
+		io::ReaderRef<R> DeserializeComplete(R& r)
 		{
-			m_changes.reset();
+			MarkAsUnchanged();
 			return r
 				>> io::read_range(m_data);
 		}
 
 		/// @brief Deserializes the field map while expecting only changed field values.
 		///	@param r The reader to use.
-		io::Reader& DeserializeChanges(io::Reader& r)
+		template <class R>
+		io::ReaderRef<R> DeserializeChanges(R& r)
 		{
-			m_changes.reset();
+			MarkAsUnchanged();
 
-			for (size_t i = 0; i < m_data.size(); i += 8)
+			const size_t maskSize = GetChangeMaskSize();
+
+			for (size_t word = 0; word < m_changes.size(); ++word)
 			{
-				uint8 flag;
-				if (!(r >> io::read<uint8>(flag)))
+				uint8 mask[MaskBytesPerChangeWord];
+				const size_t maskBytes = std::min(MaskBytesPerChangeWord, maskSize - word * MaskBytesPerChangeWord);
+				if (!ReadBytes(r, mask, maskBytes))
 				{
 					return r;
 				}
 
-				for (size_t j = 0; j < 8; ++j)
+				ChangeWord changes = 0;
+				for (size_t i = 0; i < maskBytes; ++i)
 				{
-					if (flag & (1 << j))
-					{
-						m_changes.set(j + i);
-					}
+					changes |= static_cast<ChangeWord>(mask[i]) << (i * 8);
 				}
+
+				m_changes[word] = changes;
 			}
+
+			// Flags of the padding bits in the last mask byte don't belong to any field
+			ClearUnusedChangeBits();
+
+			ForEachChangedRange([this, &r](const size_t first, const size_t count)
+			{
+				return ReadBytes(r, &m_data[first], count * sizeof(TFieldBase));
+			});
 			
-			for (size_t i = 0; i < m_data.size(); ++i)
+			return r;
+		}
+
+	private:
+		/// Gets the number of bytes of the change mask on the wire.
+		[[nodiscard]] size_t GetChangeMaskSize() const { return (m_data.size() + 7) / 8; }
+
+		/// Clears the change bits of the last change word which do not belong to a field.
+		void ClearUnusedChangeBits()
+		{
+			const size_t usedBits = m_data.size() % BitsPerChangeWord;
+			if (usedBits != 0 && !m_changes.empty())
 			{
-				if (IsFieldMarkedAsChanged(i))
+				m_changes.back() &= (ChangeWord(1) << usedBits) - 1;
+			}
+		}
+
+		/// Calls a function for every range of consecutive changed fields in ascending order. Stops as soon as the
+		/// function returns false.
+		/// @param func Function which takes the index of the first changed field and the number of fields.
+		template <class F>
+		void ForEachChangedRange(F&& func) const
+		{
+			bool hasRange = false;
+			size_t rangeStart = 0, rangeEnd = 0;
+
+			for (size_t word = 0; word < m_changes.size(); ++word)
+			{
+				ChangeWord changes = m_changes[word];
+				while (changes != 0)
 				{
-					if (!(r >> io::read<TFieldBase>(m_data[i])))
+					const size_t first = std::countr_zero(changes);
+					const size_t count = std::countr_one(changes >> first);
+					const size_t start = word * BitsPerChangeWord + first;
+
+					// Ranges which cross a word boundary are handled as a single range
+					if (!hasRange || start != rangeEnd)
 					{
-						break;
+						if (hasRange && !func(rangeStart, rangeEnd - rangeStart))
+						{
+							return;
+						}
+
+						hasRange = true;
+						rangeStart = start;
 					}
+
+					rangeEnd = start + count;
+					changes = first + count < BitsPerChangeWord ? changes & (~ChangeWord(0) << (first + count)) : 0;
 				}
 			}
-			
-			return r;
+
+			if (hasRange)
+			{
+				func(rangeStart, rangeEnd - rangeStart);
+			}
+		}
+
+		/// Reads raw bytes and fails the reader if not all of them could be read.
+		template <class R>
+		static bool ReadBytes(R& r, void* dest, const size_t size)
+		{
+			if (!r)
+			{
+				return false;
+			}
+
+			if (r.getSource()->read(static_cast<char*>(dest), size) != size)
+			{
+				r.setFailure();
+				return false;
+			}
+
+			return true;
 		}
 	
 	private:
-		std::bitset<MaxFieldCount> m_changes{};
+		/// One change flag per field, packed into words.
+		std::vector<ChangeWord> m_changes{};
 		std::vector<TFieldBase> m_data{};
 	};
 
@@ -156,7 +156,8 @@ namespace mmo
 		bool IsFalling() const noexcept { return (movementFlags & movement_flags::Falling) != 0; }
 	};
 
-	inline io::Writer& operator<<(io::Writer& writer, const MovementInfo& info)
+	template <class W>
+	io::WriterRef<W> operator<<(W& writer, const MovementInfo& info)
 	{
 		writer
 			<< io::write<uint32>(info.movementFlags)
@@ -183,7 +184,8 @@ namespace mmo
 		return writer;
 	}
 
-	inline io::Reader& operator>>(io::Reader& reader, MovementInfo& info)
+	template <class R>
+	io::ReaderRef<R> operator>>(R& reader, MovementInfo& info)
 	{
 		reader
 			>> io::read<uint32>(info.movementFlags)
@@ -209,6 +209,8 @@ namespace mmo
 					return;
 				}
 
+				GetNetworkBytesSent().Increment(m_sending.size());
+
 				m_sending.clear();
 				flush();
 			}
@@ -241,6 +243,8 @@ namespace mmo
 					return;
 				}
 
+				GetNetworkBytesReceived().Increment(size);
+
 				m_received.append(
 					m_receiving.begin(),
 					m_receiving.begin() + size);
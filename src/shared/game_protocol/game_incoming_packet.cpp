@@ -5,12 +5,23 @@
 #include <limits>
 
 #include "base/macros.h"
+#include "base/metrics.h"
 
 
 namespace mmo
 {
 	namespace game
 	{
+		namespace
+		{
+			MetricCounterArray& GetPacketsReceived()
+			{
+				static MetricCounterArray& s_packetsReceived = MetricsRegistry::Get().AddCounterArray(
+					"mmo_packets_received_total", "Number of complete packets received per op code.", "opcode", 1024, "protocol=\"game\"");
+				return s_packetsReceived;
+			}
+		}
+
 		IncomingPacket::IncomingPacket()
 			: m_id(std::numeric_limits<uint16>::max())
 		{
@@ -36,6 +47,8 @@ namespace mmo
 
 				packet.m_body = io::MemorySource(body, body + packet.m_size);
 				packet.setSource(&packet.m_body);
+
+				GetPacketsReceived().Increment(packet.m_id);
 				return receive_state::Complete;
 			}
 
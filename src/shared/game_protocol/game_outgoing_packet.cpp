@@ -2,11 +2,23 @@
 
 #include "game_outgoing_packet.h"
 
+#include "base/metrics.h"
+
 
 namespace mmo
 {
 	namespace game
 	{
+		namespace
+		{
+			MetricCounterArray& GetPacketsSent()
+			{
+				static MetricCounterArray& s_packetsSent = MetricsRegistry::Get().AddCounterArray(
+					"mmo_packets_sent_total", "Number of packets written per op code.", "opcode", 1024, "protocol=\"game\"");
+				return s_packetsSent;
+			}
+		}
+
 		OutgoingPacket::OutgoingPacket(io::ISink &sink, const bool proxy)
 			: io::Writer(sink)
 			, m_proxy(proxy)
@@ -38,6 +50,8 @@ namespace mmo
 
 				m_size = endPos - m_bodyPos;
 				Sink().Overwrite(m_sizePos, reinterpret_cast<const char*>(&m_size), sizeof(m_size));
+
+				GetPacketsSent().Increment(m_id);
 			}
 		}
 	}
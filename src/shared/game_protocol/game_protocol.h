@@ -16,6 +16,12 @@ namespace mmo
 			typedef game::OutgoingPacket OutgoingPacket;
 		};
 
+		/// Maximum number of entries a single DbQueryBatch packet may ask for.
+		static constexpr uint16 MaxDbQueryBatchSize = 64;
+
+		/// Maximum number of quest givers a single QuestGiverStatusMultipleQuery packet may ask for.
+		static constexpr uint16 MaxQuestGiverStatusBatchSize = 64;
+
 
 		////////////////////////////////////////////////////////////////////////////////
 		// BEGIN: Client <-> Realm section
@@ -150,6 +156,12 @@ namespace mmo
 
 				RandomRoll,
 
+				/// Queries multiple entries of one kind at once. Contains the single query op code, an entry count and the packed entry ids.
+				DbQueryBatch,
+
+				/// Queries the quest giver status of multiple quest givers at once. Contains an entry count and the packed guids.
+				QuestGiverStatusMultipleQuery,
+
 				/// Counter constant
 				Count_,
 			};
@@ -313,6 +325,17 @@ namespace mmo
 
 				RandomRollResult,
 
+				/// Answers a DbQueryBatch. Contains the single result op code, an entry count and the body of a single result per entry.
+				DbQueryBatchResult,
+
+				/// Movement of another unit in the compact format. Contains the packed guid of the unit, the movement op code
+				/// and the movement info encoded against the previous compact movement of that unit. Only sent to clients
+				/// which announced client_feature::CompactMovement.
+				CompactMovement,
+
+				/// Answers a QuestGiverStatusMultipleQuery. Contains an entry count and the packed guid and status per quest giver.
+				QuestGiverStatusMultiple,
+
 				/// Counter constant
 				Count_,
 			};
@@ -357,6 +380,24 @@ namespace mmo
 
 		typedef auth_result::Type AuthResult;
 
+		/// Enumerates optional protocol features a client announces in its AuthSession packet. Servers only use features
+		/// announced by the client and fall back to the default encoding otherwise.
+		namespace client_feature
+		{
+			enum Type
+			{
+				None = 0,
+
+				/// The client understands realm_client_packet::CompactMovement packets.
+				CompactMovement = 1 << 0,
+
+				/// All features supported by this build.
+				Supported = CompactMovement
+			};
+		}
+
+		typedef client_feature::Type ClientFeature;
+
 		/// Enumerates possible character creation results.
 		namespace char_create_result
 		{
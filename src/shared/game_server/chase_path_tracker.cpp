@@ -0,0 +1,42 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "chase_path_tracker.h"
+
+namespace mmo
+{
+	bool ChasePathTracker::NeedsPath(const uint64 targetGuid, const Vector3& targetLocation, const float tolerance, const Vector3& moverTarget, const GameTime now) const
+	{
+		// Target is still in reach of where the unit is heading to
+		if ((targetLocation - moverTarget).GetSquaredLength() <= tolerance * tolerance)
+		{
+			return false;
+		}
+
+		// The unit is not following a path to this target (anymore), so it needs one right away
+		if (!m_hasPath || m_targetGuid != targetGuid || moverTarget != m_destination)
+		{
+			return true;
+		}
+
+		return now - m_lastPathTime >= MinRepathInterval;
+	}
+
+	void ChasePathTracker::OnPathCalculated(const uint64 targetGuid, const Vector3& destination, const GameTime now)
+	{
+		m_targetGuid = targetGuid;
+		m_destination = destination;
+		m_lastPathTime = now;
+		m_hasPath = true;
+	}
+
+	void ChasePathTracker::OnPathFailed(const uint64 targetGuid, const Vector3& moverTarget, const GameTime now)
+	{
+		// Keep following the previous movement until it is time to try again
+		OnPathCalculated(targetGuid, moverTarget, now);
+	}
+
+	void ChasePathTracker::Reset()
+	{
+		m_hasPath = false;
+	}
+}
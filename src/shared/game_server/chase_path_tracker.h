@@ -0,0 +1,52 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+#include "math/vector3.h"
+
+namespace mmo
+{
+	/// Remembers the path a creature follows to chase its victim and decides when a new path has to be calculated.
+	/// A new path is needed when the target left the tolerance region around the movement target of the creature.
+	/// While the creature follows a path which was calculated for the same target, new paths are calculated at most
+	/// once per MinRepathInterval, as the creature is still making progress towards the target. If the movement target
+	/// changed in the meantime or the creature chases another target, the current path is no longer valid and a new
+	/// path is calculated right away.
+	class ChasePathTracker final
+	{
+	public:
+		/// Minimum time between two paths to the same target while the current path is still being followed.
+		static constexpr GameTime MinRepathInterval = 500;
+
+	public:
+		/// Determines whether a new path to the target needs to be calculated.
+		/// @param targetGuid Guid of the chased target.
+		/// @param targetLocation The current location of the chased target.
+		/// @param tolerance Distance the target may move away from the end of the current path.
+		/// @param moverTarget The current movement target of the chasing unit.
+		/// @param now The current time.
+		[[nodiscard]] bool NeedsPath(uint64 targetGuid, const Vector3& targetLocation, float tolerance, const Vector3& moverTarget, GameTime now) const;
+
+		/// Remembers that a path to the target has been calculated.
+		/// @param targetGuid Guid of the chased target.
+		/// @param destination End of the calculated path, which is the new movement target of the chasing unit.
+		/// @param now The current time.
+		void OnPathCalculated(uint64 targetGuid, const Vector3& destination, GameTime now);
+
+		/// Remembers that no path to the target could be calculated, so that it is not tried again immediately.
+		/// @param targetGuid Guid of the chased target.
+		/// @param moverTarget The current movement target of the chasing unit.
+		/// @param now The current time.
+		void OnPathFailed(uint64 targetGuid, const Vector3& moverTarget, GameTime now);
+
+		/// Forgets the current path.
+		void Reset();
+
+	private:
+		uint64 m_targetGuid = 0;
+		Vector3 m_destination;
+		GameTime m_lastPathTime = 0;
+		bool m_hasPath = false;
+	};
+}
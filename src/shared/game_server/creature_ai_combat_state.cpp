@@ -117,14 +117,16 @@ namespace mmo
 		controlled.GetMover().StopMovement();
 
 		// All remaining threateners are no longer in combat with this unit
-		for (auto& pair : m_threat)
+		for (const auto& entry : m_threat)
 		{
-			if (auto threatener = pair.second.threatener.lock())
+			if (auto threatener = entry.threatener.lock())
 			{
 				threatener->RemoveAttackingUnit(GetControlled());
 			}
 		}
 
+		m_chasePath.Reset();
+
 	}
 
 	void CreatureAICombatState::OnDamage(GameUnitS& attacker)
@@ -181,12 +183,8 @@ namespace mmo
 		// Add threat amount (Note: A value of 0 is fine here, as it will still add an
 		// entry to the threat list)
 		uint64 guid = threatener.GetGuid();
-		auto it = m_threat.find(guid);
-		if (it == m_threat.end())
+		if (m_threat.AddThreat(threatener, amount))
 		{
-			// Insert new entry
-			it = m_threat.insert(m_threat.begin(), std::make_pair(guid, ThreatEntry(threatener, 0.0f)));
-
 			// Watch for unit killed signal
 			m_killedSignals[guid] = threatener.killed.connect([this, guid, &threatener](GameUnitS*)
 				{
@@ -208,9 +206,6 @@ namespace mmo
 			GetControlled().AddCombatParticipant(threatener);
 		}
 
-		auto& threatEntry = it->second;
-		threatEntry.amount += amount;
-
 		m_lastThreatTime = GetAsyncTimeMs();
 
 		// If not casting right now and already initialized, choose next action
@@ -223,11 +218,7 @@ namespace mmo
 	void CreatureAICombatState::RemoveThreat(GameUnitS& threatener)
 	{
 		const uint64 guid = threatener.GetGuid();
-		const auto it = m_threat.find(guid);
-		if (it != m_threat.end())
-		{
-			m_threat.erase(it);
-		}
+		m_threat.Remove(guid);
 
 		const auto killedIt = m_killedSignals.find(guid);
 		if (killedIt != m_killedSignals.end())
@@ -245,7 +236,7 @@ namespace mmo
 		threatener.RemoveAttackingUnit(controlled);
 
 		if (controlled.GetVictim() == &threatener ||
-			m_threat.empty())
+			m_threat.IsEmpty())
 		{
 			controlled.StopAttack();
 			controlled.SetTarget(0);
@@ -255,42 +246,17 @@ namespace mmo
 
 	float CreatureAICombatState::GetThreat(const GameUnitS& threatener)
 	{
-		const uint64 guid = threatener.GetGuid();
-		if (const auto it = m_threat.find(guid); it == m_threat.end())
-		{
-			return 0.0f;
-		}
-		else
-		{
-			return it->second.amount;
-		}
+		return m_threat.GetThreat(threatener.GetGuid());
 	}
 
 	void CreatureAICombatState::SetThreat(const GameUnitS& threatener, const float amount)
 	{
-		const uint64 guid = threatener.GetGuid();
-		if (const auto it = m_threat.find(guid); it != m_threat.end())
-		{
-			it->second.amount = amount;
-		}
+		m_threat.SetThreat(threatener.GetGuid(), amount);
 	}
 
 	GameUnitS* CreatureAICombatState::GetTopThreatener()
 	{
-		float highestThreat = -1.0f;
-		GameUnitS* topThreatener = nullptr;
-		for (auto& entry : m_threat)
-		{
-			if (entry.second.amount > highestThreat)
-			{
-				topThreatener = entry.second.threatener.lock().get();
-				if (topThreatener)
-				{
-					highestThreat = entry.second.amount;
-				}
-			}
-		}
-		return topThreatener;
+		return m_threat.GetTopThreatener();
 	}
 
 	void CreatureAICombatState::UpdateVictim()
@@ -300,22 +266,7 @@ namespace mmo
 		GameUnitS* victim = controlled.GetVictim();
 
 		// Now, determine the victim with the highest threat value
-		float highestThreat = -1.0f;
-		GameUnitS* newVictim = nullptr;
-		for (auto& entry : m_threat)
-		{
-			auto threatener = entry.second.threatener.lock();
-			if (!threatener)
-			{
-				continue;
-			}
-
-			if (entry.second.amount > highestThreat)
-			{
-				newVictim = threatener.get();
-				highestThreat = entry.second.amount;
-			}
-		}
+		GameUnitS* newVictim = m_threat.GetTopThreatener();
 
 		if (newVictim && newVictim != victim)
 		{
@@ -342,10 +293,18 @@ namespace mmo
 
 		const Vector3 currentUnitLoc = target.GetPredictedPosition();
 		const float distance = (currentUnitLoc - currentLocation).GetSquaredLength();
+		const float tolerance = combatRange * 0.5f;
 
 		// Check distance and whether we need to move
-		if (distance > (combatRange * 0.5f) * (combatRange * 0.5f))
+		if (distance > tolerance * tolerance)
 		{
+			// While we are still following a path to this target, don't calculate a new path on every threat event
+			const GameTime now = GetAsyncTimeMs();
+			if (!m_chasePath.NeedsPath(target.GetGuid(), currentUnitLoc, tolerance, currentLocation, now))
+			{
+				return;
+			}
+
 			Vector3 newTargetLocation = target.GetPredictedPosition();
 			Vector3 direction = (newTargetLocation - currentLocation);
 			if (direction.Normalize() != 0.0f)
@@ -355,7 +314,14 @@ namespace mmo
 			}
 
 			// Chase the target
-			GetControlled().GetMover().MoveTo(newTargetLocation);
+			if (mover.MoveTo(newTargetLocation))
+			{
+				m_chasePath.OnPathCalculated(target.GetGuid(), mover.GetTarget(), now);
+			}
+			else
+			{
+				m_chasePath.OnPathFailed(target.GetGuid(), mover.GetTarget(), now);
+			}
 		}
 		else
 		{
@@ -4,7 +4,9 @@
 #include "base/typedefs.h"
 #include "creature_ai_state.h"
 #include "base/countdown.h"
+#include "chase_path_tracker.h"
 #include "game_unit_s.h"
+#include "threat_table.h"
 
 namespace mmo
 {
@@ -13,21 +15,6 @@ namespace mmo
 	/// units.
 	class CreatureAICombatState : public CreatureAIState
 	{
-		/// Represents an entry in the threat list of this unit.
-		struct ThreatEntry
-		{
-			/// Threatening unit.
-			std::weak_ptr<GameUnitS> threatener;
-			float amount;
-
-			explicit ThreatEntry(GameUnitS& threatener, float amount = 0.0f)
-				: threatener(std::static_pointer_cast<GameUnitS>(threatener.shared_from_this()))
-				, amount(amount)
-			{
-			}
-		};
-
-		typedef std::map<::uint64, ThreatEntry> ThreatList;
 		typedef std::map<uint64, scoped_connection> UnitSignals;
 		typedef std::map<uint64, scoped_connection_container> UnitSignals2;
 
@@ -101,7 +88,8 @@ namespace mmo
 
 	protected:
 		std::weak_ptr<GameUnitS> m_combatInitiator;
-		ThreatList m_threat;
+		ThreatTable m_threat;
+		ChasePathTracker m_chasePath;
 		UnitSignals m_killedSignals;
 		UnitSignals2 m_miscSignals;
 		scoped_connection m_onThreatened, m_onMoveTargetChanged;
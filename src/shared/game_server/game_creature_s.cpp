@@ -130,10 +130,15 @@ namespace mmo
 	}
 
 	QuestgiverStatus GameCreatureS::GetQuestGiverStatus(const GamePlayerS& player) const
+	{
+		return GetQuestGiverStatus(GetEntry(), player);
+	}
+
+	QuestgiverStatus GameCreatureS::GetQuestGiverStatus(const proto::UnitEntry& entry, const GamePlayerS& player)
 	{
 		QuestgiverStatus result = questgiver_status::None;
 
-		for (const auto& quest : GetEntry().end_quests())
+		for (const auto& quest : entry.end_quests())
 		{
 			if (const QuestStatus questStatus = player.GetQuestStatus(quest); questStatus == quest_status::Complete)
 			{
@@ -147,12 +152,12 @@ namespace mmo
 
 		bool hasQuestAvailableNextLevel = false;
 
-		for (const auto& quest : GetEntry().quests())
+		for (const auto& quest : entry.quests())
 		{
 			const QuestStatus questStatus = player.GetQuestStatus(quest);
 			if (questStatus == quest_status::Available)
 			{
-				if (const proto::QuestEntry* entry = GetProject().quests.getById(quest))
+				if (player.GetProject().quests.getById(quest))
 				{
 					return questgiver_status::Available;
 				}
@@ -99,6 +99,10 @@ namespace mmo
 
 		QuestgiverStatus GetQuestGiverStatus(const GamePlayerS& player) const;
 
+		/// Evaluates the quest giver status of a creature entry for a player. The status only depends on the quests
+		/// offered and ended by the entry, so it is the same for all creatures sharing that entry.
+		static QuestgiverStatus GetQuestGiverStatus(const proto::UnitEntry& entry, const GamePlayerS& player);
+
 		bool ProvidesQuest(uint32 questId) const override;
 
 		bool EndsQuest(uint32 questId) const override;
@@ -56,7 +56,26 @@ namespace mmo
 		}
 	}
 
-	void GameObjectS::WriteObjectUpdateBlock(io::Writer& writer, bool creation) const
+	namespace
+	{
+		/// Gets the number of bytes io::write_packed_guid writes for a guid.
+		size_t GetPackedGuidSize(uint64 guid)
+		{
+			size_t size = 1;
+			for (; guid != 0; guid >>= 8)
+			{
+				if (guid & 0xFF)
+				{
+					++size;
+				}
+			}
+
+			return size;
+		}
+	}
+
+	template <class W>
+	void GameObjectS::WriteObjectUpdateBlockTo(W& writer, const bool creation) const
 	{
 		writer
 			<< io::write<uint8>(GetTypeId())
@@ -91,6 +110,22 @@ namespace mmo
 		}
 	}
 
+	void GameObjectS::WriteObjectUpdateBlock(io::Writer& writer, const bool creation) const
+	{
+		WriteObjectUpdateBlockTo(writer, creation);
+	}
+
+	void GameObjectS::WriteObjectUpdateBlock(io::BasicWriter<io::SectionSink>& writer) const
+	{
+		WriteObjectUpdateBlockTo(writer, false);
+	}
+
+	size_t GameObjectS::GetChangesUpdateBlockSize() const
+	{
+		// Type id, creation flag, packed guid and update flags, but no movement info
+		return sizeof(uint8) + sizeof(uint8) + GetPackedGuidSize(GetGuid()) + sizeof(uint32) + m_fields.GetChangesSize();
+	}
+
 	void GameObjectS::WriteValueUpdateBlock(io::Writer& writer, bool creation) const
 	{
 		m_fields.SerializeChanges(writer);
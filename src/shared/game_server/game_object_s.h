@@ -305,8 +305,20 @@ namespace mmo
 
 		virtual void WriteObjectUpdateBlock(io::Writer &writer, bool creation = true) const;
 
+		/// Writes the same update block as WriteObjectUpdateBlock(writer, false) into a packet section reserved
+		/// with GetChangesUpdateBlockSize, without any virtual sink calls.
+		virtual void WriteObjectUpdateBlock(io::BasicWriter<io::SectionSink>& writer) const;
+
+		/// Gets the exact number of bytes of the update block which contains the field changes of this object.
+		[[nodiscard]] virtual size_t GetChangesUpdateBlockSize() const;
+
 		virtual void WriteValueUpdateBlock(io::Writer& writer, bool creation = true) const;
 
+	private:
+		template <class W>
+		void WriteObjectUpdateBlockTo(W& writer, bool creation) const;
+
+	public:
 		bool HasFieldChanges() const;
 
 		void ClearFieldChanges();
@@ -59,9 +59,21 @@ namespace mmo
 		m_netPlayerWatcher = watcher;
 	}
 
+	void GamePlayerS::SetGroupId(const uint64 groupId)
+	{
+		const uint64 previousGroupId = m_groupId;
+		m_groupId = groupId;
+
+		if (m_worldInstance)
+		{
+			m_worldInstance->GetGroupMembers().UpdateMember(*this, previousGroupId);
+		}
+	}
+
 	void GamePlayerS::SetClass(const proto::ClassEntry& classEntry)
 	{
 		m_classEntry = &classEntry;
+		InvalidateQuestStatus();
 
 		Set<int32>(object_fields::MaxLevel, classEntry.levelbasevalues_size());
 		Set<int32>(object_fields::PowerType, classEntry.powertype());
@@ -72,6 +84,7 @@ namespace mmo
 	void GamePlayerS::SetRace(const proto::RaceEntry& raceEntry)
 	{
 		m_raceEntry = &raceEntry;
+		InvalidateQuestStatus();
 
 		Set<uint32>(object_fields::Race, raceEntry.id());
 		Set<uint32>(object_fields::FactionTemplate, raceEntry.factiontemplate());
@@ -423,6 +436,8 @@ namespace mmo
 
 				// Update quest log field value
 				Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), field);
+				m_questCreditIndex.AddQuest(i, *questEntry);
+				InvalidateQuestStatus();
 				if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestDataChanged(quest, data);
 
 				return true;
@@ -445,6 +460,8 @@ namespace mmo
 
 				// Reset quest log
 				Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), QuestField());
+				m_questCreditIndex.RemoveQuest(i);
+				InvalidateQuestStatus();
 				if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestDataChanged(quest, QuestStatusData());
 
 				return true;
@@ -612,6 +629,7 @@ namespace mmo
 			if (field.questId == entry->id())
 			{
 				Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), QuestField());
+				m_questCreditIndex.RemoveQuest(i);
 				break;
 			}
 		}
@@ -622,6 +640,7 @@ namespace mmo
 
 		m_rewardedQuestIds.insert(entry->id());
 		it = m_quests.erase(it);
+		InvalidateQuestStatus();
 
 		if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestCompleted(questgiverGuid, quest, rewardXp, money);
 
@@ -632,71 +651,45 @@ namespace mmo
 	{
 		const uint32 creditEntry = (entry.killcredit() != 0) ? entry.killcredit() : entry.id();
 
-		// Check all quests in the quest log
-		for (uint8 i = 0; i < MaxQuestLogSize; ++i)
+		// Only check the quest requirements which need this creature. Multiple quests could require the same creature.
+		for (const QuestCreditTarget& target : m_questCreditIndex.Find(quest_credit_type::Creature, creditEntry))
 		{
-			QuestField field = Get<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)));
-			if (field.questId == 0) 
+			QuestField field;
+			QuestStatusData* data = GetIncompleteQuestData(target.logSlot, field);
+			if (!data || target.requirementIndex >= data->creatures.size())
 			{
 				continue;
 			}
 
-			// Verify quest state
-			auto it = m_quests.find(field.questId);
-			if (it == m_quests.end()) 
-			{
-				continue;
-			}
+			const auto* quest = m_questCreditIndex.GetQuest(target.logSlot);
+			const auto& req = quest->requirements(target.requirementIndex);
 
-			if (it->second.status != quest_status::Incomplete) 
+			// Get current counter
+			uint8 counter = field.counters[target.requirementIndex];
+			if (counter >= req.creaturecount())
 			{
 				continue;
 			}
 
-			// Find quest
-			const auto* quest = GetProject().quests.getById(field.questId);
-			if (!quest) 
-			{
-				continue;
-			}
+			// Increment and update counter
+			field.counters[target.requirementIndex] = ++counter;
+			data->creatures[target.requirementIndex]++;
 
-			// Counter needed so that the right field is used
-			uint8 reqIndex = 0;
-			for (const auto& req : quest->requirements())
-			{
-				if (req.creatureid() == creditEntry)
-				{
-					// Get current counter
-					uint8 counter = field.counters[reqIndex];
-					if (counter < req.creaturecount())
-					{
-						// Increment and update counter
-						field.counters[reqIndex] = ++counter;
-						it->second.creatures[reqIndex]++;
+			// Fire signal to update UI
+			if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestKillCredit(*quest, unitGuid, creditEntry, data->creatures[target.requirementIndex], req.creaturecount());
 
-						// Fire signal to update UI
-						if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestKillCredit(*quest, unitGuid, creditEntry, it->second.creatures[reqIndex], req.creaturecount());
-
-						// Check if this completed the quest
-						if (FulfillsQuestRequirements(*quest))
-						{
-							// Complete quest
-							it->second.status = quest_status::Complete;
-							field.status = quest_status::Complete;
-						}
-
-						// Save quest progress
-						Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), field);
-						if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestDataChanged(field.questId, it->second);
-					}
-
-					// Continue with next quest, as multiple quests could require the same
-					// creature kill credit
-					continue;
-				}
-
-				reqIndex++;
+			// Check if this completed the quest
+			if (FulfillsQuestRequirements(*quest))
+			{
+				// Complete quest
+				data->status = quest_status::Complete;
+				field.status = quest_status::Complete;
+				InvalidateQuestStatus();
 			}
+
+			// Save quest progress
+			Set<QuestField>(object_fields::QuestLogSlot_1 + target.logSlot * (sizeof(QuestField) / sizeof(uint32)), field);
+			if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestDataChanged(field.questId, *data);
 		}
 	}
 
@@ -767,43 +760,35 @@ namespace mmo
 
 	void GamePlayerS::OnQuestItemAddedCredit(const proto::ItemEntry& entry, uint32 amount)
 	{
-		// If this is set to true, all nearby objects will be updated
-		for (uint8 i = 0; i < MaxQuestLogSize; ++i)
-		{
-			QuestField field = Get<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)));
-			if (field.questId == 0)
-			{
-				continue;
-			}
+		const auto targets = m_questCreditIndex.Find(quest_credit_type::Item, entry.id());
 
-			// Check if the player really has accepted that quest
-			auto it = m_quests.find(field.questId);
-			if (it == m_quests.end())
+		// Targets are ordered by quest log slot, so all requirements of a quest are handled at once
+		for (size_t first = 0, last = 0; first < targets.size(); first = last)
+		{
+			const uint8 logSlot = targets[first].logSlot;
+			while (last < targets.size() && targets[last].logSlot == logSlot)
 			{
-				continue;
+				++last;
 			}
 
-			// Check if the quest was already completed
-			if (it->second.status != quest_status::Incomplete) 
+			QuestField field;
+			QuestStatusData* data = GetIncompleteQuestData(logSlot, field);
+			if (!data)
 			{
 				continue;
 			}
 
-			// Get quest template entry
-			const auto* quest = GetProject().quests.getById(field.questId);
-			if (!quest)
-			{
-				continue;
-			}
+			const auto* quest = m_questCreditIndex.GetQuest(logSlot);
 
 			// If this is set to true, all requirements of this quest will be reevaluated, which costs
 			// some time. So this variable is only updated, if a quest requirement status changed between
 			// Completed and Uncomplete to save performance.
 			bool validateQuest = false;
 
-			// Check every quest entry requirement
-			for (const auto& req : quest->requirements())
+			// Check every quest requirement which needs this item
+			for (size_t i = first; i < last; ++i)
 			{
+				const auto& req = quest->requirements(targets[i].requirementIndex);
 				if (req.itemid() == entry.id())
 				{
 					if (m_inventory.GetItemCount(entry.id()) >= req.itemcount())
@@ -826,55 +811,48 @@ namespace mmo
 				// Quest is fulfilled now
 				if (FulfillsQuestRequirements(*quest))
 				{
-					it->second.status = quest_status::Complete;
+					data->status = quest_status::Complete;
 					field.status = quest_status::Complete;
-					if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestDataChanged(field.questId, it->second);
+					InvalidateQuestStatus();
+					if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestDataChanged(field.questId, *data);
 				}
 
-				Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), field);
+				Set<QuestField>(object_fields::QuestLogSlot_1 + logSlot * (sizeof(QuestField) / sizeof(uint32)), field);
 			}
 		}
 	}
 
 	void GamePlayerS::OnQuestItemRemovedCredit(const proto::ItemEntry& entry, uint32 amount)
 	{
-		// If this is set to true, all nearby objects will be updated
-		for (uint8 i = 0; i < MaxQuestLogSize; ++i)
-		{
-			QuestField field = Get<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)));
-			if (field.questId == 0)
-			{
-				continue;
-			}
+		const auto targets = m_questCreditIndex.Find(quest_credit_type::Item, entry.id());
 
-			// Check if the player really has accepted that quest
-			auto it = m_quests.find(field.questId);
-			if (it == m_quests.end())
+		// Targets are ordered by quest log slot, so all requirements of a quest are handled at once
+		for (size_t first = 0, last = 0; first < targets.size(); first = last)
+		{
+			const uint8 logSlot = targets[first].logSlot;
+			while (last < targets.size() && targets[last].logSlot == logSlot)
 			{
-				continue;
+				++last;
 			}
 
-			// Check if the quest was already completed
-			if (it->second.status != quest_status::Incomplete)
+			QuestField field;
+			QuestStatusData* data = GetIncompleteQuestData(logSlot, field);
+			if (!data)
 			{
 				continue;
 			}
 
-			// Get quest template entry
-			const auto* quest = GetProject().quests.getById(field.questId);
-			if (!quest)
-			{
-				continue;
-			}
+			const auto* quest = m_questCreditIndex.GetQuest(logSlot);
 
 			// If this is set to true, all requirements of this quest will be reevaluated, which costs
 			// some time. So this variable is only updated, if a quest requirement status changed between
 			// Completed and Uncomplete to save performance.
 			bool validateQuest = false;
 
-			// Check every quest entry requirement
-			for (const auto& req : quest->requirements())
+			// Check every quest requirement which needs this item
+			for (size_t i = first; i < last; ++i)
 			{
+				const auto& req = quest->requirements(targets[i].requirementIndex);
 				if (req.itemid() == entry.id())
 				{
 					if (m_inventory.GetItemCount(entry.id()) < req.itemcount())
@@ -897,12 +875,13 @@ namespace mmo
 				// Quest is fulfilled now
 				if (!FulfillsQuestRequirements(*quest))
 				{
-					it->second.status = quest_status::Incomplete;
+					data->status = quest_status::Incomplete;
 					field.status = quest_status::Incomplete;
-					if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestDataChanged(field.questId, it->second);
+					InvalidateQuestStatus();
+					if (m_netPlayerWatcher) m_netPlayerWatcher->OnQuestDataChanged(field.questId, *data);
 				}
 
-				Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), field);
+				Set<QuestField>(object_fields::QuestLogSlot_1 + logSlot * (sizeof(QuestField) / sizeof(uint32)), field);
 			}
 		}
 	}
@@ -912,6 +891,26 @@ namespace mmo
 		// TODO
 	}
 
+	QuestStatusData* GamePlayerS::GetIncompleteQuestData(const uint8 logSlot, QuestField& out_field)
+	{
+		out_field = Get<QuestField>(object_fields::QuestLogSlot_1 + logSlot * (sizeof(QuestField) / sizeof(uint32)));
+
+		const auto* quest = m_questCreditIndex.GetQuest(logSlot);
+		if (!quest || out_field.questId != quest->id())
+		{
+			return nullptr;
+		}
+
+		// Check if the player really has accepted that quest and did not complete it yet
+		const auto it = m_quests.find(out_field.questId);
+		if (it == m_quests.end() || it->second.status != quest_status::Incomplete)
+		{
+			return nullptr;
+		}
+
+		return &it->second;
+	}
+
 	bool GamePlayerS::NeedsQuestItem(uint32 itemId) const
 	{
 		// TODO
@@ -947,6 +946,8 @@ namespace mmo
 			it = m_quests.erase(it);
 		}
 
+		InvalidateQuestStatus();
+
 		// Persist in database
 		QuestStatusData completed;
 		completed.status = quest_status::Rewarded;
@@ -956,6 +957,7 @@ namespace mmo
 	void GamePlayerS::SetQuestData(uint32 questId, const QuestStatusData& data)
 	{
 		m_quests[questId] = data;
+		InvalidateQuestStatus();
 
 		for (uint8 i = 0; i < MaxQuestLogSize; ++i)
 		{
@@ -970,6 +972,11 @@ namespace mmo
 					field.counters[j] = data.creatures[j];
 				}
 				Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), field, false);
+
+				if (const auto* quest = GetProject().quests.getById(questId))
+				{
+					m_questCreditIndex.AddQuest(i, *quest);
+				}
 				break;
 			}
 		}
@@ -1136,6 +1143,7 @@ namespace mmo
 
 		// Adjust stats
 		GameUnitS::SetLevel(newLevel);
+		InvalidateQuestStatus();
 
 		// Update next level xp
 		uint32 xpToNextLevel = 400 * newLevel;		// Dummy default value
@@ -5,6 +5,7 @@
 
 #include "game_unit_s.h"
 #include "inventory.h"
+#include "quest_credit_index.h"
 #include "game/quest.h"
 
 namespace mmo
@@ -87,7 +88,7 @@ namespace mmo
 		uint64 GetGroupId() const { return m_groupId; }
 
 		/// Sets the characters group id.
-		void SetGroupId(uint64 groupId) { m_groupId = groupId; }
+		void SetGroupId(uint64 groupId);
 
 	public:
 
@@ -95,6 +96,10 @@ namespace mmo
 		/// @returns Quest status.
 		QuestStatus GetQuestStatus(uint32 quest) const;
 
+		/// Gets a counter which is incremented whenever something changes that quest statuses depend on, like the
+		/// quest log, the rewarded quests or the character level. Used to invalidate cached quest giver statuses.
+		uint32 GetQuestStatusVersion() const { return m_questStatusVersion; }
+
 		/// Accepts a new quest.
 		/// @returns false if this wasn't possible (maybe questlog was full or not all requirements are met).
 		bool AcceptQuest(uint32 quest);
@@ -167,6 +172,16 @@ namespace mmo
 
 		void RecalculateTotalAttributePointsConsumed(const uint32 attribute);
 
+	private:
+		/// Gets the quest data of the quest in a quest log slot if that quest is still incomplete.
+		/// @param logSlot The quest log slot.
+		/// @param out_field Receives the quest log field of the slot.
+		/// @returns nullptr if the slot does not hold an incomplete quest.
+		QuestStatusData* GetIncompleteQuestData(uint8 logSlot, QuestField& out_field);
+
+		/// Invalidates all cached quest statuses of this character.
+		void InvalidateQuestStatus() { ++m_questStatusVersion; }
+
 	protected:
 		void OnSpellLearned(const proto::SpellEntry& spell) override
 		{
@@ -193,6 +208,8 @@ namespace mmo
 		uint32 m_totalAvailablePointsAtLevel;
 		std::map<uint32, QuestStatusData> m_quests;
 		std::set<uint32> m_rewardedQuestIds;
+		QuestCreditIndex m_questCreditIndex;
+		uint32 m_questStatusVersion = 0;
 		NetPlayerWatcher* m_netPlayerWatcher = nullptr;
 		uint64 m_groupId = 0;
 
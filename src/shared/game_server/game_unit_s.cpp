@@ -119,20 +119,41 @@ namespace mmo
 		m_despawnCountdown.SetEnd(GetAsyncTimeMs() + despawnDelay);
 	}
 
+	namespace
+	{
+		/// Number of movement speeds written after the object part of a unit's update block.
+		constexpr size_t UpdateBlockSpeedCount = 8;
+
+		template <class W>
+		void WriteSpeeds(W& writer, const GameUnitS& unit)
+		{
+			writer
+				<< io::write<float>(unit.GetSpeed(movement_type::Walk))
+				<< io::write<float>(unit.GetSpeed(movement_type::Run))
+				<< io::write<float>(unit.GetSpeed(movement_type::Backwards))
+				<< io::write<float>(unit.GetSpeed(movement_type::Swim))
+				<< io::write<float>(unit.GetSpeed(movement_type::SwimBackwards))
+				<< io::write<float>(unit.GetSpeed(movement_type::Flight))
+				<< io::write<float>(unit.GetSpeed(movement_type::FlightBackwards))
+				<< io::write<float>(unit.GetSpeed(movement_type::Turn));
+		}
+	}
+
 	void GameUnitS::WriteObjectUpdateBlock(io::Writer& writer, bool creation) const
 	{
 		GameObjectS::WriteObjectUpdateBlock(writer, creation);
+		WriteSpeeds(writer, *this);
+	}
 
-		// Speeds
-		writer
-			<< io::write<float>(GetSpeed(movement_type::Walk))
-			<< io::write<float>(GetSpeed(movement_type::Run))
-			<< io::write<float>(GetSpeed(movement_type::Backwards))
-			<< io::write<float>(GetSpeed(movement_type::Swim))
-			<< io::write<float>(GetSpeed(movement_type::SwimBackwards))
-			<< io::write<float>(GetSpeed(movement_type::Flight))
-			<< io::write<float>(GetSpeed(movement_type::FlightBackwards))
-			<< io::write<float>(GetSpeed(movement_type::Turn));
+	void GameUnitS::WriteObjectUpdateBlock(io::BasicWriter<io::SectionSink>& writer) const
+	{
+		GameObjectS::WriteObjectUpdateBlock(writer);
+		WriteSpeeds(writer, *this);
+	}
+
+	size_t GameUnitS::GetChangesUpdateBlockSize() const
+	{
+		return GameObjectS::GetChangesUpdateBlockSize() + UpdateBlockSpeedCount * sizeof(float);
 	}
 
 	void GameUnitS::WriteValueUpdateBlock(io::Writer& writer, bool creation) const
@@ -336,6 +336,10 @@ namespace mmo
 
 		virtual void WriteObjectUpdateBlock(io::Writer& writer, bool creation = true) const override;
 
+		virtual void WriteObjectUpdateBlock(io::BasicWriter<io::SectionSink>& writer) const override;
+
+		[[nodiscard]] virtual size_t GetChangesUpdateBlockSize() const override;
+
 		virtual void WriteValueUpdateBlock(io::Writer& writer, bool creation = true) const override;
 
 		virtual bool HasMovementInfo() const override { return true; }
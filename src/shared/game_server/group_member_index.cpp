@@ -0,0 +1,87 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "group_member_index.h"
+
+#include "game_player_s.h"
+#include "base/macros.h"
+#include "game/circle.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	void GroupMemberIndex::AddMember(const uint64 groupId, GamePlayerS& member)
+	{
+		if (groupId == 0)
+		{
+			return;
+		}
+
+		auto& members = m_membersByGroup[groupId];
+		ASSERT(std::find(members.begin(), members.end(), &member) == members.end());
+		members.push_back(&member);
+	}
+
+	void GroupMemberIndex::RemoveMember(const uint64 groupId, GamePlayerS& member)
+	{
+		if (groupId == 0)
+		{
+			return;
+		}
+
+		const auto it = m_membersByGroup.find(groupId);
+		if (it == m_membersByGroup.end())
+		{
+			return;
+		}
+
+		std::erase(it->second, &member);
+		if (it->second.empty())
+		{
+			m_membersByGroup.erase(it);
+		}
+	}
+
+	void GroupMemberIndex::UpdateMember(GamePlayerS& member, const uint64 previousGroupId)
+	{
+		if (member.GetGroupId() == previousGroupId)
+		{
+			return;
+		}
+
+		RemoveMember(previousGroupId, member);
+		AddMember(member.GetGroupId(), member);
+	}
+
+	std::span<GamePlayerS* const> GroupMemberIndex::GetMembers(const uint64 groupId) const
+	{
+		const auto it = m_membersByGroup.find(groupId);
+		if (it == m_membersByGroup.end())
+		{
+			return {};
+		}
+
+		return it->second;
+	}
+
+	void GroupMemberIndex::FindNearbyMembers(const GamePlayerS& member, const float radius, std::vector<uint64>& out_guids) const
+	{
+		// Uses the same shape as unit finder queries so that the results match a search around the character
+		const Vector3& location = member.GetPosition();
+		const Circle circle(location.x, location.y, radius);
+
+		for (GamePlayerS* other : GetMembers(member.GetGroupId()))
+		{
+			if (other == &member)
+			{
+				continue;
+			}
+
+			const Vector3& otherLocation = other->GetPosition();
+			if (circle.IsPointInside(Point(otherLocation.x, otherLocation.y)))
+			{
+				out_guids.push_back(other->GetGuid());
+			}
+		}
+	}
+}
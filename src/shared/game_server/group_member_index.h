@@ -0,0 +1,46 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace mmo
+{
+	class GamePlayerS;
+
+	/// Keeps track of the characters of a world instance per group, so that group related lookups only have to look
+	/// at the members of a group instead of searching the whole area around a character.
+	class GroupMemberIndex final : public NonCopyable
+	{
+	public:
+		/// Adds a character to the members of a group. Characters without a group (group id 0) are not tracked.
+		void AddMember(uint64 groupId, GamePlayerS& member);
+
+		/// Removes a character from the members of a group.
+		void RemoveMember(uint64 groupId, GamePlayerS& member);
+
+		/// Moves a character from its previous group to its current group.
+		void UpdateMember(GamePlayerS& member, uint64 previousGroupId);
+
+		/// Gets all characters of a group in this world instance.
+		[[nodiscard]] std::span<GamePlayerS* const> GetMembers(uint64 groupId) const;
+
+		/// Finds the guids of all other members of the group of a character, whose planar distance to the character
+		/// is less than the given radius.
+		/// @param member The character whose group members should be found.
+		/// @param radius The search radius.
+		/// @param out_guids Receives the guids of the nearby group members. Is not cleared.
+		void FindNearbyMembers(const GamePlayerS& member, float radius, std::vector<uint64>& out_guids) const;
+
+		/// Gets the number of groups which have members in this world instance.
+		[[nodiscard]] size_t GetGroupCount() const { return m_membersByGroup.size(); }
+
+	private:
+		std::unordered_map<uint64, std::vector<GamePlayerS*>> m_membersByGroup;
+	};
+}
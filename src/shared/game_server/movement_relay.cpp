@@ -0,0 +1,159 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "movement_relay.h"
+
+#include "math/constants.h"
+
+#include <cmath>
+
+namespace mmo
+{
+	namespace
+	{
+		/// Watchers which did not receive anything for this long are forgotten.
+		constexpr GameTime WatcherTimeout = 30000;
+
+		/// Gets the absolute difference between two angles in radians, taking wrap around into account.
+		float GetAngleDifference(const Radian& a, const Radian& b)
+		{
+			const float difference = std::fmod(std::abs(a.GetValueRadians() - b.GetValueRadians()), TwoPi);
+			return difference > Pi ? TwoPi - difference : difference;
+		}
+	}
+
+	MovementRelay::MovementRelay(const MovementRelaySettings& settings)
+		: m_settings(settings)
+	{
+	}
+
+	void MovementRelay::BeginPacket(const MovementInfo& info, const float speed, const bool isStateChange)
+	{
+		m_info = info;
+		m_speed = speed;
+		m_isStateChange = isStateChange;
+
+		if (info.timestamp < m_lastPrune + WatcherTimeout)
+		{
+			return;
+		}
+
+		m_lastPrune = info.timestamp;
+		for (auto it = m_watchers.begin(); it != m_watchers.end(); )
+		{
+			if (it->second.lastRelayed.timestamp + WatcherTimeout < info.timestamp)
+			{
+				it = m_watchers.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	bool MovementRelay::ShouldRelayTo(const uint64 watcherGuid, const float distance, const bool isRelated)
+	{
+		auto [it, inserted] = m_watchers.try_emplace(watcherGuid);
+		WatcherState& watcher = it->second;
+
+		bool relay = inserted || m_isStateChange || isRelated || distance <= m_settings.fullRateDistance;
+
+		// Packets of an earlier client time than the one the watcher knows are relayed to resynchronize it
+		if (!relay && m_info.timestamp <= watcher.lastRelayed.timestamp)
+		{
+			relay = true;
+		}
+
+		if (!relay)
+		{
+			const GameTime elapsed = m_info.timestamp - watcher.lastRelayed.timestamp;
+			const GameTime interval = distance <= m_settings.reducedRateDistance ? m_settings.reducedRateInterval : m_settings.distantInterval;
+
+			relay = elapsed >= interval;
+			if (!relay)
+			{
+				const Vector3 extrapolated = ExtrapolatePosition(watcher.lastRelayed, watcher.speed, elapsed);
+				relay = (extrapolated - m_info.position).GetSquaredLength() > m_settings.maxPositionError * m_settings.maxPositionError ||
+					GetAngleDifference(watcher.lastRelayed.facing, m_info.facing) > m_settings.maxFacingError;
+			}
+		}
+
+		if (relay)
+		{
+			watcher.lastRelayed = m_info;
+			watcher.speed = m_speed;
+		}
+
+		return relay;
+	}
+
+	void MovementRelay::Reset()
+	{
+		m_watchers.clear();
+	}
+
+	MovementType MovementRelay::GetMovementType(const MovementInfo& info)
+	{
+		const bool backwards = (info.movementFlags & movement_flags::Backward) != 0;
+
+		if (info.movementFlags & movement_flags::Flying)
+		{
+			return backwards ? movement_type::FlightBackwards : movement_type::Flight;
+		}
+
+		if (info.movementFlags & movement_flags::Swimming)
+		{
+			return backwards ? movement_type::SwimBackwards : movement_type::Swim;
+		}
+
+		if (backwards)
+		{
+			return movement_type::Backwards;
+		}
+
+		return (info.movementFlags & movement_flags::WalkMode) ? movement_type::Walk : movement_type::Run;
+	}
+
+	Vector3 MovementRelay::ExtrapolatePosition(const MovementInfo& info, const float speed, const GameTime elapsed)
+	{
+		if (!info.IsMoving() || (info.movementFlags & movement_flags::Rooted))
+		{
+			return info.position;
+		}
+
+		// Movement direction relative to the facing, with x pointing forward and z to the right
+		Vector3 direction;
+		if (info.movementFlags & movement_flags::Forward)
+		{
+			direction.x += 1.0f;
+		}
+		if (info.movementFlags & movement_flags::Backward)
+		{
+			direction.x -= 1.0f;
+		}
+		if (info.movementFlags & movement_flags::StrafeLeft)
+		{
+			direction.z -= 1.0f;
+		}
+		if (info.movementFlags & movement_flags::StrafeRight)
+		{
+			direction.z += 1.0f;
+		}
+
+		if (direction.GetSquaredLength() <= 0.0f)
+		{
+			return info.position;
+		}
+
+		direction.Normalize();
+
+		const float cosFacing = std::cos(info.facing.GetValueRadians());
+		const float sinFacing = std::sin(info.facing.GetValueRadians());
+		const Vector3 worldDirection(
+			direction.x * cosFacing + direction.z * sinFacing,
+			0.0f,
+			direction.z * cosFacing - direction.x * sinFacing);
+
+		return info.position + worldDirection * (speed * static_cast<float>(elapsed) / 1000.0f);
+	}
+}
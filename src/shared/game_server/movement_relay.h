@@ -0,0 +1,84 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+#include "game/movement_info.h"
+
+#include <unordered_map>
+
+namespace mmo
+{
+	/// Settings which control how often movement packets of a player are relayed to the units watching it.
+	struct MovementRelaySettings
+	{
+		/// Watchers within this distance receive every movement packet.
+		float fullRateDistance = 30.0f;
+		/// Watchers within this distance (but beyond fullRateDistance) receive heartbeats at most every
+		/// reducedRateInterval milliseconds.
+		float reducedRateDistance = 60.0f;
+		/// Minimum time in milliseconds between heartbeats relayed to watchers within reducedRateDistance.
+		GameTime reducedRateInterval = 1000;
+		/// Minimum time in milliseconds between heartbeats relayed to watchers beyond reducedRateDistance.
+		GameTime distantInterval = 2000;
+		/// Heartbeats are relayed regardless of the interval if the position a watcher extrapolates from the last
+		/// packet it received is off by more than this distance.
+		float maxPositionError = 1.5f;
+		/// Heartbeats are relayed regardless of the interval if the facing a watcher knows is off by more than
+		/// this angle in radians.
+		float maxFacingError = 0.35f;
+	};
+
+	/// Decides which watchers of a moving player receive a movement packet. Movement state transitions (start, stop,
+	/// jump, landing...) always go out to everybody, as do packets to nearby or related watchers. Heartbeats to
+	/// distant watchers are down-sampled by distance, unless the watcher's extrapolated position of the player
+	/// drifted too far from the real one.
+	class MovementRelay final : public NonCopyable
+	{
+	public:
+		explicit MovementRelay(const MovementRelaySettings& settings = MovementRelaySettings());
+
+	public:
+		/// Starts relaying a movement packet.
+		/// @param info The movement info of the packet.
+		/// @param speed Speed of the moving unit in units per second for its current movement.
+		/// @param isStateChange true if the packet changes the movement state and thus has to be received by everybody.
+		void BeginPacket(const MovementInfo& info, float speed, bool isStateChange);
+
+		/// Determines if the current packet is relayed to a watcher and remembers what the watcher knows if so.
+		/// @param watcherGuid Guid of the watching unit.
+		/// @param distance Distance between the watching unit and the moving unit.
+		/// @param isRelated true if the watcher is a group member, targets the moving unit or is targeted by it.
+		bool ShouldRelayTo(uint64 watcherGuid, float distance, bool isRelated);
+
+		/// Forgets everything about all watchers, so that the next packet goes out to everybody.
+		void Reset();
+
+		[[nodiscard]] const MovementRelaySettings& GetSettings() const noexcept { return m_settings; }
+
+		/// Gets the movement type whose speed applies to the given movement.
+		static MovementType GetMovementType(const MovementInfo& info);
+
+		/// Extrapolates the position of a unit from a movement snapshot, assuming it keeps its movement flags.
+		/// @param info The movement snapshot.
+		/// @param speed Speed of the unit in units per second for its movement.
+		/// @param elapsed Time in milliseconds since the snapshot.
+		static Vector3 ExtrapolatePosition(const MovementInfo& info, float speed, GameTime elapsed);
+
+	private:
+		/// What a watcher knows about the movement of the player.
+		struct WatcherState
+		{
+			MovementInfo lastRelayed;
+			float speed;
+		};
+
+		MovementRelaySettings m_settings;
+		std::unordered_map<uint64, WatcherState> m_watchers;
+		MovementInfo m_info;
+		float m_speed { 0.0f };
+		bool m_isStateChange { true };
+		GameTime m_lastPrune { 0 };
+	};
+}
@@ -0,0 +1,108 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "quest_credit_index.h"
+
+#include "base/macros.h"
+#include "proto_data/project.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	void QuestCreditIndex::AddQuest(const uint8 logSlot, const proto::QuestEntry& quest)
+	{
+		ASSERT(logSlot < m_quests.size());
+
+		RemoveQuest(logSlot);
+		m_quests[logSlot] = &quest;
+
+		for (int i = 0; i < quest.requirements_size(); ++i)
+		{
+			const auto& requirement = quest.requirements(i);
+			const QuestCreditTarget target { logSlot, static_cast<uint8>(i) };
+
+			if (requirement.creatureid() != 0)
+			{
+				AddTarget(quest_credit_type::Creature, requirement.creatureid(), target);
+			}
+			if (requirement.itemid() != 0)
+			{
+				AddTarget(quest_credit_type::Item, requirement.itemid(), target);
+			}
+			if (requirement.sourceid() != 0)
+			{
+				AddTarget(quest_credit_type::Item, requirement.sourceid(), target);
+			}
+		}
+	}
+
+	void QuestCreditIndex::RemoveQuest(const uint8 logSlot)
+	{
+		ASSERT(logSlot < m_quests.size());
+
+		const proto::QuestEntry* quest = m_quests[logSlot];
+		if (!quest)
+		{
+			return;
+		}
+
+		m_quests[logSlot] = nullptr;
+
+		const auto removeSlot = [this, logSlot](const QuestCreditType type, const uint32 entry)
+		{
+			const auto it = m_targets.find(MakeKey(type, entry));
+			if (it == m_targets.end())
+			{
+				return;
+			}
+
+			std::erase_if(it->second, [logSlot](const QuestCreditTarget& target) { return target.logSlot == logSlot; });
+			if (it->second.empty())
+			{
+				m_targets.erase(it);
+			}
+		};
+
+		for (const auto& requirement : quest->requirements())
+		{
+			removeSlot(quest_credit_type::Creature, requirement.creatureid());
+			removeSlot(quest_credit_type::Item, requirement.itemid());
+			removeSlot(quest_credit_type::Item, requirement.sourceid());
+		}
+	}
+
+	void QuestCreditIndex::Clear()
+	{
+		m_targets.clear();
+		m_quests.fill(nullptr);
+	}
+
+	std::span<const QuestCreditTarget> QuestCreditIndex::Find(const QuestCreditType type, const uint32 entry) const
+	{
+		const auto it = m_targets.find(MakeKey(type, entry));
+		if (it == m_targets.end())
+		{
+			return {};
+		}
+
+		return it->second;
+	}
+
+	void QuestCreditIndex::AddTarget(const QuestCreditType type, const uint32 entry, const QuestCreditTarget& target)
+	{
+		auto& targets = m_targets[MakeKey(type, entry)];
+
+		const auto it = std::lower_bound(targets.begin(), targets.end(), target, [](const QuestCreditTarget& a, const QuestCreditTarget& b)
+		{
+			return a.logSlot != b.logSlot ? a.logSlot < b.logSlot : a.requirementIndex < b.requirementIndex;
+		});
+
+		// A requirement which needs the same item as quest item and as source item is only listed once
+		if (it != targets.end() && it->logSlot == target.logSlot && it->requirementIndex == target.requirementIndex)
+		{
+			return;
+		}
+
+		targets.insert(it, target);
+	}
+}
@@ -0,0 +1,76 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+#include "game/quest.h"
+
+#include <array>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace mmo
+{
+	namespace proto
+	{
+		class QuestEntry;
+	}
+
+	/// Kinds of entries which give credit to quest requirements.
+	namespace quest_credit_type
+	{
+		enum Type
+		{
+			/// A creature entry which has to be killed.
+			Creature,
+			/// An item entry which has to be collected, either as quest item or as source item.
+			Item,
+
+			Count_
+		};
+	}
+
+	typedef quest_credit_type::Type QuestCreditType;
+
+	/// A quest requirement which cares about a credit entry.
+	struct QuestCreditTarget
+	{
+		/// Index of the quest log slot of the quest.
+		uint8 logSlot;
+		/// Index of the requirement in the quest entry.
+		uint8 requirementIndex;
+	};
+
+	/// Maps creature and item entries to the quest log requirements which care about them, so that credit events of
+	/// a player only have to look at the quests they are relevant for. Object and spell cast requirements don't give
+	/// credit yet and are not indexed.
+	class QuestCreditIndex final : public NonCopyable
+	{
+	public:
+		/// Adds the requirements of a quest in a quest log slot. Replaces the quest previously in that slot.
+		void AddQuest(uint8 logSlot, const proto::QuestEntry& quest);
+
+		/// Removes the requirements of the quest in a quest log slot.
+		void RemoveQuest(uint8 logSlot);
+
+		/// Removes all quests.
+		void Clear();
+
+		/// Gets all requirements which care about an entry, ordered by quest log slot and requirement index.
+		[[nodiscard]] std::span<const QuestCreditTarget> Find(QuestCreditType type, uint32 entry) const;
+
+		/// Gets the quest in a quest log slot or nullptr if the slot is not indexed.
+		[[nodiscard]] const proto::QuestEntry* GetQuest(const uint8 logSlot) const { return logSlot < m_quests.size() ? m_quests[logSlot] : nullptr; }
+
+	private:
+		static uint64 MakeKey(const QuestCreditType type, const uint32 entry) { return (static_cast<uint64>(type) << 32) | entry; }
+
+		void AddTarget(QuestCreditType type, uint32 entry, const QuestCreditTarget& target);
+
+	private:
+		std::unordered_map<uint64, std::vector<QuestCreditTarget>> m_targets;
+		std::array<const proto::QuestEntry*, MaxQuestLogSize> m_quests {};
+	};
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "quest_giver_status_cache.h"
+
+#include "game_creature_s.h"
+#include "game_player_s.h"
+#include "proto_data/project.h"
+
+namespace mmo
+{
+	QuestgiverStatus QuestGiverStatusCache::Get(const proto::UnitEntry& entry, const GamePlayerS& player)
+	{
+		// Statuses of another character or from before the last quest relevant change are outdated
+		if (player.GetGuid() != m_playerGuid || player.GetQuestStatusVersion() != m_questStatusVersion)
+		{
+			m_statusByEntry.clear();
+			m_playerGuid = player.GetGuid();
+			m_questStatusVersion = player.GetQuestStatusVersion();
+		}
+
+		if (const auto it = m_statusByEntry.find(entry.id()); it != m_statusByEntry.end())
+		{
+			return it->second;
+		}
+
+		const QuestgiverStatus status = GameCreatureS::GetQuestGiverStatus(entry, player);
+		m_statusByEntry.emplace(entry.id(), status);
+		return status;
+	}
+
+	void QuestGiverStatusCache::Clear()
+	{
+		m_statusByEntry.clear();
+		m_playerGuid = 0;
+		m_questStatusVersion = 0;
+	}
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+#include "game/quest.h"
+
+#include <unordered_map>
+
+namespace mmo
+{
+	namespace proto
+	{
+		class UnitEntry;
+	}
+
+	class GamePlayerS;
+
+	/// Caches the quest giver statuses of creature entries for a single player. Cached statuses are dropped as soon as
+	/// the quest status version of the player changes, so they are only evaluated again after the quest log, the
+	/// rewarded quests or the character level changed.
+	class QuestGiverStatusCache final : public NonCopyable
+	{
+	public:
+		/// Gets the quest giver status of a creature entry for a player, evaluating it only if it is not cached.
+		QuestgiverStatus Get(const proto::UnitEntry& entry, const GamePlayerS& player);
+
+		/// Removes all cached statuses.
+		void Clear();
+
+	private:
+		std::unordered_map<uint32, QuestgiverStatus> m_statusByEntry;
+		uint64 m_playerGuid = 0;
+		uint32 m_questStatusVersion = 0;
+	};
+}
@@ -4,10 +4,15 @@
 #include "game_item_s.h"
 #include "game_player_s.h"
 #include "no_cast_state.h"
+#include "spell_effect_plan.h"
+#include "world_instance_manager.h"
 
+#include "base/trace_profiler.h"
 #include "base/utilities.h"
 #include "proto_data/project.h"
 
+#include <optional>
+
 namespace mmo
 {
 	SingleCastState::SingleCastState(SpellCast& cast, const proto::SpellEntry& spell, const SpellTargetMap& target, const GameTime castTime, const bool isProc, uint64 itemGuid)
@@ -519,8 +524,58 @@ namespace mmo
 		}
 	}
 
+	const std::array<SingleCastState::EffectHandler, spell_effects::Count_>& SingleCastState::GetEffectHandlers()
+	{
+		static const auto handlers = []()
+		{
+			namespace se = spell_effects;
+
+			std::array<EffectHandler, se::Count_> result{};
+			result[se::Dummy] = &SingleCastState::SpellEffectDummy;
+			result[se::InstantKill] = &SingleCastState::SpellEffectInstantKill;
+			result[se::PowerDrain] = &SingleCastState::SpellEffectDrainPower;
+			result[se::Heal] = &SingleCastState::SpellEffectHeal;
+			result[se::Bind] = &SingleCastState::SpellEffectBind;
+			result[se::QuestComplete] = &SingleCastState::SpellEffectQuestComplete;
+			result[se::WeaponDamageNoSchool] = &SingleCastState::SpellEffectWeaponDamageNoSchool;
+			result[se::CreateItem] = &SingleCastState::SpellEffectCreateItem;
+			result[se::WeaponDamage] = &SingleCastState::SpellEffectWeaponDamage;
+			result[se::TeleportUnits] = &SingleCastState::SpellEffectTeleportUnits;
+			result[se::Energize] = &SingleCastState::SpellEffectEnergize;
+			result[se::WeaponPercentDamage] = &SingleCastState::SpellEffectWeaponPercentDamage;
+			result[se::OpenLock] = &SingleCastState::SpellEffectOpenLock;
+			result[se::Dispel] = &SingleCastState::SpellEffectDispel;
+			result[se::Summon] = &SingleCastState::SpellEffectSummon;
+			result[se::SummonPet] = &SingleCastState::SpellEffectSummonPet;
+			result[se::LearnSpell] = &SingleCastState::SpellEffectLearnSpell;
+			result[se::Resurrect] = &SingleCastState::SpellEffectResurrect;
+			result[se::ApplyAura] = &SingleCastState::SpellEffectApplyAura;
+			result[se::PersistentAreaAura] = &SingleCastState::SpellEffectPersistentAreaAura;
+			result[se::SchoolDamage] = &SingleCastState::SpellEffectSchoolDamage;
+			result[se::ResetAttributePoints] = &SingleCastState::SpellEffectResetAttributePoints;
+			result[se::Parry] = &SingleCastState::SpellEffectParry;
+			result[se::Block] = &SingleCastState::SpellEffectBlock;
+			result[se::Dodge] = &SingleCastState::SpellEffectDodge;
+			result[se::HealPct] = &SingleCastState::SpellEffectHealPct;
+			result[se::AddExtraAttacks] = &SingleCastState::SpellEffectAddExtraAttacks;
+			result[se::Charge] = &SingleCastState::SpellEffectCharge;
+
+			// Every effect type of the execution order needs a handler
+			for (const auto type : SpellEffectExecutionOrder)
+			{
+				ASSERT(result[type]);
+			}
+
+			return result;
+		}();
+
+		return handlers;
+	}
+
 	void SingleCastState::ApplyAllEffects()
 	{
+		TRACE_SCOPE("SingleCastState::ApplyAllEffects");
+
 		// Add spell cooldown if any
 		const uint64 spellCatCD = m_spell.categorycooldown();
 		const uint64 spellCD = m_spell.cooldown();
@@ -542,62 +597,30 @@ namespace mmo
 		// Make sure that this isn't destroyed during the effects
 		auto strong = shared_from_this();
 
-		std::vector<uint32> effects;
-		for (int i = 0; i < m_spell.effects_size(); ++i)
-		{
-			effects.push_back(m_spell.effects(i).type());
-		}
-
 		m_canTrigger = true;
 
-		namespace se = spell_effects;
-
-		std::vector<std::pair<uint32, EffectHandler>> effectMap{
-			{se::Dummy,					std::bind(&SingleCastState::SpellEffectDummy, this, std::placeholders::_1) },
-			{se::InstantKill,				std::bind(&SingleCastState::SpellEffectInstantKill, this, std::placeholders::_1)},
-			{se::PowerDrain,				std::bind(&SingleCastState::SpellEffectDrainPower, this, std::placeholders::_1)},
-			{se::Heal,					std::bind(&SingleCastState::SpellEffectHeal, this, std::placeholders::_1)},
-			{se::Bind,					std::bind(&SingleCastState::SpellEffectBind, this, std::placeholders::_1)},
-			{se::QuestComplete,			std::bind(&SingleCastState::SpellEffectQuestComplete, this, std::placeholders::_1)},
-			{se::WeaponDamageNoSchool,	std::bind(&SingleCastState::SpellEffectWeaponDamageNoSchool, this, std::placeholders::_1)},
-			{se::CreateItem,				std::bind(&SingleCastState::SpellEffectCreateItem, this, std::placeholders::_1)},
-			{se::WeaponDamage,			std::bind(&SingleCastState::SpellEffectWeaponDamage, this, std::placeholders::_1)},
-			{se::TeleportUnits,			std::bind(&SingleCastState::SpellEffectTeleportUnits, this, std::placeholders::_1)},
-			{se::Energize,				std::bind(&SingleCastState::SpellEffectEnergize, this, std::placeholders::_1)},
-			{se::WeaponPercentDamage,		std::bind(&SingleCastState::SpellEffectWeaponPercentDamage, this, std::placeholders::_1)},
-			{se::OpenLock,				std::bind(&SingleCastState::SpellEffectOpenLock, this, std::placeholders::_1)},
-			{se::Dispel,					std::bind(&SingleCastState::SpellEffectDispel, this, std::placeholders::_1)},
-			{se::Summon,					std::bind(&SingleCastState::SpellEffectSummon, this, std::placeholders::_1)},
-			{se::SummonPet,				std::bind(&SingleCastState::SpellEffectSummonPet, this, std::placeholders::_1) },
-			{se::LearnSpell,				std::bind(&SingleCastState::SpellEffectLearnSpell, this, std::placeholders::_1) },
-			{se::Resurrect,				std::bind(&SingleCastState::SpellEffectResurrect, this, std::placeholders::_1) },
-			{se::ApplyAura,				std::bind(&SingleCastState::SpellEffectApplyAura, this, std::placeholders::_1)},
-			{se::PersistentAreaAura,		std::bind(&SingleCastState::SpellEffectPersistentAreaAura, this, std::placeholders::_1) },
-			{se::SchoolDamage,			std::bind(&SingleCastState::SpellEffectSchoolDamage, this, std::placeholders::_1)},
-			{se::ResetAttributePoints,	std::bind(&SingleCastState::SpellEffectResetAttributePoints, this, std::placeholders::_1)},
-			{se::Parry,					std::bind(&SingleCastState::SpellEffectParry, this, std::placeholders::_1)},
-			{se::Block,					std::bind(&SingleCastState::SpellEffectBlock, this, std::placeholders::_1)},
-			{se::Dodge,					std::bind(&SingleCastState::SpellEffectDodge, this, std::placeholders::_1)},
-			{se::HealPct,					std::bind(&SingleCastState::SpellEffectHealPct, this, std::placeholders::_1)},
-			{se::AddExtraAttacks,			std::bind(&SingleCastState::SpellEffectAddExtraAttacks, this, std::placeholders::_1)},
-			{se::Charge,					std::bind(&SingleCastState::SpellEffectCharge, this, std::placeholders::_1)}
-		};
-
 		// Make sure that the executer exists after all effects have been executed
 		auto strongCaster = std::static_pointer_cast<GameUnitS>(m_cast.GetExecuter().shared_from_this());
 
 		if (!m_delayedCast)
 		{
-			for (auto& effect : effectMap)
+			const SpellEffectPlan* plan = nullptr;
+			if (const WorldInstance* worldInstance = m_cast.GetExecuter().GetWorldInstance())
 			{
-				for (int k = 0; k < effects.size(); ++k)
-				{
-					if (effect.first == effects[k])
-					{
-						ASSERT(effect.second);
-						effect.second(m_spell.effects(k));
-					}
-				}
+				plan = worldInstance->GetManager().GetSpellEffectPlans().Find(m_spell.id());
+			}
+
+			// Spells which aren't part of the project are planned for this cast only
+			std::optional<SpellEffectPlan> castPlan;
+			if (!plan)
+			{
+				plan = &castPlan.emplace(m_spell);
+			}
+
+			const auto& handlers = GetEffectHandlers();
+			for (const auto& step : plan->GetSteps())
+			{
+				(this->*handlers[step.type])(m_spell.effects(step.effectIndex));
 			}
 
 			m_delayedCast = true;
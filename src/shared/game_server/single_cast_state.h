@@ -2,6 +2,7 @@
 
 #include "base/typedefs.h"
 
+#include <array>
 #include <map>
 
 #include "aura_container.h"
@@ -251,6 +252,9 @@ namespace mmo
 		std::map<GameUnitS*, std::unique_ptr<AuraContainer>> m_targetAuraContainers;
 		uint64 m_itemGuid;
 
-		typedef std::function<void(const proto::SpellEffect&)> EffectHandler;
+		typedef void (SingleCastState::*EffectHandler)(const proto::SpellEffect&);
+
+		/// Gets the handler of every spell effect type, indexed by type. Effect types without handler are null.
+		static const std::array<EffectHandler, spell_effects::Count_>& GetEffectHandlers();
 	};
 }
@@ -6,6 +6,7 @@
 #include "no_cast_state.h"
 #include "single_cast_state.h"
 #include "log/default_log_levels.h"
+#include "base/trace_profiler.h"
 
 namespace mmo
 {
@@ -27,6 +28,8 @@ namespace mmo
 
 	std::pair<SpellCastResult, SpellCasting*> SpellCast::StartCast(const proto::SpellEntry& spell, const SpellTargetMap& target, const GameTime castTime, bool isProc, uint64 itemGuid)
 	{
+		TRACE_SCOPE("SpellCast::StartCast");
+
 		ASSERT(m_castState);
 
 		// TODO: all kind of checks
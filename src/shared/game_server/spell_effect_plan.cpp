@@ -0,0 +1,108 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "spell_effect_plan.h"
+
+#include "proto_data/project.h"
+
+namespace mmo
+{
+	namespace se = spell_effects;
+
+	const std::array<SpellEffect, 28> SpellEffectExecutionOrder {
+		se::Dummy,
+		se::InstantKill,
+		se::PowerDrain,
+		se::Heal,
+		se::Bind,
+		se::QuestComplete,
+		se::WeaponDamageNoSchool,
+		se::CreateItem,
+		se::WeaponDamage,
+		se::TeleportUnits,
+		se::Energize,
+		se::WeaponPercentDamage,
+		se::OpenLock,
+		se::Dispel,
+		se::Summon,
+		se::SummonPet,
+		se::LearnSpell,
+		se::Resurrect,
+		se::ApplyAura,
+		se::PersistentAreaAura,
+		se::SchoolDamage,
+		se::ResetAttributePoints,
+		se::Parry,
+		se::Block,
+		se::Dodge,
+		se::HealPct,
+		se::AddExtraAttacks,
+		se::Charge
+	};
+
+	namespace
+	{
+		/// Gets the position of every effect type in SpellEffectExecutionOrder, or -1 for effect types without handler.
+		const std::array<int, se::Count_>& GetExecutionRanks()
+		{
+			static const auto ranks = []()
+			{
+				std::array<int, se::Count_> result;
+				result.fill(-1);
+
+				for (size_t i = 0; i < SpellEffectExecutionOrder.size(); ++i)
+				{
+					result[SpellEffectExecutionOrder[i]] = static_cast<int>(i);
+				}
+
+				return result;
+			}();
+
+			return ranks;
+		}
+	}
+
+	SpellEffectPlan::SpellEffectPlan(const proto::SpellEntry& spell)
+		: m_spellId(spell.id())
+	{
+		const auto& ranks = GetExecutionRanks();
+
+		// Bucket the effects by the rank of their type. Iterating effects in order keeps effects of the same type in
+		// the order they are listed in the spell.
+		std::array<std::vector<int>, SpellEffectExecutionOrder.size()> buckets;
+		for (int i = 0; i < spell.effects_size(); ++i)
+		{
+			const uint32 type = spell.effects(i).type();
+			if (type >= se::Count_ || ranks[type] < 0)
+			{
+				continue;
+			}
+
+			buckets[ranks[type]].push_back(i);
+		}
+
+		for (size_t rank = 0; rank < buckets.size(); ++rank)
+		{
+			for (const int effectIndex : buckets[rank])
+			{
+				m_steps.push_back({ SpellEffectExecutionOrder[rank], effectIndex });
+			}
+		}
+	}
+
+	SpellEffectPlans::SpellEffectPlans(const proto::Project& project)
+	{
+		const auto& spells = project.spells.getTemplates().entry();
+
+		m_plans.reserve(spells.size());
+		for (const auto& spell : spells)
+		{
+			m_plans.emplace(spell.id(), SpellEffectPlan(spell));
+		}
+	}
+
+	const SpellEffectPlan* SpellEffectPlans::Find(const uint32 spellId) const
+	{
+		const auto it = m_plans.find(spellId);
+		return it != m_plans.end() ? &it->second : nullptr;
+	}
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+#include "game/spell.h"
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace mmo
+{
+	namespace proto
+	{
+		class Project;
+		class SpellEntry;
+	}
+
+	/// Order in which spell effect types are executed when a spell is cast. Effects of the same type are executed in
+	/// the order they are listed in the spell. Effect types which are not listed here have no handler and are skipped.
+	extern const std::array<SpellEffect, 28> SpellEffectExecutionOrder;
+
+	/// The effects of a spell resolved into the order in which they are executed, so that casting a spell does not
+	/// need to match effects against handlers again.
+	class SpellEffectPlan final
+	{
+	public:
+		/// A single effect execution.
+		struct Step
+		{
+			/// Type of the executed effect.
+			SpellEffect type;
+			/// Index of the effect in the spell entry.
+			int effectIndex;
+		};
+
+	public:
+		explicit SpellEffectPlan(const proto::SpellEntry& spell);
+
+	public:
+		/// Gets the id of the spell this plan has been built for.
+		[[nodiscard]] uint32 GetSpellId() const noexcept { return m_spellId; }
+
+		/// Gets the effect executions in order.
+		[[nodiscard]] const std::vector<Step>& GetSteps() const noexcept { return m_steps; }
+
+	private:
+		uint32 m_spellId;
+		std::vector<Step> m_steps;
+	};
+
+	/// The effect plans of all spells of a project. Plans are built once when the project has been loaded and live
+	/// as long as the project, which is not modified afterwards.
+	class SpellEffectPlans final : public NonCopyable
+	{
+	public:
+		explicit SpellEffectPlans(const proto::Project& project);
+
+	public:
+		/// Gets the plan of a spell of the project or nullptr if the project has no spell with that id.
+		[[nodiscard]] const SpellEffectPlan* Find(uint32 spellId) const;
+
+		/// Gets the number of plans.
+		[[nodiscard]] size_t GetSize() const noexcept { return m_plans.size(); }
+
+	private:
+		std::unordered_map<uint32, SpellEffectPlan> m_plans;
+	};
+}
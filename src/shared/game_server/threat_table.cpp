@@ -0,0 +1,148 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "threat_table.h"
+
+#include "game_unit_s.h"
+
+namespace mmo
+{
+	bool ThreatTable::AddThreat(GameUnitS& threatener, const float amount)
+	{
+		const uint64 guid = threatener.GetGuid();
+
+		size_t index = FindIndex(guid);
+		const bool added = index == InvalidIndex;
+		if (added)
+		{
+			index = m_entries.size();
+			m_entries.push_back({ guid, std::static_pointer_cast<GameUnitS>(threatener.shared_from_this()), 0.0f });
+		}
+
+		Entry& entry = m_entries[index];
+		entry.amount += amount;
+
+		// Threat only grows here, so the entry either overtakes the top entry or nothing changes
+		if (m_topIndex != InvalidIndex && m_topIndex != index && RanksAbove(entry, m_entries[m_topIndex]))
+		{
+			m_topIndex = index;
+		}
+
+		return added;
+	}
+
+	bool ThreatTable::Remove(const uint64 guid)
+	{
+		const size_t index = FindIndex(guid);
+		if (index == InvalidIndex)
+		{
+			return false;
+		}
+
+		const size_t last = m_entries.size() - 1;
+		if (index != last)
+		{
+			m_entries[index] = std::move(m_entries[last]);
+		}
+		m_entries.pop_back();
+
+		if (m_topIndex == index)
+		{
+			m_topIndex = InvalidIndex;
+		}
+		else if (m_topIndex == last)
+		{
+			m_topIndex = index;
+		}
+
+		return true;
+	}
+
+	void ThreatTable::Clear()
+	{
+		m_entries.clear();
+		m_topIndex = InvalidIndex;
+	}
+
+	float ThreatTable::GetThreat(const uint64 guid) const
+	{
+		const size_t index = FindIndex(guid);
+		return index == InvalidIndex ? 0.0f : m_entries[index].amount;
+	}
+
+	void ThreatTable::SetThreat(const uint64 guid, const float amount)
+	{
+		const size_t index = FindIndex(guid);
+		if (index == InvalidIndex)
+		{
+			return;
+		}
+
+		Entry& entry = m_entries[index];
+		const bool decreased = amount < entry.amount;
+		entry.amount = amount;
+
+		if (m_topIndex == InvalidIndex)
+		{
+			return;
+		}
+
+		if (m_topIndex == index)
+		{
+			// Another entry might be the top entry now
+			if (decreased)
+			{
+				m_topIndex = InvalidIndex;
+			}
+		}
+		else if (RanksAbove(entry, m_entries[m_topIndex]))
+		{
+			m_topIndex = index;
+		}
+	}
+
+	GameUnitS* ThreatTable::GetTopThreatener()
+	{
+		if (m_topIndex != InvalidIndex)
+		{
+			if (const auto threatener = m_entries[m_topIndex].threatener.lock())
+			{
+				return threatener.get();
+			}
+		}
+
+		RefreshTop();
+		return m_topIndex == InvalidIndex ? nullptr : m_entries[m_topIndex].threatener.lock().get();
+	}
+
+	size_t ThreatTable::FindIndex(const uint64 guid) const
+	{
+		for (size_t i = 0; i < m_entries.size(); ++i)
+		{
+			if (m_entries[i].guid == guid)
+			{
+				return i;
+			}
+		}
+
+		return InvalidIndex;
+	}
+
+	void ThreatTable::RefreshTop()
+	{
+		m_topIndex = InvalidIndex;
+
+		for (size_t i = 0; i < m_entries.size(); ++i)
+		{
+			// Units which no longer exist can't be attacked
+			if (m_entries[i].threatener.expired())
+			{
+				continue;
+			}
+
+			if (m_topIndex == InvalidIndex || RanksAbove(m_entries[i], m_entries[m_topIndex]))
+			{
+				m_topIndex = i;
+			}
+		}
+	}
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+
+#include <memory>
+#include <vector>
+
+namespace mmo
+{
+	class GameUnitS;
+
+	/// Stores the threat of all units a creature is in combat with. Entries are kept in a flat array and the entry
+	/// with the most threat is maintained while threat is added, so that looking up the top threatener does not need
+	/// to look at every entry.
+	class ThreatTable final : public NonCopyable
+	{
+	public:
+		/// Represents an entry in the threat table.
+		struct Entry
+		{
+			/// Guid of the threatening unit.
+			uint64 guid;
+			/// Threatening unit.
+			std::weak_ptr<GameUnitS> threatener;
+			/// Total threat amount of the unit.
+			float amount;
+		};
+
+		typedef std::vector<Entry>::const_iterator const_iterator;
+
+	public:
+		/// Adds threat of a unit. Adds the unit to the threat table if it isn't already added.
+		/// @param threatener The threatening unit.
+		/// @param amount The threat amount to add, which may be 0.
+		/// @returns true if the unit was added to the threat table.
+		bool AddThreat(GameUnitS& threatener, float amount);
+
+		/// Removes a unit from the threat table.
+		/// @returns true if the unit was part of the threat table.
+		bool Remove(uint64 guid);
+
+		/// Removes all units from the threat table.
+		void Clear();
+
+		/// Gets the threat amount of a unit or 0.0f if the unit is not part of the threat table.
+		[[nodiscard]] float GetThreat(uint64 guid) const;
+
+		/// Sets the threat amount of a unit which is part of the threat table.
+		void SetThreat(uint64 guid, float amount);
+
+		/// Gets the living unit with the most threat. If multiple units have the same amount of threat, the one with
+		/// the lowest guid is returned.
+		/// @returns The top threatener or nullptr if there is none.
+		[[nodiscard]] GameUnitS* GetTopThreatener();
+
+		[[nodiscard]] bool IsEmpty() const { return m_entries.empty(); }
+
+		[[nodiscard]] size_t GetSize() const { return m_entries.size(); }
+
+		[[nodiscard]] const_iterator begin() const { return m_entries.begin(); }
+
+		[[nodiscard]] const_iterator end() const { return m_entries.end(); }
+
+	private:
+		/// Determines whether an entry ranks above another entry.
+		static bool RanksAbove(const Entry& entry, const Entry& other)
+		{
+			return entry.amount > other.amount || (entry.amount == other.amount && entry.guid < other.guid);
+		}
+
+		[[nodiscard]] size_t FindIndex(uint64 guid) const;
+
+		/// Determines the top entry by looking at all entries.
+		void RefreshTop();
+
+	private:
+		static constexpr size_t InvalidIndex = static_cast<size_t>(-1);
+
+		std::vector<Entry> m_entries;
+
+		/// Index of the entry with the most threat or InvalidIndex if it needs to be determined again.
+		size_t m_topIndex = InvalidIndex;
+	};
+}
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "game/movement_info.h"
 #include "game_protocol/game_protocol.h"
 
 namespace mmo
@@ -23,5 +24,17 @@ namespace mmo
 		virtual void NotifyObjectsDespawned(const std::vector<GameObjectS*>& objects) const = 0;
 
 		virtual void SendPacket(game::Protocol::OutgoingPacket& packet, const std::vector<char>& buffer, bool flush = true) = 0;
+
+		/// Sends the movement of another unit. The default implementation sends the given packet, which contains the
+		/// movement in the full format, but subscribers may encode the movement differently.
+		/// @param opCode The movement op code.
+		/// @param moverGuid Guid of the moving unit.
+		/// @param info The movement of the unit.
+		/// @param packet The full movement packet.
+		/// @param buffer The buffer of the full movement packet.
+		virtual void SendMovement(uint16 opCode, uint64 moverGuid, const MovementInfo& info, game::Protocol::OutgoingPacket& packet, const std::vector<char>& buffer)
+		{
+			SendPacket(packet, buffer);
+		}
 	};
 }
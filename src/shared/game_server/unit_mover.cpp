@@ -9,6 +9,7 @@
 #include "each_tile_in_sight.h"
 #include "tile_subscriber.h"
 #include "log/default_log_levels.h"
+#include "base/trace_profiler.h"
 
 namespace mmo
 {
@@ -150,6 +151,8 @@ namespace mmo
 
 	bool UnitMover::MoveTo(const Vector3& target, float customSpeed, const IShape* clipping/* = nullptr*/)
 	{
+		TRACE_SCOPE("UnitMover::MoveTo");
+
 		auto& moved = GetMoved();
 
 		if (!moved.IsAlive() /*|| moved.IsStunned() || moved.IsRootedForMovement()*/)
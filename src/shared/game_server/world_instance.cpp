@@ -5,6 +5,7 @@
 #include "creature_spawner.h"
 #include "each_tile_in_sight.h"
 #include "game_creature_s.h"
+#include "game_player_s.h"
 #include "world_instance_manager.h"
 #include "regular_update.h"
 #include "tile_subscriber.h"
@@ -12,6 +13,7 @@
 #include "log/default_log_levels.h"
 #include "visibility_grid.h"
 #include "visibility_tile.h"
+#include "base/trace_profiler.h"
 #include "base/utilities.h"
 #include "binary_io/vector_sink.h"
 #include "game_server/game_object_s.h"
@@ -136,6 +138,8 @@ namespace mmo
 
 	void WorldInstance::Update(const RegularUpdate& update)
 	{
+		TRACE_SCOPE("WorldInstance::Update");
+
 		m_updating = true;
 
 		for (const auto& object : m_objectUpdates)
@@ -195,6 +199,12 @@ namespace mmo
 		{
 			m_unitFinder->AddUnit(*addedUnit);
 		}
+
+		if (added.IsPlayer())
+		{
+			auto& player = static_cast<GamePlayerS&>(added);
+			m_groupMembers.AddMember(player.GetGroupId(), player);
+		}
 	}
 
 	void WorldInstance::RemoveGameObject(GameObjectS& remove)
@@ -204,6 +214,12 @@ namespace mmo
 			m_unitFinder->RemoveUnit(*removedUnit);
 		}
 
+		if (remove.IsPlayer())
+		{
+			auto& player = static_cast<GamePlayerS&>(remove);
+			m_groupMembers.RemoveMember(player.GetGroupId(), player);
+		}
+
 		const auto it = m_objectsByGuid.find(remove.GetGuid());
 		if (it == m_objectsByGuid.end())
 		{
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "creature_spawner.h"
+#include "group_member_index.h"
 #include "unit_finder.h"
 #include "game/game.h"
 #include "visibility_grid.h"
@@ -100,6 +101,9 @@ namespace mmo
 		/// Gets the map id of this world instance.
 		[[nodiscard]] MapId GetMapId() const noexcept { return m_mapId; }
 
+		/// Gets the number of game objects which are currently added to this instance.
+		[[nodiscard]] size_t GetObjectCount() const noexcept { return m_objectsByGuid.size(); }
+
 		Universe& GetUniverse() const noexcept { return m_universe; }
 
 		WorldInstanceManager& GetManager() const noexcept { return m_manager; }
@@ -120,6 +124,9 @@ namespace mmo
 
 		UnitFinder& GetUnitFinder() { return *m_unitFinder; }
 
+		/// Gets the characters in this world instance by group.
+		GroupMemberIndex& GetGroupMembers() { return m_groupMembers; }
+
 		GameObjectS* FindObjectByGuid(uint64 guid);
 
 		template<class T>
@@ -180,6 +187,7 @@ namespace mmo
 		std::unordered_set<GameObjectS*> m_queuedObjectUpdates;
 		std::unique_ptr<VisibilityGrid> m_visibilityGrid;
 		std::unique_ptr<UnitFinder> m_unitFinder;
+		GroupMemberIndex m_groupMembers;
 
 		std::map<uint64, std::shared_ptr<GameCreatureS>> m_temporaryCreatures;
 
@@ -4,9 +4,12 @@
 #include "regular_update.h"
 
 #include "base/clock.h"
+#include "base/metrics.h"
+#include "base/trace_profiler.h"
 #include "base/timer_queue.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "solid_visibility_grid.h"
 #include "tiled_unit_finder.h"
@@ -14,6 +17,12 @@
 
 namespace mmo
 {
+	namespace
+	{
+		/// Bucket bounds in seconds around the 30 ms update interval.
+		const std::vector<double> TickDurationBuckets = { 0.001, 0.0025, 0.005, 0.01, 0.02, 0.03, 0.05, 0.1, 0.25, 0.5, 1.0 };
+	}
+
 	WorldInstanceManager::WorldInstanceManager(asio::io_context& ioContext,
 		Universe& universe,
 		const proto::Project& project, 
@@ -21,6 +30,7 @@ namespace mmo
 		: m_universe(universe)
 		, m_objectIdGenerator(objectIdGenerator)
 		, m_project(project)
+		, m_spellEffectPlans(project)
 		, m_updateTimer(ioContext)
 		, m_lastTick(GetAsyncTimeMs())
 	{
@@ -78,18 +88,36 @@ namespace mmo
 		m_lastTick = timestamp;
 		
 		const RegularUpdate update{ timestamp, deltaSeconds };
+
+		TraceProfiler::Get().BeginTick();
 		Update(update);
+		TraceProfiler::Get().EndTick();
 		
 		ScheduleNextUpdate();
 	}
 
 	void WorldInstanceManager::Update(const RegularUpdate& update)
 	{
+		static MetricHistogram& s_tickDuration = MetricsRegistry::Get().AddHistogram("mmo_world_tick_duration_seconds", "Time spent updating all world instances per tick.", TickDurationBuckets);
+		static MetricGauge& s_instanceCount = MetricsRegistry::Get().AddGauge("mmo_world_instances", "Number of world instances.");
+		static MetricGauge& s_objectCount = MetricsRegistry::Get().AddGauge("mmo_world_objects", "Number of game objects added to world instances.");
+
+		TRACE_SCOPE("WorldInstanceManager::Update");
+
+		const auto start = std::chrono::steady_clock::now();
+
 		std::unique_lock lock{ m_worldInstanceMutex };
+
+		size_t objectCount = 0;
 		for (const auto& worldInstance : m_worldInstances)
 		{
 			worldInstance->Update(update);
+			objectCount += worldInstance->GetObjectCount();
 		}
+
+		s_instanceCount.Set(static_cast<int64>(m_worldInstances.size()));
+		s_objectCount.Set(static_cast<int64>(objectCount));
+		s_tickDuration.ObserveDuration(std::chrono::steady_clock::now() - start);
 	}
 
 	void WorldInstanceManager::ScheduleNextUpdate()
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "base/non_copyable.h"
+#include "spell_effect_plan.h"
 #include "world_instance.h"
 #include "game/game.h"
 
@@ -51,6 +52,9 @@ namespace mmo
 		/// Gets any world instance by a map id.
 		WorldInstance* GetInstanceByMap(MapId mapId);
 
+		/// Gets the effect plans of all spells of the project.
+		const SpellEffectPlans& GetSpellEffectPlans() const noexcept { return m_spellEffectPlans; }
+
 	private:
 		void OnUpdate();
 
@@ -62,6 +66,7 @@ namespace mmo
 		Universe& m_universe;
 		const proto::Project& m_project;
 		IdGenerator<uint64>& m_objectIdGenerator;
+		const SpellEffectPlans m_spellEffectPlans;
 
 		typedef std::vector<std::unique_ptr<WorldInstance>> WorldInstances;
 		asio::high_resolution_timer m_updateTimer;
@@ -12,6 +12,8 @@
 #include <cassert>
 
 #include "graphics_null/graphics_device_null.h"
+#include "graphics/material.h"
+#include "scene_graph/render_operation.h"
 
 namespace mmo
 {
@@ -217,6 +219,63 @@ namespace mmo
 		m_transform[(uint32)type] = matrix;
 	}
 
+	void GraphicsDevice::Render(const RenderOperation& operation)
+	{
+		const VertexDeclaration* vertexDeclaration = operation.vertexData ? operation.vertexData->vertexDeclaration : nullptr;
+		const VertexBufferBinding* vertexBufferBinding = operation.vertexData ? operation.vertexData->vertexBufferBinding : nullptr;
+		const IndexBuffer* indexBuffer = operation.indexData ? operation.indexData->indexBuffer.get() : nullptr;
+
+		if (operation.material.get() != m_lastMaterial ||
+			vertexDeclaration != m_lastVertexDeclaration ||
+			vertexBufferBinding != m_lastVertexBufferBinding ||
+			indexBuffer != m_lastIndexBuffer)
+		{
+			m_stateChangeCount++;
+		}
+
+		m_lastMaterial = operation.material.get();
+		m_lastVertexDeclaration = vertexDeclaration;
+		m_lastVertexBufferBinding = vertexBufferBinding;
+		m_lastIndexBuffer = indexBuffer;
+	}
+
+	void GraphicsDevice::RenderInstanced(const RenderOperation& operation, const std::span<const Matrix4> worldTransforms)
+	{
+		for (const Matrix4& worldTransform : worldTransforms)
+		{
+			SetTransformMatrix(World, worldTransform);
+			Render(operation);
+		}
+	}
+
+	bool GraphicsDevice::CanDrawInstanced(const RenderOperation& operation)
+	{
+		if (!operation.material || !operation.vertexData)
+		{
+			return false;
+		}
+
+		// Skinned vertices are transformed by the bone matrices of a single object
+		if (operation.vertexData->vertexDeclaration->FindElementBySemantic(VertexElementSemantic::BlendIndices) != nullptr)
+		{
+			return false;
+		}
+
+		return operation.material->GetVertexShader(VertexShaderType::Instanced) != nullptr;
+	}
+
+	void GraphicsDevice::RollOverFrameStatistics()
+	{
+		m_lastFrameStateChangeCount = m_stateChangeCount;
+		m_stateChangeCount = 0;
+
+		// The first operation of a new frame always counts as a state change
+		m_lastMaterial = nullptr;
+		m_lastVertexDeclaration = nullptr;
+		m_lastVertexBufferBinding = nullptr;
+		m_lastIndexBuffer = nullptr;
+	}
+
 	void GraphicsDevice::GetViewport(int32 * x, int32 * y, int32 * w, int32 * h, float * minZ, float * maxZ)
 	{
 		if (x) *x = m_viewX;
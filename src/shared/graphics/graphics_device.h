@@ -15,6 +15,8 @@
 #include "vertex_declaration.h"
 #include "shared/graphics/constant_buffer.h"
 
+#include <span>
+
 
 namespace mmo
 {
@@ -190,7 +192,21 @@ namespace mmo
 		/// Creates a new shader of a certain type if supported.
 		virtual ShaderPtr CreateShader(ShaderType type, const void* shaderCode, size_t shaderCodeSize) = 0;
 
-		virtual void Render(const RenderOperation& operation) {}
+		/// Renders a single render operation. The base implementation only tracks state changes between
+		/// consecutive operations, so derived devices should call it before submitting the operation.
+		virtual void Render(const RenderOperation& operation);
+
+		/// Renders the same render operation once for every given world transform. The default implementation
+		/// issues one Render call per instance, devices can override this to render all instances with a single
+		/// instanced draw call if CanDrawInstanced returns true for the operation.
+		/// @param operation The operation to render. Must not use per-object constant buffers.
+		/// @param worldTransforms The world transform of every instance.
+		virtual void RenderInstanced(const RenderOperation& operation, std::span<const Matrix4> worldTransforms);
+
+		/// Determines whether all instances of a render operation can be rendered with a single draw call. This
+		/// needs the instanced vertex shader of the material, which skinned vertex data can't use and which
+		/// materials compiled before it existed don't contain.
+		[[nodiscard]] static bool CanDrawInstanced(const RenderOperation& operation);
 
 		/// 
 		virtual void Draw(uint32 vertexCount, uint32 start = 0) = 0;
@@ -293,6 +309,10 @@ namespace mmo
 
 		virtual uint64 GetBatchCount() const = 0;
 
+		/// Gets the number of times the material, vertex layout or bound buffers changed between two render
+		/// operations during the last frame.
+		virtual uint64 GetStateChangeCount() const { return m_lastFrameStateChangeCount; }
+
 	public:
 		RenderWindowPtr GetAutoCreatedWindow() const { return m_autoCreatedWindow; }
 
@@ -331,5 +351,17 @@ namespace mmo
 		DepthTestMethod m_restoreDepthComparison { DepthTestMethod::Always };
 		std::vector<std::unique_ptr<VertexDeclaration>> m_vertexDeclarations;
 		std::vector<std::unique_ptr<VertexBufferBinding>> m_vertexBufferBindings;
+		uint64 m_stateChangeCount = 0;
+		uint64 m_lastFrameStateChangeCount = 0;
+
+	protected:
+		/// Makes the statistics of the current frame available as last frame statistics. Called on Reset.
+		void RollOverFrameStatistics();
+
+	private:
+		const void* m_lastMaterial = nullptr;
+		const VertexDeclaration* m_lastVertexDeclaration = nullptr;
+		const VertexBufferBinding* m_lastVertexBufferBinding = nullptr;
+		const IndexBuffer* m_lastIndexBuffer = nullptr;
 	};
 }
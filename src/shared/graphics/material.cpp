@@ -298,7 +298,7 @@ namespace mmo
 		compiler.Compile(*this, shaderCompiler);
 
 		// Compile vertex shader
-		for (uint32 i = 0; i < 4; ++i)
+		for (uint32 i = 0; i < VertexShaderTypeCount; ++i)
 		{
 			ShaderCompileResult vertexOutput;
 			ShaderCompileInput vertexInput{ compiler.GetVertexShaderCode(), ShaderType::VertexShader };
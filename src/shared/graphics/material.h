@@ -60,9 +60,16 @@ namespace mmo
 		SkinnedMedium,
 
 		/// @brief Skinning profile with high amount of bones (128)
-		SkinnedHigh
+		SkinnedHigh,
+
+		/// @brief Default vertex shader which reads the world matrix from a per-instance vertex stream instead
+		///        of the matrix constant buffer, so that many instances can be rendered with a single draw call.
+		Instanced
 	};
 
+	/// @brief Number of vertex shader types a material can contain.
+	constexpr uint32 VertexShaderTypeCount = 5;
+
 	struct ScalarParameterValue
 	{
 		String name;
@@ -311,12 +318,12 @@ namespace mmo
 		bool m_castShadow { true };
 		bool m_receiveShadows { true };
 		MaterialType m_type { MaterialType::Opaque };
-		ShaderPtr m_vertexShader[4];
+		ShaderPtr m_vertexShader[VertexShaderTypeCount];
 		ShaderPtr m_pixelShader;
 		std::vector<String> m_textureFiles;
 		std::vector<TexturePtr> m_textures;
 		bool m_texturesChanged { true };
-		std::vector<uint8> m_vertexShaderCode[4];
+		std::vector<uint8> m_vertexShaderCode[VertexShaderTypeCount];
 		bool m_vertexShaderChanged { true };
 		std::vector<uint8> m_pixelShaderCode;
 		bool m_pixelShaderChanged { true };
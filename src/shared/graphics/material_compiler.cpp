@@ -45,7 +45,7 @@ namespace mmo
 		material.SetDepthTestEnabled(m_depthTest);
 		material.SetTwoSided(m_twoSided);
 
-		for (uint32 i = 0; i < 4; ++i)
+		for (uint32 i = 0; i < VertexShaderTypeCount; ++i)
 		{
 			m_vertexShaderCode.clear();
 			GenerateVertexShaderCode(static_cast<VertexShaderType>(i));
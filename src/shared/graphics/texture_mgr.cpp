@@ -5,6 +5,7 @@
 
 #include "assets/asset_registry.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "log/default_log_levels.h"
@@ -24,7 +25,8 @@ namespace mmo
 		auto it = m_texturesByName.find(filename);
 		if (it != m_texturesByName.end())
 		{
-			return it->second;
+			it->second.lastUsed = ++m_usageCounter;
+			return it->second.texture;
 		}
 
 		// If the texture was loaded, this could would be unreachable, so we will simply
@@ -38,13 +40,18 @@ namespace mmo
 			return nullptr;
 		}
 
+		return CreateFromStream(filename, file);
+	}
+
+	TexturePtr TextureManager::CreateFromStream(const std::string& filename, std::unique_ptr<std::istream>& stream)
+	{
 		// Create a new texture object
 		auto texture = GraphicsDevice::Get().CreateTexture();
 		texture->SetDebugName(filename);
-		texture->Load(file);
+		texture->Load(stream);
 
 		// Add it to the list of textures
-		m_texturesByName[filename] = texture;
+		m_texturesByName[filename] = { texture, ++m_usageCounter, false };
 
 		// Increase the memory usage and ensure we are still within the memory budget. Since we still hold
 		// a shared_ptr on the texture in this function, this should not remove the texture
@@ -64,38 +71,48 @@ namespace mmo
 		auto it = m_texturesByName.find(name);
 		if (it != m_texturesByName.end())
 		{
-			return it->second;
+			return it->second.texture;
 		}
 
 		auto texture = GraphicsDevice::Get().CreateTexture(width, height, usage);
 		texture->SetDebugName(name);
 
-		m_texturesByName[name] = texture;
+		m_texturesByName[name] = { texture, ++m_usageCounter, true };
 
 		return texture;
 	}
 
 	void TextureManager::EnsureMemoryBudget()
 	{
-		if (m_memoryUsage < m_memoryBudget)
+		if (m_memoryUsage <= m_memoryBudget)
 			return;
 
-		// TODO: Implement a proper strategy
-
-		auto it = m_texturesByName.begin();
-		while (it != m_texturesByName.end() && m_memoryUsage > m_memoryBudget)
+		// Use count of 1 means the texture manager is the only one referencing this texture
+		// right now, so we can safely erase it.
+		std::vector<decltype(m_texturesByName)::iterator> candidates;
+		for (auto it = m_texturesByName.begin(); it != m_texturesByName.end(); ++it)
 		{
-			// Use count of 1 means the texture manager is the only one referencing this texture
-			// right now, so we can safely erase it now.
-			if (it->second.use_count() == 1)
+			if (!it->second.manual && it->second.texture.use_count() == 1)
 			{
-				// Reduce current memory usage
-				auto usage = it->second->GetMemorySize();
-				m_memoryUsage -= usage;
+				candidates.push_back(it);
+			}
+		}
 
-				// Remove reference
-				it = m_texturesByName.erase(it);
+		// Evict least recently used textures first
+		std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b)
+		{
+			return a->second.lastUsed < b->second.lastUsed;
+		});
+
+		for (const auto& it : candidates)
+		{
+			if (m_memoryUsage <= m_memoryBudget)
+			{
+				break;
 			}
+
+			m_memoryUsage -= std::min(m_memoryUsage, static_cast<size_t>(it->second.texture->GetMemorySize()));
+			m_texturesByName.erase(it);
 		}
 	}
 
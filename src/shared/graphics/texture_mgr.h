@@ -44,6 +44,9 @@ namespace mmo
 		/// by removing textures that are not referenced anymore.
 		void EnsureMemoryBudget();
 
+		/// Creates a texture from the given file stream and adds it to the cache.
+		TexturePtr CreateFromStream(const std::string& filename, std::unique_ptr<std::istream>& stream);
+
 	public:
 		/// Gets the current memory budget.
 		inline size_t GetMemoryBudget() const { return m_memoryBudget; }
@@ -53,10 +56,21 @@ namespace mmo
 		void SetMemoryBudget(size_t newBudget);
 
 	private:
-		/// A list of textures associated to their case-insensitive filenames. Note that we only
-		/// keep weak_ptr references since we don't want to own the loaded textures ourself here
-		/// to make unloading texture less complicated.
-		std::map<std::string, TexturePtr, StrCaseIComp> m_texturesByName;
+		struct CacheEntry
+		{
+			TexturePtr texture;
+			/// Value of the usage counter when the texture was last requested, used for LRU eviction.
+			uint64 lastUsed = 0;
+			/// Manual textures are not accounted for in the memory budget and never evicted.
+			bool manual = false;
+		};
+
+		/// A list of textures associated to their case-insensitive filenames. Textures which are
+		/// only referenced by this cache are evicted in least recently used order once the memory
+		/// budget is exceeded.
+		std::map<std::string, CacheEntry, StrCaseIComp> m_texturesByName;
+		/// Incremented whenever a texture is requested.
+		uint64 m_usageCounter = 0;
 		/// The memory budget in bytes.
 		size_t m_memoryBudget;
 		/// The current memory usage in bytes.
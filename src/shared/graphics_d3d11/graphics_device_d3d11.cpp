@@ -23,6 +23,9 @@
 #include "math/radian.h"
 #include "scene_graph/render_operation.h"
 
+#include <algorithm>
+#include <cstring>
+
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib, "dxgi.lib")
 #pragma comment(lib, "d3dcompiler.lib")
@@ -496,6 +499,7 @@ namespace mmo
 		m_renderTarget.reset();
 
 		m_matrixBuffer.Reset();
+		m_instanceBuffer.Reset();
 		m_rasterizerStates.clear();
 		m_samplerStates.clear();
 		m_depthStencilStates.clear();
@@ -570,6 +574,7 @@ namespace mmo
 
 		m_lastFrameBatchCount = m_batchCount;
 		m_batchCount = 0;
+		RollOverFrameStatistics();
 
 		// Update the constant buffer
 		if (m_matrixDirty)
@@ -692,7 +697,7 @@ namespace mmo
 		}
 	}
 
-	void GraphicsDeviceD3D11::Draw(const uint32 vertexCount, const uint32 start)
+	void GraphicsDeviceD3D11::PrepareDraw()
 	{
 		UpdateCurrentRasterizerState();
 		UpdateDepthStencilState();
@@ -705,6 +710,11 @@ namespace mmo
 			m_matrixDirty = false;
 			m_immContext->UpdateSubresource(m_matrixBuffer.Get(), 0, nullptr, matrices, 0, 0);
 		}
+	}
+
+	void GraphicsDeviceD3D11::Draw(const uint32 vertexCount, const uint32 start)
+	{
+		PrepareDraw();
 		
 		// Execute draw command
 		m_immContext->Draw(vertexCount, start);
@@ -713,17 +723,7 @@ namespace mmo
 
 	void GraphicsDeviceD3D11::DrawIndexed(const uint32 startIndex, const uint32 endIndex)
 	{
-		UpdateCurrentRasterizerState();
-		UpdateDepthStencilState();
-		
-		if (m_matrixDirty)
-		{
-			const Matrix4 matrices[4] = { m_transform[0], m_transform[1], m_transform[2], m_inverseView };
-				
-			// Update the constant buffer
-			m_matrixDirty = false;
-			m_immContext->UpdateSubresource(m_matrixBuffer.Get(), 0, nullptr, matrices, 0, 0);
-		}
+		PrepareDraw();
 		
 		// Execute draw command
 		m_immContext->DrawIndexed(endIndex == 0 ? m_indexCount - startIndex : endIndex - startIndex, startIndex, 0);
@@ -1034,10 +1034,71 @@ namespace mmo
 	{
 		GraphicsDevice::Render(operation);
 
+		if (BindRenderOperation(operation, false))
+		{
+			DrawRenderOperation(operation);
+		}
+	}
+
+	void GraphicsDeviceD3D11::RenderInstanced(const RenderOperation& operation, const std::span<const Matrix4> worldTransforms)
+	{
+		if (worldTransforms.empty())
+		{
+			return;
+		}
+
+		if (!CanDrawInstanced(operation))
+		{
+			GraphicsDevice::RenderInstanced(operation, worldTransforms);
+			return;
+		}
+
+		GraphicsDevice::Render(operation);
+
+		if (!BindRenderOperation(operation, true))
+		{
+			return;
+		}
+
+		UpdateInstanceBuffer(worldTransforms);
+		DrawRenderOperationInstanced(operation, static_cast<uint32>(worldTransforms.size()));
+	}
+
+	void GraphicsDeviceD3D11::UpdateInstanceBuffer(const std::span<const Matrix4> worldTransforms)
+	{
+		if (worldTransforms.size() > m_instanceBufferCapacity)
+		{
+			// Grow in steps so that slowly growing batches don't recreate the buffer every frame
+			m_instanceBufferCapacity = std::max<size_t>(worldTransforms.size(), m_instanceBufferCapacity * 2);
+
+			D3D11_BUFFER_DESC bufferDesc;
+			ZeroMemory(&bufferDesc, sizeof(bufferDesc));
+			bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+			bufferDesc.ByteWidth = static_cast<UINT>(sizeof(Matrix4) * m_instanceBufferCapacity);
+			bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+			bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+			m_instanceBuffer.Reset();
+			VERIFY(SUCCEEDED(m_device->CreateBuffer(&bufferDesc, nullptr, &m_instanceBuffer)));
+		}
+
+		D3D11_MAPPED_SUBRESOURCE sub;
+		VERIFY(SUCCEEDED(m_immContext->Map(m_instanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &sub)));
+		std::memcpy(sub.pData, worldTransforms.data(), sizeof(Matrix4) * worldTransforms.size());
+		m_immContext->Unmap(m_instanceBuffer.Get(), 0);
+
+		ID3D11Buffer* buffers[] = { m_instanceBuffer.Get() };
+		const UINT strides[] = { sizeof(Matrix4) };
+		const UINT offsets[] = { 0 };
+		m_immContext->IASetVertexBuffers(InstanceBufferSlot, 1, buffers, strides, offsets);
+	}
+
+	bool GraphicsDeviceD3D11::BindRenderOperation(const RenderOperation& operation, const bool instanced)
+	{
 		ASSERT(operation.material);
 		if (!operation.material)
 		{
-			return;
+			return false;
 		}
 		
 		// TODO: Remove this call / make it internal to reduce the amount of state changes! Materials bring their own assigned shaders and vertex data brings its own input layout
@@ -1047,7 +1108,7 @@ namespace mmo
 		operation.material->Apply(*this, MaterialDomain::Surface);
 
 		const bool hasVertexAnimData = (operation.vertexData->vertexDeclaration->FindElementBySemantic(VertexElementSemantic::BlendIndices) != nullptr);
-		ShaderBase* vertexShader = operation.material->GetVertexShader(hasVertexAnimData ? VertexShaderType::SkinnedHigh : VertexShaderType::Default).get();
+		ShaderBase* vertexShader = operation.material->GetVertexShader(instanced ? VertexShaderType::Instanced : hasVertexAnimData ? VertexShaderType::SkinnedHigh : VertexShaderType::Default).get();
 		if (!vertexShader)
 		{
 			WLOG("No skinning vertex shader found in material " << operation.material->GetName() << " - falling back to default vertex shader");
@@ -1062,7 +1123,7 @@ namespace mmo
 
 		if (!vertexShader)
 		{
-			return;
+			return false;
 		}
 
 		// Bind vertex buffers
@@ -1100,12 +1161,21 @@ namespace mmo
 		SetFaceCullMode(operation.material->IsTwoSided() ? FaceCullMode::None : FaceCullMode::Front);	// ???
 		SetBlendMode(operation.material->IsTranslucent() ? BlendMode::Alpha : BlendMode::Opaque);
 
-		static_cast<VertexDeclarationD3D11*>(operation.vertexData->vertexDeclaration)->Bind(*static_cast<VertexShaderD3D11*>(vertexShader), operation.vertexData->vertexBufferBinding);
+		static_cast<VertexDeclarationD3D11*>(operation.vertexData->vertexDeclaration)->Bind(*static_cast<VertexShaderD3D11*>(vertexShader), operation.vertexData->vertexBufferBinding, instanced);
 		SetTopologyType(operation.topology);
 
 		if (operation.indexData)
 		{
 			operation.indexData->indexBuffer->Set(0);
+		}
+
+		return true;
+	}
+
+	void GraphicsDeviceD3D11::DrawRenderOperation(const RenderOperation& operation)
+	{
+		if (operation.indexData)
+		{
 			DrawIndexed(operation.indexData->indexStart, operation.indexData->indexStart + operation.indexData->indexCount);
 		}
 		else
@@ -1114,6 +1184,22 @@ namespace mmo
 		}
 	}
 
+	void GraphicsDeviceD3D11::DrawRenderOperationInstanced(const RenderOperation& operation, const uint32 instanceCount)
+	{
+		PrepareDraw();
+
+		if (operation.indexData)
+		{
+			m_immContext->DrawIndexedInstanced(static_cast<UINT>(operation.indexData->indexCount), instanceCount, static_cast<UINT>(operation.indexData->indexStart), 0, 0);
+		}
+		else
+		{
+			m_immContext->DrawInstanced(static_cast<UINT>(operation.vertexData->vertexCount), instanceCount, static_cast<UINT>(operation.vertexData->vertexStart), 0);
+		}
+
+		m_batchCount++;
+	}
+
 	void GraphicsDeviceD3D11::SetHardwareCursor(void* osCursorData)
 	{
 		m_hardwareCursor = static_cast<HCURSOR>(osCursorData);
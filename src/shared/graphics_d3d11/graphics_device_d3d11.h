@@ -104,6 +104,10 @@ namespace mmo
 
 		void Render(const RenderOperation& operation) override;
 
+		/// Uploads the world transforms into the instance buffer and renders all instances with a single draw call.
+		/// Falls back to one draw call per instance if the material has no instanced vertex shader.
+		void RenderInstanced(const RenderOperation& operation, std::span<const Matrix4> worldTransforms) override;
+
 		void SetHardwareCursor(void* osCursorData) override;
 
 		void* GetHardwareCursor() override;
@@ -111,6 +115,10 @@ namespace mmo
 		uint64 GetBatchCount() const override { return m_lastFrameBatchCount; }
 		// ~ End GraphicsDevice
 
+	public:
+		/// Input slot of the vertex buffer which contains the world matrix of every instance of an instanced draw.
+		static constexpr UINT InstanceBufferSlot = D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT - 1;
+
 	public:
 		void SetIndexCount(const UINT indexCount)
 		{
@@ -162,6 +170,24 @@ namespace mmo
 		
 		ID3D11SamplerState* GetCurrentSamplerState();
 
+		/// Applies the material, shaders and buffers of a render operation.
+		/// @param operation The operation to bind.
+		/// @param instanced Whether to bind the instanced vertex shader and the instance buffer.
+		/// @returns false if the operation can't be drawn.
+		bool BindRenderOperation(const RenderOperation& operation, bool instanced);
+
+		/// Issues the draw call of a bound render operation.
+		void DrawRenderOperation(const RenderOperation& operation);
+
+		/// Issues a single instanced draw call of a bound render operation.
+		void DrawRenderOperationInstanced(const RenderOperation& operation, uint32 instanceCount);
+
+		/// Copies the world transforms of an instanced draw into the instance buffer, growing it if needed.
+		void UpdateInstanceBuffer(std::span<const Matrix4> worldTransforms);
+
+		/// Applies pending rasterizer, depth stencil and matrix changes before a draw call.
+		void PrepareDraw();
+
 	private:
 		/// The d3d11 device object.
 		ComPtr<ID3D11Device> m_device;
@@ -178,6 +204,10 @@ namespace mmo
 		std::map<size_t, ComPtr<ID3D11DepthStencilState>> m_depthStencilStates;
 		/// Constant buffer for vertex shader which contains the matrices.
 		ComPtr<ID3D11Buffer> m_matrixBuffer;
+		/// Dynamic vertex buffer which contains the world matrix of every instance of an instanced draw.
+		ComPtr<ID3D11Buffer> m_instanceBuffer;
+		/// Number of world matrices which fit into the instance buffer.
+		size_t m_instanceBufferCapacity = 0;
 		/// Input layouts.
 		std::map<VertexFormat, ComPtr<ID3D11InputLayout>> InputLayouts;
 		std::map<VertexFormat, ShaderPtr> VertexShaders;
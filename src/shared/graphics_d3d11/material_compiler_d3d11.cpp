@@ -1041,13 +1041,25 @@ namespace mmo
 				<< "\tfloat2 uv" << i << " : TEXCOORD" << i << ";\n";
 		}
 
-		if (type == VertexShaderType::SkinnedLow || type == VertexShaderType::SkinnedMedium || type == VertexShaderType::SkinnedHigh)
+		const bool withSkinning = (type == VertexShaderType::SkinnedLow || type == VertexShaderType::SkinnedMedium || type == VertexShaderType::SkinnedHigh);
+		if (withSkinning)
 		{
 			vertexShaderStream
 				<< "\tuint4 boneIndices : BLENDINDICES;\n"
 				<< "\tfloat4 boneWeights : BLENDWEIGHT;\n";
 		}
 
+		// Instanced shaders read the rows of the world matrix from the per-instance vertex stream
+		const bool instanced = (type == VertexShaderType::Instanced);
+		if (instanced)
+		{
+			for (uint32 i = 0; i < 4; ++i)
+			{
+				vertexShaderStream
+					<< "\tfloat4 world" << i << " : INSTANCE_WORLD" << i << ";\n";
+			}
+		}
+
 		vertexShaderStream
 			<< "};\n\n";
 
@@ -1114,7 +1126,15 @@ namespace mmo
 			<< "{\n"
 			<< "\tVertexOut output;\n\n";
 
-		const bool withSkinning = (type != VertexShaderType::Default);
+		// Instance matrices have the memory layout of matWorld, which the constant buffer reads as column major
+		const char* worldMatrix = "matWorld";
+		if (instanced)
+		{
+			vertexShaderStream
+				<< "\tmatrix matInstanceWorld = transpose(matrix(input.world0, input.world1, input.world2, input.world3));\n\n";
+			worldMatrix = "matInstanceWorld";
+		}
+
 		if (withSkinning)
 		{
 			vertexShaderStream
@@ -1148,7 +1168,7 @@ namespace mmo
 
 		// Basic transformations
 		vertexShaderStream
-			<< "\toutput.pos = mul(transformedPos, matWorld);\n"
+			<< "\toutput.pos = mul(transformedPos, " << worldMatrix << ");\n"
 			<< "\toutput.worldPos = output.pos.xyz;\n"
 			<< "\toutput.viewDir = normalize(matInvView[3].xyz - output.worldPos);\n"
 			<< "\toutput.pos = mul(output.pos, matView);\n"
@@ -1164,9 +1184,9 @@ namespace mmo
 		if (m_lit)
 		{
 			vertexShaderStream
-				<< "\toutput.binormal = normalize(mul(normalize(transformedBinormal), (float3x3)matWorld));\n"
-				<< "\toutput.tangent = normalize(mul(normalize(transformedTangent), (float3x3)matWorld));\n"
-				<< "\toutput.normal = normalize(mul(normalize(transformedNormal), (float3x3)matWorld));\n";
+				<< "\toutput.binormal = normalize(mul(normalize(transformedBinormal), (float3x3)" << worldMatrix << "));\n"
+				<< "\toutput.tangent = normalize(mul(normalize(transformedTangent), (float3x3)" << worldMatrix << "));\n"
+				<< "\toutput.normal = normalize(mul(normalize(transformedNormal), (float3x3)" << worldMatrix << "));\n";
 		}
 
 		// Main procedure end
@@ -89,7 +89,7 @@ namespace mmo
 		return semanticNames[static_cast<uint8>(semantic)];
 	}
 
-	ID3D11InputLayout* VertexDeclarationD3D11::GetILayoutByShader(VertexShaderD3D11& boundVertexProgram, VertexBufferBinding* binding)
+	ID3D11InputLayout* VertexDeclarationD3D11::GetILayoutByShader(VertexShaderD3D11& boundVertexProgram, VertexBufferBinding* binding, const bool instanced)
 	{
 		if (const auto it = m_shaderToILayoutMap.find(&boundVertexProgram); it != m_shaderToILayoutMap.end())
 		{
@@ -99,7 +99,7 @@ namespace mmo
 		ComPtr<ID3D11InputLayout> inputLayout;
 
 		std::vector< D3D11_INPUT_ELEMENT_DESC> inputElements;
-		inputElements.reserve(m_elementList.size());
+		inputElements.reserve(m_elementList.size() + 4);
 
 		for (auto element : m_elementList)
 		{
@@ -115,6 +115,23 @@ namespace mmo
 			inputElements.push_back(elementDesc);
 		}
 
+		// Instanced vertex shaders read one row of the world matrix per element from the instance buffer
+		if (instanced)
+		{
+			for (UINT row = 0; row < 4; ++row)
+			{
+				D3D11_INPUT_ELEMENT_DESC elementDesc;
+				elementDesc.SemanticName = "INSTANCE_WORLD";
+				elementDesc.SemanticIndex = row;
+				elementDesc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+				elementDesc.InputSlot = GraphicsDeviceD3D11::InstanceBufferSlot;
+				elementDesc.AlignedByteOffset = row * sizeof(float) * 4;
+				elementDesc.InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+				elementDesc.InstanceDataStepRate = 1;
+				inputElements.push_back(elementDesc);
+			}
+		}
+
 		const auto& microcode = boundVertexProgram.GetByteCode();
 
 		ID3D11Device& d3dDevice = m_device;
@@ -160,9 +177,9 @@ namespace mmo
 		VertexDeclaration::ModifyElement(elementIndex, source, offset, theType, semantic, index);
 	}
 
-	void VertexDeclarationD3D11::Bind(VertexShaderD3D11& boundVertexProgram, VertexBufferBinding* binding)
+	void VertexDeclarationD3D11::Bind(VertexShaderD3D11& boundVertexProgram, VertexBufferBinding* binding, const bool instanced)
 	{
-		ID3D11InputLayout* pVertexLayout = GetILayoutByShader(boundVertexProgram, binding);
+		ID3D11InputLayout* pVertexLayout = GetILayoutByShader(boundVertexProgram, binding, instanced);
 
 		ID3D11DeviceContext& context = m_device;
 		context.IASetInputLayout(pVertexLayout);
@@ -27,7 +27,7 @@ namespace mmo
 		~VertexDeclarationD3D11() override;
 
 	private:
-		ID3D11InputLayout* GetILayoutByShader(VertexShaderD3D11& boundVertexProgram, VertexBufferBinding* binding);
+		ID3D11InputLayout* GetILayoutByShader(VertexShaderD3D11& boundVertexProgram, VertexBufferBinding* binding, bool instanced);
 
 	public:
 		const VertexElement& AddElement(uint16 source, uint32 offset, VertexElementType theType, VertexElementSemantic semantic, uint16 index) override;
@@ -43,7 +43,9 @@ namespace mmo
 		void ModifyElement(uint16 elementIndex, uint16 source, uint32 offset, VertexElementType theType,VertexElementSemantic semantic, uint16 index) override;
 
 	public:
-		void Bind(VertexShaderD3D11& boundVertexProgram, VertexBufferBinding* binding);
+		/// Binds the input layout for a vertex shader. Layouts of instanced vertex shaders also read the
+		/// world matrix of each instance from the instance buffer of the device.
+		void Bind(VertexShaderD3D11& boundVertexProgram, VertexBufferBinding* binding, bool instanced);
 
 	private:
 		GraphicsDeviceD3D11& m_device;
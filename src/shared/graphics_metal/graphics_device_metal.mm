@@ -79,6 +79,7 @@ namespace mmo
 
 	void GraphicsDeviceMetal::Reset()
 	{
+		RollOverFrameStatistics();
 	}
 
 	void GraphicsDeviceMetal::SetClearColor(const uint32 clearColor)
@@ -69,6 +69,10 @@ namespace mmo
 
 	void GraphicsDeviceNull::Reset()
 	{
+		m_lastFrameBatchCount = m_batchCount;
+		m_batchCount = 0;
+
+		RollOverFrameStatistics();
 	}
 
 	void GraphicsDeviceNull::SetClearColor(const uint32 clearColor)
@@ -122,6 +126,29 @@ namespace mmo
 		return nullptr;
 	}
 	
+	void GraphicsDeviceNull::Render(const RenderOperation& operation)
+	{
+		GraphicsDevice::Render(operation);
+		m_batchCount++;
+	}
+
+	void GraphicsDeviceNull::RenderInstanced(const RenderOperation& operation, const std::span<const Matrix4> worldTransforms)
+	{
+		if (worldTransforms.empty())
+		{
+			return;
+		}
+
+		// Count the draws the d3d11 device issues, which falls back to one draw per instance
+		if (!CanDrawInstanced(operation))
+		{
+			GraphicsDevice::RenderInstanced(operation, worldTransforms);
+			return;
+		}
+
+		Render(operation);
+	}
+
 	void GraphicsDeviceNull::Draw(uint32 vertexCount, uint32 start)
 	{
 	}
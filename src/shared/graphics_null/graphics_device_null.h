@@ -36,6 +36,11 @@ namespace mmo
 
 		ShaderPtr CreateShader(ShaderType type, const void* shaderCode, size_t shaderCodeSize) override;
 
+		void Render(const RenderOperation& operation) override;
+
+		/// Counts a single batch for all instances if the operation can be drawn instanced and one batch per instance otherwise.
+		void RenderInstanced(const RenderOperation& operation, std::span<const Matrix4> worldTransforms) override;
+
 		void Draw(uint32 vertexCount, uint32 start = 0) override;
 
 		void DrawIndexed(uint32 startIndex = 0, uint32 endIndex = 0) override;
@@ -90,7 +95,11 @@ namespace mmo
 
 		void* GetHardwareCursor() override;
 
-		uint64 GetBatchCount() const override { return 0; }
+		uint64 GetBatchCount() const override { return m_lastFrameBatchCount; }
 		// ~ End GraphicsDevice
+
+	private:
+		uint64 m_batchCount = 0;
+		uint64 m_lastFrameBatchCount = 0;
 	};
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 
 namespace mmo
 {
@@ -14,6 +15,8 @@ namespace mmo
 			{
 				std::string host;
 				std::string document;
+				/// Byte offset the response body should start at. A Range header is sent if not zero.
+				std::uintmax_t rangeBegin = 0;
 			};
 		}
 	}
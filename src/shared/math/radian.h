@@ -109,7 +109,8 @@ namespace mmo
 		return Radian(a / b.GetValueRadians());
 	}
 
-	inline io::Reader& operator>>(io::Reader& reader, Radian& radian)
+	template <class R>
+	io::ReaderRef<R> operator>>(R& reader, Radian& radian)
 	{
 		float value; 
 		if (reader >> io::read<float>(value))
@@ -120,7 +121,8 @@ namespace mmo
 		return reader;
 	}
 	
-	inline io::Writer& operator<<(io::Writer& writer, const Radian& radian)
+	template <class W>
+	io::WriterRef<W> operator<<(W& writer, const Radian& radian)
 	{
 		return writer << io::write<float>(radian.GetValueRadians());
 	}
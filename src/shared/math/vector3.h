@@ -386,7 +386,8 @@ namespace mmo
 			<< "(" << b.x << ", " << b.y << ", " << b.z << ")";
 	}
 
-	inline io::Writer& operator<<(io::Writer& w, const mmo::Vector3& b)
+	template <class W>
+	io::WriterRef<W> operator<<(W& w, const mmo::Vector3& b)
 	{
 		return w
 			<< io::write<float>(b.x)
@@ -394,7 +395,8 @@ namespace mmo
 			<< io::write<float>(b.z);
 	}
 
-	inline io::Reader& operator>>(io::Reader& r, mmo::Vector3& b)
+	template <class R>
+	io::ReaderRef<R> operator>>(R& r, mmo::Vector3& b)
 	{
 		return r
 			>> io::read<float>(b.x)
@@ -1,5 +1,6 @@
 
 #include "map.h"
+#include "map_entity_cache.h"
 
 #include "assets/asset_registry.h"
 #include "terrain/terrain.h"
@@ -10,7 +11,9 @@
 #include <sstream>
 #include <algorithm>
 
+#include "base/sha1.h"
 #include "base/utilities.h"
+#include "binary_io/memory_source.h"
 #include "log/default_log_levels.h"
 #include "scene_graph/mesh_serializer.h"
 
@@ -27,8 +30,9 @@ namespace mmo
         return static_cast<uint16>(x + y * terrain::constants::VerticesPerTile);
     }
 
-    MapEntity::MapEntity(const std::string& path)
-		: Filename(path)
+    MapEntity::MapEntity(const std::string& path, MapEntityCache* cache)
+		: RootId(0) // Hrm
+		, Filename(path)
     {
         auto file = AssetRegistry::OpenFile(path);
         if (!file)
@@ -37,31 +41,54 @@ namespace mmo
             return;
         }
 
-        io::StreamSource source{ *file };
-		io::Reader reader{ source };
+        const std::string content{ std::istreambuf_iterator<char>(*file), std::istreambuf_iterator<char>() };
+        const SHA1Hash sourceHash = sha1(content.data(), content.size());
 
-        MeshPtr mesh = std::make_shared<Mesh>(path);
-        MeshDeserializer deserializer(*mesh);
-        deserializer.Read(reader);
+        MapEntityCache::Entry entry;
+        if (!cache || !cache->Find(path, sourceHash, entry))
+        {
+            io::MemorySource source{ content.data(), content.data() + content.size() };
+            io::Reader reader{ source };
 
-        RootId = 0; // Hrm
+            MeshPtr mesh = std::make_shared<Mesh>(path);
+            MeshDeserializer deserializer(*mesh);
+            deserializer.Read(reader);
 
-        const AABBTree& collisionTree = mesh->GetCollisionTree();
-        if (collisionTree.IsEmpty())
-        {
-            DLOG("Mesh " << path << " has no collision - ignoring it!");
-            return;
+            entry.sourceHash = sourceHash;
+
+            const AABBTree& collisionTree = mesh->GetCollisionTree();
+            if (collisionTree.IsEmpty())
+            {
+                DLOG("Mesh " << path << " has no collision - ignoring it!");
+            }
+            else
+            {
+                // Copy collision data
+                entry.vertices = collisionTree.GetVertices();
+                entry.indices.reserve(collisionTree.GetIndices().size());
+                for (auto& index : collisionTree.GetIndices())
+                {
+                    entry.indices.push_back(static_cast<int32>(index));
+                }
+
+                entry.bounds = collisionTree.GetBoundingBox();
+            }
+
+            if (cache)
+            {
+                cache->Store(path, entry);
+            }
         }
 
-        // Copy collision data
-        Vertices = collisionTree.GetVertices();
-        Indices.reserve(collisionTree.GetIndices().size());
-		for (auto& index : collisionTree.GetIndices())
-		{
-			Indices.push_back(static_cast<int32>(index));
-		}
+        Vertices = std::move(entry.vertices);
+        Indices = std::move(entry.indices);
+        Bounds = entry.bounds;
 
-		Bounds = collisionTree.GetBoundingBox();
+        HashGeneratorSha1 geometryHash;
+        geometryHash.update(reinterpret_cast<const char*>(Vertices.data()), Vertices.size() * sizeof(Vector3));
+        geometryHash.update(reinterpret_cast<const char*>(Indices.data()), Indices.size() * sizeof(int32));
+        const SHA1Hash hash = geometryHash.finalize();
+        std::memcpy(&GeometryHash, hash.data(), sizeof(GeometryHash));
     }
 
     MapEntityInstance::MapEntityInstance(const MapEntity* entity, const AABB& bounds, const Matrix4& transformMatrix)
@@ -222,9 +249,10 @@ namespace mmo
         }
     }
 
-    Map::Map(std::string mapName)
+    Map::Map(std::string mapName, MapEntityCache* entityCache)
         : Name(std::move(mapName))
         , Id(0)
+        , m_entityCache(entityCache)
     {
 		auto file = AssetRegistry::OpenFile("Worlds/" + Name + "/" + Name + ".hwld");
 		if (!file)
@@ -302,7 +330,7 @@ namespace mmo
 
         DLOG("Loading map entity " << name << "...");
 
-        auto ret = std::make_unique<MapEntity>(name);
+        auto ret = std::make_unique<MapEntity>(name, m_entityCache);
 		m_loadedMapEntities.push_back(std::move(ret));
 
         return m_loadedMapEntities.back().get();
@@ -17,6 +17,8 @@
 
 namespace mmo
 {
+    class MapEntityCache;
+
 #pragma pack(push, 1)
     struct PageChunkLocation
     {
@@ -61,8 +63,13 @@ namespace mmo
         std::vector<int32> Indices;
         String Filename;
         AABB Bounds;
+        /// Hash of the collision geometry, used to detect changes between builds.
+        uint64 GeometryHash = 0;
 
-        MapEntity(const std::string& path);
+        /// Loads the collision geometry of a mesh file.
+        /// @param path Asset path of the mesh file.
+        /// @param cache Optional cache which is used instead of deserializing the mesh if the file didn't change.
+        explicit MapEntity(const std::string& path, MapEntityCache* cache = nullptr);
     };
 
 
@@ -125,7 +132,9 @@ namespace mmo
         const unsigned int Id;
 
     public:
-        explicit Map(std::string mapName);
+        /// @param mapName Name of the world to load.
+        /// @param entityCache Optional cache of map entity collision geometry. Has to outlive the map.
+        explicit Map(std::string mapName, MapEntityCache* entityCache = nullptr);
 		~Map() override = default;
 
 	public:
@@ -161,6 +170,8 @@ namespace mmo
     private:
         uint32 m_version = 0;
 
+        MapEntityCache* m_entityCache = nullptr;
+
         struct MapEntityChunkContent
         {
             uint32 uniqueId;
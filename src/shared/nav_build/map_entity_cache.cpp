@@ -0,0 +1,131 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "map_entity_cache.h"
+
+#include "binary_io/reader.h"
+#include "binary_io/stream_sink.h"
+#include "binary_io/stream_source.h"
+#include "binary_io/writer.h"
+#include "log/default_log_levels.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace mmo
+{
+	namespace
+	{
+		constexpr uint32 CacheFileSignature = 'NECH';
+		constexpr uint32 CacheFileVersion = 1;
+	}
+
+	MapEntityCache::MapEntityCache(String fileName)
+		: m_fileName(std::move(fileName))
+	{
+	}
+
+	void MapEntityCache::Load()
+	{
+		std::scoped_lock lock{ m_mutex };
+		m_entries.clear();
+		m_changed = false;
+
+		std::ifstream file(m_fileName, std::ios::binary);
+		if (!file)
+		{
+			return;
+		}
+
+		io::StreamSource source{ file };
+		io::Reader reader{ source };
+
+		uint32 signature = 0, version = 0, entryCount = 0;
+		if (!(reader >> io::read<uint32>(signature) >> io::read<uint32>(version) >> io::read<uint32>(entryCount)) ||
+			signature != CacheFileSignature || version != CacheFileVersion)
+		{
+			WLOG("Ignoring outdated map entity cache " << m_fileName);
+			return;
+		}
+
+		for (uint32 i = 0; i < entryCount; ++i)
+		{
+			String filename;
+			Entry entry;
+			if (!(reader
+				>> io::read_container<uint16>(filename)
+				>> io::read_range(entry.sourceHash)
+				>> io::read_container<uint32>(entry.vertices)
+				>> io::read_container<uint32>(entry.indices)
+				>> entry.bounds))
+			{
+				WLOG("Map entity cache " << m_fileName << " is corrupt, ignoring it");
+				m_entries.clear();
+				return;
+			}
+
+			m_entries[filename] = std::move(entry);
+		}
+	}
+
+	bool MapEntityCache::Save()
+	{
+		std::scoped_lock lock{ m_mutex };
+		if (!m_changed)
+		{
+			return true;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(m_fileName).parent_path(), error);
+
+		std::ofstream file(m_fileName, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			ELOG("Failed to write map entity cache " << m_fileName);
+			return false;
+		}
+
+		io::StreamSink sink{ file };
+		io::Writer writer{ sink };
+
+		writer
+			<< io::write<uint32>(CacheFileSignature)
+			<< io::write<uint32>(CacheFileVersion)
+			<< io::write<uint32>(m_entries.size());
+
+		for (const auto& [filename, entry] : m_entries)
+		{
+			writer
+				<< io::write_dynamic_range<uint16>(filename)
+				<< io::write_range(entry.sourceHash)
+				<< io::write_dynamic_range<uint32>(entry.vertices)
+				<< io::write_dynamic_range<uint32>(entry.indices)
+				<< entry.bounds;
+		}
+
+		sink.Flush();
+		m_changed = false;
+		return true;
+	}
+
+	bool MapEntityCache::Find(const String& filename, const SHA1Hash& sourceHash, Entry& out_entry) const
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		const auto it = m_entries.find(filename);
+		if (it == m_entries.end() || it->second.sourceHash != sourceHash)
+		{
+			return false;
+		}
+
+		out_entry = it->second;
+		return true;
+	}
+
+	void MapEntityCache::Store(const String& filename, Entry entry)
+	{
+		std::scoped_lock lock{ m_mutex };
+		m_entries[filename] = std::move(entry);
+		m_changed = true;
+	}
+}
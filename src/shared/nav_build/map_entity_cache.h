@@ -0,0 +1,61 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/sha1.h"
+#include "base/typedefs.h"
+#include "math/aabb.h"
+#include "math/vector3.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace mmo
+{
+	/// Persistent cache of map entity collision geometry. Deserializing a mesh file also loads its materials, which is
+	/// slow, so the collision geometry of each mesh is stored along with a hash of the mesh file content and reused by
+	/// later builds as long as the file didn't change. Thread safe.
+	class MapEntityCache final : public NonCopyable
+	{
+	public:
+		/// Cached collision geometry of a single mesh file.
+		struct Entry
+		{
+			/// SHA1 hash of the mesh file content the geometry has been extracted from.
+			SHA1Hash sourceHash {};
+			std::vector<Vector3> vertices;
+			std::vector<int32> indices;
+			AABB bounds;
+		};
+
+	public:
+		/// @param fileName Path of the file the cache is loaded from and saved to.
+		explicit MapEntityCache(String fileName);
+
+	public:
+		/// Loads the cache file. A missing or outdated file results in an empty cache.
+		void Load();
+
+		/// Saves the cache file if entries have been added since it has been loaded.
+		/// @returns false if the file could not be written.
+		bool Save();
+
+		/// Gets the cached geometry of a mesh file if the file content didn't change.
+		/// @param filename Asset path of the mesh file.
+		/// @param sourceHash Hash of the current content of the mesh file.
+		/// @param out_entry Receives the cached geometry.
+		/// @returns true if there was a matching entry.
+		bool Find(const String& filename, const SHA1Hash& sourceHash, Entry& out_entry) const;
+
+		/// Adds or replaces the cached geometry of a mesh file.
+		void Store(const String& filename, Entry entry);
+
+	private:
+		const String m_fileName;
+		mutable std::mutex m_mutex;
+		std::map<String, Entry> m_entries;
+		bool m_changed = false;
+	};
+}
@@ -1,6 +1,8 @@
 
 #include "mesh_builder.h"
 
+#include <cstring>
+#include <set>
 #include <unordered_set>
 
 #include "DetourNavMeshBuilder.h"
@@ -10,6 +12,8 @@
 #include "recast_context.h"
 
 #include "assets/asset_registry.h"
+#include "base/sha1.h"
+#include "binary_io/stream_source.h"
 #include "log/default_log_levels.h"
 #include "math/aabb.h"
 #include "map.h"
@@ -43,6 +47,24 @@ namespace mmo
         static constexpr int VoxelWalkableRadius = static_cast<int>(WalkableRadius / CellSize);
         static constexpr int VoxelWalkableHeight = static_cast<int>(WalkableHeight / CellHeight);
         static constexpr int VoxelWalkableClimb = static_cast<int>(WalkableClimb / CellHeight);
+
+        /// Part of every tile input hash. Has to be increased whenever the settings above or the build process
+        /// change, so that incremental builds don't reuse tiles built the old way.
+        static constexpr uint32 BuildVersion = 1;
+    }
+
+    namespace
+    {
+        constexpr uint32 TileHashesSignature = 'NHSH';
+        constexpr uint32 TileHashesVersion = 1;
+
+        template<class T>
+        void HashVector(HashGeneratorSha1& hash, const std::vector<T>& values)
+        {
+            const uint32 count = static_cast<uint32>(values.size());
+            hash.update(count);
+            hash.update(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
     }
 
 	namespace
@@ -299,12 +321,85 @@ namespace mmo
         m_tiles[{x, y}] = std::move(heightField);
 	}
 
-    MeshBuilder::MeshBuilder(String outputPath, String worldName)
+	bool SerializableNavPage::LoadPreviousTiles(io::Reader& reader)
+	{
+        std::lock_guard guard(m_mutex);
+
+        uint32 signature = 0, version = 0, page = 0, x = 0, y = 0, tileCount = 0;
+        if (!(reader
+            >> io::read<uint32>(signature)
+            >> io::read<uint32>(version)
+            >> io::read<uint32>(page)
+            >> io::read<uint32>(x)
+            >> io::read<uint32>(y)
+            >> io::read<uint32>(tileCount)))
+        {
+            return false;
+        }
+
+        if (signature != FileSignature || version != FileVersion || page != FilePage || static_cast<int32>(x) != m_x || static_cast<int32>(y) != m_y)
+        {
+            return false;
+        }
+
+        for (uint32 i = 0; i < tileCount; ++i)
+        {
+            uint32 tileX = 0, tileY = 0, meshSize = 0;
+            if (!(reader >> io::read<uint32>(tileX) >> io::read<uint32>(tileY) >> io::read<uint32>(meshSize)))
+            {
+                return false;
+            }
+
+            // Keep the tile data exactly as it is written by BuildAndSerializeTerrainTile: mesh size followed by the mesh
+            std::vector<char> tileData(sizeof(uint32) + meshSize);
+            std::memcpy(tileData.data(), &meshSize, sizeof(uint32));
+            if (meshSize > 0 && !(reader >> io::read_range(tileData.begin() + sizeof(uint32), tileData.end())))
+            {
+                return false;
+            }
+
+            const int32 localX = static_cast<int32>(tileX) - m_x * static_cast<int32>(terrain::constants::TilesPerPage);
+            const int32 localY = static_cast<int32>(tileY) - m_y * static_cast<int32>(terrain::constants::TilesPerPage);
+            m_previousTiles[{localX, localY}] = std::move(tileData);
+        }
+
+        return true;
+	}
+
+	bool SerializableNavPage::TakePreviousTile(int32 x, int32 y, std::vector<char>& out_tileData)
+	{
+        std::lock_guard guard(m_mutex);
+
+        const auto it = m_previousTiles.find({ x, y });
+        if (it == m_previousTiles.end())
+        {
+            return false;
+        }
+
+        out_tileData = std::move(it->second);
+        m_previousTiles.erase(it);
+        return true;
+	}
+
+    MeshBuilder::MeshBuilder(String outputPath, String worldName, const bool incremental)
 		: m_outputPath(std::move(outputPath))
 		, m_worldPath(std::move(worldName))
 		, m_chunkReferences(terrain::constants::MaxPagesSquared * terrain::constants::TilesPerPage * terrain::constants::TilesPerPage, 0)
 	{
-        m_map = std::make_unique<Map>(m_worldPath);
+        if (incremental)
+        {
+            m_entityCache = std::make_unique<MapEntityCache>((std::filesystem::path(m_outputPath) / "nav" / m_worldPath).string() + ".entities");
+            m_entityCache->Load();
+
+            LoadTileHashes();
+        }
+
+        m_map = std::make_unique<Map>(m_worldPath, m_entityCache.get());
+
+        if (m_entityCache)
+        {
+            m_entityCache->Save();
+        }
 
         if (!AssetRegistry::HasFile("Worlds/" + m_worldPath + "/" + m_worldPath + ".hwld"))
         {
@@ -399,6 +494,16 @@ namespace mmo
             chunks.push_back(chunk);
         }
 
+        const uint64 inputHash = ComputeTileHash(chunkPositions, chunks);
+
+        std::vector<char> previousTileData;
+        if (TakePreviousTile(tile, inputHash, previousTileData))
+        {
+            ++m_reusedTiles;
+            FinishTile(tile, inputHash, std::move(previousTileData), chunkPositions);
+            return true;
+        }
+
         // because ComputeRequiredChunks places the chunk that this tile falls on at
         // the start of the collection, we know that the first element in the
         // 'chunks' collection is also the chunk upon which this tile falls.
@@ -496,27 +601,126 @@ namespace mmo
 		const uint32 meshSize = static_cast<uint32>(meshEndPos - meshStartPos);
 		heightFieldSink.Overwrite(meshSizePos, reinterpret_cast<const char*>(&meshSize), sizeof(uint32));
 
+        FinishTile(tile, inputHash, std::move(heightFieldData), chunkPositions);
+
+        return true;
+	}
+
+	void MeshBuilder::SaveMap() const
+	{
+		const String path = (std::filesystem::path(m_outputPath) / "nav" / m_map->Name).string() + ".map";
+        std::ofstream of(path, std::ofstream::binary | std::ofstream::trunc);
+
+		io::StreamSink sink{ of };
+		io::Writer writer{ sink };
+
+        m_map->Serialize(writer);
+
+        // Save tile input hashes for the next incremental build
+        std::ofstream hashFile(GetTileHashesPath(), std::ofstream::binary | std::ofstream::trunc);
+        if (!hashFile)
+        {
+            ELOG("Failed to write tile hashes file " << GetTileHashesPath());
+            return;
+        }
+
+        io::StreamSink hashSink{ hashFile };
+        io::Writer hashWriter{ hashSink };
+
+        std::lock_guard guard(m_mutex);
+
+        hashWriter
+            << io::write<uint32>(TileHashesSignature)
+            << io::write<uint32>(TileHashesVersion)
+            << io::write<uint32>(m_tileHashes.size());
+
+        for (const auto& [tile, hash] : m_tileHashes)
+        {
+            hashWriter
+                << io::write<int32>(tile.first)
+                << io::write<int32>(tile.second)
+                << io::write<uint64>(hash);
+        }
+
+        hashSink.Flush();
+	}
+
+	uint64 MeshBuilder::ComputeTileHash(const std::vector<TileIndex>& chunkPositions, const std::vector<const TerrainChunk*>& chunks) const
+	{
+        ASSERT(chunkPositions.size() == chunks.size());
+
+        HashGeneratorSha1 hash;
+        hash.update(settings::BuildVersion);
+
+        std::set<uint32> entityInstances;
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            hash.update(chunkPositions[i].x);
+            hash.update(chunkPositions[i].y);
+
+            const TerrainChunk& chunk = *chunks[i];
+            HashVector(hash, chunk.m_terrainVertices);
+            HashVector(hash, chunk.m_terrainIndices);
+            HashVector(hash, chunk.m_liquidVertices);
+            HashVector(hash, chunk.m_liquidIndices);
+
+            entityInstances.insert(chunk.m_mapEntityInstances.begin(), chunk.m_mapEntityInstances.end());
+        }
+
+        // Entity instances are hashed in order of their unique id, so the result doesn't depend on the order in which
+        // they are stored in the world file
+        for (const uint32 uniqueId : entityInstances)
+        {
+            const MapEntityInstance* instance = m_map->GetMapEntityInstance(uniqueId);
+            ASSERT(instance);
+
+            hash.update(uniqueId);
+            hash.update(instance->TransformMatrix);
+            hash.update(instance->Model->GeometryHash);
+        }
+
+        const SHA1Hash digest = hash.finalize();
+
+        uint64 result;
+        std::memcpy(&result, digest.data(), sizeof(result));
+        return result;
+	}
+
+	bool MeshBuilder::TakePreviousTile(const TileIndex& tile, const uint64 inputHash, std::vector<char>& out_tileData)
+	{
+        std::lock_guard guard(m_mutex);
+
+        const auto it = m_previousTileHashes.find({ tile.x, tile.y });
+        if (it == m_previousTileHashes.end() || it->second != inputHash)
+        {
+            return false;
+        }
+
+        SerializableNavPage* page = GetInProgressPage(tile.x / terrain::constants::TilesPerPage, tile.y / terrain::constants::TilesPerPage);
+        return page->TakePreviousTile(tile.x % terrain::constants::TilesPerPage, tile.y % terrain::constants::TilesPerPage, out_tileData);
+	}
+
+	void MeshBuilder::FinishTile(const TileIndex& tile, const uint64 inputHash, std::vector<char>&& tileData, const std::vector<TileIndex>& chunkPositions)
+	{
         {
             std::lock_guard guard(m_mutex);
 
+            m_tileHashes[{ tile.x, tile.y }] = inputHash;
+
             auto const pageX = tile.x / terrain::constants::TilesPerPage;
             auto const pageY = tile.y / terrain::constants::TilesPerPage;
             auto const localTileX = tile.x % terrain::constants::TilesPerPage;
             auto const localTileY = tile.y % terrain::constants::TilesPerPage;
 
             SerializableNavPage* page = GetInProgressPage(pageX, pageY);
-            page->AddTile(localTileX, localTileY, std::move(heightFieldData));
+            page->AddTile(localTileX, localTileY, std::move(tileData));
 
             if (page->IsComplete())
             {
-                std::stringstream str;
-                str << std::setw(2) << std::setfill('0') << pageX << "_"
-                    << std::setw(2) << std::setfill('0') << pageY << ".nav";
-
 				create_directories(std::filesystem::path(m_outputPath) / "nav" / m_map->Name);
 
                 {
-                    std::ofstream file(std::filesystem::path(m_outputPath) / "nav" / m_map->Name / str.str(), std::ios::binary | std::ios::trunc);
+                    std::ofstream file(GetPagePath(pageX, pageY), std::ios::binary | std::ios::trunc);
                     ASSERT(!file.bad());
 
                     io::StreamSink sink{ file };
@@ -536,19 +740,54 @@ namespace mmo
         {
             RemoveChunkReference(x, y);
         }
+	}
 
-        return true;
+	void MeshBuilder::LoadTileHashes()
+	{
+        std::ifstream file(GetTileHashesPath(), std::ios::binary);
+        if (!file)
+        {
+            return;
+        }
+
+        io::StreamSource source{ file };
+        io::Reader reader{ source };
+
+        uint32 signature = 0, version = 0, count = 0;
+        if (!(reader >> io::read<uint32>(signature) >> io::read<uint32>(version) >> io::read<uint32>(count)) ||
+            signature != TileHashesSignature || version != TileHashesVersion)
+        {
+            WLOG("Ignoring outdated tile hashes file " << GetTileHashesPath() << ", all tiles will be built");
+            return;
+        }
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            int32 x = 0, y = 0;
+            uint64 hash = 0;
+            if (!(reader >> io::read<int32>(x) >> io::read<int32>(y) >> io::read<uint64>(hash)))
+            {
+                WLOG("Tile hashes file " << GetTileHashesPath() << " is corrupt, all tiles will be built");
+                m_previousTileHashes.clear();
+                return;
+            }
+
+            m_previousTileHashes[{ x, y }] = hash;
+        }
 	}
 
-	void MeshBuilder::SaveMap() const
+	std::filesystem::path MeshBuilder::GetTileHashesPath() const
 	{
-		const String path = (std::filesystem::path(m_outputPath) / "nav" / m_map->Name).string() + ".map";
-        std::ofstream of(path, std::ofstream::binary | std::ofstream::trunc);
+        return (std::filesystem::path(m_outputPath) / "nav" / m_worldPath).string() + ".navhash";
+	}
 
-		io::StreamSink sink{ of };
-		io::Writer writer{ sink };
+	std::filesystem::path MeshBuilder::GetPagePath(const int32 pageX, const int32 pageY) const
+	{
+        std::stringstream str;
+        str << std::setw(2) << std::setfill('0') << pageX << "_"
+            << std::setw(2) << std::setfill('0') << pageY << ".nav";
 
-        m_map->Serialize(writer);
+        return std::filesystem::path(m_outputPath) / "nav" / m_map->Name / str.str();
 	}
 
 	void MeshBuilder::AddChunkReference(const int32 chunkX, const int32 chunkY)
@@ -595,6 +834,20 @@ namespace mmo
         if (!m_pagesInProgress[{x, y}])
         {
             m_pagesInProgress[{x, y}] = std::make_unique<SerializableNavPage>(x, y);
+
+            // Keep the tiles of the previous build around until the page is written again, so they can be reused
+            if (!m_previousTileHashes.empty())
+            {
+                if (std::ifstream file(GetPagePath(x, y), std::ios::binary); file)
+                {
+                    io::StreamSource source{ file };
+                    io::Reader reader{ source };
+                    if (!m_pagesInProgress[{x, y}]->LoadPreviousTiles(reader))
+                    {
+                        WLOG("Failed to read previous navigation page " << GetPagePath(x, y) << ", its tiles will be built again");
+                    }
+                }
+            }
         }
 
         return m_pagesInProgress[{x, y}].get();
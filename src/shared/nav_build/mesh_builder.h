@@ -8,7 +8,9 @@
 #include "base/filesystem.h"
 
 #include "map.h"
+#include "map_entity_cache.h"
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -30,6 +32,12 @@ namespace mmo
 	///	by the server application.
 	class SerializableNavPage final : public NonCopyable
 	{
+	public:
+		/// Header values of a serialized page.
+		static constexpr uint32 FileSignature = 'NAVM';
+		static constexpr uint32 FileVersion = '0001';
+		static constexpr uint32 FilePage = 'PAGE';
+
 	protected:
 		// Serialized heightfield and finalized mesh data, mapped by global tile id
 		std::map<std::pair<int32, int32>, std::vector<char>> m_tiles;
@@ -44,6 +52,18 @@ namespace mmo
 		///	@param heightField The serialized height field and finalized tile buffer for the tile.
 		void AddTile(int32 x, int32 y, std::vector<char>&& heightField);
 
+		/// Reads the tiles of a previously written page file, so that tiles whose inputs didn't change can be reused.
+		///	@param reader The reader to read the page file from.
+		///	@returns false if the page file could not be read.
+		bool LoadPreviousTiles(io::Reader& reader);
+
+		/// Takes the data of a tile from the previously written page file.
+		///	@param x The x coordinate of the tile relative to this page.
+		///	@param y The y coordinate of the tile relative to this page.
+		///	@param out_tileData Receives the serialized tile data.
+		///	@returns false if the previous page file didn't contain the tile.
+		bool TakePreviousTile(int32 x, int32 y, std::vector<char>& out_tileData);
+
 		/// Determines whether all page tiles have been added.
 		///	@returns True if all tiles have been added, false otherwise.
 		bool IsComplete() const
@@ -52,6 +72,9 @@ namespace mmo
 		}
 
 	private:
+		/// Tile data of the previously written page file, mapped by tile coordinates relative to this page.
+		std::map<std::pair<int32, int32>, std::vector<char>> m_previousTiles;
+
 		/// Global x coordinate of the page.
 		int32 m_x;
 		/// Global y coordinate of the page.
@@ -72,10 +95,6 @@ namespace mmo
 		///	@param writer The io Writer to use for serialization. This abstracts the writing process.
 		void Serialize(io::Writer& writer) const
 		{
-			constexpr uint32 FileSignature = 'NAVM';
-			constexpr uint32 FileVersion = '0001';
-			constexpr uint32 FilePage = 'PAGE';
-
 			// Write header
 			writer
 				<< io::write<uint32>(FileSignature)
@@ -119,7 +138,8 @@ namespace mmo
 		/// Creates a new instance of the MeshBuilder class and initializes it.
 		///	@param outputPath The path to the output directory where the navigation map files will be stored.
 		///	@param worldName The name of the world for which the navigation map is being built.
-		explicit MeshBuilder(String outputPath, String worldName);
+		///	@param incremental If true, tiles whose inputs didn't change since the last build are not built again.
+		explicit MeshBuilder(String outputPath, String worldName, bool incremental = true);
 
 	public:
 		/// Gets the next tile index to be processed, thread safe. If no tiles are left to process, the function returns false which
@@ -132,6 +152,9 @@ namespace mmo
 		///	@returns The number of completed tiles.
 		[[nodiscard]] size_t CompletedTiles() const { return m_completedTiles; }
 
+		/// Gets the number of tiles which were reused from the previous build instead of being built.
+		[[nodiscard]] size_t GetReusedTiles() const { return m_reusedTiles; }
+
 		/// Gets the number of available tiles to be processed.
 		///	@returns The number of available tiles.
 		[[nodiscard]] size_t GetTileCount() const { return m_totalTiles; }
@@ -145,9 +168,33 @@ namespace mmo
 		///	@returns True if the tile was successfully built and serialized, false otherwise.
 		[[nodiscard]] bool BuildAndSerializeTerrainTile(const TileIndex& tile);
 
+		/// Saves the map file and the tile input hashes used by the next incremental build.
 		void SaveMap() const;
 
 	private:
+		/// Computes a hash of all inputs used to build a tile: the terrain and liquid geometry of all required
+		/// chunks and the transforms and geometry of all map entities on them. As neighbouring chunks are part of
+		/// the inputs, a change in one chunk also changes the hashes of the surrounding tiles.
+		///	@param chunkPositions Global coordinates of the chunks required to build the tile.
+		///	@param chunks The chunks required to build the tile, in the same order.
+		uint64 ComputeTileHash(const std::vector<TileIndex>& chunkPositions, const std::vector<const TerrainChunk*>& chunks) const;
+
+		/// Takes the data of a tile from the previous build if its input hash didn't change.
+		///	@returns true if the tile data could be reused.
+		bool TakePreviousTile(const TileIndex& tile, uint64 inputHash, std::vector<char>& out_tileData);
+
+		/// Adds the data of a finished tile to its page and writes the page file once all of its tiles are finished.
+		void FinishTile(const TileIndex& tile, uint64 inputHash, std::vector<char>&& tileData, const std::vector<TileIndex>& chunkPositions);
+
+		/// Loads the tile input hashes of the previous build.
+		void LoadTileHashes();
+
+		/// Gets the path of the file storing the tile input hashes.
+		[[nodiscard]] std::filesystem::path GetTileHashesPath() const;
+
+		/// Gets the path of the navigation page file of the given page.
+		[[nodiscard]] std::filesystem::path GetPagePath(int32 pageX, int32 pageY) const;
+
 
 		/// Increments the reference counter of the given chunk. This is used to determine if pages can be unloaded or not
 		///	once a tile has been completely built.
@@ -174,6 +221,7 @@ namespace mmo
 		void RemovePage(const SerializableNavPage* page);
 
 	private:
+		std::unique_ptr<MapEntityCache> m_entityCache;
 		std::unique_ptr<Map> m_map;
 
 		String m_outputPath;
@@ -181,6 +229,12 @@ namespace mmo
 
 		size_t m_totalTiles = 0;
 		volatile size_t m_completedTiles = 0;
+		std::atomic<size_t> m_reusedTiles { 0 };
+
+		/// Tile input hashes of the previous build, mapped by global tile coordinates.
+		std::map<std::pair<int32, int32>, uint64> m_previousTileHashes;
+		/// Tile input hashes of this build, mapped by global tile coordinates.
+		std::map<std::pair<int32, int32>, uint64> m_tileHashes;
 
 		std::vector<TileIndex> m_pendingTiles;
 		std::vector<int32> m_chunkReferences;
@@ -6,6 +6,7 @@
 #include "buffer.h"
 #include "receive_state.h"
 #include "base/assign_on_exit.h"
+#include "base/metrics.h"
 #include "binary_io/string_sink.h"
 #include "binary_io/memory_source.h"
 
@@ -13,6 +14,7 @@
 #include "asio/ip/tcp.hpp"
 #include "asio/write.hpp"
 #include "asio/strand.hpp"
+#include "asio/post.hpp"
 
 #include <functional>
 #include <cassert>
@@ -22,6 +24,20 @@
 
 namespace mmo
 {
+	/// Gets the process-wide counter of bytes written to sockets.
+	inline MetricCounter& GetNetworkBytesSent()
+	{
+		static MetricCounter& s_bytesSent = MetricsRegistry::Get().AddCounter("mmo_network_bytes_sent_total", "Number of bytes written to sockets.");
+		return s_bytesSent;
+	}
+
+	/// Gets the process-wide counter of bytes read from sockets.
+	inline MetricCounter& GetNetworkBytesReceived()
+	{
+		static MetricCounter& s_bytesReceived = MetricsRegistry::Get().AddCounter("mmo_network_bytes_received_total", "Number of bytes read from sockets.");
+		return s_bytesReceived;
+	}
+
 	/// Enumerates possible packet parse results.
 	enum class PacketParseResult
 	{
@@ -111,6 +127,7 @@ namespace mmo
 			: m_socket(std::move(Socket_))
 			, m_listener(Listener_)
 			, m_isParsingIncomingData(false)
+			, m_isParsingBlocked(false)
 			, m_isClosedOnParsing(false)
 			, m_isClosedOnSend(false)
 			, m_isReceiving(false)
@@ -152,6 +169,7 @@ namespace mmo
 			m_isClosedOnSend = false;
 			m_isClosedOnParsing = false;
 			m_isParsingIncomingData = false;
+			m_isParsingBlocked = false;
 			m_isReceiving = false;
 
 			m_received.clear();
@@ -161,9 +179,21 @@ namespace mmo
 			beginReceive();
 		}
 
+		/// Continues parsing packets after a packet handler returned PacketParseResult::Block. May be
+		/// called from any thread, parsing continues on the connection's strand.
 		void resumeParsing() override
 		{
-			parsePackets();
+			asio::post(m_strand, [strongThis = this->shared_from_this()]()
+			{
+				strongThis->m_isParsingBlocked = false;
+				if (strongThis->m_received.empty())
+				{
+					strongThis->beginReceive();
+					return;
+				}
+
+				strongThis->parsePackets();
+			});
 		}
 
 		void flush() override
@@ -258,6 +288,7 @@ namespace mmo
 		Buffer m_received;
 		ReceiveBuffer m_receiving;
 		bool m_isParsingIncomingData;
+		bool m_isParsingBlocked;
 		bool m_isClosedOnParsing;
 		bool m_isClosedOnSend;
 		bool m_isReceiving;
@@ -287,6 +318,8 @@ namespace mmo
 				return;
 			}
 
+			GetNetworkBytesSent().Increment(m_sending.size());
+
 			if (m_listener)
 			{
 				m_listener->connectionDataSent(m_sending.size());
@@ -333,6 +366,8 @@ namespace mmo
 				return;
 			}
 
+			GetNetworkBytesReceived().Increment(size);
+
 			m_received.append(
 			    m_receiving.begin(),
 			    m_receiving.begin() + size);
@@ -342,6 +377,13 @@ namespace mmo
 
 		void parsePackets()
 		{
+			// Keep receiving while blocked, the buffered packets are parsed once resumeParsing is called
+			if (m_isParsingBlocked)
+			{
+				beginReceive();
+				return;
+			}
+
 			m_isParsingIncomingData = true;
 			AssignOnExit<bool> isParsingIncomingDataResetter(
 				m_isParsingIncomingData, false);
@@ -388,7 +430,7 @@ namespace mmo
 								break;
 							case PacketParseResult::Block:
 								nextPacket = false;
-								WLOG("Block request by packet handler");
+								m_isParsingBlocked = true;
 								break;
 							case PacketParseResult::Disconnect:
 								m_isClosedOnParsing = true;
@@ -200,7 +200,7 @@ namespace mmo
 			}
 
 			VertexShaderType shaderType;
-			if (!(reader >> io::read<uint8>(shaderType)) || static_cast<uint8_t>(shaderType) >= 4)
+			if (!(reader >> io::read<uint8>(shaderType)) || static_cast<uint8_t>(shaderType) >= VertexShaderTypeCount)
 			{
 				return false;
 			}
@@ -477,9 +477,9 @@ namespace mmo
 			ChunkWriter shaderChunkWriter { MaterialVertexShaderChunk, writer };
 
 			// TODO: Number of shaders to write
-			writer << io::write<uint8>(4);
+			writer << io::write<uint8>(VertexShaderTypeCount);
 
-			for (uint32 i = 0; i < 4; ++i)
+			for (uint32 i = 0; i < VertexShaderTypeCount; ++i)
 			{
 				// TODO: Shader model
 				writer << io::write_dynamic_range<uint8>(String("D3D_SM5"));
@@ -5,25 +5,138 @@
 #include "movable_object.h"
 #include "camera.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace mmo
 {
+	namespace
+	{
+		/// Number of bits used for the material id in the sort key.
+		constexpr uint32 MaterialBits = 20;
+		/// Number of bits used for the vertex declaration id in the sort key.
+		constexpr uint32 DeclarationBits = 12;
+		/// Number of bits used for the vertex and index buffer id in the sort key.
+		constexpr uint32 BufferBits = 15;
+		/// Number of bits used for the quantized view depth in the sort key.
+		constexpr uint32 DepthBits = 16;
+
+		static_assert(1 + MaterialBits + DeclarationBits + BufferBits + DepthBits == 64, "Sort key bits have to add up to 64 bits");
+
+		/// Maps a pointer to a well distributed id with the given amount of bits. Collisions only affect the sort
+		/// order, since entries are compared by their actual pointers before they are merged.
+		uint64 PointerId(const void* pointer, const uint32 bits)
+		{
+			if (!pointer)
+			{
+				return 0;
+			}
+
+			uint64 value = reinterpret_cast<uintptr_t>(pointer);
+			value ^= value >> 33;
+			value *= 0xff51afd7ed558ccdull;
+			value ^= value >> 33;
+			return value >> (64 - bits);
+		}
+
+		/// Quantizes a squared view depth to 16 bits while keeping the order. Positive floats compare like
+		/// integers, so the upper bits of the float (exponent and the first mantissa bits) are used.
+		uint64 QuantizeDepth(const float squaredViewDepth)
+		{
+			const float depth = std::max(squaredViewDepth, 0.0f);
+
+			uint32 bits;
+			std::memcpy(&bits, &depth, sizeof(bits));
+			return bits >> (32 - DepthBits);
+		}
+	}
+
 	void QueuedRenderableCollection::AddRenderable(Renderable& rend)
 	{
-		m_renderables.push_back(&rend);
+		Entry& entry = m_entries.emplace_back();
+		entry.renderable = &rend;
 	}
 
 	void QueuedRenderableCollection::Clear()
 	{
-		m_renderables.clear();
+		m_entries.clear();
+	}
+
+	void QueuedRenderableCollection::Sort(const Camera& camera, const MaterialPtr& defaultMaterial)
+	{
+		for (Entry& entry : m_entries)
+		{
+			entry.operation = RenderOperation{};
+			entry.renderable->PrepareRenderOperation(entry.operation);
+
+			// Grab material with fallback to default material of the scene
+			entry.operation.material = entry.renderable->GetMaterial();
+			if (!entry.operation.material)
+			{
+				entry.operation.material = defaultMaterial;
+			}
+
+			entry.sortKey = MakeSortKey(entry.operation, entry.renderable->GetSquaredViewDepth(camera));
+		}
+
+		std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b)
+		{
+			return a.sortKey < b.sortKey;
+		});
 	}
 
 	void QueuedRenderableCollection::AcceptVisitor(QueuedRenderableVisitor& visitor) const
 	{
-		for(auto& renderable : m_renderables)
+		for (const Entry& entry : m_entries)
 		{
-			visitor.Visit(*renderable);
+			visitor.Visit(*entry.renderable);
 		}
 	}
+
+	uint64 QueuedRenderableCollection::MakeSortKey(const RenderOperation& operation, const float squaredViewDepth)
+	{
+		const VertexData* vertexData = operation.vertexData;
+		const IndexBuffer* indexBuffer = operation.indexData ? operation.indexData->indexBuffer.get() : nullptr;
+
+		const uint64 materialId = PointerId(operation.material.get(), MaterialBits);
+		const uint64 declarationId = PointerId(vertexData ? vertexData->vertexDeclaration : nullptr, DeclarationBits);
+		const uint64 bufferId = PointerId(vertexData ? vertexData->vertexBufferBinding : nullptr, BufferBits) ^ PointerId(indexBuffer, BufferBits);
+		const uint64 depth = QuantizeDepth(squaredViewDepth);
+
+		const uint64 stateKey = (materialId << (DeclarationBits + BufferBits)) | (declarationId << BufferBits) | bufferId;
+		if (operation.material && operation.material->IsTranslucent())
+		{
+			// Translucent renderables have to be rendered back to front, so depth is the most significant part
+			constexpr uint64 maxDepth = (1ull << DepthBits) - 1;
+			return (1ull << 63) | ((maxDepth - depth) << (MaterialBits + DeclarationBits + BufferBits)) | stateKey;
+		}
+
+		// Opaque renderables are grouped by state and rendered front to back inside of each group
+		return (stateKey << DepthBits) | depth;
+	}
+
+	bool QueuedRenderableCollection::CanShareInstancedDraw(const Entry& first, const Entry& second)
+	{
+		const RenderOperation& a = first.operation;
+		const RenderOperation& b = second.operation;
+
+		if (!first.renderable->CanBeInstanced() || !second.renderable->CanBeInstanced())
+		{
+			return false;
+		}
+
+		if (!a.vertexConstantBuffers.empty() || !a.pixelConstantBuffers.empty() ||
+			!b.vertexConstantBuffers.empty() || !b.pixelConstantBuffers.empty())
+		{
+			return false;
+		}
+
+		return a.vertexData == b.vertexData &&
+			a.indexData == b.indexData &&
+			a.material == b.material &&
+			a.topology == b.topology;
+	}
+
 	void RenderPriorityGroup::AddRenderable(Renderable& renderable)
 	{
 		// TODO: Implement non-solid renderables based on material settings
@@ -4,9 +4,11 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "math/aabb.h"
 #include "renderable.h"
+#include "render_operation.h"
 #include "base/signal.h"
 #include "base/typedefs.h"
 #include "queued_renderable_visitor.h"
@@ -41,6 +43,8 @@ namespace mmo
 		Max = 105
 	};
 
+	/// A collection of renderables which is sorted by a packed state key before rendering, so that renderables
+	/// sharing the same material and buffers end up next to each other and can be merged into instanced draws.
 	class QueuedRenderableCollection
 	{
 	public:
@@ -54,15 +58,44 @@ namespace mmo
 			///	overlaps with descending since both use same sort
 			SortAscending = 6
 		};
-		
+
+		/// A queued renderable with its prepared render operation.
+		struct Entry
+		{
+			uint64 sortKey { 0 };
+			Renderable* renderable { nullptr };
+			RenderOperation operation;
+		};
+
+	public:
 		void AddRenderable(Renderable& rend);
 
 		void Clear();
 
+		/// Prepares the render operations of all queued renderables and sorts them by their state key. Opaque
+		/// renderables are grouped by state (PassGroup) and rendered front to back inside of each group, translucent
+		/// renderables are rendered back to front (SortDescending) after all opaque renderables.
+		/// @param camera The camera used to calculate the view depth of the renderables.
+		/// @param defaultMaterial Material used for renderables which don't provide a material.
+		void Sort(const Camera& camera, const MaterialPtr& defaultMaterial);
+
 		void AcceptVisitor(QueuedRenderableVisitor& visitor) const;
 
+		/// Gets the queued entries in render order. Only valid after Sort has been called.
+		[[nodiscard]] const std::vector<Entry>& GetEntries() const noexcept { return m_entries; }
+
+	public:
+		/// Builds the packed 64 bit sort key of a prepared render operation.
+		/// @param operation The prepared render operation. The material has to be set.
+		/// @param squaredViewDepth The squared distance of the renderable to the camera.
+		[[nodiscard]] static uint64 MakeSortKey(const RenderOperation& operation, float squaredViewDepth);
+
+		/// Determines whether two entries can be rendered with a single instanced draw, which is the case if both
+		/// use the exact same buffers and material and only differ by their world transform.
+		[[nodiscard]] static bool CanShareInstancedDraw(const Entry& first, const Entry& second);
+
 	protected:
-		std::vector<Renderable*> m_renderables;
+		std::vector<Entry> m_entries;
 	};
 
 	class RenderPriorityGroup
@@ -73,6 +106,8 @@ namespace mmo
 
 		[[nodiscard]] const QueuedRenderableCollection& GetSolids() const noexcept { return m_solidCollection; }
 
+		[[nodiscard]] QueuedRenderableCollection& GetSolids() noexcept { return m_solidCollection; }
+
 	private:
 		void AddSolidRenderable(Renderable& renderable);
 
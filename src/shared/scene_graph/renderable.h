@@ -64,5 +64,12 @@ namespace mmo
         [[nodiscard]] virtual bool GetCastsShadows() const { return false; }
         
         [[nodiscard]] virtual MaterialPtr GetMaterial() const = 0;
+
+        /// @brief Determines whether the scene may merge this renderable with others sharing the same mesh and
+        ///        material into a single instanced draw. Only the world transform may differ between instances,
+        ///        so renderables with per-object shader constants must return false. Merged renderables are
+        ///        rendered without calling PreRender and PostRender, so renderables which override them must
+        ///        return false as well.
+        [[nodiscard]] virtual bool CanBeInstanced() const { return false; }
 	};
 }
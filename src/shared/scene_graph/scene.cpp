@@ -169,7 +169,7 @@ namespace mmo
 		gx.SetTransformMatrix(Projection, camera.GetProjectionMatrix());
 		gx.SetTransformMatrix(View, camera.GetViewMatrix());
 
-		RenderVisibleObjects();
+		RenderVisibleObjects(camera);
 	}
 
 	void Scene::UpdateSceneGraph()
@@ -189,11 +189,11 @@ namespace mmo
 		return m_defaultMaterial;
 	}
 
-	void Scene::RenderVisibleObjects()
+	void Scene::RenderVisibleObjects(const Camera& camera)
 	{
 		for (auto& queue = GetRenderQueue(); auto& [groupId, group] : queue)
 		{
-			RenderQueueGroupObjects(*group);
+			RenderQueueGroupObjects(*group, camera);
 		}
 	}
 
@@ -218,16 +218,58 @@ namespace mmo
 		GetRootSceneNode().FindVisibleObjects(camera, GetRenderQueue(), visibleObjectBounds, true);
 	}
 
-	void Scene::RenderObjects(const QueuedRenderableCollection& objects)
+	void Scene::RenderObjects(QueuedRenderableCollection& objects, const Camera& camera)
 	{
-		objects.AcceptVisitor(m_renderableVisitor);
+		objects.Sort(camera, m_defaultMaterial);
+
+		const auto& entries = objects.GetEntries();
+		for (size_t i = 0; i < entries.size(); )
+		{
+			// Find all following entries which can be merged into one instanced draw
+			size_t count = 1;
+			while (i + count < entries.size() && QueuedRenderableCollection::CanShareInstancedDraw(entries[i], entries[i + count]))
+			{
+				++count;
+			}
+
+			if (count == 1)
+			{
+				RenderSingleObject(*entries[i].renderable, entries[i].operation);
+			}
+			else
+			{
+				RenderInstancedObjects(std::span(entries).subspan(i, count));
+			}
+
+			i += count;
+		}
+	}
+
+	void Scene::RenderInstancedObjects(const std::span<const QueuedRenderableCollection::Entry> entries)
+	{
+		ASSERT(!entries.empty());
+
+		const RenderOperation& op = entries.front().operation;
+		if (op.vertexData == nullptr || op.vertexData->vertexCount == 0)
+		{
+			return;
+		}
+
+		// Instanced renderables have no render callbacks, so only their world transforms differ
+		m_instanceTransforms.clear();
+		for (const auto& entry : entries)
+		{
+			m_instanceTransforms.push_back(entry.renderable->GetWorldTransform());
+		}
+
+		GraphicsDevice::Get().RenderInstanced(op, m_instanceTransforms);
 	}
 	
-	void Scene::RenderQueueGroupObjects(RenderQueueGroup& group)
+	void Scene::RenderQueueGroupObjects(RenderQueueGroup& group, const Camera& camera)
 	{
 		for(const auto& [priority, priorityGroup] : group)
 		{
-			RenderObjects(priorityGroup->GetSolids());
+			RenderObjects(priorityGroup->GetSolids(), camera);
 		}
 	}
 
@@ -288,26 +330,29 @@ namespace mmo
 		RenderOperation op { };
 		renderable.PrepareRenderOperation(op);
 
-		if (op.vertexData == nullptr || op.vertexData->vertexCount == 0)
+		// Grab material with fallback to default material of the scene
+		op.material = renderable.GetMaterial();
+		if (!op.material)
 		{
-			return;
+			op.material = m_defaultMaterial;
 		}
 
-		auto& gx = GraphicsDevice::Get();
+		RenderSingleObject(renderable, op);
+	}
 
-		// Grab material with fallback to default material of the scene
-		auto material = renderable.GetMaterial();
-		if (!material)
+	void Scene::RenderSingleObject(Renderable& renderable, const RenderOperation& operation)
+	{
+		if (operation.vertexData == nullptr || operation.vertexData->vertexCount == 0)
 		{
-			material = m_defaultMaterial;
+			return;
 		}
 
-		op.material = material;
+		auto& gx = GraphicsDevice::Get();
 		gx.SetTransformMatrix(World, renderable.GetWorldTransform());
 
 		// Bind vertex layout
 		renderable.PreRender(*this, gx);
-		gx.Render(op);
+		gx.Render(operation);
 		renderable.PostRender(*this, gx);
 	}
 
@@ -17,6 +17,7 @@
 
 #include <map>
 #include <memory>
+#include <span>
 #include <vector>
 
 
@@ -334,6 +335,9 @@ namespace mmo
 		
 		void RenderSingleObject(Renderable& renderable);
 
+		/// Renders a renderable using an already prepared render operation with its material set.
+		void RenderSingleObject(Renderable& renderable, const RenderOperation& operation);
+
 		ManualRenderObject* CreateManualRenderObject(const String& name);
 
 		void DestroyManualRenderObject(const ManualRenderObject& object);
@@ -358,7 +362,7 @@ namespace mmo
 		MaterialPtr GetDefaultMaterial();
 
 	protected:
-		void RenderVisibleObjects();
+		void RenderVisibleObjects(const Camera& camera);
 		
 		void InitRenderQueue();
 
@@ -366,9 +370,15 @@ namespace mmo
 
 		virtual void FindVisibleObjects(Camera& camera, VisibleObjectsBoundsInfo& visibleObjectBounds);
 
-		void RenderObjects(const QueuedRenderableCollection& objects);
+		/// Sorts the given collection and renders it, merging consecutive renderables which share the same
+		/// buffers and material into instanced draws.
+		void RenderObjects(QueuedRenderableCollection& objects, const Camera& camera);
+
+		/// Renders a range of queued renderables with a single instanced draw. PreRender and PostRender aren't
+		/// called for these renderables, see Renderable::CanBeInstanced.
+		void RenderInstancedObjects(std::span<const QueuedRenderableCollection::Entry> entries);
 
-		void RenderQueueGroupObjects(RenderQueueGroup& group);
+		void RenderQueueGroupObjects(RenderQueueGroup& group, const Camera& camera);
 
 		void NotifyLightsDirty();
 		void FindLightsAffectingCamera(const Camera& camera);
@@ -421,6 +431,7 @@ namespace mmo
 		LightObjectMap m_lights;
 		
 		SceneQueuedRenderableVisitor m_renderableVisitor;
+		std::vector<Matrix4> m_instanceTransforms;
 
 		float m_defaultShadowFarDist { 0.0f };
 
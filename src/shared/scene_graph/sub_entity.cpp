@@ -3,6 +3,7 @@
 
 #include "entity.h"
 #include "sub_mesh.h"
+#include "scene_graph/camera.h"
 #include "scene_graph/render_operation.h"
 #include "scene_graph/scene_node.h"
 
@@ -26,18 +27,16 @@ namespace mmo
 
 	float SubEntity::GetSquaredViewDepth(const Camera& camera) const
 	{
-        if (m_cachedCamera == &camera)
-        {
-			return m_cachedCameraDist;
-        }
-
 		const auto* parent = m_parent.GetParentSceneNode();
 		ASSERT(parent);
-		
-		m_cachedCameraDist = 0.0f;
-		m_cachedCamera = &camera;
 
-		return m_cachedCameraDist;
+		return parent->GetDerivedPosition().GetSquaredDistanceTo(camera.GetDerivedPosition());
+	}
+
+	bool SubEntity::CanBeInstanced() const
+	{
+		// Skinned entities bind their own bone matrix buffer
+		return !m_parent.HasSkeleton();
 	}
 
 	const Matrix4& SubEntity::GetWorldTransform() const
@@ -35,6 +35,16 @@ namespace mmo
 		/// @copydoc Renderable::GetMaterial
 		[[nodiscard]] MaterialPtr GetMaterial() const override { return m_material ? m_material : m_subMesh.GetMaterial(); }
 
+		/// @copydoc Renderable::CanBeInstanced
+		[[nodiscard]] bool CanBeInstanced() const override;
+
+		/// @brief Sub entities are merged into instanced draws, which skip the render callbacks, so they can't
+		///        override them.
+		bool PreRender(Scene& scene, GraphicsDevice& graphicsDevice) final { return true; }
+
+		/// @copydoc SubEntity::PreRender
+		void PostRender(Scene& scene, GraphicsDevice& graphicsDevice) final { }
+
 		/// @brief Sets the material to use when rendering this renderable.
 		/// @param material The material to use for rendering or nullptr to use a default material.
 		void SetMaterial(const MaterialPtr& material) noexcept { m_material = material; }
@@ -50,8 +60,5 @@ namespace mmo
 		bool m_renderQueuePrioritySet { false };
 
 		MaterialPtr m_material;
-
-		mutable float m_cachedCameraDist { 0.0f };
-		mutable const Camera* m_cachedCamera { nullptr };
 	};
 }
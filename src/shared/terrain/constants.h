@@ -19,6 +19,13 @@ namespace mmo
 			constexpr uint32 MaxPagesSquared = MaxPages * MaxPages;
 			constexpr double TileSize = 33.33333f;
 			constexpr double PageSize = TileSize * TilesPerPage;
+
+			/// Coarsest level of detail of a tile. Every lod step doubles the distance between the used vertices.
+			constexpr uint32 MaxTileLod = 4;
+			static_assert((1u << MaxTileLod) < VerticesPerTile - 1, "Coarsest tile lod needs at least one inner vertex per edge");
+
+			/// Relative margin around the lod error tolerance which prevents tiles from switching back and forth.
+			constexpr float TileLodHysteresis = 0.25f;
 		}
 	}
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "assets/asset_registry.h"
 #include "base/chunk_writer.h"
 #include "base/utilities.h"
+#include "binary_io/memory_source.h"
 #include "binary_io/stream_sink.h"
 #include "log/default_log_levels.h"
 #include "scene_graph/material_manager.h"
@@ -68,6 +69,7 @@ namespace mmo
 
 		Page::~Page()
 		{
+			CancelPrepare();
 			Unload();
 
 			if (m_pageNode != nullptr)
@@ -85,34 +87,24 @@ namespace mmo
 			}
 
 			m_preparing = true;
+			InitializePageData();
 
-			m_heightmap.resize(constants::VerticesPerPage * constants::VerticesPerPage, 0.0f);
-			m_normals.resize(constants::VerticesPerPage * constants::VerticesPerPage, Vector3::UnitY);
-			m_materials.resize(constants::TilesPerPage * constants::TilesPerPage, nullptr);
-			m_layers.resize(constants::PixelsPerPage * constants::PixelsPerPage, 0x000000FF);
-			m_tileZones.resize(constants::TilesPerPage * constants::TilesPerPage, 0);
-
-			const String pageFileName = m_terrain.GetBaseFileName() + "/" + std::to_string(m_x) + "_" + std::to_string(m_z) + ".tile";
+			const String pageFileName = GetPageFilename();
 			if (AssetRegistry::HasFile(pageFileName))
 			{
 				std::unique_ptr<std::istream> file = AssetRegistry::OpenFile(pageFileName);
 				ASSERT(file);
 
-				// Lets start fresh
-				RemoveAllChunkHandlers();
-
-				// Register chunk handler
-				AddChunkHandler(*constants::VersionChunk, true, *this, &Page::ReadMCVRChunk);
-
 				io::StreamSource source{ *file };
 				io::Reader reader{source};
-				if (!Read(reader))
+				if (!ReadPageData(reader))
 				{
 					ELOG("Failed to read page file '" << pageFileName << "'!");
 					m_preparing = false;
 					return false;
 				}
 
+				ResolveMaterials();
 				m_changed = true;
 			}
 			else
@@ -127,6 +119,140 @@ namespace mmo
 			return true;
 		}
 
+		bool Page::PrepareAsync(AssetStreamer& streamer, const float priority, std::function<void(bool succeeded)> onPrepared)
+		{
+			if (IsPrepared() || IsPreparing())
+			{
+				return true;
+			}
+
+			const String pageFileName = GetPageFilename();
+			if (!AssetRegistry::HasFile(pageFileName))
+			{
+				// Nothing to stream, blank pages are cheap to set up right away
+				const bool succeeded = Prepare();
+				if (onPrepared)
+				{
+					onPrepared(succeeded);
+				}
+
+				return succeeded;
+			}
+
+			m_preparing = true;
+			InitializePageData();
+
+			m_streamer = &streamer;
+			m_prepareRequest = streamer.Request(pageFileName, priority,
+				[this, onPrepared = std::move(onPrepared)](const bool succeeded, const std::vector<char>&)
+				{
+					m_prepareRequest = AssetStreamer::InvalidRequest;
+					m_streamer = nullptr;
+					m_preparing = false;
+
+					if (!succeeded)
+					{
+						ELOG("Failed to read page file '" << GetPageFilename() << "'!");
+					}
+					else
+					{
+						// Material loading creates gpu resources and thus has to happen on this thread
+						ResolveMaterials();
+						m_changed = true;
+						m_prepared = true;
+					}
+
+					if (onPrepared)
+					{
+						onPrepared(succeeded);
+					}
+				},
+				[this](const std::vector<char>& contents)
+				{
+					if (contents.empty())
+					{
+						return false;
+					}
+
+					io::MemorySource source{ contents };
+					io::Reader reader{ source };
+					return ReadPageData(reader);
+				});
+
+			return true;
+		}
+
+		void Page::SetPreparePriority(const float priority)
+		{
+			if (m_streamer && m_prepareRequest != AssetStreamer::InvalidRequest)
+			{
+				m_streamer->SetPriority(m_prepareRequest, priority);
+			}
+		}
+
+		void Page::CancelPrepare()
+		{
+			if (!m_streamer || m_prepareRequest == AssetStreamer::InvalidRequest)
+			{
+				return;
+			}
+
+			// Wait for a running decode since it writes into this page
+			m_streamer->Cancel(m_prepareRequest, true);
+			m_prepareRequest = AssetStreamer::InvalidRequest;
+			m_streamer = nullptr;
+			m_preparing = false;
+		}
+
+		void Page::InitializePageData()
+		{
+			m_heightmap.resize(constants::VerticesPerPage * constants::VerticesPerPage, 0.0f);
+			m_normals.resize(constants::VerticesPerPage * constants::VerticesPerPage, Vector3::UnitY);
+			m_materials.resize(constants::TilesPerPage * constants::TilesPerPage, nullptr);
+			m_layers.resize(constants::PixelsPerPage * constants::PixelsPerPage, 0x000000FF);
+			m_tileZones.resize(constants::TilesPerPage * constants::TilesPerPage, 0);
+			m_materialNames.clear();
+			m_hasMaterialNames = false;
+		}
+
+		bool Page::ReadPageData(io::Reader& reader)
+		{
+			// Lets start fresh
+			RemoveAllChunkHandlers();
+
+			// Register chunk handler
+			AddChunkHandler(*constants::VersionChunk, true, *this, &Page::ReadMCVRChunk);
+
+			return Read(reader);
+		}
+
+		void Page::ResolveMaterials()
+		{
+			if (!m_hasMaterialNames)
+			{
+				return;
+			}
+
+			m_materials.clear();
+			m_materials.reserve(m_materialNames.size());
+
+			for (const auto& materialName : m_materialNames)
+			{
+				if (materialName.empty())
+				{
+					m_materials.push_back(nullptr);
+				}
+				else
+				{
+					// Don't worry: MaterialManager has a cache system, so loading the same material multiple times is not a problem!
+					m_materials.push_back(MaterialManager::Get().Load(materialName));
+				}
+			}
+
+			m_materialNames.clear();
+			m_hasMaterialNames = false;
+		}
+
 		bool Page::IsValid() const noexcept
 		{
 			return ChunkReader::IsValid();
@@ -640,8 +766,10 @@ namespace mmo
 				return false;
 			}
 
-			m_materials.clear();
-			m_materials.reserve(numMaterials);
+			// Only remember the names here since this might be executed on a streaming worker thread
+			m_materialNames.clear();
+			m_materialNames.reserve(numMaterials);
+			m_hasMaterialNames = true;
 
 			for (uint16 i = 0; i < numMaterials; ++i)
 			{
@@ -652,15 +780,7 @@ namespace mmo
 					return false;
 				}
 
-				if (materialName.empty())
-				{
-					m_materials.push_back(nullptr);
-				}
-				else
-				{
-					// Don't worry: MaterialManager has a cache system, so loading the same material multiple times is not a problem!
-					m_materials.push_back(MaterialManager::Get().Load(materialName));
-				}
+				m_materialNames.push_back(std::move(materialName));
 			}
 
 			return reader;
@@ -2,6 +2,8 @@
 
 #include "base/typedefs.h"
 
+#include "assets/asset_streamer.h"
+
 #include "base/grid.h"
 #include "graphics/material.h"
 #include "math/aabb.h"
@@ -9,6 +11,7 @@
 
 #include <unordered_map>
 #include <array>
+#include <functional>
 
 #include "base/chunk_reader.h"
 #include "base/chunk_writer.h"
@@ -44,6 +47,20 @@ namespace mmo
 		public:
 			bool Prepare();
 
+			/// Prepares the page in the background. Reading and parsing the page file is done by the streamer's
+			/// worker threads, while materials are resolved once the streamer hands the result back.
+			/// @param streamer The streamer used to load the page file. Has to outlive the page or the request.
+			/// @param priority Priority of the request, lower values are served first.
+			/// @param onPrepared Executed on the thread processing streamer completions after the page has been prepared.
+			/// @returns false if the page could not be prepared.
+			bool PrepareAsync(AssetStreamer& streamer, float priority, std::function<void(bool succeeded)> onPrepared = nullptr);
+
+			/// Updates the priority of a pending asynchronous prepare request.
+			void SetPreparePriority(float priority);
+
+			/// Cancels a pending asynchronous prepare request. Blocks if the page file is currently being parsed.
+			void CancelPrepare();
+
 			bool Load();
 
 			void Unload();
@@ -132,6 +149,12 @@ namespace mmo
 
 			bool ReadMCARChunk(io::Reader& reader, uint32 header, uint32 size);
 
+			bool ReadPageData(io::Reader& reader);
+
+			void ResolveMaterials();
+
+			void InitializePageData();
+
 		private:
 			void UpdateBoundingBox();
 
@@ -154,6 +177,8 @@ namespace mmo
 			std::vector<Vector3> m_normals;
 			std::vector<Vector3> m_tangents;
 			std::vector<MaterialPtr> m_materials;
+			std::vector<String> m_materialNames;
+			bool m_hasMaterialNames { false };
 			std::vector<uint32> m_layers;
 			std::vector<uint32> m_tileZones;
 
@@ -164,6 +189,8 @@ namespace mmo
 			bool m_loaded;
 			bool m_changed{ false };
 			bool m_unloadRequested = false;
+			AssetStreamer* m_streamer { nullptr };
+			AssetStreamer::RequestId m_prepareRequest { AssetStreamer::InvalidRequest };
 			AABB m_boundingBox;
 		};
 	}
@@ -279,6 +279,19 @@ namespace mmo
 			return page->GetTile(tileX, tileY);
 		}
 
+		IndexData* Terrain::GetTileIndexData(const uint32 lod, const uint32 neighborState)
+		{
+			const uint64 key = static_cast<uint64>(lod) << 32 | neighborState;
+
+			auto it = m_tileIndexData.find(key);
+			if (it == m_tileIndexData.end())
+			{
+				it = m_tileIndexData.emplace(key, Tile::CreateIndexData(lod, neighborState)).first;
+			}
+
+			return it->second.get();
+		}
+
 		Page* Terrain::GetPage(const uint32 x, const uint32 z) const
 		{
 			if (x >= m_width || z >= m_height)
@@ -7,6 +7,7 @@
 #include "math/vector3.h"
 
 #include <memory>
+#include <unordered_map>
 
 #include "graphics/material.h"
 
@@ -18,6 +19,7 @@ namespace mmo
 	class SceneNode;
 	class Scene;
 	class Camera;
+	class IndexData;
 
 	namespace terrain
 	{
@@ -97,6 +99,16 @@ namespace mmo
 
 			uint32 GetTileSceneQueryFlags() const { return m_tileSceneQueryFlags; }
 
+			/// Gets the index data shared by all tiles with the given lod and neighbor state. The index data is
+			/// created on first use and lives as long as the terrain.
+			IndexData* GetTileIndexData(uint32 lod, uint32 neighborState);
+
+			/// Sets the maximum height error in pixels a tile may have on screen before a finer lod is used.
+			///	A value of 0 disables level of detail and renders all tiles at full resolution.
+			void SetLodPixelError(const float pixels) { m_lodPixelError = pixels; }
+
+			float GetLodPixelError() const { return m_lodPixelError; }
+
 			struct RayIntersectsResult
 			{
 				Tile* tile;
@@ -275,6 +287,8 @@ namespace mmo
 			int32 m_lastZ;
 			uint32 m_tileSceneQueryFlags = 0;
 			MaterialPtr m_defaultMaterial;
+			std::unordered_map<uint64, std::unique_ptr<IndexData>> m_tileIndexData;
+			float m_lodPixelError = 2.0f;
 		};
 	}
 
@@ -9,11 +9,77 @@
 #include "graphics/texture_mgr.h"
 #include "scene_graph/mesh_manager.h"
 #include "scene_graph/scene.h"
+#include "scene_graph/camera.h"
+
+#include <algorithm>
 
 namespace mmo
 {
 	namespace terrain
 	{
+		namespace
+		{
+			constexpr uint32 LastVertex = constants::VerticesPerTile - 1;
+
+			uint16 GetIndex(const uint32 x, const uint32 y)
+			{
+				return static_cast<uint16>(x + y * constants::VerticesPerTile);
+			}
+
+			void AddTriangle(std::vector<uint16>& indices, const uint32 ax, const uint32 ay, uint32 bx, uint32 by, uint32 cx, uint32 cy)
+			{
+				// Use the same winding order as the regular grid triangles
+				const int32 cross = (static_cast<int32>(bx) - static_cast<int32>(ax)) * (static_cast<int32>(cy) - static_cast<int32>(ay)) -
+					(static_cast<int32>(by) - static_cast<int32>(ay)) * (static_cast<int32>(cx) - static_cast<int32>(ax));
+				if (cross == 0)
+				{
+					return;
+				}
+
+				if (cross > 0)
+				{
+					std::swap(bx, cx);
+					std::swap(by, cy);
+				}
+
+				indices.push_back(GetIndex(ax, ay));
+				indices.push_back(GetIndex(bx, by));
+				indices.push_back(GetIndex(cx, cy));
+			}
+
+			/// Connects the edge vertices used by the coarser neighbor with the first inner vertex row of the tile by
+			/// walking along both rows at once and always advancing the row whose next vertex comes first.
+			void StitchEdge(std::vector<uint16>& indices, const std::vector<uint32>& edge, const std::vector<uint32>& inner, const uint32 edgeLine, const uint32 innerLine, const bool horizontal)
+			{
+				const auto addTriangle = [&](const uint32 a, const uint32 aLine, const uint32 b, const uint32 bLine, const uint32 c, const uint32 cLine)
+				{
+					if (horizontal)
+					{
+						AddTriangle(indices, a, aLine, b, bLine, c, cLine);
+					}
+					else
+					{
+						AddTriangle(indices, aLine, a, bLine, b, cLine, c);
+					}
+				};
+
+				size_t e = 0, i = 0;
+				while (e + 1 < edge.size() || i + 1 < inner.size())
+				{
+					if (i + 1 >= inner.size() || (e + 1 < edge.size() && edge[e + 1] <= inner[i + 1]))
+					{
+						addTriangle(edge[e], edgeLine, edge[e + 1], edgeLine, inner[i], innerLine);
+						++e;
+					}
+					else
+					{
+						addTriangle(edge[e], edgeLine, inner[i], innerLine, inner[i + 1], innerLine);
+						++i;
+					}
+				}
+			}
+		}
+
 		Tile::Tile(const String& name, Page& page, size_t startX, size_t startZ)
 			: MovableObject(name)
 			, Renderable()
@@ -27,7 +93,8 @@ namespace mmo
 			m_tileY = m_startZ / (constants::VerticesPerTile - 1);
 
 			CreateVertexData(m_startX, m_startZ);
-			CreateIndexData(0, 0);
+			UpdateLodErrors();
+			m_indexData = GetTerrain().GetTileIndexData(0, 0);
 
 			m_coverageTexture = TextureManager::Get().CreateManual(m_name, constants::PixelsPerTile, constants::PixelsPerTile, R8G8B8A8, BufferUsage::StaticWriteOnly);
 			ASSERT(m_coverageTexture);
@@ -63,8 +130,11 @@ namespace mmo
 
 		void Tile::PrepareRenderOperation(RenderOperation& operation)
 		{
+			// Neighbors have selected their lod by now, so the edges can be stitched consistently
+			m_indexData = GetTerrain().GetTileIndexData(m_lod, GetNeighborState());
+
 			operation.vertexData = m_vertexData.get();
-			operation.indexData = m_indexData.get();
+			operation.indexData = m_indexData;
 			operation.topology = TopologyType::TriangleList;
 			operation.material = GetMaterial();
 		}
@@ -138,6 +208,13 @@ namespace mmo
 			queue.AddRenderable(*this, m_renderQueueId);
 		}
 
+		void Tile::SetCurrentCamera(Camera& cam)
+		{
+			MovableObject::SetCurrentCamera(cam);
+
+			UpdateLod(cam);
+		}
+
 		Terrain& Tile::GetTerrain() const
 		{
 			return m_page.GetTerrain();
@@ -198,6 +275,8 @@ namespace mmo
 			m_bounds.max.y = maxHeight;
 			m_center = m_bounds.GetCenter();
 			m_boundingRadius = (m_bounds.max - m_center).GetLength();
+
+			UpdateLodErrors();
 		}
 
 		void Tile::UpdateCoverageMap()
@@ -311,187 +390,200 @@ namespace mmo
 			m_boundingRadius = (m_bounds.max - m_center).GetLength();
 		}
 
-		void Tile::CreateIndexData(uint32 lod, uint32 neighborState)
+		uint32 Tile::MakeNeighborState(const uint32 lod, const uint32 northLod, const uint32 eastLod, const uint32 southLod, const uint32 westLod)
 		{
-			const unsigned int step = 1 << lod;
+			const auto coarser = [lod](const uint32 neighborLod) { return neighborLod > lod ? neighborLod : 0; };
+			return coarser(northLod) << 24 | coarser(eastLod) << 16 | coarser(southLod) << 8 | coarser(westLod);
+		}
+
+		std::vector<uint32> Tile::GetLodVertices(const uint32 lod)
+		{
+			// The edge length isn't a power of two, so the last vertex is always used in addition to every 2^lod-th
+			// vertex. Every lod uses a subset of the vertices of the previous lod, which makes stitching possible.
+			std::vector<uint32> vertices;
+
+			const uint32 step = 1 << lod;
+			for (uint32 i = 0; i < LastVertex; i += step)
+			{
+				vertices.push_back(i);
+			}
+
+			vertices.push_back(LastVertex);
+			return vertices;
+		}
 
-			const unsigned int northLOD = neighborState >> 24;
-			const unsigned int eastLOD = (neighborState >> 16) & 0xFF;
-			const unsigned int southLOD = (neighborState >> 8) & 0xFF;
-			const unsigned int westLOD = neighborState & 0xFF;
-			const unsigned int north = northLOD ? step : 0;
-			const unsigned int east = eastLOD ? step : 0;
-			const unsigned int south = southLOD ? step : 0;
-			const unsigned int west = westLOD ? step : 0;
+		std::vector<uint16> Tile::CreateIndices(const uint32 lod, const uint32 neighborState)
+		{
+			const uint32 northLOD = neighborState >> 24;
+			const uint32 eastLOD = (neighborState >> 16) & 0xFF;
+			const uint32 southLOD = (neighborState >> 8) & 0xFF;
+			const uint32 westLOD = neighborState & 0xFF;
 
-			const size_t newLength = (constants::VerticesPerTile / step) * (constants::VerticesPerTile / step) * 2 * 2 * 2;
-			std::vector<uint16> indices(newLength);
-			uint16* pIdx = indices.data();
+			const std::vector<uint32> vertices = GetLodVertices(lod);
+			const size_t last = vertices.size() - 1;
+			const size_t firstRow = northLOD ? 1 : 0;
+			const size_t lastRow = southLOD ? last - 1 : last;
+			const size_t firstColumn = westLOD ? 1 : 0;
+			const size_t lastColumn = eastLOD ? last - 1 : last;
 
-			unsigned int numIndexes = 0;
+			std::vector<uint16> indices;
+			indices.reserve(last * last * 6 + 4 * constants::VerticesPerTile * 3);
 
 			// go over all vertices and combine them to triangles in trilist format.
 			// leave out the edges if we need to stitch those in case over lower LOD at the
 			// neighbour.
-			for (unsigned int j = north; j < constants::VerticesPerTile - 1 - south; j += step)
+			for (size_t row = firstRow; row < lastRow; ++row)
 			{
-				for (unsigned int i = west; i < constants::VerticesPerTile - 1 - east; i += step)
+				for (size_t column = firstColumn; column < lastColumn; ++column)
 				{
-					// triangles
-					*pIdx++ = GetIndex(i, j);
-					*pIdx++ = GetIndex(i, j + step);
-					*pIdx++ = GetIndex(i + step, j);
+					const uint32 x0 = vertices[column], x1 = vertices[column + 1];
+					const uint32 y0 = vertices[row], y1 = vertices[row + 1];
 
-					*pIdx++ = GetIndex(i, j + step);
-					*pIdx++ = GetIndex(i + step, j + step);
-					*pIdx++ = GetIndex(i + step, j);
+					// triangles
+					indices.push_back(GetIndex(x0, y0));
+					indices.push_back(GetIndex(x0, y1));
+					indices.push_back(GetIndex(x1, y0));
 
-					numIndexes += 6;
+					indices.push_back(GetIndex(x0, y1));
+					indices.push_back(GetIndex(x1, y1));
+					indices.push_back(GetIndex(x1, y0));
 				}
 			}
 
 			// stitching edges to neighbours where needed
-			if (northLOD) {
-				numIndexes += StitchEdge(Direction::North, lod, northLOD, westLOD > 0, eastLOD > 0, &pIdx);
+			const std::vector<uint32> innerColumns(vertices.begin() + firstColumn, vertices.begin() + lastColumn + 1);
+			const std::vector<uint32> innerRows(vertices.begin() + firstRow, vertices.begin() + lastRow + 1);
+			if (northLOD)
+			{
+				StitchEdge(indices, GetLodVertices(northLOD), innerColumns, 0, vertices[1], true);
 			}
-			if (eastLOD) {
-				numIndexes += StitchEdge(Direction::East, lod, eastLOD, northLOD > 0, southLOD > 0, &pIdx);
+			if (eastLOD)
+			{
+				StitchEdge(indices, GetLodVertices(eastLOD), innerRows, LastVertex, vertices[last - 1], false);
 			}
-			if (southLOD) {
-				numIndexes += StitchEdge(Direction::South, lod, southLOD, eastLOD > 0, westLOD > 0, &pIdx);
+			if (southLOD)
+			{
+				StitchEdge(indices, GetLodVertices(southLOD), innerColumns, LastVertex, vertices[last - 1], true);
 			}
-			if (westLOD) {
-				numIndexes += StitchEdge(Direction::West, lod, westLOD, southLOD > 0, northLOD > 0, &pIdx);
+			if (westLOD)
+			{
+				StitchEdge(indices, GetLodVertices(westLOD), innerRows, 0, vertices[1], false);
 			}
 
-			m_indexData = std::make_unique<IndexData>();
-			m_indexData->indexBuffer = GraphicsDevice::Get().CreateIndexBuffer(numIndexes, IndexBufferSize::Index_16, BufferUsage::StaticWriteOnly, indices.data());
-			m_indexData->indexCount = numIndexes;
-			m_indexData->indexStart = 0;
+			return indices;
 		}
 
-		uint16 Tile::GetIndex(size_t x, size_t y) const
+		std::unique_ptr<IndexData> Tile::CreateIndexData(const uint32 lod, const uint32 neighborState)
 		{
-			return static_cast<uint16>(x + y * constants::VerticesPerTile);
+			const std::vector<uint16> indices = CreateIndices(lod, neighborState);
+
+			auto indexData = std::make_unique<IndexData>();
+			indexData->indexBuffer = GraphicsDevice::Get().CreateIndexBuffer(indices.size(), IndexBufferSize::Index_16, BufferUsage::StaticWriteOnly, indices.data());
+			indexData->indexCount = indices.size();
+			indexData->indexStart = 0;
+			return indexData;
 		}
 
-		uint32 Tile::StitchEdge(Direction direction, uint32 hiLOD, uint32 loLOD, bool omitFirstTri, bool omitLastTri, uint16** ppIdx)
+		void Tile::UpdateLod(const Camera& camera)
 		{
-			ASSERT(loLOD > hiLOD);
-
-			unsigned short* pIdx = *ppIdx;
-
-			int step = 1 << hiLOD;
-			int superstep = 1 << loLOD;
-			int halfsuperstep = superstep >> 1;
-			int rowstep = 0;
-			size_t startx = 0, starty = 0, endx = 0;
-			bool horizontal = false;
+			const float tolerance = GetTerrain().GetLodPixelError();
+			if (tolerance <= 0.0f)
+			{
+				m_lod = 0;
+				return;
+			}
 
-			switch (direction)
+			// Distance from the camera to the closest point of the tile bounds
+			const AABB& bounds = GetWorldBoundingBox(true);
+			const Vector3& cameraPosition = camera.GetDerivedPosition();
+			const Vector3 closest(
+				std::clamp(cameraPosition.x, bounds.min.x, bounds.max.x),
+				std::clamp(cameraPosition.y, bounds.min.y, bounds.max.y),
+				std::clamp(cameraPosition.z, bounds.min.z, bounds.max.z));
+			const float distance = std::max((closest - cameraPosition).GetLength(), camera.GetNearClipDistance());
+
+			// Number of pixels a world unit covers on screen at the tile distance
+			int32 viewportHeight = 0;
+			GraphicsDevice::Get().GetViewport(nullptr, nullptr, nullptr, &viewportHeight, nullptr, nullptr);
+			const float pixelsPerUnit = camera.GetProjectionMatrix()[1][1] * static_cast<float>(viewportHeight) * 0.5f / distance;
+
+			while (m_lod < constants::MaxTileLod && m_lodErrors[m_lod + 1] * pixelsPerUnit <= tolerance * (1.0f - constants::TileLodHysteresis))
 			{
-			case Direction::North:
-				startx = starty = 0;
-				endx = 17 - 1;
-				rowstep = step;
-				horizontal = true;
-				break;
-
-			case Direction::South:
-				startx = starty = 17 - 1;
-				endx = 0;
-				rowstep = -step;
-				step = -step;
-				superstep = -superstep;
-				halfsuperstep = -halfsuperstep;
-				horizontal = true;
-				break;
-
-			case Direction::East:
-				startx = 0;
-				endx = 17 - 1;
-				starty = 17 - 1;
-				rowstep = -step;
-				horizontal = false;
-				break;
-
-			case Direction::West:
-				startx = 17 - 1;
-				endx = 0;
-				starty = 0;
-				rowstep = step;
-				step = -step;
-				superstep = -superstep;
-				halfsuperstep = -halfsuperstep;
-				horizontal = false;
-				break;
+				++m_lod;
 			}
 
-			unsigned int numIndexes = 0;
+			while (m_lod > 0 && m_lodErrors[m_lod] * pixelsPerUnit > tolerance * (1.0f + constants::TileLodHysteresis))
+			{
+				--m_lod;
+			}
+		}
 
-			for (size_t j = startx; j != endx; j += superstep)
+		void Tile::UpdateLodErrors()
+		{
+			std::array<float, constants::VerticesPerTile * constants::VerticesPerTile> heights;
+			for (uint32 y = 0; y < constants::VerticesPerTile; ++y)
 			{
-				int k;
-				for (k = 0; k != halfsuperstep; k += step)
+				for (uint32 x = 0; x < constants::VerticesPerTile; ++x)
 				{
-					size_t jk = j + k;
-					if (j != startx || k != 0 || !omitFirstTri)
-					{
-						if (horizontal)
-						{
-							*pIdx++ = GetIndex(j, starty);
-							*pIdx++ = GetIndex(jk, starty + rowstep);
-							*pIdx++ = GetIndex(jk + step, starty + rowstep);
-						}
-						else
-						{
-							*pIdx++ = GetIndex(starty, j);
-							*pIdx++ = GetIndex(starty + rowstep, jk);
-							*pIdx++ = GetIndex(starty + rowstep, jk + step);
-						}
-						numIndexes += 3;
-					}
+					heights[GetIndex(x, y)] = m_page.GetHeightAt(m_startX + x, m_startZ + y);
 				}
+			}
 
-				if (horizontal)
-				{
-					*pIdx++ = GetIndex(j, starty);
-					*pIdx++ = GetIndex(j + halfsuperstep, starty + rowstep);
-					*pIdx++ = GetIndex(j + superstep, starty);
-				}
-				else
-				{
-					*pIdx++ = GetIndex(starty, j);
-					*pIdx++ = GetIndex(starty + rowstep, j + halfsuperstep);
-					*pIdx++ = GetIndex(starty, j + superstep);
-				}
-				numIndexes += 3;
+			// Compare every vertex with the height interpolated from the corners of the coarse cell it's in
+			m_lodErrors[0] = 0.0f;
+			for (uint32 lod = 1; lod <= constants::MaxTileLod; ++lod)
+			{
+				float maxError = m_lodErrors[lod - 1];
 
-				for (k = halfsuperstep; k != superstep; k += step)
+				const std::vector<uint32> vertices = GetLodVertices(lod);
+				for (size_t row = 0; row + 1 < vertices.size(); ++row)
 				{
-					size_t jk = j + k;
-					if (j != endx - superstep || k != superstep - step || !omitLastTri)
+					for (size_t column = 0; column + 1 < vertices.size(); ++column)
 					{
-						if (horizontal)
-						{
-							*pIdx++ = GetIndex(j + superstep, starty);
-							*pIdx++ = GetIndex(jk, starty + rowstep);
-							*pIdx++ = GetIndex(jk + step, starty + rowstep);
-						}
-						else
+						const uint32 x0 = vertices[column], x1 = vertices[column + 1];
+						const uint32 y0 = vertices[row], y1 = vertices[row + 1];
+
+						const float h00 = heights[GetIndex(x0, y0)];
+						const float h10 = heights[GetIndex(x1, y0)];
+						const float h01 = heights[GetIndex(x0, y1)];
+						const float h11 = heights[GetIndex(x1, y1)];
+
+						for (uint32 y = y0; y <= y1; ++y)
 						{
-							*pIdx++ = GetIndex(starty, j + superstep);
-							*pIdx++ = GetIndex(starty + rowstep, jk);
-							*pIdx++ = GetIndex(starty + rowstep, jk + step);
+							const float ty = static_cast<float>(y - y0) / static_cast<float>(y1 - y0);
+							for (uint32 x = x0; x <= x1; ++x)
+							{
+								const float tx = static_cast<float>(x - x0) / static_cast<float>(x1 - x0);
+								const float interpolated =
+									(h00 * (1.0f - tx) + h10 * tx) * (1.0f - ty) +
+									(h01 * (1.0f - tx) + h11 * tx) * ty;
+
+								maxError = std::max(maxError, std::abs(heights[GetIndex(x, y)] - interpolated));
+							}
 						}
-						numIndexes += 3;
 					}
 				}
+
+				m_lodErrors[lod] = maxError;
 			}
+		}
+
+		uint32 Tile::GetNeighborState() const
+		{
+			const int32 globalX = static_cast<int32>(m_page.GetX() * constants::TilesPerPage + m_tileX);
+			const int32 globalY = static_cast<int32>(m_page.GetY() * constants::TilesPerPage + m_tileY);
 
-			*ppIdx = pIdx;
+			const auto getNeighborLod = [this](const int32 x, const int32 y) -> uint32
+			{
+				const Tile* neighbor = GetTerrain().GetTile(x, y);
+				return neighbor ? neighbor->GetLod() : 0;
+			};
 
-			return numIndexes;
+			return MakeNeighborState(m_lod,
+				getNeighborLod(globalX, globalY - 1),
+				getNeighborLod(globalX + 1, globalY),
+				getNeighborLod(globalX, globalY + 1),
+				getNeighborLod(globalX - 1, globalY));
 		}
 	}
 }
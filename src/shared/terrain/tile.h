@@ -4,8 +4,11 @@
 #include "scene_graph/movable_object.h"
 #include "scene_graph/renderable.h"
 
+#include <array>
 #include <memory>
+#include <vector>
 
+#include "constants.h"
 #include "coverage_map.h"
 #include "graphics/material_instance.h"
 #include "scene_graph/mesh.h"
@@ -58,6 +61,8 @@ namespace mmo
 
 			void PopulateRenderQueue(RenderQueue& queue) override;
 
+			void SetCurrentCamera(Camera& cam) override;
+
 			Page& GetPage() const { return m_page; }
 
 			Terrain& GetTerrain() const;
@@ -66,22 +71,37 @@ namespace mmo
 
 			void UpdateCoverageMap();
 
-		private:
-			void CreateVertexData(size_t startX, size_t startZ);
+			/// Gets the level of detail the tile is currently rendered with.
+			[[nodiscard]] uint32 GetLod() const { return m_lod; }
+
+			/// Selects the level of detail based on the projected geometric error for the given camera. The scene
+			/// calls SetCurrentCamera, and thus this method, for every tile before it prepares the render operation
+			/// of any tile, so all neighbors have selected their lod when the edges are stitched.
+			void UpdateLod(const Camera& camera);
+
+			/// Combines the lods of the four neighbors of a tile into a neighbor state. The neighbor state contains
+			/// the lod of the north, east, south and west neighbor (8 bits each, north in the highest bits) if it is
+			/// coarser than the tile lod and 0 otherwise.
+			static uint32 MakeNeighborState(uint32 lod, uint32 northLod, uint32 eastLod, uint32 southLod, uint32 westLod);
 
-			void CreateIndexData(uint32 lod, uint32 neighborState);
+			/// Gets the vertices along a tile edge which are used by the given lod.
+			static std::vector<uint32> GetLodVertices(uint32 lod);
 
-			uint16 GetIndex(size_t x, size_t y) const;
+			/// Creates the triangle list indices of a tile with the given lod and neighbor state. Edges towards
+			/// coarser neighbors are stitched to the edge vertices of the neighbor lod to avoid cracks.
+			static std::vector<uint16> CreateIndices(uint32 lod, uint32 neighborState);
+
+			/// Creates the index data of a tile with the given lod and neighbor state.
+			static std::unique_ptr<IndexData> CreateIndexData(uint32 lod, uint32 neighborState);
+
+		private:
+			void CreateVertexData(size_t startX, size_t startZ);
 
-			enum class Direction : uint8
-			{
-				North = 0,
-				East = 1,
-				South = 2,
-				West = 3
-			};
+			/// Calculates the maximum height error of every lod compared to the full resolution tile.
+			void UpdateLodErrors();
 
-			uint32 StitchEdge(Direction direction, uint32 hiLOD, uint32 loLOD, bool omitFirstTri, bool omitLastTri, uint16** ppIdx);
+			/// Builds the neighbor state for the current lod from the lods the neighbor tiles have selected.
+			uint32 GetNeighborState() const;
 
 		private:
 			Page& m_page;
@@ -91,7 +111,10 @@ namespace mmo
 			float m_boundingRadius;
 			Vector3 m_center;
 			std::unique_ptr<VertexData> m_vertexData;
-			std::unique_ptr<IndexData> m_indexData;
+			/// Shared index data owned by the terrain.
+			IndexData* m_indexData { nullptr };
+			std::array<float, constants::MaxTileLod + 1> m_lodErrors {};
+			uint32 m_lod { 0 };
 			VertexBufferPtr m_mainBuffer;
 			std::shared_ptr<MaterialInstance> m_materialInstance;
 			TexturePtr m_coverageTexture;
@@ -2,6 +2,7 @@
 
 #include "compile_directory.h"
 
+#include "base/binary_delta.h"
 #include "base/macros.h"
 #include "base/sha1.h"
 
@@ -14,7 +15,14 @@
 
 #include "zstr/zstr.hpp"
 
-#include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
 
 namespace mmo
 {
@@ -26,6 +34,471 @@ namespace mmo
 			typedef sff::read::tree::Table<Iterator> Table;
 			typedef sff::write::Table<char> TableWriter;
 
+			/// Maximum number of delta patches created at once. Creating a patch keeps both versions of a large file
+			/// in memory, so the other workers keep compressing files in the meantime.
+			constexpr size_t MaxConcurrentPatches = 2;
+
+			/// Limits the number of jobs holding a slot at the same time. Slots are acquired through PatchSlot.
+			class PatchSlots final
+			{
+			public:
+				void Acquire()
+				{
+					std::unique_lock lock{ m_mutex };
+					m_slotReleased.wait(lock, [this]() { return m_used < MaxConcurrentPatches; });
+					++m_used;
+				}
+
+				void Release()
+				{
+					{
+						std::scoped_lock lock{ m_mutex };
+						--m_used;
+					}
+
+					m_slotReleased.notify_one();
+				}
+
+			private:
+				std::mutex m_mutex;
+				std::condition_variable m_slotReleased;
+				size_t m_used = 0;
+			};
+
+			/// Holds one of the patch slots for as long as it exists.
+			class PatchSlot final
+			{
+			public:
+				explicit PatchSlot(PatchSlots &slots)
+					: m_slots(slots)
+				{
+					m_slots.Acquire();
+				}
+
+				~PatchSlot()
+				{
+					m_slots.Release();
+				}
+
+				PatchSlot(const PatchSlot &) = delete;
+				PatchSlot &operator=(const PatchSlot &) = delete;
+
+			private:
+				PatchSlots &m_slots;
+			};
+
+			/// A source file which has to be compiled, along with the results of the compilation.
+			struct FileJob
+			{
+				virtual_dir::Path source;
+				/// Output path without the suffix of compressed files.
+				virtual_dir::Path destination;
+				std::string fileName;
+
+				std::uintmax_t originalSize = 0;
+				std::string sha1;
+				std::uintmax_t compressedSize = 0;
+				bool isCached = false;
+
+				/// Digest of the previous version of the file the patch applies to. Empty if there is no patch.
+				std::string patchFrom;
+				std::string patchName;
+				std::uintmax_t patchSize = 0;
+				std::uintmax_t patchOriginalSize = 0;
+			};
+
+			struct CompileContext
+			{
+				const CompileOptions &options;
+				/// True while walking the source list for the first time to find all files.
+				bool isCollecting = true;
+				/// All files of the source list by destination path.
+				std::map<virtual_dir::Path, FileJob> files;
+				/// Digests of the files of the previous build by destination path, taken from the cache.
+				std::map<virtual_dir::Path, std::string> previousDigests;
+				/// Limits the number of patches created at once by the workers.
+				mutable PatchSlots patchSlots;
+
+				explicit CompileContext(const CompileOptions &options)
+					: options(options)
+				{
+				}
+			};
+
+			void copyStream(std::istream &source, std::ostream &sink)
+			{
+				char buf[4096];
+				std::streamsize read;
+				do
+				{
+					source.read(buf, 4096);
+					read = source.gcount();
+					if (read > 0)
+					{
+						sink.write(buf, read);
+					}
+				} while (source && read > 0);
+			}
+
+			std::vector<char> readWholeFile(std::istream &source)
+			{
+				source.clear();
+				source.seekg(0, std::ios::end);
+				std::vector<char> content(static_cast<size_t>(source.tellg()));
+				source.seekg(0, std::ios::beg);
+				source.read(content.data(), static_cast<std::streamsize>(content.size()));
+				return content;
+			}
+
+			/// Writes a file to the cache. Writes to a temporary file first, so concurrent jobs with the same content
+			/// and aborted builds never leave a partial file behind.
+			template<class WriteContent>
+			void writeCacheFile(const std::filesystem::path &path, const size_t uniqueId, WriteContent &&writeContent)
+			{
+				const std::filesystem::path temporaryPath = path.string() + ".tmp" + std::to_string(uniqueId);
+
+				{
+					std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+					if (!file)
+					{
+						throw std::runtime_error("Could not open cache file " + temporaryPath.string());
+					}
+
+					writeContent(file);
+				}
+
+				std::error_code error;
+				std::filesystem::rename(temporaryPath, path, error);
+				if (error)
+				{
+					// Another job stored the same content in the meantime
+					std::filesystem::remove(temporaryPath, error);
+				}
+			}
+
+			std::filesystem::path getCachedObjectPath(const CompileContext &context, const std::string &digest)
+			{
+				return context.options.cacheDirectory / "objects" / (digest + ".z");
+			}
+
+			std::filesystem::path getCachedSourcePath(const CompileContext &context, const std::string &digest)
+			{
+				return context.options.cacheDirectory / "sources" / digest;
+			}
+
+			std::unique_ptr<std::ostream> openOutputFile(virtual_dir::IWriter &outputRoot, const virtual_dir::Path &path)
+			{
+				auto outputFile = outputRoot.writeFile(path, false, true);
+				if (!outputFile)
+				{
+					throw std::runtime_error("Could not open output file " + path);
+				}
+
+				return outputFile;
+			}
+
+			/// Writes a delta patch from the previous version of a large file, if that version is in the cache.
+			void writePatch(
+				virtual_dir::IReader &sourceRoot,
+				virtual_dir::IWriter &outputRoot,
+				const CompileContext &context,
+				FileJob &job
+			)
+			{
+				const auto previous = context.previousDigests.find(job.destination);
+				if (previous == context.previousDigests.end() ||
+					previous->second == job.sha1)
+				{
+					return;
+				}
+
+				std::ifstream previousFile(getCachedSourcePath(context, previous->second), std::ios::binary);
+				if (!previousFile)
+				{
+					return;
+				}
+
+				const auto sourceFile = sourceRoot.readFile(job.source, false);
+				if (!sourceFile)
+				{
+					throw std::runtime_error("Could not open source file " + job.source);
+				}
+
+				// Both versions of the file are kept in memory until the delta has been created
+				const PatchSlot slot{ context.patchSlots };
+				const auto previousContent = readWholeFile(previousFile);
+				const auto content = readWholeFile(*sourceFile);
+
+				std::ostringstream delta;
+				CreateBinaryDelta(previousContent.data(), previousContent.size(), content.data(), content.size(), delta);
+
+				std::string patch = delta.str();
+				job.patchOriginalSize = patch.size();
+
+				if (context.options.isZLibCompressed)
+				{
+					std::ostringstream compressed;
+					{
+						zstr::ostream compressor(compressed);
+						compressor.write(patch.data(), static_cast<std::streamsize>(patch.size()));
+					}
+
+					patch = compressed.str();
+				}
+
+				// A patch which is not smaller than the file itself only slows the update down
+				if (patch.size() >= job.compressedSize)
+				{
+					return;
+				}
+
+				job.patchFrom = previous->second;
+				job.patchName = job.fileName + "." + previous->second + ".patch";
+				if (context.options.isZLibCompressed)
+				{
+					job.patchName += ".z";
+				}
+				job.patchSize = patch.size();
+
+				const auto patchPath = virtual_dir::joinPaths(virtual_dir::splitLeaf(job.destination).first, job.patchName);
+				const auto patchFile = openOutputFile(outputRoot, patchPath);
+				patchFile->write(patch.data(), static_cast<std::streamsize>(patch.size()));
+			}
+
+			void compileFileJob(
+				virtual_dir::IReader &sourceRoot,
+				virtual_dir::IWriter &outputRoot,
+				const CompileContext &context,
+				FileJob &job,
+				const size_t jobIndex
+			)
+			{
+				const auto sourceFile = sourceRoot.readFile(job.source, false);
+				if (!sourceFile)
+				{
+					throw std::runtime_error(
+					    "Could not open source file " +
+					    job.source);
+				}
+
+				sourceFile->seekg(0, std::ios::end);
+				job.originalSize = static_cast<std::uintmax_t>(sourceFile->tellg());
+
+				sourceFile->seekg(0, std::ios::beg);
+				{
+					const auto hashCode = sha1(*sourceFile);
+					std::ostringstream formatter;
+					sha1PrintHex(formatter, hashCode);
+					job.sha1 = formatter.str();
+				}
+
+				sourceFile->clear();
+				sourceFile->seekg(0, std::ios::beg);
+
+				const bool useCache = !context.options.cacheDirectory.empty();
+				const bool isCompressed = context.options.isZLibCompressed;
+
+				auto outputName = job.destination;
+				if (isCompressed)
+				{
+					outputName += ".z";
+				}
+
+				const auto outputFile = openOutputFile(outputRoot, outputName);
+
+				if (isCompressed && useCache)
+				{
+					// Compressing is by far the most expensive part, so compressed files are shared by content
+					const auto objectPath = getCachedObjectPath(context, job.sha1);
+					job.isCached = std::filesystem::exists(objectPath);
+					if (!job.isCached)
+					{
+						writeCacheFile(objectPath, jobIndex, [&sourceFile](std::ostream &file)
+						{
+							zstr::ostream compressor(file);
+							copyStream(*sourceFile, compressor);
+						});
+					}
+
+					std::ifstream object(objectPath, std::ios::binary);
+					if (!object)
+					{
+						throw std::runtime_error("Could not open cache file " + objectPath.string());
+					}
+
+					copyStream(object, *outputFile);
+				}
+				else
+				{
+					// Generate the output stream with compression if requested
+					std::unique_ptr<std::ostream> outStream;
+					if (!isCompressed)
+					{
+						outStream = std::make_unique<std::ostream>(outputFile->rdbuf());
+					}
+					else
+					{
+						outStream = std::make_unique<zstr::ostream>(*outputFile);
+					}
+
+					copyStream(*sourceFile, *outStream);
+
+					// Flush the output stream
+					outStream->flush();
+				}
+
+				outputFile->flush();
+				job.compressedSize = isCompressed ? static_cast<std::uintmax_t>(outputFile->tellp()) : job.originalSize;
+
+				if (useCache && job.originalSize >= context.options.patchThreshold)
+				{
+					writePatch(sourceRoot, outputRoot, context, job);
+
+					// Keep the content, so the next build can create a patch from this version
+					const auto cachedSourcePath = getCachedSourcePath(context, job.sha1);
+					if (!std::filesystem::exists(cachedSourcePath))
+					{
+						sourceFile->clear();
+						sourceFile->seekg(0, std::ios::beg);
+						writeCacheFile(cachedSourcePath, jobIndex, [&sourceFile](std::ostream &file)
+						{
+							copyStream(*sourceFile, file);
+						});
+					}
+				}
+			}
+
+			/// Compiles all collected files on a number of worker threads.
+			void compileFileJobs(
+				virtual_dir::IReader &sourceRoot,
+				virtual_dir::IWriter &outputRoot,
+				CompileContext &context
+			)
+			{
+				std::vector<FileJob *> jobs;
+				jobs.reserve(context.files.size());
+				for (auto &[destination, job] : context.files)
+				{
+					jobs.push_back(&job);
+				}
+
+				size_t threadCount = context.options.concurrency;
+				if (threadCount == 0)
+				{
+					threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+				}
+				threadCount = std::min(threadCount, std::max<size_t>(jobs.size(), 1));
+
+				std::atomic<size_t> nextJob { 0 };
+				std::mutex errorMutex;
+				std::exception_ptr error;
+
+				const auto work = [&]()
+				{
+					for (;;)
+					{
+						const size_t index = nextJob++;
+						if (index >= jobs.size())
+						{
+							return;
+						}
+
+						try
+						{
+							compileFileJob(sourceRoot, outputRoot, context, *jobs[index], index);
+						}
+						catch (...)
+						{
+							std::scoped_lock lock{ errorMutex };
+							if (!error)
+							{
+								error = std::current_exception();
+							}
+
+							// Skip remaining jobs, the build failed anyway
+							nextJob = jobs.size();
+							return;
+						}
+					}
+				};
+
+				std::vector<std::thread> threads;
+				for (size_t i = 1; i < threadCount; ++i)
+				{
+					threads.emplace_back(work);
+				}
+
+				work();
+
+				for (auto &thread : threads)
+				{
+					thread.join();
+				}
+
+				if (error)
+				{
+					std::rethrow_exception(error);
+				}
+			}
+
+			std::filesystem::path getCacheManifestPath(const CompileContext &context)
+			{
+				return context.options.cacheDirectory / "manifest.txt";
+			}
+
+			/// Loads the digests of the files of the previous build.
+			void loadCacheManifest(CompileContext &context)
+			{
+				std::ifstream manifest(getCacheManifestPath(context));
+
+				std::string digest, destination;
+				while (manifest >> digest && std::getline(manifest >> std::ws, destination))
+				{
+					context.previousDigests[destination] = digest;
+				}
+			}
+
+			/// Saves the digests of the files of this build and removes cached files which are no longer used.
+			void saveCacheManifest(const CompileContext &context)
+			{
+				std::set<std::string> usedObjects, usedSources;
+
+				{
+					std::ofstream manifest(getCacheManifestPath(context), std::ios::trunc);
+					if (!manifest)
+					{
+						throw std::runtime_error("Could not write cache manifest " + getCacheManifestPath(context).string());
+					}
+
+					for (const auto &[destination, job] : context.files)
+					{
+						manifest << job.sha1 << ' ' << destination << '\n';
+
+						usedObjects.insert(getCachedObjectPath(context, job.sha1).filename().string());
+						if (job.originalSize >= context.options.patchThreshold)
+						{
+							usedSources.insert(job.sha1);
+						}
+					}
+				}
+
+				const auto removeUnused = [](const std::filesystem::path &directory, const std::set<std::string> &used)
+				{
+					std::error_code error;
+					for (std::filesystem::directory_iterator i(directory, error), end; !error && i != end; i.increment(error))
+					{
+						if (!used.count(i->path().filename().string()))
+						{
+							std::error_code removeError;
+							std::filesystem::remove(i->path(), removeError);
+						}
+					}
+				};
+
+				removeUnused(context.options.cacheDirectory / "objects", usedObjects);
+				removeUnused(context.options.cacheDirectory / "sources", usedSources);
+			}
+
 
 			void compileFile(
 				virtual_dir::IReader &sourceRoot,
@@ -33,7 +506,7 @@ namespace mmo
 				const virtual_dir::Path &fromLocation,
 				TableWriter &outputDescription,
 				const virtual_dir::Path &destinationDir,
-				bool isZLibCompressed,
+				CompileContext &context,
 				const std::string &fileName
 			)
 			{
@@ -62,7 +535,7 @@ namespace mmo
 						    virtual_dir::joinPaths(fromLocation, entry),
 						    entryOutput,
 						    virtual_dir::joinPaths(destinationDir, entry),
-						    isZLibCompressed,
+						    context,
 						    entry
 						);
 
@@ -73,95 +546,40 @@ namespace mmo
 				}
 				else if (type == virtual_dir::file_type::File)
 				{
-					const auto sourceFile = sourceRoot.readFile(
-					                            fromLocation,
-					                            false
-					                        );
-
-					if (!sourceFile)
+					// Files are compiled on worker threads once the whole source list has been walked, the second walk
+					// only writes the results
+					if (context.isCollecting)
 					{
-						throw std::runtime_error(
-						    "Could not open source file " +
-						    fromLocation);
-					}
-
-					auto compressedNameFull = destinationDir;
-					if (isZLibCompressed)
-					{
-						const auto compressedName = fileName + ".z";
-						outputDescription.addKey("compressedName", compressedName);
-
-						compressedNameFull += ".z";
-					}
-
-					{
-						sourceFile->seekg(0, std::ios::end);
-						{
-							const std::streamoff originalSize = sourceFile->tellg();
-							outputDescription.addKey("originalSize", originalSize);
-						}
-
-						sourceFile->seekg(0, std::ios::beg);
-						{
-							const auto hashCode = sha1(*sourceFile);
-							std::ostringstream formatter;
-							sha1PrintHex(formatter, hashCode);
-							outputDescription.addKey("sha1", formatter.str());
-						}
+						FileJob job;
+						job.source = fromLocation;
+						job.destination = destinationDir;
+						job.fileName = fileName;
+						context.files.emplace(destinationDir, std::move(job));
+						return;
 					}
 
-					//workaround:
-					const auto outputFile = outputRoot.writeFile(
-					                            compressedNameFull,
-					                            false,
-					                            true
-					                        );
+					const FileJob &job = context.files.at(destinationDir);
 
-					if (!outputFile)
+					if (context.options.isZLibCompressed)
 					{
-						throw std::runtime_error(
-						    "Could not open output file " +
-						    compressedNameFull);
+						outputDescription.addKey("compressedName", fileName + ".z");
 					}
 
-					sourceFile->clear();
-					sourceFile->seekg(0, std::ios::beg);
-
+					outputDescription.addKey("originalSize", job.originalSize);
+					outputDescription.addKey("sha1", job.sha1);
 
-					// Generate the output stream with compression if requested
-					std::unique_ptr<std::ostream> outStream;
-					if (!isZLibCompressed)
+					if (context.options.isZLibCompressed)
 					{
-						outStream = std::make_unique<std::ostream>(outputFile->rdbuf());
-					}
-					else
-					{
-						outStream = std::make_unique<zstr::ostream>(*outputFile);
+						outputDescription.addKey("compression", "zlib");
+						outputDescription.addKey("compressedSize", job.compressedSize);
 					}
 
-					// Read in source file in 4k byte chunks and process it
-					char buf[4096];
-					std::streamsize read;
-					do
-					{
-						sourceFile->read(buf, 4096);
-						read = sourceFile->gcount();
-						if (read > 0)
-						{
-							outStream->write(buf, read);
-						}
-					} while (*sourceFile && read > 0);
-
-					// Flush the output stream
-					outStream->flush();
-					outStream.reset();
-
-					if (isZLibCompressed)
+					if (!job.patchName.empty())
 					{
-						outputDescription.addKey("compression", "zlib");
-
-						const std::uintmax_t compressedSize = outputFile->tellp();
-						outputDescription.addKey("compressedSize", compressedSize);
+						outputDescription.addKey("patchFrom", job.patchFrom);
+						outputDescription.addKey("patchName", job.patchName);
+						outputDescription.addKey("patchSize", job.patchSize);
+						outputDescription.addKey("patchOriginalSize", job.patchOriginalSize);
 					}
 				}
 			}
@@ -173,7 +591,7 @@ namespace mmo
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
 			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed
+			    CompileContext &context
 			);
 
 
@@ -184,7 +602,7 @@ namespace mmo
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
 			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed
+			    CompileContext &context
 			)
 			{
 				// Obtain the source type so we can apply a different compiler eventually
@@ -203,7 +621,7 @@ namespace mmo
 					    fromLocation,
 					    outputDescription,
 					    destinationDir,
-					    isZLibCompressed
+					    context
 					);
 				}
 				else
@@ -260,7 +678,7 @@ namespace mmo
 									subFromLocation,
 									entryDescriptionOutput,
 									virtual_dir::joinPaths(subDestinationDir, sub),
-									isZLibCompressed
+									context
 								);
 
 								subEntriesOutput.Finish();
@@ -281,7 +699,7 @@ namespace mmo
 									subFromLocation,
 									entryDescriptionOutput,
 									subDestinationDir,
-									isZLibCompressed
+									context
 								);
 
 								entryDescriptionOutput.Finish();
@@ -311,7 +729,7 @@ namespace mmo
 								subFromLocation,
 								entryOutput,
 								virtual_dir::joinPaths(subDestinationDir, sub),
-								isZLibCompressed,
+								context,
 								to
 							);
 
@@ -326,7 +744,7 @@ namespace mmo
 								subFromLocation,
 								outputDescription,
 								subDestinationDir,
-								isZLibCompressed,
+								context,
 								to
 							);
 						}
@@ -342,7 +760,7 @@ namespace mmo
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
 			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed
+			    CompileContext &context
 			)
 			{
 				{
@@ -372,7 +790,7 @@ namespace mmo
 				    fromLocation,
 				    valueOutput,
 				    destinationDir,
-				    isZLibCompressed
+				    context
 				);
 
 				valueOutput.Finish();
@@ -380,10 +798,10 @@ namespace mmo
 		}
 
 
-		void compileDirectory(
+		CompileStatistics compileDirectory(
 			virtual_dir::IReader &sourceDir,
 			virtual_dir::IWriter &destinationDir,
-		    bool isZLibCompressed
+			const CompileOptions &options
 		)
 		{
 			// Try to find source.txt in source directoy and open it for reading
@@ -401,34 +819,26 @@ namespace mmo
 
 			// Check the format version
 			const auto version = sourceTable.getInteger<unsigned>("version", 0);
-			if (version == 0)
+			if (version != 0)
 			{
-				// Try to get the root object
-				const auto *const root = sourceTable.getTable("root");
-				if (!root)
-				{
-					throw std::runtime_error("Root directory entry is missing");
-				}
-
-				// Create the list.txt file in the target directory for writing. This file
-				// will contain a summary of all file entries
-				const virtual_dir::Path fullListFileName = "list.txt";
-				const auto listFile = destinationDir.writeFile(fullListFileName, false, true);
-				if (!listFile)
-				{
-					throw std::runtime_error(
-					    "Could not open output list file " + fullListFileName);
-				}
+				throw std::runtime_error("Unsupported source list version");
+			}
 
-				// Write the target root table
-				sff::write::Writer<char> listWriter(*listFile);
-				TableWriter listTable(listWriter, sff::write::MultiLine);
+			// Try to get the root object
+			const auto *const root = sourceTable.getTable("root");
+			if (!root)
+			{
+				throw std::runtime_error("Root directory entry is missing");
+			}
 
-				// Add the current file format verison
-				listTable.addKey("version", 1);
+			CompileContext context(options);
 
-				// Compile the first entry from the source list
-				TableWriter rootEntry(listTable, "root", sff::write::Comma);
+			// Find all files first, so they can be compiled in parallel
+			{
+				std::ostringstream discarded;
+				sff::write::Writer<char> discardedWriter(discarded);
+				TableWriter discardedTable(discardedWriter, sff::write::MultiLine);
+				TableWriter rootEntry(discardedTable, "root", sff::write::Comma);
 				compileEntry(
 				    sourceDir,
 				    destinationDir,
@@ -436,16 +846,73 @@ namespace mmo
 				    "",
 				    rootEntry,
 				    "",
-				    isZLibCompressed
+				    context
 				);
-
-				// And finishe the root entry in list.txt
 				rootEntry.Finish();
 			}
-			else
+
+			if (!options.cacheDirectory.empty())
 			{
-				throw std::runtime_error("Unsupported source list version");
+				std::filesystem::create_directories(options.cacheDirectory / "objects");
+				std::filesystem::create_directories(options.cacheDirectory / "sources");
+				loadCacheManifest(context);
+			}
+
+			compileFileJobs(sourceDir, destinationDir, context);
+
+			// Create the list.txt file in the target directory for writing. This file
+			// will contain a summary of all file entries
+			const virtual_dir::Path fullListFileName = "list.txt";
+			const auto listFile = destinationDir.writeFile(fullListFileName, false, true);
+			if (!listFile)
+			{
+				throw std::runtime_error(
+				    "Could not open output list file " + fullListFileName);
+			}
+
+			// Write the target root table
+			sff::write::Writer<char> listWriter(*listFile);
+			TableWriter listTable(listWriter, sff::write::MultiLine);
+
+			// Add the current file format verison
+			listTable.addKey("version", 1);
+
+			// Compile the first entry from the source list
+			context.isCollecting = false;
+			TableWriter rootEntry(listTable, "root", sff::write::Comma);
+			compileEntry(
+			    sourceDir,
+			    destinationDir,
+			    *root,
+			    "",
+			    rootEntry,
+			    "",
+			    context
+			);
+
+			// And finishe the root entry in list.txt
+			rootEntry.Finish();
+
+			if (!options.cacheDirectory.empty())
+			{
+				saveCacheManifest(context);
 			}
+
+			CompileStatistics statistics;
+			for (const auto &[destination, job] : context.files)
+			{
+				++statistics.files;
+				if (job.isCached)
+				{
+					++statistics.cachedFiles;
+				}
+				if (!job.patchName.empty())
+				{
+					++statistics.patches;
+				}
+			}
+
+			return statistics;
 		}
 	}
 }
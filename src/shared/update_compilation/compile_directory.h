@@ -4,6 +4,8 @@
 
 #include "base/filesystem.h"
 
+#include <cstdint>
+
 namespace mmo
 {
 	namespace virtual_dir
@@ -14,14 +16,41 @@ namespace mmo
 
 	namespace updating
 	{
+		/// Options which control how a directory is compiled.
+		struct CompileOptions
+		{
+			/// True to apply zlib compression on the files.
+			bool isZLibCompressed = false;
+			/// Number of threads hashing and compressing files. 0 uses one thread per hardware thread.
+			size_t concurrency = 0;
+			/// Directory which keeps compressed files by content hash between builds, so unchanged files are not
+			/// compressed again, and which keeps the content of large files to create delta patches against them in
+			/// the next build. Leave empty to disable caching and delta patches.
+			std::filesystem::path cacheDirectory;
+			/// Files of at least this size get a delta patch from their version of the previous build.
+			std::uintmax_t patchThreshold = 16 * 1024 * 1024;
+		};
+
+		/// Summary of a compiled directory.
+		struct CompileStatistics
+		{
+			/// Number of compiled files.
+			size_t files = 0;
+			/// Number of files whose compressed output has been taken from the cache.
+			size_t cachedFiles = 0;
+			/// Number of delta patches written.
+			size_t patches = 0;
+		};
+
 		/// Compiles a whole directory with all it's files and folders.
 		/// @sourceDir A reader object for the source directory.
-		/// @destinationDir A writer object for the destination directory.
-		/// @param isZLibCompressed True to apply zlib compression on the files.
-		void compileDirectory(
+		/// @destinationDir A writer object for the destination directory. Has to support being written to from
+		///	multiple threads at once.
+		/// @param options Compression, caching and threading options.
+		CompileStatistics compileDirectory(
 			virtual_dir::IReader &sourceDir,
 			virtual_dir::IWriter &destinationDir,
-		    bool isZLibCompressed
+			const CompileOptions &options
 		);
 	}
 }
@@ -0,0 +1,293 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "download_file.h"
+#include "update_parameters.h"
+#include "update_source.h"
+#include "updater_progress_handler.h"
+#include "base/filesystem.h"
+
+#include "zstr/zstr.hpp"
+
+#include <array>
+#include <fstream>
+#include <limits>
+
+
+namespace mmo::updating
+{
+	namespace
+	{
+		/// Size of the digest which starts every partial file, so a partial file of another version of the file is
+		/// never resumed.
+		constexpr std::uintmax_t PartHeaderSize = std::tuple_size_v<SHA1Hash>;
+
+		/// Input stream buffer which first reads the bytes stored in the partial file by previous attempts and then
+		/// continues with the remote content, appending everything received to the partial file.
+		class ResumingStreamBuffer final : public std::streambuf
+		{
+		public:
+			ResumingStreamBuffer(
+			    std::istream &local,
+			    std::uintmax_t localSize,
+			    std::istream *remote,
+			    std::uintmax_t remoteSize,
+			    std::ostream &partFile,
+			    std::uintmax_t &out_received)
+				: m_local(local)
+				, m_localRemaining(localSize)
+				, m_remote(remote)
+				, m_remoteRemaining(remoteSize)
+				, m_partFile(partFile)
+				, m_received(out_received)
+			{
+			}
+
+			[[nodiscard]] bool isComplete() const
+			{
+				return m_localRemaining == 0 && m_remoteRemaining == 0;
+			}
+
+		protected:
+			int_type underflow() override
+			{
+				if (gptr() < egptr())
+				{
+					return traits_type::to_int_type(*gptr());
+				}
+
+				std::streamsize read = 0;
+				if (m_localRemaining > 0)
+				{
+					m_local.read(m_buffer.data(), static_cast<std::streamsize>(std::min<std::uintmax_t>(m_buffer.size(), m_localRemaining)));
+					read = m_local.gcount();
+					m_localRemaining -= static_cast<std::uintmax_t>(std::max<std::streamsize>(read, 0));
+				}
+				else if (m_remote && m_remoteRemaining > 0)
+				{
+					m_remote->read(m_buffer.data(), static_cast<std::streamsize>(std::min<std::uintmax_t>(m_buffer.size(), m_remoteRemaining)));
+					read = m_remote->gcount();
+					if (read > 0)
+					{
+						m_partFile.write(m_buffer.data(), read);
+						m_remoteRemaining -= static_cast<std::uintmax_t>(read);
+						m_received += static_cast<std::uintmax_t>(read);
+					}
+				}
+
+				if (read <= 0)
+				{
+					return traits_type::eof();
+				}
+
+				setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + read);
+				return traits_type::to_int_type(*gptr());
+			}
+
+		private:
+			std::istream &m_local;
+			std::uintmax_t m_localRemaining;
+			std::istream *m_remote;
+			std::uintmax_t m_remoteRemaining;
+			std::ostream &m_partFile;
+			std::uintmax_t &m_received;
+			std::array<char, 1024 * 16> m_buffer;
+		};
+
+		/// Gets the number of content bytes stored in a partial file for the given digest.
+		std::uintmax_t getPartialSize(const std::string &partPath, const SHA1Hash &sha1)
+		{
+			std::ifstream partFile(partPath, std::ios::binary);
+			if (!partFile)
+			{
+				return 0;
+			}
+
+			SHA1Hash storedDigest;
+			if (!partFile.read(reinterpret_cast<char *>(storedDigest.data()), static_cast<std::streamsize>(storedDigest.size())) ||
+				storedDigest != sha1)
+			{
+				return 0;
+			}
+
+			partFile.seekg(0, std::ios::end);
+			return static_cast<std::uintmax_t>(partFile.tellg()) - PartHeaderSize;
+		}
+
+		/// Downloads the rest of a file.
+		/// @param out_received Receives the number of bytes received from the update source.
+		/// @returns false if the file has been received completely but does not match the expected digest.
+		bool downloadAttempt(
+		    const UpdateParameters &parameters,
+		    const std::string &source,
+		    const std::string &destination,
+		    const std::string &partPath,
+		    bool doZLibUncompress,
+		    std::uintmax_t compressedSize,
+		    std::uintmax_t originalSize,
+		    const SHA1Hash &sha1,
+		    std::uintmax_t &out_received
+		)
+		{
+			std::uintmax_t partialSize = getPartialSize(partPath, sha1);
+			if (partialSize > compressedSize)
+			{
+				partialSize = 0;
+			}
+
+			if (partialSize == 0)
+			{
+				std::ofstream partFile(partPath, std::ios::binary | std::ios::trunc);
+				if (!partFile.write(reinterpret_cast<const char *>(sha1.data()), static_cast<std::streamsize>(sha1.size())))
+				{
+					throw std::runtime_error("Could not open output file " + partPath);
+				}
+			}
+
+			std::ifstream local(partPath, std::ios::binary);
+			local.seekg(static_cast<std::streamoff>(PartHeaderSize), std::ios::beg);
+
+			std::ofstream partFile(partPath, std::ios::binary | std::ios::app);
+			if (!local || !partFile)
+			{
+				throw std::runtime_error("Could not open output file " + partPath);
+			}
+
+			const std::uintmax_t remoteSize = compressedSize - partialSize;
+
+			UpdateSourceFile remote;
+			if (remoteSize > 0)
+			{
+				remote = parameters.source->readFileFrom(source, partialSize);
+				checkExpectedFileSize(source, remoteSize, remote);
+			}
+
+			ResumingStreamBuffer buffer(local, partialSize, remote.content.get(), remoteSize, partFile, out_received);
+			std::istream raw(&buffer);
+
+			std::unique_ptr<std::istream> content =
+				doZLibUncompress ?
+					std::make_unique<zstr::istream>(raw) :
+					std::make_unique<std::istream>(&buffer);
+
+			std::ofstream sinkFile(destination, std::ios::binary | std::ios::trunc);
+			if (!sinkFile)
+			{
+				throw std::runtime_error("Could not open output file " + destination);
+			}
+
+			HashGeneratorSha1 hash;
+			std::uintmax_t written = 0;
+			parameters.progressHandler.updateFile(source, originalSize, written);
+
+			std::array<char, 1024 * 16> chunk;
+			for (;;)
+			{
+				content->read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+
+				const auto readSize = content->gcount();
+				if (readSize > 0)
+				{
+					if ((written + readSize) > originalSize)
+					{
+						throw std::runtime_error(source + ": Received more than expected");
+					}
+
+					sinkFile.write(chunk.data(), readSize);
+					hash.update(chunk.data(), static_cast<size_t>(readSize));
+					written += readSize;
+
+					parameters.progressHandler.updateFile(source, originalSize, written);
+				}
+
+				if (!(*content))
+				{
+					break;
+				}
+			}
+
+			// The decompressor may stop before the end of the compressed content, which still belongs into the partial file
+			raw.ignore(std::numeric_limits<std::streamsize>::max());
+
+			partFile.flush();
+			sinkFile.flush();
+			if (!partFile || !sinkFile)
+			{
+				throw std::runtime_error(source + ": Could not write downloaded content");
+			}
+
+			if (!buffer.isComplete() || written != originalSize)
+			{
+				throw std::runtime_error(source + ": Received incomplete file");
+			}
+
+			partFile.close();
+			local.close();
+
+			std::error_code error;
+			std::filesystem::remove(partPath, error);
+
+			if (hash.finalize() != sha1)
+			{
+				return false;
+			}
+
+			parameters.progressHandler.updateFile(source, originalSize, originalSize);
+			return true;
+		}
+	}
+
+
+	void downloadFile(
+	    const UpdateParameters &parameters,
+	    const std::string &source,
+	    const std::string &destination,
+	    const std::string &compression,
+	    std::uintmax_t compressedSize,
+	    std::uintmax_t originalSize,
+	    const SHA1Hash &sha1
+	)
+	{
+		bool doZLibUncompress = false;
+
+		if (compression == "zlib")
+		{
+			doZLibUncompress = true;
+		}
+		else if (!compression.empty())
+		{
+			throw std::runtime_error(
+			    "Unsupported compression type " + compression);
+		}
+
+		const std::string partPath = destination + ".part";
+
+		for (unsigned attempt = 1; ; ++attempt)
+		{
+			std::uintmax_t received = 0;
+			try
+			{
+				if (downloadAttempt(parameters, source, destination, partPath, doZLibUncompress, compressedSize, originalSize, sha1, received))
+				{
+					return;
+				}
+			}
+			catch (const std::exception &)
+			{
+				// Retry right away as long as the connection makes progress, otherwise the partial file is resumed
+				// by the next update
+				if (received == 0 || attempt >= MaxDownloadAttempts)
+				{
+					throw;
+				}
+
+				continue;
+			}
+
+			// The partial file has been discarded, so the next attempt starts from scratch
+			if (attempt >= MaxDownloadAttempts)
+			{
+				throw std::runtime_error(source + ": Downloaded file does not match the expected checksum");
+			}
+		}
+	}
+}
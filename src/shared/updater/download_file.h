@@ -0,0 +1,38 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/sha1.h"
+
+#include <cstdint>
+#include <string>
+
+
+namespace mmo::updating
+{
+	struct UpdateParameters;
+
+
+	/// Number of times a download is attempted in a row, as long as each attempt receives new bytes.
+	static constexpr unsigned MaxDownloadAttempts = 3;
+
+
+	/// Downloads a file from the update source. The received bytes are kept in a partial file next to the
+	/// destination until the download is complete, so an interrupted download continues where it stopped, even
+	/// after a restart. The content is hashed while it is written and verified against the expected digest.
+	/// @param source Path of the file in the update source.
+	/// @param destination Local path of the file.
+	/// @param compression Compression of the file in the update source, either empty or "zlib".
+	/// @param compressedSize Size of the file in the update source.
+	/// @param originalSize Size of the uncompressed file.
+	/// @param sha1 Digest of the uncompressed file.
+	void downloadFile(
+	    const UpdateParameters &parameters,
+	    const std::string &source,
+	    const std::string &destination,
+	    const std::string &compression,
+	    std::uintmax_t compressedSize,
+	    std::uintmax_t originalSize,
+	    const SHA1Hash &sha1
+	);
+}
@@ -5,9 +5,16 @@
 #include "prepare_progress_handler.h"
 #include "update_source.h"
 #include "copy_with_progress.h"
+#include "download_file.h"
+#include "hashing_stream_buffer.h"
 #include "parse_directory_entries.h"
 #include "hpak2_entry_handler.h"
+#include "base/binary_delta.h"
 #include "base/filesystem.h"
+#include "virtual_dir/path.h"
+
+#include <fstream>
+#include <sstream>
 
 
 namespace mmo::updating
@@ -55,9 +62,81 @@ namespace mmo::updating
 		    "Unknown file system entry type: " + type);
 	}
 
+	namespace
+	{
+		/// Downloads a delta patch and applies it to the local copy of a file.
+		/// @returns false if the patch could not be applied, in which case the local copy is left untouched.
+		bool patchFile(
+		    const UpdateParameters &parameters,
+		    const std::string &patchSource,
+		    const std::string &destination,
+		    const std::string &compression,
+		    std::uintmax_t patchSize,
+		    std::uintmax_t patchOriginalSize,
+		    const SHA1Hash &sha1
+		)
+		{
+			const std::string patchPath = destination + ".patch";
+			const std::string patchedPath = destination + ".patched";
+
+			const auto removeTemporaryFiles = [&patchPath, &patchedPath]()
+			{
+				std::error_code error;
+				std::filesystem::remove(patchPath, error);
+				std::filesystem::remove(patchedPath, error);
+			};
+
+			{
+				const auto sourceFile = parameters.source->readFile(patchSource);
+				checkExpectedFileSize(patchSource, patchSize, sourceFile);
+
+				std::ofstream sinkFile(patchPath, std::ios::binary | std::ios::trunc);
+				if (!sinkFile)
+				{
+					throw std::runtime_error("Could not open output file " + patchPath);
+				}
+
+				copyWithProgress(
+				    parameters,
+				    *sourceFile.content,
+				    sinkFile,
+				    patchSource,
+				    patchOriginalSize,
+				    patchOriginalSize,
+				    compression == "zlib"
+				);
+			}
+
+			{
+				std::ifstream previousFile(destination, std::ios::binary);
+				std::ifstream delta(patchPath, std::ios::binary);
+				std::ofstream patchedFile(patchedPath, std::ios::binary | std::ios::trunc);
+
+				// Hash while writing, so the patched file doesn't have to be read again for verification
+				HashingStreamBuffer hashingBuffer(*patchedFile.rdbuf());
+				std::ostream patchedStream(&hashingBuffer);
+
+				// Never replace the local copy with anything else than the expected file
+				if (!previousFile || !delta || !patchedFile ||
+					!ApplyBinaryDelta(previousFile, delta, patchedStream) ||
+					!patchedStream.flush() ||
+					hashingBuffer.finalize() != sha1)
+				{
+					patchedFile.close();
+					removeTemporaryFiles();
+					return false;
+				}
+			}
+
+			std::filesystem::rename(patchedPath, destination);
+			removeTemporaryFiles();
+			return true;
+		}
+	}
+
 	PreparedUpdate FileSystemEntryHandler::handleFile(
 	    const PrepareParameters &parameters,
-	    const sff::read::tree::Table<std::string::const_iterator> &/*entryDescription*/,
+	    const sff::read::tree::Table<std::string::const_iterator> &entryDescription,
 	    const std::string &source,
 	    const std::string &destination,
 	    std::uintmax_t originalSize,
@@ -66,78 +145,84 @@ namespace mmo::updating
 	    std::uintmax_t compressedSize
 	)
 	{
-		for (;;)
+		// Large files may come with a delta patch from their previous version
+		std::string patchFrom, patchName;
+		std::uintmax_t patchSize = 0, patchOriginalSize = 0;
+		const bool hasPatch =
+			entryDescription.tryGetString("patchFrom", patchFrom) &&
+			entryDescription.tryGetString("patchName", patchName) &&
+			entryDescription.tryGetInteger("patchSize", patchSize) &&
+			entryDescription.tryGetInteger("patchOriginalSize", patchOriginalSize);
+
+		bool canPatch = false;
+
 		{
-			{
-				parameters.progressHandler.beginCheckLocalCopy(source);
+			parameters.progressHandler.beginCheckLocalCopy(source);
 
-				//TODO: prevent race condition
-				std::ifstream previousFile(
-				    destination,
-				    std::ios::binary | std::ios::ate);
+			//TODO: prevent race condition
+			std::ifstream previousFile(
+			    destination,
+			    std::ios::binary | std::ios::ate);
 
-				if (previousFile)
+			if (previousFile)
+			{
+				const std::uintmax_t previousSize = previousFile.tellg();
+				if (previousSize == originalSize || hasPatch)
 				{
-					const std::uintmax_t previousSize = previousFile.tellg();
-					if (previousSize == originalSize)
+					previousFile.seekg(0, std::ios::beg);
+					const auto previousDigest = mmo::sha1(previousFile);
+					if (previousSize == originalSize && previousDigest == sha1)
 					{
-						previousFile.seekg(0, std::ios::beg);
-						const auto previousDigest = mmo::sha1(previousFile);
-						if (previousDigest == sha1)
-						{
-							break;
-						}
+						return PreparedUpdate();
+					}
+
+					if (hasPatch)
+					{
+						std::ostringstream formatter;
+						sha1PrintHex(formatter, previousDigest);
+						canPatch = (formatter.str() == patchFrom);
 					}
 				}
 			}
+		}
+
+		PreparedUpdate update;
+		update.estimates.downloadSize = canPatch ? patchSize : compressedSize;
+		update.estimates.updateSize = originalSize;
+
+		if (canPatch)
+		{
+			const auto patchSource = virtual_dir::joinPaths(virtual_dir::splitLeaf(source).first, patchName);
 
-			PreparedUpdate update;
-			update.estimates.downloadSize = compressedSize;
-			update.estimates.updateSize = originalSize;
 			update.steps.push_back(PreparedUpdateStep(
 			                           destination,
-			                           [source, destination, compression, compressedSize, originalSize]
+			                           [source, patchSource, destination, compression, compressedSize, originalSize, patchSize, patchOriginalSize, sha1]
 			                           (const UpdateParameters & parameters) -> bool
 			{
-				const auto sourceFile = parameters.source->readFile(source);
-				checkExpectedFileSize(source, compressedSize, sourceFile);
-
-				bool doZLibUncompress = false;
-
-				if (compression == "zlib")
-				{
-					doZLibUncompress = true;
-				}
-				else if (!compression.empty())
+				if (!patchFile(parameters, patchSource, destination, compression, patchSize, patchOriginalSize, sha1))
 				{
-					throw std::runtime_error(
-					    "Unsupported compression type " + compression);
+					// The local copy changed since the update has been prepared, so the whole file is needed
+					downloadFile(parameters, source, destination, compression, compressedSize, originalSize, sha1);
 				}
 
-				std::ofstream sinkFile(destination, std::ios::binary);
-				if (!sinkFile)
-				{
-					throw std::runtime_error("Could not open output file " + destination);
-				}
-
-				copyWithProgress(
-				    parameters,
-				    *sourceFile.content,
-				    sinkFile,
-				    source,
-				    originalSize,
-					originalSize,
-				    doZLibUncompress
-				);
-
-				//TODO: Copy step-wise
 				return false;
 			}));
 
 			return update;
 		}
 
-		return PreparedUpdate();
+		update.steps.push_back(PreparedUpdateStep(
+		                           destination,
+		                           [source, destination, compression, compressedSize, originalSize, sha1]
+		                           (const UpdateParameters & parameters) -> bool
+		{
+			downloadFile(parameters, source, destination, compression, compressedSize, originalSize, sha1);
+
+			//TODO: Copy step-wise
+			return false;
+		}));
+
+		return update;
 	}
 
 	PreparedUpdate FileSystemEntryHandler::finish(const PrepareParameters &/*parameters*/)
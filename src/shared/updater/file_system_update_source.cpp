@@ -31,4 +31,19 @@ namespace mmo::updating
 
 		return UpdateSourceFile(internalData, std::move(file), size);
 	}
+
+	UpdateSourceFile FileSystemUpdateSource::readFileFrom(
+	    const std::string &path,
+	    std::uintmax_t offset
+	)
+	{
+		auto file = readFile(path);
+		file.content->seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+		if (!*file.content)
+		{
+			throw std::runtime_error("Could not seek in file " + path);
+		}
+
+		return file;
+	}
 }
@@ -16,6 +16,11 @@ namespace mmo::updating
 		    const std::string &path
 		) override;
 
+		virtual UpdateSourceFile readFileFrom(
+		    const std::string &path,
+		    std::uintmax_t offset
+		) override;
+
 	private:
 
 		std::filesystem::path m_root;
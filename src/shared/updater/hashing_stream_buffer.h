@@ -0,0 +1,56 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/sha1.h"
+
+#include <streambuf>
+
+
+namespace mmo::updating
+{
+	/// Output stream buffer which forwards everything to another stream buffer and hashes it on the way, so written
+	/// content can be verified without reading it again.
+	class HashingStreamBuffer final : public std::streambuf
+	{
+	public:
+		explicit HashingStreamBuffer(std::streambuf &target)
+			: m_target(target)
+		{
+		}
+
+		/// Gets the digest of everything written so far. May only be called once.
+		SHA1Hash finalize()
+		{
+			return m_hash.finalize();
+		}
+
+	protected:
+		int_type overflow(int_type c) override
+		{
+			if (traits_type::eq_int_type(c, traits_type::eof()))
+			{
+				return traits_type::not_eof(c);
+			}
+
+			const char character = traits_type::to_char_type(c);
+			m_hash.update(&character, 1);
+			return m_target.sputc(character);
+		}
+
+		std::streamsize xsputn(const char *s, std::streamsize count) override
+		{
+			m_hash.update(s, static_cast<size_t>(count));
+			return m_target.sputn(s, count);
+		}
+
+		int sync() override
+		{
+			return m_target.pubsync();
+		}
+
+	private:
+		std::streambuf &m_target;
+		HashGeneratorSha1 m_hash;
+	};
+}
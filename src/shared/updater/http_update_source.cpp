@@ -21,10 +21,19 @@ namespace mmo::updating
 	UpdateSourceFile HTTPUpdateSource::readFile(
 	    const std::string &path
 	)
+	{
+		return readFileFrom(path, 0);
+	}
+
+	UpdateSourceFile HTTPUpdateSource::readFileFrom(
+	    const std::string &path,
+	    std::uintmax_t offset
+	)
 	{
 		net::http_client::Request request;
 		request.host = m_host;
 		request.document = m_path;
+		request.rangeBegin = offset;
 		virtual_dir::appendPath(request.document, path);
 
 		auto response = net::http_client::sendRequest(
@@ -32,17 +41,26 @@ namespace mmo::updating
 		                    m_port,
 		                    request);
 
-		if (response.status != net::http_client::Response::Ok)
+		const bool isPartial = (offset > 0 && response.status == net::http_client::Response::PartialContent);
+		if (response.status != net::http_client::Response::Ok && !isPartial)
 		{
 			throw std::runtime_error(
 			    path + ": HTTP response " +
 			    std::to_string(response.status));
 		}
 
-		return UpdateSourceFile(
+		UpdateSourceFile file(
 		           response.getInternalData(),
 		           std::move(response.body),
 		           response.bodySize
 		       );
+
+		// The server ignored the range and sends the whole file
+		if (!isPartial)
+		{
+			skipContent(file, offset);
+		}
+
+		return file;
 	}
 }
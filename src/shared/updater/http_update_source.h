@@ -20,6 +20,11 @@ namespace mmo::updating
 		    const std::string &path
 		) override;
 
+		virtual UpdateSourceFile readFileFrom(
+		    const std::string &path,
+		    std::uintmax_t offset
+		) override;
+
 	private:
 
 		const std::string m_host;
@@ -0,0 +1,103 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "perform_update.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace mmo::updating
+{
+	bool performUpdate(
+	    const PreparedUpdate &update,
+	    const UpdateParameters &parameters,
+	    size_t concurrency,
+	    const std::function<bool (const PreparedUpdateStep &)> &skipStep,
+	    const std::function<bool ()> &shouldStop
+	)
+	{
+		const auto isStopRequested = [&shouldStop]()
+		{
+			return shouldStop && shouldStop();
+		};
+
+		std::atomic<size_t> nextStep { 0 };
+		std::atomic<bool> isCancelled { false };
+		std::mutex errorMutex;
+		std::exception_ptr error;
+
+		const auto work = [&]()
+		{
+			for (;;)
+			{
+				const size_t index = nextStep++;
+				if (index >= update.steps.size())
+				{
+					return;
+				}
+
+				const PreparedUpdateStep &step = update.steps[index];
+				if (skipStep && skipStep(step))
+				{
+					continue;
+				}
+
+				try
+				{
+					while (step.step(parameters))
+					{
+						if (isStopRequested())
+						{
+							break;
+						}
+					}
+				}
+				catch (...)
+				{
+					std::scoped_lock lock{ errorMutex };
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+
+					// Don't start any more steps, the update failed anyway
+					nextStep = update.steps.size();
+					return;
+				}
+
+				if (isStopRequested())
+				{
+					isCancelled = true;
+					nextStep = update.steps.size();
+					return;
+				}
+			}
+		};
+
+		concurrency = std::clamp<size_t>(concurrency, 1, std::max<size_t>(update.steps.size(), 1));
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < concurrency; ++i)
+		{
+			threads.emplace_back(work);
+		}
+
+		work();
+
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+
+		return !isCancelled;
+	}
+}
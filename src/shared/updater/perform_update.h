@@ -0,0 +1,30 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "prepared_update.h"
+
+#include <functional>
+
+
+namespace mmo::updating
+{
+	struct UpdateParameters;
+
+
+	/// Performs all steps of a prepared update on a number of worker threads, so that many files are downloaded over
+	/// parallel connections. The progress handler of the parameters is called from all workers.
+	/// @param concurrency Number of steps performed at the same time.
+	/// @param skipStep Optional filter for steps which should not be performed.
+	/// @param shouldStop Optional callback which cancels the update when returning true. Checked between steps and
+	///	between iterations of a step.
+	/// @returns false if the update has been cancelled.
+	/// Rethrows the first exception thrown by a step after all workers have stopped.
+	bool performUpdate(
+	    const PreparedUpdate &update,
+	    const UpdateParameters &parameters,
+	    size_t concurrency,
+	    const std::function<bool (const PreparedUpdateStep &)> &skipStep = {},
+	    const std::function<bool ()> &shouldStop = {}
+	);
+}
@@ -13,5 +13,17 @@ namespace mmo::updating
 		virtual UpdateSourceFile readFile(
 		    const std::string &path
 		) = 0;
+
+		/// Reads a file starting at a byte offset, which is used to resume interrupted downloads. The size of the
+		/// returned file is the number of bytes from the offset on. Sources which can't seek skip the leading bytes.
+		virtual UpdateSourceFile readFileFrom(
+		    const std::string &path,
+		    std::uintmax_t offset
+		)
+		{
+			auto file = readFile(path);
+			skipContent(file, offset);
+			return file;
+		}
 	};
 }
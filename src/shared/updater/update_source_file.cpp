@@ -38,6 +38,29 @@ namespace mmo::updating
 	}
 
 
+	void skipContent(
+	    UpdateSourceFile &file,
+	    std::uintmax_t count
+	)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		file.content->ignore(static_cast<std::streamsize>(count));
+		if (static_cast<std::uintmax_t>(file.content->gcount()) != count)
+		{
+			throw std::runtime_error("Could not skip " + std::to_string(count) + " bytes of the content");
+		}
+
+		if (file.size)
+		{
+			file.size = (*file.size >= count) ? (*file.size - count) : 0;
+		}
+	}
+
+
 	void checkExpectedFileSize(
 	    const std::string &fileName,
 	    std::uintmax_t expected,
@@ -30,6 +30,13 @@ namespace mmo::updating
 	};
 
 
+	/// Skips the given number of bytes of the content and reduces the known size accordingly.
+	void skipContent(
+	    UpdateSourceFile &file,
+	    std::uintmax_t count
+	);
+
+
 	void checkExpectedFileSize(
 	    const std::string &fileName,
 	    std::uintmax_t expected,
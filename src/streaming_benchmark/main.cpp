@@ -0,0 +1,353 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "assets/asset_registry.h"
+#include "assets/asset_streamer.h"
+#include "base/typedefs.h"
+#include "graphics/graphics_device.h"
+#include "log/default_log_levels.h"
+#include "log/log_std_stream.h"
+#include "paging/loaded_page_section.h"
+#include "paging/page_loader_listener.h"
+#include "paging/page_pov_partitioner.h"
+#include "paging/world_page_loader.h"
+#include "scene_graph/camera.h"
+#include "scene_graph/material_manager.h"
+#include "scene_graph/scene.h"
+#include "scene_graph/scene_node.h"
+#include "terrain/page.h"
+#include "terrain/terrain.h"
+
+#include "cxxopts/cxxopts.hpp"
+
+namespace mmo
+{
+	/// Replays a straight camera flight over a world's terrain and drives terrain page streaming the same way the
+	/// client's world state does, measuring the main thread time spent per frame.
+	class StreamingBenchmark final : public IPageLoaderListener
+	{
+	public:
+		explicit StreamingBenchmark(const String& worldName, const bool async, const uint32 workerCount)
+			: m_async(async)
+		{
+			// Pages fall back to the default material which is loaded from the asset registry if it exists
+			if (!AssetRegistry::HasFile("Models/Default.hmat"))
+			{
+				MaterialManager::Get().CreateManual("Models/Default.hmat");
+			}
+
+			m_camera = m_scene.CreateCamera("BenchmarkCamera");
+			m_cameraNode = &m_scene.CreateSceneNode("BenchmarkCameraNode");
+			m_scene.GetRootSceneNode().AddChild(*m_cameraNode);
+			m_cameraNode->AttachObject(*m_camera);
+
+			m_terrain = std::make_unique<terrain::Terrain>(m_scene, m_camera, 64, 64);
+			m_terrain->SetBaseFileName("Worlds/" + worldName + "/" + worldName);
+
+			if (m_async)
+			{
+				m_streamer = std::make_unique<AssetStreamer>(workerCount);
+			}
+		}
+
+		~StreamingBenchmark() override
+		{
+			// Pages cancel their pending requests on destruction, so the streamer has to outlive the terrain
+			m_terrain.reset();
+			m_streamer.reset();
+		}
+
+	public:
+		/// Runs the benchmark and returns the main thread duration of each frame in milliseconds.
+		std::vector<double> Run(const Vector3& from, const Vector3& to, const float speed, const float frameRate)
+		{
+			const float frameDuration = 1.0f / frameRate;
+			const float distance = from.GetDistanceTo(to);
+			const uint32 frameCount = std::max(1u, static_cast<uint32>(distance / speed * frameRate));
+
+			m_cameraNode->SetPosition(from);
+			m_cameraNode->LookAt(to, TransformSpace::World, Vector3::NegativeUnitZ);
+
+			const PagePosition pos = GetPagePosition(from);
+			m_visibleSection = std::make_unique<LoadedPageSection>(pos, 1, *this);
+			m_pageLoader = std::make_unique<WorldPageLoader>(*m_visibleSection,
+				[](const WorldPageLoader::Work& work) { work(); },
+				[this](const WorldPageLoader::Work& work) { m_dispatcher.push_back(work); });
+			m_memoryPointOfView = std::make_unique<PagePOVPartitioner>(PagePosition(64, 64), 2, pos, *m_pageLoader);
+
+			std::vector<double> frameTimes;
+			frameTimes.reserve(frameCount);
+
+			for (uint32 frame = 0; frame <= frameCount; ++frame)
+			{
+				const auto frameStart = std::chrono::steady_clock::now();
+
+				m_cameraNode->SetPosition(from + (to - from) * (static_cast<float>(frame) / static_cast<float>(frameCount)));
+				Update();
+
+				const auto frameEnd = std::chrono::steady_clock::now();
+				frameTimes.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+
+				// Keep a realistic frame pacing so background workers get the same amount of time as in the client
+				std::this_thread::sleep_until(frameStart + std::chrono::duration<float>(frameDuration));
+			}
+
+			m_memoryPointOfView.reset();
+			m_pageLoader.reset();
+			m_visibleSection.reset();
+
+			return frameTimes;
+		}
+
+		uint32 GetLoadedPageCount() const { return m_loadedPageCount; }
+
+		uint64 GetStreamedFileCount() const { return m_streamer ? m_streamer->GetLoadedFileCount() : 0; }
+
+	private:
+		void Update()
+		{
+			while (!m_dispatcher.empty())
+			{
+				const auto work = std::move(m_dispatcher.front());
+				m_dispatcher.pop_front();
+				work();
+			}
+
+			if (m_streamer)
+			{
+				for (const auto& [x, z] : m_pendingPages)
+				{
+					if (terrain::Page* page = m_terrain->GetPage(x, z); page && page->IsPreparing())
+					{
+						page->SetPreparePriority(GetPriority(*page));
+					}
+				}
+
+				m_streamer->ProcessCompletions(MaxCompletionsPerFrame);
+			}
+
+			// Same as WorldState::EnsurePageIsLoaded: create at most one tile per page and frame
+			for (auto it = m_pendingPages.begin(); it != m_pendingPages.end(); )
+			{
+				terrain::Page* page = m_terrain->GetPage(it->first, it->second);
+				if (page && page->IsLoadable())
+				{
+					if (page->Load())
+					{
+						++m_loadedPageCount;
+						it = m_pendingPages.erase(it);
+						continue;
+					}
+				}
+				else if (!page || page->IsLoaded())
+				{
+					it = m_pendingPages.erase(it);
+					continue;
+				}
+
+				++it;
+			}
+
+			const PagePosition pos = GetPagePosition(m_camera->GetDerivedPosition());
+			m_memoryPointOfView->UpdateCenter(pos);
+			m_visibleSection->UpdateCenter(pos);
+		}
+
+		void OnPageAvailabilityChanged(const PageNeighborhood& neighborhood, const bool isAvailable) override
+		{
+			const PagePosition& pos = neighborhood.GetMainPage().GetPosition();
+
+			terrain::Page* page = m_terrain->GetPage(pos.x(), pos.y());
+			if (!page)
+			{
+				return;
+			}
+
+			const std::pair<uint32, uint32> key(static_cast<uint32>(pos.x()), static_cast<uint32>(pos.y()));
+			if (isAvailable)
+			{
+				if (m_streamer)
+				{
+					page->PrepareAsync(*m_streamer, GetPriority(*page));
+				}
+				else
+				{
+					page->Prepare();
+				}
+
+				if (std::find(m_pendingPages.begin(), m_pendingPages.end(), key) == m_pendingPages.end())
+				{
+					m_pendingPages.push_back(key);
+				}
+			}
+			else
+			{
+				page->CancelPrepare();
+				page->Unload();
+				std::erase(m_pendingPages, key);
+			}
+		}
+
+		float GetPriority(const terrain::Page& page) const
+		{
+			Vector3 center = page.GetBoundingBox().GetCenter();
+			center.y = m_camera->GetDerivedPosition().y;
+
+			return AssetStreamer::CalculatePriority(m_camera->GetDerivedPosition().GetDistanceTo(center), m_camera->IsVisible(page.GetBoundingBox()));
+		}
+
+		static PagePosition GetPagePosition(const Vector3& position)
+		{
+			return PagePosition(
+				static_cast<uint32>(floor(position.x / terrain::constants::PageSize)) + 32,
+				static_cast<uint32>(floor(position.z / terrain::constants::PageSize)) + 32);
+		}
+
+	private:
+		static constexpr size_t MaxCompletionsPerFrame = 4;
+
+		bool m_async;
+		Scene m_scene;
+		Camera* m_camera = nullptr;
+		SceneNode* m_cameraNode = nullptr;
+		std::unique_ptr<AssetStreamer> m_streamer;
+		std::unique_ptr<terrain::Terrain> m_terrain;
+		std::deque<WorldPageLoader::Work> m_dispatcher;
+		std::unique_ptr<LoadedPageSection> m_visibleSection;
+		std::unique_ptr<WorldPageLoader> m_pageLoader;
+		std::unique_ptr<PagePOVPartitioner> m_memoryPointOfView;
+		std::vector<std::pair<uint32, uint32>> m_pendingPages;
+		uint32 m_loadedPageCount = 0;
+	};
+
+	static double Percentile(const std::vector<double>& sortedValues, const double percentile)
+	{
+		if (sortedValues.empty())
+		{
+			return 0.0;
+		}
+
+		const size_t index = std::min(sortedValues.size() - 1, static_cast<size_t>(percentile * static_cast<double>(sortedValues.size())));
+		return sortedValues[index];
+	}
+}
+
+/// Entry point of the streaming benchmark console tool.
+///	@param argc The number of command line arguments.
+///	@param argv The command line arguments.
+///	@return 0 on success, anything else on error.
+int main(int argc, char* argv[])
+{
+	auto logOptions = mmo::g_DefaultConsoleLogOptions;
+
+	std::mutex coutLogMutex;
+	mmo::g_DefaultLog.signal().connect([&coutLogMutex, &logOptions](const mmo::LogEntry& entry) {
+		std::scoped_lock lock{ coutLogMutex };
+		printLogEntry(std::cout, entry, logOptions);
+		});
+
+	mmo::String dataDirectory;
+	mmo::String worldName;
+	mmo::String mode = "async";
+	float fromX = -1000.0f, fromZ = 0.0f, toX = 1000.0f, toZ = 0.0f;
+	float height = 50.0f;
+	float speed = 28.0f;
+	float frameRate = 60.0f;
+	mmo::uint32 workerCount = 2;
+
+	cxxopts::Options options("Terrain Streaming Benchmark, available options");
+	options.add_options()
+		("help", "produce help message")
+		("d,data", "set data directory path", cxxopts::value<std::string>(dataDirectory))
+		("w,world", "sets the name of the world to fly over", cxxopts::value<std::string>(worldName))
+		("m,mode", "'async' to stream pages in the background, 'sync' to load them on the main thread", cxxopts::value<std::string>(mode))
+		("from-x", "x coordinate of the start of the camera path", cxxopts::value<float>(fromX))
+		("from-z", "z coordinate of the start of the camera path", cxxopts::value<float>(fromZ))
+		("to-x", "x coordinate of the end of the camera path", cxxopts::value<float>(toX))
+		("to-z", "z coordinate of the end of the camera path", cxxopts::value<float>(toZ))
+		("height", "height of the camera above the terrain", cxxopts::value<float>(height))
+		("s,speed", "camera speed in units per second", cxxopts::value<float>(speed))
+		("f,fps", "simulated frame rate", cxxopts::value<float>(frameRate))
+		("j,workers", "number of streaming worker threads", cxxopts::value<mmo::uint32>(workerCount))
+		;
+
+	options.parse_positional({ "data", "world" });
+
+	try
+	{
+		cxxopts::ParseResult result = options.parse(argc, argv);
+		if (result.count("help") || dataDirectory.empty() || worldName.empty())
+		{
+			ILOG(options.help());
+			return result.count("help") ? 0 : 1;
+		}
+
+		if (mode != "async" && mode != "sync")
+		{
+			ELOG("Unknown mode '" << mode << "', use 'async' or 'sync'");
+			return 1;
+		}
+
+		if (speed <= 0.0f || frameRate <= 0.0f || workerCount == 0)
+		{
+			ELOG("Speed, frame rate and worker count have to be greater than zero");
+			return 1;
+		}
+
+		mmo::AssetRegistry::Initialize(dataDirectory, {});
+		mmo::GraphicsDevice::CreateNull({});
+
+		std::vector<double> frameTimes;
+		mmo::uint32 loadedPages, streamedFiles;
+		{
+			mmo::StreamingBenchmark benchmark(worldName, mode == "async", workerCount);
+			frameTimes = benchmark.Run(mmo::Vector3(fromX, height, fromZ), mmo::Vector3(toX, height, toZ), speed, frameRate);
+			loadedPages = benchmark.GetLoadedPageCount();
+			streamedFiles = static_cast<mmo::uint32>(benchmark.GetStreamedFileCount());
+		}
+
+		std::vector<double> sorted = frameTimes;
+		std::sort(sorted.begin(), sorted.end());
+
+		const double frameBudget = 1000.0 / frameRate;
+		const size_t hitches = std::count_if(sorted.begin(), sorted.end(), [frameBudget](const double time) { return time > frameBudget; });
+
+		double total = 0.0;
+		for (const double time : frameTimes)
+		{
+			total += time;
+		}
+
+		std::ostringstream strm;
+		strm << std::fixed << std::setprecision(3)
+			<< "Mode: " << mode << ", frames: " << frameTimes.size() << ", pages loaded: " << loadedPages << ", files streamed: " << streamedFiles << "\n"
+			<< "Main thread frame time (ms): avg " << (frameTimes.empty() ? 0.0 : total / static_cast<double>(frameTimes.size()))
+			<< ", p50 " << mmo::Percentile(sorted, 0.50)
+			<< ", p95 " << mmo::Percentile(sorted, 0.95)
+			<< ", p99 " << mmo::Percentile(sorted, 0.99)
+			<< ", max " << (sorted.empty() ? 0.0 : sorted.back()) << "\n"
+			<< "Frames over the " << frameBudget << " ms budget: " << hitches;
+		ILOG(strm.str());
+
+		mmo::GraphicsDevice::Destroy();
+		mmo::AssetRegistry::Destroy();
+	}
+	catch (const cxxopts::OptionException& e)
+	{
+		ELOG(e.what() << "\n");
+		ILOG(options.help());
+		return 1;
+	}
+
+	return 0;
+}
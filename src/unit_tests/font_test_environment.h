@@ -0,0 +1,46 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "assets/asset_registry.h"
+#include "graphics/graphics_device.h"
+
+#include <filesystem>
+#include <stdexcept>
+
+namespace mmo
+{
+	/// Copies the test font from src/unit_tests/data into an empty asset directory as "test.ttf" and initializes
+	/// the asset registry and the null graphics device. Throws if the font can't be found, so font tests fail
+	/// instead of silently checking nothing.
+	class FontTestEnvironment final
+	{
+	public:
+		FontTestEnvironment()
+		{
+			const std::filesystem::path fontPath = MMO_TEST_FONT_PATH;
+			if (!std::filesystem::exists(fontPath))
+			{
+				throw std::runtime_error("Test font " + fontPath.string() + " not found");
+			}
+
+			m_directory = std::filesystem::temp_directory_path() / "mmo_font_test";
+			std::filesystem::remove_all(m_directory);
+			std::filesystem::create_directories(m_directory);
+			std::filesystem::copy_file(fontPath, m_directory / "test.ttf");
+
+			AssetRegistry::Initialize(m_directory, {});
+			GraphicsDevice::CreateNull({});
+		}
+
+		~FontTestEnvironment()
+		{
+			GraphicsDevice::Destroy();
+			AssetRegistry::Destroy();
+			std::filesystem::remove_all(m_directory);
+		}
+
+	private:
+		std::filesystem::path m_directory;
+	};
+}
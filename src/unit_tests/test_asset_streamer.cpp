@@ -0,0 +1,153 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "assets/asset_registry.h"
+#include "assets/asset_streamer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+using namespace mmo;
+
+namespace
+{
+	/// Initializes the asset registry with a temporary directory containing a few files.
+	struct ScopedAssetDirectory final
+	{
+		ScopedAssetDirectory()
+			: path(std::filesystem::temp_directory_path() / "mmo_asset_streamer_test")
+		{
+			std::filesystem::remove_all(path);
+			std::filesystem::create_directories(path);
+
+			std::ofstream(path / "a.bin", std::ios::binary) << "first";
+			std::ofstream(path / "b.bin", std::ios::binary) << "second";
+
+			AssetRegistry::Initialize(path, {});
+		}
+
+		~ScopedAssetDirectory()
+		{
+			AssetRegistry::Destroy();
+			std::filesystem::remove_all(path);
+		}
+
+		std::filesystem::path path;
+	};
+
+	void WaitForCompletions(AssetStreamer& streamer, const size_t count)
+	{
+		size_t processed = 0;
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (processed < count && std::chrono::steady_clock::now() < deadline)
+		{
+			processed += streamer.ProcessCompletions();
+			std::this_thread::yield();
+		}
+	}
+}
+
+TEST_CASE("AssetStreamer delivers file contents on the processing thread", "[asset_streamer]")
+{
+	ScopedAssetDirectory directory;
+	AssetStreamer streamer(1);
+
+	bool called = false;
+	String contents;
+	const auto callerThread = std::this_thread::get_id();
+	streamer.Request("a.bin", 1.0f, [&](const bool succeeded, const std::vector<char>& data)
+	{
+		called = true;
+		CHECK(succeeded);
+		CHECK(std::this_thread::get_id() == callerThread);
+		contents.assign(data.begin(), data.end());
+	});
+
+	WaitForCompletions(streamer, 1);
+
+	REQUIRE(called);
+	CHECK(contents == "first");
+	CHECK(streamer.GetPendingCount() == 0);
+}
+
+TEST_CASE("AssetStreamer merges requests for the same file", "[asset_streamer]")
+{
+	ScopedAssetDirectory directory;
+	AssetStreamer streamer(1);
+
+	int calls = 0;
+	streamer.Request("a.bin", 2.0f, [&calls](bool, const std::vector<char>&) { ++calls; });
+	streamer.Request("A.BIN", 1.0f, [&calls](bool, const std::vector<char>&) { ++calls; });
+
+	WaitForCompletions(streamer, 1);
+
+	CHECK(calls == 2);
+	CHECK(streamer.GetLoadedFileCount() == 1);
+}
+
+TEST_CASE("AssetStreamer runs the decode step before completion", "[asset_streamer]")
+{
+	ScopedAssetDirectory directory;
+	AssetStreamer streamer(1);
+
+	String contents;
+	streamer.Request("b.bin", 1.0f,
+		[&contents](const bool succeeded, const std::vector<char>& data)
+		{
+			CHECK(succeeded);
+			contents.assign(data.begin(), data.end());
+		},
+		[](std::vector<char>& data)
+		{
+			std::reverse(data.begin(), data.end());
+			return true;
+		});
+
+	WaitForCompletions(streamer, 1);
+
+	CHECK(contents == "dnoces");
+}
+
+TEST_CASE("AssetStreamer does not notify cancelled requests", "[asset_streamer]")
+{
+	ScopedAssetDirectory directory;
+	AssetStreamer streamer(1);
+
+	bool cancelledCalled = false, otherCalled = false;
+	const auto id = streamer.Request("a.bin", 1.0f, [&cancelledCalled](bool, const std::vector<char>&) { cancelledCalled = true; });
+	streamer.Request("b.bin", 2.0f, [&otherCalled](bool, const std::vector<char>&) { otherCalled = true; });
+	streamer.Cancel(id, true);
+
+	WaitForCompletions(streamer, 1);
+
+	CHECK_FALSE(cancelledCalled);
+	CHECK(otherCalled);
+	CHECK(streamer.GetPendingCount() == 0);
+}
+
+TEST_CASE("AssetStreamer reports missing files as failed", "[asset_streamer]")
+{
+	ScopedAssetDirectory directory;
+	AssetStreamer streamer(1);
+
+	bool called = false;
+	streamer.Request("missing.bin", 1.0f, [&called](const bool succeeded, const std::vector<char>&)
+	{
+		called = true;
+		CHECK_FALSE(succeeded);
+	});
+
+	WaitForCompletions(streamer, 1);
+
+	CHECK(called);
+}
+
+TEST_CASE("AssetStreamer prefers visible and closer assets", "[asset_streamer]")
+{
+	CHECK(AssetStreamer::CalculatePriority(10.0f, true) < AssetStreamer::CalculatePriority(20.0f, true));
+	CHECK(AssetStreamer::CalculatePriority(10.0f, true) < AssetStreamer::CalculatePriority(10.0f, false));
+	CHECK(AssetStreamer::CalculatePriority(30.0f, true) < AssetStreamer::CalculatePriority(10.0f, false));
+}
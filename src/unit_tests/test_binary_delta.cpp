@@ -0,0 +1,95 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/binary_delta.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace mmo;
+
+namespace
+{
+	std::string MakeRandomContent(const size_t size, const uint32 seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_int_distribution<int> distribution(0, 255);
+
+		std::string content(size, '\0');
+		for (auto& c : content)
+		{
+			c = static_cast<char>(distribution(generator));
+		}
+
+		return content;
+	}
+
+	std::string CreateDelta(const std::string& source, const std::string& target, const size_t blockSize = 64)
+	{
+		std::ostringstream delta;
+		CreateBinaryDelta(source.data(), source.size(), target.data(), target.size(), delta, blockSize);
+		return delta.str();
+	}
+
+	bool Apply(const std::string& source, const std::string& delta, std::string& out_target)
+	{
+		std::istringstream sourceStream(source);
+		std::istringstream deltaStream(delta);
+		std::ostringstream targetStream;
+		if (!ApplyBinaryDelta(sourceStream, deltaStream, targetStream))
+		{
+			return false;
+		}
+
+		out_target = targetStream.str();
+		return true;
+	}
+}
+
+
+TEST_CASE("Binary delta reproduces the target", "[binary_delta]")
+{
+	const std::string source = MakeRandomContent(64 * 1024, 1);
+
+	std::string target = source.substr(0, 10000) + MakeRandomContent(500, 2) + source.substr(12000) + MakeRandomContent(100, 3);
+	// Move a block to the front, which has to be found at an unaligned offset
+	target = source.substr(30001, 4000) + target;
+
+	const std::string delta = CreateDelta(source, target);
+
+	std::string result;
+	REQUIRE(Apply(source, delta, result));
+	CHECK(result == target);
+
+	// Most of the target is copied from the source
+	CHECK(delta.size() < 2000);
+}
+
+TEST_CASE("Binary delta handles empty and unrelated content", "[binary_delta]")
+{
+	const std::string content = MakeRandomContent(1000, 4);
+	std::string result;
+
+	REQUIRE(Apply(std::string(), CreateDelta(std::string(), content), result));
+	CHECK(result == content);
+
+	REQUIRE(Apply(content, CreateDelta(content, std::string()), result));
+	CHECK(result.empty());
+
+	const std::string other = MakeRandomContent(3000, 5);
+	REQUIRE(Apply(content, CreateDelta(content, other), result));
+	CHECK(result == other);
+}
+
+TEST_CASE("Binary delta rejects a different source", "[binary_delta]")
+{
+	const std::string source = MakeRandomContent(4096, 6);
+	const std::string target = source + "appended";
+	const std::string delta = CreateDelta(source, target);
+
+	std::string result;
+	CHECK_FALSE(Apply(source.substr(1), delta, result));
+	CHECK_FALSE(Apply(source, delta.substr(0, delta.size() - 4), result));
+}
@@ -6,10 +6,13 @@
 #include "base/typedefs.h"
 #include "writer.h"
 #include "math/aabb.h"
+#include "game/movement_info.h"
 
 #include <vector>
 #include <cstring>
 #include <algorithm>
+#include <chrono>
+#include <iostream>
 
 using namespace mmo;
 
@@ -287,3 +290,247 @@ TEST_CASE("Reader reads limited string correctly", "[binaryio]")
     REQUIRE(reader);
 }
 
+
+namespace
+{
+	/// Writes a typical object update: header, movement info and a block of field values.
+	template <class W>
+	void WriteTypicalUpdate(W& writer, const MovementInfo& movement, const std::vector<uint32>& fields)
+	{
+		writer
+			<< io::write<uint8>(1)
+			<< io::write_packed_guid(0xF130000000000001)
+			<< io::write<uint32>(1)
+			<< movement
+			<< io::write_dynamic_range<uint8>(fields);
+	}
+
+	MovementInfo MakeMovementInfo()
+	{
+		MovementInfo info;
+		info.movementFlags = movement_flags::Forward | movement_flags::Falling;
+		info.timestamp = 123456;
+		info.position = Vector3(1.0f, 2.0f, 3.0f);
+		info.facing = Radian(0.5f);
+		info.fallTime = 42;
+		info.jumpVelocity = 7.0f;
+		return info;
+	}
+
+	std::vector<uint32> MakeFields()
+	{
+		std::vector<uint32> fields(24);
+		for (uint32 i = 0; i < fields.size(); ++i)
+		{
+			fields[i] = i * 7;
+		}
+
+		return fields;
+	}
+}
+
+TEST_CASE("BasicWriter writes the same bytes as Writer", "[binaryio]")
+{
+	const MovementInfo movement = MakeMovementInfo();
+	const std::vector<uint32> fields = MakeFields();
+
+	std::vector<char> expected;
+	{
+		io::VectorSink sink{ expected };
+		io::Writer writer{ sink };
+		WriteTypicalUpdate(writer, movement, fields);
+	}
+
+	std::vector<char> actual;
+	{
+		io::VectorSink sink{ actual };
+		io::BasicWriter writer{ sink };
+		writer.Reserve(256);
+		WriteTypicalUpdate(writer, movement, fields);
+		CHECK(actual.capacity() >= 256);
+	}
+
+	CHECK(actual == expected);
+}
+
+TEST_CASE("Reserved sections are written without growing the buffer", "[binaryio]")
+{
+	const MovementInfo movement = MakeMovementInfo();
+	const std::vector<uint32> fields = MakeFields();
+
+	std::vector<char> expected;
+	{
+		io::VectorSink sink{ expected };
+		io::Writer writer{ sink };
+		WriteTypicalUpdate(writer, movement, fields);
+	}
+
+	std::vector<char> actual;
+	{
+		io::VectorSink sink{ actual };
+		io::BasicWriter writer{ sink };
+
+		// Header, movement info and the field count have a variable size, the field values don't
+		writer << io::write<uint8>(1) << io::write_packed_guid(0xF130000000000001) << io::write<uint32>(1) << movement << io::write<uint8>(fields.size());
+
+		const size_t sectionPosition = actual.size();
+		io::SectionSink section = writer.ReserveSection(fields.size() * sizeof(uint32));
+		REQUIRE(actual.size() == sectionPosition + section.Size());
+
+		const char* const sectionData = actual.data();
+		io::BasicWriter sectionWriter{ section };
+		for (const uint32 field : fields)
+		{
+			sectionWriter << io::write<uint32>(field);
+		}
+
+		CHECK(section.Position() == section.Size());
+		CHECK(actual.data() == sectionData);
+	}
+
+	CHECK(actual == expected);
+}
+
+TEST_CASE("Sections refuse writes past their end", "[binaryio]")
+{
+	// The bytes behind the section must never be written
+	std::vector<char> buffer(8, 'x');
+	io::SectionSink section{ buffer.data(), 6 };
+	io::BasicWriter writer{ section };
+
+	writer << io::write<uint32>(1);
+	CHECK(static_cast<bool>(writer));
+
+	writer << io::write<uint32>(2);
+	CHECK_FALSE(static_cast<bool>(writer));
+	CHECK(section.HasOverflowed());
+	CHECK(section.Position() == 4);
+
+	// Once a write has been refused, smaller writes which would still fit are refused as well
+	writer << io::write<uint8>(3);
+	CHECK(section.Position() == 4);
+
+	// Overwrites may only change bytes which have been written already
+	writer.WritePOD(2, uint32(4));
+	CHECK(buffer[4] == 'x');
+	CHECK(buffer[6] == 'x');
+	CHECK(buffer[7] == 'x');
+}
+
+TEST_CASE("BasicReader reads what was written", "[binaryio]")
+{
+	const MovementInfo movement = MakeMovementInfo();
+	const std::vector<uint32> fields = MakeFields();
+
+	std::vector<char> buffer;
+	io::VectorSink sink{ buffer };
+	io::BasicWriter writer{ sink };
+	writer << io::write<uint16>(0x1234) << movement << io::write_dynamic_range<uint8>(fields);
+
+	io::MemorySource source{ buffer };
+	io::BasicReader reader{ source };
+
+	uint16 header = 0;
+	MovementInfo readMovement;
+	std::vector<uint32> readFields;
+
+	reader >> io::read<uint16>(header) >> readMovement >> io::read_container<uint8>(readFields);
+
+	REQUIRE(reader);
+	CHECK(header == 0x1234);
+	CHECK(readMovement.timestamp == movement.timestamp);
+	CHECK(readMovement.position == movement.position);
+	CHECK(readMovement.jumpVelocity == movement.jumpVelocity);
+	CHECK(readFields == fields);
+	CHECK(source.end());
+}
+
+TEST_CASE("BasicReader rejects truncated sections up front", "[binaryio]")
+{
+	const std::vector<char> buffer(6, 0);
+	io::MemorySource source{ buffer };
+	io::BasicReader reader{ source };
+
+	uint32 value = 0;
+	CHECK(reader.Require(4) >> value);
+	CHECK_FALSE(reader.Require(4));
+}
+
+TEST_CASE("Serialization throughput", "[binaryio][!benchmark]")
+{
+	constexpr size_t PacketCount = 200000;
+
+	const MovementInfo movement = MakeMovementInfo();
+	const std::vector<uint32> fields = MakeFields();
+
+	using Clock = std::chrono::steady_clock;
+	std::vector<char> buffer;
+	size_t totalBytes = 0;
+
+	auto start = Clock::now();
+	for (size_t i = 0; i < PacketCount; ++i)
+	{
+		buffer.clear();
+		io::VectorSink sink{ buffer };
+		io::Writer writer{ sink };
+		WriteTypicalUpdate(writer, movement, fields);
+		totalBytes += buffer.size();
+	}
+	const double virtualSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	start = Clock::now();
+	for (size_t i = 0; i < PacketCount; ++i)
+	{
+		buffer.clear();
+		io::VectorSink sink{ buffer };
+		io::BasicWriter writer{ sink };
+		writer.Reserve(256);
+		WriteTypicalUpdate(writer, movement, fields);
+	}
+	const double typedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	start = Clock::now();
+	for (size_t i = 0; i < PacketCount; ++i)
+	{
+		buffer.clear();
+		io::VectorSink sink{ buffer };
+		io::BasicWriter writer{ sink };
+		writer.Reserve(256);
+		writer << io::write<uint8>(1) << io::write_packed_guid(0xF130000000000001) << io::write<uint32>(1) << movement << io::write<uint8>(fields.size());
+
+		io::SectionSink section = writer.ReserveSection(fields.size() * sizeof(uint32));
+		io::BasicWriter sectionWriter{ section };
+		for (const uint32 field : fields)
+		{
+			sectionWriter << io::write<uint32>(field);
+		}
+	}
+	const double sectionSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	MovementInfo readMovement;
+	start = Clock::now();
+	for (size_t i = 0; i < PacketCount; ++i)
+	{
+		io::MemorySource source{ buffer };
+		io::Reader reader{ source };
+		reader >> io::skip(14) >> readMovement;
+	}
+	const double virtualReadSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	start = Clock::now();
+	for (size_t i = 0; i < PacketCount; ++i)
+	{
+		io::MemorySource source{ buffer };
+		io::BasicReader reader{ source };
+		reader >> io::skip(14) >> readMovement;
+	}
+	const double typedReadSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	const double megaBytes = static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+	std::cout << "Serializing " << PacketCount << " object updates (" << totalBytes / PacketCount << " bytes each):" << std::endl;
+	std::cout << "\tWriter:       " << megaBytes / virtualSeconds << " MB/s" << std::endl;
+	std::cout << "\tBasicWriter:  " << megaBytes / typedSeconds << " MB/s" << std::endl;
+	std::cout << "\tSections:     " << megaBytes / sectionSeconds << " MB/s" << std::endl;
+	std::cout << "\tReader:       " << PacketCount / virtualReadSeconds << " movement infos/s" << std::endl;
+	std::cout << "\tBasicReader:  " << PacketCount / typedReadSeconds << " movement infos/s" << std::endl;
+}
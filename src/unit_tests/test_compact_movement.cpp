@@ -0,0 +1,200 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "binary_io/memory_source.h"
+#include "binary_io/reader.h"
+#include "binary_io/vector_sink.h"
+#include "binary_io/writer.h"
+#include "game/compact_movement.h"
+#include "math/constants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	std::vector<char> Encode(const CompactMovementState& state, const CompactMovementState* reference)
+	{
+		std::vector<char> buffer;
+		io::VectorSink sink { buffer };
+		io::Writer writer { sink };
+		WriteCompactMovement(writer, state, reference);
+		return buffer;
+	}
+
+	bool Decode(const std::vector<char>& buffer, const CompactMovementState* reference, CompactMovementState& out_state)
+	{
+		io::MemorySource source { buffer.data(), buffer.data() + buffer.size() };
+		io::Reader reader { source };
+		return ReadCompactMovement(reader, reference, out_state);
+	}
+
+	float GetAngleDifference(const float a, const float b)
+	{
+		const float difference = std::fmod(std::abs(a - b), TwoPi);
+		return difference > Pi ? TwoPi - difference : difference;
+	}
+}
+
+TEST_CASE("Compact movement keyframes round trip", "[compact_movement]")
+{
+	MovementInfo info;
+	info.movementFlags = movement_flags::Forward | movement_flags::Falling;
+	info.timestamp = 123456789;
+	info.position = Vector3(-1234.5f, 56.25f, 7890.125f);
+	info.facing = Radian(1.5f);
+	info.fallTime = 250;
+	info.jumpVelocity = 7.5f;
+	info.jumpSinAngle = 0.5f;
+	info.jumpCosAngle = 0.25f;
+	info.jumpXZSpeed = 3.0f;
+
+	const CompactMovementState state = CompactMovementState::FromMovementInfo(info);
+	const auto buffer = Encode(state, nullptr);
+
+	CompactMovementState decoded;
+	REQUIRE(Decode(buffer, nullptr, decoded));
+	CHECK(decoded == state);
+
+	const MovementInfo decodedInfo = decoded.ToMovementInfo();
+	CHECK(decodedInfo.movementFlags == info.movementFlags);
+	CHECK(decodedInfo.timestamp == info.timestamp);
+	CHECK(decodedInfo.position.IsNearlyEqual(info.position, 0.5f / CompactMovementPositionScale));
+	CHECK(decodedInfo.fallTime == info.fallTime);
+	CHECK(decodedInfo.jumpVelocity == info.jumpVelocity);
+	CHECK(decodedInfo.jumpXZSpeed == info.jumpXZSpeed);
+}
+
+TEST_CASE("Compact movement deltas stay within the quantization error", "[compact_movement]")
+{
+	std::mt19937 generator(1337);
+	std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+	std::uniform_real_distribution<float> angle(-10.0f, 10.0f);
+	std::uniform_int_distribution<int> chance(0, 99);
+
+	MovementInfo info;
+	info.position = Vector3(500.0f, 20.0f, -300.0f);
+	info.timestamp = 1000;
+
+	const CompactMovementState* senderReference = nullptr;
+	const CompactMovementState* receiverReference = nullptr;
+	CompactMovementState senderState, receiverState;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		info.timestamp += 50 + chance(generator) * 5;
+		info.position += Vector3(step(generator), step(generator) * 0.1f, step(generator));
+		info.facing = Radian(angle(generator));
+		info.movementFlags = chance(generator) < 20 ? movement_flags::Swimming | movement_flags::Forward : movement_flags::Forward;
+		info.pitch = Radian(angle(generator) * 0.3f);
+
+		const CompactMovementState state = CompactMovementState::FromMovementInfo(info);
+		const auto buffer = Encode(state, senderReference);
+		senderState = state;
+		senderReference = &senderState;
+
+		CompactMovementState decoded;
+		REQUIRE(Decode(buffer, receiverReference, decoded));
+		REQUIRE(decoded == state);
+		receiverState = decoded;
+		receiverReference = &receiverState;
+
+		const MovementInfo decodedInfo = decoded.ToMovementInfo();
+		CHECK(decodedInfo.timestamp == info.timestamp);
+		CHECK(std::abs(decodedInfo.position.x - info.position.x) <= 0.5f / CompactMovementPositionScale + 0.001f);
+		CHECK(std::abs(decodedInfo.position.y - info.position.y) <= 0.5f / CompactMovementPositionScale + 0.001f);
+		CHECK(std::abs(decodedInfo.position.z - info.position.z) <= 0.5f / CompactMovementPositionScale + 0.001f);
+		CHECK(GetAngleDifference(decodedInfo.facing.GetValueRadians(), info.facing.GetValueRadians()) <= Pi / 65536.0f + 0.0005f);
+
+		if (info.movementFlags & movement_flags::Swimming)
+		{
+			const float expectedPitch = std::clamp(info.pitch.GetValueRadians(), -Pi, Pi);
+			CHECK(std::abs(decodedInfo.pitch.GetValueRadians() - expectedPitch) <= Pi / 32767.0f + 0.0005f);
+		}
+	}
+}
+
+TEST_CASE("Compact movement falls back to wide positions and keyframes", "[compact_movement]")
+{
+	MovementInfo info;
+	info.timestamp = 5000;
+	info.position = Vector3(10.0f, 0.0f, 10.0f);
+	const CompactMovementState first = CompactMovementState::FromMovementInfo(info);
+
+	SECTION("Large jumps in position")
+	{
+		info.timestamp += 100;
+		info.position = Vector3(5000.0f, 0.0f, -5000.0f);
+		const CompactMovementState second = CompactMovementState::FromMovementInfo(info);
+
+		const auto buffer = Encode(second, &first);
+		REQUIRE_FALSE(buffer.empty());
+		CHECK((buffer[0] & compact_movement_fields::PositionWide) != 0);
+		CHECK((buffer[0] & compact_movement_fields::Keyframe) == 0);
+
+		CompactMovementState decoded;
+		REQUIRE(Decode(buffer, &first, decoded));
+		CHECK(decoded == second);
+	}
+
+	SECTION("Timestamps going backwards")
+	{
+		info.timestamp = 100;
+		const CompactMovementState second = CompactMovementState::FromMovementInfo(info);
+
+		const auto buffer = Encode(second, &first);
+		REQUIRE_FALSE(buffer.empty());
+		CHECK((buffer[0] & compact_movement_fields::Keyframe) != 0);
+
+		CompactMovementState decoded;
+		REQUIRE(Decode(buffer, nullptr, decoded));
+		CHECK(decoded == second);
+	}
+
+	SECTION("Deltas without reference are rejected")
+	{
+		info.timestamp += 100;
+		const auto buffer = Encode(CompactMovementState::FromMovementInfo(info), &first);
+
+		CompactMovementState decoded;
+		CHECK_FALSE(Decode(buffer, nullptr, decoded));
+	}
+
+	SECTION("Truncated data is rejected")
+	{
+		auto buffer = Encode(first, nullptr);
+		buffer.pop_back();
+
+		CompactMovementState decoded;
+		CHECK_FALSE(Decode(buffer, nullptr, decoded));
+	}
+}
+
+TEST_CASE("Compact movement heartbeats are smaller than the full format", "[compact_movement]")
+{
+	MovementInfo info;
+	info.movementFlags = movement_flags::Forward;
+	info.timestamp = 10000;
+	info.position = Vector3(100.0f, 5.0f, 100.0f);
+	info.facing = Radian(0.75f);
+
+	std::vector<char> fullBuffer;
+	io::VectorSink fullSink { fullBuffer };
+	io::Writer fullWriter { fullSink };
+	fullWriter << io::write<uint64>(1) << info;
+
+	const CompactMovementState first = CompactMovementState::FromMovementInfo(info);
+	info.timestamp += 500;
+	info.position.x += 3.5f;
+	const auto heartbeat = Encode(CompactMovementState::FromMovementInfo(info), &first);
+
+	// Packed guid of a low guid, op code and the delta
+	const size_t compactSize = 2 + 1 + heartbeat.size();
+	INFO("Full: " << fullBuffer.size() << " bytes, compact: " << compactSize << " bytes");
+	CHECK(compactSize * 3 <= fullBuffer.size());
+}
@@ -4,6 +4,10 @@
 #include "memory_source.h"
 #include "vector_sink.h"
 
+#include <chrono>
+#include <iostream>
+#include <random>
+
 
 class AssertException final : std::runtime_error
 {
@@ -29,6 +33,54 @@ public:
 
 using namespace mmo;
 
+namespace
+{
+	/// Serializes the changes of a field map field by field, the way the wire format is specified.
+	void SerializeChangesPerField(const FieldMap<uint32>& fieldMap, io::Writer& writer)
+	{
+		for (size_t i = 0; i < fieldMap.GetFieldCount(); i += 8)
+		{
+			uint8 flag = 0;
+			for (size_t j = 0; j < 8 && i + j < fieldMap.GetFieldCount(); ++j)
+			{
+				if (fieldMap.IsFieldMarkedAsChanged(i + j))
+				{
+					flag |= 1 << j;
+				}
+			}
+
+			writer << io::write<uint8>(flag);
+		}
+
+		for (size_t i = 0; i < fieldMap.GetFieldCount(); ++i)
+		{
+			if (fieldMap.IsFieldMarkedAsChanged(i))
+			{
+				writer << io::write<uint32>(fieldMap.GetFieldValue<uint32>(i));
+			}
+		}
+	}
+
+	/// Changes random fields of a field map, in random runs of consecutive fields.
+	void ChangeRandomFields(FieldMap<uint32>& fieldMap, std::mt19937& generator, const size_t changeCount)
+	{
+		std::uniform_int_distribution<size_t> index(0, fieldMap.GetFieldCount() - 1);
+		std::uniform_int_distribution<size_t> runLength(1, 70);
+		std::uniform_int_distribution<uint32> value;
+
+		for (size_t i = 0; i < changeCount; ++i)
+		{
+			const size_t first = index(generator);
+			const size_t last = std::min(fieldMap.GetFieldCount(), first + runLength(generator));
+			for (size_t field = first; field < last; ++field)
+			{
+				// Zero would not change fresh fields
+				fieldMap.SetFieldValue<uint32>(static_cast<uint16>(field), value(generator) | 1);
+			}
+		}
+	}
+}
+
 
 TEST_CASE("SerializeCompleteIsDeserializable", "[field_map]")
 {
@@ -188,4 +240,147 @@ TEST_CASE("SetFieldsMarkFieldsAsChanged", "[field_map]")
 
 	CHECK(fieldMap.IsFieldMarkedAsChanged(0));
 	CHECK(fieldMap.IsFieldMarkedAsChanged(1));
-}
\ No newline at end of file
+}
+
+TEST_CASE("SerializeChangesMatchesPerFieldFormat", "[field_map]")
+{
+	std::mt19937 generator(4242);
+
+	const size_t fieldCount = GENERATE(1, 7, 8, 9, 63, 64, 65, 127, 128, 129, static_cast<size_t>(object_fields::PlayerFieldCount));
+	const size_t changeCount = GENERATE(0, 1, 5, 40);
+
+	for (int iteration = 0; iteration < 20; ++iteration)
+	{
+		FieldMap<uint32> fieldMap;
+		fieldMap.Initialize(fieldCount);
+		ChangeRandomFields(fieldMap, generator, changeCount);
+
+		std::vector<char> buffer;
+		io::VectorSink sink { buffer };
+		io::Writer writer { sink };
+		fieldMap.SerializeChanges(writer);
+
+		std::vector<char> expected;
+		io::VectorSink expectedSink { expected };
+		io::Writer expectedWriter { expectedSink };
+		SerializeChangesPerField(fieldMap, expectedWriter);
+
+		REQUIRE(buffer == expected);
+
+		FieldMap<uint32> deserializedMap;
+		deserializedMap.Initialize(fieldCount);
+
+		io::MemorySource source { buffer };
+		io::Reader reader { source };
+		REQUIRE(deserializedMap.DeserializeChanges(reader));
+		CHECK(source.end());
+
+		for (size_t i = 0; i < fieldCount; ++i)
+		{
+			REQUIRE(deserializedMap.IsFieldMarkedAsChanged(i) == fieldMap.IsFieldMarkedAsChanged(i));
+			REQUIRE(deserializedMap.GetFieldValue<uint32>(i) == fieldMap.GetFieldValue<uint32>(i));
+		}
+
+		CHECK(deserializedMap.HasChanges() == fieldMap.HasChanges());
+		CHECK(deserializedMap.GetFirstChangedField() == fieldMap.GetFirstChangedField());
+		CHECK(deserializedMap.GetLastChangedField() == fieldMap.GetLastChangedField());
+	}
+}
+
+TEST_CASE("DeserializeChangesFailsOnTruncatedData", "[field_map]")
+{
+	FieldMap<uint32> fieldMap;
+	fieldMap.Initialize(100);
+	fieldMap.SetFieldValue<uint32>(10, 1);
+	fieldMap.SetFieldValue<uint32>(70, 2);
+
+	std::vector<char> buffer;
+	io::VectorSink sink { buffer };
+	io::Writer writer { sink };
+	fieldMap.SerializeChanges(writer);
+
+	// Missing parts of the mask as well as missing values are detected
+	for (const size_t size : { size_t(5), buffer.size() - 1 })
+	{
+		io::MemorySource source { buffer.data(), buffer.data() + size };
+		io::Reader reader { source };
+
+		FieldMap<uint32> deserializedMap;
+		deserializedMap.Initialize(100);
+		CHECK_FALSE(deserializedMap.DeserializeChanges(reader));
+	}
+}
+
+TEST_CASE("DeserializeChangesIgnoresPaddingBits", "[field_map]")
+{
+	std::vector<char> buffer;
+	io::VectorSink sink { buffer };
+	io::Writer writer { sink };
+	writer << io::write<uint8>(0xff) << io::write<uint32>(1) << io::write<uint32>(2) << io::write<uint32>(3);
+
+	FieldMap<uint32> fieldMap;
+	fieldMap.Initialize(3);
+
+	io::MemorySource source { buffer };
+	io::Reader reader { source };
+	REQUIRE(fieldMap.DeserializeChanges(reader));
+	CHECK(fieldMap.GetFieldValue<uint32>(2) == 3);
+	CHECK(fieldMap.GetLastChangedField() == 2);
+}
+
+TEST_CASE("Field map change serialization throughput", "[field_map][!benchmark]")
+{
+	constexpr size_t Iterations = 20000;
+
+	std::mt19937 generator(1);
+
+	for (const size_t fieldCount : { static_cast<size_t>(object_fields::UnitFieldCount), static_cast<size_t>(object_fields::PlayerFieldCount) })
+	{
+		FieldMap<uint32> fieldMap;
+		fieldMap.Initialize(fieldCount);
+		ChangeRandomFields(fieldMap, generator, 8);
+
+		using Clock = std::chrono::steady_clock;
+		std::vector<char> buffer;
+		size_t checksum = 0;
+
+		auto start = Clock::now();
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			buffer.clear();
+			io::VectorSink sink { buffer };
+			io::Writer writer { sink };
+			SerializeChangesPerField(fieldMap, writer);
+			checksum += buffer.size();
+		}
+		const double perFieldSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		start = Clock::now();
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			buffer.clear();
+			io::VectorSink sink { buffer };
+			io::Writer writer { sink };
+			fieldMap.SerializeChanges(writer);
+			checksum += buffer.size();
+		}
+		const double wordSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		FieldMap<uint32> deserializedMap;
+		deserializedMap.Initialize(fieldCount);
+
+		start = Clock::now();
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			io::MemorySource source { buffer };
+			io::Reader reader { source };
+			deserializedMap.DeserializeChanges(reader);
+		}
+		const double readSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		std::cout << "Field map with " << fieldCount << " fields (" << buffer.size() << " bytes of changes, checksum " << checksum << "):" << std::endl;
+		std::cout << "\tPer field:   " << Iterations / perFieldSeconds << " serializations/s" << std::endl;
+		std::cout << "\tPer word:    " << Iterations / wordSeconds << " serializations/s" << std::endl;
+		std::cout << "\tDeserialize: " << Iterations / readSeconds << " deserializations/s" << std::endl;
+	}
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#if MMO_BUILD_CLIENT
+
+#include "catch.hpp"
+#include "font_test_environment.h"
+
+#include "frame_ui/font.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace mmo;
+
+namespace
+{
+	/// Printable characters and a few accented ones, which are spread over more than one atlas page.
+	constexpr uint32 FirstCodepoint = 0x20;
+	constexpr uint32 LastCodepoint = 0xFF;
+
+	/// Checks that a glyph has the same metrics and pixels as a glyph of another font.
+	void CheckGlyphsMatch(uint32 codepoint, const Font& expectedFont, const FontGlyph* expected, const Font& actualFont, const FontGlyph* actual)
+	{
+		INFO("Codepoint " << codepoint);
+		REQUIRE((expected == nullptr) == (actual == nullptr));
+		if (!expected)
+		{
+			return;
+		}
+
+		CHECK(actual->GetAdvance(1.0f) == expected->GetAdvance(1.0f));
+		REQUIRE(actual->GetImage());
+		CHECK(actual->GetImage()->GetWidth() == expected->GetImage()->GetWidth());
+		CHECK(actual->GetImage()->GetHeight() == expected->GetImage()->GetHeight());
+		CHECK(actual->GetImage()->GetOffsetX() == expected->GetImage()->GetOffsetX());
+		CHECK(actual->GetImage()->GetOffsetY() == expected->GetImage()->GetOffsetY());
+
+		std::vector<uint32> expectedPixels, actualPixels;
+		const bool expectedOnAtlas = expectedFont.GetAtlas().CopyPixels(*expected->GetImage(), expectedPixels);
+		const bool actualOnAtlas = actualFont.GetAtlas().CopyPixels(*actual->GetImage(), actualPixels);
+		REQUIRE(actualOnAtlas == expectedOnAtlas);
+		CHECK(actualPixels == expectedPixels);
+	}
+}
+
+TEST_CASE("Lazily rasterized glyphs match eager rasterization", "[font]")
+{
+	FontTestEnvironment environment;
+
+	const float outline = GENERATE(0.0f, 2.0f);
+
+	// All glyphs rasterized up front onto one big page
+	Font eager(2048, 1);
+	REQUIRE(eager.Initialize("test.ttf", 16.0f, outline));
+	eager.PreloadGlyphs(FirstCodepoint, LastCodepoint);
+	CHECK(eager.GetAtlas().GetEvictionCount() == 0);
+
+	// Glyphs rasterized on use onto small pages, which have to be reused all the time
+	Font lazy(128, 2);
+	REQUIRE(lazy.Initialize("test.ttf", 16.0f, outline));
+	CHECK(lazy.GetAtlas().GetPageCount() == 0);
+
+	std::vector<uint32> codepoints(LastCodepoint - FirstCodepoint + 1);
+	std::iota(codepoints.begin(), codepoints.end(), FirstCodepoint);
+
+	std::mt19937 generator(3);
+	for (int round = 0; round < 3; ++round)
+	{
+		std::shuffle(codepoints.begin(), codepoints.end(), generator);
+		for (const uint32 codepoint : codepoints)
+		{
+			CheckGlyphsMatch(codepoint, eager, eager.GetGlyphData(codepoint), lazy, lazy.GetGlyphData(codepoint));
+		}
+	}
+
+	CHECK(lazy.GetAtlas().GetPageCount() == 2);
+	CHECK(lazy.GetAtlas().GetEvictionCount() > 0);
+
+	// Measuring text does not depend on how glyphs are rasterized
+	const std::string text = "The quick brown fox jumps over the lazy dog.\n\tThen it rests.";
+	CHECK(lazy.GetTextWidth(text) == eager.GetTextWidth(text));
+}
+
+TEST_CASE("Glyph cache restores rasterized glyphs", "[font]")
+{
+	FontTestEnvironment environment;
+
+	const float outline = GENERATE(0.0f, 1.0f);
+
+	Font rasterized;
+	REQUIRE(rasterized.Initialize("test.ttf", 12.0f, outline));
+	rasterized.EnableGlyphCache("Cache/Fonts");
+	rasterized.PreloadGlyphs(FirstCodepoint, LastCodepoint);
+	rasterized.SaveGlyphCache();
+
+	// A font of another size must not use the cache file
+	Font otherSize;
+	REQUIRE(otherSize.Initialize("test.ttf", 14.0f, outline));
+	otherSize.EnableGlyphCache("Cache/Fonts");
+
+	Font cached;
+	REQUIRE(cached.Initialize("test.ttf", 12.0f, outline));
+	cached.EnableGlyphCache("Cache/Fonts");
+	for (uint32 codepoint = LastCodepoint; codepoint >= FirstCodepoint; --codepoint)
+	{
+		CheckGlyphsMatch(codepoint, rasterized, rasterized.GetGlyphData(codepoint), cached, cached.GetGlyphData(codepoint));
+	}
+
+	const FontGlyph* glyph = otherSize.GetGlyphData('W');
+	REQUIRE(glyph);
+	CHECK(glyph->GetImage()->GetHeight() > rasterized.GetGlyphData('W')->GetImage()->GetHeight());
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "catch.hpp"
 
 #include "game_server/game_unit_s.h"
+#include "binary_io/vector_sink.h"
 #include "proto_data/project.h"
 
 #include <memory>
@@ -178,3 +179,37 @@ TEST_CASE("IsFacingTowards returns false if target location is in side of unit w
 	REQUIRE(!unit->IsFacingTowards(Vector3(0.0f, 0.0f, 1.0f)));
 	REQUIRE(!unit->IsFacingTowards(Vector3(0.0f, 0.0f, -1.0f)));
 }
+
+TEST_CASE("Update blocks written into reserved sections match regular update blocks", "[game_unit_s]")
+{
+	asio::io_service io{};
+	TimerQueue timers{ io };
+	proto::Project project{};
+	std::shared_ptr<GameUnitS> unit = std::make_shared<GameUnitS>(project, timers);
+	unit->Initialize();
+	unit->Set<uint64>(object_fields::Guid, 0xF130000000000F01);
+	unit->ClearFieldChanges();
+
+	unit->Set<uint32>(object_fields::Entry, 12);
+	unit->Set<float>(object_fields::Scale, 2.0f);
+
+	std::vector<char> expected;
+	{
+		io::VectorSink sink{ expected };
+		io::Writer writer{ sink };
+		unit->WriteObjectUpdateBlock(writer, false);
+	}
+
+	REQUIRE(unit->GetChangesUpdateBlockSize() == expected.size());
+
+	std::vector<char> actual;
+	io::VectorSink sink{ actual };
+	io::BasicWriter writer{ sink };
+	io::SectionSink section = writer.ReserveSection(unit->GetChangesUpdateBlockSize());
+	io::BasicWriter sectionWriter{ section };
+	unit->WriteObjectUpdateBlock(sectionWriter);
+
+	CHECK(static_cast<bool>(sectionWriter));
+	CHECK(section.Position() == section.Size());
+	CHECK(actual == expected);
+}
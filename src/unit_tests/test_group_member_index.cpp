@@ -0,0 +1,224 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "game_server/game_player_s.h"
+#include "game_server/group_member_index.h"
+#include "game_server/quest_status_data.h"
+#include "game_server/tiled_unit_finder.h"
+#include "game_server/tiled_unit_finder_tile.h"
+#include "proto_data/project.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+
+using namespace mmo;
+
+namespace
+{
+	constexpr float NearbyMemberRadius = 100.0f;
+
+	/// Players spread over an area, some of them in groups, registered in a unit finder and a group member index.
+	struct GroupedPlayers
+	{
+		proto::Project project;
+		asio::io_service io;
+		TimerQueue timers { io };
+		TiledUnitFinder finder { 33.3333f };
+		GroupMemberIndex index;
+		std::vector<std::shared_ptr<GamePlayerS>> players;
+
+		GroupedPlayers(std::mt19937& generator, const uint32 playerCount, const float areaSize, const uint32 groupCount)
+		{
+			std::uniform_real_distribution<float> coordinate(-areaSize * 0.5f, areaSize * 0.5f);
+			std::uniform_int_distribution<uint32> group(0, groupCount * 2);
+
+			for (uint32 i = 0; i < playerCount; ++i)
+			{
+				auto player = std::make_shared<GamePlayerS>(project, timers);
+				player->Initialize();
+				player->Set<uint64>(object_fields::Guid, i + 1);
+				player->Relocate(Vector3(coordinate(generator), coordinate(generator), coordinate(generator)), Radian(0.0f));
+
+				// About half of the players are not in a group
+				const uint32 groupId = group(generator);
+				player->SetGroupId(groupId > groupCount ? 0 : groupId);
+
+				finder.AddUnit(*player);
+				index.AddMember(player->GetGroupId(), *player);
+				players.push_back(std::move(player));
+			}
+		}
+
+		void Move(GamePlayerS& player, const Vector3& position)
+		{
+			const Vector3 previousPosition = player.GetPosition();
+			player.Relocate(position, Radian(0.0f));
+			finder.UpdatePosition(player, previousPosition);
+		}
+	};
+
+	/// The nearby group member lookup which searches all units around a character.
+	std::vector<uint64> FindNearbyMembersByArea(UnitFinder& finder, GamePlayerS& character)
+	{
+		const Vector3 location(character.GetPosition());
+		const uint64 groupId = character.GetGroupId();
+		std::vector<uint64> nearbyMembers;
+
+		finder.FindUnits(Circle(location.x, location.y, NearbyMemberRadius), [&character, groupId, &nearbyMembers](GameUnitS& unit) -> bool
+			{
+				if (!unit.IsPlayer())
+				{
+					return true;
+				}
+
+				const GamePlayerS& other = static_cast<GamePlayerS&>(unit);
+				if (other.GetGroupId() == groupId && other.GetGuid() != character.GetGuid())
+				{
+					nearbyMembers.push_back(other.GetGuid());
+				}
+
+				return true;
+			});
+
+		return nearbyMembers;
+	}
+
+	std::vector<uint64> FindNearbyMembersByGroup(const GroupMemberIndex& index, const GamePlayerS& character)
+	{
+		std::vector<uint64> nearbyMembers;
+		index.FindNearbyMembers(character, NearbyMemberRadius, nearbyMembers);
+		return nearbyMembers;
+	}
+
+	void CheckNearbyMembersMatch(GroupedPlayers& world)
+	{
+		for (const auto& player : world.players)
+		{
+			if (player->GetGroupId() == 0)
+			{
+				continue;
+			}
+
+			auto expected = FindNearbyMembersByArea(world.finder, *player);
+			auto actual = FindNearbyMembersByGroup(world.index, *player);
+			std::sort(expected.begin(), expected.end());
+			std::sort(actual.begin(), actual.end());
+
+			INFO("Character " << player->GetGuid());
+			REQUIRE(actual == expected);
+		}
+	}
+}
+
+TEST_CASE("Group member index tracks members per group", "[group_member_index]")
+{
+	proto::Project project;
+	asio::io_service io;
+	TimerQueue timers { io };
+
+	auto first = std::make_shared<GamePlayerS>(project, timers);
+	auto second = std::make_shared<GamePlayerS>(project, timers);
+	first->Initialize();
+	second->Initialize();
+
+	GroupMemberIndex index;
+	index.AddMember(0, *first);
+	CHECK(index.GetGroupCount() == 0);
+
+	first->SetGroupId(5);
+	index.AddMember(first->GetGroupId(), *first);
+	second->SetGroupId(5);
+	index.AddMember(second->GetGroupId(), *second);
+	REQUIRE(index.GetMembers(5).size() == 2);
+
+	second->SetGroupId(7);
+	index.UpdateMember(*second, 5);
+	REQUIRE(index.GetMembers(5).size() == 1);
+	CHECK(index.GetMembers(5)[0] == first.get());
+	REQUIRE(index.GetMembers(7).size() == 1);
+	CHECK(index.GetMembers(7)[0] == second.get());
+
+	second->SetGroupId(0);
+	index.UpdateMember(*second, 7);
+	CHECK(index.GetMembers(7).empty());
+	CHECK(index.GetGroupCount() == 1);
+
+	index.RemoveMember(first->GetGroupId(), *first);
+	CHECK(index.GetGroupCount() == 0);
+}
+
+TEST_CASE("Nearby group members match an area search", "[group_member_index]")
+{
+	std::mt19937 generator(GENERATE(1u, 2u, 3u));
+	GroupedPlayers world(generator, 400, 600.0f, 30);
+
+	CheckNearbyMembersMatch(world);
+
+	// Characters move around and change groups
+	std::uniform_int_distribution<size_t> player(0, world.players.size() - 1);
+	std::uniform_real_distribution<float> step(-60.0f, 60.0f);
+	std::uniform_int_distribution<uint32> group(0, 30);
+	for (int round = 0; round < 10; ++round)
+	{
+		for (int i = 0; i < 100; ++i)
+		{
+			GamePlayerS& character = *world.players[player(generator)];
+			world.Move(character, character.GetPosition() + Vector3(step(generator), step(generator), step(generator)));
+		}
+
+		for (int i = 0; i < 20; ++i)
+		{
+			GamePlayerS& character = *world.players[player(generator)];
+			const uint64 previousGroupId = character.GetGroupId();
+			character.SetGroupId(group(generator));
+			world.index.UpdateMember(character, previousGroupId);
+		}
+
+		CheckNearbyMembersMatch(world);
+	}
+}
+
+TEST_CASE("Nearby group member update throughput", "[group_member_index][!benchmark]")
+{
+	std::mt19937 generator(7);
+
+	// A crowded instance: most characters are grouped in groups of about five characters
+	constexpr uint32 PlayerCount = 4000;
+	GroupedPlayers world(generator, PlayerCount, 1500.0f, PlayerCount / 10);
+
+	std::vector<GamePlayerS*> grouped;
+	for (const auto& player : world.players)
+	{
+		if (player->GetGroupId() != 0)
+		{
+			grouped.push_back(player.get());
+		}
+	}
+
+	using Clock = std::chrono::steady_clock;
+	size_t checksum = 0;
+
+	auto start = Clock::now();
+	for (GamePlayerS* player : grouped)
+	{
+		checksum += FindNearbyMembersByArea(world.finder, *player).size();
+	}
+	const double areaSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	start = Clock::now();
+	for (GamePlayerS* player : grouped)
+	{
+		checksum -= FindNearbyMembersByGroup(world.index, *player).size();
+	}
+	const double groupSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	CHECK(checksum == 0);
+
+	std::cout << "Nearby group member updates for " << grouped.size() << " of " << PlayerCount << " characters in one instance:" << std::endl;
+	std::cout << "\tArea search:  " << areaSeconds * 1000.0 << " ms" << std::endl;
+	std::cout << "\tGroup roster: " << groupSeconds * 1000.0 << " ms" << std::endl;
+}
@@ -0,0 +1,157 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#if MMO_BUILD_CLIENT
+
+#include "catch.hpp"
+
+#include "graphics/graphics_device.h"
+#include "graphics/material.h"
+#include "graphics/vertex_index_data.h"
+#include "scene_graph/render_operation.h"
+#include "scene_graph/render_queue.h"
+#include "scene_graph/renderable.h"
+
+#include <memory>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Creates the null graphics device for the lifetime of a test and destroys it again afterwards.
+	class NullDeviceScope final
+	{
+	public:
+		NullDeviceScope()
+			: m_device(GraphicsDevice::CreateNull({}))
+		{
+		}
+
+		~NullDeviceScope()
+		{
+			GraphicsDevice::Destroy();
+		}
+
+		[[nodiscard]] GraphicsDevice& GetDevice() const { return m_device; }
+
+	private:
+		GraphicsDevice& m_device;
+	};
+
+	/// Renders the instances of an operation in a frame of their own and returns the number of batches of that frame.
+	uint64 CountInstancedBatches(GraphicsDevice& device, const RenderOperation& operation, const std::vector<Matrix4>& worldTransforms)
+	{
+		device.Reset();
+		device.RenderInstanced(operation, worldTransforms);
+		device.Reset();
+
+		return device.GetBatchCount();
+	}
+
+	/// Renderable without render callbacks which can be merged into instanced draws.
+	class TestRenderable : public Renderable
+	{
+	public:
+		void PrepareRenderOperation(RenderOperation& operation) override
+		{
+		}
+
+		[[nodiscard]] const Matrix4& GetWorldTransform() const override { return Matrix4::Identity; }
+
+		[[nodiscard]] float GetSquaredViewDepth(const Camera& camera) const override { return 0.0f; }
+
+		[[nodiscard]] MaterialPtr GetMaterial() const override { return nullptr; }
+
+		[[nodiscard]] bool CanBeInstanced() const override { return true; }
+	};
+
+	/// Renderable which changes device state for the duration of its own draw and thus can't be instanced.
+	class CallbackRenderable final : public TestRenderable
+	{
+	public:
+		bool PreRender(Scene& scene, GraphicsDevice& graphicsDevice) override
+		{
+			graphicsDevice.SetFillMode(FillMode::Wireframe);
+			return true;
+		}
+
+		void PostRender(Scene& scene, GraphicsDevice& graphicsDevice) override
+		{
+			graphicsDevice.SetFillMode(FillMode::Solid);
+		}
+
+		[[nodiscard]] bool CanBeInstanced() const override { return false; }
+	};
+}
+
+TEST_CASE("Instanced draws count the batches the d3d11 device issues", "[graphics]")
+{
+	const NullDeviceScope scope;
+	GraphicsDevice& device = scope.GetDevice();
+
+	VertexData vertexData(&device);
+	vertexData.vertexDeclaration->AddElement(0, 0, VertexElementType::Float3, VertexElementSemantic::Position, 0);
+	vertexData.vertexCount = 3;
+
+	std::vector<uint8> shaderCode { 1, 2, 3, 4 };
+	const auto material = std::make_shared<Material>("Instanced");
+	material->SetVertexShaderCode(VertexShaderType::Default, shaderCode);
+	material->SetVertexShaderCode(VertexShaderType::SkinnedHigh, shaderCode);
+
+	RenderOperation operation;
+	operation.vertexData = &vertexData;
+	operation.material = material;
+
+	const std::vector<Matrix4> worldTransforms(100, Matrix4::Identity);
+
+	SECTION("Materials with an instanced vertex shader render all instances with one draw")
+	{
+		material->SetVertexShaderCode(VertexShaderType::Instanced, shaderCode);
+		material->Update();
+
+		CHECK(GraphicsDevice::CanDrawInstanced(operation));
+		CHECK(CountInstancedBatches(device, operation, worldTransforms) == 1);
+	}
+
+	SECTION("Materials without an instanced vertex shader render one draw per instance")
+	{
+		material->Update();
+
+		CHECK_FALSE(GraphicsDevice::CanDrawInstanced(operation));
+		CHECK(CountInstancedBatches(device, operation, worldTransforms) == worldTransforms.size());
+	}
+
+	SECTION("Skinned vertex data renders one draw per instance")
+	{
+		material->SetVertexShaderCode(VertexShaderType::Instanced, shaderCode);
+		material->Update();
+		vertexData.vertexDeclaration->AddElement(0, 12, VertexElementType::UByte4, VertexElementSemantic::BlendIndices, 0);
+
+		CHECK_FALSE(GraphicsDevice::CanDrawInstanced(operation));
+		CHECK(CountInstancedBatches(device, operation, worldTransforms) == worldTransforms.size());
+	}
+}
+
+TEST_CASE("Renderables with render callbacks aren't merged into instanced draws", "[graphics]")
+{
+	const NullDeviceScope scope;
+
+	VertexData vertexData(&scope.GetDevice());
+	vertexData.vertexCount = 3;
+
+	TestRenderable instanced, otherInstanced;
+	CallbackRenderable withCallbacks;
+
+	QueuedRenderableCollection::Entry first { 0, &instanced };
+	first.operation.vertexData = &vertexData;
+	QueuedRenderableCollection::Entry second = first;
+	second.renderable = &otherInstanced;
+	QueuedRenderableCollection::Entry third = first;
+	third.renderable = &withCallbacks;
+
+	CHECK(QueuedRenderableCollection::CanShareInstancedDraw(first, second));
+	CHECK_FALSE(QueuedRenderableCollection::CanShareInstancedDraw(first, third));
+	CHECK_FALSE(QueuedRenderableCollection::CanShareInstancedDraw(third, first));
+}
+
+#endif
@@ -0,0 +1,131 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/database_metrics.h"
+#include "base/metrics.h"
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace mmo;
+
+
+TEST_CASE("Counter sums increments of all threads", "[metrics]")
+{
+	MetricCounter counter;
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back([&counter]()
+		{
+			for (int j = 0; j < 1000; ++j)
+			{
+				counter.Increment();
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	CHECK(counter.GetValue() == 4000);
+}
+
+TEST_CASE("Histogram counts values in inclusive buckets", "[metrics]")
+{
+	MetricHistogram histogram({ 1.0, 2.0 });
+	histogram.Observe(0.5);
+	histogram.Observe(1.0);
+	histogram.Observe(1.5);
+	histogram.Observe(10.0);
+
+	const auto counts = histogram.GetBucketCounts();
+	REQUIRE(counts.size() == 3);
+	CHECK(counts[0] == 2);
+	CHECK(counts[1] == 1);
+	CHECK(counts[2] == 1);
+	CHECK(histogram.GetSum() == Approx(13.0));
+}
+
+TEST_CASE("Counter array counts out of range indices separately", "[metrics]")
+{
+	MetricCounterArray counters(4);
+	counters.Increment(1);
+	counters.Increment(4);
+	counters.Increment(100, 2);
+
+	CHECK(counters.GetValue(0) == 0);
+	CHECK(counters.GetValue(1) == 1);
+	CHECK(counters.GetValue(3) == 0);
+	CHECK(counters.GetOtherValue() == 3);
+}
+
+TEST_CASE("Registry returns the same metric for the same name and labels", "[metrics]")
+{
+	MetricCounter& first = MetricsRegistry::Get().AddCounter("test_registry_reuse_total", "Test counter.", "kind=\"a\"");
+	MetricCounter& second = MetricsRegistry::Get().AddCounter("test_registry_reuse_total", "Test counter.", "kind=\"a\"");
+	MetricCounter& other = MetricsRegistry::Get().AddCounter("test_registry_reuse_total", "Test counter.", "kind=\"b\"");
+
+	CHECK(&first == &second);
+	CHECK(&first != &other);
+}
+
+TEST_CASE("Registry writes the text exposition format", "[metrics]")
+{
+	MetricsRegistry::Get().AddGauge("test_exposition_gauge", "Test gauge.").Set(-3);
+	MetricsRegistry::Get().AddHistogram("test_exposition_seconds", "Test histogram.", { 0.5 }).Observe(0.25);
+	MetricsRegistry::Get().AddCounterArray("test_exposition_total", "Test counters.", "opcode", 8, "protocol=\"test\"").Increment(5, 2);
+	MetricsRegistry::Get().AddCounterArray("test_exposition_total", "Test counters.", "opcode", 8, "protocol=\"test\"").Increment(8);
+
+	std::ostringstream strm;
+	MetricsRegistry::Get().WriteText(strm);
+	const std::string text = strm.str();
+
+	CHECK(text.find("# TYPE test_exposition_gauge gauge\ntest_exposition_gauge -3\n") != std::string::npos);
+	CHECK(text.find("test_exposition_seconds_bucket{le=\"0.5\"} 1\n") != std::string::npos);
+	CHECK(text.find("test_exposition_seconds_bucket{le=\"+Inf\"} 1\n") != std::string::npos);
+	CHECK(text.find("test_exposition_seconds_count 1\n") != std::string::npos);
+	CHECK(text.find("test_exposition_total{protocol=\"test\",opcode=\"5\"} 2\n") != std::string::npos);
+	CHECK(text.find("test_exposition_total{protocol=\"test\",opcode=\"0\"}") == std::string::npos);
+	CHECK(text.find("test_exposition_total{protocol=\"test\",opcode=\"other\"} 1\n") != std::string::npos);
+}
+
+TEST_CASE("Database requests are measured until they have been executed", "[metrics]")
+{
+	std::vector<std::function<void()>> queued;
+	const DatabaseActionDispatcher dispatcher = MeasureDatabaseRequests([&queued](const std::function<void()>& action) { queued.push_back(action); });
+
+	const MetricGauge& queueDepth = MetricsRegistry::Get().AddGauge("mmo_db_queue_depth", "");
+	const MetricHistogram& latency = MetricsRegistry::Get().AddHistogram("mmo_db_request_duration_seconds", "");
+	const int64 initialDepth = queueDepth.GetValue();
+	const auto countObservations = [&latency]()
+	{
+		uint64 count = 0;
+		for (const uint64 bucket : latency.GetBucketCounts())
+		{
+			count += bucket;
+		}
+		return count;
+	};
+	const uint64 initialObservations = countObservations();
+
+	int executed = 0;
+	dispatcher([&executed]() { ++executed; });
+	dispatcher([&executed]() { ++executed; });
+	CHECK(queueDepth.GetValue() == initialDepth + 2);
+	CHECK(executed == 0);
+
+	for (const auto& action : queued)
+	{
+		action();
+	}
+
+	CHECK(executed == 2);
+	CHECK(queueDepth.GetValue() == initialDepth);
+	CHECK(countObservations() == initialObservations + 2);
+}
@@ -0,0 +1,232 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "binary_io/vector_sink.h"
+#include "binary_io/writer.h"
+#include "game_server/movement_relay.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// A simulated player which runs around and turns every now and then, sending movement packets like the client.
+	struct SimulatedPlayer
+	{
+		uint64 guid = 0;
+		MovementInfo info;
+		GameTime nextHeartbeat = 0;
+		GameTime turnEnd = 0;
+		std::unique_ptr<MovementRelay> relay;
+	};
+
+	constexpr float RunSpeed = 7.0f;
+	constexpr float TurnRate = 3.14159f;
+
+	size_t GetPacketSize(const MovementInfo& info)
+	{
+		std::vector<char> buffer;
+		io::VectorSink sink { buffer };
+		io::Writer writer { sink };
+
+		// Op code, size and guid of the movement packet
+		writer << io::write<uint16>(0) << io::write<uint32>(0) << io::write<uint64>(0) << info;
+		return buffer.size();
+	}
+
+	float GetDistance(const Vector3& a, const Vector3& b)
+	{
+		return (a - b).GetLength();
+	}
+}
+
+TEST_CASE("Movement relay sends state changes and nearby updates at full rate", "[movement_relay]")
+{
+	MovementRelaySettings settings;
+	MovementRelay relay { settings };
+
+	MovementInfo info;
+	info.movementFlags = movement_flags::Forward;
+	info.timestamp = 1000;
+
+	constexpr uint64 NearWatcher = 1, FarWatcher = 2, RelatedWatcher = 3;
+	const float farDistance = settings.reducedRateDistance + 10.0f;
+
+	// The first packet goes out to everybody
+	relay.BeginPacket(info, RunSpeed, true);
+	CHECK(relay.ShouldRelayTo(NearWatcher, 5.0f, false));
+	CHECK(relay.ShouldRelayTo(FarWatcher, farDistance, false));
+	CHECK(relay.ShouldRelayTo(RelatedWatcher, farDistance, true));
+
+	// A heartbeat matching the extrapolated movement is skipped for distant watchers only
+	info.timestamp += 500;
+	info.position = MovementRelay::ExtrapolatePosition(info, RunSpeed, 500);
+	relay.BeginPacket(info, RunSpeed, false);
+	CHECK(relay.ShouldRelayTo(NearWatcher, 5.0f, false));
+	CHECK_FALSE(relay.ShouldRelayTo(FarWatcher, farDistance, false));
+	CHECK(relay.ShouldRelayTo(RelatedWatcher, farDistance, true));
+
+	// A heartbeat which is off by more than the error bound is relayed
+	info.timestamp += 100;
+	info.position.x += settings.maxPositionError * 2.0f;
+	relay.BeginPacket(info, RunSpeed, false);
+	CHECK(relay.ShouldRelayTo(FarWatcher, farDistance, false));
+
+	// Stopping is always relayed
+	info.timestamp += 50;
+	info.movementFlags = movement_flags::None;
+	relay.BeginPacket(info, RunSpeed, true);
+	CHECK(relay.ShouldRelayTo(FarWatcher, farDistance, false));
+
+	// Heartbeats are relayed after the interval of the distance tier has passed
+	info.timestamp += settings.distantInterval;
+	relay.BeginPacket(info, RunSpeed, false);
+	CHECK(relay.ShouldRelayTo(FarWatcher, farDistance, false));
+}
+
+TEST_CASE("Movement relay extrapolates along the facing", "[movement_relay]")
+{
+	MovementInfo info;
+	info.movementFlags = movement_flags::Forward;
+	info.facing = Radian(0.0f);
+	CHECK(MovementRelay::ExtrapolatePosition(info, 10.0f, 1000).IsNearlyEqual(Vector3(10.0f, 0.0f, 0.0f)));
+
+	info.movementFlags = movement_flags::StrafeRight;
+	CHECK(MovementRelay::ExtrapolatePosition(info, 10.0f, 500).IsNearlyEqual(Vector3(0.0f, 0.0f, 5.0f)));
+
+	info.movementFlags = movement_flags::Backward;
+	info.facing = Radian(3.14159265f * 0.5f);
+	CHECK(MovementRelay::ExtrapolatePosition(info, 4.0f, 1000).IsNearlyEqual(Vector3(0.0f, 0.0f, 4.0f), 0.001f));
+
+	info.movementFlags = movement_flags::Forward | movement_flags::Rooted;
+	CHECK(MovementRelay::ExtrapolatePosition(info, 4.0f, 1000).IsNearlyEqual(Vector3::Zero));
+}
+
+TEST_CASE("Movement relay reduces traffic of crowded tiles within the error bound", "[movement_relay]")
+{
+	MovementRelaySettings settings;
+	settings.maxPositionError = GENERATE(1.0f, 3.0f);
+
+	constexpr size_t PlayerCount = 300;
+	constexpr float AreaSize = 120.0f;
+	constexpr GameTime TickInterval = 100;
+	constexpr GameTime SimulatedTime = 10000;
+	constexpr GameTime HeartbeatInterval = 500;
+
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> position(0.0f, AreaSize);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	std::uniform_int_distribution<int> chance(0, 99);
+
+	std::vector<SimulatedPlayer> players(PlayerCount);
+	for (size_t i = 0; i < players.size(); ++i)
+	{
+		players[i].guid = i + 1;
+		players[i].info.position = Vector3(position(generator), 0.0f, position(generator));
+		players[i].info.facing = Radian(angle(generator));
+		players[i].relay = std::make_unique<MovementRelay>(settings);
+	}
+
+	// What every watcher knows about every other player: the last movement info it received
+	std::vector<MovementInfo> known(PlayerCount * PlayerCount);
+
+	size_t fullRateBytes = 0;
+	size_t relayedBytes = 0;
+	float maxObservedError = 0.0f;
+	bool missedStateChange = false;
+
+	const auto sendPacket = [&](SimulatedPlayer& sender, const bool isStateChange)
+	{
+		const size_t packetSize = GetPacketSize(sender.info);
+		sender.relay->BeginPacket(sender.info, RunSpeed, isStateChange);
+
+		for (const auto& watcher : players)
+		{
+			if (watcher.guid == sender.guid)
+			{
+				continue;
+			}
+
+			fullRateBytes += packetSize;
+
+			auto& knownInfo = known[(watcher.guid - 1) * PlayerCount + sender.guid - 1];
+			if (sender.relay->ShouldRelayTo(watcher.guid, GetDistance(watcher.info.position, sender.info.position), false))
+			{
+				relayedBytes += packetSize;
+				knownInfo = sender.info;
+				continue;
+			}
+
+			missedStateChange |= isStateChange;
+
+			// The watcher did not receive this packet, so it still extrapolates from the last one it got
+			const Vector3 extrapolated = MovementRelay::ExtrapolatePosition(knownInfo, RunSpeed, sender.info.timestamp - knownInfo.timestamp);
+			maxObservedError = std::max(maxObservedError, GetDistance(extrapolated, sender.info.position));
+		}
+	};
+
+	for (auto& player : players)
+	{
+		player.info.timestamp = 1;
+		player.info.movementFlags = movement_flags::Forward;
+		player.nextHeartbeat = player.info.timestamp + HeartbeatInterval;
+		sendPacket(player, true);
+	}
+
+	for (GameTime now = 1 + TickInterval; now <= SimulatedTime; now += TickInterval)
+	{
+		for (auto& player : players)
+		{
+			MovementInfo& info = player.info;
+
+			// Move along the current facing, turning if the player currently turns
+			const float seconds = static_cast<float>(TickInterval) / 1000.0f;
+			info.position = MovementRelay::ExtrapolatePosition(info, RunSpeed, TickInterval);
+			if (info.IsTurning())
+			{
+				info.facing = Radian(info.facing.GetValueRadians() + TurnRate * seconds);
+			}
+			info.timestamp = now;
+
+			// Keep the players inside of the area
+			info.position.x = std::clamp(info.position.x, 0.0f, AreaSize);
+			info.position.z = std::clamp(info.position.z, 0.0f, AreaSize);
+
+			if (info.IsTurning() && now >= player.turnEnd)
+			{
+				info.movementFlags &= ~movement_flags::TurnLeft;
+				sendPacket(player, true);
+			}
+			else if (!info.IsTurning() && chance(generator) < 3)
+			{
+				info.movementFlags |= movement_flags::TurnLeft;
+				player.turnEnd = now + TickInterval * (1 + chance(generator) % 5);
+				sendPacket(player, true);
+			}
+			else if (now >= player.nextHeartbeat)
+			{
+				sendPacket(player, false);
+			}
+			else
+			{
+				continue;
+			}
+
+			player.nextHeartbeat = now + HeartbeatInterval;
+		}
+	}
+
+	INFO("Full rate: " << fullRateBytes << " bytes, relayed: " << relayedBytes << " bytes");
+
+	CHECK_FALSE(missedStateChange);
+	CHECK(maxObservedError <= settings.maxPositionError);
+
+	// Most watchers in a crowded area are far away from each other, so the bulk of the heartbeats is dropped
+	CHECK(relayedBytes < fullRateBytes * 3 / 4);
+}
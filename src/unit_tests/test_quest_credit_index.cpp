@@ -0,0 +1,401 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "game_server/game_item_s.h"
+#include "game_server/game_player_s.h"
+#include "game_server/quest_credit_index.h"
+#include "game_server/quest_status_data.h"
+#include "proto_data/project.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+
+using namespace mmo;
+
+namespace
+{
+	constexpr uint32 FirstCreatureId = 100;
+	constexpr uint32 CreatureCount = 12;
+	constexpr uint32 FirstItemId = 200;
+	constexpr uint32 ItemCount = 6;
+
+	/// A project with random kill quests.
+	struct QuestProject
+	{
+		proto::Project project;
+
+		explicit QuestProject(std::mt19937& generator, const uint32 questCount)
+		{
+			std::uniform_int_distribution<uint32> creature(FirstCreatureId, FirstCreatureId + CreatureCount - 1);
+			std::uniform_int_distribution<int> requirementCount(0, 4);
+			std::uniform_int_distribution<uint32> count(1, 4);
+
+			for (uint32 id = FirstCreatureId; id < FirstCreatureId + CreatureCount; ++id)
+			{
+				auto* unit = project.units.add(id);
+				unit->set_name("Creature");
+			}
+
+			for (uint32 id = 1; id <= questCount; ++id)
+			{
+				auto* quest = project.quests.add(id);
+				quest->set_name("Quest");
+
+				const int requirements = requirementCount(generator);
+				for (int i = 0; i < requirements; ++i)
+				{
+					auto* requirement = quest->add_requirements();
+					requirement->set_creatureid(creature(generator));
+					requirement->set_creaturecount(count(generator));
+				}
+			}
+		}
+	};
+
+	/// A project with random quests which need looted items, a quest starting source item or a creature.
+	struct ItemQuestProject
+	{
+		proto::Project project;
+
+		explicit ItemQuestProject(std::mt19937& generator, const uint32 questCount)
+		{
+			std::uniform_int_distribution<uint32> item(FirstItemId, FirstItemId + ItemCount - 1);
+			std::uniform_int_distribution<int> requirementCount(0, 4);
+			std::uniform_int_distribution<int> requirementType(0, 5);
+			std::uniform_int_distribution<uint32> count(1, 6);
+
+			for (uint32 id = FirstItemId; id < FirstItemId + ItemCount; ++id)
+			{
+				auto* entry = project.items.add(id);
+				entry->set_name("Item");
+				entry->set_maxstack(5);
+			}
+
+			for (uint32 id = 1; id <= questCount; ++id)
+			{
+				auto* quest = project.quests.add(id);
+				quest->set_name("Quest");
+
+				const int requirements = requirementCount(generator);
+				for (int i = 0; i < requirements; ++i)
+				{
+					auto* requirement = quest->add_requirements();
+					switch (requirementType(generator))
+					{
+					case 0:
+						requirement->set_creatureid(FirstCreatureId);
+						requirement->set_creaturecount(1);
+						break;
+					case 1:
+						requirement->set_sourceid(item(generator));
+						requirement->set_sourcecount(count(generator));
+						break;
+					default:
+						requirement->set_itemid(item(generator));
+						requirement->set_itemcount(count(generator));
+						break;
+					}
+				}
+			}
+		}
+	};
+
+	std::shared_ptr<GamePlayerS> CreatePlayer(const proto::Project& project, TimerQueue& timers, const uint32 questCount)
+	{
+		auto player = std::make_shared<GamePlayerS>(project, timers);
+		player->Initialize();
+
+		for (uint32 id = 1; id <= std::min(questCount, MaxQuestLogSize); ++id)
+		{
+			QuestStatusData data;
+			data.status = quest_status::Incomplete;
+			player->SetQuestData(id, data);
+		}
+
+		return player;
+	}
+
+	QuestField GetQuestField(const GamePlayerS& player, const uint32 slot)
+	{
+		return player.Get<QuestField>(object_fields::QuestLogSlot_1 + slot * (sizeof(QuestField) / sizeof(uint32)));
+	}
+
+	/// Reference for the kill credit: every requirement of every incomplete quest in the quest log which needs the
+	/// killed creature gets credit.
+	void ApplyReferenceKillCredit(const proto::Project& project, std::array<QuestField, MaxQuestLogSize>& questLog, const uint32 creatureId)
+	{
+		for (QuestField& field : questLog)
+		{
+			if (field.questId == 0 || field.status != quest_status::Incomplete)
+			{
+				continue;
+			}
+
+			const auto* quest = project.quests.getById(field.questId);
+			bool credited = false, fulfilled = true;
+			for (int i = 0; i < quest->requirements_size(); ++i)
+			{
+				const auto& req = quest->requirements(i);
+				if (req.creatureid() == creatureId && field.counters[i] < req.creaturecount())
+				{
+					field.counters[i]++;
+					credited = true;
+				}
+
+				fulfilled &= req.creatureid() == 0 || field.counters[i] >= req.creaturecount();
+			}
+
+			// Quests are only checked for completion when they received credit
+			if (credited && fulfilled)
+			{
+				field.status = quest_status::Complete;
+			}
+		}
+	}
+
+	/// Reference for the item credit: every incomplete quest in the quest log with a requirement of the changed item
+	/// is checked. A quest gets completed if enough items were added and every requirement is fulfilled, and
+	/// reverted to incomplete if items were removed and a requirement isn't fulfilled anymore.
+	void ApplyReferenceItemCredit(const proto::Project& project, std::array<QuestField, MaxQuestLogSize>& questLog, const Inventory& inventory, const uint32 itemId, const bool added)
+	{
+		const uint32 itemCount = inventory.GetItemCount(itemId);
+
+		for (QuestField& field : questLog)
+		{
+			if (field.questId == 0 || field.status != quest_status::Incomplete)
+			{
+				continue;
+			}
+
+			const auto* quest = project.quests.getById(field.questId);
+			bool validate = false, fulfilled = true;
+			for (int i = 0; i < quest->requirements_size(); ++i)
+			{
+				const auto& req = quest->requirements(i);
+				if (req.itemid() == itemId)
+				{
+					validate |= added == (itemCount >= req.itemcount());
+				}
+				else if (req.sourceid() == itemId)
+				{
+					validate |= added == (itemCount >= req.sourcecount());
+				}
+
+				fulfilled &= req.creatureid() == 0 || field.counters[i] >= req.creaturecount();
+				fulfilled &= req.itemid() == 0 || inventory.GetItemCount(req.itemid()) >= req.itemcount();
+			}
+
+			if (validate && fulfilled == added)
+			{
+				field.status = added ? quest_status::Complete : quest_status::Incomplete;
+			}
+		}
+	}
+
+	void CheckQuestLog(const GamePlayerS& player, const std::array<QuestField, MaxQuestLogSize>& expected)
+	{
+		for (uint32 slot = 0; slot < MaxQuestLogSize; ++slot)
+		{
+			const QuestField field = GetQuestField(player, slot);
+			REQUIRE(field.questId == expected[slot].questId);
+			REQUIRE(field.counterField == expected[slot].counterField);
+			REQUIRE(field.status == expected[slot].status);
+
+			if (field.questId != 0)
+			{
+				REQUIRE(player.GetQuestStatus(field.questId) == field.status);
+			}
+		}
+	}
+}
+
+TEST_CASE("Quest credit index lists requirements by slot and requirement", "[quest_credit_index]")
+{
+	proto::Project project;
+
+	auto* first = project.quests.add(1);
+	first->add_requirements()->set_creatureid(10);
+	first->add_requirements()->set_itemid(20);
+	auto* sourceRequirement = first->add_requirements();
+	sourceRequirement->set_itemid(21);
+	sourceRequirement->set_sourceid(21);
+
+	auto* second = project.quests.add(2);
+	second->add_requirements()->set_objectid(30);
+	second->mutable_requirements(0)->set_spellcast(40);
+	second->add_requirements()->set_creatureid(10);
+
+	QuestCreditIndex index;
+	index.AddQuest(5, *second);
+	index.AddQuest(2, *first);
+
+	const auto creatures = index.Find(quest_credit_type::Creature, 10);
+	REQUIRE(creatures.size() == 2);
+	CHECK(creatures[0].logSlot == 2);
+	CHECK(creatures[0].requirementIndex == 0);
+	CHECK(creatures[1].logSlot == 5);
+	CHECK(creatures[1].requirementIndex == 1);
+
+	CHECK(index.Find(quest_credit_type::Item, 20).size() == 1);
+	CHECK(index.Find(quest_credit_type::Item, 21).size() == 1);
+	CHECK(index.Find(quest_credit_type::Creature, 20).empty());
+	CHECK(index.GetQuest(2) == first);
+
+	index.RemoveQuest(2);
+	CHECK(index.GetQuest(2) == nullptr);
+	CHECK(index.Find(quest_credit_type::Creature, 10).size() == 1);
+	CHECK(index.Find(quest_credit_type::Item, 20).empty());
+
+	// Adding a quest to an occupied slot replaces the old one
+	index.AddQuest(5, *first);
+	REQUIRE(index.Find(quest_credit_type::Creature, 10).size() == 1);
+	CHECK(index.Find(quest_credit_type::Creature, 10)[0].logSlot == 5);
+	CHECK(index.Find(quest_credit_type::Creature, 10)[0].requirementIndex == 0);
+
+	index.Clear();
+	CHECK(index.Find(quest_credit_type::Creature, 10).empty());
+}
+
+TEST_CASE("Quest kill credit matches a full quest log scan", "[quest_credit_index]")
+{
+	std::mt19937 generator(GENERATE(1u, 2u, 3u));
+	QuestProject questProject(generator, MaxQuestLogSize);
+	const proto::Project& project = questProject.project;
+
+	asio::io_service io;
+	TimerQueue timers { io };
+	auto player = CreatePlayer(project, timers, MaxQuestLogSize);
+
+	std::array<QuestField, MaxQuestLogSize> expected;
+	for (uint32 slot = 0; slot < MaxQuestLogSize; ++slot)
+	{
+		expected[slot] = GetQuestField(*player, slot);
+	}
+
+	// Abandoning a quest removes it from the index
+	REQUIRE(player->AbandonQuest(3));
+	expected[2] = QuestField();
+
+	std::uniform_int_distribution<uint32> creature(FirstCreatureId, FirstCreatureId + CreatureCount - 1);
+	for (int kill = 0; kill < 300; ++kill)
+	{
+		const uint32 creatureId = creature(generator);
+		player->OnQuestKillCredit(1, *project.units.getById(creatureId));
+		ApplyReferenceKillCredit(project, expected, creatureId);
+		CheckQuestLog(*player, expected);
+	}
+}
+
+TEST_CASE("Quest item credit matches a full quest log scan", "[quest_credit_index]")
+{
+	std::mt19937 generator(GENERATE(1u, 2u, 3u));
+	ItemQuestProject questProject(generator, MaxQuestLogSize);
+	const proto::Project& project = questProject.project;
+
+	asio::io_service io;
+	TimerQueue timers { io };
+	auto player = CreatePlayer(project, timers, MaxQuestLogSize);
+	Inventory& inventory = player->GetInventory();
+
+	std::array<QuestField, MaxQuestLogSize> expected;
+	for (uint32 slot = 0; slot < MaxQuestLogSize; ++slot)
+	{
+		expected[slot] = GetQuestField(*player, slot);
+	}
+
+	REQUIRE(player->AbandonQuest(5));
+	expected[4] = QuestField();
+
+	std::uniform_int_distribution<uint32> item(FirstItemId, FirstItemId + ItemCount - 1);
+	std::uniform_int_distribution<uint32> stacks(1, 5);
+	std::bernoulli_distribution loot(0.6);
+	uint64 nextItemGuid = 1;
+	for (int change = 0; change < 300; ++change)
+	{
+		const auto& entry = *project.items.getById(item(generator));
+		const uint16 itemCount = inventory.GetItemCount(entry.id());
+
+		if (itemCount == 0 || loot(generator))
+		{
+			// Looting creates items and credits quests like Inventory::CreateItems, which needs a world instance
+			auto looted = std::make_shared<GameItemS>(project, entry);
+			looted->Initialize();
+			looted->Set<uint64>(object_fields::Guid, CreateEntryGUID(nextItemGuid++, entry.id(), GuidType::Item));
+			looted->AddStacks(stacks(generator) - 1);
+			if (inventory.AddItem(looted) != inventory_change_failure::Okay)
+			{
+				continue;
+			}
+
+			player->OnQuestItemAddedCredit(entry, looted->GetStackCount());
+			ApplyReferenceItemCredit(project, expected, inventory, entry.id(), true);
+		}
+		else
+		{
+			// Removing whole stacks credits quests from the inventory
+			REQUIRE(inventory.RemoveItems(entry, std::uniform_int_distribution<uint16>(1, itemCount)(generator)) == inventory_change_failure::Okay);
+			ApplyReferenceItemCredit(project, expected, inventory, entry.id(), false);
+		}
+
+		CheckQuestLog(*player, expected);
+	}
+
+	// Some quests have to be completed by the items, or the comparison checks nothing
+	CHECK(std::count_if(expected.begin(), expected.end(), [](const QuestField& field) { return field.status == quest_status::Complete; }) > 0);
+}
+
+TEST_CASE("Quest kill credit throughput with a full quest log", "[quest_credit_index][!benchmark]")
+{
+	std::mt19937 generator(7);
+	QuestProject questProject(generator, MaxQuestLogSize);
+	proto::Project& project = questProject.project;
+
+	// Most creatures of an AoE pull are not needed by any quest
+	constexpr uint32 AoeCreatureCount = CreatureCount * 4;
+	for (uint32 id = FirstCreatureId + CreatureCount; id < FirstCreatureId + AoeCreatureCount; ++id)
+	{
+		project.units.add(id)->set_name("Creature");
+	}
+
+	constexpr uint32 KillCount = 200000;
+	std::uniform_int_distribution<uint32> creature(FirstCreatureId, FirstCreatureId + AoeCreatureCount - 1);
+	std::vector<const proto::UnitEntry*> kills;
+	for (uint32 i = 0; i < KillCount; ++i)
+	{
+		kills.push_back(project.units.getById(creature(generator)));
+	}
+
+	asio::io_service io;
+	TimerQueue timers { io };
+	auto player = CreatePlayer(project, timers, MaxQuestLogSize);
+
+	std::array<QuestField, MaxQuestLogSize> questLog;
+	for (uint32 slot = 0; slot < MaxQuestLogSize; ++slot)
+	{
+		questLog[slot] = GetQuestField(*player, slot);
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	auto start = Clock::now();
+	for (const auto* entry : kills)
+	{
+		ApplyReferenceKillCredit(project, questLog, entry->id());
+	}
+	const double scanSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	start = Clock::now();
+	for (const auto* entry : kills)
+	{
+		player->OnQuestKillCredit(1, *entry);
+	}
+	const double indexSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::cout << "Quest kill credit with " << MaxQuestLogSize << " quests:" << std::endl;
+	std::cout << "\tQuest log scan: " << KillCount / scanSeconds << " kills/s" << std::endl;
+	std::cout << "\tCredit index:   " << KillCount / indexSeconds << " kills/s" << std::endl;
+}
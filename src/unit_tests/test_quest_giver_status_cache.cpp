@@ -0,0 +1,190 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "game_server/game_creature_s.h"
+#include "game_server/game_player_s.h"
+#include "game_server/quest_giver_status_cache.h"
+#include "game_server/quest_status_data.h"
+#include "proto_data/project.h"
+
+#include <memory>
+#include <random>
+
+using namespace mmo;
+
+namespace
+{
+	constexpr uint32 QuestCount = 40;
+	constexpr uint32 QuestGiverCount = 12;
+	constexpr uint32 MaxLevel = 8;
+
+	/// A project with random quest chains, spread over a couple of quest givers.
+	struct QuestGiverProject
+	{
+		proto::Project project;
+
+		explicit QuestGiverProject(std::mt19937& generator)
+		{
+			auto* race = project.races.add(1);
+			race->set_name("Race");
+
+			auto* classEntry = project.classes.add(1);
+			classEntry->set_name("Class");
+			for (uint32 level = 1; level <= MaxLevel; ++level)
+			{
+				auto* values = classEntry->add_levelbasevalues();
+				values->set_health(100 * level);
+				values->set_mana(100 * level);
+				values->set_stamina(10);
+				values->set_strength(10);
+				values->set_agility(10);
+				values->set_intellect(10);
+				values->set_spirit(10);
+			}
+
+			std::uniform_int_distribution<uint32> minLevel(0, MaxLevel);
+			std::uniform_int_distribution<int> chance(0, 99);
+
+			for (uint32 id = 1; id <= QuestCount; ++id)
+			{
+				auto* quest = project.quests.add(id);
+				quest->set_name("Quest");
+				quest->set_minlevel(minLevel(generator));
+
+				if (id > 1 && chance(generator) < 30)
+				{
+					quest->set_prevquestid(std::uniform_int_distribution<uint32>(1, id - 1)(generator));
+				}
+
+				if (chance(generator) < 10)
+				{
+					// Not available for the race of the test character
+					quest->set_requiredraces(1 << 1);
+				}
+			}
+
+			std::uniform_int_distribution<uint32> quest(1, QuestCount);
+			std::uniform_int_distribution<int> questCount(0, 5);
+			for (uint32 id = 1; id <= QuestGiverCount; ++id)
+			{
+				auto* unit = project.units.add(id);
+				unit->set_name("Quest Giver");
+
+				for (int i = questCount(generator); i > 0; --i)
+				{
+					unit->add_quests(quest(generator));
+				}
+				for (int i = questCount(generator); i > 0; --i)
+				{
+					unit->add_end_quests(quest(generator));
+				}
+			}
+		}
+	};
+
+	void CheckStatusesMatch(const proto::Project& project, QuestGiverStatusCache& cache, const GamePlayerS& player)
+	{
+		for (uint32 id = 1; id <= QuestGiverCount; ++id)
+		{
+			const auto& entry = *project.units.getById(id);
+			const QuestgiverStatus expected = GameCreatureS::GetQuestGiverStatus(entry, player);
+
+			INFO("Quest giver " << id);
+			REQUIRE(cache.Get(entry, player) == expected);
+			REQUIRE(cache.Get(entry, player) == expected);
+		}
+	}
+}
+
+TEST_CASE("Cached quest giver statuses match uncached evaluation", "[quest_giver_status_cache]")
+{
+	std::mt19937 generator(GENERATE(1u, 2u, 3u, 4u));
+	QuestGiverProject questProject(generator);
+	const proto::Project& project = questProject.project;
+
+	asio::io_service io;
+	TimerQueue timers { io };
+	auto player = std::make_shared<GamePlayerS>(project, timers);
+	player->Initialize();
+	player->SetRace(*project.races.getById(1));
+	player->SetClass(*project.classes.getById(1));
+	player->SetLevel(1);
+
+	QuestGiverStatusCache cache;
+	CheckStatusesMatch(project, cache, *player);
+
+	std::uniform_int_distribution<uint32> quest(1, QuestCount);
+	std::uniform_int_distribution<uint32> level(1, MaxLevel);
+	std::uniform_int_distribution<int> action(0, 5);
+
+	for (int step = 0; step < 500; ++step)
+	{
+		const uint32 questId = quest(generator);
+
+		switch (action(generator))
+		{
+		case 0:
+		case 1:
+			player->AcceptQuest(questId);
+			break;
+		case 2:
+			player->AbandonQuest(questId);
+			break;
+		case 3:
+			player->SetLevel(level(generator));
+			break;
+		case 4:
+			if (player->GetQuestStatus(questId) == quest_status::Incomplete)
+			{
+				QuestStatusData data;
+				data.status = quest_status::Complete;
+				player->SetQuestData(questId, data);
+			}
+			break;
+		case 5:
+			if (player->GetQuestStatus(questId) == quest_status::Complete)
+			{
+				player->NotifyQuestRewarded(questId);
+			}
+			break;
+		}
+
+		CheckStatusesMatch(project, cache, *player);
+	}
+}
+
+TEST_CASE("Quest giver status cache is only invalidated by relevant changes", "[quest_giver_status_cache]")
+{
+	std::mt19937 generator(5);
+	QuestGiverProject questProject(generator);
+	const proto::Project& project = questProject.project;
+
+	asio::io_service io;
+	TimerQueue timers { io };
+	auto player = std::make_shared<GamePlayerS>(project, timers);
+	player->Initialize();
+	player->SetRace(*project.races.getById(1));
+	player->SetClass(*project.classes.getById(1));
+	player->SetLevel(MaxLevel);
+
+	const uint32 version = player->GetQuestStatusVersion();
+
+	// Failed attempts to change the quest log don't change anything
+	CHECK_FALSE(player->AbandonQuest(QuestCount + 1));
+	CHECK_FALSE(player->AcceptQuest(QuestCount + 1));
+	CHECK(player->GetQuestStatusVersion() == version);
+
+	uint32 availableQuest = 0;
+	for (uint32 id = 1; id <= QuestCount && availableQuest == 0; ++id)
+	{
+		if (player->GetQuestStatus(id) == quest_status::Available)
+		{
+			availableQuest = id;
+		}
+	}
+	REQUIRE(availableQuest != 0);
+
+	REQUIRE(player->AcceptQuest(availableQuest));
+	CHECK(player->GetQuestStatusVersion() != version);
+}
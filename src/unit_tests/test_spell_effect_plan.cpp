@@ -0,0 +1,206 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "game_server/spell_effect_plan.h"
+#include "proto_data/project.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	typedef std::vector<std::pair<uint32, int>> EffectCalls;
+
+	namespace se = spell_effects;
+
+	/// Effect types in the order of the handler table SingleCastState::ApplyAllEffects bound on every cast before
+	/// execution plans existed. Kept separate from SpellEffectExecutionOrder on purpose, so that a change to the
+	/// execution order shows up as a difference.
+	const std::vector<uint32> BoundHandlerOrder {
+		se::Dummy,
+		se::InstantKill,
+		se::PowerDrain,
+		se::Heal,
+		se::Bind,
+		se::QuestComplete,
+		se::WeaponDamageNoSchool,
+		se::CreateItem,
+		se::WeaponDamage,
+		se::TeleportUnits,
+		se::Energize,
+		se::WeaponPercentDamage,
+		se::OpenLock,
+		se::Dispel,
+		se::Summon,
+		se::SummonPet,
+		se::LearnSpell,
+		se::Resurrect,
+		se::ApplyAura,
+		se::PersistentAreaAura,
+		se::SchoolDamage,
+		se::ResetAttributePoints,
+		se::Parry,
+		se::Block,
+		se::Dodge,
+		se::HealPct,
+		se::AddExtraAttacks,
+		se::Charge
+	};
+
+	/// Executes effects the way spell casts did before execution plans: every bound handler is matched against
+	/// every effect.
+	EffectCalls DispatchByHandlerMatching(const proto::SpellEntry& spell)
+	{
+		std::vector<uint32> effects;
+		for (int i = 0; i < spell.effects_size(); ++i)
+		{
+			effects.push_back(spell.effects(i).type());
+		}
+
+		EffectCalls calls;
+		for (const uint32 handlerType : BoundHandlerOrder)
+		{
+			for (int k = 0; k < effects.size(); ++k)
+			{
+				if (handlerType == effects[k])
+				{
+					calls.emplace_back(handlerType, k);
+				}
+			}
+		}
+
+		return calls;
+	}
+
+	EffectCalls DispatchByPlan(const SpellEffectPlan& plan)
+	{
+		EffectCalls calls;
+		for (const auto& step : plan.GetSteps())
+		{
+			calls.emplace_back(step.type, step.effectIndex);
+		}
+
+		return calls;
+	}
+
+	void AddEffect(proto::SpellEntry& spell, const uint32 type)
+	{
+		auto* effect = spell.add_effects();
+		effect->set_index(spell.effects_size() - 1);
+		effect->set_type(type);
+	}
+
+	/// Checks the plans of all spells of a project against the old handler dispatch.
+	void CheckProjectPlans(const proto::Project& project)
+	{
+		const SpellEffectPlans plans(project);
+		REQUIRE(plans.GetSize() == project.spells.count());
+
+		for (const auto& spell : project.spells.getTemplates().entry())
+		{
+			INFO("Spell " << spell.id());
+
+			const SpellEffectPlan* plan = plans.Find(spell.id());
+			REQUIRE(plan);
+			CHECK(DispatchByPlan(*plan) == DispatchByHandlerMatching(spell));
+		}
+	}
+}
+
+TEST_CASE("Spell effect plans execute effects in handler order", "[spell_effect_plan]")
+{
+	proto::Project project;
+	auto* spell = project.spells.add();
+	AddEffect(*spell, spell_effects::SchoolDamage);
+	AddEffect(*spell, spell_effects::Dummy);
+	AddEffect(*spell, spell_effects::PortalTeleport);
+	AddEffect(*spell, spell_effects::ApplyAura);
+	AddEffect(*spell, spell_effects::Dummy);
+
+	const SpellEffectPlan plan(*spell);
+	REQUIRE(plan.GetSpellId() == spell->id());
+	REQUIRE(plan.GetSteps().size() == 4);
+
+	// Effects without handler are skipped and effects of the same type keep their order
+	CHECK(plan.GetSteps()[0].type == spell_effects::Dummy);
+	CHECK(plan.GetSteps()[0].effectIndex == 1);
+	CHECK(plan.GetSteps()[1].type == spell_effects::Dummy);
+	CHECK(plan.GetSteps()[1].effectIndex == 4);
+	CHECK(plan.GetSteps()[2].type == spell_effects::ApplyAura);
+	CHECK(plan.GetSteps()[2].effectIndex == 3);
+	CHECK(plan.GetSteps()[3].type == spell_effects::SchoolDamage);
+	CHECK(plan.GetSteps()[3].effectIndex == 0);
+}
+
+TEST_CASE("Spell effect plans match the old handler dispatch", "[spell_effect_plan]")
+{
+	SECTION("Every combination of two effect types")
+	{
+		proto::Project project;
+
+		// Includes types without handler and unknown types beyond the known ones
+		for (uint32 first = 0; first < se::Count_ + 2; ++first)
+		{
+			auto* single = project.spells.add();
+			AddEffect(*single, first);
+
+			for (uint32 second = 0; second < se::Count_ + 2; ++second)
+			{
+				auto* spell = project.spells.add();
+				AddEffect(*spell, first);
+				AddEffect(*spell, second);
+				AddEffect(*spell, first);
+			}
+		}
+
+		CheckProjectPlans(project);
+	}
+
+	SECTION("Spells of the project in MMO_TEST_PROJECT")
+	{
+		const char* projectPath = std::getenv("MMO_TEST_PROJECT");
+		if (!projectPath || !std::filesystem::exists(projectPath))
+		{
+			WARN("Set MMO_TEST_PROJECT to the data folder of a project to check its spells");
+			return;
+		}
+
+		proto::Project project;
+		REQUIRE(project.load(projectPath));
+		CheckProjectPlans(project);
+	}
+}
+
+TEST_CASE("Spell effect plans are built for all spells of a project", "[spell_effect_plan]")
+{
+	proto::Project project;
+	auto* heal = project.spells.add();
+	AddEffect(*heal, spell_effects::Heal);
+	auto* energize = project.spells.add();
+	AddEffect(*energize, spell_effects::Energize);
+
+	const SpellEffectPlans plans(project);
+	CHECK(plans.GetSize() == 2);
+	CHECK(plans.Find(energize->id() + 1) == nullptr);
+
+	const SpellEffectPlan* plan = plans.Find(energize->id());
+	REQUIRE(plan);
+	CHECK(plan->GetSpellId() == energize->id());
+	REQUIRE(plan->GetSteps().size() == 1);
+	CHECK(plan->GetSteps()[0].type == spell_effects::Energize);
+
+	// Another project has its own plans
+	proto::Project other;
+	auto* otherSpell = other.spells.add(heal->id());
+	AddEffect(*otherSpell, spell_effects::Dummy);
+
+	const SpellEffectPlans otherPlans(other);
+	REQUIRE(otherPlans.Find(heal->id()));
+	CHECK(otherPlans.Find(heal->id())->GetSteps()[0].type == spell_effects::Dummy);
+	CHECK(plans.Find(heal->id())->GetSteps()[0].type == spell_effects::Heal);
+}
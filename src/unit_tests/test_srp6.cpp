@@ -0,0 +1,317 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/big_number.h"
+#include "base/constants.h"
+#include "base/crypto_worker_pool.h"
+#include "base/sha1.h"
+#include "base/srp6.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+
+using namespace mmo;
+
+namespace
+{
+	/// Account data as stored in the login database.
+	struct TestAccount final
+	{
+		String name;
+		BigNumber s;
+		BigNumber x;
+		BigNumber v;
+	};
+
+	TestAccount CreateAccount(const String& name, const String& password)
+	{
+		TestAccount account;
+		account.name = name;
+		account.s.setRand(32 * 8);
+
+		const String credentials = name + ":" + password;
+		const SHA1Hash authHash = sha1(credentials.data(), credentials.size());
+
+		HashGeneratorSha1 gen;
+		gen.update(reinterpret_cast<const char*>(account.s.asByteArray().data()), account.s.getNumBytes());
+		gen.update(reinterpret_cast<const char*>(authHash.data()), authHash.size());
+		const SHA1Hash xHash = gen.finalize();
+		account.x.setBinary(xHash.data(), xHash.size());
+
+		account.v = constants::srp::g.modExp(account.x, constants::srp::N);
+		return account;
+	}
+
+	/// Values calculated by the client after receiving the logon challenge.
+	struct ClientProof final
+	{
+		BigNumber A;
+		std::array<uint8, 20> m1{};
+		SHA1Hash m2{};
+		BigNumber sessionKey;
+	};
+
+	/// Client side of the handshake, same as done by the login connectors.
+	ClientProof CalculateClientProof(const TestAccount& account, const BigNumber& x, const BigNumber& B)
+	{
+		ClientProof proof;
+
+		BigNumber a;
+		a.setRand(19 * 8);
+		proof.A = constants::srp::g.modExp(a, constants::srp::N);
+
+		const SHA1Hash uHash = Sha1_BigNumbers({ proof.A, B });
+		BigNumber u;
+		u.setBinary(uHash.data(), uHash.size());
+
+		// Add k * N so that the base of the exponentiation never becomes negative
+		BigNumber k{ 3 };
+		BigNumber N = constants::srp::N;
+		BigNumber base = B;
+		BigNumber privateKey = x;
+		base = (base + k * N) - k * constants::srp::g.modExp(x, constants::srp::N);
+		const BigNumber S = base.modExp((a + u * privateKey), constants::srp::N);
+
+		char S1[16], S2[16];
+		const auto arrS = S.asByteArray(32);
+		for (uint32 i = 0; i < 16; i++)
+		{
+			S1[i] = arrS[i * 2];
+			S2[i] = arrS[i * 2 + 1];
+		}
+
+		const SHA1Hash S1hash = sha1(S1, 16);
+		const SHA1Hash S2hash = sha1(S2, 16);
+
+		uint8 S_hash[40];
+		for (uint32 i = 0; i < 20; i++)
+		{
+			S_hash[i * 2] = S1hash[i];
+			S_hash[i * 2 + 1] = S2hash[i];
+		}
+		proof.sessionKey.setBinary(S_hash, 40);
+
+		const SHA1Hash userHash = sha1(account.name.c_str(), account.name.size());
+		const SHA1Hash Nhash = Sha1_BigNumbers({ constants::srp::N });
+		const SHA1Hash ghash = Sha1_BigNumbers({ constants::srp::g });
+
+		uint8 Ng_hash[20];
+		for (uint32 i = 0; i < 20; i++) Ng_hash[i] = Nhash[i] ^ ghash[i];
+
+		const BigNumber t_acc{ userHash.data(), userHash.size() };
+		const BigNumber t_Ng_hash{ Ng_hash, 20 };
+
+		HashGeneratorSha1 gen;
+		Sha1_Add_BigNumbers(gen, { t_Ng_hash, t_acc, account.s, proof.A, B });
+		gen.update(reinterpret_cast<const char*>(S_hash), 40);
+		const SHA1Hash m1 = gen.finalize();
+		std::copy(m1.begin(), m1.end(), proof.m1.begin());
+
+		Sha1_Add_BigNumbers(gen, { proof.A });
+		gen.update(reinterpret_cast<const char*>(m1.data()), m1.size());
+		gen.update(reinterpret_cast<const char*>(S_hash), 40);
+		proof.m2 = gen.finalize();
+
+		return proof;
+	}
+
+	/// Executes result handlers directly on the worker thread.
+	void DispatchDirectly(const std::function<void()>& handler)
+	{
+		handler();
+	}
+}
+
+TEST_CASE("FixedBaseModExp matches regular modular exponentiation", "[srp6]")
+{
+	const FixedBaseModExp table(constants::srp::g, constants::srp::N, srp6::ServerPrivateKeyBits);
+
+	for (int i = 0; i < 32; ++i)
+	{
+		BigNumber exponent;
+		exponent.setRand(srp6::ServerPrivateKeyBits);
+		CHECK(table.modExp(exponent).asHexStr() == constants::srp::g.modExp(exponent, constants::srp::N).asHexStr());
+	}
+
+	CHECK(table.modExp(BigNumber(0u)).asHexStr() == BigNumber(1u).asHexStr());
+	CHECK(table.modExp(BigNumber(1u)).asHexStr() == constants::srp::g.asHexStr());
+
+	// Exponents exceeding the table fall back to a regular modular exponentiation
+	BigNumber largeExponent;
+	largeExponent.setRand(256);
+	CHECK(table.modExp(largeExponent).asHexStr() == constants::srp::g.modExp(largeExponent, constants::srp::N).asHexStr());
+}
+
+TEST_CASE("SRP6 server verifies a valid client proof", "[srp6]")
+{
+	const TestAccount account = CreateAccount("TEST", "PASSWORD");
+
+	BigNumber b;
+	b.setRand(srp6::ServerPrivateKeyBits);
+	const BigNumber B = srp6::CalculateServerPublicKey(account.v, b);
+	BigNumber v = account.v;
+	CHECK(B.asHexStr() == (((v * 3) + constants::srp::g.modExp(b, constants::srp::N)) % constants::srp::N).asHexStr());
+
+	const ClientProof client = CalculateClientProof(account, account.x, B);
+	const srp6::ServerProof server = srp6::VerifyClientProof(account.name, account.s, account.v, b, B, client.A, client.m1);
+
+	REQUIRE(server.verified);
+	CHECK(server.sessionKey.asHexStr() == client.sessionKey.asHexStr());
+	CHECK(server.m2 == client.m2);
+}
+
+TEST_CASE("SRP6 server rejects a wrong password", "[srp6]")
+{
+	const TestAccount account = CreateAccount("TEST", "PASSWORD");
+	const TestAccount wrongPassword = CreateAccount("TEST", "WRONG");
+
+	BigNumber b;
+	b.setRand(srp6::ServerPrivateKeyBits);
+	const BigNumber B = srp6::CalculateServerPublicKey(account.v, b);
+
+	const ClientProof client = CalculateClientProof(account, wrongPassword.x, B);
+	const srp6::ServerProof server = srp6::VerifyClientProof(account.name, account.s, account.v, b, B, client.A, client.m1);
+
+	CHECK_FALSE(server.verified);
+}
+
+TEST_CASE("CryptoWorkerPool delivers results through the dispatcher", "[srp6]")
+{
+	std::promise<int> result;
+	const auto callerThread = std::this_thread::get_id();
+	std::thread::id workThread;
+
+	{
+		CryptoWorkerPool pool(1, 4, DispatchDirectly);
+		REQUIRE(pool.Post([&workThread]() { workThread = std::this_thread::get_id(); return 42; },
+			[&result](const int value) { result.set_value(value); }));
+
+		auto future = result.get_future();
+		REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+		CHECK(future.get() == 42);
+	}
+
+	CHECK(workThread != callerThread);
+}
+
+TEST_CASE("CryptoWorkerPool rejects work if too many jobs are pending", "[srp6]")
+{
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	std::atomic<int> completed{ 0 };
+
+	CryptoWorkerPool pool(1, 1, DispatchDirectly);
+
+	// Occupy the only worker
+	std::promise<void> started;
+	REQUIRE(pool.Post([&started, released]() { started.set_value(); released.wait(); }, [&completed]() { ++completed; }));
+	started.get_future().wait();
+
+	// Fill the queue
+	CHECK(pool.Post([]() {}, [&completed]() { ++completed; }));
+	CHECK(pool.GetPendingJobCount() == 1);
+
+	// Queue is full now
+	CHECK_FALSE(pool.Post([]() {}, [&completed]() { ++completed; }));
+
+	release.set_value();
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (completed < 2 && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::yield();
+	}
+
+	CHECK(completed == 2);
+}
+
+TEST_CASE("SRP6 login storm", "[srp6][!benchmark]")
+{
+	constexpr size_t LoginCount = 2000;
+
+	const TestAccount account = CreateAccount("TEST", "PASSWORD");
+	BigNumber v = account.v;
+
+	struct Session
+	{
+		BigNumber b, B;
+		ClientProof client;
+	};
+	std::vector<Session> sessions(LoginCount);
+	for (auto& session : sessions)
+	{
+		session.b.setRand(srp6::ServerPrivateKeyBits);
+	}
+
+	using Clock = std::chrono::steady_clock;
+	const auto toSeconds = [](const Clock::duration duration) { return std::chrono::duration<double>(duration).count(); };
+
+	// Logon challenge: previous implementation versus fixed base table
+	auto start = Clock::now();
+	for (auto& session : sessions)
+	{
+		session.B = ((v * 3) + constants::srp::g.modExp(session.b, constants::srp::N)) % constants::srp::N;
+	}
+	const double challengeModExp = toSeconds(Clock::now() - start);
+
+	start = Clock::now();
+	for (auto& session : sessions)
+	{
+		session.B = srp6::CalculateServerPublicKey(account.v, session.b);
+	}
+	const double challengeTable = toSeconds(Clock::now() - start);
+
+	for (auto& session : sessions)
+	{
+		session.client = CalculateClientProof(account, account.x, session.B);
+	}
+
+	// Logon proof: inline on a single thread versus the crypto worker pool
+	size_t verified = 0;
+	start = Clock::now();
+	for (const auto& session : sessions)
+	{
+		verified += srp6::VerifyClientProof(account.name, account.s, account.v, session.b, session.B, session.client.A, session.client.m1).verified ? 1 : 0;
+	}
+	const double proofInline = toSeconds(Clock::now() - start);
+	CHECK(verified == LoginCount);
+
+	const size_t workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+	std::atomic<size_t> pooledVerified{ 0 };
+	std::atomic<size_t> pooledCompleted{ 0 };
+	start = Clock::now();
+	{
+		CryptoWorkerPool pool(workerCount, LoginCount, DispatchDirectly);
+		for (const auto& session : sessions)
+		{
+			REQUIRE(pool.Post([&account, &session]()
+				{
+					return srp6::VerifyClientProof(account.name, account.s, account.v, session.b, session.B, session.client.A, session.client.m1);
+				},
+				[&pooledVerified, &pooledCompleted](const srp6::ServerProof& proof)
+				{
+					pooledVerified += proof.verified ? 1 : 0;
+					++pooledCompleted;
+				}));
+		}
+
+		while (pooledCompleted < LoginCount)
+		{
+			std::this_thread::yield();
+		}
+	}
+	const double proofPooled = toSeconds(Clock::now() - start);
+	CHECK(pooledVerified == LoginCount);
+
+	std::cout << "SRP6 login storm with " << LoginCount << " logins:" << std::endl;
+	std::cout << "\tLogon challenge (modExp):      " << LoginCount / challengeModExp << " handshakes/s" << std::endl;
+	std::cout << "\tLogon challenge (fixed base):  " << LoginCount / challengeTable << " handshakes/s" << std::endl;
+	std::cout << "\tLogon proof (inline):          " << LoginCount / proofInline << " handshakes/s" << std::endl;
+	std::cout << "\tLogon proof (" << workerCount << " crypto workers): " << LoginCount / proofPooled << " handshakes/s" << std::endl;
+	std::cout << "\tFull handshake (before):       " << LoginCount / (challengeModExp + proofInline) << " handshakes/s" << std::endl;
+	std::cout << "\tFull handshake (after):        " << LoginCount / (challengeTable + proofPooled) << " handshakes/s" << std::endl;
+}
@@ -0,0 +1,150 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#if MMO_BUILD_CLIENT
+
+#include "catch.hpp"
+
+#include "terrain/constants.h"
+#include "terrain/tile.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace mmo;
+using namespace mmo::terrain;
+
+namespace
+{
+	constexpr uint32 LastVertex = constants::VerticesPerTile - 1;
+
+	enum class Side
+	{
+		North,
+		East,
+		South,
+		West
+	};
+
+	typedef std::vector<std::pair<uint32, uint32>> Segments;
+
+	/// Gets all triangle edges which lie on a side of the tile as ranges of vertices along that side.
+	Segments GetSideSegments(const std::vector<uint16>& indices, const Side side)
+	{
+		const auto onSide = [side](const uint32 x, const uint32 y)
+		{
+			switch (side)
+			{
+			case Side::North: return y == 0;
+			case Side::East: return x == LastVertex;
+			case Side::South: return y == LastVertex;
+			default: return x == 0;
+			}
+		};
+
+		Segments segments;
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			for (size_t k = 0; k < 3; ++k)
+			{
+				const uint32 a = indices[i + k], b = indices[i + (k + 1) % 3];
+				const uint32 ax = a % constants::VerticesPerTile, ay = a / constants::VerticesPerTile;
+				const uint32 bx = b % constants::VerticesPerTile, by = b / constants::VerticesPerTile;
+				if (!onSide(ax, ay) || !onSide(bx, by))
+				{
+					continue;
+				}
+
+				const bool horizontal = side == Side::North || side == Side::South;
+				const uint32 from = horizontal ? ax : ay, to = horizontal ? bx : by;
+				segments.emplace_back(std::min(from, to), std::max(from, to));
+			}
+		}
+
+		std::sort(segments.begin(), segments.end());
+		return segments;
+	}
+
+	/// Gets the segments between the edge vertices of a lod.
+	Segments GetLodSegments(const uint32 lod)
+	{
+		const std::vector<uint32> vertices = Tile::GetLodVertices(lod);
+
+		Segments segments;
+		for (size_t i = 0; i + 1 < vertices.size(); ++i)
+		{
+			segments.emplace_back(vertices[i], vertices[i + 1]);
+		}
+
+		return segments;
+	}
+
+	/// Gets twice the area covered by the triangles and checks that all of them have the same winding order.
+	int64 GetDoubleArea(const std::vector<uint16>& indices)
+	{
+		int64 area = 0;
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			const int64 ax = indices[i] % constants::VerticesPerTile, ay = indices[i] / constants::VerticesPerTile;
+			const int64 bx = indices[i + 1] % constants::VerticesPerTile, by = indices[i + 1] / constants::VerticesPerTile;
+			const int64 cx = indices[i + 2] % constants::VerticesPerTile, cy = indices[i + 2] / constants::VerticesPerTile;
+
+			const int64 cross = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+			CHECK(cross < 0);
+			area -= cross;
+		}
+
+		return area;
+	}
+}
+
+TEST_CASE("Tile neighbor state only contains coarser neighbors", "[terrain]")
+{
+	CHECK(Tile::MakeNeighborState(1, 1, 0, 1, 0) == 0);
+	CHECK(Tile::MakeNeighborState(1, 2, 0, 0, 0) == 2u << 24);
+	CHECK(Tile::MakeNeighborState(1, 0, 3, 0, 0) == 3u << 16);
+	CHECK(Tile::MakeNeighborState(1, 0, 0, 4, 0) == 4u << 8);
+	CHECK(Tile::MakeNeighborState(1, 0, 0, 0, 2) == 2u);
+	CHECK(Tile::MakeNeighborState(0, 4, 3, 2, 1) == (4u << 24 | 3u << 16 | 2u << 8 | 1u));
+	CHECK(Tile::MakeNeighborState(constants::MaxTileLod, constants::MaxTileLod, 0, 0, 0) == 0);
+}
+
+TEST_CASE("Tile edges match the edges of coarser neighbors", "[terrain]")
+{
+	const Side side = GENERATE(Side::North, Side::East, Side::South, Side::West);
+	const uint32 shift = side == Side::North ? 24 : side == Side::East ? 16 : side == Side::South ? 8 : 0;
+
+	for (uint32 lod = 0; lod <= constants::MaxTileLod; ++lod)
+	{
+		INFO("Lod " << lod);
+
+		// Without coarser neighbors every side uses the edge vertices of the tile lod
+		const std::vector<uint16> unstitched = Tile::CreateIndices(lod, 0);
+		CHECK(GetSideSegments(unstitched, side) == GetLodSegments(lod));
+		CHECK(GetDoubleArea(unstitched) == 2 * LastVertex * LastVertex);
+
+		for (uint32 neighborLod = lod + 1; neighborLod <= constants::MaxTileLod; ++neighborLod)
+		{
+			INFO("Neighbor lod " << neighborLod);
+
+			// The neighbor renders its side with its own lod, as the tile is finer than the neighbor
+			const std::vector<uint16> stitched = Tile::CreateIndices(lod, neighborLod << shift);
+			CHECK(GetSideSegments(stitched, side) == GetLodSegments(neighborLod));
+
+			// Stitching must neither leave holes nor overlap triangles
+			CHECK(GetDoubleArea(stitched) == 2 * LastVertex * LastVertex);
+		}
+	}
+
+	SECTION("All sides stitched at once")
+	{
+		const uint32 neighborLod = constants::MaxTileLod;
+		const uint32 state = Tile::MakeNeighborState(0, neighborLod, neighborLod, neighborLod, neighborLod);
+
+		const std::vector<uint16> stitched = Tile::CreateIndices(0, state);
+		CHECK(GetSideSegments(stitched, side) == GetLodSegments(neighborLod));
+		CHECK(GetDoubleArea(stitched) == 2 * LastVertex * LastVertex);
+	}
+}
+
+#endif
@@ -0,0 +1,269 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#if MMO_BUILD_CLIENT
+
+#include "catch.hpp"
+#include "font_test_environment.h"
+
+#include "frame_ui/font.h"
+#include "frame_ui/geometry_buffer.h"
+#include "frame_ui/rect.h"
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+
+using namespace mmo;
+
+namespace
+{
+	/// Counts the glyphs of a text which generate geometry.
+	uint32 CountVisibleGlyphs(Font& font, const std::string& text)
+	{
+		uint32 count = 0;
+		for (const char c : text)
+		{
+			const FontGlyph* glyph = font.GetGlyphData(c == '\t' ? ' ' : c);
+			if (glyph && glyph->GetImage()->GetOwner())
+			{
+				++count;
+			}
+		}
+
+		return count;
+	}
+
+	/// Generates chat messages or tooltip texts made of random words.
+	std::string GenerateText(std::mt19937& generator, const uint32 wordCount)
+	{
+		static const char* words[] = { "the", "Defias", "Brotherhood", "of", "Westfall", "has", "looted", "[Linen Cloth]", "and", "gains", "15", "reputation", "with", "Stormwind.", "Heals", "for", "2", "seconds", "Mana:", "Use:" };
+
+		std::uniform_int_distribution<size_t> word(0, std::size(words) - 1);
+
+		std::string text;
+		for (uint32 i = 0; i < wordCount; ++i)
+		{
+			if (!text.empty())
+			{
+				text += ' ';
+			}
+
+			text += words[word(generator)];
+		}
+
+		return text;
+	}
+}
+
+TEST_CASE("Text layouts split text into lines", "[text_layout]")
+{
+	FontTestEnvironment environment;
+
+	Font font;
+	REQUIRE(font.Initialize("test.ttf", 12.0f));
+
+	const float scale = GENERATE(1.0f, 1.5f);
+
+	SECTION("Words are moved to the next line")
+	{
+		const float width = font.GetTextWidth("Hello brave", scale) + 1.0f;
+		const TextLayout layout(font, "Hello brave Hello world", width, scale, TextWrapping::Word);
+
+		REQUIRE(layout.GetLineCount() == 2);
+		CHECK(layout.GetLines()[0].glyphCount == CountVisibleGlyphs(font, "Hello brave"));
+		CHECK(layout.GetLines()[0].width == font.GetTextWidth("Hello brave", scale));
+		CHECK(layout.GetLines()[1].glyphCount == CountVisibleGlyphs(font, "Hello world"));
+		CHECK(layout.GetLines()[1].width == font.GetTextWidth("Hello world", scale));
+
+		// Each line starts at the left edge and is one line height below the previous line
+		const TextLayoutGlyph& first = layout.GetGlyphs()[layout.GetLines()[0].firstGlyph];
+		const TextLayoutGlyph& second = layout.GetGlyphs()[layout.GetLines()[1].firstGlyph];
+		CHECK(first.position.x == 0.0f);
+		CHECK(second.position.x == 0.0f);
+		CHECK(second.position.y - first.position.y == Approx(font.GetHeight(scale)));
+	}
+
+	SECTION("Line breaks start new lines and words aren't wrapped without a width")
+	{
+		const TextLayout layout(font, "Hello brave new world\nand\tgoodbye", 0.0f, scale, TextWrapping::Word);
+
+		REQUIRE(layout.GetLineCount() == 2);
+		CHECK(layout.GetLines()[0].width == font.GetTextWidth("Hello brave new world", scale));
+		CHECK(layout.GetLines()[1].width == font.GetTextWidth("and\tgoodbye", scale));
+		CHECK(layout.GetGlyphs().size() == CountVisibleGlyphs(font, "Hello brave new worldand\tgoodbye"));
+	}
+
+	SECTION("Characters are moved to the next line")
+	{
+		const std::string text = "WWWWWWWWWWWWWWWWWWWW";
+		const float glyphAdvance = font.GetGlyphData('W')->GetAdvance(scale);
+		const TextLayout layout(font, text, glyphAdvance * 7.5f, scale, TextWrapping::Character);
+
+		// A line is finished as soon as a glyph reaches the end of the line
+		REQUIRE(layout.GetLineCount() == 3);
+		CHECK(layout.GetLines()[0].glyphCount == 8);
+		CHECK(layout.GetLines()[1].glyphCount == 8);
+		CHECK(layout.GetLines()[2].glyphCount == 4);
+
+		const Rect area(10.0f, 10.0f, 10.0f + glyphAdvance * 7.5f, 100.0f);
+		CHECK(font.DrawText(text, area, nullptr, scale) == 3);
+	}
+}
+
+TEST_CASE("Text layout cache", "[text_layout]")
+{
+	FontTestEnvironment environment;
+
+	SECTION("Layouts are reused until the text, width or scale changes")
+	{
+		Font font;
+		REQUIRE(font.Initialize("test.ttf", 12.0f));
+
+		const TextLayout& layout = font.GetTextLayout("Hello world", 100.0f);
+		CHECK(&font.GetTextLayout("Hello world", 100.0f) == &layout);
+		CHECK(font.GetTextLayoutCache().GetSize() == 1);
+
+		font.GetTextLayout("Hello world", 120.0f);
+		font.GetTextLayout("Hello world", 100.0f, 2.0f);
+		font.GetTextLayout("Hello world", 100.0f, 1.0f, TextWrapping::Character);
+		font.GetTextLayout("Hello World", 100.0f);
+		CHECK(font.GetTextLayoutCache().GetSize() == 5);
+		CHECK(&font.GetTextLayout("Hello world", 100.0f) == &layout);
+
+		// Initializing the font again changes all glyphs
+		REQUIRE(font.Initialize("test.ttf", 14.0f));
+		CHECK(font.GetTextLayoutCache().GetSize() == 0);
+	}
+
+	SECTION("The least recently used layout is removed")
+	{
+		Font font;
+		REQUIRE(font.Initialize("test.ttf", 12.0f));
+
+		TextLayoutCache cache(2);
+		const TextLayout& first = cache.Get(font, "first", 100.0f, 1.0f, TextWrapping::Word);
+		cache.Get(font, "second", 100.0f, 1.0f, TextWrapping::Word);
+		CHECK(&cache.Get(font, "first", 100.0f, 1.0f, TextWrapping::Word) == &first);
+
+		cache.Get(font, "third", 100.0f, 1.0f, TextWrapping::Word);
+		CHECK(cache.GetSize() == 2);
+		CHECK(&cache.Get(font, "first", 100.0f, 1.0f, TextWrapping::Word) == &first);
+		CHECK(cache.GetSize() == 2);
+	}
+
+	SECTION("Cached layouts are drawn after their glyphs were removed from the atlas")
+	{
+		// A single tiny atlas page, so that every other text removes the glyphs of the cached layout
+		Font font(64, 1);
+		REQUIRE(font.Initialize("test.ttf", 12.0f));
+
+		const std::string text = "abcdef";
+		const Rect area(0.0f, 0.0f, 200.0f, 20.0f);
+
+		GeometryBuffer expected;
+		font.DrawText(text, area, &expected);
+
+		font.DrawText("ghijklmnopqrstuvwxyz", area, nullptr);
+		font.PreloadGlyphs('A', 'Z');
+		REQUIRE(font.GetAtlas().GetEvictionCount() > 0);
+
+		GeometryBuffer actual;
+		font.DrawText(text, area, &actual);
+		CHECK(actual.GetVertexCount() == expected.GetVertexCount());
+		CHECK(actual.GetVertexCount() == CountVisibleGlyphs(font, text) * 6);
+	}
+}
+
+TEST_CASE("Chat and tooltip frame cost", "[text_layout][!benchmark]")
+{
+	FontTestEnvironment environment;
+
+	Font font;
+	REQUIRE(font.Initialize("test.ttf", 12.0f, 1.0f));
+	font.SetShadow(1.0f, 1.0f);
+
+	std::mt19937 generator(11);
+
+	// A chat frame showing its last hundred lines and a big tooltip with lots of wrapped lines
+	constexpr uint32 ChatLineCount = 100;
+	const Rect chatArea(20.0f, 400.0f, 520.0f, 700.0f);
+	std::vector<std::string> chatLines;
+	for (uint32 i = 0; i < ChatLineCount; ++i)
+	{
+		chatLines.push_back(GenerateText(generator, 6 + i % 10));
+	}
+
+	const Rect tooltipArea(600.0f, 100.0f, 850.0f, 600.0f);
+	std::vector<std::string> tooltipTexts;
+	for (uint32 i = 0; i < 12; ++i)
+	{
+		tooltipTexts.push_back(GenerateText(generator, 4 + i * 3));
+	}
+
+	constexpr uint32 FrameCount = 500;
+
+	GeometryBuffer buffer;
+	const auto renderFrame = [&](const auto& layoutText)
+	{
+		buffer.Reset();
+
+		Rect lineArea = chatArea;
+		for (const auto& line : chatLines)
+		{
+			const TextLayout& layout = layoutText(line, lineArea.GetWidth(), TextWrapping::Character);
+			font.DrawTextLayout(layout, lineArea.GetPosition(), buffer);
+			lineArea.top += font.GetHeight() * layout.GetLineCount();
+		}
+
+		Point position = tooltipArea.GetPosition();
+		for (const auto& text : tooltipTexts)
+		{
+			const TextLayout& layout = layoutText(text, tooltipArea.GetWidth(), TextWrapping::Word);
+			for (uint32 i = 0; i < layout.GetLineCount(); ++i)
+			{
+				font.DrawTextLayoutLine(layout, i, position, buffer);
+			}
+
+			position.y += font.GetHeight() * layout.GetLineCount();
+		}
+
+		return buffer.GetVertexCount();
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	// Splitting all texts into lines and looking up their glyphs again every frame
+	std::unique_ptr<TextLayout> uncached;
+	size_t uncachedVertices = 0;
+	auto start = Clock::now();
+	for (uint32 frame = 0; frame < FrameCount; ++frame)
+	{
+		uncachedVertices += renderFrame([&](const std::string& text, float width, TextWrapping wrapping) -> const TextLayout&
+		{
+			uncached = std::make_unique<TextLayout>(font, text, width, 1.0f, wrapping);
+			return *uncached;
+		});
+	}
+	const double uncachedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	size_t cachedVertices = 0;
+	start = Clock::now();
+	for (uint32 frame = 0; frame < FrameCount; ++frame)
+	{
+		cachedVertices += renderFrame([&](const std::string& text, float width, TextWrapping wrapping) -> const TextLayout&
+		{
+			return font.GetTextLayout(text, width, 1.0f, wrapping);
+		});
+	}
+	const double cachedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	CHECK(cachedVertices == uncachedVertices);
+
+	std::cout << "Geometry of a chat frame with " << ChatLineCount << " lines and a tooltip (" << uncachedVertices / FrameCount << " vertices):" << std::endl;
+	std::cout << "\tLaid out every frame: " << uncachedSeconds * 1000000.0 / FrameCount << " us per frame" << std::endl;
+	std::cout << "\tCached layouts:       " << cachedSeconds * 1000000.0 / FrameCount << " us per frame" << std::endl;
+}
+
+#endif
@@ -0,0 +1,354 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "game_server/chase_path_tracker.h"
+#include "game_server/game_player_s.h"
+#include "game_server/quest_status_data.h"
+#include "game_server/threat_table.h"
+#include "proto_data/project.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace mmo;
+
+namespace
+{
+	/// Units which can be added to a threat table.
+	struct Threateners
+	{
+		proto::Project project;
+		asio::io_service io;
+		TimerQueue timers { io };
+		std::vector<std::shared_ptr<GamePlayerS>> units;
+
+		explicit Threateners(const uint32 count)
+		{
+			for (uint32 i = 0; i < count; ++i)
+			{
+				auto unit = std::make_shared<GamePlayerS>(project, timers);
+				unit->Initialize();
+				unit->Set<uint64>(object_fields::Guid, i + 1);
+				units.push_back(std::move(unit));
+			}
+		}
+	};
+
+	struct ReferenceEntry
+	{
+		std::weak_ptr<GameUnitS> threatener;
+		float amount;
+	};
+
+	/// Victim selection by looking at every entry of a threat list sorted by guid.
+	GameUnitS* FindTopThreatenerByScan(const std::map<uint64, ReferenceEntry>& threat)
+	{
+		float highestThreat = -1.0f;
+		GameUnitS* topThreatener = nullptr;
+		for (const auto& [guid, entry] : threat)
+		{
+			const auto threatener = entry.threatener.lock();
+			if (!threatener)
+			{
+				continue;
+			}
+
+			if (entry.amount > highestThreat)
+			{
+				topThreatener = threatener.get();
+				highestThreat = entry.amount;
+			}
+		}
+
+		return topThreatener;
+	}
+
+	/// Result of a simulated pull where a creature chases a kiting target while being attacked by many units.
+	struct ChaseResult
+	{
+		uint32 pathCount = 0;
+		uint32 decisionCount = 0;
+		float maxDistance = 0.0f;
+		float finalDistance = 0.0f;
+	};
+
+	/// Simulates a creature chasing its victim. Every attack of a threatening unit and every 500 ms the creature decides
+	/// whether it needs a new path, like CreatureAICombatState does. Paths are straight lines in this simulation.
+	template<typename NeedsPath, typename PathCalculated>
+	ChaseResult SimulateChase(const uint32 attackerCount, const GameTime duration, NeedsPath&& needsPath, PathCalculated&& pathCalculated)
+	{
+		constexpr float CreatureSpeed = 7.0f;
+		constexpr float TargetSpeed = 7.0f;
+		constexpr float CombatRange = 10.0f;
+		constexpr float Tolerance = CombatRange * 0.5f;
+		constexpr GameTime Step = 50;
+		constexpr GameTime DecisionInterval = 500;
+
+		std::mt19937 generator(11);
+		std::uniform_int_distribution<GameTime> attackDelay(1000, 3000);
+
+		std::vector<GameTime> nextAttacks(attackerCount);
+		for (auto& nextAttack : nextAttacks)
+		{
+			nextAttack = attackDelay(generator);
+		}
+
+		ChaseResult result;
+		Vector3 position(0.0f, 0.0f, 0.0f);
+		Vector3 moveTarget = position;
+		Vector3 targetPosition(20.0f, 0.0f, 0.0f);
+		GameTime nextDecision = 0;
+
+		for (GameTime now = 0; now <= duration; now += Step)
+		{
+			// Target walks in circles around the spawn point
+			const float angle = static_cast<float>(now) / 1000.0f * TargetSpeed / 20.0f;
+			targetPosition = Vector3(std::cos(angle) * 20.0f, 0.0f, std::sin(angle) * 20.0f);
+
+			uint32 decisions = 0;
+			if (now >= nextDecision)
+			{
+				++decisions;
+				nextDecision = now + DecisionInterval;
+			}
+
+			for (auto& nextAttack : nextAttacks)
+			{
+				if (now >= nextAttack)
+				{
+					++decisions;
+					nextAttack = now + attackDelay(generator);
+				}
+			}
+
+			for (uint32 i = 0; i < decisions; ++i)
+			{
+				++result.decisionCount;
+
+				if (!needsPath(targetPosition, Tolerance, moveTarget, now))
+				{
+					continue;
+				}
+
+				Vector3 newTarget = targetPosition;
+				Vector3 direction = targetPosition - position;
+				if (direction.Normalize() != 0.0f)
+				{
+					newTarget = newTarget - direction * 2.0f;
+				}
+
+				moveTarget = newTarget;
+				pathCalculated(moveTarget, now);
+				++result.pathCount;
+			}
+
+			// Move towards the current movement target
+			Vector3 toTarget = moveTarget - position;
+			const float remaining = toTarget.Normalize();
+			const float stepLength = CreatureSpeed * static_cast<float>(Step) / 1000.0f;
+			position = remaining <= stepLength ? moveTarget : position + toTarget * stepLength;
+
+			const float distance = (targetPosition - position).GetLength();
+			if (now >= 5000)
+			{
+				result.maxDistance = std::max(result.maxDistance, distance);
+			}
+			result.finalDistance = distance;
+		}
+
+		return result;
+	}
+
+	ChaseResult SimulateFixedChase(const uint32 attackerCount, const GameTime duration)
+	{
+		return SimulateChase(attackerCount, duration, [](const Vector3& targetPosition, const float tolerance, const Vector3& moveTarget, GameTime)
+			{
+				return (targetPosition - moveTarget).GetSquaredLength() > tolerance * tolerance;
+			},
+			[](const Vector3&, GameTime) {});
+	}
+
+	ChaseResult SimulateTrackedChase(const uint32 attackerCount, const GameTime duration)
+	{
+		constexpr uint64 TargetGuid = 1;
+
+		ChasePathTracker tracker;
+		return SimulateChase(attackerCount, duration, [&tracker](const Vector3& targetPosition, const float tolerance, const Vector3& moveTarget, const GameTime now)
+			{
+				return tracker.NeedsPath(TargetGuid, targetPosition, tolerance, moveTarget, now);
+			},
+			[&tracker](const Vector3& destination, const GameTime now)
+			{
+				tracker.OnPathCalculated(TargetGuid, destination, now);
+			});
+	}
+}
+
+TEST_CASE("Threat table picks the same victim as a full scan", "[threat_table]")
+{
+	Threateners threateners(24);
+
+	std::mt19937 generator(GENERATE(1u, 2u, 3u, 4u));
+	std::uniform_int_distribution<size_t> unit(0, threateners.units.size() - 1);
+	std::uniform_int_distribution<int> operation(0, 9);
+	std::uniform_int_distribution<int> amount(0, 8);
+
+	ThreatTable table;
+	std::map<uint64, ReferenceEntry> reference;
+	uint64 nextGuid = threateners.units.size() + 1;
+
+	for (int i = 0; i < 5000; ++i)
+	{
+		auto& threatener = threateners.units[unit(generator)];
+		const uint64 guid = threatener->GetGuid();
+
+		// Small amounts so that ties happen frequently
+		const float value = static_cast<float>(amount(generator)) * 25.0f;
+
+		switch (operation(generator))
+		{
+		case 0:
+			CHECK(table.Remove(guid) == (reference.erase(guid) != 0));
+			break;
+		case 1:
+			table.SetThreat(guid, value);
+			if (const auto it = reference.find(guid); it != reference.end())
+			{
+				it->second.amount = value;
+			}
+			break;
+		case 2:
+			// Unit is destroyed but still on the threat table, another unit takes its place
+			if (reference.contains(guid))
+			{
+				threatener = std::make_shared<GamePlayerS>(threateners.project, threateners.timers);
+				threatener->Initialize();
+				threatener->Set<uint64>(object_fields::Guid, nextGuid++);
+			}
+			break;
+		default:
+			{
+				const bool added = !reference.contains(guid);
+				CHECK(table.AddThreat(*threatener, value) == added);
+				if (added)
+				{
+					reference[guid] = { threatener, 0.0f };
+				}
+				reference[guid].amount += value;
+			}
+			break;
+		}
+
+		REQUIRE(table.GetSize() == reference.size());
+		REQUIRE(table.GetTopThreatener() == FindTopThreatenerByScan(reference));
+		REQUIRE(table.GetThreat(guid) == (reference.contains(guid) ? reference[guid].amount : 0.0f));
+	}
+
+	table.Clear();
+	CHECK(table.IsEmpty());
+	CHECK(table.GetTopThreatener() == nullptr);
+}
+
+TEST_CASE("Chase path tracker throttles paths to the same target", "[threat_table]")
+{
+	ChasePathTracker tracker;
+	const Vector3 start(0.0f, 0.0f, 0.0f);
+
+	// Target in reach of the movement target: no path needed
+	CHECK_FALSE(tracker.NeedsPath(1, Vector3(3.0f, 0.0f, 0.0f), 5.0f, start, 0));
+
+	// No path yet
+	REQUIRE(tracker.NeedsPath(1, Vector3(20.0f, 0.0f, 0.0f), 5.0f, start, 0));
+	tracker.OnPathCalculated(1, Vector3(18.0f, 0.0f, 0.0f), 0);
+
+	// Target moved away, but the current path was just calculated
+	CHECK_FALSE(tracker.NeedsPath(1, Vector3(30.0f, 0.0f, 0.0f), 5.0f, Vector3(18.0f, 0.0f, 0.0f), 100));
+	CHECK(tracker.NeedsPath(1, Vector3(30.0f, 0.0f, 0.0f), 5.0f, Vector3(18.0f, 0.0f, 0.0f), ChasePathTracker::MinRepathInterval));
+
+	// Another target or another movement target invalidates the path immediately
+	CHECK(tracker.NeedsPath(2, Vector3(30.0f, 0.0f, 0.0f), 5.0f, Vector3(18.0f, 0.0f, 0.0f), 100));
+	CHECK(tracker.NeedsPath(1, Vector3(30.0f, 0.0f, 0.0f), 5.0f, Vector3(12.0f, 0.0f, 0.0f), 100));
+
+	// Failed paths are not retried immediately
+	tracker.OnPathFailed(1, Vector3(12.0f, 0.0f, 0.0f), 200);
+	CHECK_FALSE(tracker.NeedsPath(1, Vector3(30.0f, 0.0f, 0.0f), 5.0f, Vector3(12.0f, 0.0f, 0.0f), 300));
+	CHECK(tracker.NeedsPath(1, Vector3(30.0f, 0.0f, 0.0f), 5.0f, Vector3(12.0f, 0.0f, 0.0f), 700));
+
+	tracker.Reset();
+	CHECK(tracker.NeedsPath(1, Vector3(30.0f, 0.0f, 0.0f), 5.0f, Vector3(12.0f, 0.0f, 0.0f), 300));
+}
+
+TEST_CASE("Throttled chase keeps the creature in reach of its victim", "[threat_table]")
+{
+	const uint32 attackerCount = GENERATE(1u, 10u, 40u);
+	constexpr GameTime Duration = 60 * 1000;
+
+	const ChaseResult fixed = SimulateFixedChase(attackerCount, Duration);
+	const ChaseResult tracked = SimulateTrackedChase(attackerCount, Duration);
+
+	INFO("Attackers: " << attackerCount);
+	CHECK(tracked.decisionCount == fixed.decisionCount);
+	CHECK(tracked.pathCount <= fixed.pathCount);
+
+	// The creature keeps up with its victim as well as before
+	CHECK(tracked.maxDistance <= fixed.maxDistance + 1.0f);
+	CHECK(tracked.finalDistance <= 10.0f);
+}
+
+TEST_CASE("Chase path calculations in a large pull", "[threat_table][!benchmark]")
+{
+	constexpr GameTime Duration = 5 * 60 * 1000;
+
+	std::cout << "Chase paths calculated in " << Duration / 1000 << " s while kiting:" << std::endl;
+	for (const uint32 attackerCount : { 1u, 10u, 40u, 100u })
+	{
+		const ChaseResult fixed = SimulateFixedChase(attackerCount, Duration);
+		const ChaseResult tracked = SimulateTrackedChase(attackerCount, Duration);
+
+		std::cout << "\t" << attackerCount << " attackers, " << fixed.decisionCount << " decisions: "
+			<< fixed.pathCount << " paths before, " << tracked.pathCount << " paths with tracker" << std::endl;
+	}
+
+	Threateners threateners(100);
+	std::mt19937 generator(5);
+	std::uniform_int_distribution<size_t> unit(0, threateners.units.size() - 1);
+	std::uniform_real_distribution<float> amount(0.0f, 100.0f);
+
+	ThreatTable table;
+	std::map<uint64, ReferenceEntry> reference;
+
+	using Clock = std::chrono::steady_clock;
+	constexpr int EventCount = 200000;
+	size_t checksum = 0;
+
+	auto start = Clock::now();
+	for (int i = 0; i < EventCount; ++i)
+	{
+		const auto& threatener = threateners.units[unit(generator)];
+		auto& entry = reference[threatener->GetGuid()];
+		entry.threatener = threatener;
+		entry.amount += amount(generator);
+		checksum += reinterpret_cast<uintptr_t>(FindTopThreatenerByScan(reference));
+	}
+	const double scanSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	generator.seed(5);
+	start = Clock::now();
+	for (int i = 0; i < EventCount; ++i)
+	{
+		const auto& threatener = threateners.units[unit(generator)];
+		table.AddThreat(*threatener, amount(generator));
+		checksum -= reinterpret_cast<uintptr_t>(table.GetTopThreatener());
+	}
+	const double tableSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	CHECK(checksum == 0);
+
+	std::cout << "Victim updates for " << EventCount << " threat events of " << threateners.units.size() << " attackers:" << std::endl;
+	std::cout << "\tFull scan:    " << scanSeconds * 1000.0 << " ms" << std::endl;
+	std::cout << "\tThreat table: " << tableSeconds * 1000.0 << " ms" << std::endl;
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/trace_profiler.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace mmo;
+
+
+TEST_CASE("Ring buffer keeps the newest events", "[trace_profiler]")
+{
+	TraceEventBuffer buffer(1, 2);
+	buffer.Push("a", 1, 1);
+	buffer.Push("b", 2, 1);
+	buffer.Push("c", 3, 1);
+
+	std::vector<TraceEvent> events;
+	buffer.CopyEvents(events, 0);
+
+	REQUIRE(events.size() == 2);
+	CHECK(std::string(events[0].name) == "b");
+	CHECK(std::string(events[1].name) == "c");
+
+	events.clear();
+	buffer.CopyEvents(events, 3);
+	REQUIRE(events.size() == 1);
+	CHECK(events[0].start == 3);
+}
+
+TEST_CASE("Scopes are only recorded while recording", "[trace_profiler]")
+{
+	TraceProfiler& profiler = TraceProfiler::Get();
+	const uint64 since = profiler.GetTimestamp();
+
+	profiler.SetEnabled(false);
+	{
+		TRACE_SCOPE("TestScopeSkipped");
+	}
+
+	profiler.SetEnabled(true);
+	{
+		TRACE_SCOPE("TestScopeRecorded");
+	}
+	profiler.SetEnabled(false);
+
+	std::ostringstream strm;
+	profiler.WriteChromeTrace(strm, since);
+	const std::string json = strm.str();
+
+	CHECK(json.find("\"name\":\"TestScopeRecorded\",\"ph\":\"X\"") != std::string::npos);
+	CHECK(json.find("TestScopeSkipped") == std::string::npos);
+}
+
+TEST_CASE("Sampling records one out of every n ticks", "[trace_profiler]")
+{
+	TraceProfiler& profiler = TraceProfiler::Get();
+	profiler.SetEnabled(false);
+	profiler.SetSampleInterval(2);
+
+	int recordedTicks = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		profiler.BeginTick();
+		if (profiler.IsRecording())
+		{
+			++recordedTicks;
+		}
+		profiler.EndTick();
+		CHECK(!profiler.IsRecording());
+	}
+
+	profiler.SetSampleInterval(0);
+	CHECK(recordedTicks == 2);
+}
+
+TEST_CASE("Slow ticks write a trace file in the background", "[trace_profiler]")
+{
+	const std::filesystem::path folder = std::filesystem::temp_directory_path() / "mmo_trace_test";
+	std::filesystem::remove_all(folder);
+
+	TraceProfiler& profiler = TraceProfiler::Get();
+	profiler.SetEnabled(true);
+	profiler.SetTrigger(1, 0, folder.string());
+
+	profiler.BeginTick();
+	{
+		TRACE_SCOPE("TestScopeSlowTick");
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	profiler.EndTick();
+
+	profiler.SetTrigger(0, 0, String());
+	profiler.SetEnabled(false);
+	profiler.FlushCaptures();
+
+	std::vector<std::filesystem::path> files;
+	for (const auto& entry : std::filesystem::directory_iterator(folder))
+	{
+		files.push_back(entry.path());
+	}
+
+	REQUIRE(files.size() == 1);
+
+	std::ifstream file(files.front());
+	const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	CHECK(json.find("\"name\":\"TestScopeSlowTick\"") != std::string::npos);
+
+	file.close();
+	std::filesystem::remove_all(folder);
+}
@@ -0,0 +1,388 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/filesystem.h"
+#include "base/sha1.h"
+#include "updater/download_file.h"
+#include "updater/http_update_source.h"
+#include "updater/perform_update.h"
+#include "updater/prepared_update.h"
+#include "updater/update_parameters.h"
+#include "updater/updater_progress_handler.h"
+
+#include "asio.hpp"
+#include "zstr/zstr.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+using namespace mmo;
+using namespace mmo::updating;
+
+namespace
+{
+	/// Minimal HTTP/1.0 server on the loopback interface standing in for the update server. Supports byte ranges
+	/// and can drop connections, delay responses or refuse requests.
+	class TestHttpServer final
+	{
+	public:
+		TestHttpServer()
+			: m_acceptor(m_ioService, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0))
+		{
+			m_acceptThread = std::thread([this]() { Accept(); });
+		}
+
+		~TestHttpServer()
+		{
+			m_stopping = true;
+
+			// Wake up the blocking accept
+			asio::ip::tcp::socket socket(m_ioService);
+			asio::error_code error;
+			socket.connect(m_acceptor.local_endpoint(), error);
+
+			m_acceptThread.join();
+			for (auto &thread : m_connectionThreads)
+			{
+				thread.join();
+			}
+		}
+
+		uint16 GetPort() const { return m_acceptor.local_endpoint().port(); }
+
+		void AddFile(const std::string &path, std::string content)
+		{
+			std::scoped_lock lock{ m_mutex };
+			m_files[path] = std::move(content);
+		}
+
+		/// Closes the connection of the next response for a file after the given number of body bytes.
+		void CutNextResponse(const std::string &path, const size_t bytes)
+		{
+			std::scoped_lock lock{ m_mutex };
+			m_cuts[path] = bytes;
+		}
+
+		void SetUnavailable(const bool unavailable) { m_unavailable = unavailable; }
+
+		void SetResponseDelay(const std::chrono::milliseconds delay) { m_delay = delay; }
+
+		size_t GetPeakConnections() const { return m_peakConnections; }
+
+		std::vector<size_t> GetRangeRequests(const std::string &path) const
+		{
+			std::scoped_lock lock{ m_mutex };
+			const auto it = m_ranges.find(path);
+			return it != m_ranges.end() ? it->second : std::vector<size_t>();
+		}
+
+	private:
+		void Accept()
+		{
+			for (;;)
+			{
+				auto socket = std::make_shared<asio::ip::tcp::socket>(m_ioService);
+				asio::error_code error;
+				m_acceptor.accept(*socket, error);
+				if (m_stopping)
+				{
+					return;
+				}
+
+				if (!error)
+				{
+					m_connectionThreads.emplace_back([this, socket]() { Serve(*socket); });
+				}
+			}
+		}
+
+		void Serve(asio::ip::tcp::socket &socket)
+		{
+			const size_t active = ++m_activeConnections;
+			size_t peak = m_peakConnections;
+			while (active > peak && !m_peakConnections.compare_exchange_weak(peak, active))
+			{
+			}
+
+			asio::error_code error;
+			asio::streambuf requestBuffer;
+			asio::read_until(socket, requestBuffer, "\r\n\r\n", error);
+
+			std::istream request(&requestBuffer);
+			std::string method, path, line;
+			request >> method >> path;
+			std::getline(request, line);
+
+			size_t rangeBegin = 0;
+			while (std::getline(request, line) && line != "\r")
+			{
+				static const std::string RangePrefix = "Range: bytes=";
+				if (line.compare(0, RangePrefix.size(), RangePrefix) == 0)
+				{
+					rangeBegin = std::stoull(line.substr(RangePrefix.size()));
+				}
+			}
+
+			std::this_thread::sleep_for(m_delay.load());
+
+			std::string response;
+			std::string body;
+			{
+				std::scoped_lock lock{ m_mutex };
+				m_ranges[path].push_back(rangeBegin);
+
+				const auto file = m_files.find(path);
+				if (m_unavailable)
+				{
+					response = "HTTP/1.0 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+				}
+				else if (file == m_files.end() || rangeBegin > file->second.size())
+				{
+					response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+				}
+				else
+				{
+					body = file->second.substr(rangeBegin);
+					response = (rangeBegin > 0 ? "HTTP/1.0 206 Partial Content\r\n" : "HTTP/1.0 200 OK\r\n");
+					response += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+
+					if (const auto cut = m_cuts.find(path); cut != m_cuts.end())
+					{
+						body.resize(std::min(body.size(), cut->second));
+						m_cuts.erase(cut);
+					}
+				}
+			}
+
+			asio::write(socket, asio::buffer(response + body), error);
+			socket.shutdown(asio::ip::tcp::socket::shutdown_both, error);
+			socket.close(error);
+
+			--m_activeConnections;
+		}
+
+	private:
+		asio::io_service m_ioService;
+		asio::ip::tcp::acceptor m_acceptor;
+		std::thread m_acceptThread;
+		std::vector<std::thread> m_connectionThreads;
+		std::atomic<bool> m_stopping { false };
+
+		mutable std::mutex m_mutex;
+		std::map<std::string, std::string> m_files;
+		std::map<std::string, size_t> m_cuts;
+		std::map<std::string, std::vector<size_t>> m_ranges;
+		std::atomic<bool> m_unavailable { false };
+		std::atomic<std::chrono::milliseconds> m_delay { std::chrono::milliseconds(0) };
+		std::atomic<size_t> m_activeConnections { 0 };
+		std::atomic<size_t> m_peakConnections { 0 };
+	};
+
+	struct NullProgressHandler final : IUpdaterProgressHandler
+	{
+		void updateFile(const std::string &, std::uintmax_t, std::uintmax_t) override
+		{
+		}
+	};
+
+	/// Temporary directory which is removed again when leaving the scope.
+	struct TemporaryDirectory final
+	{
+		std::filesystem::path path;
+
+		TemporaryDirectory()
+			: path(std::filesystem::temp_directory_path() / ("mmo_update_test_" + std::to_string(std::random_device()())))
+		{
+			std::filesystem::create_directories(path);
+		}
+
+		~TemporaryDirectory()
+		{
+			std::error_code error;
+			std::filesystem::remove_all(path, error);
+		}
+	};
+
+	std::string MakeRandomContent(const size_t size, const uint32 seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_int_distribution<int> distribution(0, 255);
+
+		std::string content(size, '\0');
+		for (auto &c : content)
+		{
+			c = static_cast<char>(distribution(generator));
+		}
+
+		return content;
+	}
+
+	std::string Compress(const std::string &content)
+	{
+		std::ostringstream compressed;
+		{
+			zstr::ostream compressor(compressed);
+			compressor.write(content.data(), static_cast<std::streamsize>(content.size()));
+		}
+
+		return compressed.str();
+	}
+
+	std::string ReadFile(const std::filesystem::path &path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		std::ostringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+
+	UpdateParameters MakeParameters(const TestHttpServer &server, IUpdaterProgressHandler &progressHandler)
+	{
+		return UpdateParameters(std::make_unique<HTTPUpdateSource>("127.0.0.1", server.GetPort(), "/"), false, progressHandler);
+	}
+}
+
+
+TEST_CASE("Interrupted downloads continue where they stopped", "[updater]")
+{
+	TestHttpServer server;
+	NullProgressHandler progressHandler;
+	const auto parameters = MakeParameters(server, progressHandler);
+	TemporaryDirectory directory;
+
+	const std::string content = MakeRandomContent(300000, 1);
+	const auto digest = sha1(content.data(), content.size());
+	const auto destination = (directory.path / "file.bin").string();
+
+	SECTION("Uncompressed")
+	{
+		server.AddFile("/file.bin", content);
+		server.CutNextResponse("/file.bin", 100000);
+
+		downloadFile(parameters, "file.bin", destination, "", content.size(), content.size(), digest);
+
+		CHECK(server.GetRangeRequests("/file.bin") == std::vector<size_t>({ 0, 100000 }));
+	}
+
+	SECTION("Compressed")
+	{
+		const std::string compressed = Compress(content);
+		server.AddFile("/file.bin", compressed);
+		server.CutNextResponse("/file.bin", compressed.size() / 2);
+
+		downloadFile(parameters, "file.bin", destination, "zlib", compressed.size(), content.size(), digest);
+
+		CHECK(server.GetRangeRequests("/file.bin") == std::vector<size_t>({ 0, compressed.size() / 2 }));
+	}
+
+	CHECK(ReadFile(destination) == content);
+	CHECK_FALSE(std::filesystem::exists(destination + ".part"));
+}
+
+TEST_CASE("Partial downloads are resumed by the next update", "[updater]")
+{
+	TestHttpServer server;
+	NullProgressHandler progressHandler;
+	const auto parameters = MakeParameters(server, progressHandler);
+	TemporaryDirectory directory;
+
+	const std::string content = MakeRandomContent(200000, 2);
+	const auto digest = sha1(content.data(), content.size());
+	const auto destination = (directory.path / "file.bin").string();
+
+	server.AddFile("/file.bin", content);
+	server.CutNextResponse("/file.bin", 50000);
+
+	// The first response is cut and the server goes away before the download is retried
+	std::thread outage([&server]()
+	{
+		while (server.GetRangeRequests("/file.bin").empty())
+		{
+			std::this_thread::yield();
+		}
+		server.SetUnavailable(true);
+	});
+
+	CHECK_THROWS(downloadFile(parameters, "file.bin", destination, "", content.size(), content.size(), digest));
+	outage.join();
+
+	CHECK(std::filesystem::exists(destination + ".part"));
+
+	server.SetUnavailable(false);
+	downloadFile(parameters, "file.bin", destination, "", content.size(), content.size(), digest);
+
+	CHECK(ReadFile(destination) == content);
+	CHECK(server.GetRangeRequests("/file.bin").back() == 50000);
+	CHECK_FALSE(std::filesystem::exists(destination + ".part"));
+}
+
+TEST_CASE("Downloads not matching the expected digest are rejected", "[updater]")
+{
+	TestHttpServer server;
+	NullProgressHandler progressHandler;
+	const auto parameters = MakeParameters(server, progressHandler);
+	TemporaryDirectory directory;
+
+	const std::string content = MakeRandomContent(10000, 3);
+	const std::string expected = MakeRandomContent(10000, 4);
+	const auto destination = (directory.path / "file.bin").string();
+
+	server.AddFile("/file.bin", content);
+
+	CHECK_THROWS(downloadFile(parameters, "file.bin", destination, "", content.size(), content.size(), sha1(expected.data(), expected.size())));
+	CHECK(server.GetRangeRequests("/file.bin").size() == MaxDownloadAttempts);
+	CHECK_FALSE(std::filesystem::exists(destination + ".part"));
+}
+
+TEST_CASE("Update steps download files over parallel connections", "[updater]")
+{
+	TestHttpServer server;
+	NullProgressHandler progressHandler;
+	const auto parameters = MakeParameters(server, progressHandler);
+	TemporaryDirectory directory;
+
+	constexpr size_t FileCount = 8;
+	constexpr size_t Concurrency = 4;
+	const auto delay = std::chrono::milliseconds(200);
+	server.SetResponseDelay(delay);
+
+	std::vector<std::string> contents;
+	PreparedUpdate update;
+	for (size_t i = 0; i < FileCount; ++i)
+	{
+		contents.push_back(MakeRandomContent(50000, static_cast<uint32>(10 + i)));
+
+		const std::string name = "file" + std::to_string(i) + ".bin";
+		server.AddFile("/" + name, contents.back());
+
+		const auto destination = (directory.path / name).string();
+		const auto digest = sha1(contents.back().data(), contents.back().size());
+		const auto size = contents.back().size();
+		update.steps.emplace_back(destination, [name, destination, digest, size](const UpdateParameters &updateParameters)
+		{
+			downloadFile(updateParameters, name, destination, "", size, size, digest);
+			return false;
+		});
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	CHECK(performUpdate(update, parameters, Concurrency));
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	for (size_t i = 0; i < FileCount; ++i)
+	{
+		CHECK(ReadFile(directory.path / ("file" + std::to_string(i) + ".bin")) == contents[i]);
+	}
+
+	CHECK(server.GetPeakConnections() == Concurrency);
+
+	// One request after another would take at least FileCount times the delay
+	CHECK(elapsed < delay * FileCount);
+}
@@ -21,6 +21,9 @@ int main(int argc, char **argv)
 	// Paramaters parsed out of command line options
 	std::string sourceDir, outputDir;
 	std::string compression;
+	std::string cacheDir;
+	size_t concurrency = 0;
+	std::uintmax_t patchThresholdMiB = 16;
 
 	// Build command line options
 	cxxopts::Options options(VersionStr + ", available options");
@@ -30,6 +33,9 @@ int main(int argc, char **argv)
 		("s,source", "A directory containing source.txt", cxxopts::value(sourceDir))
 		("o,output", "Where to put the updater-compatible files", cxxopts::value(outputDir))
 		("c,compression", "Provide 'zlib' for compression", cxxopts::value(compression))
+		("j,concurrency", "Number of threads compressing files, 0 for one per hardware thread", cxxopts::value(concurrency))
+		("cache", "A directory which keeps compressed files and large file versions between builds, required for delta patches", cxxopts::value(cacheDir))
+		("patch-threshold", "Minimum size in MiB of files which get delta patches against their previous version", cxxopts::value(patchThresholdMiB))
 		;
 
 	// Support positional arguments
@@ -52,12 +58,16 @@ int main(int argc, char **argv)
 		}
 
 
-		bool isZLibCompressed = false;
+		mmo::updating::CompileOptions compileOptions;
+		compileOptions.concurrency = concurrency;
+		compileOptions.cacheDirectory = cacheDir;
+		compileOptions.patchThreshold = patchThresholdMiB * 1024 * 1024;
+
 		if (!compression.empty())
 		{
 			if (compression == "zlib")
 			{
-				isZLibCompressed = true;
+				compileOptions.isZLibCompressed = true;
 			}
 			else
 			{
@@ -73,11 +83,16 @@ int main(int argc, char **argv)
 			virtual_dir::FileSystemReader sourceReader(sourceDir);
 			virtual_dir::FileSystemWriter outputWriter(outputDir);
 
-			mmo::updating::compileDirectory(
+			const auto statistics = mmo::updating::compileDirectory(
 				sourceReader,
 				outputWriter,
-				isZLibCompressed
+				compileOptions
 			);
+
+			std::cout
+				<< "Compiled " << statistics.files << " files ("
+				<< statistics.cachedFiles << " taken from cache, "
+				<< statistics.patches << " delta patches)\n";
 		}
 		catch (const std::exception &e)
 		{
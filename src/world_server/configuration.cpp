@@ -38,6 +38,11 @@ namespace mmo
 		, dataFolder("data")
 		, mapFolder("nav")
 		, watchDataForChanges(true)
+		, isTraceEnabled(false)
+		, traceSampleInterval(0)
+		, traceTickThreshold(0)
+		, traceTicksAfterOverrun(30)
+		, traceFolder("traces")
 	{
 	}
 
@@ -159,6 +164,25 @@ namespace mmo
 				logFileName = log->getString("fileName", logFileName);
 				isLogFileBuffering = log->getInteger("buffering", static_cast<unsigned>(isLogFileBuffering)) != 0;
 			}
+
+			if (const Table *const profiler = global.getTable("profiler"))
+			{
+				isTraceEnabled = detail::parseBoolean(*profiler, "enabled", isTraceEnabled);
+				traceSampleInterval = profiler->getInteger("sampleInterval", traceSampleInterval);
+				traceTickThreshold = profiler->getInteger("tickThreshold", traceTickThreshold);
+				traceTicksAfterOverrun = profiler->getInteger("ticksAfterOverrun", traceTicksAfterOverrun);
+				traceFolder = profiler->getString("folder", traceFolder);
+			}
+
+			if (const Table *const relay = global.getTable("movementRelay"))
+			{
+				movementRelay.fullRateDistance = relay->getInteger("fullRateDistance", movementRelay.fullRateDistance);
+				movementRelay.reducedRateDistance = relay->getInteger("reducedRateDistance", movementRelay.reducedRateDistance);
+				movementRelay.reducedRateInterval = relay->getInteger("reducedRateInterval", movementRelay.reducedRateInterval);
+				movementRelay.distantInterval = relay->getInteger("distantInterval", movementRelay.distantInterval);
+				movementRelay.maxPositionError = relay->getInteger("maxPositionError", movementRelay.maxPositionError);
+				movementRelay.maxFacingError = relay->getInteger("maxFacingError", movementRelay.maxFacingError);
+			}
 		}
 		catch (const sff::read::ParseException<Iterator> &e)
 		{
@@ -265,6 +289,31 @@ namespace mmo
 			log.Finish();
 		}
 
+		global.writer.newLine();
+
+		{
+			sff::write::Table<Char> profiler(global, "profiler", sff::write::MultiLine);
+			profiler.addKey("enabled", static_cast<unsigned>(isTraceEnabled));
+			profiler.addKey("sampleInterval", traceSampleInterval);
+			profiler.addKey("tickThreshold", traceTickThreshold);
+			profiler.addKey("ticksAfterOverrun", traceTicksAfterOverrun);
+			profiler.addKey("folder", traceFolder);
+			profiler.Finish();
+		}
+
+		global.writer.newLine();
+
+		{
+			sff::write::Table<Char> relay(global, "movementRelay", sff::write::MultiLine);
+			relay.addKey("fullRateDistance", movementRelay.fullRateDistance);
+			relay.addKey("reducedRateDistance", movementRelay.reducedRateDistance);
+			relay.addKey("reducedRateInterval", movementRelay.reducedRateInterval);
+			relay.addKey("distantInterval", movementRelay.distantInterval);
+			relay.addKey("maxPositionError", movementRelay.maxPositionError);
+			relay.addKey("maxFacingError", movementRelay.maxFacingError);
+			relay.Finish();
+		}
+
 		return true;
 	}
 }
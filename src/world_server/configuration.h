@@ -4,6 +4,7 @@
 
 #include "simple_file_format/sff_write_table.h"
 #include "base/typedefs.h"
+#include "game_server/movement_relay.h"
 
 #include <set>
 
@@ -61,6 +62,21 @@ namespace mmo
 		String mapFolder;
 		bool watchDataForChanges;
 
+		/// If enabled, every tick is recorded by the trace profiler.
+		bool isTraceEnabled;
+		/// Records one out of every n ticks with the trace profiler. 0 disables sampling.
+		uint32 traceSampleInterval;
+		/// Tick duration in milliseconds after which the following ticks are recorded and written to a trace file.
+		/// 0 disables the trigger.
+		uint32 traceTickThreshold;
+		/// Number of ticks recorded after a slow tick.
+		uint32 traceTicksAfterOverrun;
+		/// Folder in which triggered trace files are written.
+		String traceFolder;
+
+		/// Controls how often movement packets of players are relayed to other players depending on their distance.
+		MovementRelaySettings movementRelay;
+
 		explicit Configuration();
 		bool load(const String &fileName);
 		bool save(const String &fileName);
@@ -3,6 +3,8 @@
 #include "player.h"
 
 #include "player_manager.h"
+#include "base/metrics.h"
+#include "base/trace_profiler.h"
 #include "base/utilities.h"
 #include "game_server/each_tile_in_region.h"
 #include "game_server/each_tile_in_sight.h"
@@ -19,13 +21,18 @@
 
 namespace mmo
 {
-	Player::Player(PlayerManager& playerManager, RealmConnector& realmConnector, std::shared_ptr<GamePlayerS> characterObject, CharacterData characterData, const proto::Project& project, WorldInstance& instance)
+	/// Rough size of a value update block of a single object, used to reserve update packet buffers up front.
+	static constexpr size_t EstimatedUpdateBlockSize = 64;
+
+	Player::Player(PlayerManager& playerManager, RealmConnector& realmConnector, std::shared_ptr<GamePlayerS> characterObject, CharacterData characterData, const proto::Project& project, WorldInstance& instance, const uint32 clientFeatures)
 		: m_manager(playerManager)
 		, m_connector(realmConnector)
 		, m_character(std::move(characterObject))
 		, m_characterData(std::move(characterData))
 		, m_project(project)
 		, m_groupUpdate(instance.GetUniverse().GetTimers())
+		, m_movementRelay(playerManager.GetMovementRelaySettings())
+		, m_clientFeatures(clientFeatures)
 	{
 		m_character->SetNetUnitWatcher(this);
 		m_character->SetPlayerWatcher(this);
@@ -54,34 +61,22 @@ namespace mmo
 		// Group update signal
 		m_groupUpdate.ended.connect([&]()
 			{
-				const Vector3 location(m_character->GetPosition());
-
-				// Get group id
-				auto groupId = m_character->GetGroupId();
-				std::vector<uint64> nearbyMembers;
-
-				// Determine nearby party members
-				instance.GetUnitFinder().FindUnits(Circle(location.x, location.y, 100.0f), [this, groupId, &nearbyMembers](GameUnitS& unit) -> bool
-					{
-						// Only characters
-						if (!unit.IsPlayer())
-						{
-							return true;
-						}
+				// Characters without a group are not updated at all
+				if (m_character->GetGroupId() == 0)
+				{
+					return;
+				}
 
-						// Check characters group
-						GamePlayerS* character = static_cast<GamePlayerS*>(&unit);
-						if (character->GetGroupId() == groupId &&
-							character->GetGuid() != GetCharacterGuid())
-						{
-							nearbyMembers.push_back(character->GetGuid());
-						}
+				// Determine nearby party members by looking at the group members only
+				if (WorldInstance* worldInstance = m_character->GetWorldInstance())
+				{
+					std::vector<uint64> nearbyMembers;
+					worldInstance->GetGroupMembers().FindNearbyMembers(*m_character, 100.0f, nearbyMembers);
 
-						return true;
-					});
+					// Send packet to world node
+					m_connector.SendCharacterGroupUpdate(*m_character, nearbyMembers);
+				}
 
-				// Send packet to world node
-				m_connector.SendCharacterGroupUpdate(*m_character, nearbyMembers);
 				m_groupUpdate.SetEnd(GetAsyncTimeMs() + constants::OneSecond * 3);
 			});
 
@@ -172,11 +167,18 @@ namespace mmo
 			std::vector<char> buffer;
 			io::VectorSink sink(buffer);
 
+			// Grow the buffer once for the whole packet instead of repeatedly while writing the update blocks
+			sink.Reserve(objects.size() * EstimatedUpdateBlockSize);
+
 			typename game::Protocol::OutgoingPacket packet(sink);
 			packet.Start(game::realm_client_packet::UpdateObject);
 			const size_t countPosition = sink.Position();
 			packet << io::write<uint16>(objects.size());
 
+			// The size of each update block is known up front, so the blocks are written into reserved sections
+			io::BasicWriter<io::VectorSink<>> bufferWriter(sink);
+			bool blocksValid = true;
+
 			uint16 objectUpdateCount = objects.size();
 			for (const auto& object : objects)
 			{
@@ -186,13 +188,22 @@ namespace mmo
 					continue;
 				}
 
-				object->WriteObjectUpdateBlock(packet, false);
+				io::SectionSink section = bufferWriter.ReserveSection(object->GetChangesUpdateBlockSize());
+				io::BasicWriter<io::SectionSink> blockWriter(section);
+				object->WriteObjectUpdateBlock(blockWriter);
+
+				if (!blockWriter || section.Position() != section.Size())
+				{
+					ELOG("Update block of object " << log_hex_digit(object->GetGuid()) << " doesn't match its calculated size of " << section.Size() << " bytes, skipping object update packet");
+					blocksValid = false;
+					break;
+				}
 			}
 
 			sink.Overwrite(countPosition, reinterpret_cast<const char*>(&objectUpdateCount), sizeof(uint16));
 			packet.Finish();
 
-			if (objectUpdateCount > 0)
+			if (objectUpdateCount > 0 && blocksValid)
 			{
 				// Send the proxy packet to the realm server
 				m_connector.SendProxyPacket(m_character->GetGuid(), packet.GetId(), packet.GetSize(), buffer, false);
@@ -280,6 +291,12 @@ namespace mmo
 			}
 		}
 
+		// The client forgets the movement of destroyed objects as well
+		for (const auto *gameObject : objects)
+		{
+			m_movementReferences.erase(gameObject->GetGuid());
+		}
+
 		VisibilityTile &tile = m_worldInstance->GetGrid().RequireTile(GetTileIndex());
 		SendPacket([&objects](game::OutgoingPacket& outPacket)
 		{
@@ -298,8 +315,34 @@ namespace mmo
 		m_connector.SendProxyPacket(m_character->GetGuid(), packet.GetId(), packet.GetSize(), buffer, flush);
 	}
 
+	void Player::SendMovement(const uint16 opCode, const uint64 moverGuid, const MovementInfo& info, game::Protocol::OutgoingPacket& packet, const std::vector<char>& buffer)
+	{
+		static_assert(game::realm_client_packet::Count_ <= 256, "Compact movement packets store the op code in a single byte");
+
+		if (!(m_clientFeatures & game::client_feature::CompactMovement))
+		{
+			SendPacket(packet, buffer);
+			return;
+		}
+
+		auto [it, inserted] = m_movementReferences.try_emplace(moverGuid);
+		const CompactMovementState state = CompactMovementState::FromMovementInfo(info);
+
+		SendPacket([&](game::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(game::realm_client_packet::CompactMovement);
+			outPacket << io::write_packed_guid(moverGuid) << io::write<uint8>(opCode);
+			WriteCompactMovement(outPacket, state, inserted ? nullptr : &it->second);
+			outPacket.Finish();
+		});
+
+		it->second = state;
+	}
+
 	void Player::HandleProxyPacket(game::client_realm_packet::Type opCode, std::vector<uint8>& buffer)
 	{
+		TRACE_SCOPE("Player::HandleProxyPacket");
+
 		io::MemorySource source(reinterpret_cast<char*>(buffer.data()), reinterpret_cast<char*>(buffer.data() + buffer.size()));
 		io::Reader reader(source);
 
@@ -415,6 +458,9 @@ namespace mmo
 		case game::client_realm_packet::QuestGiverStatusQuery:
 			OnQuestGiverStatusQuery(opCode, buffer.size(), reader);
 			break;
+		case game::client_realm_packet::QuestGiverStatusMultipleQuery:
+			OnQuestGiverStatusMultipleQuery(opCode, buffer.size(), reader);
+			break;
 
 		case game::client_realm_packet::TrainerMenu:
 			OnTrainerMenu(opCode, buffer.size(), reader);
@@ -509,11 +555,12 @@ namespace mmo
 			<< io::write<uint8>(flags);
 		outPacket.Finish();
 
-		// Spawn tile objects
+		// Collect all listeners in range so that the packet only has to be sent to the realm once
+		std::vector<uint64> receivers;
 		ForEachSubscriberInSight(
 			m_worldInstance->GetGrid(),
 			tile.GetPosition(),
-			[&position, chatDistance, &outPacket, &buffer](TileSubscriber& subscriber)
+			[&position, chatDistance, &receivers](TileSubscriber& subscriber)
 			{
 				auto& unit = subscriber.GetGameUnit();
 				const float distanceSquared = (unit.GetPosition() - position).GetSquaredLength();
@@ -522,8 +569,10 @@ namespace mmo
 					return;
 				}
 
-				subscriber.SendPacket(outPacket, buffer);
+				receivers.push_back(unit.GetGuid());
 			});
+
+		m_connector.SendProxyPacketMulti(receivers, outPacket.GetId(), outPacket.GetSize(), buffer);
 	}
 
 	bool Player::IsLooting() const
@@ -548,6 +597,10 @@ namespace mmo
 
 		m_worldInstance = &instance;
 
+		// Watchers on the new map have not seen any movement of the character yet, and the client forgot every unit it knew
+		m_movementRelay.Reset();
+		m_movementReferences.clear();
+
 		// Self spawn
 		std::vector<GameObjectS*> objects;
 
@@ -603,6 +656,7 @@ namespace mmo
 	{
 		// No longer watch for network events
 		m_character->SetNetUnitWatcher(nullptr);
+		m_movementReferences.clear();
 
 		SaveCharacterData();
 
@@ -1045,6 +1099,9 @@ namespace mmo
 
 		m_character->ApplyMovementInfo(info);
 
+		static MetricCounter& s_relayedPackets = MetricsRegistry::Get().AddCounter("mmo_world_movement_packets_total", "Number of player movement packets sent to watchers or skipped by the movement relay.", "result=\"relayed\"");
+		static MetricCounter& s_skippedPackets = MetricsRegistry::Get().AddCounter("mmo_world_movement_packets_total", "Number of player movement packets sent to watchers or skipped by the movement relay.", "result=\"skipped\"");
+
 		std::vector<char> buffer;
 		io::VectorSink sink { buffer };
 		game::OutgoingPacket movementPacket { sink };
@@ -1052,19 +1109,42 @@ namespace mmo
 		movementPacket << io::write<uint64>(characterGuid) << info;
 		movementPacket.Finish();
 
+		// Heartbeats and facing updates only refresh the current movement, every other packet changes it and has to be
+		// received by every watcher
+		const bool isStateChange = opCode != game::realm_client_packet::MoveHeartBeat && opCode != game::realm_client_packet::MoveSetFacing;
+		m_movementRelay.BeginPacket(info, m_character->GetSpeed(MovementRelay::GetMovementType(info)), isStateChange);
+
+		const uint64 targetGuid = m_character->Get<uint64>(object_fields::TargetUnit);
+		const uint64 groupId = m_character->GetGroupId();
+
 		ForEachTileInSight(
 			m_worldInstance->GetGrid(),
 			tile.GetPosition(),
-			[characterGuid, &buffer, &movementPacket](VisibilityTile &tile)
+			[this, opCode, characterGuid, targetGuid, groupId, &info, &buffer, &movementPacket](VisibilityTile &tile)
 		{
 			for (const auto& watcher : tile.GetWatchers())
 			{
-				if (watcher->GetGameUnit().GetGuid() == characterGuid)
+				GameUnitS& watchingUnit = watcher->GetGameUnit();
+				if (watchingUnit.GetGuid() == characterGuid)
+				{
+					continue;
+				}
+
+				bool isRelated = watchingUnit.GetGuid() == targetGuid || watchingUnit.Get<uint64>(object_fields::TargetUnit) == characterGuid;
+				if (!isRelated && groupId != 0 && watchingUnit.IsPlayer())
+				{
+					isRelated = static_cast<GamePlayerS&>(watchingUnit).GetGroupId() == groupId;
+				}
+
+				const float distance = std::sqrt(watchingUnit.GetSquaredDistanceTo(info.position, true));
+				if (!m_movementRelay.ShouldRelayTo(watchingUnit.GetGuid(), distance, isRelated))
 				{
+					s_skippedPackets.Increment();
 					continue;
 				}
 
-				watcher->SendPacket(movementPacket, buffer);
+				s_relayedPackets.Increment();
+				watcher->SendMovement(opCode, characterGuid, info, movementPacket, buffer);
 			}
 		});
 	}
@@ -6,9 +6,12 @@
 #include "vector_sink.h"
 #include "game_server/character_data.h"
 #include "game/chat_type.h"
+#include "game/compact_movement.h"
 #include "game/vendor.h"
 #include "game_server/game_object_s.h"
 #include "game_server/game_player_s.h"
+#include "game_server/movement_relay.h"
+#include "game_server/quest_giver_status_cache.h"
 #include "game_server/tile_index.h"
 #include "game_server/tile_subscriber.h"
 #include "game_protocol/game_protocol.h"
@@ -30,7 +33,7 @@ namespace mmo
 	{
 	public:
 		explicit Player(PlayerManager& manager, RealmConnector& realmConnector, std::shared_ptr<GamePlayerS> characterObject,
-		                CharacterData characterData, const proto::Project& project, WorldInstance& instance);
+		                CharacterData characterData, const proto::Project& project, WorldInstance& instance, uint32 clientFeatures = 0);
 		~Player() override;
 
 	public:
@@ -65,6 +68,9 @@ namespace mmo
 		/// @copydoc TileSubscriber::SendPacket
 		void SendPacket(game::Protocol::OutgoingPacket& packet, const std::vector<char>& buffer, bool flush = true) override;
 
+		/// @copydoc TileSubscriber::SendMovement
+		void SendMovement(uint16 opCode, uint64 moverGuid, const MovementInfo& info, game::Protocol::OutgoingPacket& packet, const std::vector<char>& buffer) override;
+
 		void HandleProxyPacket(game::client_realm_packet::Type opCode, std::vector<uint8>& buffer);
 
 		void LocalChatMessage(ChatType type, const std::string& message);
@@ -264,6 +270,13 @@ namespace mmo
 		/// @param contentReader Reader object used to read the packets content bytes.
 		void OnQuestGiverStatusQuery(uint16 opCode, uint32 size, io::Reader& contentReader);
 
+		/// Handles the client's request to get the current status of multiple quest giver npcs at once, which is sent
+		///	for all quest givers which became visible to the client at the same time.
+		///	@param opCode The op code of the packet.
+		///	@param size The size of the packet content in bytes, excluding the packet header.
+		/// @param contentReader Reader object used to read the packets content bytes.
+		void OnQuestGiverStatusMultipleQuery(uint16 opCode, uint32 size, io::Reader& contentReader);
+
 		/// 
 		///	@param opCode The op code of the packet.
 		///	@param size The size of the packet content in bytes, excluding the packet header.
@@ -428,6 +441,17 @@ namespace mmo
 		scoped_connection m_onLootSourceDespawned;
 
 		Countdown m_groupUpdate;
+
+		MovementRelay m_movementRelay;
+
+		/// Features announced by the client, see game::client_feature.
+		uint32 m_clientFeatures;
+
+		/// Last compact movement state sent to the client per moving unit.
+		mutable std::unordered_map<uint64, CompactMovementState> m_movementReferences;
+
+		/// Quest giver statuses of the character per creature entry.
+		QuestGiverStatusCache m_questGiverStatusCache;
 	};
 
 }
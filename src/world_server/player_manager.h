@@ -14,7 +14,10 @@ namespace mmo
 		typedef std::shared_ptr<Player> PlayerPtr;
 
 	public:
-		PlayerManager() = default;
+		explicit PlayerManager(const MovementRelaySettings& movementRelaySettings = MovementRelaySettings())
+			: m_movementRelaySettings(movementRelaySettings)
+		{
+		}
 
 	public:
 		/// @brief Adds a new player to the player manager.
@@ -27,8 +30,12 @@ namespace mmo
 
 		PlayerPtr GetPlayerByCharacterGuid(ObjectGuid guid) const;
 
+		/// @brief Gets the settings used to relay player movement to other players.
+		const MovementRelaySettings& GetMovementRelaySettings() const { return m_movementRelaySettings; }
+
 	private:
 		std::map<ObjectId, PlayerPtr> m_players;
+		MovementRelaySettings m_movementRelaySettings;
 	};
 	
 }
@@ -278,7 +278,7 @@ namespace mmo
 			return;
 		}
 
-		QuestgiverStatus status = questGiver->GetQuestGiverStatus(*m_character);
+		QuestgiverStatus status = m_questGiverStatusCache.Get(questGiver->GetEntry(), *m_character);
 		SendPacket([questGiverGuid, status](game::OutgoingPacket& packet)
 			{
 				packet.Start(game::realm_client_packet::QuestGiverStatus);
@@ -287,6 +287,60 @@ namespace mmo
 			});
 	}
 
+	void Player::OnQuestGiverStatusMultipleQuery(uint16 opCode, uint32 size, io::Reader& contentReader)
+	{
+		uint16 count;
+		if (!(contentReader >> io::read<uint16>(count)))
+		{
+			ELOG("Failed to read QuestGiverStatusMultipleQuery packet!");
+			return;
+		}
+
+		if (count == 0 || count > game::MaxQuestGiverStatusBatchSize)
+		{
+			ELOG("Invalid QuestGiverStatusMultipleQuery entry count " << count);
+			return;
+		}
+
+		std::vector<std::pair<uint64, QuestgiverStatus>> statuses;
+		statuses.reserve(count);
+
+		for (uint16 i = 0; i < count; ++i)
+		{
+			uint64 questGiverGuid;
+			if (!(contentReader >> io::read_packed_guid(questGiverGuid)))
+			{
+				ELOG("Failed to read QuestGiverStatusMultipleQuery packet!");
+				return;
+			}
+
+			// Quest givers might have despawned in the meantime, so just skip them
+			GameCreatureS* questGiver = m_character->GetWorldInstance()->FindByGuid<GameCreatureS>(questGiverGuid);
+			if (!questGiver)
+			{
+				continue;
+			}
+
+			statuses.emplace_back(questGiverGuid, m_questGiverStatusCache.Get(questGiver->GetEntry(), *m_character));
+		}
+
+		if (statuses.empty())
+		{
+			return;
+		}
+
+		SendPacket([&statuses](game::OutgoingPacket& packet)
+			{
+				packet.Start(game::realm_client_packet::QuestGiverStatusMultiple);
+				packet << io::write<uint16>(statuses.size());
+				for (const auto& [guid, status] : statuses)
+				{
+					packet << io::write_packed_guid(guid) << io::write<uint8>(status);
+				}
+				packet.Finish();
+			});
+	}
+
 	void Player::OnQuestGiverCompleteQuest(uint16 opCode, uint32 size, io::Reader& contentReader)
 	{
 		uint64 questGiverGuid = 0;
@@ -13,6 +13,7 @@
 #include "realm_connector.h"
 #include "game_server/world_instance_manager.h"
 #include "player_manager.h"
+#include "web_service.h"
 
 #include <fstream>
 #include <sstream>
@@ -24,6 +25,7 @@
 
 #include "base/filesystem.h"
 #include "base/timer_queue.h"
+#include "base/trace_profiler.h"
 #include "game_server/universe.h"
 #include "proto_data/project.h"
 #include "assets/asset_registry.h"
@@ -111,7 +113,12 @@ namespace mmo
 			return 1;
 		}
 
-		PlayerManager playerManager;
+		PlayerManager playerManager { config.movementRelay };
+
+		// Setup the trace profiler
+		TraceProfiler::Get().SetEnabled(config.isTraceEnabled);
+		TraceProfiler::Get().SetSampleInterval(config.traceSampleInterval);
+		TraceProfiler::Get().SetTrigger(config.traceTickThreshold, config.traceTicksAfterOverrun, config.traceFolder);
 
 		// Initialize asset registry
 		AssetRegistry::Initialize(config.mapFolder, {});
@@ -150,8 +157,11 @@ namespace mmo
 		// Create the web service
 		/////////////////////////////////////////////////////////////////////////////////////////////////
 
-		// TODO
-
+		auto webService = std::make_unique<WebService>(
+			ioService,
+			config.webPort,
+			config.webPassword
+		);
 
 
 		/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -12,6 +12,7 @@
 #include "base/clock.h"
 #include "base/constants.h"
 #include "base/timer_queue.h"
+#include "base/trace_profiler.h"
 #include "game_server/character_data.h"
 #include "game/chat_type.h"
 #include "game_server/game_player_s.h"
@@ -358,6 +359,25 @@ namespace mmo
 		}, flush);
 	}
 
+	void RealmConnector::SendProxyPacketMulti(const std::vector<uint64>& characterGuids, uint16 packetId, uint32 packetSize, const std::vector<char>& packetContent, bool flush)
+	{
+		if (characterGuids.empty())
+		{
+			return;
+		}
+
+		sendSinglePacket([&characterGuids, packetId, packetSize, &packetContent](auth::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(auth::world_realm_packet::ProxyPacketMulti);
+			outPacket
+				<< io::write<uint16>(packetId)
+				<< io::write<uint32>(packetSize)
+				<< io::write_dynamic_range<uint32>(packetContent)
+				<< io::write_dynamic_range<uint32>(characterGuids);
+			outPacket.Finish();
+		}, flush);
+	}
+
 	void RealmConnector::SendCharacterData(uint32 mapId, const InstanceId& instanceId, const GamePlayerS& character)
 	{
 		sendSinglePacket([&character, mapId, &instanceId](auth::OutgoingPacket & outPacket)
@@ -468,6 +488,15 @@ namespace mmo
 			ELOG("Failed to read PLAYER_CHARACTER_JOIN packet");
 			return PacketParseResult::Disconnect;
 		}
+
+		// Older realm servers do not send the client features, in which case the client gets the full packet formats
+		uint32 clientFeatures = game::client_feature::None;
+		if (!packet.getSource()->end() && !(packet >> io::read<uint32>(clientFeatures)))
+		{
+			ELOG("Failed to read PLAYER_CHARACTER_JOIN packet");
+			return PacketParseResult::Disconnect;
+		}
+		clientFeatures &= game::client_feature::Supported;
 		
 		DLOG("Player character " << log_hex_digit(characterData.characterId) << " wants to join world...");
 		
@@ -604,7 +633,7 @@ namespace mmo
 		characterObject->ClearFieldChanges();
 
 		// Create a new player object
-		auto player = std::make_shared<Player>(m_playerManager, *this, characterObject, characterData, m_project, *instance);
+		auto player = std::make_shared<Player>(m_playerManager, *this, characterObject, characterData, m_project, *instance, clientFeatures);
 		m_playerManager.AddPlayer(player);
 
 		// Enter the world using the character object
@@ -824,6 +853,8 @@ namespace mmo
 
 	PacketParseResult RealmConnector::connectionPacketReceived(auth::IncomingPacket& packet)
 	{
+		TRACE_SCOPE("RealmConnector::connectionPacketReceived");
+
 		return HandleIncomingPacket(packet);
 	}
 
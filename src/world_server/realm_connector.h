@@ -69,6 +69,13 @@ namespace mmo
 		/// @param packetContent 
 		void SendProxyPacket(uint64 characterGuid, uint16 packetId, uint32 packetSize, const std::vector<char>& packetContent, bool flush = true);
 
+		/// @brief Sends a proxy packet to the clients of multiple characters. The packet content is only sent once and fanned out by the realm.
+		/// @param characterGuids Guids of all characters which should receive the packet.
+		/// @param packetId Op code of the client packet.
+		/// @param packetSize Size of the client packet body in bytes.
+		/// @param packetContent The serialized client packet.
+		void SendProxyPacketMulti(const std::vector<uint64>& characterGuids, uint16 packetId, uint32 packetSize, const std::vector<char>& packetContent, bool flush = true);
+
 		void SendCharacterData(uint32 mapId, const InstanceId& instanceId, const GamePlayerS& character);
 
 		void SendQuestData(uint64 characterGuid, uint32 questId, const QuestStatusData& questData);
@@ -0,0 +1,108 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "web_client.h"
+
+#include "web_service.h"
+#include "base/clock.h"
+#include "base/metrics.h"
+#include "base/trace_profiler.h"
+#include "http/http_incoming_request.h"
+#include "log/default_log_levels.h"
+
+namespace mmo
+{
+	namespace
+	{
+		void SendJsonResponse(web::WebResponse &response, const String &json)
+		{
+			response.finishWithContent("application/json", json.data(), json.size());
+		}
+	}
+
+	WebClient::WebClient(WebService &webService, std::shared_ptr<Client> connection)
+		: web::WebClient(webService, connection)
+	{
+	}
+
+	void WebClient::handleRequest(const net::http::IncomingRequest &request,
+	                              web::WebResponse &response)
+	{
+		if (!net::http::authorize(request,
+		                          [this](const std::string &name, const std::string &password) -> bool
+			{
+				(void)name;
+				const auto &expectedPassword = static_cast<WebService &>(this->getService()).GetPassword();
+				return (expectedPassword == password);
+			}))
+		{
+			respondUnauthorized(response, "MMO World");
+			return;
+		}
+
+		const auto &url = request.getPath();
+		switch(request.getType())
+		{
+			case net::http::IncomingRequest::Get:
+			{
+				if (url == "/uptime")
+				{
+					const GameTime startTime = static_cast<WebService &>(getService()).GetStartTime();
+
+					std::ostringstream message;
+					message << "{\"uptime\":" << gameTimeToSeconds<unsigned>(GetAsyncTimeMs() - startTime) << "}";
+					SendJsonResponse(response, message.str());
+				}
+				else if (url == "/metrics")
+				{
+					std::ostringstream message;
+					MetricsRegistry::Get().WriteText(message);
+
+					const String content = message.str();
+					response.finishWithContent("text/plain; version=0.0.4", content.data(), content.size());
+				}
+				else if (url == "/trace")
+				{
+					std::ostringstream message;
+					TraceProfiler::Get().WriteChromeTrace(message);
+					SendJsonResponse(response, message.str());
+				}
+				else
+				{
+					response.setStatus(net::http::OutgoingAnswer::NotFound);
+
+					const String message = "The command '" + url + "' does not exist";
+					response.finishWithContent("text/html", message.data(), message.size());
+				}
+				break;
+			}
+			case net::http::IncomingRequest::Post:
+			{
+				if (url == "/shutdown")
+				{
+					handleShutdown(request, response);
+				}
+				else
+				{
+					response.setStatus(net::http::OutgoingAnswer::NotFound);
+
+					const String message = "The command '" + url + "' does not exist";
+					response.finishWithContent("text/html", message.data(), message.size());
+				}
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+	}
+
+	void WebClient::handleShutdown(const net::http::IncomingRequest& request, web::WebResponse& response) const
+	{
+		ILOG("Shutting down..");
+		response.finish();
+
+		auto& ioService = getService().getIOService();
+		ioService.stop();
+	}
+}
@@ -0,0 +1,33 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "web_services/web_service.h"
+#include "web_client.h"
+#include "base/constants.h"
+#include "base/clock.h"
+
+namespace mmo
+{
+	class WebService 
+		: public web::WebService
+	{
+	public:
+
+		explicit WebService(
+		    asio::io_service &service,
+		    uint16 port,
+		    String password
+		);
+
+		GameTime GetStartTime() const;
+		const String &GetPassword() const;
+
+		virtual web::WebService::WebClientPtr createClient(std::shared_ptr<Client> connection) override;
+
+	private:
+
+		const GameTime m_startTime;
+		const String m_password;
+	};
+}